@@ -35,23 +35,16 @@ const QString ChannelAnalyzer::m_channelId = "ChannelAnalyzer";
 ChannelAnalyzer::ChannelAnalyzer(DeviceAPI *deviceAPI) :
         ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
         m_deviceAPI(deviceAPI),
-        m_sampleSink(0),
-        m_settingsMutex(QMutex::Recursive)
+        m_sampleSink(0)
 {
     setObjectName(m_channelId);
 
 	m_undersampleCount = 0;
 	m_sum = 0;
-	m_usb = true;
 	m_magsq = 0;
-	m_useInterpolator = false;
-	m_interpolatorDistance = 1.0f;
 	m_interpolatorDistanceRemain = 0.0f;
 	m_inputSampleRate = 48000;
 	m_inputFrequencyOffset = 0;
-	SSBFilter = new fftfilt(m_settings.m_lowCutoff / m_inputSampleRate, m_settings.m_bandwidth / m_inputSampleRate, ssbFftLen);
-	DSBFilter = new fftfilt(m_settings.m_bandwidth / m_inputSampleRate, 2*ssbFftLen);
-	RRCFilter = new fftfilt(m_settings.m_bandwidth / m_inputSampleRate, 2*ssbFftLen);
 	m_corr = new fftcorr(8*ssbFftLen); // 8k for 4k effective samples
 	m_pll.computeCoefficients(0.002f, 0.5f, 10.0f); // bandwidth, damping factor, loop gain
 
@@ -70,9 +63,30 @@ ChannelAnalyzer::~ChannelAnalyzer()
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete SSBFilter;
-    delete DSBFilter;
-    delete RRCFilter;
+}
+
+ChannelAnalyzer::Filters::Filters(int sampleRate, float bandwidth, float lowCutoff, quint32 rrcRolloff) :
+    m_ssbFilter(ssbFftLen),
+    m_dsbFilter(2*ssbFftLen),
+    m_rrcFilter(2*ssbFftLen),
+    m_usb(true)
+{
+    if (bandwidth < 0)
+    {
+        bandwidth = -bandwidth;
+        lowCutoff = -lowCutoff;
+        m_usb = false;
+    }
+
+    if (bandwidth < 100.0f)
+    {
+        bandwidth = 100.0f;
+        lowCutoff = 0;
+    }
+
+    m_ssbFilter.create_filter(lowCutoff / sampleRate, bandwidth / sampleRate);
+    m_dsbFilter.create_dsb_filter(bandwidth / sampleRate);
+    m_rrcFilter.create_rrc_filter(bandwidth / sampleRate, rrcRolloff / 100.0);
 }
 
 void ChannelAnalyzer::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
@@ -81,19 +95,40 @@ void ChannelAnalyzer::feed(const SampleVector::const_iterator& begin, const Samp
 	fftfilt::cmplx *sideband = 0;
 	Complex ci;
 
-	m_settingsMutex.lock();
+    m_settingsSnapshot.update();
+    m_filters.update();
+
+    if (m_interpolation.update()) {
+        m_interpolatorDistanceRemain = 0;
+    }
+
+    if (m_loopSettings.update())
+    {
+        const LoopSettings& loopSettings = m_loopSettings.get();
+
+        if (loopSettings.m_pskOrder < 32) {
+            m_pll.setPskOrder(loopSettings.m_pskOrder);
+        }
+
+        // both reset the loops
+        m_pll.setSampleRate(loopSettings.m_sampleRate);
+        m_fll.setSampleRate(loopSettings.m_sampleRate);
+    }
+
+    const ChannelAnalyzerSettings& settings = m_settingsSnapshot.get();
+    Interpolation& interpolation = m_interpolation.get();
 
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
-		if (m_useInterpolator)
+		if (settings.m_downSample)
 		{
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
+            if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
             {
                 processOneSample(ci, sideband);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
+                m_interpolatorDistanceRemain += interpolation.m_distance;
             }
 		}
 		else
@@ -104,29 +139,29 @@ void ChannelAnalyzer::feed(const SampleVector::const_iterator& begin, const Samp
 
 	if(m_sampleSink != 0)
 	{
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), m_settings.m_ssb); // m_ssb = positive only
+		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), settings.m_ssb); // m_ssb = positive only
 	}
 
 	m_sampleBuffer.clear();
-
-	m_settingsMutex.unlock();
 }
 
 void ChannelAnalyzer::processOneSample(Complex& c, fftfilt::cmplx *sideband)
 {
+    const ChannelAnalyzerSettings& settings = m_settingsSnapshot.get();
+    Filters& filters = m_filters.get();
     int n_out;
-    int decim = 1<<m_settings.m_spanLog2;
+    int decim = 1<<settings.m_spanLog2;
 
-    if (m_settings.m_ssb)
+    if (settings.m_ssb)
     {
-        n_out = SSBFilter->runSSB(c, &sideband, m_usb);
+        n_out = filters.m_ssbFilter.runSSB(c, &sideband, filters.m_usb);
     }
     else
     {
-        if (m_settings.m_rrc) {
-            n_out = RRCFilter->runFilt(c, &sideband);
+        if (settings.m_rrc) {
+            n_out = filters.m_rrcFilter.runFilt(c, &sideband);
         } else {
-            n_out = DSBFilter->runDSB(c, &sideband);
+            n_out = filters.m_dsbFilter.runDSB(c, &sideband);
         }
     }
 
@@ -146,9 +181,9 @@ void ChannelAnalyzer::processOneSample(Complex& c, fftfilt::cmplx *sideband)
             m_channelPowerAvg(m_magsq);
             std::complex<float> mix;
 
-            if (m_settings.m_pll)
+            if (settings.m_pll)
             {
-                if (m_settings.m_fll)
+                if (settings.m_fll)
                 {
                     m_fll.feed(re, im);
                     // Use -fPLL to mix (exchange PLL real and image in the complex multiplication)
@@ -162,7 +197,7 @@ void ChannelAnalyzer::processOneSample(Complex& c, fftfilt::cmplx *sideband)
                 }
             }
 
-            feedOneSample(m_settings.m_pll ? mix : m_sum, m_settings.m_fll ? m_fll.getComplex() : m_pll.getComplex());
+            feedOneSample(settings.m_pll ? mix : m_sum, settings.m_fll ? m_fll.getComplex() : m_pll.getComplex());
             m_sum = 0;
         }
     }
@@ -191,7 +226,7 @@ bool ChannelAnalyzer::handleMessage(const Message& cmd)
 		if (getMessageQueueToGUI())
 		{
             MsgReportChannelSampleRateChanged *msg = MsgReportChannelSampleRateChanged::create();
-            getMessageQueueToGUI()->push(msg);
+            getMessageQueueToGUI()->pushCoalesced(msg); // GUI only needs to know it has changed
 		}
 
 	    return true;
@@ -247,51 +282,40 @@ void ChannelAnalyzer::applyChannelSettings(int inputSampleRate, int inputFrequen
 
     if ((m_inputSampleRate != inputSampleRate) || force)
     {
-        m_settingsMutex.lock();
-
-        m_interpolator.create(16, inputSampleRate, inputSampleRate / 2.2f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) inputSampleRate / (Real) m_settings.m_downSampleRate;
+        publishInterpolation(inputSampleRate, m_settings.m_downSampleRate);
 
         if (!m_settings.m_downSample)
         {
-            setFilters(inputSampleRate, m_settings.m_bandwidth, m_settings.m_lowCutoff);
-            m_pll.setSampleRate(inputSampleRate / (1<<m_settings.m_spanLog2));
-            m_fll.setSampleRate(inputSampleRate / (1<<m_settings.m_spanLog2));
+            publishFilters(inputSampleRate, m_settings);
+            publishLoopSettings(inputSampleRate, m_settings);
         }
-
-        m_settingsMutex.unlock();
     }
 
     m_inputSampleRate = inputSampleRate;
     m_inputFrequencyOffset = inputFrequencyOffset;
 }
 
-void ChannelAnalyzer::setFilters(int sampleRate, float bandwidth, float lowCutoff)
+void ChannelAnalyzer::publishInterpolation(int inputSampleRate, quint32 downSampleRate)
 {
-    qDebug("ChannelAnalyzer::setFilters: sampleRate: %d bandwidth: %f lowCutoff: %f",
-            sampleRate, bandwidth, lowCutoff);
-
-    if (bandwidth < 0)
-    {
-        bandwidth = -bandwidth;
-        lowCutoff = -lowCutoff;
-        m_usb = false;
-    }
-    else
-    {
-        m_usb = true;
-    }
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, inputSampleRate, inputSampleRate / 2.2f);
+    interpolation->m_distance = (Real) inputSampleRate / (Real) downSampleRate;
+    m_interpolation.publish(interpolation);
+}
 
-    if (bandwidth < 100.0f)
-    {
-        bandwidth = 100.0f;
-        lowCutoff = 0;
-    }
+void ChannelAnalyzer::publishFilters(int sampleRate, const ChannelAnalyzerSettings& settings)
+{
+    qDebug("ChannelAnalyzer::publishFilters: sampleRate: %d bandwidth: %d lowCutoff: %d",
+            sampleRate, settings.m_bandwidth, settings.m_lowCutoff);
+    m_filters.publish(new Filters(sampleRate, settings.m_bandwidth, settings.m_lowCutoff, settings.m_rrcRolloff));
+}
 
-    SSBFilter->create_filter(lowCutoff / sampleRate, bandwidth / sampleRate);
-    DSBFilter->create_dsb_filter(bandwidth / sampleRate);
-    RRCFilter->create_rrc_filter(bandwidth / sampleRate, m_settings.m_rrcRolloff / 100.0);
+void ChannelAnalyzer::publishLoopSettings(int sampleRate, const ChannelAnalyzerSettings& settings)
+{
+    LoopSettings *loopSettings = new LoopSettings();
+    loopSettings->m_sampleRate = sampleRate / (1<<settings.m_spanLog2);
+    loopSettings->m_pskOrder = settings.m_pllPskOrder;
+    m_loopSettings.publish(loopSettings);
 }
 
 void ChannelAnalyzer::applySettings(const ChannelAnalyzerSettings& settings, bool force)
@@ -310,74 +334,34 @@ void ChannelAnalyzer::applySettings(const ChannelAnalyzerSettings& settings, boo
             << " m_pllPskOrder: " << settings.m_pllPskOrder
             << " m_inputType: " << (int) settings.m_inputType;
 
-    if ((settings.m_downSampleRate != m_settings.m_downSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolator.create(16, m_inputSampleRate, m_inputSampleRate / 2.2);
-        m_interpolatorDistanceRemain = 0.0f;
-        m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) settings.m_downSampleRate;
-        m_settingsMutex.unlock();
-    }
-
-    if ((settings.m_downSample != m_settings.m_downSample) || force)
-    {
-        int sampleRate = settings.m_downSample ? settings.m_downSampleRate : m_inputSampleRate;
-
-        m_settingsMutex.lock();
-        m_useInterpolator = settings.m_downSample;
-        setFilters(sampleRate, settings.m_bandwidth, settings.m_lowCutoff);
-        m_pll.setSampleRate(sampleRate / (1<<settings.m_spanLog2));
-        m_fll.setSampleRate(sampleRate / (1<<settings.m_spanLog2));
-        m_settingsMutex.unlock();
-    }
+    int sampleRate = settings.m_downSample ? settings.m_downSampleRate : m_inputSampleRate;
 
-    if ((settings.m_bandwidth != m_settings.m_bandwidth) ||
-        (settings.m_lowCutoff != m_settings.m_lowCutoff)|| force)
-    {
-        m_settingsMutex.lock();
-        setFilters(settings.m_downSample ? settings.m_downSampleRate : m_inputSampleRate, settings.m_bandwidth, settings.m_lowCutoff);
-        m_settingsMutex.unlock();
+    if ((settings.m_downSampleRate != m_settings.m_downSampleRate) || force) {
+        publishInterpolation(m_inputSampleRate, settings.m_downSampleRate);
     }
 
-    if ((settings.m_rrcRolloff != m_settings.m_rrcRolloff) || force)
+    if ((settings.m_downSample != m_settings.m_downSample)
+     || (settings.m_downSample && (settings.m_downSampleRate != m_settings.m_downSampleRate))
+     || (settings.m_bandwidth != m_settings.m_bandwidth)
+     || (settings.m_lowCutoff != m_settings.m_lowCutoff)
+     || (settings.m_rrcRolloff != m_settings.m_rrcRolloff) || force)
     {
-        float sampleRate = settings.m_downSample ? (float) settings.m_downSampleRate : (float) m_inputSampleRate;
-        m_settingsMutex.lock();
-        RRCFilter->create_rrc_filter(settings.m_bandwidth / sampleRate, settings.m_rrcRolloff / 100.0);
-        m_settingsMutex.unlock();
+        publishFilters(sampleRate, settings);
     }
 
-    if ((settings.m_spanLog2 != m_settings.m_spanLog2) || force)
+    // the loops are reset when they are switched on
+    if ((settings.m_downSample != m_settings.m_downSample)
+     || (settings.m_downSample && (settings.m_downSampleRate != m_settings.m_downSampleRate))
+     || (settings.m_spanLog2 != m_settings.m_spanLog2)
+     || (settings.m_pll != m_settings.m_pll)
+     || (settings.m_fll != m_settings.m_fll)
+     || (settings.m_pllPskOrder != m_settings.m_pllPskOrder) || force)
     {
-        int sampleRate = (settings.m_downSample ? settings.m_downSampleRate : m_inputSampleRate) / (1<<m_settings.m_spanLog2);
-        m_pll.setSampleRate(sampleRate);
-        m_fll.setSampleRate(sampleRate);
-    }
-
-    if (settings.m_pll != m_settings.m_pll || force)
-    {
-        if (settings.m_pll)
-        {
-            m_pll.reset();
-            m_fll.reset();
-        }
-    }
-
-    if (settings.m_fll != m_settings.m_fll || force)
-    {
-        if (settings.m_fll) {
-            m_fll.reset();
-        }
-    }
-
-    if (settings.m_pllPskOrder != m_settings.m_pllPskOrder || force)
-    {
-        if (settings.m_pllPskOrder < 32) {
-            m_pll.setPskOrder(settings.m_pllPskOrder);
-        }
+        publishLoopSettings(sampleRate, settings);
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
 }
 
 Real ChannelAnalyzer::getPllFrequency() const
@@ -18,7 +18,6 @@
 #ifndef INCLUDE_CHANALYZERNG_H
 #define INCLUDE_CHANALYZERNG_H
 
-#include <QMutex>
 #include <vector>
 
 #include "dsp/basebandsamplesink.h"
@@ -32,6 +31,7 @@
 #include "audio/audiofifo.h"
 #include "util/message.h"
 #include "util/movingaverage.h"
+#include "util/settingssnapshot.h"
 
 #include "chanalyzersettings.h"
 
@@ -91,6 +91,7 @@ public:
 
     class MsgReportChannelSampleRateChanged : public Message {
         MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED(MsgReportChannelSampleRateChanged)
 
     public:
 
@@ -158,49 +159,75 @@ public:
     static const QString m_channelId;
 
 private:
+    struct Interpolation //!< input to down sampled channel rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct Filters //!< at channel sample rate
+    {
+        Filters(int sampleRate = 48000, float bandwidth = 5000, float lowCutoff = 300, quint32 rrcRolloff = 35);
+        fftfilt m_ssbFilter;
+        fftfilt m_dsbFilter;
+        fftfilt m_rrcFilter;
+        bool m_usb;
+    };
+
+    struct LoopSettings //!< PLL and FLL
+    {
+        LoopSettings() : m_sampleRate(48000), m_pskOrder(1) {}
+        unsigned int m_sampleRate;
+        unsigned int m_pskOrder;
+    };
+
 	DeviceAPI *m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
     ChannelAnalyzerSettings m_settings;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<ChannelAnalyzerSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<Filters> m_filters;
+    SettingsSnapshot<LoopSettings> m_loopSettings;
+
     int m_inputSampleRate;
     int m_inputFrequencyOffset;
 	int m_undersampleCount;
 	fftfilt::cmplx m_sum;
-	bool m_usb;
 	double m_magsq;
-	bool m_useInterpolator;
 
 	NCOF m_nco;
 	PhaseLockComplex m_pll;
 	FreqLockComplex m_fll;
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
 
-	fftfilt* SSBFilter;
-	fftfilt* DSBFilter;
-	fftfilt* RRCFilter;
 	fftcorr* m_corr;
 
 	BasebandSampleSink* m_sampleSink;
 	SampleVector m_sampleBuffer;
 	MovingAverageUtil<double, double, 480> m_channelPowerAvg;
-	QMutex m_settingsMutex;
 
 //	void apply(bool force = false);
 	void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
 	void applySettings(const ChannelAnalyzerSettings& settings, bool force = false);
-	void setFilters(int sampleRate, float bandwidth, float lowCutoff);
+	void publishInterpolation(int inputSampleRate, quint32 downSampleRate);
+	void publishFilters(int sampleRate, const ChannelAnalyzerSettings& settings);
+	void publishLoopSettings(int sampleRate, const ChannelAnalyzerSettings& settings);
 	void processOneSample(Complex& c, fftfilt::cmplx *sideband);
 
 	inline void feedOneSample(const fftfilt::cmplx& s, const fftfilt::cmplx& pll)
 	{
-	    switch (m_settings.m_inputType)
+	    const ChannelAnalyzerSettings& settings = m_settingsSnapshot.get();
+	    bool usb = m_filters->m_usb;
+
+	    switch (settings.m_inputType)
 	    {
 	        case ChannelAnalyzerSettings::InputPLL:
             {
-                if (m_settings.m_ssb & !m_usb) { // invert spectrum for LSB
+                if (settings.m_ssb & !usb) { // invert spectrum for LSB
                     m_sampleBuffer.push_back(Sample(pll.imag()*SDR_RX_SCALEF, pll.real()*SDR_RX_SCALEF));
                 } else {
                     m_sampleBuffer.push_back(Sample(pll.real()*SDR_RX_SCALEF, pll.imag()*SDR_RX_SCALEF));
@@ -211,7 +238,7 @@ private:
 	        {
 	            std::complex<float> a = m_corr->run(s/(SDR_RX_SCALEF/768.0f), 0);
 
-                if (m_settings.m_ssb & !m_usb) { // invert spectrum for LSB
+                if (settings.m_ssb & !usb) { // invert spectrum for LSB
                     m_sampleBuffer.push_back(Sample(a.imag(), a.real()));
                 } else {
                     m_sampleBuffer.push_back(Sample(a.real(), a.imag()));
@@ -221,7 +248,7 @@ private:
             case ChannelAnalyzerSettings::InputSignal:
             default:
             {
-                if (m_settings.m_ssb & !m_usb) { // invert spectrum for LSB
+                if (settings.m_ssb & !usb) { // invert spectrum for LSB
                     m_sampleBuffer.push_back(Sample(s.imag(), s.real()));
                 } else {
                     m_sampleBuffer.push_back(Sample(s.real(), s.imag()));
@@ -25,6 +25,7 @@
 
 #include <stdio.h>
 #include <complex.h>
+#include <algorithm>
 
 #include "SWGChannelSettings.h"
 #include "SWGAMDemodSettings.h"
@@ -56,14 +57,10 @@ AMDemod::AMDemod(DeviceAPI *deviceAPI) :
         m_inputFrequencyOffset(0),
         m_running(false),
         m_squelchOpen(false),
-        m_squelchDelayLine(9600),
         m_magsqSum(0.0f),
         m_magsqPeak(0.0f),
         m_magsqCount(0),
-        m_volumeAGC(0.003),
-        m_syncAMAGC(12000, 0.1, 1e-2),
-        m_audioFifo(48000),
-        m_settingsMutex(QMutex::Recursive)
+        m_audioFifo(48000)
 {
     setObjectName(m_channelId);
 
@@ -74,10 +71,9 @@ AMDemod::AMDemod(DeviceAPI *deviceAPI) :
 
 	DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(&m_audioFifo, getInputMessageQueue());
 	m_audioSampleRate = DSPEngine::instance()->getAudioDeviceManager()->getOutputSampleRate();
-    DSBFilter = new fftfilt((2.0f * m_settings.m_rfBandwidth) / m_audioSampleRate, 2 * 1024);
     SSBFilter = new fftfilt(0.0f, m_settings.m_rfBandwidth / m_audioSampleRate, 1024);
-    m_syncAMAGC.setThresholdEnable(false);
-    m_syncAMAGC.resize(12000, 6000, 0.1);
+    m_pll.computeCoefficients(0.05, 0.707, 1000);
+    resetSyncAMBuffer(m_settings.m_syncAMOperation);
 
     applyChannelSettings(m_inputSampleRate, m_inputFrequencyOffset, true);
     applySettings(m_settings, true);
@@ -87,10 +83,6 @@ AMDemod::AMDemod(DeviceAPI *deviceAPI) :
     m_deviceAPI->addChannelSink(m_threadedChannelizer);
     m_deviceAPI->addChannelSinkAPI(this);
 
-    m_pllFilt.create(101, m_audioSampleRate, 200.0);
-    m_pll.computeCoefficients(0.05, 0.707, 1000);
-    m_syncAMBuffIndex = 0;
-
     m_networkManager = new QNetworkAccessManager();
     connect(m_networkManager, SIGNAL(finished(QNetworkReply*)), this, SLOT(networkManagerFinished(QNetworkReply*)));
 }
@@ -104,10 +96,28 @@ AMDemod::~AMDemod()
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete DSBFilter;
     delete SSBFilter;
 }
 
+AMDemod::AFFilters::AFFilters(Real rfBandwidth, uint32_t audioSampleRate) :
+    m_dsbFilter((2.0f * rfBandwidth) / audioSampleRate, 2 * 1024)
+{
+    m_bandpass.create(301, audioSampleRate, 300.0, rfBandwidth / 2.0f);
+    m_lowpass.create(301, audioSampleRate, rfBandwidth / 2.0f);
+}
+
+AMDemod::AudioProcessing::AudioProcessing(uint32_t audioSampleRate, bool pll) :
+    m_sampleRate(audioSampleRate),
+    m_squelchDelayLine(audioSampleRate/5),
+    m_volumeAGC(0.003),
+    m_syncAMAGC(12000, 0.1, 1e-2)
+{
+    m_volumeAGC.resizeNew(pll ? audioSampleRate/4 : audioSampleRate/10, 0.003);
+    m_syncAMAGC.setThresholdEnable(false);
+    m_syncAMAGC.resize(audioSampleRate/4, audioSampleRate/8, 0.1);
+    m_pllFilt.create(101, audioSampleRate, 200.0);
+}
+
 uint32_t AMDemod::getNumberOfDeviceStreams() const
 {
     return m_deviceAPI->getNbSourceStreams();
@@ -122,31 +132,62 @@ void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector
         return;
     }
 
-	m_settingsMutex.lock();
+    m_settingsSnapshot.update();
+    m_afFilters.update();
+
+    if (m_interpolation.update()) {
+        m_interpolatorDistanceRemain = 0;
+    }
+
+    if (m_audioProcessing.update())
+    {
+        m_pll.setSampleRate(m_audioProcessing->m_sampleRate);
+        resetSyncAMBuffer(m_settingsSnapshot->m_syncAMOperation);
+    }
+
+    Interpolation& interpolation = m_interpolation.get();
+    m_filterInput.clear();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
-		if (m_interpolatorDistance < 1.0f) // interpolate
+		if (interpolation.m_distance < 1.0f) // interpolate
 		{
-		    while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
+		    while (!interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
             {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
+                m_filterInput.push_back(ci);
+                m_interpolatorDistanceRemain += interpolation.m_distance;
             }
 		}
 		else // decimate
 		{
-	        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
+	        if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
 	        {
-	            processOneSample(ci);
-	            m_interpolatorDistanceRemain += m_interpolatorDistance;
+	            m_filterInput.push_back(ci);
+	            m_interpolatorDistanceRemain += interpolation.m_distance;
 	        }
 		}
 	}
 
+    const AMDemodSettings& settings = m_settingsSnapshot.get();
+
+    if (settings.m_pll) {
+        processSyncAM(settings);
+    }
+
+    for (std::vector<fftfilt::cmplx>::iterator it = m_filterInput.begin(); it != m_filterInput.end(); ++it) {
+        processOneSample(*it);
+    }
+
+    if (settings.m_pll)
+    {
+        uint32_t consumed = std::min(m_syncAMBuffIndex, (uint32_t) m_syncAMBuff.size());
+        m_syncAMBuff.erase(m_syncAMBuff.begin(), m_syncAMBuff.begin() + consumed);
+        m_syncAMBuffIndex = 0;
+    }
+
 	if (m_audioBufferFill > 0)
 	{
 		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
@@ -158,12 +199,68 @@ void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector
 
 		m_audioBufferFill = 0;
 	}
+}
 
-	m_settingsMutex.unlock();
+void AMDemod::resetSyncAMBuffer(AMDemodSettings::SyncAMOperation syncAMOperation)
+{
+    // the sideband filters output half a FFT length at a time. Starting with this latency
+    // there is always a filtered sample to read for each input sample.
+    m_syncAMBuff.assign(syncAMOperation == AMDemodSettings::SyncAMDSB ? 1024 : 512, 0.0f);
+    m_syncAMBuffIndex = 0;
+    m_syncAMOperation = syncAMOperation;
+}
+
+void AMDemod::processSyncAM(const AMDemodSettings& settings)
+{
+    AFFilters& afFilters = m_afFilters.get();
+    AudioProcessing& audio = m_audioProcessing.get();
+    int n_in = m_filterInput.size();
+    int n_out;
+
+    if (settings.m_syncAMOperation != m_syncAMOperation) {
+        resetSyncAMBuffer(settings.m_syncAMOperation);
+    }
+
+    // the PLL runs on all samples so that it stays locked while the squelch is closed
+    m_syncAMInput.resize(n_in);
+
+    for (int i = 0; i < n_in; i++)
+    {
+        Real re = m_filterInput[i].real() / SDR_RX_SCALEF;
+        Real im = m_filterInput[i].imag() / SDR_RX_SCALEF;
+        std::complex<float> s(re, im);
+        s = audio.m_pllFilt.filter(s);
+        m_pll.feed(s.real(), s.imag());
+        m_syncAMInput[i].real(re * m_pll.getImag() - im * m_pll.getReal());
+        m_syncAMInput[i].imag(re * m_pll.getReal() + im * m_pll.getImag());
+    }
+
+    // the block filters can output up to half a FFT length more than their input
+    if (m_filterOutput.size() < (unsigned int) n_in + 2*1024) {
+        m_filterOutput.resize(n_in + 2*1024);
+    }
+
+    fftfilt::cmplx *sideband = m_filterOutput.data();
+
+    if (settings.m_syncAMOperation == AMDemodSettings::SyncAMDSB) {
+        n_out = afFilters.m_dsbFilter.runDSBBlock(m_syncAMInput.data(), n_in, sideband, false);
+    } else {
+        n_out = SSBFilter->runSSBBlock(m_syncAMInput.data(), n_in, sideband, settings.m_syncAMOperation == AMDemodSettings::SyncAMUSB, false);
+    }
+
+    for (int i = 0; i < n_out; i++)
+    {
+        float agcVal = audio.m_syncAMAGC.feedAndGetValue(sideband[i]);
+        fftfilt::cmplx z = sideband[i] * agcVal; // * m_syncAMAGC.getStepValue();
+        m_syncAMBuff.push_back(z.real() + z.imag());
+    }
 }
 
 void AMDemod::processOneSample(Complex &ci)
 {
+    const AMDemodSettings& settings = m_settingsSnapshot.get();
+    AFFilters& afFilters = m_afFilters.get();
+    AudioProcessing& audio = m_audioProcessing.get();
     Real re = ci.real() / SDR_RX_SCALEF;
     Real im = ci.imag() / SDR_RX_SCALEF;
     Real magsq = re*re + im*im;
@@ -178,7 +275,7 @@ void AMDemod::processOneSample(Complex &ci)
 
     m_magsqCount++;
 
-    m_squelchDelayLine.write(magsq);
+    audio.m_squelchDelayLine.write(magsq);
 
     if (m_magsq < m_squelchLevel)
     {
@@ -194,80 +291,46 @@ void AMDemod::processOneSample(Complex &ci)
     }
 
     qint16 sample;
+    Real syncAM = 0.0f;
+
+    if (settings.m_pll) // one synchronous AM sample is read for each input sample
+    {
+        syncAM = m_syncAMBuffIndex < m_syncAMBuff.size() ? m_syncAMBuff[m_syncAMBuffIndex] : 0.0f;
+        m_syncAMBuffIndex++;
+    }
 
     m_squelchOpen = (m_squelchCount >= m_audioSampleRate / 20);
 
-    if (m_squelchOpen && !m_settings.m_audioMute)
+    if (m_squelchOpen && !settings.m_audioMute)
     {
         Real demod;
 
-        if (m_settings.m_pll)
+        if (settings.m_pll)
         {
-            std::complex<float> s(re, im);
-            s = m_pllFilt.filter(s);
-            m_pll.feed(s.real(), s.imag());
-            float yr = re * m_pll.getImag() - im * m_pll.getReal();
-            float yi = re * m_pll.getReal() + im * m_pll.getImag();
-
-            fftfilt::cmplx *sideband;
-            std::complex<float> cs(yr, yi);
-            int n_out;
-
-            if (m_settings.m_syncAMOperation == AMDemodSettings::SyncAMDSB) {
-                n_out = DSBFilter->runDSB(cs, &sideband, false);
-            } else {
-                n_out = SSBFilter->runSSB(cs, &sideband, m_settings.m_syncAMOperation == AMDemodSettings::SyncAMUSB, false);
-            }
-
-            for (int i = 0; i < n_out; i++)
-            {
-                float agcVal = m_syncAMAGC.feedAndGetValue(sideband[i]);
-                fftfilt::cmplx z = sideband[i] * agcVal; // * m_syncAMAGC.getStepValue();
-
-                if (m_settings.m_syncAMOperation == AMDemodSettings::SyncAMDSB) {
-                    m_syncAMBuff[i] = (z.real() + z.imag());
-                } else if (m_settings.m_syncAMOperation == AMDemodSettings::SyncAMUSB) {
-                    m_syncAMBuff[i] = (z.real() + z.imag());
-                } else {
-                    m_syncAMBuff[i] = (z.real() + z.imag());
-                }
-
-//                    if (m_settings.m_syncAMOperation == AMDemodSettings::SyncAMDSB) {
-//                        m_syncAMBuff[i] = (sideband[i].real() + sideband[i].imag())/2.0f;
-//                    } else if (m_settings.m_syncAMOperation == AMDemodSettings::SyncAMUSB) {
-//                        m_syncAMBuff[i] = (sideband[i].real() + sideband[i].imag());
-//                    } else {
-//                        m_syncAMBuff[i] = (sideband[i].real() + sideband[i].imag());
-//                    }
-
-                m_syncAMBuffIndex = 0;
-            }
-
-            m_syncAMBuffIndex = m_syncAMBuffIndex < 2*1024 ? m_syncAMBuffIndex : 0;
-            demod = m_syncAMBuff[m_syncAMBuffIndex++]*4.0f; // mos pifometrico
-//                demod = m_syncAMBuff[m_syncAMBuffIndex++]*(SDR_RX_SCALEF/602.0f);
+            demod = syncAM*4.0f; // mos pifometrico
+//                demod = syncAM*(SDR_RX_SCALEF/602.0f);
 //                m_volumeAGC.feed(demod);
 //                demod /= (10.0*m_volumeAGC.getValue());
         }
         else
         {
-            demod = sqrt(m_squelchDelayLine.readBack(m_audioSampleRate/20));
-            m_volumeAGC.feed(demod);
-            demod = (demod - m_volumeAGC.getValue()) / m_volumeAGC.getValue();
+            demod = sqrt(audio.m_squelchDelayLine.readBack(m_audioSampleRate/20));
+            audio.m_volumeAGC.feed(demod);
+            demod = (demod - audio.m_volumeAGC.getValue()) / audio.m_volumeAGC.getValue();
         }
 
-        if (m_settings.m_bandpassEnable)
+        if (settings.m_bandpassEnable)
         {
-            demod = m_bandpass.filter(demod);
+            demod = afFilters.m_bandpass.filter(demod);
             demod /= 301.0f;
         }
         else
         {
-            demod = m_lowpass.filter(demod);
+            demod = afFilters.m_lowpass.filter(demod);
         }
 
         Real attack = (m_squelchCount - 0.05f * m_audioSampleRate) / (0.05f * m_audioSampleRate);
-        sample = demod * StepFunctions::smootherstep(attack) * (m_audioSampleRate/24) * m_settings.m_volume;
+        sample = demod * StepFunctions::smootherstep(attack) * (m_audioSampleRate/24) * settings.m_volume;
     }
     else
     {
@@ -382,31 +445,22 @@ void AMDemod::applyAudioSampleRate(int sampleRate)
             sampleRate, m_settings.m_inputFrequencyOffset);
     m_inputMessageQueue.push(channelConfigMsg);
 
-    m_settingsMutex.lock();
-
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorDistance = (Real) m_inputSampleRate / (Real) sampleRate;
-    m_bandpass.create(301, sampleRate, 300.0, m_settings.m_rfBandwidth / 2.0f);
-    m_lowpass.create(301, sampleRate,  m_settings.m_rfBandwidth / 2.0f);
+    publishInterpolation(m_inputSampleRate, sampleRate, m_settings.m_rfBandwidth);
+    m_afFilters.publish(new AFFilters(m_settings.m_rfBandwidth, sampleRate));
+    m_audioProcessing.publish(new AudioProcessing(sampleRate, m_settings.m_pll)); // also sets the PLL sample rate
     m_audioFifo.setSize(sampleRate);
-    m_squelchDelayLine.resize(sampleRate/5);
-    DSBFilter->create_dsb_filter((2.0f * m_settings.m_rfBandwidth) / (float) sampleRate);
-    m_pllFilt.create(101, sampleRate, 200.0);
-
-    if (m_settings.m_pll) {
-        m_volumeAGC.resizeNew(sampleRate, 0.003);
-    } else {
-        m_volumeAGC.resizeNew(sampleRate/10, 0.003);
-    }
-
-    m_syncAMAGC.resize(sampleRate/4, sampleRate/8, 0.1);
-    m_pll.setSampleRate(sampleRate);
 
-    m_settingsMutex.unlock();
     m_audioSampleRate = sampleRate;
 }
 
+void AMDemod::publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real rfBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, inputSampleRate, rfBandwidth / 2.2f);
+    interpolation->m_distance = (Real) inputSampleRate / (Real) audioSampleRate;
+    m_interpolation.publish(interpolation);
+}
+
 void AMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force)
 {
     qDebug() << "AMDemod::applyChannelSettings:"
@@ -420,13 +474,8 @@ void AMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffset
         m_nco.setFreq(-inputFrequencyOffset, inputSampleRate);
     }
 
-    if ((m_inputSampleRate != inputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) inputSampleRate / (Real) m_audioSampleRate;
-        m_settingsMutex.unlock();
+    if ((m_inputSampleRate != inputSampleRate) || force) {
+        publishInterpolation(inputSampleRate, m_audioSampleRate, m_settings.m_rfBandwidth);
     }
 
     m_inputSampleRate = inputSampleRate;
@@ -455,17 +504,27 @@ void AMDemod::applySettings(const AMDemodSettings& settings, bool force)
 
     QList<QString> reverseAPIKeys;
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
+        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(settings.m_audioDeviceName), audioDeviceIndex);
+        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            applyAudioSampleRate(audioSampleRate);
+        }
+
+        reverseAPIKeys.append("audioDeviceName");
+    }
+
     if((m_settings.m_rfBandwidth != settings.m_rfBandwidth) ||
         (m_settings.m_bandpassEnable != settings.m_bandpassEnable) || force)
     {
-        m_settingsMutex.lock();
-        m_interpolator.create(16, m_inputSampleRate, settings.m_rfBandwidth / 2.2f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-        m_bandpass.create(301, m_audioSampleRate, 300.0, settings.m_rfBandwidth / 2.0f);
-        m_lowpass.create(301, m_audioSampleRate,  settings.m_rfBandwidth / 2.0f);
-        DSBFilter->create_dsb_filter((2.0f * settings.m_rfBandwidth) / (float) m_audioSampleRate);
-        m_settingsMutex.unlock();
+        publishInterpolation(m_inputSampleRate, m_audioSampleRate, settings.m_rfBandwidth);
+        m_afFilters.publish(new AFFilters(settings.m_rfBandwidth, m_audioSampleRate));
 
         if ((m_settings.m_rfBandwidth != settings.m_rfBandwidth) || force) {
             reverseAPIKeys.append("rfBandwidth");
@@ -481,40 +540,15 @@ void AMDemod::applySettings(const AMDemodSettings& settings, bool force)
         reverseAPIKeys.append("squelch");
     }
 
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
-    {
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
-        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(settings.m_audioDeviceName), audioDeviceIndex);
-        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            applyAudioSampleRate(audioSampleRate);
-        }
-
-        reverseAPIKeys.append("audioDeviceName");
-    }
-
     if ((m_settings.m_pll != settings.m_pll) || force)
     {
-        if (settings.m_pll)
-        {
-            m_volumeAGC.resizeNew(m_audioSampleRate/4, 0.003);
-            m_syncAMBuffIndex = 0;
-        }
-        else
-        {
-            m_volumeAGC.resizeNew(m_audioSampleRate/10, 0.003);
-        }
-
+        m_audioProcessing.publish(new AudioProcessing(m_audioSampleRate, settings.m_pll)); // volume AGC depends on PLL mode
         reverseAPIKeys.append("pll");
         reverseAPIKeys.append("syncAMOperation");
     }
 
     if ((m_settings.m_syncAMOperation != settings.m_syncAMOperation) || force)
     {
-        m_syncAMBuffIndex = 0;
         reverseAPIKeys.append("pll");
         reverseAPIKeys.append("syncAMOperation");
     }
@@ -557,6 +591,7 @@ void AMDemod::applySettings(const AMDemodSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
 }
 
 QByteArray AMDemod::serialize() const
@@ -21,7 +21,6 @@
 #include <vector>
 
 #include <QNetworkRequest>
-#include <QMutex>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -32,9 +31,11 @@
 #include "dsp/bandpass.h"
 #include "dsp/lowpass.h"
 #include "dsp/phaselockcomplex.h"
+#include "dsp/fftfilt.h"
 #include "audio/audiofifo.h"
 #include "util/message.h"
 #include "util/doublebufferfifo.h"
+#include "util/settingssnapshot.h"
 
 #include "amdemodsettings.h"
 
@@ -43,7 +44,6 @@ class QNetworkReply;
 class DeviceAPI;
 class DownChannelizer;
 class ThreadedBasebandSampleSink;
-class fftfilt;
 
 class AMDemod : public BasebandSampleSink, public ChannelAPI {
 	Q_OBJECT
@@ -179,6 +179,31 @@ private:
 		RSRunning
 	};
 
+    struct Interpolation //!< channel to audio sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct AFFilters
+    {
+        AFFilters(Real rfBandwidth = 5000, uint32_t audioSampleRate = 48000);
+        Bandpass<Real> m_bandpass;
+        Lowpass<Real> m_lowpass;
+        fftfilt m_dsbFilter;
+    };
+
+    struct AudioProcessing //!< states sized on the audio sample rate
+    {
+        AudioProcessing(uint32_t audioSampleRate = 48000, bool pll = false);
+        uint32_t m_sampleRate;
+        DoubleBufferFIFO<Real> m_squelchDelayLine;
+        SimpleAGC<4800> m_volumeAGC;
+        MagAGC m_syncAMAGC;
+        Lowpass<std::complex<float> > m_pllFilt;
+    };
+
 	DeviceAPI *m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
@@ -189,15 +214,18 @@ private:
     uint32_t m_audioSampleRate;
     bool m_running;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<AMDemodSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<AFFilters> m_afFilters;
+    SettingsSnapshot<AudioProcessing> m_audioProcessing;
+
 	NCO m_nco;
-	Interpolator m_interpolator;
-	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
 
 	Real m_squelchLevel;
 	uint32_t m_squelchCount;
 	bool m_squelchOpen;
-	DoubleBufferFIFO<Real> m_squelchDelayLine;
 	double m_magsq;
 	double m_magsqSum;
 	double m_magsqPeak;
@@ -205,16 +233,15 @@ private:
 	MagSqLevelsStore m_magSqLevelStore;
 
 	MovingAverageUtil<Real, double, 16> m_movingAverage;
-	SimpleAGC<4800> m_volumeAGC;
-    Bandpass<Real> m_bandpass;
-    Lowpass<Real> m_lowpass;
-    Lowpass<std::complex<float> > m_pllFilt;
     PhaseLockComplex m_pll;
-    fftfilt* DSBFilter;
     fftfilt* SSBFilter;
-    Real m_syncAMBuff[2*1024];
-    uint32_t m_syncAMBuffIndex;
-    MagAGC m_syncAMAGC;
+    std::vector<Real> m_syncAMBuff;         //!< synchronous AM demodulated samples waiting to be read
+    uint32_t m_syncAMBuffIndex;              //!< next sample to read
+    AMDemodSettings::SyncAMOperation m_syncAMOperation;
+
+    std::vector<fftfilt::cmplx> m_filterInput;  //!< audio rate samples of one feed() call
+    std::vector<fftfilt::cmplx> m_syncAMInput;  //!< samples mixed by the PLL
+    std::vector<fftfilt::cmplx> m_filterOutput; //!< sideband filter output
 
 	AudioVector m_audioBuffer;
 	uint32_t m_audioBufferFill;
@@ -225,15 +252,16 @@ private:
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
-	QMutex m_settingsMutex;
-
 	void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const AMDemodSettings& settings, bool force = false);
     void applyAudioSampleRate(int sampleRate);
+    void publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real rfBandwidth);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const AMDemodSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const AMDemodSettings& settings, bool force);
 
+    void resetSyncAMBuffer(AMDemodSettings::SyncAMOperation syncAMOperation);
+    void processSyncAM(const AMDemodSettings& settings);
     void processOneSample(Complex &ci);
 
 private slots:
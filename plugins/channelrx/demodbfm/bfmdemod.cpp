@@ -58,10 +58,7 @@ BFMDemod::BFMDemod(DeviceAPI *deviceAPI) :
         m_inputSampleRate(384000),
         m_inputFrequencyOffset(0),
         m_audioFifo(250000),
-        m_settingsMutex(QMutex::Recursive),
         m_pilotPLL(19000/384000, 50/384000, 0.01),
-        m_deemphasisFilterX(default_deemphasis * 48000 * 1.0e-6),
-        m_deemphasisFilterY(default_deemphasis * 48000 * 1.0e-6),
 	m_fmExcursion(default_excursion)
 {
 	setObjectName(m_channelId);
@@ -77,22 +74,14 @@ BFMDemod::BFMDemod(DeviceAPI *deviceAPI) :
     m_squelchLevel = 0;
     m_squelchState = 0;
 
-    m_interpolatorDistance = 0.0f;
     m_interpolatorDistanceRemain = 0.0f;
-
-    m_interpolatorRDSDistance = 0.0f;
     m_interpolatorRDSDistanceRemain = 0.0f;
-
-    m_interpolatorStereoDistance = 0.0f;
     m_interpolatorStereoDistanceRemain = 0.0f;
 
     m_sampleSink = 0;
     m_m1Arg = 0;
 
-    m_rfFilter = new fftfilt(-50000.0 / 384000.0, 50000.0 / 384000.0, filtFftLen);
-
-	m_deemphasisFilterX.configure(default_deemphasis * m_audioSampleRate * 1.0e-6);
-	m_deemphasisFilterY.configure(default_deemphasis * m_audioSampleRate * 1.0e-6);
+	m_deemphasis.publish(new Deemphasis(m_audioSampleRate));
  	m_phaseDiscri.setFMScaling(384000/m_fmExcursion);
 
 	m_audioBuffer.resize(16384);
@@ -121,7 +110,6 @@ BFMDemod::~BFMDemod()
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete m_rfFilter;
 }
 
 void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
@@ -135,14 +123,28 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 	m_sampleBuffer.clear();
 
-	m_settingsMutex.lock();
+    m_settingsSnapshot.update();
+    m_rfFilter.update();
+    m_deemphasis.update();
+
+    if (m_interpolation.update())
+    {
+        m_interpolatorDistanceRemain = m_interpolation->m_distance;
+        m_interpolatorStereoDistanceRemain = m_interpolation->m_distance;
+        m_interpolatorRDSDistanceRemain = m_interpolation->m_rdsDistance;
+    }
+
+    const BFMDemodSettings& settings = m_settingsSnapshot.get();
+    Interpolation& interpolation = m_interpolation.get();
+    fftfilt& rfFilter = m_rfFilter->m_filter;
+    Deemphasis& deemphasis = m_deemphasis.get();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
 		c *= m_nco.nextIQ();
 
-		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
+		rf_out = rfFilter.runFilt(c, &rf); // filter RF before demod
 
 		for (int i =0 ; i  <rf_out; i++)
 		{
@@ -157,7 +159,7 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 			if (msq >= m_squelchLevel)
 			{
-			    if (m_squelchState < m_settings.m_rfBandwidth / 10) { // twice attack and decay rate
+			    if (m_squelchState < settings.m_rfBandwidth / 10) { // twice attack and decay rate
 			        m_squelchState++;
 			    }
 			}
@@ -168,22 +170,22 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 			    }
 			}
 
-			if (m_squelchState > m_settings.m_rfBandwidth / 20) { // squelch open
+			if (m_squelchState > settings.m_rfBandwidth / 20) { // squelch open
 				demod = m_phaseDiscri.phaseDiscriminator(rf[i]);
 			} else {
 				demod = 0;
 			}
 
-			if (!m_settings.m_showPilot) {
+			if (!settings.m_showPilot) {
 				m_sampleBuffer.push_back(Sample(demod * SDR_RX_SCALEF, 0.0));
 			}
 
-			if (m_settings.m_rdsActive)
+			if (settings.m_rdsActive)
 			{
 				//Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
 				Complex r(demod * 2.0 * std::cos(3.0 * m_pilotPLLSamples[3]), 0.0);
 
-				if (m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
+				if (interpolation.m_interpolatorRDS.decimate(&m_interpolatorRDSDistanceRemain, r, &cr))
 				{
 					bool bit;
 
@@ -194,7 +196,7 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 						}
 					}
 
-					m_interpolatorRDSDistanceRemain += m_interpolatorRDSDistance;
+					m_interpolatorRDSDistanceRemain += interpolation.m_rdsDistance;
 				}
 			}
 
@@ -202,54 +204,54 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
 			// Process stereo if stereo mode is selected
 
-			if (m_settings.m_audioStereo)
+			if (settings.m_audioStereo)
 			{
 				m_pilotPLL.process(demod, m_pilotPLLSamples);
 
-				if (m_settings.m_showPilot) {
+				if (settings.m_showPilot) {
 					m_sampleBuffer.push_back(Sample(m_pilotPLLSamples[1] * SDR_RX_SCALEF, 0.0)); // debug 38 kHz pilot
 				}
 
-				if (m_settings.m_lsbStereo)
+				if (settings.m_lsbStereo)
 				{
 					// 1.17 * 0.7 = 0.819
 					Complex s(demod * m_pilotPLLSamples[1], demod * m_pilotPLLSamples[2]);
 
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
+					if (interpolation.m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
 					{
 						sampleStereo = cs.real() + cs.imag();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
+						m_interpolatorStereoDistanceRemain += interpolation.m_distance;
 					}
 				}
 				else
 				{
 					Complex s(demod * 1.17 * m_pilotPLLSamples[1], 0);
 
-					if (m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
+					if (interpolation.m_interpolatorStereo.decimate(&m_interpolatorStereoDistanceRemain, s, &cs))
 					{
 						sampleStereo = cs.real();
-						m_interpolatorStereoDistanceRemain += m_interpolatorStereoDistance;
+						m_interpolatorStereoDistanceRemain += interpolation.m_distance;
 					}
 				}
 			}
 
 			Complex e(demod, 0);
 
-			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
+			if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
 			{
-				if (m_settings.m_audioStereo)
+				if (settings.m_audioStereo)
 				{
 					Real deemph_l, deemph_r; // Pre-emphasis is applied on each channel before multiplexing
-					m_deemphasisFilterX.process(ci.real() + sampleStereo, deemph_l);
-					m_deemphasisFilterY.process(ci.real() - sampleStereo, deemph_r);
-                    m_audioBuffer[m_audioBufferFill].l = (qint16)(deemph_l * (1<<12) * m_settings.m_volume);
-                    m_audioBuffer[m_audioBufferFill].r = (qint16)(deemph_r * (1<<12) * m_settings.m_volume);
+					deemphasis.m_filterX.process(ci.real() + sampleStereo, deemph_l);
+					deemphasis.m_filterY.process(ci.real() - sampleStereo, deemph_r);
+                    m_audioBuffer[m_audioBufferFill].l = (qint16)(deemph_l * (1<<12) * settings.m_volume);
+                    m_audioBuffer[m_audioBufferFill].r = (qint16)(deemph_r * (1<<12) * settings.m_volume);
 				}
 				else
 				{
 					Real deemph;
-					m_deemphasisFilterX.process(ci.real(), deemph);
-					quint16 sample = (qint16)(deemph * (1<<12) * m_settings.m_volume);
+					deemphasis.m_filterX.process(ci.real(), deemph);
+					quint16 sample = (qint16)(deemph * (1<<12) * settings.m_volume);
 					m_audioBuffer[m_audioBufferFill].l = sample;
 					m_audioBuffer[m_audioBufferFill].r = sample;
 				}
@@ -267,7 +269,7 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 					m_audioBufferFill = 0;
 				}
 
-				m_interpolatorDistanceRemain += m_interpolatorDistance;
+				m_interpolatorDistanceRemain += interpolation.m_distance;
 			}
 		}
 	}
@@ -288,8 +290,6 @@ void BFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	}
 
 	m_sampleBuffer.clear();
-
-	m_settingsMutex.unlock();
 }
 
 void BFMDemod::start()
@@ -387,20 +387,8 @@ void BFMDemod::applyAudioSampleRate(int sampleRate)
 {
     qDebug("BFMDemod::applyAudioSampleRate: %d", sampleRate);
 
-    m_settingsMutex.lock();
-
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_afBandwidth);
-    m_interpolatorDistanceRemain = (Real) m_inputSampleRate / sampleRate;
-    m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) sampleRate;
-
-    m_interpolatorStereo.create(16, m_inputSampleRate, m_settings.m_afBandwidth);
-    m_interpolatorStereoDistanceRemain = (Real) m_inputSampleRate / sampleRate;
-    m_interpolatorStereoDistance =  (Real) m_inputSampleRate / (Real) sampleRate;
-
-    m_deemphasisFilterX.configure(default_deemphasis * sampleRate * 1.0e-6);
-    m_deemphasisFilterY.configure(default_deemphasis * sampleRate * 1.0e-6);
-
-    m_settingsMutex.unlock();
+    publishInterpolation(m_inputSampleRate, sampleRate, m_settings.m_afBandwidth);
+    m_deemphasis.publish(new Deemphasis(sampleRate));
 
     m_audioSampleRate = sampleRate;
 }
@@ -420,27 +408,9 @@ void BFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
     if ((inputSampleRate != m_inputSampleRate) || force)
     {
         m_pilotPLL.configure(19000.0/inputSampleRate, 50.0/inputSampleRate, 0.01);
-
-        m_settingsMutex.lock();
-
-        m_interpolator.create(16, inputSampleRate, m_settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) inputSampleRate / m_audioSampleRate;
-        m_interpolatorDistance =  (Real) inputSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorStereo.create(16, inputSampleRate, m_settings.m_afBandwidth);
-        m_interpolatorStereoDistanceRemain = (Real) inputSampleRate / m_audioSampleRate;
-        m_interpolatorStereoDistance =  (Real) inputSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorRDS.create(4, inputSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) inputSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) inputSampleRate / 250000.0;
-
-        Real lowCut = -(m_settings.m_rfBandwidth / 2.0) / inputSampleRate;
-        Real hiCut  = (m_settings.m_rfBandwidth / 2.0) / inputSampleRate;
-        m_rfFilter->create_filter(lowCut, hiCut);
+        publishInterpolation(inputSampleRate, m_audioSampleRate, m_settings.m_afBandwidth);
+        publishRFFilter(inputSampleRate, m_settings.m_rfBandwidth);
         m_phaseDiscri.setFMScaling(inputSampleRate / m_fmExcursion);
-
-        m_settingsMutex.unlock();
     }
 
     m_inputSampleRate = inputSampleRate;
@@ -492,34 +462,15 @@ void BFMDemod::applySettings(const BFMDemodSettings& settings, bool force)
     if ((settings.m_afBandwidth != m_settings.m_afBandwidth) || force)
     {
         reverseAPIKeys.append("afBandwidth");
-        m_settingsMutex.lock();
-
-        m_interpolator.create(16, m_inputSampleRate, settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) m_inputSampleRate / m_audioSampleRate;
-        m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorStereo.create(16, m_inputSampleRate, settings.m_afBandwidth);
-        m_interpolatorStereoDistanceRemain = (Real) m_inputSampleRate / m_audioSampleRate;
-        m_interpolatorStereoDistance =  (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-
-        m_interpolatorRDS.create(4, m_inputSampleRate, 600.0);
-        m_interpolatorRDSDistanceRemain = (Real) m_inputSampleRate / 250000.0;
-        m_interpolatorRDSDistance =  (Real) m_inputSampleRate / 250000.0;
-
+        publishInterpolation(m_inputSampleRate, m_audioSampleRate, settings.m_afBandwidth);
         m_lowpass.create(21, m_audioSampleRate, settings.m_afBandwidth);
-
-        m_settingsMutex.unlock();
     }
 
     if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         reverseAPIKeys.append("rfBandwidth");
-        m_settingsMutex.lock();
-        Real lowCut = -(settings.m_rfBandwidth / 2.0) / m_inputSampleRate;
-        Real hiCut  = (settings.m_rfBandwidth / 2.0) / m_inputSampleRate;
-        m_rfFilter->create_filter(lowCut, hiCut);
+        publishRFFilter(m_inputSampleRate, settings.m_rfBandwidth);
         m_phaseDiscri.setFMScaling(m_inputSampleRate / m_fmExcursion);
-        m_settingsMutex.unlock();
     }
 
     if ((settings.m_squelch != m_settings.m_squelch) || force)
@@ -553,6 +504,25 @@ void BFMDemod::applySettings(const BFMDemodSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
+}
+
+void BFMDemod::publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real afBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, inputSampleRate, afBandwidth);
+    interpolation->m_interpolatorStereo.create(16, inputSampleRate, afBandwidth);
+    interpolation->m_interpolatorRDS.create(4, inputSampleRate, 600.0);
+    interpolation->m_distance = (Real) inputSampleRate / (Real) audioSampleRate;
+    interpolation->m_rdsDistance = (Real) inputSampleRate / 250000.0;
+    m_interpolation.publish(interpolation);
+}
+
+void BFMDemod::publishRFFilter(int inputSampleRate, Real rfBandwidth)
+{
+    Real lowCut = -(rfBandwidth / 2.0) / inputSampleRate;
+    Real hiCut  = (rfBandwidth / 2.0) / inputSampleRate;
+    m_rfFilter.publish(new RFFilter(lowCut, hiCut));
 }
 
 QByteArray BFMDemod::serialize() const
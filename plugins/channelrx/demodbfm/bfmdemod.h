@@ -21,7 +21,6 @@
 
 #include <vector>
 
-#include <QMutex>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
@@ -36,6 +35,7 @@
 #include "dsp/phasediscri.h"
 #include "audio/audiofifo.h"
 #include "util/message.h"
+#include "util/settingssnapshot.h"
 
 #include "rdsparser.h"
 #include "rdsdecoder.h"
@@ -222,6 +222,34 @@ private:
 		RSRunning
 	};
 
+    struct Interpolation //!< channel to audio and RDS sample rates
+    {
+        Interpolation() : m_distance(1.0f), m_rdsDistance(1.0f) {}
+        Interpolator m_interpolator;       //!< between fixed demod bandwidth and audio bandwidth (rational)
+        Interpolator m_interpolatorStereo; //!< twin interpolator for stereo subcarrier
+        Interpolator m_interpolatorRDS;    //!< to the 250 kS/s RDS demodulator
+        Real m_distance;
+        Real m_rdsDistance;
+    };
+
+    struct RFFilter
+    {
+        RFFilter(Real lowCut = -50000.0 / 384000.0, Real hiCut = 50000.0 / 384000.0) :
+            m_filter(lowCut, hiCut, filtFftLen)
+        {}
+        fftfilt m_filter;
+    };
+
+    struct Deemphasis //!< at audio sample rate
+    {
+        explicit Deemphasis(uint32_t audioSampleRate = 48000) :
+            m_filterX(default_deemphasis * audioSampleRate * 1.0e-6),
+            m_filterY(default_deemphasis * audioSampleRate * 1.0e-6)
+        {}
+        LowPassFilterRC m_filterX;
+        LowPassFilterRC m_filterY;
+    };
+
 	DeviceAPI *m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
@@ -231,21 +259,18 @@ private:
     BFMDemodSettings m_settings;
     quint32 m_audioSampleRate;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<BFMDemodSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<RFFilter> m_rfFilter;
+    SettingsSnapshot<Deemphasis> m_deemphasis;
+
 	NCO m_nco;
-	Interpolator m_interpolator; //!< Interpolator between fixed demod bandwidth and audio bandwidth (rational)
-	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
-
-	Interpolator m_interpolatorStereo; //!< Twin Interpolator for stereo subcarrier
-	Real m_interpolatorStereoDistance;
 	Real m_interpolatorStereoDistanceRemain;
-
-	Interpolator m_interpolatorRDS; //!< Twin Interpolator for stereo subcarrier
-	Real m_interpolatorRDSDistance;
 	Real m_interpolatorRDSDistanceRemain;
 
 	Lowpass<Real> m_lowpass;
-	fftfilt* m_rfFilter;
 	static const int filtFftLen = 1024;
 
 	Real m_squelchLevel;
@@ -265,7 +290,6 @@ private:
 	BasebandSampleSink* m_sampleSink;
 	AudioFifo m_audioFifo;
 	SampleVector m_sampleBuffer;
-	QMutex m_settingsMutex;
 
 	RDSPhaseLock m_pilotPLL;
 	Real m_pilotPLLSamples[4];
@@ -274,8 +298,6 @@ private:
 	RDSDecoder m_rdsDecoder;
 	RDSParser m_rdsParser;
 
-	LowPassFilterRC m_deemphasisFilterX;
-	LowPassFilterRC m_deemphasisFilterY;
     static const Real default_deemphasis;
 
 	Real m_fmExcursion;
@@ -291,6 +313,8 @@ private:
 	void applyAudioSampleRate(int sampleRate);
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
 	void applySettings(const BFMDemodSettings& settings, bool force = false);
+    void publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real afBandwidth);
+    void publishRFFilter(int inputSampleRate, Real rfBandwidth);
 
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const BFMDemodSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
@@ -25,12 +25,16 @@
 #include <QDebug>
 #include <stdio.h>
 #include <complex.h>
+#include "SWGChannelReport.h"
+#include "SWGDATVDemodReport.h"
+
 #include "audio/audiooutput.h"
 #include "dsp/dspengine.h"
 
 #include "dsp/downchannelizer.h"
 #include "dsp/threadedbasebandsamplesink.h"
 #include "device/deviceapi.h"
+#include "util/db.h"
 
 const QString DATVDemod::m_channelIdURI = "sdrangel.channel.demoddatv";
 const QString DATVDemod::m_channelId = "DATVDemod";
@@ -64,6 +68,7 @@ DATVDemod::DATVDemod(DeviceAPI *deviceAPI) :
 
     //*************** DATV PARAMETERS  ***************
     m_blnInitialized=false;
+    m_objScheduler=nullptr;
     CleanUpDATVFramework(false);
 
     m_objVideoStream = new DATVideostream();
@@ -203,11 +208,15 @@ bool DATVDemod::PlayVideo(bool blnStartStop)
 
 void DATVDemod::CleanUpDATVFramework(bool blnRelease)
 {
+    // the worker threads of the previous chain must be joined before a new one is built
+    // or they keep running its runnables that write to the shared video stream and scopes
+    if (m_objScheduler != nullptr) {
+        m_objScheduler->shutdown();
+    }
+
     if (blnRelease == true)
     {
-        if (m_objScheduler != nullptr)
-        {
-            m_objScheduler->shutdown();
+        if (m_objScheduler != nullptr) {
             delete m_objScheduler;
         }
 
@@ -404,7 +413,7 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
 
         if(p_fecframes != nullptr)
         {
-            delete (leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >*) p_fecframes;
+            delete (leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >*) p_fecframes;
         }
 
         if(p_bbframes != nullptr)
@@ -414,12 +423,12 @@ void DATVDemod::CleanUpDATVFramework(bool blnRelease)
 
         if(p_s2_deinterleaver != nullptr)
         {
-            delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>*) p_s2_deinterleaver;
+            delete (leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>*) p_s2_deinterleaver;
         }
 
         if(r_fecdec != nullptr)
         {
-            delete (leansdr::s2_fecdec<bool, leansdr::hard_sb>*) r_fecdec;
+            delete (leansdr::s2_fecdec_soft*) r_fecdec;
         }
 
         if(p_deframer != nullptr)
@@ -794,6 +803,9 @@ void DATVDemod::InitDATVFramework()
     }
 
     // DECONVOLUTION AND SYNCHRONIZATION
+    // From here the chain works on symbols and bytes and can run in its own thread
+
+    m_objScheduler->set_group(1);
 
     p_bytes = new leansdr::pipebuf<leansdr::u8>(m_objScheduler, "bytes", BUF_BYTES);
 
@@ -861,6 +873,7 @@ void DATVDemod::InitDATVFramework()
     // OUTPUT
     r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream);
 
+    startScheduler();
     m_blnDVBInitialized = true;
 }
 
@@ -1099,39 +1112,43 @@ void DATVDemod::InitDATVS2Framework()
         r_scope_symbols_dvbs2->calculate_cstln_points();
     }
 
-    // Bit-flipping mode.
-    // Deinterleave into hard bits.
+    // Soft decision mode.
+    // Deinterleave into LLRs and decode LDPC with layered min-sum in SIMD lanes.
+    // Deinterleaving and LDPC decoding can run in their own thread
+
+    m_objScheduler->set_group(1);
 
     p_bbframes = new leansdr::pipebuf<leansdr::bbframe>(m_objScheduler, "BB frames", BUF_FRAMES);
 
-    p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> >(m_objScheduler, "FEC frames", BUF_FRAMES);
+    // room for a full batch of frames decoded together when the decoder lags behind
+    p_fecframes = new leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> >(
+        m_objScheduler,
+        "FEC frames",
+        std::max(BUF_FRAMES, (unsigned long) leansdr::ldpc_minsum_decoder::LANES)
+    );
 
-    p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::hard_sb>(
+    p_s2_deinterleaver = new leansdr::s2_deinterleaver<leansdr::llr_ss,leansdr::llr_sb>(
         m_objScheduler,
         *(leansdr::pipebuf< leansdr::plslot<leansdr::llr_ss> > *) p_slots_dvbs2,
-        *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes
+        *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes
     );
 
     p_vbitcount= new leansdr::pipebuf<int>(m_objScheduler, "Bits processed", BUF_S2PACKETS);
     p_verrcount = new leansdr::pipebuf<int>(m_objScheduler, "Bits corrected", BUF_S2PACKETS);
 
-    r_fecdec =  new leansdr::s2_fecdec<bool, leansdr::hard_sb>(
-        m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::hard_sb> > * ) p_fecframes,
+    r_fecdec =  new leansdr::s2_fecdec_soft(
+        m_objScheduler, *(leansdr::pipebuf< leansdr::fecframe<leansdr::llr_sb> > * ) p_fecframes,
         *(leansdr::pipebuf<leansdr::bbframe> *) p_bbframes,
         p_vbitcount,
         p_verrcount
     );
-    leansdr::s2_fecdec<bool, leansdr::hard_sb> *fecdec = (leansdr::s2_fecdec<bool, leansdr::hard_sb> * ) r_fecdec;
+    leansdr::s2_fecdec_soft *fecdec = (leansdr::s2_fecdec_soft * ) r_fecdec;
 
-    fecdec->bitflips=0;
+    fecdec->max_iterations = m_settings.m_ldpcMaxIterations;
 
-    /*
-    fecdec->bitflips = cfg.ldpc_bf; //int TODO
-    if ( ! cfg.ldpc_bf )
-    fprintf(stderr, "Warning: No LDPC error correction selected.\n")
-    */
+    // Deframe BB frames to TS packets (own thread with the video output)
+    m_objScheduler->set_group(2);
 
-    // Deframe BB frames to TS packets
     p_lock = new leansdr::pipebuf<int> (m_objScheduler, "lock", BUF_SLOW);
     p_locktime = new leansdr::pipebuf<leansdr::u32> (m_objScheduler, "locktime", BUF_S2PACKETS);
     p_tspackets = new leansdr::pipebuf<leansdr::tspacket>(m_objScheduler, "TS packets", BUF_S2PACKETS);
@@ -1146,10 +1163,64 @@ void DATVDemod::InitDATVS2Framework()
     // OUTPUT
     r_videoplayer = new leansdr::datvvideoplayer<leansdr::tspacket>(m_objScheduler, *p_tspackets, m_objVideoStream);
 
+    startScheduler();
     m_blnDVBInitialized = true;
 }
 
 
+void DATVDemod::startScheduler()
+{
+    m_runnableLoads.clear();
+    m_runnableTimeNs.clear();
+    m_loadTimer.start();
+
+    if (m_settings.m_multiThread)
+    {
+        if (m_objScheduler->start_threads()) {
+            qDebug("DATVDemod::startScheduler: decoder chain runs multithreaded");
+        } else {
+            qWarning("DATVDemod::startScheduler: cannot run the decoder chain multithreaded. Running in sequence");
+        }
+    }
+}
+
+bool DATVDemod::isMultiThreaded()
+{
+    QMutexLocker mlock(&m_objSettingsMutex);
+    return m_blnDVBInitialized && (m_objScheduler != nullptr) && m_objScheduler->is_threaded();
+}
+
+void DATVDemod::getRunnableLoads(std::vector<RunnableLoad>& loads)
+{
+    QMutexLocker mlock(&m_objSettingsMutex);
+
+    if (m_blnDVBInitialized && (m_objScheduler != nullptr) && (m_loadTimer.elapsed() >= 1000)) {
+        updateRunnableLoads();
+    }
+
+    loads = m_runnableLoads;
+}
+
+void DATVDemod::updateRunnableLoads()
+{
+    leansdr::scheduler::runnable_stats stats[leansdr::MAX_RUNNABLES];
+    int nbRunnables = m_objScheduler->get_stats(stats, leansdr::MAX_RUNNABLES);
+    qint64 elapsedNs = m_loadTimer.nsecsElapsed();
+    m_loadTimer.restart();
+
+    m_runnableLoads.resize(nbRunnables);
+    m_runnableTimeNs.resize(nbRunnables, 0);
+
+    for (int i = 0; i < nbRunnables; i++)
+    {
+        m_runnableLoads[i].m_name = QString(stats[i].name);
+        m_runnableLoads[i].m_group = stats[i].group;
+        m_runnableLoads[i].m_load = elapsedNs > 0 ? (stats[i].time_ns - m_runnableTimeNs[i]) / (float) elapsedNs : 0.0f;
+        m_runnableLoads[i].m_calls = stats[i].calls;
+        m_runnableTimeNs[i] = stats[i].time_ns;
+    }
+}
+
 void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
 {
     (void) firstOfBurst;
@@ -1162,6 +1233,7 @@ void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
     double magSq;
 
     int lngWritable=0;
+    bool blnInputFull=false;
 
     //********** Bis repetita : Let's rock and roll buddy ! **********
 
@@ -1238,7 +1310,8 @@ void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
 
             if (m_blnDVBInitialized
                && (p_rawiq_writer!=nullptr)
-               && (m_objScheduler!=nullptr))
+               && (m_objScheduler!=nullptr)
+               && !blnInputFull)
             {
                 p_rawiq_writer->write(objIQ);
                 m_lngReadIQ++;
@@ -1252,6 +1325,8 @@ void DATVDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
                     m_objScheduler->step();
 
                     m_lngReadIQ=0;
+                    // decoder threads late: drop the rest of the block rather than waiting for them
+                    blnInputFull = p_rawiq_writer->writable() <= 0;
                     //delete p_rawiq_writer;
                     //p_rawiq_writer = new leansdr::pipewriter<leansdr::cf32>(*p_rawiq);
                 }
@@ -1427,6 +1502,13 @@ void DATVDemod::applySettings(const DATVDemodSettings& settings, bool force)
         }
     }
 
+    if ((settings.m_ldpcMaxIterations != m_settings.m_ldpcMaxIterations) || force)
+    {
+        if (r_fecdec) {
+            ((leansdr::s2_fecdec_soft *) r_fecdec)->max_iterations = settings.m_ldpcMaxIterations;
+        }
+    }
+
     if ((m_settings.m_rfBandwidth != settings.m_rfBandwidth)
         || force)
     {
@@ -1571,3 +1653,35 @@ int DATVDemod::getLeanDVBModulationFromDATV(DATVDemodSettings::DATVModulation da
         return -1;
     }
 }
+
+int DATVDemod::webapiReportGet(
+        SWGSDRangel::SWGChannelReport& response,
+        QString& errorMessage)
+{
+    (void) errorMessage;
+    response.setDatvDemodReport(new SWGSDRangel::SWGDATVDemodReport());
+    response.getDatvDemodReport()->init();
+    webapiFormatChannelReport(response);
+    return 200;
+}
+
+void DATVDemod::webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response)
+{
+    std::vector<RunnableLoad> loads;
+    getRunnableLoads(loads);
+
+    response.getDatvDemodReport()->setChannelPowerDb(CalcDb::dbPower(getMagSq() / (SDR_RX_SCALED*SDR_RX_SCALED)));
+    response.getDatvDemodReport()->setChannelSampleRate(m_sampleRate);
+    response.getDatvDemodReport()->setMultiThread(isMultiThreaded() ? 1 : 0);
+
+    QList<SWGSDRangel::SWGDATVDemodRunnableReport*> *runnables = response.getDatvDemodReport()->getRunnables();
+
+    for (std::vector<RunnableLoad>::const_iterator it = loads.begin(); it != loads.end(); ++it)
+    {
+        runnables->append(new SWGSDRangel::SWGDATVDemodRunnableReport);
+        runnables->back()->setName(new QString(it->m_name));
+        runnables->back()->setGroup(it->m_group);
+        runnables->back()->setLoad(it->m_load * 100.0f);
+        runnables->back()->setCalls(it->m_calls);
+    }
+}
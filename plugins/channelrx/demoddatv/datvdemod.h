@@ -57,6 +57,13 @@ class DownChannelizer;
 #include "util/movingaverage.h"
 
 #include <QMutex>
+#include <QElapsedTimer>
+
+#include <vector>
+
+namespace SWGSDRangel {
+    class SWGChannelReport;
+}
 
 // enum DATVModulation { BPSK, QPSK, PSK8, APSK16, APSK32, APSK64E, QAM16, QAM64, QAM256 };
 // enum dvb_version { DVB_S, DVB_S2 };
@@ -153,6 +160,18 @@ public:
         return m_settings.m_centerFrequency;
     }
 
+    virtual int webapiReportGet(
+            SWGSDRangel::SWGChannelReport& response,
+            QString& errorMessage);
+
+    struct RunnableLoad //!< CPU usage of one block of the leansdr decoder chain
+    {
+        QString m_name;
+        int m_group;     //!< scheduler group (thread). Group 0 runs in the channel DSP thread
+        float m_load;    //!< fraction of one core used over the last measurement period
+        quint64 m_calls; //!< number of invocations since the chain was built
+    };
+
     bool SetTVScreen(TVScreen *objScreen);
     DATVideostream * SetVideoRender(DATVideoRender *objScreen);
     bool audioActive();
@@ -188,6 +207,8 @@ public:
     int getModcodModulation() const { return m_modcodModulation; }
     int getModcodCodeRate() const { return m_modcodCodeRate; }
     bool isCstlnSetByModcod() const { return m_cstlnSetByModcod; }
+    bool isMultiThreaded(); //!< decoder chain actually runs in several threads
+    void getRunnableLoads(std::vector<RunnableLoad>& loads); //!< refreshed at most once per second
     static DATVDemodSettings::DATVCodeRate getCodeRateFromLeanDVBCode(int leanDVBCodeRate);
     static DATVDemodSettings::DATVModulation getModulationFromLeanDVBCode(int leanDVBModulation);
     static int getLeanDVBCodeRateFromDATV(DATVDemodSettings::DATVCodeRate datvCodeRate);
@@ -429,9 +450,16 @@ private:
 
     QMutex m_objSettingsMutex;
 
+    std::vector<RunnableLoad> m_runnableLoads;
+    std::vector<quint64> m_runnableTimeNs; //!< cumulated run time at the last load update
+    QElapsedTimer m_loadTimer;
+
     //void ApplySettings();
     void applySettings(const DATVDemodSettings& settings, bool force = false);
 	void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
+    void startScheduler(); //!< once the decoder chain is built
+    void updateRunnableLoads();
+    void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
 };
 
 #endif // INCLUDE_DATVDEMOD_H
@@ -261,6 +261,7 @@ void DATVDemodGUI::displaySettings()
         ui->chkHardMetric->setStyleSheet("QCheckBox { color: white }");
         ui->chkFastlock->setStyleSheet("QCheckBox { color: white }");
         ui->chkViterbi->setStyleSheet("QCheckBox { color: white }");
+        ui->spiLDPCIterations->setEnabled(false);
     }
     else
     {
@@ -272,6 +273,7 @@ void DATVDemodGUI::displaySettings()
         ui->chkHardMetric->setStyleSheet("QCheckBox { color: gray }");
         ui->chkFastlock->setStyleSheet("QCheckBox { color: gray }");
         ui->chkViterbi->setStyleSheet("QCheckBox { color: gray }");
+        ui->spiLDPCIterations->setEnabled(true);
     }
 
     if (m_settings.m_standard == DATVDemodSettings::dvb_version::DVB_S) {
@@ -292,6 +294,8 @@ void DATVDemodGUI::displaySettings()
     ui->audioVolume->setValue(m_settings.m_audioVolume);
     ui->audioVolumeText->setText(tr("%1").arg(m_settings.m_audioVolume));
     ui->videoMute->setChecked(m_settings.m_videoMute);
+    ui->chkMultiThread->setChecked(m_settings.m_multiThread);
+    ui->spiLDPCIterations->setValue(m_settings.m_ldpcMaxIterations);
 
     blockApplySettings(false);
     m_objChannelMarker.blockSignals(false);
@@ -377,6 +381,8 @@ void DATVDemodGUI::applySettings(bool force)
         m_settings.m_audioMute = ui->audioMute->isChecked();
         m_settings.m_audioVolume = ui->audioVolume->value();
         m_settings.m_videoMute = ui->videoMute->isChecked();
+        m_settings.m_multiThread = ui->chkMultiThread->isChecked();
+        m_settings.m_ldpcMaxIterations = ui->spiLDPCIterations->value();
 
         QString msg = tr("DATVDemodGUI::applySettings: force: %1").arg(force);
         m_settings.debug(msg);
@@ -432,6 +438,8 @@ void DATVDemodGUI::tick()
             ui->statusText->setText(tr("MCOD %1 %2").arg(modcodModulationStr).arg(modcodCodeRateStr));
         }
 
+        displayRunnableLoads();
+
         if (m_cstlnSetByModcod != m_objDATVDemod->isCstlnSetByModcod())
         {
             m_cstlnSetByModcod = m_objDATVDemod->isCstlnSetByModcod();
@@ -498,6 +506,7 @@ void DATVDemodGUI::on_cmbStandard_currentIndexChanged(int index)
         ui->chkHardMetric->setStyleSheet("QCheckBox { color: white }");
         ui->chkFastlock->setStyleSheet("QCheckBox { color: white }");
         ui->chkViterbi->setStyleSheet("QCheckBox { color: white }");
+        ui->spiLDPCIterations->setEnabled(false);
     }
     else
     {
@@ -509,6 +518,7 @@ void DATVDemodGUI::on_cmbStandard_currentIndexChanged(int index)
         ui->chkHardMetric->setStyleSheet("QCheckBox { color: gray }");
         ui->chkFastlock->setStyleSheet("QCheckBox { color: gray }");
         ui->chkViterbi->setStyleSheet("QCheckBox { color: gray }");
+        ui->spiLDPCIterations->setEnabled(true);
     }
 
     if (m_settings.m_standard == DATVDemodSettings::dvb_version::DVB_S) {
@@ -634,6 +644,11 @@ void DATVDemodGUI::on_chkFastlock_clicked()
     applySettings();
 }
 
+void DATVDemodGUI::on_chkMultiThread_clicked()
+{
+    applySettings();
+}
+
 void DATVDemodGUI::on_audioMute_toggled(bool checked)
 {
     (void) checked;
@@ -689,6 +704,47 @@ void DATVDemodGUI::displayRRCParameters(bool blnVisible)
     ui->excursionLabel->setVisible(blnVisible);
 }
 
+void DATVDemodGUI::displayRunnableLoads()
+{
+    std::vector<DATVDemod::RunnableLoad> loads;
+    m_objDATVDemod->getRunnableLoads(loads);
+
+    if (loads.size() == 0)
+    {
+        ui->lblLoad->setText(tr("CPU: -"));
+        ui->lblLoad->setToolTip(tr("CPU load of each decoder thread"));
+        return;
+    }
+
+    // Sum per thread group for the label and detail each block in the tooltip
+    std::vector<float> groupLoads;
+    QString toolTip = tr("<table><tr><th>Block</th><th>Thread</th><th>CPU</th><th>Calls</th></tr>");
+
+    for (std::vector<DATVDemod::RunnableLoad>::const_iterator it = loads.begin(); it != loads.end(); ++it)
+    {
+        if (it->m_group >= (int) groupLoads.size()) {
+            groupLoads.resize(it->m_group + 1, 0.0f);
+        }
+
+        groupLoads[it->m_group] += it->m_load;
+        toolTip += QString("<tr><td>%1</td><td align=\"right\">%2</td><td align=\"right\">%3%</td><td align=\"right\">%4</td></tr>")
+            .arg(it->m_name.toHtmlEscaped())
+            .arg(it->m_group)
+            .arg(it->m_load * 100.0f, 0, 'f', 1)
+            .arg(it->m_calls);
+    }
+
+    toolTip += "</table>";
+    QString text = m_objDATVDemod->isMultiThreaded() ? tr("CPU (MT):") : tr("CPU:");
+
+    for (unsigned int i = 0; i < groupLoads.size(); i++) {
+        text += QString(" T%1 %2%").arg(i).arg(groupLoads[i] * 100.0f, 0, 'f', 0);
+    }
+
+    ui->lblLoad->setText(text);
+    ui->lblLoad->setToolTip(toolTip);
+}
+
 void DATVDemodGUI::on_cmbFilter_currentIndexChanged(int index)
 {
     (void) index;
@@ -707,3 +763,9 @@ void DATVDemodGUI::on_spiExcursion_valueChanged(int arg1)
     (void) arg1;
     applySettings();
 }
+
+void DATVDemodGUI::on_spiLDPCIterations_valueChanged(int arg1)
+{
+    (void) arg1;
+    applySettings();
+}
@@ -89,11 +89,13 @@ private slots:
     void on_cmbFilter_currentIndexChanged(int index);
     void on_spiRollOff_valueChanged(int arg1);
     void on_spiExcursion_valueChanged(int arg1);
+    void on_spiLDPCIterations_valueChanged(int arg1);
     void on_deltaFrequency_changed(qint64 value);
     void on_rfBandwidth_changed(qint64 value);
     void on_audioMute_toggled(bool checked);
     void on_audioVolume_valueChanged(int value);
     void on_videoMute_toggled(bool checked);
+    void on_chkMultiThread_clicked();
 
 private:
     Ui::DATVDemodGUI* ui;
@@ -133,6 +135,7 @@ private:
     QString formatBytes(qint64 intBytes);
 
     void displayRRCParameters(bool blnVisible);
+    void displayRunnableLoads();
 
 	void leaveEvent(QEvent*);
 	void enterEvent(QEvent*);
@@ -52,6 +52,8 @@ void DATVDemodSettings::resetToDefaults()
     m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
     m_audioVolume = 0;
     m_videoMute = false;
+    m_multiThread = false;
+    m_ldpcMaxIterations = 25;
 }
 
 QByteArray DATVDemodSettings::serialize() const
@@ -82,6 +84,8 @@ QByteArray DATVDemodSettings::serialize() const
     s.writeString(20, m_audioDeviceName);
     s.writeS32(21, m_audioVolume);
     s.writeBool(22, m_videoMute);
+    s.writeBool(23, m_multiThread);
+    s.writeS32(24, m_ldpcMaxIterations);
 
     return s.final();
 }
@@ -143,6 +147,8 @@ bool DATVDemodSettings::deserialize(const QByteArray& data)
         d.readString(20, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
         d.readS32(21, &m_audioVolume, 0);
         d.readBool(22, &m_videoMute, false);
+        d.readBool(23, &m_multiThread, false);
+        d.readS32(24, &m_ldpcMaxIterations, 25);
 
         validateSystemConfiguration();
 
@@ -176,7 +182,9 @@ void DATVDemodSettings::debug(const QString& msg) const
         << " m_audioMute: " << m_audioMute
         << " m_audioDeviceName: " << m_audioDeviceName
         << " m_audioVolume: " << m_audioVolume
-        << " m_videoMute: " << m_videoMute;
+        << " m_videoMute: " << m_videoMute
+        << " m_multiThread: " << m_multiThread
+        << " m_ldpcMaxIterations: " << m_ldpcMaxIterations;
 }
 
 bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
@@ -193,6 +201,7 @@ bool DATVDemodSettings::isDifferent(const DATVDemodSettings& other)
         || (m_notchFilters != other.m_notchFilters)
         || (m_symbolRate != other.m_symbolRate)
         || (m_excursion != other.m_excursion)
+        || (m_multiThread != other.m_multiThread)
         || (m_standard != other.m_standard));
 }
 
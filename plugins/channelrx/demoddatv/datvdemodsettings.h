@@ -93,6 +93,8 @@ struct DATVDemodSettings
     int m_excursion;
     int m_audioVolume;
     bool m_videoMute;
+    bool m_multiThread; //!< run the decoder chain in several threads
+    int m_ldpcMaxIterations; //!< DVB-S2 LDPC decoder iterations limit
 
     DATVDemodSettings();
     void resetToDefaults();
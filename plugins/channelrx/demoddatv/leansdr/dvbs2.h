@@ -33,6 +33,7 @@
 #include "dvb.h"
 #include "softword.h"
 #include "ldpc.h"
+#include "ldpc_minsum.h"
 #include "sdr.h"
 
 namespace leansdr
@@ -2174,6 +2175,131 @@ struct s2_fecdec : runnable
     pipewriter<int> *bitcount, *errcount;
 }; // s2_fecdec
 
+// S2 SOFT FEC DECODER AND BASEBAND DESCRAMBLER
+// Layered min-sum LDPC (see ldpc_minsum.h) on LLR frames then BCH.
+// Consecutive frames with the same FEC settings already available
+// in the input pipe are decoded together in the SIMD lanes.
+// Nothing is waited for so this does not add latency.
+
+struct s2_fecdec_soft : runnable
+{
+    int max_iterations; // LDPC iterations limit
+    s2_fecdec_soft(scheduler *sch,
+                   pipebuf<fecframe<llr_sb>> &_in, pipebuf<bbframe> &_out,
+                   pipebuf<int> *_bitcount = NULL,
+                   pipebuf<int> *_errcount = NULL)
+        : runnable(sch, "S2 fecdec soft"),
+          max_iterations(25),
+          iterations(0),
+          in(_in), out(_out),
+          bitcount(opt_writer(_bitcount, 1)),
+          errcount(opt_writer(_errcount, 1))
+    {
+        memset(codes, 0, sizeof(codes));
+        if (sch->debug)
+            fprintf(stderr, "S2 fecdec soft: %s kernel\n",
+                    ldpc_minsum_decoder::kernel_name(ldpc_minsum_decoder::get_kernel()));
+    }
+    ~s2_fecdec_soft()
+    {
+        for (int sf = 0; sf <= 1; ++sf)
+            for (int fec = 0; fec < FEC_COUNT; ++fec)
+                delete codes[sf][fec];
+    }
+    void run()
+    {
+        while (in.readable() >= 1 && out.writable() >= 1 &&
+               opt_writable(bitcount, 1) && opt_writable(errcount, 1))
+        {
+            fecframe<llr_sb> *pin = in.rd();
+            const modcod_info *mcinfo = check_modcod(pin->pls.modcod);
+            const fec_info *fi = &fec_infos[pin->pls.sf][mcinfo->rate];
+            // Batch of frames with the same code, each one gives at most one BB frame
+            int nmax = std::min(in.readable(), out.writable());
+            if (bitcount)
+                nmax = std::min(nmax, (int)bitcount->writable());
+            if (errcount)
+                nmax = std::min(nmax, (int)errcount->writable());
+            nmax = std::min(nmax, ldpc_minsum_decoder::LANES);
+            const int8_t *frames[ldpc_minsum_decoder::LANES];
+            int nframes = 0;
+            while (nframes < nmax &&
+                   pin[nframes].pls.sf == pin->pls.sf &&
+                   check_modcod(pin[nframes].pls.modcod)->rate == mcinfo->rate)
+            {
+                frames[nframes] = (const int8_t *)pin[nframes].bytes;
+                ++nframes;
+            }
+            // LDPC decode
+            const ldpc_minsum_code *code = get_code(pin->pls.sf, mcinfo->rate);
+            decoder.max_iterations = max_iterations;
+            uint32_t failed = decoder.decode(*code, frames, nframes);
+            iterations = decoder.get_iterations();
+            if (sch->debug2)
+                fprintf(stderr, "LDPCITER = %d FAILED = %08x\n", iterations, failed);
+            for (int f = 0; f < nframes; ++f)
+                output_frame(&pin[f], fi, f);
+            in.read(nframes);
+        }
+    }
+    int get_iterations() const { return iterations; } // Of the last batch
+
+  private:
+    const ldpc_minsum_code *get_code(int sf, int rate)
+    {
+        if (!codes[sf][rate])
+        {
+            const fec_info *fi = &fec_infos[sf][rate];
+            if (!fi->ldpc)
+                fail("Unsupported LDPC code");
+            codes[sf][rate] = new ldpc_minsum_code;
+            if (!codes[sf][rate]->init(fi->ldpc, fi->kldpc, sf ? 64800 / 4 : 64800))
+                fail("Bad LDPC table");
+        }
+        return codes[sf][rate];
+    }
+    void output_frame(const fecframe<llr_sb> *pin, const fec_info *fi, int f)
+    {
+        size_t cwbytes = fi->kldpc / 8;
+        size_t msgbytes = fi->Kbch / 8;
+        // Bits corrected by LDPC
+        int nldpc = 0;
+        decoder.harden(f, fi->kldpc, bch_buf);
+        for (size_t i = 0; i < cwbytes; ++i)
+            nldpc += hamming_weight((uint8_t)(softbyte_harden(pin->bytes[i]) ^ bch_buf[i]));
+        // BCH decode with suitable BCH decoder for this MODCOD
+        const modcod_info *mcinfo = check_modcod(pin->pls.modcod);
+        bch_interface *bch = s2bch.bchs[pin->pls.sf][mcinfo->rate];
+        int ncorr = bch->decode(bch_buf, cwbytes);
+        if (sch->debug2)
+            fprintf(stderr, "LDPCCORR = %d BCHCORR = %d\n", nldpc, ncorr);
+        bool corrupted = (ncorr < 0);
+        // Report VER
+        opt_write(bitcount, fi->Kbch);
+        opt_write(errcount, (ncorr >= 0) ? nldpc + ncorr : fi->Kbch);
+        if (!corrupted)
+        {
+            // Descramble and output
+            bbframe *pout = out.wr();
+            pout->pls = pin->pls;
+            bbscrambling.transform(bch_buf, msgbytes, pout->bytes);
+            out.written(1);
+        }
+        if (sch->debug)
+            fprintf(stderr, "%c", corrupted ? ':' : (ncorr || nldpc) ? '.' : '_');
+    }
+
+    ldpc_minsum_code *codes[2][FEC_COUNT]; // Built on first use
+    ldpc_minsum_decoder decoder;
+    int iterations;
+    uint8_t bch_buf[64800 / 8]; // Hard decisions for BCH
+    s2_bch_engines s2bch;
+    s2_bbscrambling bbscrambling;
+    pipereader<fecframe<llr_sb>> in;
+    pipewriter<bbframe> out;
+    pipewriter<int> *bitcount, *errcount;
+}; // s2_fecdec_soft
+
 // External LDPC decoder
 // Spawns a user-specified command, FEC frames on stdin/stdout.
 
@@ -19,6 +19,11 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 #include <math.h>
 #include <stdint.h>
@@ -45,10 +50,22 @@ void fail(const char *s);
 // [pipereader] is a client-side hook reading from a [pipebuf].
 // [runnable] is anything that moves data between [pipebufs].
 // [scheduler] is a global context which invokes [runnables] until fixpoint.
+//
+// Runnables can be assigned to groups (scheduler::set_group before they
+// are constructed). With scheduler::start_threads each group other than 0
+// runs in its own worker thread while group 0 still runs in the caller of
+// step(). A pipe whose readers live in another group than its writer is
+// then split in a writer side and a reader side buffer (single producer,
+// single consumer). Data produced during a pass of the writer group is
+// transferred in one block at the end of the pass so the transfer size
+// follows the actual data rate of each pipe.
 
 static const int MAX_PIPES = 64;
 static const int MAX_RUNNABLES = 64;
 static const int MAX_READERS = 8;
+static const int MAX_GROUPS = 8;
+
+struct scheduler;
 
 struct pipebuf_common
 {
@@ -67,9 +84,54 @@ struct pipebuf_common
         (void)total_bufs;
     }
 
+    // Threaded mode support (see scheduler::start_threads)
+    virtual void share() // split in writer and reader sides. Threads must not be running.
+    {
+    }
+
+    virtual bool flush() // writer side: transfer pending data to the reader side
+    {
+        return false;
+    }
+
+    virtual bool blocked() // writer side: pending data could not be transferred
+    {
+        return false;
+    }
+
+    virtual unsigned long written_count()
+    {
+        return 0;
+    }
+
+    virtual unsigned long read_count()
+    {
+        return 0;
+    }
+
+    void add_reader_group(int group)
+    {
+        if (reader_group == -1)
+            reader_group = group;
+        else if (reader_group != group)
+            reader_group = -2;
+    }
+
     const char *name;
+    scheduler *sch;
+    int writer_group; // -1 when there is no writer
+    int reader_group; // -1 when there is no reader, -2 when readers are in several groups
+    bool shared;      // writer and readers run in different groups
+    bool transferred; // writer side: data was transferred since the end of the last pass
+    bool reclaimed;   // reader side: space was freed since the end of the last pass
 
-    pipebuf_common(const char *_name) : name(_name)
+    pipebuf_common(const char *_name) : name(_name),
+                                        sch(NULL),
+                                        writer_group(-1),
+                                        reader_group(-1),
+                                        shared(false),
+                                        transferred(false),
+                                        reclaimed(false)
     {
     }
 
@@ -120,19 +182,49 @@ struct scheduler
     window_placement *windows;
     bool verbose, debug, debug2;
 
+    struct runnable_stats
+    {
+        const char *name;
+        int group;
+        unsigned long long time_ns; // cumulated time spent in run()
+        unsigned long long calls;   // number of run() invocations
+    };
+
     scheduler() : npipes(0),
                   nrunnables(0),
                   windows(NULL),
                   verbose(false),
                   debug(false),
-                  debug2(false)
+                  debug2(false),
+                  current_group(0),
+                  ngroups(0),
+                  threads_running(false),
+                  stopping(false)
     {
+        for (int i = 0; i < MAX_RUNNABLES; ++i)
+        {
+            groups[i] = 0;
+            run_time_ns[i].store(0);
+            run_calls[i].store(0);
+        }
+
+        for (int g = 0; g < MAX_GROUPS; ++g)
+        {
+            workers[g] = NULL;
+            wakeups[g].signaled = false;
+        }
+    }
+
+    ~scheduler()
+    {
+        stop_threads();
     }
 
     void add_pipe(pipebuf_common *p)
     {
         if (npipes == MAX_PIPES)
             fail("MAX_PIPES");
+        p->sch = this;
         pipes[npipes++] = p;
     }
 
@@ -140,15 +232,128 @@ struct scheduler
     {
         if (nrunnables == MAX_RUNNABLES)
             fail("MAX_RUNNABLES");
+        groups[nrunnables] = current_group;
         runnables[nrunnables++] = r;
     }
 
+    // Runnables, pipe writers and pipe readers constructed after this call belong to the group
+    void set_group(int group)
+    {
+        if ((group < 0) || (group >= MAX_GROUPS))
+            fail("MAX_GROUPS");
+        else
+            current_group = group;
+    }
+
+    int get_group() const
+    {
+        return current_group;
+    }
+
     void step()
     {
+        if (threads_running)
+            step_threaded();
+        else if (ngroups > 0)
+            for (int g = 0; g < ngroups; ++g) // shared pipes but no threads: run the groups in sequence
+                run_group(g);
+        else
+            for (int i = 0; i < nrunnables; ++i)
+                run_timed(i);
+    }
+
+    // Start one worker thread per group except group 0 that keeps running in step().
+    // Returns false and stays in sequential mode when there is only one group or when
+    // the readers of a pipe are spread over several groups.
+    bool start_threads()
+    {
+        if (threads_running)
+            return true;
+
+        int ng = 0;
+
         for (int i = 0; i < nrunnables; ++i)
-            runnables[i]->run();
+            if (groups[i] + 1 > ng)
+                ng = groups[i] + 1;
+
+        if (ng < 2)
+            return false;
+
+        for (int i = 0; i < npipes; ++i)
+        {
+            if (pipes[i]->reader_group == -2)
+            {
+                fprintf(stderr, "leansdr::scheduler::start_threads: readers of %s are in different groups\n", pipes[i]->name);
+                return false;
+            }
+        }
+
+        for (int i = 0; i < npipes; ++i)
+            if ((pipes[i]->reader_group >= 0) && (pipes[i]->writer_group >= 0) && (pipes[i]->reader_group != pipes[i]->writer_group))
+                pipes[i]->share();
+
+        ngroups = ng;
+        stopping.store(false);
+        threads_running = true;
+
+        for (int g = 1; g < ngroups; ++g)
+            workers[g] = new std::thread(&scheduler::worker, this, g);
+
+        return true;
+    }
+
+    // Join the worker threads. Pipes stay shared and step() then runs all groups in sequence.
+    void stop_threads()
+    {
+        if (!threads_running)
+            return;
+
+        stopping.store(true);
+
+        for (int g = 1; g < ngroups; ++g)
+        {
+            notify(g);
+            workers[g]->join();
+            delete workers[g];
+            workers[g] = NULL;
+        }
+
+        threads_running = false;
+    }
+
+    bool is_threaded() const
+    {
+        return threads_running;
+    }
+
+    // Copy the runnables statistics. Safe to call from any thread.
+    int get_stats(runnable_stats *stats, int max_stats) const
+    {
+        int n = nrunnables < max_stats ? nrunnables : max_stats;
+
+        for (int i = 0; i < n; ++i)
+        {
+            stats[i].name = runnables[i]->name;
+            stats[i].group = groups[i];
+            stats[i].time_ns = run_time_ns[i].load(std::memory_order_relaxed);
+            stats[i].calls = run_calls[i].load(std::memory_order_relaxed);
+        }
+
+        return n;
     }
 
+    // Wake up the thread of a group e.g. when data was transferred to or from it
+    void notify(int group)
+    {
+        if ((group < 0) || (group >= MAX_GROUPS))
+            return;
+
+        std::lock_guard<std::mutex> lock(wakeups[group].mutex);
+        wakeups[group].signaled = true;
+        wakeups[group].cv.notify_one();
+    }
+
+    // Sequential mode only
     void run()
     {
         unsigned long long prev_hash = 0;
@@ -165,6 +370,8 @@ struct scheduler
 
     void shutdown()
     {
+        stop_threads();
+
         for (int i = 0; i < nrunnables; ++i)
             runnables[i]->shutdown();
     }
@@ -186,6 +393,132 @@ struct scheduler
         fprintf(stderr, "Total buffer memory: %ld KiB\n",
                 (unsigned long)total_bufs / 1024);
     }
+
+  private:
+    struct wakeup
+    {
+        std::mutex mutex;
+        std::condition_variable cv;
+        bool signaled;
+    };
+
+    int current_group;
+    int groups[MAX_RUNNABLES];
+    std::atomic<unsigned long long> run_time_ns[MAX_RUNNABLES];
+    std::atomic<unsigned long long> run_calls[MAX_RUNNABLES];
+    int ngroups;
+    bool threads_running;
+    std::atomic<bool> stopping;
+    std::thread *workers[MAX_GROUPS];
+    wakeup wakeups[MAX_GROUPS];
+
+    void run_timed(int i)
+    {
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        runnables[i]->run();
+        std::chrono::steady_clock::duration dt = std::chrono::steady_clock::now() - t0;
+        run_time_ns[i].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(dt).count(), std::memory_order_relaxed);
+        run_calls[i].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Progress marker of a group. Only counters updated by the group itself are used.
+    unsigned long long progress(int group)
+    {
+        unsigned long long p = 0;
+
+        for (int i = 0; i < npipes; ++i)
+        {
+            if (pipes[i]->writer_group == group)
+                p += pipes[i]->written_count();
+            if (pipes[i]->reader_group == group)
+                p += pipes[i]->read_count();
+        }
+
+        return p;
+    }
+
+    bool outputs_blocked(int group)
+    {
+        for (int i = 0; i < npipes; ++i)
+            if (pipes[i]->shared && (pipes[i]->writer_group == group) && pipes[i]->blocked())
+                return true;
+
+        return false;
+    }
+
+    // One pass over the runnables of a group then transfer its output to the other groups
+    unsigned long long run_group(int group)
+    {
+        for (int i = 0; i < nrunnables; ++i)
+            if (groups[i] == group)
+                run_timed(i);
+
+        // The other side is woken up once per pass and not at every transfer
+        for (int i = 0; i < npipes; ++i)
+        {
+            pipebuf_common *p = pipes[i];
+
+            if (!p->shared)
+                continue;
+
+            if (p->writer_group == group)
+            {
+                p->flush();
+
+                if (p->transferred)
+                {
+                    p->transferred = false;
+                    notify(p->reader_group);
+                }
+            }
+            else if ((p->reader_group == group) && p->reclaimed)
+            {
+                p->reclaimed = false;
+                notify(p->writer_group);
+            }
+        }
+
+        return progress(group);
+    }
+
+    void wait(int group, int timeout_ms)
+    {
+        std::unique_lock<std::mutex> lock(wakeups[group].mutex);
+
+        if (!wakeups[group].signaled && !stopping.load())
+            wakeups[group].cv.wait_for(lock, std::chrono::milliseconds(timeout_ms));
+
+        wakeups[group].signaled = false;
+    }
+
+    void worker(int group)
+    {
+        unsigned long long last = progress(group);
+
+        while (!stopping.load())
+        {
+            unsigned long long p = run_group(group);
+
+            if (p == last)
+                wait(group, 100);
+
+            last = p;
+        }
+    }
+
+    // Group 0 runs in the caller. When its outputs are full give the other groups
+    // one short wait to consume then run once more. Whatever is left of the input is
+    // processed by the next call so that the caller is never held for long.
+    void step_threaded()
+    {
+        unsigned long long p0 = progress(0);
+
+        if (run_group(0) != p0 || !outputs_blocked(0))
+            return;
+
+        wait(0, 10);
+        run_group(0);
+    }
 };
 
 struct runnable : runnable_common
@@ -213,10 +546,22 @@ struct pipebuf : pipebuf_common
         return sizeof(T);
     }
 
+    // Shared mode: writer side is [buf, end) from xfer to wr, reader side is [rbuf, rend)
+    // holding the rds up to rwr. Only transfers and reader side packing take the mutex.
+    T *xfer;
+    T *rbuf;
+    T *rend;
+    std::atomic<T *> rwr;
+    std::mutex xfer_mutex;
+
     pipebuf(scheduler *sch, const char *name, unsigned long size) : pipebuf_common(name),
                                                                     buf(new T[size]),
                                                                     nrd(0), wr(buf),
                                                                     end(buf + size),
+                                                                    xfer(buf),
+                                                                    rbuf(NULL),
+                                                                    rend(NULL),
+                                                                    rwr(NULL),
                                                                     min_write(1),
                                                                     total_written(0),
                                                                     total_read(0)
@@ -234,14 +579,97 @@ struct pipebuf : pipebuf_common
 
     void pack()
     {
+        T *rd = wr;
+        if (shared)
+            rd = xfer;
+        else
+            for (int i = 0; i < nrd; ++i)
+                if (rds[i] < rd)
+                    rd = rds[i];
+        memmove(buf, rd, (wr - rd) * sizeof(T));
+        wr -= rd - buf;
+        if (shared)
+            xfer -= rd - buf;
+        else
+            for (int i = 0; i < nrd; ++i)
+                rds[i] -= rd - buf;
+    }
+
+    void share()
+    {
+        if (shared)
+            return;
+        unsigned long size = end - buf;
+        rbuf = new T[size];
+        rend = rbuf + size;
         T *rd = wr;
         for (int i = 0; i < nrd; ++i)
             if (rds[i] < rd)
                 rd = rds[i];
-        memmove(buf, rd, (wr - rd) * sizeof(T));
-        wr -= rd - buf;
+        memcpy(rbuf, rd, (wr - rd) * sizeof(T));
         for (int i = 0; i < nrd; ++i)
-            rds[i] -= rd - buf;
+            rds[i] = rbuf + (rds[i] - rd);
+        rwr.store(rbuf + (wr - rd));
+        wr = buf;
+        xfer = buf;
+        shared = true;
+    }
+
+    // Writer thread. Moves as much pending data as the reader side can take.
+    bool flush()
+    {
+        unsigned long n = wr - xfer;
+        if (!n)
+            return false;
+        {
+            std::lock_guard<std::mutex> lock(xfer_mutex);
+            T *w = rwr.load(std::memory_order_relaxed);
+            if ((unsigned long)(rend - w) < n)
+                n = rend - w;
+            if (!n)
+                return false;
+            memcpy(w, xfer, n * sizeof(T));
+            rwr.store(w + n, std::memory_order_release);
+        }
+        xfer += n;
+        transferred = true;
+        return true;
+    }
+
+    bool blocked()
+    {
+        return xfer != wr;
+    }
+
+    // Reader thread. Reclaims the space already consumed on the reader side.
+    bool pack_reader()
+    {
+        T *rd = rend;
+        for (int i = 0; i < nrd; ++i)
+            if (rds[i] < rd)
+                rd = rds[i];
+        if (rd == rbuf)
+            return false;
+        {
+            std::lock_guard<std::mutex> lock(xfer_mutex);
+            T *w = rwr.load(std::memory_order_relaxed);
+            memmove(rbuf, rd, (w - rd) * sizeof(T));
+            rwr.store(w - (rd - rbuf), std::memory_order_relaxed);
+        }
+        for (int i = 0; i < nrd; ++i)
+            rds[i] -= rd - rbuf;
+        reclaimed = true;
+        return true;
+    }
+
+    unsigned long written_count()
+    {
+        return total_written;
+    }
+
+    unsigned long read_count()
+    {
+        return total_read;
     }
 
     long long hash()
@@ -260,26 +688,31 @@ struct pipebuf : pipebuf_common
         else
             fprintf(stderr, ".%-16s : %3ldM/%3ldM", name, total_read / 1000000,
                     total_written / 1000000);
-        *total_bufs += (end - buf) * sizeof(T);
+        *total_bufs += (end - buf) * sizeof(T) * (shared ? 2 : 1);
         unsigned long nw = end - wr;
         fprintf(stderr, " %6ld writable %c,", nw, (nw < min_write) ? '!' : ' ');
-        T *rd = wr;
+        T *w = shared ? rwr.load() : wr;
+        T *rd = w;
         for (int j = 0; j < nrd; ++j)
             if (rds[j] < rd)
                 rd = rds[j];
-        fprintf(stderr, " %6d unread (", (int)(wr - rd));
+        fprintf(stderr, " %6d unread (", (int)(w - rd));
         for (int j = 0; j < nrd; ++j)
-            fprintf(stderr, " %d", (int)(wr - rds[j]));
-        fprintf(stderr, " )\n");
+            fprintf(stderr, " %d", (int)(w - rds[j]));
+        if (shared)
+            fprintf(stderr, " ) %6d pending\n", (int)(wr - xfer));
+        else
+            fprintf(stderr, " )\n");
     }
     unsigned long min_write;
     unsigned long total_written, total_read;
-#ifdef DEBUG
     ~pipebuf()
     {
+#ifdef DEBUG
         fprintf(stderr, "Deallocating %s !\n", name);
-    }
 #endif
+        delete[] rbuf;
+    }
 };
 
 template <typename T>
@@ -291,12 +724,17 @@ struct pipewriter
     {
         if (min_write > buf.min_write)
             buf.min_write = min_write;
+        buf.writer_group = buf.sch->get_group();
     }
     // Return number of items writable at this->wr, 0 if full.
     long writable()
     {
         if (buf.end < buf.min_write + buf.wr)
+        {
+            if (buf.shared)
+                buf.flush();
             buf.pack();
+        }
         return buf.end - buf.wr;
     }
 
@@ -352,11 +790,18 @@ struct pipereader
 
     pipereader(pipebuf<T> &_buf) : buf(_buf), id(_buf.add_reader())
     {
+        buf.add_reader_group(buf.sch->get_group());
     }
 
     long readable()
     {
-        return buf.wr - buf.rds[id];
+        if (!buf.shared)
+            return buf.wr - buf.rds[id];
+        T *w = buf.rwr.load(std::memory_order_acquire);
+        // Keep room for the writer once half of the reader side is filled
+        if ((buf.rend - w) < (buf.rend - buf.rbuf) / 2 && buf.pack_reader())
+            w = buf.rwr.load(std::memory_order_relaxed);
+        return w - buf.rds[id];
     }
 
     T *rd()
@@ -366,7 +811,7 @@ struct pipereader
 
     void read(unsigned long n)
     {
-        if (buf.rds[id] + n > buf.wr)
+        if (buf.rds[id] + n > (buf.shared ? buf.rwr.load(std::memory_order_relaxed) : buf.wr))
         {
             fprintf(stderr, "Bug: underflow from %s\n", buf.name);
         }
@@ -0,0 +1,218 @@
+#include <string.h>
+
+#include "util/cpufeatures.h"
+#include "ldpc_minsum.h"
+
+namespace leansdr
+{
+
+// Constant initialized so that it is valid before the dynamic initialization of current_kernel
+ldpc_minsum_decoder::decode_fn ldpc_minsum_decoder::decode_kernel = ldpc_minsum_decoder::decode_scalar;
+ldpc_minsum_decoder::kernel ldpc_minsum_decoder::current_kernel = ldpc_minsum_decoder::select_best();
+
+ldpc_minsum_decoder::ldpc_minsum_decoder()
+    : max_iterations(25),
+      llr_shift(1),
+      llr(nullptr),
+      msgs(nullptr),
+      iterations(0)
+{
+}
+
+uint32_t ldpc_minsum_decoder::decode(const ldpc_minsum_code &code, const int8_t *const frames[], int nframes)
+{
+    if (nframes > LANES)
+        nframes = LANES;
+    // SIMD kernels use aligned loads
+    llr_storage.resize((code.n + 1) * LANES);
+    msgs_storage.resize((code.nedges + 1) * LANES);
+    llr = (int8_t *)(((uintptr_t)llr_storage.data() + LANES - 1) & ~(uintptr_t)(LANES - 1));
+    msgs = (int8_t *)(((uintptr_t)msgs_storage.data() + LANES - 1) & ~(uintptr_t)(LANES - 1));
+    int div = 1 << llr_shift;
+    int8_t *pl = llr;
+    for (int v = 0; v < code.n; ++v, pl += LANES)
+    {
+        for (int f = 0; f < nframes; ++f)
+        {
+            int l = frames[f][v] / div;
+            pl[f] = (l < -127) ? -127 : l;
+        }
+        // Unused lanes get the all zeros codeword which is always valid.
+        for (int f = nframes; f < LANES; ++f)
+            pl[f] = 127 / div;
+    }
+    uint32_t failed = decode_kernel(code, llr, msgs, max_iterations, &iterations);
+    return (nframes < LANES) ? failed & ((1u << nframes) - 1) : failed;
+}
+
+void ldpc_minsum_decoder::harden(int frame, int nbits, uint8_t *out) const
+{
+    const int8_t *pl = llr + frame;
+    for (int i = 0; i < nbits / 8; ++i, ++out)
+    {
+        uint8_t b = 0;
+        for (int j = 0; j < 8; ++j, pl += LANES)
+            b = (b << 1) | (*pl < 0);
+        *out = b;
+    }
+}
+
+bool ldpc_minsum_decoder::is_supported(kernel k)
+{
+    switch (k)
+    {
+    case KERNEL_SCALAR:
+        return true;
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KERNEL_SSE41:
+        return CPUFeatures::hasSSE41();
+    case KERNEL_AVX2:
+        return CPUFeatures::hasAVX2();
+#endif
+    default:
+        return false;
+    }
+}
+
+bool ldpc_minsum_decoder::set_kernel(kernel k)
+{
+    if (!is_supported(k))
+        return false;
+    switch (k)
+    {
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KERNEL_SSE41:
+        decode_kernel = decode_sse41;
+        break;
+    case KERNEL_AVX2:
+        decode_kernel = decode_avx2;
+        break;
+#endif
+    default:
+        decode_kernel = decode_scalar;
+        break;
+    }
+    current_kernel = k;
+    return true;
+}
+
+const char *ldpc_minsum_decoder::kernel_name(kernel k)
+{
+    switch (k)
+    {
+    case KERNEL_SCALAR:
+        return "scalar";
+    case KERNEL_SSE41:
+        return "SSE4.1";
+    case KERNEL_AVX2:
+        return "AVX2";
+    default:
+        return "unknown";
+    }
+}
+
+ldpc_minsum_decoder::kernel ldpc_minsum_decoder::select_best()
+{
+    if (set_kernel(KERNEL_AVX2))
+        return KERNEL_AVX2;
+    if (set_kernel(KERNEL_SSE41))
+        return KERNEL_SSE41;
+    return KERNEL_SCALAR;
+}
+
+// Reference implementation. The SIMD kernels do exactly the same per lane.
+
+static inline int8_t minsum_sat(int v)
+{
+    return (v < -127) ? -127 : (v > 127) ? 127 : v;
+}
+
+static uint32_t minsum_syndrome_scalar(const ldpc_minsum_code &code, const int8_t *llr)
+{
+    const int LANES = ldpc_minsum_decoder::LANES;
+    uint8_t acc[LANES];
+    memset(acc, 0, sizeof(acc));
+    const uint32_t *pv = code.edge_var.data();
+    for (int c = 0; c < code.nchecks(); ++c)
+    {
+        uint8_t x[LANES];
+        memset(x, 0, sizeof(x));
+        for (int e = code.check_edges[c]; e < code.check_edges[c + 1]; ++e)
+        {
+            const int8_t *pl = llr + pv[e] * LANES;
+            for (int l = 0; l < LANES; ++l)
+                x[l] ^= pl[l];
+        }
+        for (int l = 0; l < LANES; ++l)
+            acc[l] |= x[l];
+    }
+    uint32_t failed = 0;
+    for (int l = 0; l < LANES; ++l)
+        failed |= (uint32_t)(acc[l] >> 7) << l;
+    return failed;
+}
+
+uint32_t ldpc_minsum_decoder::decode_scalar(const ldpc_minsum_code &code, int8_t *llr, int8_t *msgs,
+                                            int max_iterations, int *iterations)
+{
+    *iterations = 0;
+    uint32_t failed = minsum_syndrome_scalar(code, llr);
+    if (!failed)
+        return 0;
+    memset(msgs, 0, code.nedges * LANES);
+    const uint32_t *pv = code.edge_var.data();
+    int8_t t[ldpc_minsum_code::MAX_DEGREE][LANES];
+
+    for (int it = 0; it < max_iterations && failed; ++it)
+    {
+        int8_t *pm = msgs;
+        for (int c = 0; c < code.nchecks(); ++c)
+        {
+            int first = code.check_edges[c];
+            int degree = code.check_edges[c + 1] - first;
+            uint8_t min1[LANES], min2[LANES], sign[LANES];
+            memset(min1, 127, sizeof(min1));
+            memset(min2, 127, sizeof(min2));
+            memset(sign, 0, sizeof(sign));
+            // Remove the previous message of this check from the variable nodes.
+            // Saturated variable nodes are kept as they are: their previous
+            // message cannot be removed exactly and they are reliable anyway.
+            for (int e = 0; e < degree; ++e)
+            {
+                const int8_t *pl = llr + pv[first + e] * LANES;
+                const int8_t *pr = pm + e * LANES;
+                for (int l = 0; l < LANES; ++l)
+                {
+                    int8_t v = (pl[l] == 127 || pl[l] == -127) ? pl[l] : minsum_sat(pl[l] - pr[l]);
+                    uint8_t a = (v < 0) ? -v : v;
+                    t[e][l] = v;
+                    sign[l] ^= v;
+                    min2[l] = (a < min1[l]) ? min1[l] : (a < min2[l]) ? a : min2[l];
+                    min1[l] = (a < min1[l]) ? a : min1[l];
+                }
+            }
+            // New messages, scaled by 3/4, and updated variable nodes.
+            for (int e = 0; e < degree; ++e)
+            {
+                int8_t *pl = llr + pv[first + e] * LANES;
+                int8_t *pr = pm + e * LANES;
+                for (int l = 0; l < LANES; ++l)
+                {
+                    uint8_t a = (t[e][l] < 0) ? -t[e][l] : t[e][l];
+                    uint8_t m = (a == min1[l]) ? min2[l] : min1[l];
+                    m -= m >> 2;
+                    int8_t r = ((sign[l] ^ t[e][l]) & 128) ? -m : m;
+                    pr[l] = r;
+                    pl[l] = minsum_sat(t[e][l] + r);
+                }
+            }
+            pm += degree * LANES;
+        }
+        *iterations = it + 1;
+        failed = minsum_syndrome_scalar(code, llr);
+    }
+
+    return failed;
+}
+
+} // namespace leansdr
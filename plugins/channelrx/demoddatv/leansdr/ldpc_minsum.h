@@ -0,0 +1,169 @@
+// This file is part of LeanSDR Copyright (C) 2016-2018 <pabr@pabr.org>.
+// See the toplevel README for more information.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef LEANSDR_LDPC_MINSUM_H
+#define LEANSDR_LDPC_MINSUM_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace leansdr
+{
+
+// LAYERED NORMALIZED MIN-SUM LDPC DECODER
+//
+// Soft decoder for the S2-style LDPC codes of ldpc.h. Each check node is
+// processed in turn (layered schedule) with 8-bit saturating LLRs
+// (log p(0)/p(1), clipped to +-127 like llr_t) and check messages
+// scaled by 3/4.
+//
+// Up to LANES frames of the same code are decoded together. Data is
+// interleaved by frame: the LLRs of bit v of all the frames are
+// contiguous so that one SIMD register holds the same bit of several
+// frames and the whole code structure is shared by the lanes. The layout
+// does not depend on the kernel so all kernels give bit identical results.
+//
+// Kernels live in their own translation units compiled with the
+// corresponding instruction set (ldpc_minsum_sse41.cpp, ldpc_minsum_avx2.cpp)
+// and are selected at runtime from the CPU features.
+
+// Code structure: list of the variable nodes connected to each check node.
+// Codeword bits are the k message bits followed by the n-k parity bits.
+// With the S2 "integrated" parity, check c involves message bits from the
+// table and parity bits c and c-1.
+
+struct ldpc_minsum_code
+{
+    static const int MAX_DEGREE = 64; // Max edges per check node
+
+    int k;      // Message size in bits
+    int n;      // Codeword size in bits
+    int nedges; // Total number of edges
+    std::vector<int> check_edges;   // [n-k+1] offset of the first edge of each check node
+    std::vector<uint32_t> edge_var; // [nedges] variable node of each edge
+
+    ldpc_minsum_code() : k(0), n(0), nedges(0) {}
+
+    int nchecks() const { return n - k; }
+
+    // Build from a S2-style table (see ldpc_table in ldpc.h).
+    // Returns false if the table does not match k and n.
+    template <typename TABLE>
+    bool init(const TABLE *table, int _k, int _n)
+    {
+        k = _k;
+        n = _n;
+        int n_k = n - k;
+        if (k != table->nrows * 360 || table->q * 360 != n_k)
+            return false;
+        // Message bits connected to each check node
+        std::vector<std::vector<uint32_t>> checks(n_k);
+        int m = 0;
+        for (int r = 0; r < table->nrows; ++r)
+        {
+            int q = table->q;
+            int qoffs = 0;
+            for (int mw = 360; mw--; ++m, qoffs += q)
+            {
+                for (int nc = 0; nc < table->rows[r].ncols; ++nc)
+                {
+                    int a = (int)table->rows[r].cols[nc] + qoffs;
+                    if (a >= n_k)
+                        a -= n_k; // Modulo n-k. Note qoffs<360*q.
+                    if (a >= n_k)
+                        return false;
+                    checks[a].push_back(m);
+                }
+            }
+        }
+        check_edges.resize(n_k + 1);
+        edge_var.clear();
+        for (int c = 0; c < n_k; ++c)
+        {
+            check_edges[c] = edge_var.size();
+            edge_var.insert(edge_var.end(), checks[c].begin(), checks[c].end());
+            edge_var.push_back(k + c);
+            if (c)
+                edge_var.push_back(k + c - 1);
+            if ((int)edge_var.size() - check_edges[c] > MAX_DEGREE)
+                return false;
+        }
+        check_edges[n_k] = edge_var.size();
+        nedges = edge_var.size();
+        return true;
+    }
+};
+
+struct ldpc_minsum_decoder
+{
+    static const int LANES = 32; // Frames decoded together
+
+    enum kernel
+    {
+        KERNEL_SCALAR,
+        KERNEL_SSE41,
+        KERNEL_AVX2,
+        KERNEL_COUNT
+    };
+
+    // Decode the frames interleaved in llr[n][LANES] in place. msgs[nedges][LANES]
+    // is scratch for the check node messages. Stops as soon as all the parity
+    // checks are satisfied or after max_iterations iterations. Returns the
+    // bitmap of the lanes which still fail a parity check and the number of
+    // iterations done in *iterations (0 if the input was already a codeword).
+    typedef uint32_t (*decode_fn)(const ldpc_minsum_code &code, int8_t *llr, int8_t *msgs,
+                                  int max_iterations, int *iterations);
+
+    int max_iterations;
+    int llr_shift; // Input LLRs are divided by 2^llr_shift to leave headroom.
+
+    ldpc_minsum_decoder();
+
+    // frames: nframes (<= LANES) codewords of n LLRs in transmission order
+    // (e.g. the bytes of fecframe<llr_sb>).
+    // Returns the bitmap of the frames which still fail a parity check.
+    uint32_t decode(const ldpc_minsum_code &code, const int8_t *const frames[], int nframes);
+    // Hard decision of the first nbits bits of a frame, MSB first (hard_sb).
+    void harden(int frame, int nbits, uint8_t *out) const;
+    int get_iterations() const { return iterations; } // Of the last decode()
+
+    static bool is_supported(kernel k); // Compiled in and supported by the CPU
+    static bool set_kernel(kernel k);   // Returns false and keeps the current one if not supported
+    static kernel get_kernel() { return current_kernel; }
+    static const char *kernel_name(kernel k);
+
+  private:
+    std::vector<int8_t> llr_storage;
+    std::vector<int8_t> msgs_storage;
+    int8_t *llr;  // [n][LANES] aligned on LANES bytes
+    int8_t *msgs; // [nedges][LANES] aligned on LANES bytes
+    int iterations;
+
+    static decode_fn decode_kernel;
+    static kernel current_kernel;
+    static kernel select_best();
+
+    static uint32_t decode_scalar(const ldpc_minsum_code &code, int8_t *llr, int8_t *msgs,
+                                  int max_iterations, int *iterations);
+    static uint32_t decode_sse41(const ldpc_minsum_code &code, int8_t *llr, int8_t *msgs,
+                                 int max_iterations, int *iterations);
+    static uint32_t decode_avx2(const ldpc_minsum_code &code, int8_t *llr, int8_t *msgs,
+                                int max_iterations, int *iterations);
+};
+
+} // namespace leansdr
+
+#endif // LEANSDR_LDPC_MINSUM_H
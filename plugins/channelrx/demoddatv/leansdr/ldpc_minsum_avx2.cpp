@@ -0,0 +1,78 @@
+// Compiled with AVX2 enabled. Only intrinsics here (see ldpc_minsum.h).
+// One register holds the same bit of the 32 frames.
+
+#include <string.h>
+#include <immintrin.h>
+
+#include "ldpc_minsum.h"
+
+namespace leansdr
+{
+
+static uint32_t minsum_syndrome_avx2(const ldpc_minsum_code &code, const int8_t *llr)
+{
+    __m256i acc = _mm256_setzero_si256();
+    const uint32_t *pv = code.edge_var.data();
+    for (int c = 0; c < code.nchecks(); ++c)
+    {
+        __m256i x = _mm256_setzero_si256();
+        for (int e = code.check_edges[c]; e < code.check_edges[c + 1]; ++e)
+            x = _mm256_xor_si256(x, _mm256_load_si256((const __m256i *)(llr + pv[e] * 32)));
+        acc = _mm256_or_si256(acc, x);
+    }
+    return (uint32_t)_mm256_movemask_epi8(acc);
+}
+
+uint32_t ldpc_minsum_decoder::decode_avx2(const ldpc_minsum_code &code, int8_t *llr, int8_t *msgs,
+                                          int max_iterations, int *iterations)
+{
+    *iterations = 0;
+    uint32_t failed = minsum_syndrome_avx2(code, llr);
+    if (!failed)
+        return 0;
+    memset(msgs, 0, code.nedges * LANES);
+    const uint32_t *pv = code.edge_var.data();
+    const __m256i m127 = _mm256_set1_epi8(-127);
+    const __m256i p127 = _mm256_set1_epi8(127);
+    const __m256i one = _mm256_set1_epi8(1);
+    const __m256i low6 = _mm256_set1_epi8(0x3f);
+    __m256i t[ldpc_minsum_code::MAX_DEGREE];
+
+    for (int it = 0; it < max_iterations && failed; ++it)
+    {
+        __m256i *pm = (__m256i *)msgs;
+        for (int c = 0; c < code.nchecks(); ++c)
+        {
+            const uint32_t *pe = pv + code.check_edges[c];
+            int degree = code.check_edges[c + 1] - code.check_edges[c];
+            __m256i min1 = p127, min2 = p127, sign = _mm256_setzero_si256();
+            for (int e = 0; e < degree; ++e)
+            {
+                __m256i l = _mm256_load_si256((const __m256i *)(llr + pe[e] * 32));
+                __m256i v = _mm256_max_epi8(_mm256_subs_epi8(l, _mm256_load_si256(pm + e)), m127);
+                v = _mm256_blendv_epi8(v, l, _mm256_cmpeq_epi8(_mm256_abs_epi8(l), p127)); // saturated nodes kept
+                __m256i a = _mm256_abs_epi8(v);
+                t[e] = v;
+                sign = _mm256_xor_si256(sign, v);
+                min2 = _mm256_min_epu8(min2, _mm256_max_epu8(min1, a));
+                min1 = _mm256_min_epu8(min1, a);
+            }
+            for (int e = 0; e < degree; ++e)
+            {
+                __m256i a = _mm256_abs_epi8(t[e]);
+                __m256i m = _mm256_blendv_epi8(min1, min2, _mm256_cmpeq_epi8(a, min1));
+                m = _mm256_sub_epi8(m, _mm256_and_si256(_mm256_srli_epi16(m, 2), low6));
+                __m256i r = _mm256_sign_epi8(m, _mm256_or_si256(_mm256_xor_si256(sign, t[e]), one));
+                _mm256_store_si256(pm + e, r);
+                _mm256_store_si256((__m256i *)(llr + pe[e] * 32), _mm256_max_epi8(_mm256_adds_epi8(t[e], r), m127));
+            }
+            pm += degree;
+        }
+        *iterations = it + 1;
+        failed = minsum_syndrome_avx2(code, llr);
+    }
+
+    return failed;
+}
+
+} // namespace leansdr
@@ -0,0 +1,95 @@
+// Compiled with SSE4.1 enabled. Only intrinsics here (see ldpc_minsum.h).
+// The 32 frames are held in two registers: lanes 0-15 and lanes 16-31.
+
+#include <string.h>
+#include <smmintrin.h>
+
+#include "ldpc_minsum.h"
+
+namespace leansdr
+{
+
+static uint32_t minsum_syndrome_sse41(const ldpc_minsum_code &code, const int8_t *llr)
+{
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    const uint32_t *pv = code.edge_var.data();
+    for (int c = 0; c < code.nchecks(); ++c)
+    {
+        __m128i x0 = _mm_setzero_si128();
+        __m128i x1 = _mm_setzero_si128();
+        for (int e = code.check_edges[c]; e < code.check_edges[c + 1]; ++e)
+        {
+            const __m128i *pl = (const __m128i *)(llr + pv[e] * 32);
+            x0 = _mm_xor_si128(x0, _mm_load_si128(pl));
+            x1 = _mm_xor_si128(x1, _mm_load_si128(pl + 1));
+        }
+        acc0 = _mm_or_si128(acc0, x0);
+        acc1 = _mm_or_si128(acc1, x1);
+    }
+    return (uint32_t)_mm_movemask_epi8(acc0) | ((uint32_t)_mm_movemask_epi8(acc1) << 16);
+}
+
+uint32_t ldpc_minsum_decoder::decode_sse41(const ldpc_minsum_code &code, int8_t *llr, int8_t *msgs,
+                                           int max_iterations, int *iterations)
+{
+    *iterations = 0;
+    uint32_t failed = minsum_syndrome_sse41(code, llr);
+    if (!failed)
+        return 0;
+    memset(msgs, 0, code.nedges * LANES);
+    const uint32_t *pv = code.edge_var.data();
+    const __m128i m127 = _mm_set1_epi8(-127);
+    const __m128i p127 = _mm_set1_epi8(127);
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i low6 = _mm_set1_epi8(0x3f);
+    __m128i t[ldpc_minsum_code::MAX_DEGREE][2];
+
+    for (int it = 0; it < max_iterations && failed; ++it)
+    {
+        __m128i *pm = (__m128i *)msgs;
+        for (int c = 0; c < code.nchecks(); ++c)
+        {
+            const uint32_t *pe = pv + code.check_edges[c];
+            int degree = code.check_edges[c + 1] - code.check_edges[c];
+            __m128i min1[2] = {p127, p127};
+            __m128i min2[2] = {p127, p127};
+            __m128i sign[2] = {_mm_setzero_si128(), _mm_setzero_si128()};
+            for (int e = 0; e < degree; ++e)
+            {
+                const __m128i *pl = (const __m128i *)(llr + pe[e] * 32);
+                for (int h = 0; h < 2; ++h)
+                {
+                    __m128i l = _mm_load_si128(pl + h);
+                    __m128i v = _mm_max_epi8(_mm_subs_epi8(l, _mm_load_si128(pm + 2 * e + h)), m127);
+                    v = _mm_blendv_epi8(v, l, _mm_cmpeq_epi8(_mm_abs_epi8(l), p127)); // saturated nodes kept
+                    __m128i a = _mm_abs_epi8(v);
+                    t[e][h] = v;
+                    sign[h] = _mm_xor_si128(sign[h], v);
+                    min2[h] = _mm_min_epu8(min2[h], _mm_max_epu8(min1[h], a));
+                    min1[h] = _mm_min_epu8(min1[h], a);
+                }
+            }
+            for (int e = 0; e < degree; ++e)
+            {
+                __m128i *pl = (__m128i *)(llr + pe[e] * 32);
+                for (int h = 0; h < 2; ++h)
+                {
+                    __m128i a = _mm_abs_epi8(t[e][h]);
+                    __m128i m = _mm_blendv_epi8(min1[h], min2[h], _mm_cmpeq_epi8(a, min1[h]));
+                    m = _mm_sub_epi8(m, _mm_and_si128(_mm_srli_epi16(m, 2), low6));
+                    __m128i r = _mm_sign_epi8(m, _mm_or_si128(_mm_xor_si128(sign[h], t[e][h]), one));
+                    _mm_store_si128(pm + 2 * e + h, r);
+                    _mm_store_si128(pl + h, _mm_max_epi8(_mm_adds_epi8(t[e][h], r), m127));
+                }
+            }
+            pm += 2 * degree;
+        }
+        *iterations = it + 1;
+        failed = minsum_syndrome_sse41(code, llr);
+    }
+
+    return failed;
+}
+
+} // namespace leansdr
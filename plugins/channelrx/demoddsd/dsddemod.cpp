@@ -56,7 +56,6 @@ DSDDemod::DSDDemod(DeviceAPI *deviceAPI) :
         m_deviceAPI(deviceAPI),
         m_inputSampleRate(48000),
         m_inputFrequencyOffset(0),
-        m_interpolatorDistance(0.0f),
         m_interpolatorDistanceRemain(0.0f),
         m_sampleCount(0),
         m_squelchCount(0),
@@ -69,8 +68,7 @@ DSDDemod::DSDDemod(DeviceAPI *deviceAPI) :
         m_scopeXY(0),
         m_scopeEnabled(true),
         m_dsdDecoder(),
-        m_signalFormat(signalFormatNone),
-        m_settingsMutex(QMutex::Recursive)
+        m_signalFormat(signalFormatNone)
 {
 	setObjectName(m_channelId);
 
@@ -128,7 +126,26 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	Complex ci;
 	int samplesPerSymbol = m_dsdDecoder.getSamplesPerSymbol();
 
-	m_settingsMutex.lock();
+    if (m_settingsSnapshot.update())
+    {
+        const DSDDemodSettings& settings = m_settingsSnapshot.get();
+        int squelchGate = 480 * settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
+
+        if (squelchGate != m_squelchGate)
+        {
+            m_squelchGate = squelchGate;
+            m_squelchCount = 0; // reset squelch open counter
+        }
+
+        m_squelchLevel = std::pow(10.0, settings.m_squelch / 10.0); // input is a value in dB
+    }
+
+    if (m_interpolation.update()) {
+        m_interpolatorDistanceRemain = 0;
+    }
+
+    const DSDDemodSettings& settings = m_settingsSnapshot.get();
+    Interpolation& interpolation = m_interpolation.get();
 	m_scopeSampleBuffer.clear();
 
 	m_dsdDecoder.enableMbelib(!DSPEngine::instance()->hasDVSerialSupport()); // disable mbelib if DV serial support is present and activated else enable it
@@ -138,7 +155,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
-        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
+        if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
         {
             FixReal sample, delayedSample;
             qint16 sampleDSD;
@@ -157,7 +174,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
             m_magsqCount++;
 
-            Real demod = m_phaseDiscri.phaseDiscriminator(ci) * m_settings.m_demodGain; // [-1.0:1.0]
+            Real demod = m_phaseDiscri.phaseDiscriminator(ci) * settings.m_demodGain; // [-1.0:1.0]
             m_sampleCount++;
 
             // AF processing
@@ -217,7 +234,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
             m_dsdDecoder.pushSample(sampleDSD);
 
-            if (m_settings.m_enableCosineFiltering) { // show actual input to FSK demod
+            if (settings.m_enableCosineFiltering) { // show actual input to FSK demod
             	sample = m_dsdDecoder.getFilteredSample() * m_scaleFromShort;
             }
 
@@ -235,7 +252,7 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
                 delayedSample = m_sampleBuffer[m_sampleBufferIndex - samplesPerSymbol];
             }
 
-            if (m_settings.m_syncOrConstellation)
+            if (settings.m_syncOrConstellation)
             {
                 Sample s(sample, m_dsdDecoder.getSymbolSyncSample() * m_scaleFromShort * 0.84);
                 m_scopeSampleBuffer.push_back(s);
@@ -248,16 +265,16 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 
             if (DSPEngine::instance()->hasDVSerialSupport())
             {
-                if ((m_settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
+                if ((settings.m_slot1On) && m_dsdDecoder.mbeDVReady1())
                 {
-                    if (!m_settings.m_audioMute)
+                    if (!settings.m_audioMute)
                     {
                         DSPEngine::instance()->pushMbeFrame(
                                 m_dsdDecoder.getMbeDVFrame1(),
                                 m_dsdDecoder.getMbeRateIndex(),
-                                m_settings.m_volume * 10.0,
-                                m_settings.m_tdmaStereo ? 1 : 3, // left or both channels
-                                m_settings.m_highPassFilter,
+                                settings.m_volume * 10.0,
+                                settings.m_tdmaStereo ? 1 : 3, // left or both channels
+                                settings.m_highPassFilter,
                                 m_audioSampleRate/8000, // upsample from native 8k
                                 &m_audioFifo1);
                     }
@@ -265,16 +282,16 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
                     m_dsdDecoder.resetMbeDV1();
                 }
 
-                if ((m_settings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
+                if ((settings.m_slot2On) && m_dsdDecoder.mbeDVReady2())
                 {
-                    if (!m_settings.m_audioMute)
+                    if (!settings.m_audioMute)
                     {
                         DSPEngine::instance()->pushMbeFrame(
                                 m_dsdDecoder.getMbeDVFrame2(),
                                 m_dsdDecoder.getMbeRateIndex(),
-                                m_settings.m_volume * 10.0,
-                                m_settings.m_tdmaStereo ? 2 : 3, // right or both channels
-                                m_settings.m_highPassFilter,
+                                settings.m_volume * 10.0,
+                                settings.m_tdmaStereo ? 2 : 3, // right or both channels
+                                settings.m_highPassFilter,
                                 m_audioSampleRate/8000, // upsample from native 8k
                                 &m_audioFifo2);
                     }
@@ -293,20 +310,20 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 //                m_dsdDecoder.resetMbeDV1();
 //            }
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
+            m_interpolatorDistanceRemain += interpolation.m_distance;
         }
 	}
 
 	if (!DSPEngine::instance()->hasDVSerialSupport())
 	{
-	    if (m_settings.m_slot1On)
+	    if (settings.m_slot1On)
 	    {
 	        int nbAudioSamples;
 	        short *dsdAudio = m_dsdDecoder.getAudio1(nbAudioSamples);
 
 	        if (nbAudioSamples > 0)
 	        {
-	            if (!m_settings.m_audioMute) {
+	            if (!settings.m_audioMute) {
 	                m_audioFifo1.write((const quint8*) dsdAudio, nbAudioSamples);
 	            }
 
@@ -314,14 +331,14 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	        }
 	    }
 
-        if (m_settings.m_slot2On)
+        if (settings.m_slot2On)
         {
             int nbAudioSamples;
             short *dsdAudio = m_dsdDecoder.getAudio2(nbAudioSamples);
 
             if (nbAudioSamples > 0)
             {
-                if (!m_settings.m_audioMute) {
+                if (!settings.m_audioMute) {
                     m_audioFifo2.write((const quint8*) dsdAudio, nbAudioSamples);
                 }
 
@@ -346,8 +363,6 @@ void DSDDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
     {
         m_scopeXY->feed(m_scopeSampleBuffer.begin(), m_scopeSampleBuffer.end(), true); // true = real samples for what it's worth
     }
-
-	m_settingsMutex.unlock();
 }
 
 void DSDDemod::start()
@@ -456,13 +471,8 @@ void DSDDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
         m_nco.setFreq(-inputFrequencyOffset, inputSampleRate);
     }
 
-    if ((inputSampleRate != m_inputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, (m_settings.m_rfBandwidth) / 2.2);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) inputSampleRate / (Real) 48000;
-        m_settingsMutex.unlock();
+    if ((inputSampleRate != m_inputSampleRate) || force) {
+        publishInterpolation(inputSampleRate, m_settings.m_rfBandwidth);
     }
 
     m_inputSampleRate = inputSampleRate;
@@ -524,12 +534,8 @@ void DSDDemod::applySettings(const DSDDemodSettings& settings, bool force)
     if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         reverseAPIKeys.append("rfBandwidth");
-        m_settingsMutex.lock();
-        m_interpolator.create(16, m_inputSampleRate, (settings.m_rfBandwidth) / 2.2);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) 48000;
-        //m_phaseDiscri.setFMScaling((float) settings.m_rfBandwidth / (float) settings.m_fmDeviation);
-        m_settingsMutex.unlock();
+        publishInterpolation(m_inputSampleRate, settings.m_rfBandwidth);
+        //m_phaseDiscri.setFMScaling((float) m_settings.m_rfBandwidth / (float) m_settings.m_fmDeviation);
     }
 
     if ((settings.m_fmDeviation != m_settings.m_fmDeviation) || force)
@@ -538,18 +544,13 @@ void DSDDemod::applySettings(const DSDDemodSettings& settings, bool force)
         m_phaseDiscri.setFMScaling(48000.0f / (2.0f*settings.m_fmDeviation));
     }
 
-    if ((settings.m_squelchGate != m_settings.m_squelchGate) || force)
-    {
+    // squelch gate and level are set by the DSP thread when it picks up the settings
+    if ((settings.m_squelchGate != m_settings.m_squelchGate) || force) {
         reverseAPIKeys.append("squelchGate");
-        m_squelchGate = 480 * settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
-        m_squelchCount = 0; // reset squelch open counter
     }
 
-    if ((settings.m_squelch != m_settings.m_squelch) || force)
-    {
+    if ((settings.m_squelch != m_settings.m_squelch) || force) {
         reverseAPIKeys.append("squelch");
-        // input is a value in dB
-        m_squelchLevel = std::pow(10.0, settings.m_squelch / 10.0);
     }
 
     if ((settings.m_volume != m_settings.m_volume) || force)
@@ -593,7 +594,7 @@ void DSDDemod::applySettings(const DSDDemodSettings& settings, bool force)
         reverseAPIKeys.append("audioDeviceName");
         AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
         int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
-        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(settings.m_audioDeviceName), audioDeviceIndex);
+        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(m_settings.m_audioDeviceName), audioDeviceIndex);
         audioDeviceManager->addAudioSink(&m_audioFifo1, getInputMessageQueue(), audioDeviceIndex);
         audioDeviceManager->addAudioSink(&m_audioFifo2, getInputMessageQueue(), audioDeviceIndex);
         uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
@@ -614,6 +615,15 @@ void DSDDemod::applySettings(const DSDDemodSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
+}
+
+void DSDDemod::publishInterpolation(int inputSampleRate, Real rfBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, inputSampleRate, rfBandwidth / 2.2);
+    interpolation->m_distance = (Real) inputSampleRate / (Real) 48000;
+    m_interpolation.publish(interpolation);
 }
 
 QByteArray DSDDemod::serialize() const
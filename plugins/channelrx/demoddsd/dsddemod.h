@@ -21,7 +21,6 @@
 
 #include <vector>
 
-#include <QMutex>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
@@ -37,6 +36,7 @@
 #include "audio/audiofifo.h"
 #include "util/message.h"
 #include "util/doublebufferfifo.h"
+#include "util/settingssnapshot.h"
 
 #include "dsddemodsettings.h"
 #include "dsddecoder.h"
@@ -215,6 +215,13 @@ private:
 		RSRunning
 	};
 
+    struct Interpolation //!< channel to 48 kS/s decoder input
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
 	DeviceAPI *m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
@@ -224,14 +231,16 @@ private:
 	DSDDemodSettings m_settings;
     quint32 m_audioSampleRate;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<DSDDemodSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+
 	NCO m_nco;
-	Interpolator m_interpolator;
-	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
 	int m_sampleCount;
 	int m_squelchCount;
-	int m_squelchGate;
-	double m_squelchLevel;
+	int m_squelchGate;    //!< DSP thread
+	double m_squelchLevel; //!< DSP thread
 	bool m_squelchOpen;
     DoubleBufferFIFO<Real> m_squelchDelayLine;
 
@@ -263,13 +272,12 @@ private:
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
-    QMutex m_settingsMutex;
-
     static const int m_udpBlockSize;
 
     void applyAudioSampleRate(int sampleRate);
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
 	void applySettings(const DSDDemodSettings& settings, bool force = false);
+    void publishInterpolation(int inputSampleRate, Real rfBandwidth);
 	void formatStatusText();
 
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const DSDDemodSettings& settings);
@@ -20,6 +20,7 @@
 
 #include <QTime>
 #include <QDebug>
+#include <QStringList>
 #include <stdio.h>
 
 #include "dsp/downchannelizer.h"
@@ -39,8 +40,7 @@ const QString LoRaDemod::m_channelId = "LoRaDemod";
 LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
         ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
         m_deviceAPI(deviceAPI),
-        m_sampleSink(0),
-        m_settingsMutex(QMutex::Recursive)
+        m_sampleSink(0)
 {
 	setObjectName(m_channelId);
 
@@ -48,24 +48,14 @@ LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
 	m_sampleRate = 96000;
 	m_frequency = 0;
 	m_nco.setFreq(m_frequency, m_sampleRate);
-	m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
+	publishInterpolation(m_sampleRate, m_Bandwidth);
 	m_sampleDistanceRemain = (Real)m_sampleRate / m_Bandwidth;
 
-	m_chirp = 0;
-	m_angle = 0;
-	m_bin = 0;
-	m_result = 0;
-	m_count = 0;
-	m_header = 0;
-	m_time = 0;
-	m_tune = 0;
-
-	loraFilter = new sfft(LORA_SFFT_LEN);
-	negaFilter = new sfft(LORA_SFFT_LEN);
+	for (unsigned int sf = LoRaSymbolDemod::m_minSpreadFactor; sf <= LoRaSymbolDemod::m_maxSpreadFactor; sf++) {
+		m_symbolDemods.push_back(new LoRaSymbolDemod(sf));
+	}
 
-	mov = new float[4*LORA_SFFT_LEN];
-	history = new short[1024];
-	finetune = new short[16];
+	m_symbolDemods[0]->setSpectrumBuffer(&m_sampleBuffer);
 
     m_channelizer = new DownChannelizer(this);
     m_threadedChannelizer = new ThreadedBasebandSampleSink(m_channelizer);
@@ -75,16 +65,9 @@ LoRaDemod::LoRaDemod(DeviceAPI* deviceAPI) :
 
 LoRaDemod::~LoRaDemod()
 {
-	if (loraFilter)
-		delete loraFilter;
-	if (negaFilter)
-		delete negaFilter;
-	if (mov)
-		delete [] mov;
-	if (history)
-		delete [] history;
-	if (finetune)
-		delete [] finetune;
+	for (std::vector<LoRaSymbolDemod*>::iterator it = m_symbolDemods.begin(); it != m_symbolDemods.end(); ++it) {
+		delete *it;
+	}
 
 	m_deviceAPI->removeChannelSinkAPI(this);
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
@@ -92,12 +75,13 @@ LoRaDemod::~LoRaDemod()
     delete m_channelizer;
 }
 
-void LoRaDemod::dumpRaw()
+// Text of the experimental 6 bit explicit mode of SF8 frames
+void LoRaDemod::dumpRaw(const std::vector<unsigned short>& symbols)
 {
-	short bin, j, max;
+	short j, max;
 	char text[256];
 
-	max = m_time / 4 - 3;
+	max = symbols.size();
 
 	if (max > 140)
 	{
@@ -106,8 +90,7 @@ void LoRaDemod::dumpRaw()
 
 	for ( j=0; j < max; j++)
 	{
-		bin = (history[(j + 1)  * 4] + m_tune ) & (LORA_SFFT_LEN - 1);
-		text[j] = toGray(bin >> 1);
+		text[j] = toGray(symbols[j] >> 2);
 	}
 
 	prng6(text, max);
@@ -135,149 +118,71 @@ void LoRaDemod::dumpRaw()
 	printf("%s\n", &text[1]);
 }
 
-short LoRaDemod::synch(short bin)
+void LoRaDemod::reportFrames(LoRaSymbolDemod *symbolDemod)
 {
-	short i, j;
+	const std::vector<std::vector<unsigned short>>& frames = symbolDemod->getFrames();
 
-	if (bin < 0)
+	for (std::vector<std::vector<unsigned short>>::const_iterator it = frames.begin(); it != frames.end(); ++it)
 	{
-		if (m_time > 70)
-		{
-			dumpRaw();
-		}
-
-		m_time = 0;
-		return -1;
-	}
+		QStringList symbols;
 
-	history[m_time] = bin;
-
-	if (m_time > 12)
-	{
-		if (bin == history[m_time - 6])
-		{
-			if (bin == history[m_time - 12])
-			{
-				m_tune = LORA_SFFT_LEN - bin;
-				j = 0;
-
-				for (i=0; i<12; i++)
-				{
-					j += finetune[15 & (m_time - i)];
-				}
-
-				if (j < 0)
-				{
-					m_tune += 1;
-				}
-
-				m_tune &= (LORA_SFFT_LEN - 1);
-				m_time = 0;
-				return -1;
-			}
+		for (std::vector<unsigned short>::const_iterator sit = it->begin(); sit != it->end(); ++sit) {
+			symbols.append(QString::number(*sit, 16));
 		}
-	}
 
-	m_time++;
-	m_time &= 1023;
+		qDebug("LoRaDemod::reportFrames: SF%u: %u symbols: %s",
+				symbolDemod->getSpreadFactor(), (unsigned int) it->size(), qPrintable(symbols.join(" ")));
 
-	if (m_time & 3)
-	{
-		return -1;
+		if ((symbolDemod->getSpreadFactor() == 8) && (it->size() > 17)) {
+			dumpRaw(*it);
+		}
 	}
 
-	return (bin + m_tune) & (LORA_SFFT_LEN - 1);
+	symbolDemod->clearFrames();
 }
 
-int LoRaDemod::detect(Complex c, Complex a)
+void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool pO)
 {
-	int p, q;
-	short i, result, negresult, movpoint;
-	float peak, negpeak, tfloat;
-	float mag[LORA_SFFT_LEN];
-	float rev[LORA_SFFT_LEN];
-
-	loraFilter->run(c * a);
-	negaFilter->run(c * conj(a));
-
-	// process spectrum twice in FFTLEN
-	if (++m_count & ((1 << DATA_BITS) - 1))
-	{
-		return m_result;
-	}
-
-	movpoint = 3 & (m_count >> DATA_BITS);
+    (void) pO;
+	Complex ci;
 
-	loraFilter->fetch(mag);
-	negaFilter->fetch(rev);
-	peak = negpeak = 0.0f;
-	result = negresult = 0;
+	m_sampleBuffer.clear();
+	m_channelBuffer.clear();
 
-	for (i = 0; i < LORA_SFFT_LEN; i++)
+	if (m_settingsSnapshot.update())
 	{
-		if (rev[i] > negpeak)
-		{
-			negpeak = rev[i];
-			negresult = i;
-		}
-
-		tfloat = mov[i] + mov[LORA_SFFT_LEN + i] +mov[2 * LORA_SFFT_LEN + i]
-				+ mov[3 * LORA_SFFT_LEN + i] + mag[i];
+		int spread = m_settingsSnapshot->m_spread;
 
-		if (tfloat > peak)
-		{
-			peak = tfloat;
-			result = i;
+		for (unsigned int i = 0; i < m_symbolDemods.size(); i++) {
+			m_symbolDemods[i]->setSpectrumBuffer((int) i == spread ? &m_sampleBuffer : nullptr);
 		}
-
-		mov[movpoint * LORA_SFFT_LEN + i] = mag[i];
 	}
 
-	p = (result - 1 + LORA_SFFT_LEN) & (LORA_SFFT_LEN -1);
-	q = (result + 1) & (LORA_SFFT_LEN -1);
-	finetune[15 & m_time] = (mag[p] > mag[q]) ? -1 : 1;
-
-	if (peak < negpeak * LORA_SQUELCH)
-	{
-		result = -1;
+	if (m_interpolation.update()) {
+		m_sampleDistanceRemain = m_interpolation->m_distance;
 	}
 
-	result = synch(result);
-
-	if (result >= 0)
-	{
-		m_result = result;
-	}
-
-	return m_result;
-}
-
-void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool pO)
-{
-    (void) pO;
-	int newangle;
-	Complex ci;
-
-	m_sampleBuffer.clear();
-
-	m_settingsMutex.lock();
+	Interpolation& interpolation = m_interpolation.get();
 
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
 		Complex c(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
 		c *= m_nco.nextIQ();
 
-		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
+		if(interpolation.m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
-			m_chirp = (m_chirp + 1) & (SPREADFACTOR - 1);
-                        m_angle = (m_angle + m_chirp) & (SPREADFACTOR - 1);
-			Complex cangle(cos(M_PI*2*m_angle/SPREADFACTOR),-sin(M_PI*2*m_angle/SPREADFACTOR));
-			newangle = detect(ci, cangle);
-
-			m_bin = (m_bin + newangle) & (LORA_SFFT_LEN - 1);
-			Complex nangle(cos(M_PI*2*m_bin/LORA_SFFT_LEN),sin(M_PI*2*m_bin/LORA_SFFT_LEN));
-			m_sampleBuffer.push_back(Sample(nangle.real() * 100, nangle.imag() * 100));
-			m_sampleDistanceRemain += (Real)m_sampleRate / m_Bandwidth;
+			m_channelBuffer.push_back(ci);
+			m_sampleDistanceRemain += interpolation.m_distance;
+		}
+	}
+
+	// all spreading factors from the same samples. The one displayed fills the spectrum buffer with its dechirped windows.
+	for (std::vector<LoRaSymbolDemod*>::iterator it = m_symbolDemods.begin(); it != m_symbolDemods.end(); ++it)
+	{
+		(*it)->process(m_channelBuffer.data(), m_channelBuffer.size());
+
+		if ((*it)->getFrames().size() > 0) {
+			reportFrames(*it);
 		}
 	}
 
@@ -285,8 +190,6 @@ void LoRaDemod::feed(const SampleVector::const_iterator& begin, const SampleVect
 	{
 		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), false);
 	}
-
-	m_settingsMutex.unlock();
 }
 
 void LoRaDemod::start()
@@ -305,14 +208,9 @@ bool LoRaDemod::handleMessage(const Message& cmd)
 	{
 		DownChannelizer::MsgChannelizerNotification& notif = (DownChannelizer::MsgChannelizerNotification&) cmd;
 
-		m_settingsMutex.lock();
-
 		m_sampleRate = notif.getSampleRate();
 		m_nco.setFreq(-notif.getFrequencyOffset(), m_sampleRate);
-		m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
-		m_sampleDistanceRemain = m_sampleRate / m_Bandwidth;
-
-		m_settingsMutex.unlock();
+		publishInterpolation(m_sampleRate, m_Bandwidth);
 
 		qDebug() << "LoRaDemod::handleMessage: MsgChannelizerNotification: m_sampleRate: " << m_sampleRate
 				<< " frequencyOffset: " << notif.getFrequencyOffset();
@@ -336,17 +234,16 @@ bool LoRaDemod::handleMessage(const Message& cmd)
 	{
 		MsgConfigureLoRaDemod& cfg = (MsgConfigureLoRaDemod&) cmd;
 
-		m_settingsMutex.lock();
-
 		LoRaDemodSettings settings = cfg.getSettings();
 
 		m_Bandwidth = LoRaDemodSettings::bandwidths[settings.m_bandwidthIndex];
-		m_interpolator.create(16, m_sampleRate, m_Bandwidth/1.9);
-
-		m_settingsMutex.unlock();
+		publishInterpolation(m_sampleRate, m_Bandwidth);
 
+		// the displayed spreading factor is selected by the DSP thread when it picks up the settings
 		m_settings = settings;
-		qDebug() << "LoRaDemod::handleMessage: MsgConfigureLoRaDemod: m_Bandwidth: " << m_Bandwidth;
+		m_settingsSnapshot.publish(settings);
+		qDebug() << "LoRaDemod::handleMessage: MsgConfigureLoRaDemod: m_Bandwidth: " << m_Bandwidth
+				<< " m_spread: " << settings.m_spread;
 
 		return true;
 	}
@@ -367,6 +264,14 @@ bool LoRaDemod::handleMessage(const Message& cmd)
 	}
 }
 
+void LoRaDemod::publishInterpolation(int sampleRate, Real bandwidth)
+{
+	Interpolation *interpolation = new Interpolation();
+	interpolation->m_interpolator.create(16, sampleRate, bandwidth/1.9);
+	interpolation->m_distance = (Real) sampleRate / bandwidth;
+	m_interpolation.publish(interpolation);
+}
+
 QByteArray LoRaDemod::serialize() const
 {
     return m_settings.serialize();
@@ -19,7 +19,6 @@
 #ifndef INCLUDE_LoRaDEMOD_H
 #define INCLUDE_LoRaDEMOD_H
 
-#include <QMutex>
 #include <vector>
 
 #include "dsp/basebandsamplesink.h"
@@ -27,15 +26,10 @@
 #include "dsp/nco.h"
 #include "dsp/interpolator.h"
 #include "util/message.h"
-#include "dsp/fftfilt.h"
+#include "util/settingssnapshot.h"
 
 #include "lorademodsettings.h"
-
-#define DATA_BITS (6)
-#define SAMPLEBITS (DATA_BITS + 2)
-#define SPREADFACTOR (1 << SAMPLEBITS)
-#define LORA_SFFT_LEN (SPREADFACTOR / 2)
-#define LORA_SQUELCH (3)
+#include "lorasymboldemod.h"
 
 class DeviceAPI;
 class ThreadedBasebandSampleSink;
@@ -120,13 +114,20 @@ public:
     static const QString m_channelId;
 
 private:
-	int  detect(Complex sample, Complex angle);
-	void dumpRaw(void);
-	short synch (short bin);
+    struct Interpolation //!< channel to one sample per chip
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+	void dumpRaw(const std::vector<unsigned short>& symbols);
+	void reportFrames(LoRaSymbolDemod *symbolDemod);
 	short toGray(short bin);
 	void interleave6(char* inout, int size);
 	void hamming6(char* inout, int size);
 	void prng6(char* inout, int size);
+	void publishInterpolation(int sampleRate, Real bandwidth);
 
 	DeviceAPI *m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
@@ -136,28 +137,19 @@ private:
 	Real m_Bandwidth;
 	int m_sampleRate;
 	int m_frequency;
-	int m_chirp;
-	int m_angle;
-	int m_bin;
-	int m_result;
-	int m_count;
-	int m_header;
-	int m_time;
-	short m_tune;
-
-	sfft* loraFilter;
-	sfft* negaFilter;
-	float* mov;
-	short* history;
-	short* finetune;
+
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<LoRaDemodSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+
+	std::vector<LoRaSymbolDemod*> m_symbolDemods; //!< one per spreading factor all run on the same channel samples
+	std::vector<Complex> m_channelBuffer;         //!< one sample per chip
 
 	NCO m_nco;
-	Interpolator m_interpolator;
 	Real m_sampleDistanceRemain;
 
 	BasebandSampleSink* m_sampleSink;
 	SampleVector m_sampleBuffer;
-	QMutex m_settingsMutex;
 };
 
 #endif // INCLUDE_LoRaDEMOD_H
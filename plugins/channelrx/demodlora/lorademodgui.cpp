@@ -99,7 +99,9 @@ void LoRaDemodGUI::on_BW_valueChanged(int value)
 
 void LoRaDemodGUI::on_Spread_valueChanged(int value)
 {
-    (void) value;
+    m_settings.m_spread = value;
+    ui->SpreadText->setText(tr("SF%1").arg(LoRaSymbolDemod::m_minSpreadFactor + value));
+    applySettings();
 }
 
 void LoRaDemodGUI::onWidgetRolled(QWidget* widget, bool rollDown)
@@ -190,5 +192,7 @@ void LoRaDemodGUI::displaySettings()
     blockApplySettings(true);
     ui->BWText->setText(QString("%1 Hz").arg(thisBW));
     ui->BW->setValue(m_settings.m_bandwidthIndex);
+    ui->SpreadText->setText(tr("SF%1").arg(LoRaSymbolDemod::m_minSpreadFactor + m_settings.m_spread));
+    ui->Spread->setValue(m_settings.m_spread);
     blockApplySettings(false);
 }
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/fftengine.h"
+#include "lorasymboldemod.h"
+
+const float LoRaSymbolDemod::m_detectionRatio = 10.0f;
+
+LoRaSymbolDemod::LoRaSymbolDemod(unsigned int spreadFactor) :
+    m_spreadFactor(spreadFactor),
+    m_nbSymbols(1 << spreadFactor),
+    m_windowFill(0),
+    m_skip(0),
+    m_state(StateDetect),
+    m_preambleBin(0),
+    m_preambleCount(0),
+    m_syncCount(0),
+    m_downChirpCount(0),
+    m_weakCount(0),
+    m_spectrumBuffer(nullptr)
+{
+    m_fft = FFTEngine::create();
+    m_fft->configure(m_nbSymbols, false);
+    m_window.resize(m_nbSymbols);
+    m_upChirp.resize(m_nbSymbols);
+    m_downChirp.resize(m_nbSymbols);
+
+    // base up chirp at one sample per chip sweeping from -BW/2 to +BW/2
+    for (unsigned int n = 0; n < m_nbSymbols; n++)
+    {
+        double phase = M_PI * (((double) n * n) / m_nbSymbols - n);
+        phase = std::fmod(phase, 2.0 * M_PI);
+        m_upChirp[n] = Complex(std::cos(phase), std::sin(phase));
+        m_downChirp[n] = std::conj(m_upChirp[n]);
+    }
+
+    m_symbols.reserve(m_frameMaxSymbols);
+}
+
+LoRaSymbolDemod::~LoRaSymbolDemod()
+{
+    delete m_fft;
+}
+
+void LoRaSymbolDemod::process(const Complex *samples, unsigned int nbSamples)
+{
+    unsigned int i = 0;
+
+    while (i < nbSamples)
+    {
+        if (m_skip > 0)
+        {
+            unsigned int n = std::min(m_skip, nbSamples - i);
+            m_skip -= n;
+            i += n;
+            continue;
+        }
+
+        unsigned int n = std::min(m_nbSymbols - m_windowFill, nbSamples - i);
+        std::copy(samples + i, samples + i + n, m_window.begin() + m_windowFill);
+        m_windowFill += n;
+        i += n;
+
+        if (m_windowFill == m_nbSymbols)
+        {
+            m_windowFill = 0;
+            processWindow();
+        }
+    }
+}
+
+unsigned int LoRaSymbolDemod::dechirp(const std::vector<Complex>& chirp, float& ratio)
+{
+    Complex *in = m_fft->in();
+
+    for (unsigned int n = 0; n < m_nbSymbols; n++) {
+        in[n] = m_window[n] * chirp[n];
+    }
+
+    if (m_spectrumBuffer && (&chirp == &m_downChirp))
+    {
+        for (unsigned int n = 0; n < m_nbSymbols; n++) {
+            m_spectrumBuffer->push_back(Sample(in[n].real() * SDR_RX_SCALEF, in[n].imag() * SDR_RX_SCALEF));
+        }
+    }
+
+    m_fft->transform();
+    const Complex *out = m_fft->out();
+    unsigned int peakBin = 0;
+    float peak = 0.0f;
+    float sum = 0.0f;
+
+    for (unsigned int n = 0; n < m_nbSymbols; n++)
+    {
+        float magsq = out[n].real() * out[n].real() + out[n].imag() * out[n].imag();
+        sum += magsq;
+
+        if (magsq > peak)
+        {
+            peak = magsq;
+            peakBin = n;
+        }
+    }
+
+    ratio = sum == 0.0f ? 0.0f : (peak * m_nbSymbols) / sum;
+    return peakBin;
+}
+
+void LoRaSymbolDemod::processWindow()
+{
+    float ratio;
+    unsigned int bin = dechirp(m_downChirp, ratio);
+
+    switch (m_state)
+    {
+    case StateDetect:
+        if (ratio < m_detectionRatio)
+        {
+            m_preambleCount = 0;
+        }
+        else if ((m_preambleCount > 0) && (((bin - m_preambleBin + 1) & (m_nbSymbols - 1)) <= 2)) // same bin within one
+        {
+            m_preambleCount++;
+        }
+        else
+        {
+            m_preambleBin = bin;
+            m_preambleCount = 1;
+        }
+
+        if (m_preambleCount == m_preambleMinCount)
+        {
+            // the window started preambleBin samples after a chirp start
+            m_skip = (m_nbSymbols - bin) & (m_nbSymbols - 1);
+            m_preambleCount = 0;
+            m_syncCount = 0;
+            m_downChirpCount = 0;
+            m_state = StateSync;
+        }
+        break;
+    case StateSync:
+    {
+        float downRatio;
+        dechirp(m_upChirp, downRatio); // down chirps give a peak at bin 0 when aligned
+
+        if ((downRatio > m_detectionRatio) && (downRatio > ratio))
+        {
+            if (++m_downChirpCount == 2)
+            {
+                m_skip = m_nbSymbols / 4; // quarter of down chirp that ends the delimiter
+                m_symbols.clear();
+                m_weakCount = 0;
+                m_state = StateData;
+            }
+        }
+        else if ((ratio < m_detectionRatio) || (++m_syncCount == m_syncMaxCount))
+        {
+            m_state = StateDetect;
+        }
+        else
+        {
+            m_downChirpCount = 0; // remaining preamble and sync word
+        }
+        break;
+    }
+    case StateData:
+        if (ratio < m_detectionRatio)
+        {
+            if (++m_weakCount == 2) // a single weak symbol is kept, the frame ends on two in a row
+            {
+                m_symbols.pop_back();
+                endFrame();
+                break;
+            }
+        }
+        else
+        {
+            m_weakCount = 0;
+        }
+
+        m_symbols.push_back(bin);
+
+        if (m_symbols.size() == m_frameMaxSymbols) {
+            endFrame();
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void LoRaSymbolDemod::endFrame()
+{
+    if (m_symbols.size() > 0) {
+        m_frames.push_back(m_symbols);
+    }
+
+    m_symbols.clear();
+    m_state = StateDetect;
+}
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_CHANNELRX_DEMODLORA_LORASYMBOLDEMOD_H_
+#define PLUGINS_CHANNELRX_DEMODLORA_LORASYMBOLDEMOD_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+
+class FFTEngine;
+
+/**
+ * LoRa symbol demodulator for one spreading factor.
+ *
+ * Input is the channel at one sample per chip (sample rate equal to the LoRa bandwidth).
+ * Samples are cut in windows of 2^SF samples. Each window is multiplied by a tabulated
+ * down chirp and transformed with one FFT: the index of the strongest bin is the symbol.
+ *
+ * Frames are found from the preamble (a run of windows giving the same bin), the windows
+ * are then aligned on the chirp boundaries and the two and a quarter down chirps of the
+ * start of frame delimiter are looked for. Symbols that follow are collected until the
+ * signal is lost. Several instances with different spreading factors can be run on the
+ * same stream since LoRa spreading factors are quasi orthogonal.
+ */
+class LoRaSymbolDemod
+{
+public:
+    explicit LoRaSymbolDemod(unsigned int spreadFactor);
+    ~LoRaSymbolDemod();
+
+    unsigned int getSpreadFactor() const { return m_spreadFactor; }
+    unsigned int getNbSymbols() const { return m_nbSymbols; } //!< number of symbol values and of samples per symbol
+
+    /** Process samples at one sample per chip */
+    void process(const Complex *samples, unsigned int nbSamples);
+    /** Frames completed since the last clear as lists of symbols */
+    const std::vector<std::vector<unsigned short>>& getFrames() const { return m_frames; }
+    void clearFrames() { m_frames.clear(); }
+    /** When set dechirped windows are appended to this vector for display */
+    void setSpectrumBuffer(SampleVector *spectrumBuffer) { m_spectrumBuffer = spectrumBuffer; }
+
+    static const unsigned int m_minSpreadFactor = 7;
+    static const unsigned int m_maxSpreadFactor = 12;
+
+private:
+    enum State
+    {
+        StateDetect,   //!< looking for the preamble
+        StateSync,     //!< aligned on the preamble looking for the start of frame delimiter
+        StateData      //!< collecting symbols
+    };
+
+    unsigned int m_spreadFactor;
+    unsigned int m_nbSymbols;
+    FFTEngine *m_fft;
+    std::vector<Complex> m_downChirp; //!< conjugate of the base up chirp
+    std::vector<Complex> m_upChirp;   //!< base up chirp
+    std::vector<Complex> m_window;
+    unsigned int m_windowFill;
+    unsigned int m_skip;              //!< samples to drop before the next window
+    State m_state;
+    unsigned int m_preambleBin;
+    unsigned int m_preambleCount;
+    unsigned int m_syncCount;         //!< windows seen in sync state
+    unsigned int m_downChirpCount;
+    unsigned int m_weakCount;         //!< consecutive symbols below the detection ratio
+    std::vector<unsigned short> m_symbols;
+    std::vector<std::vector<unsigned short>> m_frames;
+    SampleVector *m_spectrumBuffer;
+
+    static const unsigned int m_preambleMinCount = 4;  //!< consecutive identical bins to detect a preamble
+    static const unsigned int m_syncMaxCount = 16;     //!< windows to find the start of frame delimiter
+    static const unsigned int m_frameMaxSymbols = 1024;
+    static const float m_detectionRatio;               //!< peak to mean bin power ratio of a chirp
+
+    void processWindow();
+    /** Multiply the window by the chirp and run the FFT. Returns the strongest bin and its power ratio to the mean */
+    unsigned int dechirp(const std::vector<Complex>& chirp, float& ratio);
+    void endFrame();
+};
+
+#endif // PLUGINS_CHANNELRX_DEMODLORA_LORASYMBOLDEMOD_H_
@@ -58,21 +58,17 @@ NFMDemod::NFMDemod(DeviceAPI *devieAPI) :
         m_inputSampleRate(48000),
         m_inputFrequencyOffset(0),
         m_running(false),
+        m_pfbAttached(false),
         m_ctcssIndex(0),
         m_sampleCount(0),
         m_squelchCount(0),
-        m_squelchGate(4800),
-        m_squelchLevel(-990),
         m_squelchOpen(false),
         m_afSquelchOpen(false),
         m_magsq(0.0f),
         m_magsqSum(0.0f),
         m_magsqPeak(0.0f),
         m_magsqCount(0),
-        m_afSquelch(),
-        m_squelchDelayLine(24000),
-        m_audioFifo(48000),
-        m_settingsMutex(QMutex::Recursive)
+        m_audioFifo(48000)
 {
     qDebug("NFMDemod::NFMDemod");
 	setObjectName(m_channelId);
@@ -84,13 +80,6 @@ NFMDemod::NFMDemod(DeviceAPI *devieAPI) :
 
     DSPEngine::instance()->getAudioDeviceManager()->addAudioSink(&m_audioFifo, getInputMessageQueue());
     m_audioSampleRate = DSPEngine::instance()->getAudioDeviceManager()->getOutputSampleRate();
-    m_discriCompensation = (m_audioSampleRate/48000.0f);
-    m_discriCompensation *= sqrt(m_discriCompensation);
-
-	m_ctcssDetector.setCoefficients(m_audioSampleRate/16, m_audioSampleRate/8.0f); // 0.5s / 2 Hz resolution
-	m_afSquelch.setCoefficients(m_audioSampleRate/2000, 600, m_audioSampleRate, 200, 0, afSqTones); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
-
-    m_ctcssLowpass.create(301, m_audioSampleRate, 250.0);
 
     applyChannelSettings(m_inputSampleRate, m_inputFrequencyOffset, true);
 	applySettings(m_settings, true);
@@ -110,7 +99,13 @@ NFMDemod::~NFMDemod()
     delete m_networkManager;
 	DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo);
 	m_deviceAPI->removeChannelSinkAPI(this);
-    m_deviceAPI->removeChannelSink(m_threadedChannelizer);
+
+    if (m_pfbAttached) {
+        m_deviceAPI->removePFBChannelSink(m_threadedChannelizer);
+    } else {
+        m_deviceAPI->removeChannelSink(m_threadedChannelizer);
+    }
+
     delete m_threadedChannelizer;
     delete m_channelizer;
 }
@@ -156,37 +151,51 @@ void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	    return;
 	}
 
-	m_settingsMutex.lock();
+    m_settingsSnapshot.update();
+    m_afFilters.update();
+
+    if (m_interpolation.update()) {
+        m_interpolatorDistanceRemain = 0;
+    }
+
+    if (m_squelch.update())
+    {
+        m_squelchCount = 0; // reset squelch open counter
+        m_movingAverage.reset();
+    }
+
+    Interpolation& interpolation = m_interpolation.get();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
+        if (interpolation.m_distance < 1.0f) // interpolate
         {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
+            while (!interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
             {
                 processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
+                m_interpolatorDistanceRemain += interpolation.m_distance;
             }
         }
         else // decimate
         {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
+            if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
             {
                 processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
+                m_interpolatorDistanceRemain += interpolation.m_distance;
             }
         }
     }
-
-	m_settingsMutex.unlock();
 }
 
 void NFMDemod::processOneSample(Complex &ci)
 {
     qint16 sample;
+    const NFMDemodSettings& settings = m_settingsSnapshot.get();
+    AFFilters& afFilters = m_afFilters.get();
+    Squelch& squelch = m_squelch.get();
 
     double magsqRaw; // = ci.real()*ci.real() + c.imag()*c.imag();
     Real deviation;
@@ -207,28 +216,28 @@ void NFMDemod::processOneSample(Complex &ci)
 
     // AF processing
 
-    if (m_settings.m_deltaSquelch)
+    if (settings.m_deltaSquelch)
     {
-        if (m_afSquelch.analyze(demod * m_discriCompensation))
+        if (squelch.m_afSquelch.analyze(demod * squelch.m_discriCompensation))
         {
-            m_afSquelchOpen = m_afSquelch.evaluate(); // ? m_squelchGate + m_squelchDecay : 0;
+            m_afSquelchOpen = squelch.m_afSquelch.evaluate(); // ? m_squelchGate + m_squelchDecay : 0;
 
             if (!m_afSquelchOpen) {
-                m_squelchDelayLine.zeroBack(m_audioSampleRate/10); // zero out evaluation period
+                squelch.m_delayLine.zeroBack(m_audioSampleRate/10); // zero out evaluation period
             }
         }
 
         if (m_afSquelchOpen)
         {
-            m_squelchDelayLine.write(demod * m_discriCompensation);
+            squelch.m_delayLine.write(demod * squelch.m_discriCompensation);
 
-            if (m_squelchCount < 2*m_squelchGate) {
+            if (m_squelchCount < 2*squelch.m_gate) {
                 m_squelchCount++;
             }
         }
         else
         {
-            m_squelchDelayLine.write(0);
+            squelch.m_delayLine.write(0);
 
             if (m_squelchCount > 0) {
                 m_squelchCount--;
@@ -237,9 +246,9 @@ void NFMDemod::processOneSample(Complex &ci)
     }
     else
     {
-        if ((Real) m_movingAverage < m_squelchLevel)
+        if ((Real) m_movingAverage < squelch.m_level)
         {
-            m_squelchDelayLine.write(0);
+            squelch.m_delayLine.write(0);
 
             if (m_squelchCount > 0) {
                 m_squelchCount--;
@@ -247,17 +256,17 @@ void NFMDemod::processOneSample(Complex &ci)
         }
         else
         {
-            m_squelchDelayLine.write(demod * m_discriCompensation);
+            squelch.m_delayLine.write(demod * squelch.m_discriCompensation);
 
-            if (m_squelchCount < 2*m_squelchGate) {
+            if (m_squelchCount < 2*squelch.m_gate) {
                 m_squelchCount++;
             }
         }
     }
 
-    m_squelchOpen = (m_squelchCount > m_squelchGate);
+    m_squelchOpen = (m_squelchCount > squelch.m_gate);
 
-    if (m_settings.m_audioMute)
+    if (settings.m_audioMute)
     {
         sample = 0;
     }
@@ -265,22 +274,22 @@ void NFMDemod::processOneSample(Complex &ci)
     {
         if (m_squelchOpen)
         {
-            if (m_settings.m_ctcssOn)
+            if (settings.m_ctcssOn)
             {
-                Real ctcss_sample = m_ctcssLowpass.filter(demod * m_discriCompensation);
+                Real ctcss_sample = afFilters.m_ctcssLowpass.filter(demod * squelch.m_discriCompensation);
 
                 if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
                 {
-                    if (m_ctcssDetector.analyze(&ctcss_sample))
+                    if (squelch.m_ctcssDetector.analyze(&ctcss_sample))
                     {
                         int maxToneIndex;
 
-                        if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+                        if (squelch.m_ctcssDetector.getDetectedTone(maxToneIndex))
                         {
                             if (maxToneIndex+1 != m_ctcssIndex)
                             {
                                 if (getMessageQueueToGUI()) {
-                                    MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
+                                    MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(squelch.m_ctcssDetector.getToneSet()[maxToneIndex]);
                                     getMessageQueueToGUI()->push(msg);
                                 }
                                 m_ctcssIndex = maxToneIndex+1;
@@ -301,16 +310,16 @@ void NFMDemod::processOneSample(Complex &ci)
                 }
             }
 
-            if (m_settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
+            if (settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
             {
                 sample = 0;
             }
             else
             {
-                if (m_settings.m_highPass) {
-                    sample = m_bandpass.filter(m_squelchDelayLine.readBack(m_squelchGate)) * m_settings.m_volume;
+                if (settings.m_highPass) {
+                    sample = afFilters.m_bandpass.filter(squelch.m_delayLine.readBack(squelch.m_gate)) * settings.m_volume;
                 } else {
-                    sample = m_lowpass.filter(m_squelchDelayLine.readBack(m_squelchGate)) * m_settings.m_volume * 301.0f;
+                    sample = afFilters.m_lowpass.filter(squelch.m_delayLine.readBack(squelch.m_gate)) * settings.m_volume * 301.0f;
                 }
             }
         }
@@ -395,9 +404,18 @@ bool NFMDemod::handleMessage(const Message& cmd)
                  << " sampleRate: " << cfg.getSampleRate()
                  << " centerFrequency: " << cfg.getCenterFrequency();
 
-        m_channelizer->configure(m_channelizer->getInputMessageQueue(),
-            cfg.getSampleRate(),
-            cfg.getCenterFrequency());
+        if (m_pfbAttached)
+        {
+            // the filter bank sub-band is already centered on the channel
+            m_deviceAPI->addPFBChannelSink(m_threadedChannelizer, cfg.getCenterFrequency());
+            m_channelizer->configure(m_channelizer->getInputMessageQueue(), cfg.getSampleRate(), 0);
+        }
+        else
+        {
+            m_channelizer->configure(m_channelizer->getInputMessageQueue(),
+                cfg.getSampleRate(),
+                cfg.getCenterFrequency());
+        }
 
         return true;
     }
@@ -441,6 +459,27 @@ bool NFMDemod::handleMessage(const Message& cmd)
 	}
 }
 
+void NFMDemod::attachChannelizer(bool sharedChannelizer, int inputFrequencyOffset)
+{
+    if (sharedChannelizer)
+    {
+        m_deviceAPI->removeChannelSink(m_threadedChannelizer);
+        m_pfbAttached = m_deviceAPI->addPFBChannelSink(m_threadedChannelizer, inputFrequencyOffset);
+
+        if (!m_pfbAttached)
+        {
+            qWarning("NFMDemod::attachChannelizer: no shared filter bank on this device. Using a dedicated channelizer");
+            m_deviceAPI->addChannelSink(m_threadedChannelizer);
+        }
+    }
+    else
+    {
+        m_deviceAPI->removePFBChannelSink(m_threadedChannelizer);
+        m_deviceAPI->addChannelSink(m_threadedChannelizer);
+        m_pfbAttached = false;
+    }
+}
+
 void NFMDemod::applyAudioSampleRate(int sampleRate)
 {
     qDebug("NFMDemod::applyAudioSampleRate: %d", sampleRate);
@@ -449,35 +488,58 @@ void NFMDemod::applyAudioSampleRate(int sampleRate)
             sampleRate, m_settings.m_inputFrequencyOffset);
     m_inputMessageQueue.push(channelConfigMsg);
 
-    m_settingsMutex.lock();
+    publishInterpolation(m_inputSampleRate, sampleRate, m_settings.m_rfBandwidth);
+    publishAFFilters(sampleRate, m_settings.m_afBandwidth);
+    publishSquelch(m_settings, sampleRate);
 
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorDistance = (Real) m_inputSampleRate / (Real) sampleRate;
-    m_ctcssLowpass.create(301, sampleRate, 250.0);
-    m_bandpass.create(301, sampleRate, 300.0, m_settings.m_afBandwidth);
-    m_lowpass.create(301, sampleRate, m_settings.m_afBandwidth);
-    m_squelchGate = (sampleRate / 100) * m_settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
-    m_squelchCount = 0; // reset squelch open counter
-    m_ctcssDetector.setCoefficients(sampleRate/16, sampleRate/8.0f); // 0.5s / 2 Hz resolution
+    m_phaseDiscri.setFMScaling(sampleRate / static_cast<float>(m_settings.m_fmDeviation));
+    m_audioFifo.setSize(sampleRate);
 
-    if (sampleRate < 16000) {
-        m_afSquelch.setCoefficients(sampleRate/2000, 600, sampleRate, 200, 0, afSqTones_lowrate); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
+    m_audioSampleRate = sampleRate;
+}
 
-    } else {
-        m_afSquelch.setCoefficients(sampleRate/2000, 600, sampleRate, 200, 0, afSqTones); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
-    }
+void NFMDemod::publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real rfBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, inputSampleRate, rfBandwidth / 2.2f);
+    interpolation->m_distance = (Real) inputSampleRate / (Real) audioSampleRate;
+    m_interpolation.publish(interpolation);
+}
 
-    m_discriCompensation = (sampleRate/48000.0f);
-    m_discriCompensation *= sqrt(m_discriCompensation);
+void NFMDemod::publishAFFilters(uint32_t audioSampleRate, Real afBandwidth)
+{
+    AFFilters *afFilters = new AFFilters();
+    afFilters->m_ctcssLowpass.create(301, audioSampleRate, 250.0);
+    afFilters->m_bandpass.create(301, audioSampleRate, 300.0, afBandwidth);
+    afFilters->m_lowpass.create(301, audioSampleRate, afBandwidth);
+    m_afFilters.publish(afFilters);
+}
 
-    m_phaseDiscri.setFMScaling(sampleRate / static_cast<float>(m_settings.m_fmDeviation));
-    m_audioFifo.setSize(sampleRate);
-    m_squelchDelayLine.resize(sampleRate/2);
+void NFMDemod::publishSquelch(const NFMDemodSettings& settings, uint32_t audioSampleRate)
+{
+    Squelch *squelch = new Squelch(audioSampleRate/2);
+    squelch->m_gate = (audioSampleRate / 100) * settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
+    squelch->m_ctcssDetector.setCoefficients(audioSampleRate/16, audioSampleRate/8.0f); // 0.5s / 2 Hz resolution
 
-    m_settingsMutex.unlock();
+    if (audioSampleRate < 16000) {
+        squelch->m_afSquelch.setCoefficients(audioSampleRate/2000, 600, audioSampleRate, 200, 0, afSqTones_lowrate); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
+    } else {
+        squelch->m_afSquelch.setCoefficients(audioSampleRate/2000, 600, audioSampleRate, 200, 0, afSqTones); // 0.5ms test period, 300ms average span, audio SR, 100ms attack, no decay
+    }
 
-    m_audioSampleRate = sampleRate;
+    if (settings.m_deltaSquelch)
+    { // input is a value in negative centis
+        squelch->m_level = (- settings.m_squelch) / 100.0;
+        squelch->m_afSquelch.setThreshold(squelch->m_level);
+    }
+    else
+    { // input is a value in deci-Bels
+        squelch->m_level = std::pow(10.0, settings.m_squelch / 10.0);
+    }
+
+    squelch->m_discriCompensation = (audioSampleRate/48000.0f);
+    squelch->m_discriCompensation *= sqrt(squelch->m_discriCompensation);
+    m_squelch.publish(squelch);
 }
 
 void NFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force)
@@ -492,13 +554,8 @@ void NFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
         m_nco.setFreq(-inputFrequencyOffset, inputSampleRate);
     }
 
-    if ((inputSampleRate != m_inputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) inputSampleRate / (Real) m_audioSampleRate;
-        m_settingsMutex.unlock();
+    if ((inputSampleRate != m_inputSampleRate) || force) {
+        publishInterpolation(inputSampleRate, m_audioSampleRate, m_settings.m_rfBandwidth);
     }
 
     m_inputSampleRate = inputSampleRate;
@@ -519,6 +576,7 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
             << " m_ctcssIndex: " << settings.m_ctcssIndex
             << " m_ctcssOn: " << settings.m_ctcssOn
             << " m_highPass: " << settings.m_highPass
+            << " m_sharedChannelizer: " << settings.m_sharedChannelizer
             << " m_audioMute: " << settings.m_audioMute
             << " m_audioDeviceName: " << settings.m_audioDeviceName
             << " m_useReverseAPI: " << settings.m_useReverseAPI
@@ -549,14 +607,25 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
         reverseAPIKeys.append("title");
     }
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        reverseAPIKeys.append("audioDeviceName");
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
+        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(settings.m_audioDeviceName), audioDeviceIndex);
+        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            applyAudioSampleRate(audioSampleRate);
+        }
+    }
+
     if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         reverseAPIKeys.append("rfBandwidth");
-        m_settingsMutex.lock();
-        m_interpolator.create(16, m_inputSampleRate, settings.m_rfBandwidth / 2.2);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-        m_settingsMutex.unlock();
+        publishInterpolation(m_inputSampleRate, m_audioSampleRate, settings.m_rfBandwidth);
     }
 
     if ((settings.m_fmDeviation != m_settings.m_fmDeviation) || force)
@@ -568,17 +637,11 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
     if ((settings.m_afBandwidth != m_settings.m_afBandwidth) || force)
     {
         reverseAPIKeys.append("afBandwidth");
-        m_settingsMutex.lock();
-        m_bandpass.create(301, m_audioSampleRate, 300.0, settings.m_afBandwidth);
-        m_lowpass.create(301, m_audioSampleRate, settings.m_afBandwidth);
-        m_settingsMutex.unlock();
+        publishAFFilters(m_audioSampleRate, settings.m_afBandwidth);
     }
 
-    if ((settings.m_squelchGate != m_settings.m_squelchGate) || force)
-    {
+    if ((settings.m_squelchGate != m_settings.m_squelchGate) || force) {
         reverseAPIKeys.append("squelchGate");
-        m_squelchGate = (m_audioSampleRate / 100) * settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
-        m_squelchCount = 0; // reset squelch open counter
     }
 
     if ((settings.m_squelch != m_settings.m_squelch) || force) {
@@ -589,21 +652,10 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
     }
 
     if ((settings.m_squelch != m_settings.m_squelch) ||
-        (settings.m_deltaSquelch != m_settings.m_deltaSquelch) || force)
+        (settings.m_deltaSquelch != m_settings.m_deltaSquelch) ||
+        (settings.m_squelchGate != m_settings.m_squelchGate) || force)
     {
-        if (settings.m_deltaSquelch)
-        { // input is a value in negative centis
-            m_squelchLevel = (- settings.m_squelch) / 100.0;
-            m_afSquelch.setThreshold(m_squelchLevel);
-            m_afSquelch.reset();
-        }
-        else
-        { // input is a value in deci-Bels
-            m_squelchLevel = std::pow(10.0, settings.m_squelch / 10.0);
-            m_movingAverage.reset();
-        }
-
-        m_squelchCount = 0; // reset squelch open counter
+        publishSquelch(settings, m_audioSampleRate); // squelch counter and average are reset when it is picked up
     }
 
     if ((settings.m_ctcssIndex != m_settings.m_ctcssIndex) || force)
@@ -616,18 +668,12 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
         reverseAPIKeys.append("highPass");
     }
 
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    if (settings.m_sharedChannelizer != m_pfbAttached)
     {
-        reverseAPIKeys.append("audioDeviceName");
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
-        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(settings.m_audioDeviceName), audioDeviceIndex);
-        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            applyAudioSampleRate(audioSampleRate);
-        }
+        attachChannelizer(settings.m_sharedChannelizer, settings.m_inputFrequencyOffset);
+        MsgConfigureChannelizer* channelConfigMsg = MsgConfigureChannelizer::create(
+                m_audioSampleRate, settings.m_inputFrequencyOffset);
+        m_inputMessageQueue.push(channelConfigMsg);
     }
 
     if (settings.m_useReverseAPI)
@@ -641,6 +687,19 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
     }
 
     m_settings = settings;
+
+    if (m_settings.m_sharedChannelizer != m_pfbAttached) // the device has no filter bank
+    {
+        m_settings.m_sharedChannelizer = false;
+
+        if (m_guiMessageQueue)
+        {
+            MsgConfigureNFMDemod *msgToGUI = MsgConfigureNFMDemod::create(m_settings, false);
+            m_guiMessageQueue->push(msgToGUI);
+        }
+    }
+
+    m_settingsSnapshot.publish(m_settings);
 }
 
 QByteArray NFMDemod::serialize() const
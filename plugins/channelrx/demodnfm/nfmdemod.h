@@ -21,7 +21,6 @@
 
 #include <vector>
 
-#include <QMutex>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
@@ -38,6 +37,7 @@
 #include "util/message.h"
 #include "util/movingaverage.h"
 #include "util/doublebufferfifo.h"
+#include "util/settingssnapshot.h"
 
 #include "nfmdemodsettings.h"
 
@@ -205,6 +205,36 @@ private:
 		RSRunning
 	};
 
+    struct Interpolation //!< channel to audio sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct AFFilters
+    {
+        Lowpass<Real> m_ctcssLowpass;
+        Bandpass<Real> m_bandpass;
+        Lowpass<Real> m_lowpass;
+    };
+
+    struct Squelch
+    {
+        explicit Squelch(int delayLineSize = 24000) :
+            m_delayLine(delayLineSize),
+            m_gate(4800),
+            m_level(-990),
+            m_discriCompensation(1.0f)
+        {}
+        CTCSSDetector m_ctcssDetector;
+        AFSquelch m_afSquelch;
+        DoubleBufferFIFO<Real> m_delayLine;
+        int m_gate;
+        Real m_level;
+        float m_discriCompensation; //!< compensation factor that depends on audio rate (1 for 48 kS/s)
+    };
+
     DeviceAPI* m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
@@ -213,24 +243,23 @@ private:
     int m_inputFrequencyOffset;
 	NFMDemodSettings m_settings;
 	uint32_t m_audioSampleRate;
-	float m_discriCompensation; //!< compensation factor that depends on audio rate (1 for 48 kS/s)
 	bool m_running;
+    bool m_pfbAttached; //!< channelizer fed by a sub-band of the device filter bank
+
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<NFMDemodSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<AFFilters> m_afFilters;
+    SettingsSnapshot<Squelch> m_squelch;
 
 	NCO m_nco;
-	Interpolator m_interpolator;
-	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
-	Lowpass<Real> m_ctcssLowpass;
-	Bandpass<Real> m_bandpass;
-    Lowpass<Real> m_lowpass;
-	CTCSSDetector m_ctcssDetector;
+	CTCSSDetector m_ctcssDetector; //!< tone set for the GUI
 	int m_ctcssIndex; // 0 for nothing detected
 	int m_ctcssIndexSelected;
 	int m_sampleCount;
 	int m_squelchCount;
-	int m_squelchGate;
 
-	Real m_squelchLevel;
 	bool m_squelchOpen;
 	bool m_afSquelchOpen;
 	double m_magsq; //!< displayed averaged value
@@ -240,16 +269,12 @@ private:
     MagSqLevelsStore m_magSqLevelStore;
 
 	MovingAverageUtil<Real, double, 32> m_movingAverage;
-	AFSquelch m_afSquelch;
 	Real m_agcLevel; // AGC will aim to  this level
-	DoubleBufferFIFO<Real> m_squelchDelayLine;
 
 	AudioVector m_audioBuffer;
 	uint m_audioBufferFill;
 	AudioFifo m_audioFifo;
 
-	QMutex m_settingsMutex;
-
     PhaseDiscriminators m_phaseDiscri;
 
     QNetworkAccessManager *m_networkManager;
@@ -261,6 +286,10 @@ private:
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const NFMDemodSettings& settings, bool force = false);
     void applyAudioSampleRate(int sampleRate);
+    void attachChannelizer(bool sharedChannelizer, int inputFrequencyOffset); //!< sets m_pfbAttached
+    void publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real rfBandwidth);
+    void publishAFFilters(uint32_t audioSampleRate, Real afBandwidth);
+    void publishSquelch(const NFMDemodSettings& settings, uint32_t audioSampleRate);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const NFMDemodSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const NFMDemodSettings& settings, bool force);
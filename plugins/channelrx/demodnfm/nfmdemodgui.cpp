@@ -207,6 +207,12 @@ void NFMDemodGUI::on_highPassFilter_toggled(bool checked)
     applySettings();
 }
 
+void NFMDemodGUI::on_sharedChannelizer_toggled(bool checked)
+{
+    m_settings.m_sharedChannelizer = checked;
+    applySettings();
+}
+
 void NFMDemodGUI::on_audioMute_toggled(bool checked)
 {
 	m_settings.m_audioMute = checked;
@@ -405,6 +411,7 @@ void NFMDemodGUI::displaySettings()
 
     ui->ctcssOn->setChecked(m_settings.m_ctcssOn);
     ui->highPassFilter->setChecked(m_settings.m_highPass);
+    ui->sharedChannelizer->setChecked(m_settings.m_sharedChannelizer);
     ui->audioMute->setChecked(m_settings.m_audioMute);
 
     ui->ctcss->setCurrentIndex(m_settings.m_ctcssIndex);
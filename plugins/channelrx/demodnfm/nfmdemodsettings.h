@@ -43,6 +43,7 @@ struct NFMDemodSettings
     QString m_title;
     QString m_audioDeviceName;
     bool m_highPass;
+    bool m_sharedChannelizer; //!< take a sub-band of the device shared filter bank instead of running a dedicated channelizer
     bool m_useReverseAPI;
     QString m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
@@ -51,21 +51,16 @@ const QString SSBDemod::m_channelId = "SSBDemod";
 SSBDemod::SSBDemod(DeviceAPI *deviceAPI) :
         ChannelAPI(m_channelIdURI, ChannelAPI::StreamSingleSink),
         m_deviceAPI(deviceAPI),
+        m_agc(new MagAGC(12000, agcTarget, 1e-2)),
         m_audioBinaual(false),
         m_audioFlipChannels(false),
         m_dsb(false),
         m_audioMute(false),
-        m_agc(12000, agcTarget, 1e-2),
         m_agcActive(false),
-        m_agcClamping(false),
-        m_agcNbSamples(12000),
-        m_agcPowerThreshold(1e-2),
-        m_agcThresholdGate(0),
         m_squelchDelayLine(2*48000),
         m_audioActive(false),
         m_sampleSink(0),
-        m_audioFifo(24000),
-        m_settingsMutex(QMutex::Recursive)
+        m_audioFifo(24000)
 {
 	setObjectName(m_channelId);
 
@@ -90,12 +85,6 @@ SSBDemod::SSBDemod(DeviceAPI *deviceAPI) :
 	m_magsqPeak = 0.0f;
 	m_magsqCount = 0;
 
-	m_agc.setClampMax(SDR_RX_SCALED/100.0);
-	m_agc.setClamping(m_agcClamping);
-
-	SSBFilter = new fftfilt(m_LowCutoff / m_audioSampleRate, m_Bandwidth / m_audioSampleRate, ssbFftLen);
-	DSBFilter = new fftfilt((2.0f * m_Bandwidth) / m_audioSampleRate, 2 * ssbFftLen);
-
     applyChannelSettings(m_inputSampleRate, m_inputFrequencyOffset, true);
 	applySettings(m_settings, true);
 
@@ -118,8 +107,13 @@ SSBDemod::~SSBDemod()
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete SSBFilter;
-    delete DSBFilter;
+}
+
+SSBDemod::Filters::Filters(Real lowCutoff, Real bandwidth, bool usb, uint32_t audioSampleRate) :
+    m_ssbFilter(lowCutoff / (float) audioSampleRate, bandwidth / (float) audioSampleRate, ssbFftLen),
+    m_dsbFilter((2.0f * bandwidth) / (float) audioSampleRate, 2 * ssbFftLen),
+    m_usb(usb)
+{
 }
 
 void SSBDemod::configure(MessageQueue* messageQueue,
@@ -158,45 +152,74 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 {
     (void) positiveOnly;
     Complex ci;
-	m_settingsMutex.lock();
+
+    if (m_settingsSnapshot.update())
+    {
+        const SSBDemodSettings& settings = m_settingsSnapshot.get();
+        m_volume = settings.m_volume / 4.0; // for 3276.8
+        m_spanLog2 = settings.m_spanLog2;
+        m_audioBinaual = settings.m_audioBinaural;
+        m_audioFlipChannels = settings.m_audioFlipChannels;
+        m_dsb = settings.m_dsb;
+        m_audioMute = settings.m_audioMute;
+        m_agcActive = settings.m_agc;
+    }
+
+    if (m_interpolation.update()) {
+        m_interpolatorDistanceRemain = 0;
+    }
+
+    m_filters.update();
+    m_agc.update();
+    Interpolation& interpolation = m_interpolation.get();
+    m_filterInput.clear();
 
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
-        if (m_interpolatorDistance < 1.0f) // interpolate
+        if (interpolation.m_distance < 1.0f) // interpolate
         {
-            while (!m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
+            while (!interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
             {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
+                m_filterInput.push_back(ci);
+                m_interpolatorDistanceRemain += interpolation.m_distance;
             }
         }
         else
         {
-            if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
+            if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
             {
-                processOneSample(ci);
-                m_interpolatorDistanceRemain += m_interpolatorDistance;
+                m_filterInput.push_back(ci);
+                m_interpolatorDistanceRemain += interpolation.m_distance;
             }
         }
     }
 
-	m_settingsMutex.unlock();
+    processFilterBlock();
 }
 
-void SSBDemod::processOneSample(Complex &ci)
+void SSBDemod::processFilterBlock()
 {
-	fftfilt::cmplx *sideband;
+	int n_in = m_filterInput.size();
 	int n_out = 0;
 	int decim = 1<<(m_spanLog2 - 1);
 	unsigned char decim_mask = decim - 1; // counter LSB bit mask for decimation by 2^(m_scaleLog2 - 1)
+    Filters& filters = m_filters.get();
+    MagAGC& agc = m_agc.get();
+
+    // the block filters can output up to half a FFT length more than their input
+    if (m_filterOutput.size() < (unsigned int) n_in + 2*ssbFftLen) {
+        m_filterOutput.resize(n_in + 2*ssbFftLen);
+    }
+
+    fftfilt::cmplx *sideband = m_filterOutput.data();
 
     if (m_dsb) {
-        n_out = DSBFilter->runDSB(ci, &sideband);
+        n_out = filters.m_dsbFilter.runDSBBlock(m_filterInput.data(), n_in, sideband);
     } else {
-        n_out = SSBFilter->runSSB(ci, &sideband, m_usb);
+        n_out = filters.m_ssbFilter.runSSBBlock(m_filterInput.data(), n_in, sideband, filters.m_usb);
     }
 
     for (int i = 0; i < n_out; i++)
@@ -221,7 +244,7 @@ void SSBDemod::processOneSample(Complex &ci)
 
             m_magsqCount++;
 
-            if (!m_dsb & !m_usb)
+            if (!m_dsb & !filters.m_usb)
             { // invert spectrum for LSB
                 m_sampleBuffer.push_back(Sample(avgi, avgr));
             }
@@ -234,8 +257,8 @@ void SSBDemod::processOneSample(Complex &ci)
             m_sum.imag(0.0);
         }
 
-        float agcVal = m_agcActive ? m_agc.feedAndGetValue(sideband[i]) : 0.1;
-        fftfilt::cmplx& delayedSample = m_squelchDelayLine.readBack(m_agc.getStepDownDelay());
+        float agcVal = m_agcActive ? agc.feedAndGetValue(sideband[i]) : 0.1;
+        fftfilt::cmplx& delayedSample = m_squelchDelayLine.readBack(agc.getStepDownDelay());
         m_audioActive = delayedSample.real() != 0.0;
         m_squelchDelayLine.write(sideband[i]*agcVal);
 
@@ -246,7 +269,7 @@ void SSBDemod::processOneSample(Complex &ci)
         }
         else
         {
-            fftfilt::cmplx z = m_agcActive ? delayedSample * m_agc.getStepValue() : delayedSample;
+            fftfilt::cmplx z = m_agcActive ? delayedSample * agc.getStepValue() : delayedSample;
 
             if (m_audioBinaual)
             {
@@ -394,14 +417,8 @@ void SSBDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
         m_nco.setFreq(-inputFrequencyOffset, inputSampleRate);
     }
 
-    if ((m_inputSampleRate != inputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        Real interpolatorBandwidth = (m_Bandwidth * 1.5f) > inputSampleRate ? inputSampleRate : (m_Bandwidth * 1.5f);
-        m_interpolator.create(16, inputSampleRate, interpolatorBandwidth, 2.0f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) inputSampleRate / (Real) m_audioSampleRate;
-        m_settingsMutex.unlock();
+    if ((m_inputSampleRate != inputSampleRate) || force) {
+        publishInterpolation(inputSampleRate, m_audioSampleRate, m_Bandwidth);
     }
 
     m_inputSampleRate = inputSampleRate;
@@ -416,36 +433,11 @@ void SSBDemod::applyAudioSampleRate(int sampleRate)
             sampleRate, m_settings.m_inputFrequencyOffset);
     m_inputMessageQueue.push(channelConfigMsg);
 
-    m_settingsMutex.lock();
-
-    Real interpolatorBandwidth = (m_Bandwidth * 1.5f) > m_inputSampleRate ? m_inputSampleRate : (m_Bandwidth * 1.5f);
-    m_interpolator.create(16, m_inputSampleRate, interpolatorBandwidth, 2.0f);
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorDistance = (Real) m_inputSampleRate / (Real) sampleRate;
-
-    SSBFilter->create_filter(m_LowCutoff / (float) sampleRate, m_Bandwidth / (float) sampleRate);
-    DSBFilter->create_dsb_filter((2.0f * m_Bandwidth) / (float) sampleRate);
-
-    int agcNbSamples = (sampleRate / 1000) * (1<<m_settings.m_agcTimeLog2);
-    int agcThresholdGate = (sampleRate / 1000) * m_settings.m_agcThresholdGate; // ms
-
-    if (m_agcNbSamples != agcNbSamples)
-    {
-        m_agc.resize(agcNbSamples, agcNbSamples/2, agcTarget);
-        m_agc.setStepDownDelay(agcNbSamples);
-        m_agcNbSamples = agcNbSamples;
-    }
-
-    if (m_agcThresholdGate != agcThresholdGate)
-    {
-        m_agc.setGate(agcThresholdGate);
-        m_agcThresholdGate = agcThresholdGate;
-    }
-
+    publishInterpolation(m_inputSampleRate, sampleRate, m_Bandwidth);
+    m_filters.publish(new Filters(m_LowCutoff, m_Bandwidth, m_usb, sampleRate));
+    publishAGC(m_settings, sampleRate);
     m_audioFifo.setSize(sampleRate);
 
-    m_settingsMutex.unlock();
-
     m_audioSampleRate = sampleRate;
 
     if (m_guiMessageQueue) // forward to GUI if any
@@ -482,6 +474,20 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
 
     QList<QString> reverseAPIKeys;
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        reverseAPIKeys.append("audioDeviceName");
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
+        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            applyAudioSampleRate(audioSampleRate);
+        }
+    }
+
     if((m_settings.m_inputFrequencyOffset != settings.m_inputFrequencyOffset) || force) {
         reverseAPIKeys.append("inputFrequencyOffset");
     }
@@ -517,21 +523,12 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
         m_Bandwidth = band;
         m_LowCutoff = lowCutoff;
 
-        m_settingsMutex.lock();
-        Real interpolatorBandwidth = (m_Bandwidth * 1.5f) > m_inputSampleRate ? m_inputSampleRate : (m_Bandwidth * 1.5f);
-        m_interpolator.create(16, m_inputSampleRate, interpolatorBandwidth, 2.0f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-        SSBFilter->create_filter(m_LowCutoff / (float) m_audioSampleRate, m_Bandwidth / (float) m_audioSampleRate);
-        DSBFilter->create_dsb_filter((2.0f * m_Bandwidth) / (float) m_audioSampleRate);
-        m_settingsMutex.unlock();
+        publishInterpolation(m_inputSampleRate, m_audioSampleRate, m_Bandwidth);
+        m_filters.publish(new Filters(m_LowCutoff, m_Bandwidth, m_usb, m_audioSampleRate));
     }
 
-    if ((m_settings.m_volume != settings.m_volume) || force)
-    {
+    if ((m_settings.m_volume != settings.m_volume) || force) {
         reverseAPIKeys.append("volume");
-        m_volume = settings.m_volume;
-        m_volume /= 4.0; // for 3276.8
     }
 
     if ((m_settings.m_agcTimeLog2 != settings.m_agcTimeLog2) || force) {
@@ -552,57 +549,7 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
         (m_settings.m_agcThresholdGate != settings.m_agcThresholdGate) ||
         (m_settings.m_agcClamping != settings.m_agcClamping) || force)
     {
-        int agcNbSamples = (m_audioSampleRate / 1000) * (1<<settings.m_agcTimeLog2);
-        m_agc.setThresholdEnable(settings.m_agcPowerThreshold != -SSBDemodSettings::m_minPowerThresholdDB);
-        double agcPowerThreshold = CalcDb::powerFromdB(settings.m_agcPowerThreshold) * (SDR_RX_SCALED*SDR_RX_SCALED);
-        int agcThresholdGate = (m_audioSampleRate / 1000) * settings.m_agcThresholdGate; // ms
-        bool agcClamping = settings.m_agcClamping;
-
-        if (m_agcNbSamples != agcNbSamples)
-        {
-            m_settingsMutex.lock();
-            m_agc.resize(agcNbSamples, agcNbSamples/2, agcTarget);
-            m_agc.setStepDownDelay(agcNbSamples);
-            m_agcNbSamples = agcNbSamples;
-            m_settingsMutex.unlock();
-        }
-
-        if (m_agcPowerThreshold != agcPowerThreshold)
-        {
-            m_agc.setThreshold(agcPowerThreshold);
-            m_agcPowerThreshold = agcPowerThreshold;
-        }
-
-        if (m_agcThresholdGate != agcThresholdGate)
-        {
-            m_agc.setGate(agcThresholdGate);
-            m_agcThresholdGate = agcThresholdGate;
-        }
-
-        if (m_agcClamping != agcClamping)
-        {
-            m_agc.setClamping(agcClamping);
-            m_agcClamping = agcClamping;
-        }
-
-        qDebug() << "SBDemod::applySettings: AGC:"
-            << " agcNbSamples: " << agcNbSamples
-            << " agcPowerThreshold: " << agcPowerThreshold
-            << " agcThresholdGate: " << agcThresholdGate
-            << " agcClamping: " << agcClamping;
-    }
-
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
-    {
-        reverseAPIKeys.append("audioDeviceName");
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
-        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            applyAudioSampleRate(audioSampleRate);
-        }
+        publishAGC(settings, m_audioSampleRate);
     }
 
     if ((m_settings.m_spanLog2 != settings.m_spanLog2) || force) {
@@ -624,13 +571,6 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
         reverseAPIKeys.append("agc");
     }
 
-    m_spanLog2 = settings.m_spanLog2;
-    m_audioBinaual = settings.m_audioBinaural;
-    m_audioFlipChannels = settings.m_audioFlipChannels;
-    m_dsb = settings.m_dsb;
-    m_audioMute = settings.m_audioMute;
-    m_agcActive = settings.m_agc;
-
     if (settings.m_useReverseAPI)
     {
         bool fullUpdate = ((m_settings.m_useReverseAPI != settings.m_useReverseAPI) && settings.m_useReverseAPI) ||
@@ -642,6 +582,38 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
+}
+
+void SSBDemod::publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real bandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    Real interpolatorBandwidth = (bandwidth * 1.5f) > inputSampleRate ? inputSampleRate : (bandwidth * 1.5f);
+    interpolation->m_interpolator.create(16, inputSampleRate, interpolatorBandwidth, 2.0f);
+    interpolation->m_distance = (Real) inputSampleRate / (Real) audioSampleRate;
+    m_interpolation.publish(interpolation);
+}
+
+void SSBDemod::publishAGC(const SSBDemodSettings& settings, uint32_t audioSampleRate)
+{
+    int agcNbSamples = (audioSampleRate / 1000) * (1<<settings.m_agcTimeLog2);
+    double agcPowerThreshold = CalcDb::powerFromdB(settings.m_agcPowerThreshold) * (SDR_RX_SCALED*SDR_RX_SCALED);
+    int agcThresholdGate = (audioSampleRate / 1000) * settings.m_agcThresholdGate; // ms
+
+    MagAGC *agc = new MagAGC(agcNbSamples, agcTarget, agcPowerThreshold);
+    agc->resize(agcNbSamples, agcNbSamples/2, agcTarget);
+    agc->setStepDownDelay(agcNbSamples);
+    agc->setThresholdEnable(settings.m_agcPowerThreshold != -SSBDemodSettings::m_minPowerThresholdDB);
+    agc->setGate(agcThresholdGate);
+    agc->setClampMax(SDR_RX_SCALED/100.0);
+    agc->setClamping(settings.m_agcClamping);
+    m_agc.publish(agc);
+
+    qDebug() << "SBDemod::publishAGC:"
+        << " agcNbSamples: " << agcNbSamples
+        << " agcPowerThreshold: " << agcPowerThreshold
+        << " agcThresholdGate: " << agcThresholdGate
+        << " agcClamping: " << settings.m_agcClamping;
 }
 
 QByteArray SSBDemod::serialize() const
@@ -21,7 +21,6 @@
 
 #include <vector>
 
-#include <QMutex>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
@@ -33,6 +32,7 @@
 #include "audio/audiofifo.h"
 #include "util/message.h"
 #include "util/doublebufferfifo.h"
+#include "util/settingssnapshot.h"
 
 #include "ssbdemodsettings.h"
 
@@ -187,6 +187,21 @@ private:
         double m_magsqPeak;
     };
 
+    struct Interpolation //!< channel to audio sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct Filters //!< sideband filters at audio sample rate
+    {
+        Filters(Real lowCutoff = 300, Real bandwidth = 5000, bool usb = true, uint32_t audioSampleRate = 48000);
+        fftfilt m_ssbFilter;
+        fftfilt m_dsbFilter;
+        bool m_usb;
+    };
+
 	class MsgConfigureSSBDemodPrivate : public Message {
 		MESSAGE_CLASS_DECLARATION
 
@@ -285,6 +300,12 @@ private:
     DownChannelizer* m_channelizer;
     SSBDemodSettings m_settings;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<SSBDemodSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<Filters> m_filters;
+    SettingsSnapshot<MagAGC> m_agc;
+
 	Real m_Bandwidth;
 	Real m_LowCutoff;
 	Real m_volume;
@@ -303,25 +324,19 @@ private:
 	double m_magsqPeak;
     int  m_magsqCount;
     MagSqLevelsStore m_magSqLevelStore;
-    MagAGC m_agc;
     bool m_agcActive;
-    bool m_agcClamping;
-    int m_agcNbSamples;         //!< number of audio (48 kHz) samples for AGC averaging
-    double m_agcPowerThreshold; //!< AGC power threshold (linear)
-    int m_agcThresholdGate;     //!< Gate length in number of samples befor threshold triggers
     DoubleBufferFIFO<fftfilt::cmplx> m_squelchDelayLine;
     bool m_audioActive;         //!< True if an audio signal is produced (no AGC or AGC and above threshold)
 
 	NCOF m_nco;
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
-	fftfilt* SSBFilter;
-	fftfilt* DSBFilter;
 
 	BasebandSampleSink* m_sampleSink;
 	SampleVector m_sampleBuffer;
 
+    std::vector<fftfilt::cmplx> m_filterInput;  //!< audio rate samples of one feed() call
+    std::vector<fftfilt::cmplx> m_filterOutput; //!< sideband filter output
+
 	AudioVector m_audioBuffer;
 	uint m_audioBufferFill;
 	AudioFifo m_audioFifo;
@@ -330,16 +345,16 @@ private:
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
-	QMutex m_settingsMutex;
-
 	void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
 	void applySettings(const SSBDemodSettings& settings, bool force = false);
     void applyAudioSampleRate(int sampleRate);
+    void publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real bandwidth);
+    void publishAGC(const SSBDemodSettings& settings, uint32_t audioSampleRate);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const SSBDemodSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const SSBDemodSettings& settings, bool force);
 
-    void processOneSample(Complex &ci);
+    void processFilterBlock();
 
 private slots:
     void networkManagerFinished(QNetworkReply *reply);
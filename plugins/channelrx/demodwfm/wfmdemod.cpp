@@ -58,12 +58,10 @@ WFMDemod::WFMDemod(DeviceAPI* deviceAPI) :
         m_magsqSum(0.0f),
         m_magsqPeak(0.0f),
         m_magsqCount(0),
-        m_audioFifo(250000),
-        m_settingsMutex(QMutex::Recursive)
+        m_audioFifo(250000)
 {
 	setObjectName(m_channelId);
 
-	m_rfFilter = new fftfilt(-50000.0 / 384000.0, 50000.0 / 384000.0, rfFilterFftLength);
 	m_phaseDiscri.setFMScaling(384000/75000);
 
 	m_audioBuffer.resize(16384);
@@ -94,7 +92,6 @@ WFMDemod::~WFMDemod()
 	m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete m_rfFilter;
 }
 
 void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
@@ -107,73 +104,89 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	double msq;
 	float fmDev;
 
-	m_settingsMutex.lock();
+    m_settingsSnapshot.update();
+    m_rfFilter.update();
+
+    if (m_interpolation.update()) {
+        m_interpolatorDistanceRemain = m_interpolation->m_distance;
+    }
+
+    const WFMDemodSettings& settings = m_settingsSnapshot.get();
+    Interpolation& interpolation = m_interpolation.get();
+	m_rfInput.clear();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
+		m_rfInput.push_back(c);
+	}
 
-		rf_out = m_rfFilter->runFilt(c, &rf); // filter RF before demod
+	// the block filter can output up to half a FFT length more than its input
+	if (m_rfOutput.size() < m_rfInput.size() + rfFilterFftLength) {
+		m_rfOutput.resize(m_rfInput.size() + rfFilterFftLength);
+	}
 
-		for (int i = 0 ; i < rf_out; i++)
-		{
-		    msq = rf[i].real()*rf[i].real() + rf[i].imag()*rf[i].imag();
-		    Real magsq = msq / (SDR_RX_SCALED*SDR_RX_SCALED);
-		    m_magsqSum += magsq;
-		    m_movingAverage(magsq);
+	rf = m_rfOutput.data();
+	rf_out = m_rfFilter->m_filter.runFiltBlock(m_rfInput.data(), m_rfInput.size(), rf); // filter RF before demod
 
-            if (magsq > m_magsqPeak) {
-                m_magsqPeak = magsq;
-            }
+	for (int i = 0 ; i < rf_out; i++)
+	{
+	    msq = rf[i].real()*rf[i].real() + rf[i].imag()*rf[i].imag();
+	    Real magsq = msq / (SDR_RX_SCALED*SDR_RX_SCALED);
+	    m_magsqSum += magsq;
+	    m_movingAverage(magsq);
+
+        if (magsq > m_magsqPeak) {
+            m_magsqPeak = magsq;
+        }
 
-            m_magsqCount++;
+        m_magsqCount++;
 
-            if (magsq >= m_squelchLevel)
-            {
-                if (m_squelchState < m_settings.m_rfBandwidth / 10) { // twice attack and decay rate
-                    m_squelchState++;
-                }
+        if (magsq >= m_squelchLevel)
+        {
+            if (m_squelchState < settings.m_rfBandwidth / 10) { // twice attack and decay rate
+                m_squelchState++;
             }
-            else
-            {
-                if (m_squelchState > 0) {
-                    m_squelchState--;
-                }
+        }
+        else
+        {
+            if (m_squelchState > 0) {
+                m_squelchState--;
             }
+        }
 
-			m_squelchOpen = (m_squelchState > (m_settings.m_rfBandwidth / 20));
-
-			if (m_squelchOpen && !m_settings.m_audioMute) { // squelch open and not mute
-                demod = m_phaseDiscri.phaseDiscriminatorDelta(rf[i], msq, fmDev);
-            } else {
-                demod = 0;
-            }
+		m_squelchOpen = (m_squelchState > (settings.m_rfBandwidth / 20));
 
-            Complex e(demod, 0);
+		if (m_squelchOpen && !settings.m_audioMute) { // squelch open and not mute
+            demod = m_phaseDiscri.phaseDiscriminatorDelta(rf[i], msq, fmDev);
+        } else {
+            demod = 0;
+        }
 
-			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
-			{
-				qint16 sample = (qint16)(ci.real() * 3276.8f * m_settings.m_volume);
-				m_sampleBuffer.push_back(Sample(sample, sample));
-				m_audioBuffer[m_audioBufferFill].l = sample;
-				m_audioBuffer[m_audioBufferFill].r = sample;
+        Complex e(demod, 0);
 
-				++m_audioBufferFill;
+		if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
+		{
+			qint16 sample = (qint16)(ci.real() * 3276.8f * settings.m_volume);
+			m_sampleBuffer.push_back(Sample(sample, sample));
+			m_audioBuffer[m_audioBufferFill].l = sample;
+			m_audioBuffer[m_audioBufferFill].r = sample;
 
-				if(m_audioBufferFill >= m_audioBuffer.size())
-				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+			++m_audioBufferFill;
 
-					if (res != m_audioBufferFill) {
-						qDebug("WFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
-					}
+			if(m_audioBufferFill >= m_audioBuffer.size())
+			{
+				uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
-					m_audioBufferFill = 0;
+				if (res != m_audioBufferFill) {
+					qDebug("WFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
 				}
 
-				m_interpolatorDistanceRemain += m_interpolatorDistance;
+				m_audioBufferFill = 0;
 			}
+
+			m_interpolatorDistanceRemain += interpolation.m_distance;
 		}
 	}
 
@@ -189,8 +202,6 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	}
 
 	m_sampleBuffer.clear();
-
-	m_settingsMutex.unlock();
 }
 
 void WFMDemod::start()
@@ -274,15 +285,24 @@ void WFMDemod::applyAudioSampleRate(int sampleRate)
 {
     qDebug("WFMDemod::applyAudioSampleRate: %d", sampleRate);
 
-    m_settingsMutex.lock();
+    publishInterpolation(m_inputSampleRate, sampleRate, m_settings.m_afBandwidth);
 
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_afBandwidth);
-    m_interpolatorDistanceRemain = (Real) m_inputSampleRate / sampleRate;
-    m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) sampleRate;
+    m_audioSampleRate = sampleRate;
+}
 
-    m_settingsMutex.unlock();
+void WFMDemod::publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real afBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, inputSampleRate, afBandwidth);
+    interpolation->m_distance = (Real) inputSampleRate / (Real) audioSampleRate;
+    m_interpolation.publish(interpolation);
+}
 
-    m_audioSampleRate = sampleRate;
+void WFMDemod::publishRFFilter(int inputSampleRate, Real rfBandwidth)
+{
+    Real lowCut = -(rfBandwidth / 2.0) / inputSampleRate;
+    Real hiCut  = (rfBandwidth / 2.0) / inputSampleRate;
+    m_rfFilter.publish(new RFFilter(lowCut, hiCut));
 }
 
 void WFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force)
@@ -299,16 +319,8 @@ void WFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
 
     if ((inputSampleRate != m_inputSampleRate) || force)
     {
-        qDebug() << "WFMDemod::applyChannelSettings: m_interpolator.create";
-        m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) inputSampleRate / (Real) m_audioSampleRate;
-        m_interpolatorDistance =  (Real) inputSampleRate / (Real) m_audioSampleRate;
-        m_settingsMutex.unlock();
-        qDebug() << "WFMDemod::applySettings: m_rfFilter->create_filter";
-        Real lowCut = -(m_settings.m_rfBandwidth / 2.0) / inputSampleRate;
-        Real hiCut  = (m_settings.m_rfBandwidth / 2.0) / inputSampleRate;
-        m_rfFilter->create_filter(lowCut, hiCut);
+        publishInterpolation(inputSampleRate, m_audioSampleRate, m_settings.m_afBandwidth);
+        publishRFFilter(inputSampleRate, m_settings.m_rfBandwidth);
         m_fmExcursion = m_settings.m_rfBandwidth / (Real) inputSampleRate;
         m_phaseDiscri.setFMScaling(1.0f/m_fmExcursion);
         qDebug("WFMDemod::applySettings: m_fmExcursion: %f", m_fmExcursion);
@@ -365,22 +377,28 @@ void WFMDemod::applySettings(const WFMDemodSettings& settings, bool force)
         reverseAPIKeys.append("rgbColor");
     }
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
+        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(settings.m_audioDeviceName), audioDeviceIndex);
+        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            applyAudioSampleRate(audioSampleRate);
+        }
+    }
+
     if((settings.m_afBandwidth != m_settings.m_afBandwidth) ||
        (settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
-        m_settingsMutex.lock();
-        qDebug() << "WFMDemod::applySettings: m_interpolator.create";
-        m_interpolator.create(16, m_inputSampleRate, settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-        m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-        qDebug() << "WFMDemod::applySettings: m_rfFilter->create_filter";
-        Real lowCut = -(settings.m_rfBandwidth / 2.0) / m_inputSampleRate;
-        Real hiCut  = (settings.m_rfBandwidth / 2.0) / m_inputSampleRate;
-        m_rfFilter->create_filter(lowCut, hiCut);
+        publishInterpolation(m_inputSampleRate, m_audioSampleRate, settings.m_afBandwidth);
+        publishRFFilter(m_inputSampleRate, settings.m_rfBandwidth);
         m_fmExcursion = settings.m_rfBandwidth / (Real) m_inputSampleRate;
         m_phaseDiscri.setFMScaling(1.0f/m_fmExcursion);
         qDebug("WFMDemod::applySettings: m_fmExcursion: %f", m_fmExcursion);
-        m_settingsMutex.unlock();
     }
 
     if ((settings.m_squelch != m_settings.m_squelch) || force)
@@ -389,19 +407,6 @@ void WFMDemod::applySettings(const WFMDemodSettings& settings, bool force)
         m_squelchLevel = pow(10.0, settings.m_squelch / 10.0);
     }
 
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
-    {
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getOutputDeviceIndex(settings.m_audioDeviceName);
-        //qDebug("AMDemod::applySettings: audioDeviceName: %s audioDeviceIndex: %d", qPrintable(settings.m_audioDeviceName), audioDeviceIndex);
-        audioDeviceManager->addAudioSink(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            applyAudioSampleRate(audioSampleRate);
-        }
-    }
-
     if (settings.m_useReverseAPI)
     {
         bool fullUpdate = ((m_settings.m_useReverseAPI != settings.m_useReverseAPI) && settings.m_useReverseAPI) ||
@@ -413,6 +418,7 @@ void WFMDemod::applySettings(const WFMDemodSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
 }
 
 QByteArray WFMDemod::serialize() const
@@ -21,7 +21,6 @@
 
 #include <vector>
 
-#include <QMutex>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesink.h"
@@ -30,6 +29,7 @@
 #include "dsp/interpolator.h"
 #include "dsp/lowpass.h"
 #include "util/movingaverage.h"
+#include "util/settingssnapshot.h"
 #include "dsp/fftfilt.h"
 #include "dsp/phasediscri.h"
 #include "audio/audiofifo.h"
@@ -178,6 +178,21 @@ private:
         double m_magsqPeak;
     };
 
+    struct Interpolation //!< channel to audio sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct RFFilter
+    {
+        RFFilter(Real lowCut = -50000.0 / 384000.0, Real hiCut = 50000.0 / 384000.0) :
+            m_filter(lowCut, hiCut, rfFilterFftLength)
+        {}
+        fftfilt m_filter;
+    };
+
 	enum RateState {
 		RSInitialFill,
 		RSRunning
@@ -192,11 +207,15 @@ private:
     WFMDemodSettings m_settings;
     quint32 m_audioSampleRate;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<WFMDemodSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<RFFilter> m_rfFilter;
+
 	NCO m_nco;
-	Interpolator m_interpolator; //!< Interpolator between sample rate sent from DSP engine and requested RF bandwidth (rational)
-	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
-	fftfilt* m_rfFilter;
+    std::vector<fftfilt::cmplx> m_rfInput;  //!< mixed samples of one feed() call
+    std::vector<fftfilt::cmplx> m_rfOutput; //!< RF filter output
 
 	Real m_squelchLevel;
 	int m_squelchState;
@@ -215,7 +234,6 @@ private:
 
 	AudioFifo m_audioFifo;
 	SampleVector m_sampleBuffer;
-	QMutex m_settingsMutex;
 
 	PhaseDiscriminators m_phaseDiscri;
 
@@ -227,6 +245,8 @@ private:
     void applyAudioSampleRate(int sampleRate);
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const WFMDemodSettings& settings, bool force = false);
+    void publishInterpolation(int inputSampleRate, uint32_t audioSampleRate, Real afBandwidth);
+    void publishRFFilter(int inputSampleRate, Real rfBandwidth);
 
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const WFMDemodSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
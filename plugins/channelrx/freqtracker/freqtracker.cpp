@@ -59,15 +59,13 @@ FreqTracker::FreqTracker(DeviceAPI *deviceAPI) :
         m_channelSampleRate(48000),
         m_running(false),
         m_squelchOpen(false),
-        m_squelchGate(0),
         m_magsqSum(0.0f),
         m_magsqPeak(0.0f),
         m_magsqCount(0),
         m_timerConnected(false),
         m_tickCount(0),
         m_lastCorrAbs(0),
-        m_avgDeltaFreq(0.0),
-        m_settingsMutex(QMutex::Recursive)
+        m_avgDeltaFreq(0.0)
 {
     setObjectName(m_channelId);
 
@@ -80,7 +78,6 @@ FreqTracker::FreqTracker(DeviceAPI *deviceAPI) :
 #endif
 	m_magsq = 0.0;
 
-    m_rrcFilter = new fftfilt(m_settings.m_rfBandwidth / m_channelSampleRate, 2*1024);
     m_pll.computeCoefficients(0.002f, 0.5f, 10.0f); // bandwidth, damping factor, loop gain
     applyChannelSettings(m_inputSampleRate, m_inputFrequencyOffset, true);
 
@@ -106,7 +103,6 @@ FreqTracker::~FreqTracker()
     m_deviceAPI->removeChannelSink(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete m_rrcFilter;
 }
 
 void FreqTracker::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst)
@@ -118,45 +114,65 @@ void FreqTracker::feed(const SampleVector::const_iterator& begin, const SampleVe
         return;
     }
 
-	m_settingsMutex.lock();
+    m_settingsSnapshot.update();
+    m_channelFilter.update();
+
+    if (m_interpolation.update()) {
+        m_interpolatorDistanceRemain = 0;
+    }
+
+    if (m_loopSettings.update())
+    {
+        const LoopSettings& loopSettings = m_loopSettings.get();
+
+        if (loopSettings.m_pskOrder < 32) {
+            m_pll.setPskOrder(loopSettings.m_pskOrder);
+        }
+
+        // both reset the loops
+        m_pll.setSampleRate(loopSettings.m_sampleRate);
+        m_fll.setSampleRate(loopSettings.m_sampleRate);
+    }
+
+    Interpolation& interpolation = m_interpolation.get();
 
 	for (SampleVector::const_iterator it = begin; it != end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
-		if (m_interpolatorDistance < 1.0f) // interpolate
+		if (interpolation.m_distance < 1.0f) // interpolate
 		{
             processOneSample(ci);
 
-		    while (m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
+		    while (interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
             {
                 processOneSample(ci);
             }
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
+            m_interpolatorDistanceRemain += interpolation.m_distance;
 		}
 		else // decimate
 		{
-	        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
+	        if (interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
 	        {
 	            processOneSample(ci);
-	            m_interpolatorDistanceRemain += m_interpolatorDistance;
+	            m_interpolatorDistanceRemain += interpolation.m_distance;
 	        }
 		}
 	}
-
-	m_settingsMutex.unlock();
 }
 
 void FreqTracker::processOneSample(Complex &ci)
 {
+    const FreqTrackerSettings& settings = m_settingsSnapshot.get();
+    ChannelFilter& channelFilter = m_channelFilter.get();
     fftfilt::cmplx *sideband;
     int n_out;
 
-    if (m_settings.m_rrc)
+    if (settings.m_rrc)
     {
-        n_out = m_rrcFilter->runFilt(ci, &sideband);
+        n_out = channelFilter.m_rrcFilter.runFilt(ci, &sideband);
     }
     else
     {
@@ -182,13 +198,13 @@ void FreqTracker::processOneSample(Complex &ci)
 
         if (m_magsq < m_squelchLevel)
         {
-            if (m_squelchGate > 0)
+            if (channelFilter.m_squelchGate > 0)
             {
                 if (m_squelchCount > 0) {
                     m_squelchCount--;
                 }
 
-                m_squelchOpen = m_squelchCount >= m_squelchGate;
+                m_squelchOpen = m_squelchCount >= channelFilter.m_squelchGate;
             }
             else
             {
@@ -197,13 +213,13 @@ void FreqTracker::processOneSample(Complex &ci)
         }
         else
         {
-            if (m_squelchGate > 0)
+            if (channelFilter.m_squelchGate > 0)
             {
-                if (m_squelchCount < 2*m_squelchGate) {
+                if (m_squelchCount < 2*channelFilter.m_squelchGate) {
                     m_squelchCount++;
                 }
 
-                m_squelchOpen = m_squelchCount >= m_squelchGate;
+                m_squelchOpen = m_squelchCount >= channelFilter.m_squelchGate;
             }
             else
             {
@@ -213,11 +229,11 @@ void FreqTracker::processOneSample(Complex &ci)
 
         if (m_squelchOpen)
         {
-            if (m_settings.m_trackerType == FreqTrackerSettings::TrackerFLL)
+            if (settings.m_trackerType == FreqTrackerSettings::TrackerFLL)
             {
                 m_fll.feed(re, im);
             }
-            else if (m_settings.m_trackerType == FreqTrackerSettings::TrackerPLL)
+            else if (settings.m_trackerType == FreqTrackerSettings::TrackerPLL)
             {
                 m_pll.feed(re, im);
             }
@@ -344,6 +360,7 @@ void FreqTracker::applySettings(const FreqTrackerSettings& settings, bool force)
     QList<QString> reverseAPIKeys;
     bool updateChannelizer = false;
     bool updateInterpolator = false;
+    bool resetLoops = false;
 
     if ((m_settings.m_inputFrequencyOffset != settings.m_inputFrequencyOffset) || force)
     {
@@ -385,10 +402,8 @@ void FreqTracker::applySettings(const FreqTrackerSettings& settings, bool force)
         m_avgDeltaFreq = 0.0;
         m_lastCorrAbs = 0;
 
-        if (settings.m_tracking)
-        {
-            m_pll.reset();
-            m_fll.reset();
+        if (settings.m_tracking) {
+            resetLoops = true;
         }
     }
 
@@ -397,12 +412,7 @@ void FreqTracker::applySettings(const FreqTrackerSettings& settings, bool force)
         reverseAPIKeys.append("trackerType");
         m_lastCorrAbs = 0;
         m_avgDeltaFreq = 0.0;
-
-        if (settings.m_trackerType == FreqTrackerSettings::TrackerFLL) {
-            m_fll.reset();
-        } else if (settings.m_trackerType == FreqTrackerSettings::TrackerPLL) {
-            m_pll.reset();
-        }
+        resetLoops = true;
 
         if (settings.m_trackerType == FreqTrackerSettings::TrackerNone) {
             disconnectTimer();
@@ -414,10 +424,7 @@ void FreqTracker::applySettings(const FreqTrackerSettings& settings, bool force)
     if ((m_settings.m_pllPskOrder != settings.m_pllPskOrder) || force)
     {
         reverseAPIKeys.append("pllPskOrder");
-
-        if (settings.m_pllPskOrder < 32) {
-            m_pll.setPskOrder(settings.m_pllPskOrder);
-        }
+        resetLoops = true;
     }
 
     if ((m_settings.m_rrc != settings.m_rrc) || force) {
@@ -445,6 +452,11 @@ void FreqTracker::applySettings(const FreqTrackerSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
+
+    if (resetLoops) { // the loops are reset when the DSP thread picks up the loop settings
+        publishLoopSettings(m_channelSampleRate, settings);
+    }
 
     if (updateChannelizer) {
         configureChannelizer();
@@ -455,13 +467,23 @@ void FreqTracker::applySettings(const FreqTrackerSettings& settings, bool force)
 
 void FreqTracker::setInterpolator()
 {
-    m_settingsMutex.lock();
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorDistance = (Real) m_inputSampleRate / (Real) m_channelSampleRate;
-    m_rrcFilter->create_rrc_filter(m_settings.m_rfBandwidth / m_channelSampleRate, m_settings.m_rrcRolloff / 100.0);
-    m_squelchGate = (m_channelSampleRate / 100) * m_settings.m_squelchGate; // gate is given in 10s of ms at channel sample rate
-    m_settingsMutex.unlock();
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, m_inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
+    interpolation->m_distance = (Real) m_inputSampleRate / (Real) m_channelSampleRate;
+    m_interpolation.publish(interpolation);
+
+    ChannelFilter *channelFilter = new ChannelFilter();
+    channelFilter->m_rrcFilter.create_rrc_filter(m_settings.m_rfBandwidth / m_channelSampleRate, m_settings.m_rrcRolloff / 100.0);
+    channelFilter->m_squelchGate = (m_channelSampleRate / 100) * m_settings.m_squelchGate; // gate is given in 10s of ms at channel sample rate
+    m_channelFilter.publish(channelFilter);
+}
+
+void FreqTracker::publishLoopSettings(unsigned int sampleRate, const FreqTrackerSettings& settings)
+{
+    LoopSettings *loopSettings = new LoopSettings();
+    loopSettings->m_sampleRate = sampleRate;
+    loopSettings->m_pskOrder = settings.m_pllPskOrder;
+    m_loopSettings.publish(loopSettings);
 }
 
 void FreqTracker::configureChannelizer()
@@ -469,8 +491,7 @@ void FreqTracker::configureChannelizer()
     if (m_channelSampleRate != m_deviceSampleRate / (1<<m_settings.m_log2Decim))
     {
         m_channelSampleRate = m_deviceSampleRate / (1<<m_settings.m_log2Decim);
-        m_pll.setSampleRate(m_channelSampleRate);
-        m_fll.setSampleRate(m_channelSampleRate);
+        publishLoopSettings(m_channelSampleRate, m_settings);
     }
 
     if (!m_settings.m_tracking) {
@@ -488,7 +509,7 @@ void FreqTracker::configureChannelizer()
         MsgSampleRateNotification *msg = MsgSampleRateNotification::create(
             m_deviceSampleRate / (1<<m_settings.m_log2Decim),
             m_settings.m_inputFrequencyOffset);
-        m_guiMessageQueue->push(msg);
+        m_guiMessageQueue->pushCoalesced(msg); // sent at each tracking correction: only the latest is useful
     }
 }
 
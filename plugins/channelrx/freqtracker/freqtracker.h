@@ -21,7 +21,6 @@
 #include <vector>
 
 #include <QNetworkRequest>
-#include <QMutex>
 
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelapi.h"
@@ -31,10 +30,12 @@
 #include "dsp/agc.h"
 #include "dsp/bandpass.h"
 #include "dsp/lowpass.h"
+#include "dsp/fftfilt.h"
 #include "dsp/phaselockcomplex.h"
 #include "dsp/freqlockcomplex.h"
 #include "util/message.h"
 #include "util/doublebufferfifo.h"
+#include "util/settingssnapshot.h"
 
 #include "freqtrackersettings.h"
 
@@ -44,7 +45,6 @@ class DeviceAPI;
 class DownChannelizer;
 class ThreadedBasebandSampleSink;
 class QTimer;
-class fftfilt;
 
 class FreqTracker : public BasebandSampleSink, public ChannelAPI {
 	Q_OBJECT
@@ -97,6 +97,7 @@ public:
 
     class MsgSampleRateNotification : public Message {
         MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED(MsgSampleRateNotification)
 
     public:
         static MsgSampleRateNotification* create(int sampleRate, int frequencyOffset) {
@@ -196,6 +197,27 @@ private:
         double m_magsqPeak;
     };
 
+    struct Interpolation //!< channel to tracker sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct ChannelFilter //!< RRC filter and squelch gate at tracker sample rate
+    {
+        ChannelFilter() : m_rrcFilter(0.1, 2*1024), m_squelchGate(0) {}
+        fftfilt m_rrcFilter;
+        uint32_t m_squelchGate; //!< Squelch gate in samples
+    };
+
+    struct LoopSettings //!< PLL and FLL
+    {
+        LoopSettings() : m_sampleRate(48000), m_pskOrder(1) {}
+        unsigned int m_sampleRate;
+        unsigned int m_pskOrder;
+    };
+
 	enum RateState {
 		RSInitialFill,
 		RSRunning
@@ -206,6 +228,12 @@ private:
     DownChannelizer* m_channelizer;
     FreqTrackerSettings m_settings;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<FreqTrackerSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<ChannelFilter> m_channelFilter;
+    SettingsSnapshot<LoopSettings> m_loopSettings;
+
     uint32_t m_deviceSampleRate;
     int m_inputSampleRate;
     int m_inputFrequencyOffset;
@@ -215,16 +243,11 @@ private:
 	NCOF m_nco;
     PhaseLockComplex m_pll;
     FreqLockComplex m_fll;
-	Interpolator m_interpolator;
-	Real m_interpolatorDistance;
 	Real m_interpolatorDistanceRemain;
 
-	fftfilt* m_rrcFilter;
-
 	Real m_squelchLevel;
 	uint32_t m_squelchCount;
 	bool m_squelchOpen;
-    uint32_t m_squelchGate; //!< Squelch gate in samples
 	double m_magsq;
 	double m_magsqSum;
 	double m_magsqPeak;
@@ -242,11 +265,11 @@ private:
     uint32_t m_tickCount;
     int m_lastCorrAbs;
     Real m_avgDeltaFreq;
-	QMutex m_settingsMutex;
 
     void applySettings(const FreqTrackerSettings& settings, bool force = false);
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
     void setInterpolator();
+    void publishLoopSettings(unsigned int sampleRate, const FreqTrackerSettings& settings);
     void configureChannelizer();
     void connectTimer();
     void disconnectTimer();
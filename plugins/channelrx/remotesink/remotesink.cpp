@@ -70,6 +70,8 @@ RemoteSink::RemoteSink(DeviceAPI *deviceAPI) :
         m_deviceSampleRate(48000),
         m_nbBlocksFEC(0),
         m_txDelay(35),
+        m_blockSize(RemoteUdpSize),
+        m_sampleEncoding(RemoteEncodingRaw),
         m_dataAddress("127.0.0.1"),
         m_dataPort(9090)
 {
@@ -134,6 +136,7 @@ void RemoteSink::feed(const SampleVector::const_iterator& begin, const SampleVec
         {
             struct timeval tv;
             RemoteMetaDataFEC metaData;
+            metaData.init();
             gettimeofday(&tv, 0);
 
             metaData.m_centerFrequency = m_centerFrequency + m_frequencyOffset;
@@ -145,12 +148,19 @@ void RemoteSink::feed(const SampleVector::const_iterator& begin, const SampleVec
             metaData.m_tv_sec = tv.tv_sec;
             metaData.m_tv_usec = tv.tv_usec;
 
+            if ((m_blockSize != RemoteUdpSize) || (m_sampleEncoding != RemoteEncodingRaw))
+            {
+                metaData.m_version = RemoteProtocolV2;
+                metaData.m_encoding = m_sampleEncoding;
+                metaData.m_blockSize = m_blockSize;
+            }
+
             if (!m_dataBlock) { // on the very first cycle there is no data block allocated
                 m_dataBlock = new RemoteDataBlock();
             }
 
             boost::crc_32_type crc32;
-            crc32.process_bytes(&metaData, sizeof(RemoteMetaDataFEC)-4);
+            crc32.process_bytes(&metaData, RemoteMetaDataFEC::crcSize());
             metaData.m_crc32 = crc32.checksum();
             RemoteSuperBlock& superBlock = m_dataBlock->m_superBlocks[0]; // first block
             superBlock.init();
@@ -172,7 +182,10 @@ void RemoteSink::feed(const SampleVector::const_iterator& begin, const SampleVec
                         << "|" << (int) metaData.m_nbOriginalBlocks
                         << ":" << (int) metaData.m_nbFECBlocks
                         << "|" << metaData.m_tv_sec
-                        << ":" << metaData.m_tv_usec;
+                        << ":" << metaData.m_tv_usec
+                        << "|" << (int) metaData.m_version
+                        << ":" << (int) metaData.m_encoding
+                        << ":" << metaData.m_blockSize;
 
                 m_currentMetaFEC = metaData;
             }
@@ -202,6 +215,7 @@ void RemoteSink::feed(const SampleVector::const_iterator& begin, const SampleVec
             m_superBlock.m_header.m_blockIndex = m_txBlockIndex;
             m_superBlock.m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
             m_superBlock.m_header.m_sampleBits = SDR_RX_SAMP_SZ;
+            m_superBlock.m_header.m_version = RemoteProtocolV1; // protocol version 2 is applied by the sender thread
             m_dataBlock->m_superBlocks[m_txBlockIndex] = m_superBlock;
 
             if (m_txBlockIndex == RemoteNbOrginalBlocks - 1) // frame complete
@@ -214,6 +228,8 @@ void RemoteSink::feed(const SampleVector::const_iterator& begin, const SampleVec
                 m_dataBlock->m_txControlBlock.m_txDelay = m_txDelay;
                 m_dataBlock->m_txControlBlock.m_dataAddress = m_dataAddress;
                 m_dataBlock->m_txControlBlock.m_dataPort = m_dataPort;
+                m_dataBlock->m_txControlBlock.m_blockSize = m_blockSize;
+                m_dataBlock->m_txControlBlock.m_sampleEncoding = m_sampleEncoding;
 
                 emit dataBlockAvailable(m_dataBlock);
                 m_dataBlock = new RemoteDataBlock(); // create a new one immediately
@@ -241,11 +257,12 @@ void RemoteSink::start()
     }
 
     m_sinkThread = new RemoteSinkThread();
+    // the sender thread queues data blocks itself so that they do not go through an event loop
     connect(this,
             SIGNAL(dataBlockAvailable(RemoteDataBlock *)),
             m_sinkThread,
             SLOT(processDataBlock(RemoteDataBlock *)),
-            Qt::QueuedConnection);
+            Qt::DirectConnection);
     m_sinkThread->startStop(true);
     m_running = true;
 }
@@ -368,6 +385,8 @@ void RemoteSink::applySettings(const RemoteSinkSettings& settings, bool force)
     qDebug() << "RemoteSink::applySettings:"
             << " m_nbFECBlocks: " << settings.m_nbFECBlocks
             << " m_txDelay: " << settings.m_txDelay
+            << " m_blockSize: " << settings.m_blockSize
+            << " m_sampleEncoding: " << settings.m_sampleEncoding
             << " m_dataAddress: " << settings.m_dataAddress
             << " m_dataPort: " << settings.m_dataPort
             << " force: " << force;
@@ -387,6 +406,18 @@ void RemoteSink::applySettings(const RemoteSinkSettings& settings, bool force)
         setTxDelay(settings.m_txDelay, settings.m_nbFECBlocks);
     }
 
+    if ((m_settings.m_blockSize != settings.m_blockSize) || force)
+    {
+        reverseAPIKeys.append("blockSize");
+        m_blockSize = settings.m_blockSize;
+    }
+
+    if ((m_settings.m_sampleEncoding != settings.m_sampleEncoding) || force)
+    {
+        reverseAPIKeys.append("sampleEncoding");
+        m_sampleEncoding = settings.m_sampleEncoding;
+    }
+
     if ((m_settings.m_dataAddress != settings.m_dataAddress) || force)
     {
         reverseAPIKeys.append("dataAddress");
@@ -471,6 +502,18 @@ int RemoteSink::webapiSettingsPutPatch(
         }
     }
 
+    if (channelSettingsKeys.contains("blockSize"))
+    {
+        int blockSize = response.getRemoteSinkSettings()->getBlockSize();
+        settings.m_blockSize = blockSize < RemoteUdpSize ? RemoteUdpSize : blockSize > RemoteMaxUdpSize ? RemoteMaxUdpSize : blockSize;
+    }
+
+    if (channelSettingsKeys.contains("sampleEncoding"))
+    {
+        int sampleEncoding = response.getRemoteSinkSettings()->getSampleEncoding();
+        settings.m_sampleEncoding = (sampleEncoding < 0) || (sampleEncoding >= RemoteEncodingEnd) ? RemoteEncodingRaw : sampleEncoding;
+    }
+
     if (channelSettingsKeys.contains("dataAddress")) {
         settings.m_dataAddress = *response.getRemoteSinkSettings()->getDataAddress();
     }
@@ -543,6 +586,8 @@ void RemoteSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& re
 {
     response.getRemoteSinkSettings()->setNbFecBlocks(settings.m_nbFECBlocks);
     response.getRemoteSinkSettings()->setTxDelay(settings.m_txDelay);
+    response.getRemoteSinkSettings()->setBlockSize(settings.m_blockSize);
+    response.getRemoteSinkSettings()->setSampleEncoding(settings.m_sampleEncoding);
 
     if (response.getRemoteSinkSettings()->getDataAddress()) {
         *response.getRemoteSinkSettings()->getDataAddress() = settings.m_dataAddress;
@@ -593,6 +638,12 @@ void RemoteSink::webapiReverseSendSettings(QList<QString>& channelSettingsKeys,
     {
         swgRemoteSinkSettings->setTxDelay(settings.m_txDelay);
     }
+    if (channelSettingsKeys.contains("blockSize") || force) {
+        swgRemoteSinkSettings->setBlockSize(settings.m_blockSize);
+    }
+    if (channelSettingsKeys.contains("sampleEncoding") || force) {
+        swgRemoteSinkSettings->setSampleEncoding(settings.m_sampleEncoding);
+    }
     if (channelSettingsKeys.contains("dataAddress") || force) {
         swgRemoteSinkSettings->setDataAddress(new QString(settings.m_dataAddress));
     }
@@ -186,6 +186,8 @@ private:
     uint32_t m_deviceSampleRate;
     int m_nbBlocksFEC;
     int m_txDelay;
+    int m_blockSize;
+    int m_sampleEncoding;
     QString m_dataAddress;
     uint16_t m_dataPort;
     QNetworkAccessManager *m_networkManager;
@@ -200,6 +200,15 @@ void RemoteSinkGUI::displaySettings()
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s).arg(s1));
     ui->txDelayText->setText(tr("%1%").arg(m_settings.m_txDelay));
     ui->txDelay->setValue(m_settings.m_txDelay);
+    int blockSizeIndex = ui->blockSize->findText(QString::number(m_settings.m_blockSize));
+
+    if (blockSizeIndex < 0) { // size set through the API
+        ui->blockSize->addItem(QString::number(m_settings.m_blockSize));
+        blockSizeIndex = ui->blockSize->count() - 1;
+    }
+
+    ui->blockSize->setCurrentIndex(blockSizeIndex);
+    ui->sampleEncoding->setCurrentIndex(m_settings.m_sampleEncoding);
     updateTxDelayTime();
     applyDecimation();
     blockApplySettings(false);
@@ -347,6 +356,19 @@ void RemoteSinkGUI::on_nbFECBlocks_valueChanged(int value)
     applySettings();
 }
 
+void RemoteSinkGUI::on_blockSize_currentIndexChanged(int index)
+{
+    (void) index;
+    m_settings.m_blockSize = ui->blockSize->currentText().toUInt();
+    applySettings();
+}
+
+void RemoteSinkGUI::on_sampleEncoding_currentIndexChanged(int index)
+{
+    m_settings.m_sampleEncoding = index < 0 ? 0 : index;
+    applySettings();
+}
+
 void RemoteSinkGUI::updateTxDelayTime()
 {
     double txDelayRatio = m_settings.m_txDelay / 100.0;
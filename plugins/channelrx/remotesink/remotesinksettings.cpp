@@ -37,6 +37,8 @@ RemoteSinkSettings::RemoteSinkSettings()
 void RemoteSinkSettings::resetToDefaults()
 {
     m_nbFECBlocks = 0;
+    m_blockSize = 512;
+    m_sampleEncoding = 0;
     m_txDelay = 35;
     m_dataAddress = "127.0.0.1";
     m_dataPort = 9090;
@@ -68,6 +70,8 @@ QByteArray RemoteSinkSettings::serialize() const
     s.writeU32(11, m_reverseAPIChannelIndex);
     s.writeU32(12, m_log2Decim);
     s.writeU32(13, m_filterChainHash);
+    s.writeU32(14, m_blockSize);
+    s.writeU32(15, m_sampleEncoding);
 
     return s.final();
 }
@@ -124,6 +128,10 @@ bool RemoteSinkSettings::deserialize(const QByteArray& data)
         d.readU32(12, &tmp, 0);
         m_log2Decim = tmp > 6 ? 6 : tmp;
         d.readU32(13, &m_filterChainHash, 0);
+        d.readU32(14, &tmp, 512);
+        m_blockSize = tmp < 512 ? 512 : tmp > 8972 ? 8972 : tmp;
+        d.readU32(15, &tmp, 0);
+        m_sampleEncoding = tmp > 3 ? 0 : tmp;
 
         return true;
     }
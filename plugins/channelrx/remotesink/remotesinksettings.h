@@ -32,6 +32,8 @@ class Serializable;
 struct RemoteSinkSettings
 {
     uint16_t m_nbFECBlocks;
+    uint32_t m_blockSize;      //!< UDP datagram size. Protocol version 2 if not 512
+    uint32_t m_sampleEncoding; //!< RemoteSampleEncoding. Protocol version 2 if not raw
     uint32_t m_txDelay;
     QString  m_dataAddress;
     uint16_t m_dataPort;
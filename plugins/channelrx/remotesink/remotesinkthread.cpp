@@ -24,7 +24,7 @@
 #include "remotesinkthread.h"
 
 #include <channel/remotedatablock.h>
-#include <QUdpSocket>
+#include <QElapsedTimer>
 
 #include "cm256cc/cm256.h"
 
@@ -34,7 +34,7 @@ RemoteSinkThread::RemoteSinkThread(QObject* parent) :
     QThread(parent),
     m_running(false),
     m_address(QHostAddress::LocalHost),
-    m_socket(0)
+    m_nbDroppedBlocks(0)
 {
 
     m_cm256p = m_cm256.isInitialized() ? &m_cm256 : 0;
@@ -44,6 +44,10 @@ RemoteSinkThread::RemoteSinkThread(QObject* parent) :
 RemoteSinkThread::~RemoteSinkThread()
 {
     qDebug("RemoteSinkThread::~RemoteSinkThread");
+
+    while (!m_dataBlocks.isEmpty()) { // queued after stop
+        delete m_dataBlocks.dequeue();
+    }
 }
 
 void RemoteSinkThread::startStop(bool start)
@@ -54,9 +58,10 @@ void RemoteSinkThread::startStop(bool start)
 
 void RemoteSinkThread::startWork()
 {
-    qDebug("RemoteSinkThread::startWork");
+    qDebug("RemoteSinkThread::startWork: %s", m_socket.isBatching() ? "batched send" : "one datagram per call");
 	m_startWaitMutex.lock();
-	m_socket = new QUdpSocket(this);
+    m_socket.open();
+    m_socket.setBufferSizes(1<<20, 0); // room for a few frames
 	start();
 	while(!m_running)
 		m_startWaiter.wait(&m_startWaitMutex, 100);
@@ -66,10 +71,16 @@ void RemoteSinkThread::startWork()
 void RemoteSinkThread::stopWork()
 {
 	qDebug("RemoteSinkThread::stopWork");
-    delete m_socket;
-    m_socket = 0;
 	m_running = false;
+    m_dataBlocksWaiter.wakeAll();
 	wait();
+    m_socket.close();
+
+    QMutexLocker mutexLocker(&m_dataBlocksMutex);
+
+    while (!m_dataBlocks.isEmpty()) {
+        delete m_dataBlocks.dequeue();
+    }
 }
 
 void RemoteSinkThread::run()
@@ -78,9 +89,27 @@ void RemoteSinkThread::run()
 	m_running = true;
 	m_startWaiter.wakeAll();
 
+    // sender loop. No event loop: blocks are handed over by processDataBlock
     while (m_running)
     {
-        sleep(1); // Do nothing as everything is in the data handler (dequeuer)
+        RemoteDataBlock *dataBlock = nullptr;
+        m_dataBlocksMutex.lock();
+
+        if (m_dataBlocks.isEmpty()) {
+            m_dataBlocksWaiter.wait(&m_dataBlocksMutex, 100);
+        }
+
+        if (!m_dataBlocks.isEmpty()) {
+            dataBlock = m_dataBlocks.dequeue();
+        }
+
+        m_dataBlocksMutex.unlock();
+
+        if (dataBlock)
+        {
+            handleDataBlock(*dataBlock);
+            delete dataBlock;
+        }
     }
 
     m_running = false;
@@ -89,8 +118,19 @@ void RemoteSinkThread::run()
 
 void RemoteSinkThread::processDataBlock(RemoteDataBlock *dataBlock)
 {
-    handleDataBlock(*dataBlock);
-    delete dataBlock;
+    QMutexLocker mutexLocker(&m_dataBlocksMutex);
+
+    if (m_dataBlocks.size() >= m_maxQueuedBlocks) // the sender cannot keep up: drop the oldest frame
+    {
+        delete m_dataBlocks.dequeue();
+
+        if ((m_nbDroppedBlocks++ % 100) == 0) {
+            qWarning("RemoteSinkThread::processDataBlock: queue full: %llu blocks dropped", m_nbDroppedBlocks);
+        }
+    }
+
+    m_dataBlocks.enqueue(dataBlock);
+    m_dataBlocksWaiter.wakeOne();
 }
 
 void RemoteSinkThread::handleDataBlock(RemoteDataBlock& dataBlock)
@@ -106,18 +146,23 @@ void RemoteSinkThread::handleDataBlock(RemoteDataBlock& dataBlock)
     uint16_t dataPort = dataBlock.m_txControlBlock.m_dataPort;
     RemoteSuperBlock *txBlockx = dataBlock.m_superBlocks;
 
-    if ((nbBlocksFEC == 0) || !m_cm256p) // Do not FEC encode
+    if ((dataBlock.m_txControlBlock.m_blockSize != RemoteUdpSize) || (dataBlock.m_txControlBlock.m_sampleEncoding != RemoteEncodingRaw))
     {
-        if (m_socket)
+        // version 2: re-encode the frame. The delay is given for 128 + nbBlocksFEC blocks per frame
+        m_frameEncoder.setBlockSize(dataBlock.m_txControlBlock.m_blockSize);
+        m_frameEncoder.setEncoding((RemoteSampleEncoding) dataBlock.m_txControlBlock.m_sampleEncoding);
+        int nbBlocks = m_frameEncoder.encode(txBlockx, frameIndex, nbBlocksFEC);
+
+        if (nbBlocks > 0)
         {
-            for (int i = 0; i < RemoteNbOrginalBlocks; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) RemoteUdpSize, m_address, dataPort);
-                usleep(txDelay);
-            }
+            txDelay = (txDelay * (RemoteNbOrginalBlocks + nbBlocksFEC)) / nbBlocks;
+            sendBlocks(m_frameEncoder.getDatagrams(), m_frameEncoder.getBlockSize(), nbBlocks, txDelay, dataPort);
         }
     }
+    else if ((nbBlocksFEC == 0) || !m_cm256p) // Do not FEC encode
+    {
+        sendBlocks((const char *) txBlockx, RemoteUdpSize, RemoteNbOrginalBlocks, txDelay, dataPort);
+    }
     else
     {
         cm256Params.BlockBytes = sizeof(RemoteProtectedBlock);
@@ -135,6 +180,7 @@ void RemoteSinkThread::handleDataBlock(RemoteDataBlock& dataBlock)
             txBlockx[i].m_header.m_blockIndex = i;
             txBlockx[i].m_header.m_sampleBytes = (SDR_RX_SAMP_SZ <= 16 ? 2 : 4);
             txBlockx[i].m_header.m_sampleBits = SDR_RX_SAMP_SZ;
+            txBlockx[i].m_header.m_version = RemoteProtocolV1;
             descriptorBlocks[i].Block = (void *) &(txBlockx[i].m_protectedBlock);
             descriptorBlocks[i].Index = txBlockx[i].m_header.m_blockIndex;
         }
@@ -153,20 +199,44 @@ void RemoteSinkThread::handleDataBlock(RemoteDataBlock& dataBlock)
         }
 
         // Transmit all blocks
-        if (m_socket)
-        {
-            for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) RemoteUdpSize, m_address, dataPort);
-                usleep(txDelay);
-            }
-        }
+        sendBlocks((const char *) txBlockx, RemoteUdpSize, cm256Params.OriginalCount + cm256Params.RecoveryCount, txDelay, dataPort);
     }
 
     dataBlock.m_txControlBlock.m_processed = true;
 }
 
+void RemoteSinkThread::sendBlocks(const char *blocks, int blockSize, int nbBlocks, int txDelay, uint16_t dataPort)
+{
+    if (!m_socket.isOpen()) {
+        return;
+    }
+
+    if (txDelay <= 0) // whole frame at once
+    {
+        m_socket.send(blocks, blockSize, nbBlocks, m_address, dataPort);
+        return;
+    }
+
+    // Delays of a few microseconds between single datagrams cannot be honored by the scheduler and cost
+    // one system call each. Send bursts spanning at least m_minBurstUs and pace them against the clock.
+    int burstSize = m_minBurstUs / txDelay;
+    burstSize = burstSize < 1 ? 1 : burstSize > nbBlocks ? nbBlocks : burstSize;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < nbBlocks; i += burstSize)
+    {
+        int nbBurst = nbBlocks - i < burstSize ? nbBlocks - i : burstSize;
+        m_socket.send(&blocks[i*blockSize], blockSize, nbBurst, m_address, dataPort);
+        qint64 dueUs = (qint64) (i + nbBurst) * txDelay;
+        qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+
+        if (dueUs > elapsedUs) {
+            usleep(dueUs - elapsedUs);
+        }
+    }
+}
+
 void RemoteSinkThread::handleInputMessages()
 {
     Message* message;
@@ -28,15 +28,18 @@
 #include <QMutex>
 #include <QWaitCondition>
 #include <QHostAddress>
+#include <QQueue>
 
 #include "cm256cc/cm256.h"
+#include "channel/remoteframecodec.h"
 
 #include "util/message.h"
 #include "util/messagequeue.h"
+#include "util/udpbatchsocket.h"
 
 class RemoteDataBlock;
+struct RemoteSuperBlock;
 class CM256;
-class QUdpSocket;
 
 class RemoteSinkThread : public QThread {
     Q_OBJECT
@@ -67,7 +70,7 @@ public:
     void startStop(bool start);
 
 public slots:
-    void processDataBlock(RemoteDataBlock *dataBlock);
+    void processDataBlock(RemoteDataBlock *dataBlock); //!< queues the block for the sender loop. Can be called from any thread
 
 private:
 	QMutex m_startWaitMutex;
@@ -76,9 +79,18 @@ private:
 
     CM256 m_cm256;
     CM256 *m_cm256p;
+    RemoteFrameEncoder m_frameEncoder; //!< version 2 protocol encoder
 
     QHostAddress m_address;
-    QUdpSocket *m_socket;
+    UDPBatchSocket m_socket;
+
+    QQueue<RemoteDataBlock*> m_dataBlocks; //!< blocks waiting to be sent
+    QMutex m_dataBlocksMutex;
+    QWaitCondition m_dataBlocksWaiter;
+    quint64 m_nbDroppedBlocks;             //!< blocks dropped because the queue was full
+
+    static const int m_minBurstUs = 500;     //!< minimum pacing interval when blocks are delayed
+    static const int m_maxQueuedBlocks = 16; //!< frames waiting to be sent before the oldest is dropped
 
     MessageQueue m_inputMessageQueue;
 
@@ -87,6 +99,7 @@ private:
 
     void run();
     void handleDataBlock(RemoteDataBlock& dataBlock);
+    void sendBlocks(const char *blocks, int blockSize, int nbBlocks, int txDelay, uint16_t dataPort);
 
 private slots:
     void handleInputMessages();
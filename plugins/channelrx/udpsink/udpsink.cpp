@@ -50,19 +50,11 @@ UDPSink::UDPSink(DeviceAPI *deviceAPI) :
         m_deviceAPI(deviceAPI),
         m_inputSampleRate(48000),
         m_inputFrequencyOffset(0),
-        m_outMovingAverage(480, 1e-10),
-        m_inMovingAverage(480, 1e-10),
-        m_amMovingAverage(1200, 1e-10),
         m_audioFifo(24000),
         m_spectrum(0),
-        m_squelch(1e-6),
         m_squelchOpen(false),
         m_squelchOpenCount(0),
-        m_squelchCloseCount(0),
-        m_squelchGate(4800),
-        m_squelchRelease(4800),
-        m_agc(9600, m_agcTarget, 1e-6),
-        m_settingsMutex(QMutex::Recursive)
+        m_squelchCloseCount(0)
 {
 	setObjectName(m_channelId);
 
@@ -76,7 +68,6 @@ UDPSink::UDPSink(DeviceAPI *deviceAPI) :
 	m_audioBufferFill = 0;
 
 	m_nco.setFreq(0, m_inputSampleRate);
-	m_interpolator.create(16, m_inputSampleRate, m_settings.m_rfBandwidth / 2.0);
 	m_sampleDistanceRemain = m_inputSampleRate / m_settings.m_outputSampleRate;
 	m_spectrumEnabled = false;
 	m_nextSSBId = 0;
@@ -102,9 +93,6 @@ UDPSink::UDPSink(DeviceAPI *deviceAPI) :
 		qWarning("UDPSink::UDPSink: cannot bind audio port");
 	}
 
-    m_agc.setClampMax(SDR_RX_SCALED*SDR_RX_SCALED);
-    m_agc.setClamping(true);
-
 	//DSPEngine::instance()->addAudioSink(&m_audioFifo);
 
     applyChannelSettings(m_inputSampleRate, m_inputFrequencyOffset, true);
@@ -149,43 +137,66 @@ void UDPSink::feed(const SampleVector::const_iterator& begin, const SampleVector
 	double l, r;
 
 	m_sampleBuffer.clear();
-	m_settingsMutex.lock();
+
+	if (m_settingsSnapshot.update())
+	{
+	    // the UDP buffers are only written here so their destination is changed here
+	    const UDPSinkSettings& settings = m_settingsSnapshot.get();
+	    m_udpBuffer16->setAddress(const_cast<QString&>(settings.m_udpAddress));
+	    m_udpBufferMono16->setAddress(const_cast<QString&>(settings.m_udpAddress));
+	    m_udpBuffer24->setAddress(const_cast<QString&>(settings.m_udpAddress));
+	    m_udpBuffer16->setPort(settings.m_udpPort);
+	    m_udpBufferMono16->setPort(settings.m_udpPort);
+	    m_udpBuffer24->setPort(settings.m_udpPort);
+	}
+
+	if (m_interpolation.update()) {
+	    m_sampleDistanceRemain = m_interpolation->m_distance;
+	}
+
+	if (m_squelch.update()) {
+	    initSquelch(m_squelchOpen);
+	}
+
+	const UDPSinkSettings& settings = m_settingsSnapshot.get();
+	Interpolation& interpolation = m_interpolation.get();
+	Squelch& squelch = m_squelch.get();
 
 	for(SampleVector::const_iterator it = begin; it < end; ++it)
 	{
 		Complex c(it->real(), it->imag());
 		c *= m_nco.nextIQ();
 
-		if(m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
+		if(interpolation.m_interpolator.decimate(&m_sampleDistanceRemain, c, &ci))
 		{
 		    double inMagSq;
 		    double agcFactor = 1.0;
 
-            if ((m_settings.m_agc) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatNFM) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatNFMMono) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatIQ16) &&
-                (m_settings.m_sampleFormat != UDPSinkSettings::FormatIQ24))
+            if ((settings.m_agc) &&
+                (settings.m_sampleFormat != UDPSinkSettings::FormatNFM) &&
+                (settings.m_sampleFormat != UDPSinkSettings::FormatNFMMono) &&
+                (settings.m_sampleFormat != UDPSinkSettings::FormatIQ16) &&
+                (settings.m_sampleFormat != UDPSinkSettings::FormatIQ24))
             {
-                agcFactor = m_agc.feedAndGetValue(ci);
-                inMagSq = m_agc.getMagSq();
+                agcFactor = squelch.m_agc.feedAndGetValue(ci);
+                inMagSq = squelch.m_agc.getMagSq();
             }
             else
             {
                 inMagSq = ci.real()*ci.real() + ci.imag()*ci.imag();
             }
 
-		    m_inMovingAverage.feed(inMagSq / (SDR_RX_SCALED*SDR_RX_SCALED));
-		    m_inMagsq = m_inMovingAverage.average();
+		    squelch.m_inMovingAverage.feed(inMagSq / (SDR_RX_SCALED*SDR_RX_SCALED));
+		    m_inMagsq = squelch.m_inMovingAverage.average();
 
 			Sample ss(ci.real(), ci.imag());
 			m_sampleBuffer.push_back(ss);
 
-			m_sampleDistanceRemain += m_inputSampleRate / m_settings.m_outputSampleRate;
+			m_sampleDistanceRemain += interpolation.m_distance;
 
 			calculateSquelch(m_inMagsq);
 
-			if (m_settings.m_sampleFormat == UDPSinkSettings::FormatLSB) // binaural LSB
+			if (settings.m_sampleFormat == UDPSinkSettings::FormatLSB) // binaural LSB
 			{
 			    ci *= agcFactor;
 				int n_out = UDPFilter->runSSB(ci, &sideband, false);
@@ -194,14 +205,14 @@ void UDPSink::feed(const SampleVector::const_iterator& begin, const SampleVector
 				{
 					for (int i = 0; i < n_out; i++)
 					{
-						l = m_squelchOpen ? sideband[i].real() * m_settings.m_gain : 0;
-						r = m_squelchOpen ? sideband[i].imag() * m_settings.m_gain : 0;
+						l = m_squelchOpen ? sideband[i].real() * settings.m_gain : 0;
+						r = m_squelchOpen ? sideband[i].imag() * settings.m_gain : 0;
 						udpWrite(l, r);
-					    m_outMovingAverage.feed((l*l + r*r) / (SDR_RX_SCALED*SDR_RX_SCALED));
+					    squelch.m_outMovingAverage.feed((l*l + r*r) / (SDR_RX_SCALED*SDR_RX_SCALED));
 					}
 				}
 			}
-			if (m_settings.m_sampleFormat == UDPSinkSettings::FormatUSB) // binaural USB
+			if (settings.m_sampleFormat == UDPSinkSettings::FormatUSB) // binaural USB
 			{
 			    ci *= agcFactor;
 				int n_out = UDPFilter->runSSB(ci, &sideband, true);
@@ -210,26 +221,26 @@ void UDPSink::feed(const SampleVector::const_iterator& begin, const SampleVector
 				{
 					for (int i = 0; i < n_out; i++)
 					{
-						l = m_squelchOpen ? sideband[i].real() * m_settings.m_gain : 0;
-						r = m_squelchOpen ? sideband[i].imag() * m_settings.m_gain : 0;
+						l = m_squelchOpen ? sideband[i].real() * settings.m_gain : 0;
+						r = m_squelchOpen ? sideband[i].imag() * settings.m_gain : 0;
                         udpWrite(l, r);
-						m_outMovingAverage.feed((l*l + r*r) / (SDR_RX_SCALED*SDR_RX_SCALED));
+						squelch.m_outMovingAverage.feed((l*l + r*r) / (SDR_RX_SCALED*SDR_RX_SCALED));
 					}
 				}
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatNFM)
+			else if (settings.m_sampleFormat == UDPSinkSettings::FormatNFM)
 			{
-                Real discri = m_squelchOpen ? m_phaseDiscri.phaseDiscriminator(ci) * m_settings.m_gain : 0;
+                Real discri = m_squelchOpen ? m_phaseDiscri.phaseDiscriminator(ci) * settings.m_gain : 0;
 				udpWriteNorm(discri, discri);
-				m_outMovingAverage.feed(discri*discri);
+				squelch.m_outMovingAverage.feed(discri*discri);
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatNFMMono)
+			else if (settings.m_sampleFormat == UDPSinkSettings::FormatNFMMono)
 			{
-			    Real discri = m_squelchOpen ? m_phaseDiscri.phaseDiscriminator(ci) * m_settings.m_gain : 0;
+			    Real discri = m_squelchOpen ? m_phaseDiscri.phaseDiscriminator(ci) * settings.m_gain : 0;
 				udpWriteNormMono(discri);
-				m_outMovingAverage.feed(discri*discri);
+				squelch.m_outMovingAverage.feed(discri*discri);
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatLSBMono) // Monaural LSB
+			else if (settings.m_sampleFormat == UDPSinkSettings::FormatLSBMono) // Monaural LSB
 			{
 			    ci *= agcFactor;
 				int n_out = UDPFilter->runSSB(ci, &sideband, false);
@@ -238,13 +249,13 @@ void UDPSink::feed(const SampleVector::const_iterator& begin, const SampleVector
 				{
 					for (int i = 0; i < n_out; i++)
 					{
-						l = m_squelchOpen ? (sideband[i].real() + sideband[i].imag()) * 0.7 * m_settings.m_gain : 0;
+						l = m_squelchOpen ? (sideband[i].real() + sideband[i].imag()) * 0.7 * settings.m_gain : 0;
 		                udpWriteMono(l);
-						m_outMovingAverage.feed((l * l) / (SDR_RX_SCALED*SDR_RX_SCALED));
+						squelch.m_outMovingAverage.feed((l * l) / (SDR_RX_SCALED*SDR_RX_SCALED));
 					}
 				}
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatUSBMono) // Monaural USB
+			else if (settings.m_sampleFormat == UDPSinkSettings::FormatUSBMono) // Monaural USB
 			{
 			    ci *= agcFactor;
 				int n_out = UDPFilter->runSSB(ci, &sideband, true);
@@ -253,69 +264,69 @@ void UDPSink::feed(const SampleVector::const_iterator& begin, const SampleVector
 				{
 					for (int i = 0; i < n_out; i++)
 					{
-						l = m_squelchOpen ? (sideband[i].real() + sideband[i].imag()) * 0.7 * m_settings.m_gain : 0;
+						l = m_squelchOpen ? (sideband[i].real() + sideband[i].imag()) * 0.7 * settings.m_gain : 0;
                         udpWriteMono(l);
-						m_outMovingAverage.feed((l * l) / (SDR_RX_SCALED*SDR_RX_SCALED));
+						squelch.m_outMovingAverage.feed((l * l) / (SDR_RX_SCALED*SDR_RX_SCALED));
 					}
 				}
 			}
-			else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatAMMono)
+			else if (settings.m_sampleFormat == UDPSinkSettings::FormatAMMono)
 			{
-			    Real amplitude = m_squelchOpen ? sqrt(inMagSq) * agcFactor * m_settings.m_gain : 0;
+			    Real amplitude = m_squelchOpen ? sqrt(inMagSq) * agcFactor * settings.m_gain : 0;
 				FixReal demod = (FixReal) amplitude;
                 udpWriteMono(demod);
-				m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
+				squelch.m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
 			}
-            else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatAMNoDCMono)
+            else if (settings.m_sampleFormat == UDPSinkSettings::FormatAMNoDCMono)
             {
                 if (m_squelchOpen)
                 {
                     double demodf = sqrt(inMagSq);
-                    m_amMovingAverage.feed(demodf);
-                    Real amplitude = (demodf - m_amMovingAverage.average()) * agcFactor * m_settings.m_gain;
+                    squelch.m_amMovingAverage.feed(demodf);
+                    Real amplitude = (demodf - squelch.m_amMovingAverage.average()) * agcFactor * settings.m_gain;
                     FixReal demod = (FixReal) amplitude;
                     udpWriteMono(demod);
-                    m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
+                    squelch.m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
                 }
                 else
                 {
                     udpWriteMono(0);
-                    m_outMovingAverage.feed(0);
+                    squelch.m_outMovingAverage.feed(0);
                 }
             }
-            else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatAMBPFMono)
+            else if (settings.m_sampleFormat == UDPSinkSettings::FormatAMBPFMono)
             {
                 if (m_squelchOpen)
                 {
                     double demodf = sqrt(inMagSq);
-                    demodf = m_bandpass.filter(demodf);
+                    demodf = squelch.m_bandpass.filter(demodf);
                     demodf /= 301.0;
-                    Real amplitude = demodf * agcFactor * m_settings.m_gain;
+                    Real amplitude = demodf * agcFactor * settings.m_gain;
                     FixReal demod = (FixReal) amplitude;
                     udpWriteMono(demod);
-                    m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
+                    squelch.m_outMovingAverage.feed((amplitude/SDR_RX_SCALEF)*(amplitude/SDR_RX_SCALEF));
                 }
                 else
                 {
                     udpWriteMono(0);
-                    m_outMovingAverage.feed(0);
+                    squelch.m_outMovingAverage.feed(0);
                 }
             }
 			else // Raw I/Q samples
 			{
 			    if (m_squelchOpen)
 			    {
-	                udpWrite(ci.real() * m_settings.m_gain, ci.imag() * m_settings.m_gain);
-	                m_outMovingAverage.feed((inMagSq*m_settings.m_gain*m_settings.m_gain) / (SDR_RX_SCALED*SDR_RX_SCALED));
+	                udpWrite(ci.real() * settings.m_gain, ci.imag() * settings.m_gain);
+	                squelch.m_outMovingAverage.feed((inMagSq*settings.m_gain*settings.m_gain) / (SDR_RX_SCALED*SDR_RX_SCALED));
 			    }
 			    else
 			    {
 	                udpWrite(0, 0);
-	                m_outMovingAverage.feed(0);
+	                squelch.m_outMovingAverage.feed(0);
 			    }
 			}
 
-            m_magsq = m_outMovingAverage.average();
+            m_magsq = squelch.m_outMovingAverage.average();
 		}
 	}
 
@@ -325,8 +336,6 @@ void UDPSink::feed(const SampleVector::const_iterator& begin, const SampleVector
 	{
 		m_spectrum->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
 	}
-
-	m_settingsMutex.unlock();
 }
 
 void UDPSink::start()
@@ -481,12 +490,8 @@ void UDPSink::applyChannelSettings(int inputSampleRate, int inputFrequencyOffset
         m_nco.setFreq(-inputFrequencyOffset, inputSampleRate);
     }
 
-    if ((inputSampleRate != m_inputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_settings.m_rfBandwidth / 2.0);
-        m_sampleDistanceRemain = inputSampleRate / m_settings.m_outputSampleRate;
-        m_settingsMutex.unlock();
+    if ((inputSampleRate != m_inputSampleRate) || force) {
+        publishInterpolation(inputSampleRate, m_settings);
     }
 
     m_inputSampleRate = inputSampleRate;
@@ -570,39 +575,19 @@ void UDPSink::applySettings(const UDPSinkSettings& settings, bool force)
         reverseAPIKeys.append("audioPort");
     }
 
-    m_settingsMutex.lock();
-
-    if ((settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset) ||
-        (settings.m_rfBandwidth != m_settings.m_rfBandwidth) ||
+    if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) ||
         (settings.m_outputSampleRate != m_settings.m_outputSampleRate) || force)
     {
-        m_interpolator.create(16, m_inputSampleRate, settings.m_rfBandwidth / 2.0);
-        m_sampleDistanceRemain = m_inputSampleRate / settings.m_outputSampleRate;
-
-        if ((settings.m_sampleFormat == UDPSinkSettings::FormatLSB) ||
-            (settings.m_sampleFormat == UDPSinkSettings::FormatLSBMono) ||
-            (settings.m_sampleFormat == UDPSinkSettings::FormatUSB) ||
-            (settings.m_sampleFormat == UDPSinkSettings::FormatUSBMono))
-        {
-            m_squelchGate = settings.m_outputSampleRate * 0.05;
-        }
-        else
-        {
-            m_squelchGate = (settings.m_outputSampleRate * settings.m_squelchGate) / 100;
-        }
-
-        m_squelchRelease = (settings.m_outputSampleRate * settings.m_squelchGate) / 100;
-        initSquelch(m_squelchOpen);
-        m_agc.resize(settings.m_outputSampleRate/5, settings.m_outputSampleRate/20, m_agcTarget); // Fixed 200 ms
-        int stepDownDelay =  (settings.m_outputSampleRate * (settings.m_squelchGate == 0 ? 1 : settings.m_squelchGate))/100;
-        m_agc.setStepDownDelay(stepDownDelay);
-        m_agc.setGate(settings.m_outputSampleRate * 0.05);
-
-        m_bandpass.create(301, settings.m_outputSampleRate, 300.0, settings.m_rfBandwidth / 2.0f);
+        publishInterpolation(m_inputSampleRate, settings);
+    }
 
-        m_inMovingAverage.resize(settings.m_outputSampleRate * 0.01, 1e-10);  // 10 ms
-        m_amMovingAverage.resize(settings.m_outputSampleRate * 0.005, 1e-10); //  5 ms
-        m_outMovingAverage.resize(settings.m_outputSampleRate * 0.01, 1e-10); // 10 ms
+    if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) ||
+        (settings.m_outputSampleRate != m_settings.m_outputSampleRate) ||
+        (settings.m_sampleFormat != m_settings.m_sampleFormat) ||
+        (settings.m_squelchGate != m_settings.m_squelchGate) ||
+        (settings.m_squelchdB != m_settings.m_squelchdB) || force)
+    {
+        publishSquelch(settings);
     }
 
     if ((settings.m_audioActive != m_settings.m_audioActive) || force)
@@ -618,45 +603,7 @@ void UDPSink::applySettings(const UDPSinkSettings& settings, bool force)
         }
     }
 
-    if ((settings.m_squelchGate != m_settings.m_squelchGate) || force)
-    {
-        if ((settings.m_sampleFormat == UDPSinkSettings::FormatLSB) ||
-            (settings.m_sampleFormat == UDPSinkSettings::FormatLSBMono) ||
-            (settings.m_sampleFormat == UDPSinkSettings::FormatUSB) ||
-            (settings.m_sampleFormat == UDPSinkSettings::FormatUSBMono))
-        {
-            m_squelchGate = settings.m_outputSampleRate * 0.05;
-        }
-        else
-        {
-            m_squelchGate = (settings.m_outputSampleRate * settings.m_squelchGate)/100;
-        }
-
-        m_squelchRelease = (settings.m_outputSampleRate * settings.m_squelchGate)/100;
-        initSquelch(m_squelchOpen);
-        int stepDownDelay =  (settings.m_outputSampleRate * (settings.m_squelchGate == 0 ? 1 : settings.m_squelchGate))/100;
-        m_agc.setStepDownDelay(stepDownDelay); // same delay for up and down
-    }
-
-    if ((settings.m_squelchdB != m_settings.m_squelchdB) || force)
-    {
-        m_squelch = CalcDb::powerFromdB(settings.m_squelchdB);
-        m_agc.setThreshold(m_squelch*(1<<23));
-    }
-
-    if ((settings.m_udpAddress != m_settings.m_udpAddress) || force)
-    {
-        m_udpBuffer16->setAddress(const_cast<QString&>(settings.m_udpAddress));
-        m_udpBufferMono16->setAddress(const_cast<QString&>(settings.m_udpAddress));
-        m_udpBuffer24->setAddress(const_cast<QString&>(settings.m_udpAddress));
-    }
-
-    if ((settings.m_udpPort != m_settings.m_udpPort) || force)
-    {
-        m_udpBuffer16->setPort(settings.m_udpPort);
-        m_udpBufferMono16->setPort(settings.m_udpPort);
-        m_udpBuffer24->setPort(settings.m_udpPort);
-    }
+    // the UDP destination is set by the DSP thread when it picks up the settings
 
     if ((settings.m_audioPort != m_settings.m_audioPort) || force)
     {
@@ -680,8 +627,6 @@ void UDPSink::applySettings(const UDPSinkSettings& settings, bool force)
         m_phaseDiscri.setFMScaling((float) settings.m_outputSampleRate / (2.0f * settings.m_fmDeviation));
     }
 
-    m_settingsMutex.unlock();
-
     if (settings.m_useReverseAPI)
     {
         bool fullUpdate = ((m_settings.m_useReverseAPI != settings.m_useReverseAPI) && settings.m_useReverseAPI) ||
@@ -693,6 +638,47 @@ void UDPSink::applySettings(const UDPSinkSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
+}
+
+void UDPSink::publishInterpolation(int inputSampleRate, const UDPSinkSettings& settings)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(16, inputSampleRate, settings.m_rfBandwidth / 2.0);
+    interpolation->m_distance = inputSampleRate / settings.m_outputSampleRate;
+    m_interpolation.publish(interpolation);
+}
+
+void UDPSink::publishSquelch(const UDPSinkSettings& settings)
+{
+    Squelch *squelch = new Squelch();
+    squelch->m_level = CalcDb::powerFromdB(settings.m_squelchdB);
+
+    if ((settings.m_sampleFormat == UDPSinkSettings::FormatLSB) ||
+        (settings.m_sampleFormat == UDPSinkSettings::FormatLSBMono) ||
+        (settings.m_sampleFormat == UDPSinkSettings::FormatUSB) ||
+        (settings.m_sampleFormat == UDPSinkSettings::FormatUSBMono))
+    {
+        squelch->m_gate = settings.m_outputSampleRate * 0.05;
+    }
+    else
+    {
+        squelch->m_gate = (settings.m_outputSampleRate * settings.m_squelchGate) / 100;
+    }
+
+    squelch->m_release = (settings.m_outputSampleRate * settings.m_squelchGate) / 100;
+    squelch->m_agc.resize(settings.m_outputSampleRate/5, settings.m_outputSampleRate/20, m_agcTarget); // Fixed 200 ms
+    int stepDownDelay =  (settings.m_outputSampleRate * (settings.m_squelchGate == 0 ? 1 : settings.m_squelchGate))/100;
+    squelch->m_agc.setStepDownDelay(stepDownDelay); // same delay for up and down
+    squelch->m_agc.setGate(settings.m_outputSampleRate * 0.05);
+    squelch->m_agc.setThreshold(squelch->m_level*(1<<23));
+
+    squelch->m_bandpass.create(301, settings.m_outputSampleRate, 300.0, settings.m_rfBandwidth / 2.0f);
+
+    squelch->m_inMovingAverage.resize(settings.m_outputSampleRate * 0.01, 1e-10);  // 10 ms
+    squelch->m_amMovingAverage.resize(settings.m_outputSampleRate * 0.005, 1e-10); //  5 ms
+    squelch->m_outMovingAverage.resize(settings.m_outputSampleRate * 0.01, 1e-10); // 10 ms
+    m_squelch.publish(squelch);
 }
 
 QByteArray UDPSink::serialize() const
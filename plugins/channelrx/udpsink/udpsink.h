@@ -19,7 +19,6 @@
 #ifndef INCLUDE_UDPSRC_H
 #define INCLUDE_UDPSRC_H
 
-#include <QMutex>
 #include <QHostAddress>
 #include <QNetworkRequest>
 
@@ -34,6 +33,7 @@
 #include "dsp/bandpass.h"
 #include "util/udpsinkutil.h"
 #include "util/message.h"
+#include "util/settingssnapshot.h"
 #include "audio/audiofifo.h"
 
 #include "udpsinksettings.h"
@@ -189,6 +189,37 @@ protected:
         int32_t m_i;
     };
 
+    struct Interpolation //!< channel to output sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct Squelch //!< squelch, AGC and level averages at output sample rate
+    {
+        Squelch() :
+            m_level(1e-6),
+            m_gate(4800),
+            m_release(4800),
+            m_agc(9600, m_agcTarget, 1e-6),
+            m_inMovingAverage(480, 1e-10),
+            m_amMovingAverage(1200, 1e-10),
+            m_outMovingAverage(480, 1e-10)
+        {
+            m_agc.setClampMax(SDR_RX_SCALED*SDR_RX_SCALED);
+            m_agc.setClamping(true);
+        }
+        double m_level;
+        int m_gate;    //!< number of samples computed from given gate
+        int m_release;
+        MagAGC m_agc;
+        Bandpass<double> m_bandpass;
+        MovingAverage<double> m_inMovingAverage;
+        MovingAverage<double> m_amMovingAverage;
+        MovingAverage<double> m_outMovingAverage;
+    };
+
     DeviceAPI *m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
@@ -197,19 +228,20 @@ protected:
     int m_inputFrequencyOffset;
     UDPSinkSettings m_settings;
 
+    // States published by the configuration and picked up by feed() at block boundaries
+    SettingsSnapshot<UDPSinkSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<Squelch> m_squelch;
+
 	QUdpSocket *m_audioSocket;
 
 	double m_magsq;
     double m_inMagsq;
-    MovingAverage<double> m_outMovingAverage;
-    MovingAverage<double> m_inMovingAverage;
-    MovingAverage<double> m_amMovingAverage;
 
 	Real m_scale;
 	Complex m_last, m_this;
 
 	NCO m_nco;
-	Interpolator m_interpolator;
 	Real m_sampleDistanceRemain;
 	fftfilt* UDPFilter;
 
@@ -234,23 +266,17 @@ protected:
 
     PhaseDiscriminators m_phaseDiscri;
 
-    double m_squelch;
     bool m_squelchOpen;
     int  m_squelchOpenCount;
     int  m_squelchCloseCount;
-    int  m_squelchGate; //!< number of samples computed from given gate
-    int  m_squelchRelease;
-
-    MagAGC m_agc;
-    Bandpass<double> m_bandpass;
 
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
-	QMutex m_settingsMutex;
-
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = true);
     void applySettings(const UDPSinkSettings& settings, bool force = false);
+    void publishInterpolation(int inputSampleRate, const UDPSinkSettings& settings);
+    void publishSquelch(const UDPSinkSettings& settings);
 
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const UDPSinkSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
@@ -258,28 +284,30 @@ protected:
 
     inline void calculateSquelch(double value)
     {
-        if ((!m_settings.m_squelchEnabled) || (value > m_squelch))
+        const Squelch& squelch = m_squelch.get();
+
+        if ((!m_settingsSnapshot->m_squelchEnabled) || (value > squelch.m_level))
         {
-            if (m_squelchGate == 0)
+            if (squelch.m_gate == 0)
             {
                 m_squelchOpen = true;
             }
             else
             {
-                if (m_squelchOpenCount < m_squelchGate)
+                if (m_squelchOpenCount < squelch.m_gate)
                 {
                     m_squelchOpenCount++;
                 }
                 else
                 {
-                    m_squelchCloseCount = m_squelchRelease;
+                    m_squelchCloseCount = squelch.m_release;
                     m_squelchOpen = true;
                 }
             }
         }
         else
         {
-            if (m_squelchGate == 0)
+            if (squelch.m_gate == 0)
             {
                 m_squelchOpen = false;
             }
@@ -303,8 +331,8 @@ protected:
         if (open)
         {
             m_squelchOpen = true;
-            m_squelchOpenCount = m_squelchGate;
-            m_squelchCloseCount = m_squelchRelease;
+            m_squelchOpenCount = m_squelch->m_gate;
+            m_squelchCloseCount = m_squelch->m_release;
         }
         else
         {
@@ -318,9 +346,9 @@ protected:
     {
         if (SDR_RX_SAMP_SZ == 16)
         {
-            if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ16) {
+            if (m_settingsSnapshot->m_sampleFormat == UDPSinkSettings::FormatIQ16) {
                 m_udpBuffer16->write(Sample16(real, imag));
-            } else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ24) {
+            } else if (m_settingsSnapshot->m_sampleFormat == UDPSinkSettings::FormatIQ24) {
                 m_udpBuffer24->write(Sample24(real<<8, imag<<8));
             } else {
                 m_udpBuffer16->write(Sample16(real, imag));
@@ -328,9 +356,9 @@ protected:
         }
         else if (SDR_RX_SAMP_SZ == 24)
         {
-            if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ16) {
+            if (m_settingsSnapshot->m_sampleFormat == UDPSinkSettings::FormatIQ16) {
                 m_udpBuffer16->write(Sample16(real>>8, imag>>8));
-            } else if (m_settings.m_sampleFormat == UDPSinkSettings::FormatIQ24) {
+            } else if (m_settingsSnapshot->m_sampleFormat == UDPSinkSettings::FormatIQ24) {
                 m_udpBuffer24->write(Sample24(real, imag));
             } else {
                 m_udpBuffer16->write(Sample16(real>>8, imag>>8));
@@ -159,7 +159,67 @@ void FileSource::pull(Sample& sample)
         im = 0;
     }
 
+    setSample(sample, re, im);
+}
+
+void FileSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    if (!m_running || ((m_sampleSize != 16) && (m_sampleSize != 24)))
+    {
+        for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+            pull(*begin);
+        }
+
+        return;
+    }
+
+    // read the whole block from file at once
+    unsigned int sampleBytes = m_sampleSize == 16 ? 2*sizeof(int16_t) : 2*sizeof(int32_t);
+
+    if (m_fileBuffer.size() < nbSamples*sampleBytes) {
+        m_fileBuffer.resize(nbSamples*sampleBytes);
+    }
+
+    m_ifstream.read(m_fileBuffer.data(), nbSamples*sampleBytes);
+    unsigned int nbRead = m_ifstream.gcount() / sampleBytes;
+    m_samplesCount += nbRead;
+
+    if (m_sampleSize == 16)
+    {
+        const int16_t *buf = reinterpret_cast<const int16_t*>(m_fileBuffer.data());
+
+        for (unsigned int i = 0; i < nbRead; i++, ++begin) { // scale to +/-1.0
+            setSample(*begin, (buf[2*i] * m_linearGain) / 32760.0f, (buf[2*i+1] * m_linearGain) / 32760.0f);
+        }
+    }
+    else
+    {
+        const int32_t *buf = reinterpret_cast<const int32_t*>(m_fileBuffer.data());
+
+        for (unsigned int i = 0; i < nbRead; i++, ++begin) { // scale to +/-1.0
+            setSample(*begin, (buf[2*i] * m_linearGain) / 8388608.0f, (buf[2*i+1] * m_linearGain) / 8388608.0f);
+        }
+    }
+
+    if (nbRead < nbSamples) // end of file: loop or stop then complete the block
+    {
+        handleEOF();
 
+        if (nbRead > 0)
+        {
+            pull(begin, nbSamples - nbRead);
+        }
+        else
+        {
+            for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+                pull(*begin);
+            }
+        }
+    }
+}
+
+void FileSource::setSample(Sample& sample, Real re, Real im)
+{
     if (SDR_TX_SAMP_SZ == 16)
     {
         sample.setReal(re * 32768.0f);
@@ -311,6 +311,7 @@ public:
     virtual void destroy() { delete this; }
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -394,6 +395,7 @@ private:
     UpChannelizer* m_channelizer;
     FileSourceSettings m_settings;
 	std::ifstream m_ifstream;
+    std::vector<char> m_fileBuffer; //!< raw samples read from file in block
 	QString m_fileName;
 	quint32 m_sampleSize;
 	quint64 m_centerFrequency;
@@ -420,6 +422,7 @@ private:
 	void openFileStream();
 	void seekFileStream(int seekMillis);
     void handleEOF();
+    void setSample(Sample& sample, Real re, Real im); //!< scale sample to Tx size and update levels
     void applySettings(const FileSourceSettings& settings, bool force = false);
     void validateFilterChainHash(FileSourceSettings& settings);
     void calculateFrequencyOffset();
@@ -20,7 +20,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QMutexLocker>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QBuffer>
@@ -57,10 +56,10 @@ AMMod::AMMod(DeviceAPI *deviceAPI) :
     m_outputSampleRate(48000),
     m_inputFrequencyOffset(0),
     m_audioFifo(4800),
-	m_settingsMutex(QMutex::Recursive),
 	m_fileSize(0),
 	m_recordLength(0),
 	m_sampleRate(48000),
+	m_fileSeekPoint(-1),
 	m_levelCalcCount(0),
 	m_peakLevel(0.0f),
 	m_levelSum(0.0f)
@@ -74,7 +73,6 @@ AMMod::AMMod(DeviceAPI *deviceAPI) :
 
 	DSPEngine::instance()->getAudioDeviceManager()->addAudioSource(&m_audioFifo, getInputMessageQueue());
 	m_audioSampleRate = DSPEngine::instance()->getAudioDeviceManager()->getInputSampleRate();
-	m_toneNco.setFreq(1000.0, m_audioSampleRate);
 
 	// CW keyer
 	m_cwKeyer.setSampleRate(m_audioSampleRate);
@@ -106,7 +104,46 @@ AMMod::~AMMod()
 
 void AMMod::pull(Sample& sample)
 {
-	if (m_settings.m_channelMute)
+    updateStates();
+    pullOne(sample);
+}
+
+void AMMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    updateStates(); // once for the whole block
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+}
+
+void AMMod::updateStates()
+{
+    bool settingsChanged = m_settingsSnapshot.update();
+    bool interpolationChanged = m_interpolation.update();
+
+    if (interpolationChanged)
+    {
+        m_interpolatorDistanceRemain = 0;
+        m_interpolatorConsumed = false;
+    }
+
+    if (settingsChanged || interpolationChanged) {
+        m_toneNco.setFreq(m_settingsSnapshot->m_toneFrequency, m_interpolation->m_audioSampleRate);
+    }
+
+    int seekPoint = m_fileSeekPoint.fetchAndStoreOrdered(-1);
+
+    if ((seekPoint >= 0) && m_ifstream.is_open())
+    {
+        m_ifstream.clear();
+        m_ifstream.seekg(seekPoint, std::ios::beg);
+    }
+}
+
+void AMMod::pullOne(Sample& sample)
+{
+	if (m_settingsSnapshot->m_channelMute)
 	{
 		sample.m_real = 0.0f;
 		sample.m_imag = 0.0f;
@@ -114,32 +151,29 @@ void AMMod::pull(Sample& sample)
 	}
 
 	Complex ci;
+    Interpolation& interpolation = m_interpolation.get();
 
-	m_settingsMutex.lock();
-
-    if (m_interpolatorDistance > 1.0f) // decimate
+    if (interpolation.m_distance > 1.0f) // decimate
     {
     	modulateSample();
 
-        while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        while (!interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
         	modulateSample();
         }
     }
     else
     {
-        if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        if (interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
         	modulateSample();
         }
     }
 
-    m_interpolatorDistanceRemain += m_interpolatorDistance;
+    m_interpolatorDistanceRemain += interpolation.m_distance;
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
 	m_movingAverage(magsq);
@@ -171,13 +205,15 @@ void AMMod::modulateSample()
     calculateLevel(t);
     m_audioBufferFill++;
 
-    m_modSample.real((t*m_settings.m_modFactor + 1.0f) * 16384.0f); // modulate and scale zero frequency carrier
+    m_modSample.real((t*m_settingsSnapshot->m_modFactor + 1.0f) * 16384.0f); // modulate and scale zero frequency carrier
     m_modSample.imag(0.0f);
 }
 
 void AMMod::pullAF(Real& sample)
 {
-    switch (m_settings.m_modAFInput)
+    const AMModSettings& settings = m_settingsSnapshot.get();
+
+    switch (settings.m_modAFInput)
     {
     case AMModSettings::AMModInputTone:
         sample = m_toneNco.next();
@@ -189,7 +225,7 @@ void AMMod::pullAF(Real& sample)
         {
             if (m_ifstream.eof())
             {
-            	if (m_settings.m_playLoop)
+            	if (settings.m_playLoop)
             	{
                     m_ifstream.clear();
                     m_ifstream.seekg(0, std::ios::beg);
@@ -203,7 +239,7 @@ void AMMod::pullAF(Real& sample)
             else
             {
             	m_ifstream.read(reinterpret_cast<char*>(&sample), sizeof(Real));
-            	sample *= m_settings.m_volumeFactor;
+            	sample *= settings.m_volumeFactor;
             }
         }
         else
@@ -212,7 +248,7 @@ void AMMod::pullAF(Real& sample)
         }
         break;
     case AMModSettings::AMModInputAudio:
-        sample = ((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r) / 65536.0f) * m_settings.m_volumeFactor;
+        sample = ((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r) / 65536.0f) * settings.m_volumeFactor;
         break;
     case AMModSettings::AMModInputCWTone:
         Real fadeFactor;
@@ -399,15 +435,10 @@ void AMMod::openFileStream()
 
 void AMMod::seekFileStream(int seekPercentage)
 {
-    QMutexLocker mutexLocker(&m_settingsMutex);
-
-    if (m_ifstream.is_open())
-    {
-        int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
-        seekPoint *= sizeof(Real);
-        m_ifstream.clear();
-        m_ifstream.seekg(seekPoint, std::ios::beg);
-    }
+    // the stream is read by the DSP thread which does the seek at the next block
+    int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
+    seekPoint *= sizeof(Real);
+    m_fileSeekPoint.fetchAndStoreOrdered(seekPoint);
 }
 
 void AMMod::applyAudioSampleRate(int sampleRate)
@@ -418,20 +449,21 @@ void AMMod::applyAudioSampleRate(int sampleRate)
             sampleRate, m_settings.m_inputFrequencyOffset);
     m_inputMessageQueue.push(channelConfigMsg);
 
-    m_settingsMutex.lock();
-
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorConsumed = false;
-    m_interpolatorDistance = (Real) sampleRate / (Real) m_outputSampleRate;
-    m_interpolator.create(48, sampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
-    m_toneNco.setFreq(m_settings.m_toneFrequency, sampleRate);
+    publishInterpolation(sampleRate, m_outputSampleRate, m_settings.m_rfBandwidth); // tone NCO follows when it is picked up
     m_cwKeyer.setSampleRate(sampleRate);
 
-    m_settingsMutex.unlock();
-
     m_audioSampleRate = sampleRate;
 }
 
+void AMMod::publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, Real rfBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(48, audioSampleRate, rfBandwidth / 2.2, 3.0);
+    interpolation->m_distance = (Real) audioSampleRate / (Real) outputSampleRate;
+    interpolation->m_audioSampleRate = audioSampleRate;
+    m_interpolation.publish(interpolation);
+}
+
 void AMMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force)
 {
     qDebug() << "AMMod::applyChannelSettings:"
@@ -442,19 +474,11 @@ void AMMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate, i
     if ((inputFrequencyOffset != m_inputFrequencyOffset) ||
         (outputSampleRate != m_outputSampleRate) || force)
     {
-        m_settingsMutex.lock();
         m_carrierNco.setFreq(inputFrequencyOffset, outputSampleRate);
-        m_settingsMutex.unlock();
     }
 
-    if ((outputSampleRate != m_outputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
-        m_settingsMutex.unlock();
+    if ((outputSampleRate != m_outputSampleRate) || force) {
+        publishInterpolation(m_audioSampleRate, outputSampleRate, m_settings.m_rfBandwidth);
     }
 
     m_basebandSampleRate = basebandSampleRate;
@@ -483,6 +507,21 @@ void AMMod::applySettings(const AMModSettings& settings, bool force)
 
     QList<QString> reverseAPIKeys;
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        reverseAPIKeys.append("audioDeviceName");
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
+        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            reverseAPIKeys.append("audioSampleRate");
+            applyAudioSampleRate(audioSampleRate);
+        }
+    }
+
     if ((settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset) || force) {
         reverseAPIKeys.append("inputFrequencyOffset");
     }
@@ -510,34 +549,12 @@ void AMMod::applySettings(const AMModSettings& settings, bool force)
     if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         reverseAPIKeys.append("rfBandwidth");
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) m_outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, settings.m_rfBandwidth / 2.2, 3.0);
-        m_settingsMutex.unlock();
+        publishInterpolation(m_audioSampleRate, m_outputSampleRate, settings.m_rfBandwidth);
     }
 
-    if ((settings.m_toneFrequency != m_settings.m_toneFrequency) || force)
-    {
+    // tone NCO frequency is set by the DSP thread when it picks up the settings
+    if ((settings.m_toneFrequency != m_settings.m_toneFrequency) || force) {
         reverseAPIKeys.append("toneFrequency");
-        m_settingsMutex.lock();
-        m_toneNco.setFreq(settings.m_toneFrequency, m_audioSampleRate);
-        m_settingsMutex.unlock();
-    }
-
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
-    {
-        reverseAPIKeys.append("audioDeviceName");
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
-        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            reverseAPIKeys.append("audioSampleRate");
-            applyAudioSampleRate(audioSampleRate);
-        }
     }
 
     if (settings.m_useReverseAPI)
@@ -551,6 +568,7 @@ void AMMod::applySettings(const AMModSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
 }
 
 QByteArray AMMod::serialize() const
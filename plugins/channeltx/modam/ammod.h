@@ -22,7 +22,7 @@
 #include <iostream>
 #include <fstream>
 
-#include <QMutex>
+#include <QAtomicInt>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
@@ -35,6 +35,7 @@
 #include "dsp/cwkeyer.h"
 #include "audio/audiofifo.h"
 #include "util/message.h"
+#include "util/settingssnapshot.h"
 
 #include "ammodsettings.h"
 
@@ -206,6 +207,7 @@ public:
     virtual void destroy() { delete this; }
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -265,6 +267,14 @@ private:
         RSRunning
     };
 
+    struct Interpolation //!< audio to channel sample rate
+    {
+        Interpolation() : m_distance(1.0f), m_audioSampleRate(48000) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+        uint32_t m_audioSampleRate; //!< audio sample rate the interpolator and tone NCO are built for
+    };
+
     DeviceAPI* m_deviceAPI;
     ThreadedBasebandSampleSource* m_threadedChannelizer;
     UpChannelizer* m_channelizer;
@@ -275,11 +285,13 @@ private:
     AMModSettings m_settings;
     quint32 m_audioSampleRate;
 
+    // States published by the configuration and picked up by pull() at block boundaries
+    SettingsSnapshot<AMModSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+
     NCO m_carrierNco;
     NCOF m_toneNco;
     Complex m_modSample;
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
     bool m_interpolatorConsumed;
 
@@ -291,13 +303,13 @@ private:
 
     AudioFifo m_audioFifo;
     SampleVector m_sampleBuffer;
-    QMutex m_settingsMutex;
 
     std::ifstream m_ifstream;
     QString m_fileName;
     quint64 m_fileSize;     //!< raw file size (bytes)
     quint32 m_recordLength; //!< record length in seconds computed from file size
     int m_sampleRate;
+    QAtomicInt m_fileSeekPoint; //!< byte offset requested by the GUI, -1 if none
 
     quint32 m_levelCalcCount;
     Real m_peakLevel;
@@ -314,9 +326,12 @@ private:
     void applySettings(const AMModSettings& settings, bool force = false);
     void pullAF(Real& sample);
     void calculateLevel(Real& sample);
+    void updateStates();
+    void pullOne(Sample& sample);
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
+    void publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, Real rfBandwidth);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const AMModSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const AMModSettings& settings, bool force);
@@ -17,7 +17,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QMutexLocker>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QBuffer>
@@ -60,10 +59,10 @@ NFMMod::NFMMod(DeviceAPI *deviceAPI) :
 	m_inputFrequencyOffset(0),
 	m_modPhasor(0.0f),
     m_audioFifo(4800),
-	m_settingsMutex(QMutex::Recursive),
 	m_fileSize(0),
 	m_recordLength(0),
 	m_sampleRate(48000),
+	m_fileSeekPoint(-1),
 	m_levelCalcCount(0),
 	m_peakLevel(0.0f),
 	m_levelSum(0.0f)
@@ -78,10 +77,6 @@ NFMMod::NFMMod(DeviceAPI *deviceAPI) :
 	DSPEngine::instance()->getAudioDeviceManager()->addAudioSource(&m_audioFifo, getInputMessageQueue());
 	m_audioSampleRate = DSPEngine::instance()->getAudioDeviceManager()->getInputSampleRate();
 
-    m_lowpass.create(301, m_audioSampleRate, 250.0);
-	m_toneNco.setFreq(1000.0, m_audioSampleRate);
-	m_ctcssNco.setFreq(88.5, m_audioSampleRate);
-
     // CW keyer
     m_cwKeyer.setSampleRate(m_audioSampleRate);
     m_cwKeyer.setWPM(13);
@@ -112,7 +107,50 @@ NFMMod::~NFMMod()
 
 void NFMMod::pull(Sample& sample)
 {
-	if (m_settings.m_channelMute)
+    updateStates();
+    pullOne(sample);
+}
+
+void NFMMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    updateStates(); // once for the whole block
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+}
+
+void NFMMod::updateStates()
+{
+    bool settingsChanged = m_settingsSnapshot.update();
+    bool afFiltersChanged = m_afFilters.update();
+
+    if (settingsChanged || afFiltersChanged)
+    {
+        const NFMModSettings& settings = m_settingsSnapshot.get();
+        uint32_t audioSampleRate = m_afFilters->m_sampleRate;
+        m_toneNco.setFreq(settings.m_toneFrequency, audioSampleRate);
+        m_ctcssNco.setFreq(NFMModSettings::getCTCSSFreq(settings.m_ctcssIndex), audioSampleRate);
+    }
+
+    if (m_interpolation.update())
+    {
+        m_interpolatorDistanceRemain = 0;
+        m_interpolatorConsumed = false;
+    }
+
+    int seekPoint = m_fileSeekPoint.fetchAndStoreOrdered(-1);
+
+    if ((seekPoint >= 0) && m_ifstream.is_open())
+    {
+        m_ifstream.clear();
+        m_ifstream.seekg(seekPoint, std::ios::beg);
+    }
+}
+
+void NFMMod::pullOne(Sample& sample)
+{
+	if (m_settingsSnapshot->m_channelMute)
 	{
 		sample.m_real = 0.0f;
 		sample.m_imag = 0.0f;
@@ -120,32 +158,29 @@ void NFMMod::pull(Sample& sample)
 	}
 
 	Complex ci;
+    Interpolation& interpolation = m_interpolation.get();
 
-	m_settingsMutex.lock();
-
-    if (m_interpolatorDistance > 1.0f) // decimate
+    if (interpolation.m_distance > 1.0f) // decimate
     {
     	modulateSample();
 
-        while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        while (!interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
         	modulateSample();
         }
     }
     else
     {
-        if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        if (interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
         	modulateSample();
         }
     }
 
-    m_interpolatorDistanceRemain += m_interpolatorDistance;
+    m_interpolatorDistanceRemain += interpolation.m_distance;
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
 	m_movingAverage(magsq);
@@ -171,19 +206,21 @@ void NFMMod::pullAudio(int nbSamples)
 void NFMMod::modulateSample()
 {
 	Real t;
+    const NFMModSettings& settings = m_settingsSnapshot.get();
+    AFFilters& afFilters = m_afFilters.get();
 
     pullAF(t);
     calculateLevel(t);
     m_audioBufferFill++;
 
-    if (m_settings.m_ctcssOn)
+    if (settings.m_ctcssOn)
     {
-        m_modPhasor += (m_settings.m_fmDeviation / (float) m_audioSampleRate) * (0.85f * m_bandpass.filter(t) + 0.15f * 378.0f * m_ctcssNco.next()) * (M_PI / 378.0f);
+        m_modPhasor += (settings.m_fmDeviation / (float) afFilters.m_sampleRate) * (0.85f * afFilters.m_bandpass.filter(t) + 0.15f * 378.0f * m_ctcssNco.next()) * (M_PI / 378.0f);
     }
     else
     {
         // 378 = 302 * 1.25; 302 = number of filter taps (established experimentally)
-        m_modPhasor += (m_settings.m_fmDeviation / (float) m_audioSampleRate) * m_bandpass.filter(t) * (M_PI / 378.0f);
+        m_modPhasor += (settings.m_fmDeviation / (float) afFilters.m_sampleRate) * afFilters.m_bandpass.filter(t) * (M_PI / 378.0f);
     }
 
     m_modSample.real(cos(m_modPhasor) * 0.891235351562f * SDR_TX_SCALEF); // -1 dB
@@ -192,7 +229,9 @@ void NFMMod::modulateSample()
 
 void NFMMod::pullAF(Real& sample)
 {
-    switch (m_settings.m_modAFInput)
+    const NFMModSettings& settings = m_settingsSnapshot.get();
+
+    switch (settings.m_modAFInput)
     {
     case NFMModSettings::NFMModInputTone:
         sample = m_toneNco.next();
@@ -204,7 +243,7 @@ void NFMMod::pullAF(Real& sample)
         {
             if (m_ifstream.eof())
             {
-            	if (m_settings.m_playLoop)
+            	if (settings.m_playLoop)
             	{
                     m_ifstream.clear();
                     m_ifstream.seekg(0, std::ios::beg);
@@ -218,7 +257,7 @@ void NFMMod::pullAF(Real& sample)
             else
             {
             	m_ifstream.read(reinterpret_cast<char*>(&sample), sizeof(Real));
-            	sample *= m_settings.m_volumeFactor;
+            	sample *= settings.m_volumeFactor;
             }
         }
         else
@@ -227,7 +266,7 @@ void NFMMod::pullAF(Real& sample)
         }
         break;
     case NFMModSettings::NFMModInputAudio:
-        sample = ((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r) / 65536.0f) * m_settings.m_volumeFactor;
+        sample = ((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r) / 65536.0f) * settings.m_volumeFactor;
         break;
     case NFMModSettings::NFMModInputCWTone:
         Real fadeFactor;
@@ -415,15 +454,10 @@ void NFMMod::openFileStream()
 
 void NFMMod::seekFileStream(int seekPercentage)
 {
-    QMutexLocker mutexLocker(&m_settingsMutex);
-
-    if (m_ifstream.is_open())
-    {
-        int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
-        seekPoint *= sizeof(Real);
-        m_ifstream.clear();
-        m_ifstream.seekg(seekPoint, std::ios::beg);
-    }
+    // the stream is read by the DSP thread which does the seek at the next block
+    int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
+    seekPoint *= sizeof(Real);
+    m_fileSeekPoint.fetchAndStoreOrdered(seekPoint);
 }
 
 void NFMMod::applyAudioSampleRate(int sampleRate)
@@ -434,23 +468,29 @@ void NFMMod::applyAudioSampleRate(int sampleRate)
             sampleRate, m_settings.m_inputFrequencyOffset);
     m_inputMessageQueue.push(channelConfigMsg);
 
-    m_settingsMutex.lock();
-
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorConsumed = false;
-    m_interpolatorDistance = (Real) sampleRate / (Real) m_outputSampleRate;
-    m_interpolator.create(48, sampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
-    m_lowpass.create(301, sampleRate, 250.0);
-    m_bandpass.create(301, sampleRate, 300.0, m_settings.m_afBandwidth);
-    m_toneNco.setFreq(m_settings.m_toneFrequency, sampleRate);
-    m_ctcssNco.setFreq(NFMModSettings::getCTCSSFreq(m_settings.m_ctcssIndex), sampleRate);
+    publishInterpolation(sampleRate, m_outputSampleRate, m_settings.m_rfBandwidth);
+    publishAFFilters(sampleRate, m_settings.m_afBandwidth); // tone NCOs follow when it is picked up
     m_cwKeyer.setSampleRate(sampleRate);
 
-    m_settingsMutex.unlock();
-
     m_audioSampleRate = sampleRate;
 }
 
+void NFMMod::publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, Real rfBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(48, audioSampleRate, rfBandwidth / 2.2, 3.0);
+    interpolation->m_distance = (Real) audioSampleRate / (Real) outputSampleRate;
+    m_interpolation.publish(interpolation);
+}
+
+void NFMMod::publishAFFilters(uint32_t audioSampleRate, Real afBandwidth)
+{
+    AFFilters *afFilters = new AFFilters();
+    afFilters->m_bandpass.create(301, audioSampleRate, 300.0, afBandwidth);
+    afFilters->m_sampleRate = audioSampleRate;
+    m_afFilters.publish(afFilters);
+}
+
 void NFMMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force)
 {
     qDebug() << "NFMMod::applyChannelSettings:"
@@ -461,19 +501,11 @@ void NFMMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate,
     if ((inputFrequencyOffset != m_inputFrequencyOffset) ||
         (outputSampleRate != m_outputSampleRate) || force)
     {
-        m_settingsMutex.lock();
         m_carrierNco.setFreq(inputFrequencyOffset, outputSampleRate);
-        m_settingsMutex.unlock();
     }
 
-    if ((outputSampleRate != m_outputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
-        m_settingsMutex.unlock();
+    if ((outputSampleRate != m_outputSampleRate) || force) {
+        publishInterpolation(m_audioSampleRate, outputSampleRate, m_settings.m_rfBandwidth);
     }
 
     m_basebandSampleRate = basebandSampleRate;
@@ -505,6 +537,21 @@ void NFMMod::applySettings(const NFMModSettings& settings, bool force)
 
     QList<QString> reverseAPIKeys;
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        reverseAPIKeys.append("audioDeviceName");
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
+        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            reverseAPIKeys.append("audioSampleRate");
+            applyAudioSampleRate(audioSampleRate);
+        }
+    }
+
     if ((settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset) || force) {
         reverseAPIKeys.append("inputFrequencyOffset");
     }
@@ -536,51 +583,22 @@ void NFMMod::applySettings(const NFMModSettings& settings, bool force)
     if((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         reverseAPIKeys.append("rfBandwidth");
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) m_outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, settings.m_rfBandwidth / 2.2, 3.0);
-        m_settingsMutex.unlock();
+        publishInterpolation(m_audioSampleRate, m_outputSampleRate, settings.m_rfBandwidth);
     }
 
     if ((settings.m_afBandwidth != m_settings.m_afBandwidth) || force)
     {
         reverseAPIKeys.append("afBandwidth");
-        m_settingsMutex.lock();
-        m_lowpass.create(301, m_audioSampleRate, 250.0);
-        m_bandpass.create(301, m_audioSampleRate, 300.0, settings.m_afBandwidth);
-        m_settingsMutex.unlock();
+        publishAFFilters(m_audioSampleRate, settings.m_afBandwidth);
     }
 
-    if ((settings.m_toneFrequency != m_settings.m_toneFrequency) || force)
-    {
+    // tone and CTCSS NCO frequencies are set by the DSP thread when it picks up the settings
+    if ((settings.m_toneFrequency != m_settings.m_toneFrequency) || force) {
         reverseAPIKeys.append("toneFrequency");
-        m_settingsMutex.lock();
-        m_toneNco.setFreq(settings.m_toneFrequency, m_audioSampleRate);
-        m_settingsMutex.unlock();
     }
 
-    if ((settings.m_ctcssIndex != m_settings.m_ctcssIndex) || force)
-    {
+    if ((settings.m_ctcssIndex != m_settings.m_ctcssIndex) || force) {
         reverseAPIKeys.append("ctcssIndex");
-        m_settingsMutex.lock();
-        m_ctcssNco.setFreq(NFMModSettings::getCTCSSFreq(settings.m_ctcssIndex), m_audioSampleRate);
-        m_settingsMutex.unlock();
-    }
-
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
-    {
-        reverseAPIKeys.append("audioDeviceName");
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
-        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            reverseAPIKeys.append("audioSampleRate");
-            applyAudioSampleRate(audioSampleRate);
-        }
     }
 
     if (settings.m_useReverseAPI)
@@ -594,6 +612,7 @@ void NFMMod::applySettings(const NFMModSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
 }
 
 QByteArray NFMMod::serialize() const
@@ -22,7 +22,7 @@
 #include <iostream>
 #include <fstream>
 
-#include <QMutex>
+#include <QAtomicInt>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
@@ -37,6 +37,7 @@
 #include "dsp/cwkeyer.h"
 #include "audio/audiofifo.h"
 #include "util/message.h"
+#include "util/settingssnapshot.h"
 
 #include "nfmmodsettings.h"
 
@@ -208,6 +209,7 @@ public:
     virtual void destroy() { delete this; }
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -267,6 +269,20 @@ private:
         RSRunning
     };
 
+    struct Interpolation //!< audio to channel sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct AFFilters
+    {
+        AFFilters() : m_sampleRate(48000) {}
+        Bandpass<Real> m_bandpass;
+        uint32_t m_sampleRate; //!< audio sample rate the filters and tone NCOs are built for
+    };
+
     DeviceAPI* m_deviceAPI;
     ThreadedBasebandSampleSource* m_threadedChannelizer;
     UpChannelizer* m_channelizer;
@@ -277,17 +293,18 @@ private:
     NFMModSettings m_settings;
     quint32 m_audioSampleRate;
 
+    // States published by the configuration and picked up by pull() at block boundaries
+    SettingsSnapshot<NFMModSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<AFFilters> m_afFilters;
+
     NCO m_carrierNco;
     NCOF m_toneNco;
     NCOF m_ctcssNco;
     float m_modPhasor; //!< baseband modulator phasor
     Complex m_modSample;
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
     bool m_interpolatorConsumed;
-    Lowpass<Real> m_lowpass;
-    Bandpass<Real> m_bandpass;
 
     double m_magsq;
     MovingAverageUtil<double, double, 16> m_movingAverage;
@@ -297,13 +314,13 @@ private:
 
     AudioFifo m_audioFifo;
     SampleVector m_sampleBuffer;
-    QMutex m_settingsMutex;
 
     std::ifstream m_ifstream;
     QString m_fileName;
     quint64 m_fileSize;     //!< raw file size (bytes)
     quint32 m_recordLength; //!< record length in seconds computed from file size
     int m_sampleRate;
+    QAtomicInt m_fileSeekPoint; //!< byte offset requested by the GUI, -1 if none
 
     NFMModSettings::NFMModInputAF m_afInput;
     quint32 m_levelCalcCount;
@@ -321,9 +338,13 @@ private:
     void applySettings(const NFMModSettings& settings, bool force = false);
     void pullAF(Real& sample);
     void calculateLevel(Real& sample);
+    void updateStates();
+    void pullOne(Sample& sample);
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
+    void publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, Real rfBandwidth);
+    void publishAFFilters(uint32_t audioSampleRate, Real afBandwidth);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const NFMModSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const NFMModSettings& settings, bool force);
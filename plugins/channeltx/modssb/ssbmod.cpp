@@ -19,7 +19,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QMutexLocker>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QBuffer>
@@ -58,18 +57,16 @@ SSBMod::SSBMod(DeviceAPI *deviceAPI) :
     m_basebandSampleRate(48000),
     m_outputSampleRate(48000),
     m_inputFrequencyOffset(0),
-    m_SSBFilter(0),
-    m_DSBFilter(0),
 	m_SSBFilterBuffer(0),
 	m_DSBFilterBuffer(0),
 	m_SSBFilterBufferIndex(0),
 	m_DSBFilterBufferIndex(0),
     m_sampleSink(0),
     m_audioFifo(4800),
-	m_settingsMutex(QMutex::Recursive),
 	m_fileSize(0),
 	m_recordLength(0),
 	m_sampleRate(48000),
+	m_fileSeekPoint(-1),
 	m_levelCalcCount(0),
 	m_peakLevel(0.0f),
 	m_levelSum(0.0f),
@@ -80,8 +77,6 @@ SSBMod::SSBMod(DeviceAPI *deviceAPI) :
 	DSPEngine::instance()->getAudioDeviceManager()->addAudioSource(&m_audioFifo, getInputMessageQueue());
     m_audioSampleRate = DSPEngine::instance()->getAudioDeviceManager()->getInputSampleRate();
 
-    m_SSBFilter = new fftfilt(m_settings.m_lowCutoff / m_audioSampleRate, m_settings.m_bandwidth / m_audioSampleRate, m_ssbFftLen);
-    m_DSBFilter = new fftfilt((2.0f * m_settings.m_bandwidth) / m_audioSampleRate, 2 * m_ssbFftLen);
     m_SSBFilterBuffer = new Complex[m_ssbFftLen>>1]; // filter returns data exactly half of its size
     m_DSBFilterBuffer = new Complex[m_ssbFftLen];
     std::fill(m_SSBFilterBuffer, m_SSBFilterBuffer+(m_ssbFftLen>>1), Complex{0,0});
@@ -99,8 +94,6 @@ SSBMod::SSBMod(DeviceAPI *deviceAPI) :
 
 	m_magsq = 0.0;
 
-	m_toneNco.setFreq(1000.0, m_audioSampleRate);
-
 	// CW keyer
 	m_cwKeyer.setSampleRate(48000);
 	m_cwKeyer.setWPM(13);
@@ -141,42 +134,90 @@ SSBMod::~SSBMod()
     delete m_threadedChannelizer;
     delete m_channelizer;
 
-    delete m_SSBFilter;
-    delete m_DSBFilter;
     delete[] m_SSBFilterBuffer;
     delete[] m_DSBFilterBuffer;
 }
 
+SSBMod::Filters::Filters(uint32_t audioSampleRate, float band, float lowCutoff) :
+    m_SSBFilter(lowCutoff / audioSampleRate, band / audioSampleRate, m_ssbFftLen),
+    m_DSBFilter((2.0f * band) / audioSampleRate, 2 * m_ssbFftLen)
+{
+}
+
 void SSBMod::pull(Sample& sample)
 {
-	Complex ci;
+    updateStates();
+    pullOne(sample);
+}
+
+void SSBMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    updateStates(); // once for the whole block
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+}
+
+void SSBMod::updateStates()
+{
+    bool settingsChanged = m_settingsSnapshot.update();
+    bool interpolationChanged = m_interpolation.update();
+
+    if (interpolationChanged)
+    {
+        m_interpolatorDistanceRemain = 0;
+        m_interpolatorConsumed = false;
+    }
+
+    if (settingsChanged || interpolationChanged) {
+        m_toneNco.setFreq(m_settingsSnapshot->m_toneFrequency, m_interpolation->m_audioSampleRate);
+    }
+
+    if (m_filters.update()) // flush what the previous filters left
+    {
+        std::fill(m_SSBFilterBuffer, m_SSBFilterBuffer+(m_ssbFftLen>>1), Complex{0,0});
+        std::fill(m_DSBFilterBuffer, m_DSBFilterBuffer+m_ssbFftLen, Complex{0,0});
+        m_SSBFilterBufferIndex = 0;
+        m_DSBFilterBufferIndex = 0;
+    }
+
+    int seekPoint = m_fileSeekPoint.fetchAndStoreOrdered(-1);
 
-	m_settingsMutex.lock();
+    if ((seekPoint >= 0) && m_ifstream.is_open())
+    {
+        m_ifstream.clear();
+        m_ifstream.seekg(seekPoint, std::ios::beg);
+    }
+}
+
+void SSBMod::pullOne(Sample& sample)
+{
+	Complex ci;
+    Interpolation& interpolation = m_interpolation.get();
 
-    if (m_interpolatorDistance > 1.0f) // decimate
+    if (interpolation.m_distance > 1.0f) // decimate
     {
     	modulateSample();
 
-        while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        while (!interpolation.m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
         	modulateSample();
         }
     }
     else
     {
-        if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        if (interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
         	modulateSample();
         }
     }
 
-    m_interpolatorDistanceRemain += m_interpolatorDistance;
+    m_interpolatorDistanceRemain += interpolation.m_distance;
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
     ci *= 0.891235351562f * SDR_TX_SCALEF; //scaling at -1 dB to account for possible filter overshoot
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
 	m_movingAverage(magsq);
@@ -208,7 +249,10 @@ void SSBMod::modulateSample()
 
 void SSBMod::pullAF(Complex& sample)
 {
-	if (m_settings.m_audioMute)
+    const SSBModSettings& settings = m_settingsSnapshot.get();
+    Filters& filters = m_filters.get();
+
+	if (settings.m_audioMute)
 	{
         sample.real(0.0f);
         sample.imag(0.0f);
@@ -219,13 +263,13 @@ void SSBMod::pullAF(Complex& sample)
     fftfilt::cmplx *filtered;
     int n_out = 0;
 
-    int decim = 1<<(m_settings.m_spanLog2 - 1);
+    int decim = 1<<(settings.m_spanLog2 - 1);
     unsigned char decim_mask = decim - 1; // counter LSB bit mask for decimation by 2^(m_scaleLog2 - 1)
 
-    switch (m_settings.m_modAFInput)
+    switch (settings.m_modAFInput)
     {
     case SSBModSettings::SSBModInputTone:
-    	if (m_settings.m_dsb)
+    	if (settings.m_dsb)
     	{
     		Real t = m_toneNco.next()/1.25;
     		sample.real(t);
@@ -233,7 +277,7 @@ void SSBMod::pullAF(Complex& sample)
     	}
     	else
     	{
-    		if (m_settings.m_usb) {
+    		if (settings.m_usb) {
     			sample = m_toneNco.nextIQ();
     		} else {
     			sample = m_toneNco.nextQI();
@@ -251,7 +295,7 @@ void SSBMod::pullAF(Complex& sample)
         {
             if (m_ifstream.eof())
             {
-            	if (m_settings.m_playLoop)
+            	if (settings.m_playLoop)
             	{
                     m_ifstream.clear();
                     m_ifstream.seekg(0, std::ios::beg);
@@ -265,19 +309,19 @@ void SSBMod::pullAF(Complex& sample)
             }
             else
             {
-            	if (m_settings.m_audioBinaural)
+            	if (settings.m_audioBinaural)
             	{
             		Complex c;
                 	m_ifstream.read(reinterpret_cast<char*>(&c), sizeof(Complex));
 
-                	if (m_settings.m_audioFlipChannels)
+                	if (settings.m_audioFlipChannels)
                 	{
-                        ci.real(c.imag() * m_settings.m_volumeFactor);
-                        ci.imag(c.real() * m_settings.m_volumeFactor);
+                        ci.real(c.imag() * settings.m_volumeFactor);
+                        ci.imag(c.real() * settings.m_volumeFactor);
                 	}
                 	else
                 	{
-                    	ci = c * m_settings.m_volumeFactor;
+                    	ci = c * settings.m_volumeFactor;
                 	}
             	}
             	else
@@ -285,16 +329,16 @@ void SSBMod::pullAF(Complex& sample)
                     Real real;
                 	m_ifstream.read(reinterpret_cast<char*>(&real), sizeof(Real));
 
-                	if (m_settings.m_agc)
+                	if (settings.m_agc)
                 	{
                         real = m_audioCompressor.compress(real);
                         ci.real(real);
                         ci.imag(0.0f);
-                        ci *= m_settings.m_volumeFactor;
+                        ci *= settings.m_volumeFactor;
                 	}
                 	else
                 	{
-                        ci.real(real * m_settings.m_volumeFactor);
+                        ci.real(real * settings.m_volumeFactor);
                         ci.imag(0.0f);
                 	}
             	}
@@ -307,31 +351,31 @@ void SSBMod::pullAF(Complex& sample)
         }
         break;
     case SSBModSettings::SSBModInputAudio:
-        if (m_settings.m_audioBinaural)
+        if (settings.m_audioBinaural)
     	{
-        	if (m_settings.m_audioFlipChannels)
+        	if (settings.m_audioFlipChannels)
         	{
-                ci.real((m_audioBuffer[m_audioBufferFill].r / SDR_TX_SCALEF) * m_settings.m_volumeFactor);
-                ci.imag((m_audioBuffer[m_audioBufferFill].l / SDR_TX_SCALEF) * m_settings.m_volumeFactor);
+                ci.real((m_audioBuffer[m_audioBufferFill].r / SDR_TX_SCALEF) * settings.m_volumeFactor);
+                ci.imag((m_audioBuffer[m_audioBufferFill].l / SDR_TX_SCALEF) * settings.m_volumeFactor);
         	}
         	else
         	{
-                ci.real((m_audioBuffer[m_audioBufferFill].l / SDR_TX_SCALEF) * m_settings.m_volumeFactor);
-                ci.imag((m_audioBuffer[m_audioBufferFill].r / SDR_TX_SCALEF) * m_settings.m_volumeFactor);
+                ci.real((m_audioBuffer[m_audioBufferFill].l / SDR_TX_SCALEF) * settings.m_volumeFactor);
+                ci.imag((m_audioBuffer[m_audioBufferFill].r / SDR_TX_SCALEF) * settings.m_volumeFactor);
         	}
     	}
         else
         {
-            if (m_settings.m_agc)
+            if (settings.m_agc)
             {
                 ci.real(((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r)  / 65536.0f));
                 ci.real(m_audioCompressor.compress(ci.real()));
                 ci.imag(0.0f);
-                ci *= m_settings.m_volumeFactor;
+                ci *= settings.m_volumeFactor;
             }
             else
             {
-                ci.real(((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r)  / 65536.0f) * m_settings.m_volumeFactor);
+                ci.real(((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r)  / 65536.0f) * settings.m_volumeFactor);
                 ci.imag(0.0f);
             }
         }
@@ -344,7 +388,7 @@ void SSBMod::pullAF(Complex& sample)
         {
             m_cwKeyer.getCWSmoother().getFadeSample(true, fadeFactor);
 
-        	if (m_settings.m_dsb)
+        	if (settings.m_dsb)
         	{
         		Real t = m_toneNco.next() * fadeFactor;
         		sample.real(t);
@@ -352,7 +396,7 @@ void SSBMod::pullAF(Complex& sample)
         	}
         	else
         	{
-        		if (m_settings.m_usb) {
+        		if (settings.m_usb) {
         			sample = m_toneNco.nextIQ() * fadeFactor;
         		} else {
         			sample = m_toneNco.nextQI() * fadeFactor;
@@ -363,7 +407,7 @@ void SSBMod::pullAF(Complex& sample)
         {
         	if (m_cwKeyer.getCWSmoother().getFadeSample(false, fadeFactor))
         	{
-            	if (m_settings.m_dsb)
+            	if (settings.m_dsb)
             	{
             		Real t = (m_toneNco.next() * fadeFactor)/1.25;
             		sample.real(t);
@@ -371,7 +415,7 @@ void SSBMod::pullAF(Complex& sample)
             	}
             	else
             	{
-            		if (m_settings.m_usb) {
+            		if (settings.m_usb) {
             			sample = m_toneNco.nextIQ() * fadeFactor;
             		} else {
             			sample = m_toneNco.nextQI() * fadeFactor;
@@ -394,12 +438,12 @@ void SSBMod::pullAF(Complex& sample)
         break;
     }
 
-    if ((m_settings.m_modAFInput == SSBModSettings::SSBModInputFile)
-       || (m_settings.m_modAFInput == SSBModSettings::SSBModInputAudio)) // real audio
+    if ((settings.m_modAFInput == SSBModSettings::SSBModInputFile)
+       || (settings.m_modAFInput == SSBModSettings::SSBModInputAudio)) // real audio
     {
-    	if (m_settings.m_dsb)
+    	if (settings.m_dsb)
     	{
-    		n_out = m_DSBFilter->runDSB(ci, &filtered);
+    		n_out = filters.m_DSBFilter.runDSB(ci, &filtered);
 
     		if (n_out > 0)
     		{
@@ -412,7 +456,7 @@ void SSBMod::pullAF(Complex& sample)
     	}
     	else
     	{
-    		n_out = m_SSBFilter->runSSB(ci, &filtered, m_settings.m_usb);
+    		n_out = filters.m_SSBFilter.runSSB(ci, &filtered, settings.m_usb);
 
     		if (n_out > 0)
     		{
@@ -438,7 +482,7 @@ void SSBMod::pullAF(Complex& sample)
                     Real avgr = (m_sum.real() / decim) * 0.891235351562f * SDR_TX_SCALEF; //scaling at -1 dB to account for possible filter overshoot
                     Real avgi = (m_sum.imag() / decim) * 0.891235351562f * SDR_TX_SCALEF;
 
-                    if (!m_settings.m_dsb & !m_settings.m_usb)
+                    if (!settings.m_dsb & !settings.m_usb)
                     { // invert spectrum for LSB
                         m_sampleBuffer.push_back(Sample(avgi, avgr));
                     }
@@ -453,8 +497,8 @@ void SSBMod::pullAF(Complex& sample)
             }
     	}
     } // Real audio
-    else if ((m_settings.m_modAFInput == SSBModSettings::SSBModInputTone)
-          || (m_settings.m_modAFInput == SSBModSettings::SSBModInputCWTone)) // tone
+    else if ((settings.m_modAFInput == SSBModSettings::SSBModInputTone)
+          || (settings.m_modAFInput == SSBModSettings::SSBModInputCWTone)) // tone
     {
         m_sum += sample;
 
@@ -463,7 +507,7 @@ void SSBMod::pullAF(Complex& sample)
             Real avgr = (m_sum.real() / decim) * 0.891235351562f * SDR_TX_SCALEF; //scaling at -1 dB to account for possible filter overshoot
             Real avgi = (m_sum.imag() / decim) * 0.891235351562f * SDR_TX_SCALEF;
 
-            if (!m_settings.m_dsb & !m_settings.m_usb)
+            if (!settings.m_dsb & !settings.m_usb)
             { // invert spectrum for LSB
                 m_sampleBuffer.push_back(Sample(avgi, avgr));
             }
@@ -476,7 +520,7 @@ void SSBMod::pullAF(Complex& sample)
             m_sum.imag(0.0);
         }
 
-        if (m_sumCount < (m_settings.m_dsb ? m_ssbFftLen : m_ssbFftLen>>1))
+        if (m_sumCount < (settings.m_dsb ? m_ssbFftLen : m_ssbFftLen>>1))
         {
             n_out = 0;
             m_sumCount++;
@@ -492,7 +536,7 @@ void SSBMod::pullAF(Complex& sample)
     {
         if (m_sampleSink != 0)
         {
-            m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), !m_settings.m_dsb);
+            m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), !settings.m_dsb);
         }
 
         m_sampleBuffer.clear();
@@ -660,15 +704,10 @@ void SSBMod::openFileStream()
 
 void SSBMod::seekFileStream(int seekPercentage)
 {
-    QMutexLocker mutexLocker(&m_settingsMutex);
-
-    if (m_ifstream.is_open())
-    {
-        int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
-        seekPoint *= sizeof(Real);
-        m_ifstream.clear();
-        m_ifstream.seekg(seekPoint, std::ios::beg);
-    }
+    // the stream is read by the DSP thread which does the seek at the next block
+    int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
+    seekPoint *= sizeof(Real);
+    m_fileSeekPoint.fetchAndStoreOrdered(seekPoint);
 }
 
 void SSBMod::applyAudioSampleRate(int sampleRate)
@@ -680,39 +719,11 @@ void SSBMod::applyAudioSampleRate(int sampleRate)
             sampleRate, m_settings.m_inputFrequencyOffset);
     m_inputMessageQueue.push(channelConfigMsg);
 
-    m_settingsMutex.lock();
-
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorConsumed = false;
-    m_interpolatorDistance = (Real) sampleRate / (Real) m_outputSampleRate;
-    m_interpolator.create(48, sampleRate, m_settings.m_bandwidth, 3.0);
-
-    float band = m_settings.m_bandwidth;
-    float lowCutoff = m_settings.m_lowCutoff;
-    bool usb = m_settings.m_usb;
-
-    if (band < 100.0f) // at least 100 Hz
-    {
-        band = 100.0f;
-        lowCutoff = 0;
-    }
-
-    if (band - lowCutoff < 100.0f) {
-        lowCutoff = band - 100.0f;
-    }
-
-    m_SSBFilter->create_filter(lowCutoff / sampleRate, band / sampleRate);
-    m_DSBFilter->create_dsb_filter((2.0f * band) / sampleRate);
-
-    m_settings.m_bandwidth = band;
-    m_settings.m_lowCutoff = lowCutoff;
-    m_settings.m_usb = usb;
-
-    m_toneNco.setFreq(m_settings.m_toneFrequency, sampleRate);
+    // bandwidth and low cutoff in m_settings are already limited by applySettings
+    publishInterpolation(sampleRate, m_outputSampleRate, m_settings.m_bandwidth); // tone NCO follows when it is picked up
+    publishFilters(sampleRate, m_settings.m_bandwidth, m_settings.m_lowCutoff);
     m_cwKeyer.setSampleRate(sampleRate);
 
-    m_settingsMutex.unlock();
-
     m_audioSampleRate = sampleRate;
 
     if (getMessageQueueToGUI())
@@ -722,6 +733,20 @@ void SSBMod::applyAudioSampleRate(int sampleRate)
     }
 }
 
+void SSBMod::publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, float band)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(48, audioSampleRate, band, 3.0);
+    interpolation->m_distance = (Real) audioSampleRate / (Real) outputSampleRate;
+    interpolation->m_audioSampleRate = audioSampleRate;
+    m_interpolation.publish(interpolation);
+}
+
+void SSBMod::publishFilters(uint32_t audioSampleRate, float band, float lowCutoff)
+{
+    m_filters.publish(new Filters(audioSampleRate, band, lowCutoff)); // filter buffers are flushed when it is picked up
+}
+
 void SSBMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force)
 {
     qDebug() << "SSBMod::applyChannelSettings:"
@@ -732,19 +757,11 @@ void SSBMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate,
     if ((inputFrequencyOffset != m_inputFrequencyOffset) ||
         (outputSampleRate != m_outputSampleRate) || force)
     {
-        m_settingsMutex.lock();
         m_carrierNco.setFreq(inputFrequencyOffset, outputSampleRate);
-        m_settingsMutex.unlock();
     }
 
-    if ((outputSampleRate != m_outputSampleRate) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, m_settings.m_bandwidth, 3.0);
-        m_settingsMutex.unlock();
+    if ((outputSampleRate != m_outputSampleRate) || force) {
+        publishInterpolation(m_audioSampleRate, outputSampleRate, m_settings.m_bandwidth);
     }
 
     m_basebandSampleRate = basebandSampleRate;
@@ -811,6 +828,19 @@ void SSBMod::applySettings(const SSBModSettings& settings, bool force)
         reverseAPIKeys.append("audioDeviceName");
     }
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
+        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            applyAudioSampleRate(audioSampleRate);
+        }
+    }
+
     if ((settings.m_bandwidth != m_settings.m_bandwidth) ||
         (settings.m_lowCutoff != m_settings.m_lowCutoff) || force)
     {
@@ -824,50 +854,15 @@ void SSBMod::applySettings(const SSBModSettings& settings, bool force)
             lowCutoff = band - 100.0f;
         }
 
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) m_outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, band, 3.0);
-        m_SSBFilter->create_filter(lowCutoff / m_audioSampleRate, band / m_audioSampleRate);
-        m_DSBFilter->create_dsb_filter((2.0f * band) / m_audioSampleRate);
-        m_settingsMutex.unlock();
-    }
-
-    if ((settings.m_toneFrequency != m_settings.m_toneFrequency) || force)
-    {
-        m_settingsMutex.lock();
-        m_toneNco.setFreq(settings.m_toneFrequency, m_audioSampleRate);
-        m_settingsMutex.unlock();
+        publishInterpolation(m_audioSampleRate, m_outputSampleRate, band);
+        publishFilters(m_audioSampleRate, band, lowCutoff);
     }
-
-    if ((settings.m_dsb != m_settings.m_dsb) || force)
+    else if (settings.m_dsb != m_settings.m_dsb) // start the other mode with flushed filter buffers
     {
-        if (settings.m_dsb)
-        {
-            std::fill(m_DSBFilterBuffer, m_DSBFilterBuffer+m_ssbFftLen, Complex{0,0});
-            //memset(m_DSBFilterBuffer, 0, sizeof(Complex)*(m_ssbFftLen));
-            m_DSBFilterBufferIndex = 0;
-        }
-        else
-        {
-            std::fill(m_SSBFilterBuffer, m_SSBFilterBuffer+(m_ssbFftLen>>1), Complex{0,0});
-            //memset(m_SSBFilterBuffer, 0, sizeof(Complex)*(m_ssbFftLen>>1));
-            m_SSBFilterBufferIndex = 0;
-        }
+        publishFilters(m_audioSampleRate, m_settings.m_bandwidth, m_settings.m_lowCutoff);
     }
 
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
-    {
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
-        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            applyAudioSampleRate(audioSampleRate);
-        }
-    }
+    // tone NCO frequency is set by the DSP thread when it picks up the settings
 
     if (settings.m_useReverseAPI)
     {
@@ -883,6 +878,7 @@ void SSBMod::applySettings(const SSBModSettings& settings, bool force)
     m_settings.m_bandwidth = band;
     m_settings.m_lowCutoff = lowCutoff;
     m_settings.m_usb = usb;
+    m_settingsSnapshot.publish(m_settings);
 }
 
 QByteArray SSBMod::serialize() const
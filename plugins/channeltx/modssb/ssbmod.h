@@ -22,7 +22,7 @@
 #include <iostream>
 #include <fstream>
 
-#include <QMutex>
+#include <QAtomicInt>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
@@ -37,6 +37,7 @@
 #include "audio/audiofifo.h"
 #include "audio/audiocompressorsnd.h"
 #include "util/message.h"
+#include "util/settingssnapshot.h"
 
 #include "ssbmodsettings.h"
 
@@ -210,6 +211,7 @@ public:
     void setSpectrumSampleSink(BasebandSampleSink* sampleSink) { m_sampleSink = sampleSink; }
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -270,6 +272,21 @@ private:
         RSRunning
     };
 
+    struct Interpolation //!< audio to channel sample rate
+    {
+        Interpolation() : m_distance(1.0f), m_audioSampleRate(48000) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+        uint32_t m_audioSampleRate; //!< audio sample rate the interpolator and tone NCO are built for
+    };
+
+    struct Filters //!< at audio sample rate
+    {
+        Filters(uint32_t audioSampleRate = 48000, float band = 3000.0f, float lowCutoff = 300.0f);
+        fftfilt m_SSBFilter;
+        fftfilt m_DSBFilter;
+    };
+
     DeviceAPI* m_deviceAPI;
     ThreadedBasebandSampleSource* m_threadedChannelizer;
     UpChannelizer* m_channelizer;
@@ -280,15 +297,16 @@ private:
     SSBModSettings m_settings;
     quint32 m_audioSampleRate;
 
+    // States published by the configuration and picked up by pull() at block boundaries
+    SettingsSnapshot<SSBModSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<Filters> m_filters;
+
     NCOF m_carrierNco;
     NCOF m_toneNco;
     Complex m_modSample;
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
     bool m_interpolatorConsumed;
-	fftfilt* m_SSBFilter;
-	fftfilt* m_DSBFilter;
 	Complex* m_SSBFilterBuffer;
 	Complex* m_DSBFilterBuffer;
 	int m_SSBFilterBufferIndex;
@@ -309,13 +327,13 @@ private:
     uint m_audioBufferFill;
 
     AudioFifo m_audioFifo;
-    QMutex m_settingsMutex;
 
     std::ifstream m_ifstream;
     QString m_fileName;
     quint64 m_fileSize;     //!< raw file size (bytes)
     quint32 m_recordLength; //!< record length in seconds computed from file size
     int m_sampleRate;
+    QAtomicInt m_fileSeekPoint; //!< byte offset requested by the GUI, -1 if none
 
     quint32 m_levelCalcCount;
     Real m_peakLevel;
@@ -335,9 +353,13 @@ private:
     void applySettings(const SSBModSettings& settings, bool force = false);
     void pullAF(Complex& sample);
     void calculateLevel(Complex& sample);
+    void updateStates();
+    void pullOne(Sample& sample);
     void modulateSample();
     void openFileStream();
     void seekFileStream(int seekPercentage);
+    void publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, float band);
+    void publishFilters(uint32_t audioSampleRate, float band, float lowCutoff);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const SSBModSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const SSBModSettings& settings, bool force);
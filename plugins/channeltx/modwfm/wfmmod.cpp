@@ -17,7 +17,6 @@
 
 #include <QTime>
 #include <QDebug>
-#include <QMutexLocker>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QBuffer>
@@ -60,17 +59,16 @@ WFMMod::WFMMod(DeviceAPI *deviceAPI) :
     m_inputFrequencyOffset(0),
 	m_modPhasor(0.0f),
     m_audioFifo(4800),
-	m_settingsMutex(QMutex::Recursive),
     m_fileSize(0),
 	m_recordLength(0),
 	m_sampleRate(48000),
+	m_fileSeekPoint(-1),
 	m_levelCalcCount(0),
 	m_peakLevel(0.0f),
 	m_levelSum(0.0f)
 {
 	setObjectName(m_channelId);
 
-    m_rfFilter = new fftfilt(-62500.0 / 384000.0, 62500.0 / 384000.0, m_rfFilterFFTLength);
     m_rfFilterBuffer = new Complex[m_rfFilterFFTLength];
     std::fill(m_rfFilterBuffer, m_rfFilterBuffer+m_rfFilterFFTLength, Complex{0,0});
     //memset(m_rfFilterBuffer, 0, sizeof(Complex)*(m_rfFilterFFTLength));
@@ -84,8 +82,6 @@ WFMMod::WFMMod(DeviceAPI *deviceAPI) :
 	DSPEngine::instance()->getAudioDeviceManager()->addAudioSource(&m_audioFifo, getInputMessageQueue());
     m_audioSampleRate = DSPEngine::instance()->getAudioDeviceManager()->getInputSampleRate();
 
-	m_toneNcoRF.setFreq(1000.0, m_outputSampleRate);
-
     // CW keyer
     m_cwKeyer.setSampleRate(m_outputSampleRate);
     m_cwKeyer.setWPM(13);
@@ -113,13 +109,65 @@ WFMMod::~WFMMod()
     m_deviceAPI->removeChannelSource(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete m_rfFilter;
     delete[] m_rfFilterBuffer;
 }
 
+WFMMod::RFFilter::RFFilter(int sampleRate, Real rfBandwidth) :
+    m_filter(-(rfBandwidth / 2.0) / sampleRate, (rfBandwidth / 2.0) / sampleRate, m_rfFilterFFTLength),
+    m_sampleRate(sampleRate)
+{
+}
+
 void WFMMod::pull(Sample& sample)
 {
-	if (m_settings.m_channelMute)
+    updateStates();
+    pullOne(sample);
+}
+
+void WFMMod::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    updateStates(); // once for the whole block
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+}
+
+void WFMMod::updateStates()
+{
+    bool settingsChanged = m_settingsSnapshot.update();
+    bool rfFilterChanged = m_rfFilter.update();
+
+    if (rfFilterChanged) // flush what the previous filter left
+    {
+        std::fill(m_rfFilterBuffer, m_rfFilterBuffer+m_rfFilterFFTLength, Complex{0,0});
+        m_rfFilterBufferIndex = 0;
+    }
+
+    if (settingsChanged || rfFilterChanged) {
+        m_toneNcoRF.setFreq(m_settingsSnapshot->m_toneFrequency, m_rfFilter->m_sampleRate);
+    }
+
+    if (m_interpolation.update())
+    {
+        m_interpolatorDistanceRemain = 0;
+        m_interpolatorConsumed = false;
+    }
+
+    int seekPoint = m_fileSeekPoint.fetchAndStoreOrdered(-1);
+
+    if ((seekPoint >= 0) && m_ifstream.is_open())
+    {
+        m_ifstream.clear();
+        m_ifstream.seekg(seekPoint, std::ios::beg);
+    }
+}
+
+void WFMMod::pullOne(Sample& sample)
+{
+    const WFMModSettings& settings = m_settingsSnapshot.get();
+
+	if (settings.m_channelMute)
 	{
 		sample.m_real = 0.0f;
 		sample.m_imag = 0.0f;
@@ -129,32 +177,32 @@ void WFMMod::pull(Sample& sample)
 	Complex ci, ri;
     fftfilt::cmplx *rf;
     int rf_out;
+    Interpolation& interpolation = m_interpolation.get();
+    RFFilter& rfFilter = m_rfFilter.get();
 
-	m_settingsMutex.lock();
-
-	if ((m_settings.m_modAFInput == WFMModSettings::WFMModInputFile)
-	   || (m_settings.m_modAFInput == WFMModSettings::WFMModInputAudio))
+	if ((settings.m_modAFInput == WFMModSettings::WFMModInputFile)
+	   || (settings.m_modAFInput == WFMModSettings::WFMModInputAudio))
 	{
-	    if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ri))
+	    if (interpolation.m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ri))
 	    {
 	        pullAF(m_modSample);
 	        calculateLevel(m_modSample.real());
 	        m_audioBufferFill++;
 	    }
 
-	    m_interpolatorDistanceRemain += m_interpolatorDistance;
+	    m_interpolatorDistanceRemain += interpolation.m_distance;
 	}
 	else
 	{
 	    pullAF(ri);
 	}
 
-    m_modPhasor += (m_settings.m_fmDeviation / (float) m_outputSampleRate) * ri.real() * M_PI * 2.0f;
+    m_modPhasor += (settings.m_fmDeviation / (float) rfFilter.m_sampleRate) * ri.real() * M_PI * 2.0f;
     ci.real(cos(m_modPhasor) * 0.891235351562f * SDR_TX_SCALEF); // -1 dB
     ci.imag(sin(m_modPhasor) * 0.891235351562f * SDR_TX_SCALEF);
 
     // RF filtering
-    rf_out = m_rfFilter->runFilt(ci, &rf);
+    rf_out = rfFilter.m_filter.runFilt(ci, &rf);
 
     if (rf_out > 0)
     {
@@ -166,8 +214,6 @@ void WFMMod::pull(Sample& sample)
     ci = m_rfFilterBuffer[m_rfFilterBufferIndex] * m_carrierNco.nextIQ(); // shift to carrier frequency
     m_rfFilterBufferIndex++;
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
 	m_movingAverage(magsq);
@@ -192,10 +238,12 @@ void WFMMod::pullAudio(int nbSamples)
 
 void WFMMod::pullAF(Complex& sample)
 {
-    switch (m_settings.m_modAFInput)
+    const WFMModSettings& settings = m_settingsSnapshot.get();
+
+    switch (settings.m_modAFInput)
     {
     case WFMModSettings::WFMModInputTone:
-        sample.real(m_toneNcoRF.next() * m_settings.m_volumeFactor);
+        sample.real(m_toneNcoRF.next() * settings.m_volumeFactor);
         sample.imag(0.0f);
         break;
     case WFMModSettings::WFMModInputFile:
@@ -205,7 +253,7 @@ void WFMMod::pullAF(Complex& sample)
         {
             if (m_ifstream.eof())
             {
-            	if (m_settings.m_playLoop)
+            	if (settings.m_playLoop)
             	{
                     m_ifstream.clear();
                     m_ifstream.seekg(0, std::ios::beg);
@@ -221,7 +269,7 @@ void WFMMod::pullAF(Complex& sample)
             {
                 Real s;
             	m_ifstream.read(reinterpret_cast<char*>(&s), sizeof(Real));
-            	sample.real(s * m_settings.m_volumeFactor);
+            	sample.real(s * settings.m_volumeFactor);
                 sample.imag(0.0f);
             }
         }
@@ -233,7 +281,7 @@ void WFMMod::pullAF(Complex& sample)
         break;
     case WFMModSettings::WFMModInputAudio:
         {
-            sample.real(((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r) / 65536.0f) * m_settings.m_volumeFactor);
+            sample.real(((m_audioBuffer[m_audioBufferFill].l + m_audioBuffer[m_audioBufferFill].r) / 65536.0f) * settings.m_volumeFactor);
             sample.imag(0.0f);
         }
         break;
@@ -243,14 +291,14 @@ void WFMMod::pullAF(Complex& sample)
         if (m_cwKeyer.getSample())
         {
             m_cwKeyer.getCWSmoother().getFadeSample(true, fadeFactor);
-            sample.real(m_toneNcoRF.next() * m_settings.m_volumeFactor * fadeFactor);
+            sample.real(m_toneNcoRF.next() * settings.m_volumeFactor * fadeFactor);
             sample.imag(0.0f);
         }
         else
         {
             if (m_cwKeyer.getCWSmoother().getFadeSample(false, fadeFactor))
             {
-                sample.real(m_toneNcoRF.next() * m_settings.m_volumeFactor * fadeFactor);
+                sample.real(m_toneNcoRF.next() * settings.m_volumeFactor * fadeFactor);
                 sample.imag(0.0f);
             }
             else
@@ -425,31 +473,29 @@ void WFMMod::openFileStream()
 
 void WFMMod::seekFileStream(int seekPercentage)
 {
-    QMutexLocker mutexLocker(&m_settingsMutex);
-
-    if (m_ifstream.is_open())
-    {
-        int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
-        seekPoint *= sizeof(Real);
-        m_ifstream.clear();
-        m_ifstream.seekg(seekPoint, std::ios::beg);
-    }
+    // the stream is read by the DSP thread which does the seek at the next block
+    int seekPoint = ((m_recordLength * seekPercentage) / 100) * m_sampleRate;
+    seekPoint *= sizeof(Real);
+    m_fileSeekPoint.fetchAndStoreOrdered(seekPoint);
 }
 
 void WFMMod::applyAudioSampleRate(int sampleRate)
 {
     qDebug("WFMMod::applyAudioSampleRate: %d", sampleRate);
 
-    m_settingsMutex.lock();
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorConsumed = false;
-    m_interpolatorDistance = (Real) sampleRate / (Real) m_outputSampleRate;
-    m_interpolator.create(48, sampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
-    m_settingsMutex.unlock();
+    publishInterpolation(sampleRate, m_outputSampleRate, m_settings.m_rfBandwidth);
 
     m_audioSampleRate = sampleRate;
 }
 
+void WFMMod::publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, Real rfBandwidth)
+{
+    Interpolation *interpolation = new Interpolation();
+    interpolation->m_interpolator.create(48, audioSampleRate, rfBandwidth / 2.2, 3.0);
+    interpolation->m_distance = (Real) audioSampleRate / (Real) outputSampleRate;
+    m_interpolation.publish(interpolation);
+}
+
 void WFMMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force)
 {
     qDebug() << "WFMMod::applyChannelSettings:"
@@ -460,25 +506,15 @@ void WFMMod::applyChannelSettings(int basebandSampleRate, int outputSampleRate,
     if ((inputFrequencyOffset != m_inputFrequencyOffset) ||
         (outputSampleRate != m_outputSampleRate) || force)
     {
-        m_settingsMutex.lock();
         m_carrierNco.setFreq(inputFrequencyOffset, outputSampleRate);
-        m_settingsMutex.unlock();
     }
 
     if ((outputSampleRate != m_outputSampleRate) || force)
     {
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
-        Real lowCut = -(m_settings.m_rfBandwidth / 2.0) / outputSampleRate;
-        Real hiCut  = (m_settings.m_rfBandwidth / 2.0) / outputSampleRate;
-        m_rfFilter->create_filter(lowCut, hiCut);
-        m_toneNcoRF.setFreq(m_settings.m_toneFrequency, outputSampleRate);
+        publishInterpolation(m_audioSampleRate, outputSampleRate, m_settings.m_rfBandwidth);
+        m_rfFilter.publish(new RFFilter(outputSampleRate, m_settings.m_rfBandwidth)); // tone NCO follows when it is picked up
         m_cwKeyer.setSampleRate(outputSampleRate);
         m_cwKeyer.reset();
-        m_settingsMutex.unlock();
     }
 
     m_basebandSampleRate = basebandSampleRate;
@@ -508,6 +544,20 @@ void WFMMod::applySettings(const WFMModSettings& settings, bool force)
 
     QList<QString> reverseAPIKeys;
 
+    // first so that the states published below use the new audio sample rate
+    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
+    {
+        reverseAPIKeys.append("audioDeviceName");
+        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
+        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
+        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
+        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
+
+        if (m_audioSampleRate != audioSampleRate) {
+            applyAudioSampleRate(audioSampleRate);
+        }
+    }
+
     if ((settings.m_inputFrequencyOffset != m_settings.m_inputFrequencyOffset) || force) {
         reverseAPIKeys.append("inputFrequencyOffset");
     }
@@ -530,43 +580,18 @@ void WFMMod::applySettings(const WFMModSettings& settings, bool force)
     if ((settings.m_afBandwidth != m_settings.m_afBandwidth) || force)
     {
         reverseAPIKeys.append("afBandwidth");
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_audioSampleRate / (Real) m_outputSampleRate;
-        m_interpolator.create(48, m_audioSampleRate, settings.m_rfBandwidth / 2.2, 3.0);
-        m_settingsMutex.unlock();
+        publishInterpolation(m_audioSampleRate, m_outputSampleRate, settings.m_rfBandwidth);
     }
 
     if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         reverseAPIKeys.append("rfBandwidth");
-        m_settingsMutex.lock();
-        Real lowCut = -(settings.m_rfBandwidth / 2.0) / m_outputSampleRate;
-        Real hiCut  = (settings.m_rfBandwidth / 2.0) / m_outputSampleRate;
-        m_rfFilter->create_filter(lowCut, hiCut);
-        m_settingsMutex.unlock();
+        m_rfFilter.publish(new RFFilter(m_outputSampleRate, settings.m_rfBandwidth));
     }
 
-    if ((settings.m_toneFrequency != m_settings.m_toneFrequency) || force)
-    {
+    // tone NCO frequency is set by the DSP thread when it picks up the settings
+    if ((settings.m_toneFrequency != m_settings.m_toneFrequency) || force) {
         reverseAPIKeys.append("toneFrequency");
-        m_settingsMutex.lock();
-        m_toneNcoRF.setFreq(settings.m_toneFrequency, m_outputSampleRate);
-        m_settingsMutex.unlock();
-    }
-
-    if ((settings.m_audioDeviceName != m_settings.m_audioDeviceName) || force)
-    {
-        reverseAPIKeys.append("audioDeviceName");
-        AudioDeviceManager *audioDeviceManager = DSPEngine::instance()->getAudioDeviceManager();
-        int audioDeviceIndex = audioDeviceManager->getInputDeviceIndex(settings.m_audioDeviceName);
-        audioDeviceManager->addAudioSource(&m_audioFifo, getInputMessageQueue(), audioDeviceIndex);
-        uint32_t audioSampleRate = audioDeviceManager->getInputSampleRate(audioDeviceIndex);
-
-        if (m_audioSampleRate != audioSampleRate) {
-            applyAudioSampleRate(audioSampleRate);
-        }
     }
 
     if (settings.m_useReverseAPI)
@@ -580,6 +605,7 @@ void WFMMod::applySettings(const WFMModSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
 }
 
 QByteArray WFMMod::serialize() const
@@ -22,7 +22,7 @@
 #include <iostream>
 #include <fstream>
 
-#include <QMutex>
+#include <QAtomicInt>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
@@ -36,6 +36,7 @@
 #include "dsp/cwkeyer.h"
 #include "audio/audiofifo.h"
 #include "util/message.h"
+#include "util/settingssnapshot.h"
 
 #include "wfmmodsettings.h"
 
@@ -207,6 +208,7 @@ public:
     virtual void destroy() { delete this; }
 
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -266,6 +268,20 @@ private:
         RSRunning
     };
 
+    struct Interpolation //!< audio to channel sample rate
+    {
+        Interpolation() : m_distance(1.0f) {}
+        Interpolator m_interpolator;
+        Real m_distance;
+    };
+
+    struct RFFilter //!< at channel sample rate
+    {
+        RFFilter(int sampleRate = 384000, Real rfBandwidth = 125000.0f);
+        fftfilt m_filter;
+        int m_sampleRate; //!< channel sample rate the filter and tone NCO are built for
+    };
+
     DeviceAPI* m_deviceAPI;
     ThreadedBasebandSampleSource* m_threadedChannelizer;
     UpChannelizer* m_channelizer;
@@ -276,16 +292,18 @@ private:
     WFMModSettings m_settings;
     quint32 m_audioSampleRate;
 
+    // States published by the configuration and picked up by pull() at block boundaries
+    SettingsSnapshot<WFMModSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolation> m_interpolation;
+    SettingsSnapshot<RFFilter> m_rfFilter;
+
     NCO m_carrierNco;
     NCOF m_toneNcoRF;
     float m_modPhasor; //!< baseband modulator phasor
     Complex m_modSample;
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
     bool m_interpolatorConsumed;
 
-    fftfilt* m_rfFilter;
     static const int m_rfFilterFFTLength;
     fftfilt::cmplx *m_rfFilterBuffer;
     int m_rfFilterBufferIndex;
@@ -298,13 +316,13 @@ private:
 
     AudioFifo m_audioFifo;
     SampleVector m_sampleBuffer;
-    QMutex m_settingsMutex;
 
     std::ifstream m_ifstream;
     QString m_fileName;
     quint64 m_fileSize;     //!< raw file size (bytes)
     quint32 m_recordLength; //!< record length in seconds computed from file size
     int m_sampleRate;
+    QAtomicInt m_fileSeekPoint; //!< byte offset requested by the GUI, -1 if none
 
     quint32 m_levelCalcCount;
     Real m_peakLevel;
@@ -319,10 +337,13 @@ private:
     void applyAudioSampleRate(int sampleRate);
     void applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const WFMModSettings& settings, bool force = false);
+    void updateStates();
+    void pullOne(Sample& sample);
     void pullAF(Complex& sample);
     void calculateLevel(const Real& sample);
     void openFileStream();
     void seekFileStream(int seekPercentage);
+    void publishInterpolation(uint32_t audioSampleRate, int outputSampleRate, Real rfBandwidth);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const WFMModSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
     void webapiReverseSendSettings(QList<QString>& channelSettingsKeys, const WFMModSettings& settings, bool force);
@@ -326,7 +326,7 @@ void RemoteSource::handleDataBlock(RemoteDataBlock* dataBlock)
         {
             RemoteMetaDataFEC *metaData = (RemoteMetaDataFEC *) &(dataBlock->m_superBlocks[0].m_protectedBlock);
             boost::crc_32_type crc32;
-            crc32.process_bytes(metaData, sizeof(RemoteMetaDataFEC)-4);
+            crc32.process_bytes(metaData, RemoteMetaDataFEC::crcSize());
 
             if (crc32.checksum() == metaData->m_crc32)
             {
@@ -373,6 +373,9 @@ void RemoteSource::printMeta(const QString& header, RemoteMetaDataFEC *metaData)
             << ":" << (int) metaData->m_nbFECBlocks
             << "|" << metaData->m_tv_sec
             << ":" << metaData->m_tv_usec
+            << "|" << (int) metaData->m_version
+            << ":" << (int) metaData->m_encoding
+            << ":" << metaData->m_blockSize
             << "|";
 }
 
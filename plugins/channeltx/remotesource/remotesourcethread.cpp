@@ -129,7 +129,6 @@ void RemoteSourceThread::handleInputMessages()
 
 void RemoteSourceThread::readPendingDatagrams()
 {
-    RemoteSuperBlock superBlock;
     qint64 size;
 
     while (m_socket->hasPendingDatagrams())
@@ -137,54 +136,77 @@ void RemoteSourceThread::readPendingDatagrams()
         QHostAddress sender;
         quint16 senderPort = 0;
         //qint64 pendingDataSize = m_socket->pendingDatagramSize();
-        size = m_socket->readDatagram((char *) &superBlock, (long long int) sizeof(RemoteSuperBlock), &sender, &senderPort);
+        size = m_socket->readDatagram(m_datagram, (long long int) sizeof(m_datagram), &sender, &senderPort);
 
-        if (size == sizeof(RemoteSuperBlock))
+        if (RemoteFrameDecoder::isVersion2(m_datagram, size))
         {
-            unsigned int dataBlockIndex = superBlock.m_header.m_frameIndex % m_nbDataBlocks;
-
-            // create the first block for this index
-            if (m_dataBlocks[dataBlockIndex] == 0) {
-                m_dataBlocks[dataBlockIndex] = new RemoteDataBlock();
-            }
-
-            if (m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex < 0)
-            {
-                // initialize virgin block with the frame index
-                m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex = superBlock.m_header.m_frameIndex;
-            }
-            else
-            {
-                // if the frame index is not the same for the same slot it means we are starting a new frame
-                uint32_t frameIndex = m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex;
-
-                if (superBlock.m_header.m_frameIndex != frameIndex)
-                {
-                    //qDebug("RemoteSourceThread::readPendingDatagrams: push frame %u", frameIndex);
-                    m_dataQueue->push(m_dataBlocks[dataBlockIndex]);
-                    m_dataBlocks[dataBlockIndex] = new RemoteDataBlock();
-                    m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex = superBlock.m_header.m_frameIndex;
-                }
+            if (m_frameDecoder.feed(m_datagram, size)) {
+                processFrameV2();
             }
+        }
+        else if (size == sizeof(RemoteSuperBlock))
+        {
+            processSuperBlock(*((RemoteSuperBlock *) m_datagram));
+        }
+        else
+        {
+            qWarning("RemoteSourceThread::readPendingDatagrams: wrong super block size not processing");
+        }
+    }
+}
 
-            m_dataBlocks[dataBlockIndex]->m_superBlocks[superBlock.m_header.m_blockIndex] = superBlock;
+void RemoteSourceThread::processSuperBlock(const RemoteSuperBlock& superBlock)
+{
+    unsigned int dataBlockIndex = superBlock.m_header.m_frameIndex % m_nbDataBlocks;
 
-            if (superBlock.m_header.m_blockIndex == 0) {
-                m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_metaRetrieved = true;
-            }
+    // create the first block for this index
+    if (m_dataBlocks[dataBlockIndex] == 0) {
+        m_dataBlocks[dataBlockIndex] = new RemoteDataBlock();
+    }
 
-            if (superBlock.m_header.m_blockIndex < RemoteNbOrginalBlocks) {
-                m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_originalCount++;
-            } else {
-                m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_recoveryCount++;
-            }
+    if (m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex < 0)
+    {
+        // initialize virgin block with the frame index
+        m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex = superBlock.m_header.m_frameIndex;
+    }
+    else
+    {
+        // if the frame index is not the same for the same slot it means we are starting a new frame
+        uint32_t frameIndex = m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex;
 
-            m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_blockCount++;
-        }
-        else
+        if (superBlock.m_header.m_frameIndex != frameIndex)
         {
-            qWarning("RemoteSourceThread::readPendingDatagrams: wrong super block size not processing");
+            //qDebug("RemoteSourceThread::readPendingDatagrams: push frame %u", frameIndex);
+            m_dataQueue->push(m_dataBlocks[dataBlockIndex]);
+            m_dataBlocks[dataBlockIndex] = new RemoteDataBlock();
+            m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_frameIndex = superBlock.m_header.m_frameIndex;
         }
     }
+
+    m_dataBlocks[dataBlockIndex]->m_superBlocks[superBlock.m_header.m_blockIndex] = superBlock;
+
+    if (superBlock.m_header.m_blockIndex == 0) {
+        m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_metaRetrieved = true;
+    }
+
+    if (superBlock.m_header.m_blockIndex < RemoteNbOrginalBlocks) {
+        m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_originalCount++;
+    } else {
+        m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_recoveryCount++;
+    }
+
+    m_dataBlocks[dataBlockIndex]->m_rxControlBlock.m_blockCount++;
 }
 
+void RemoteSourceThread::processFrameV2()
+{
+    // the frame is complete: hand it over right away as a version 1 frame with all original blocks
+    const RemoteSuperBlock *frame = m_frameDecoder.getFrame();
+    RemoteDataBlock *dataBlock = new RemoteDataBlock();
+    std::copy(frame, frame + RemoteNbOrginalBlocks, dataBlock->m_superBlocks);
+    dataBlock->m_rxControlBlock.m_frameIndex = frame[0].m_header.m_frameIndex;
+    dataBlock->m_rxControlBlock.m_metaRetrieved = true;
+    dataBlock->m_rxControlBlock.m_originalCount = RemoteNbOrginalBlocks;
+    dataBlock->m_rxControlBlock.m_blockCount = RemoteNbOrginalBlocks;
+    m_dataQueue->push(dataBlock);
+}
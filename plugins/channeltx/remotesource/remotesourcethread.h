@@ -25,6 +25,7 @@
 
 #include "util/message.h"
 #include "util/messagequeue.h"
+#include "channel/remoteframecodec.h"
 
 class RemoteDataQueue;
 class RemoteDataBlock;
@@ -94,11 +95,15 @@ private:
 
     static const uint32_t m_nbDataBlocks = 4;          //!< number of data blocks in the ring buffer
     RemoteDataBlock *m_dataBlocks[m_nbDataBlocks];  //!< ring buffer of data blocks indexed by frame affinity
+    RemoteFrameDecoder m_frameDecoder;               //!< restores version 2 protocol frames
+    char m_datagram[RemoteMaxUdpSize];
 
     void startWork();
     void stopWork();
 
     void run();
+    void processSuperBlock(const RemoteSuperBlock& superBlock);
+    void processFrameV2();
 
 private slots:
     void handleInputMessages();
@@ -47,32 +47,27 @@ UDPSource::UDPSource(DeviceAPI *deviceAPI) :
     m_basebandSampleRate(48000),
     m_outputSampleRate(48000),
     m_inputFrequencyOffset(0),
-    m_squelch(1e-6),
     m_spectrum(0),
     m_spectrumEnabled(false),
-    m_spectrumChunkSize(2160),
     m_spectrumChunkCounter(0),
     m_magsq(1e-10),
     m_movingAverage(16, 1e-10),
-    m_inMovingAverage(480, 1e-10),
+    m_udpBufferResize(0),
+    m_udpReadIndexReset(0),
     m_sampleRateSum(0),
     m_sampleRateAvgCounter(0),
     m_levelCalcCount(0),
     m_peakLevel(0.0f),
     m_levelSum(0.0f),
-    m_levelNbSamples(480),
     m_squelchOpen(false),
     m_squelchOpenCount(0),
     m_squelchCloseCount(0),
-    m_squelchThreshold(4800),
     m_modPhasor(0.0f),
-    m_SSBFilterBufferIndex(0),
-    m_settingsMutex(QMutex::Recursive)
+    m_SSBFilterBufferIndex(0)
 {
     setObjectName(m_channelId);
 
     m_udpHandler.setFeedbackMessageQueue(&m_inputMessageQueue);
-    m_SSBFilter = new fftfilt(m_settings.m_lowCutoff / m_settings.m_inputSampleRate, m_settings.m_rfBandwidth / m_settings.m_inputSampleRate, m_ssbFftLen);
     m_SSBFilterBuffer = new Complex[m_ssbFftLen>>1]; // filter returns data exactly half of its size
 
     applyChannelSettings(m_basebandSampleRate, m_outputSampleRate, m_inputFrequencyOffset, true);
@@ -95,10 +90,23 @@ UDPSource::~UDPSource()
     m_deviceAPI->removeChannelSource(m_threadedChannelizer);
     delete m_threadedChannelizer;
     delete m_channelizer;
-    delete m_SSBFilter;
     delete[] m_SSBFilterBuffer;
 }
 
+UDPSource::InputStates::InputStates(Real inputSampleRate, Real squelchdB, Real squelchGate) :
+    m_inMovingAverage(inputSampleRate * 0.01, 1e-10), // 10 ms
+    m_squelch(CalcDb::powerFromdB(squelchdB)),
+    m_squelchThreshold(inputSampleRate * squelchGate),
+    m_levelNbSamples(inputSampleRate * 0.01), // every 10 ms
+    m_spectrumChunkSize(inputSampleRate * 0.05) // 50 ms chunk
+{
+}
+
+UDPSource::SSBFilter::SSBFilter(Real inputSampleRate, Real lowCutoff, Real rfBandwidth) :
+    m_filter(lowCutoff / inputSampleRate, rfBandwidth / inputSampleRate, m_ssbFftLen)
+{
+}
+
 void UDPSource::start()
 {
     m_udpHandler.start();
@@ -112,7 +120,62 @@ void UDPSource::stop()
 
 void UDPSource::pull(Sample& sample)
 {
-    if (m_settings.m_channelMute)
+    updateStates();
+    pullOne(sample);
+}
+
+void UDPSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    updateStates(); // once for the whole block
+
+    for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+        pullOne(*begin);
+    }
+}
+
+void UDPSource::updateStates()
+{
+    if (m_settingsSnapshot.update()) {
+        m_udpHandler.setAutoRWBalance(m_settingsSnapshot->m_autoRWBalance);
+    }
+
+    bool interpolatorChanged = m_interpolator.update();
+
+    if (m_interpolatorDistance.update() || interpolatorChanged)
+    {
+        m_interpolatorDistanceRemain = 0;
+        m_interpolatorConsumed = false;
+    }
+
+    if (m_inputStates.update())
+    {
+        initSquelch(m_squelchOpen);
+        m_spectrumChunkCounter = 0;
+        m_levelCalcCount = 0;
+        m_peakLevel = 0.0f;
+        m_levelSum = 0.0f;
+    }
+
+    if (m_ssbFilter.update()) // flush what the previous filter left
+    {
+        std::fill(m_SSBFilterBuffer, m_SSBFilterBuffer+(m_ssbFftLen>>1), Complex{0,0});
+        m_SSBFilterBufferIndex = 0;
+    }
+
+    // the UDP buffer is read here so it is resized or rewound here
+    int udpBufferSampleRate = m_udpBufferResize.fetchAndStoreOrdered(0);
+    bool udpReadIndexReset = m_udpReadIndexReset.fetchAndStoreOrdered(0) != 0;
+
+    if (udpBufferSampleRate > 0) {
+        m_udpHandler.resizeBuffer(udpBufferSampleRate); // also resets the read index
+    } else if (udpReadIndexReset) {
+        m_udpHandler.resetReadIndex();
+    }
+}
+
+void UDPSource::pullOne(Sample& sample)
+{
+    if (m_settingsSnapshot->m_channelMute)
     {
         sample.m_real = 0.0f;
         sample.m_imag = 0.0f;
@@ -121,32 +184,30 @@ void UDPSource::pull(Sample& sample)
     }
 
     Complex ci;
+    Interpolator& interpolator = m_interpolator.get();
+    Real interpolatorDistance = m_interpolatorDistance.get();
 
-    m_settingsMutex.lock();
-
-    if (m_interpolatorDistance > 1.0f) // decimate
+    if (interpolatorDistance > 1.0f) // decimate
     {
         modulateSample();
 
-        while (!m_interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        while (!interpolator.decimate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
             modulateSample();
         }
     }
     else
     {
-        if (m_interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
+        if (interpolator.interpolate(&m_interpolatorDistanceRemain, m_modSample, &ci))
         {
             modulateSample();
         }
     }
 
-    m_interpolatorDistanceRemain += m_interpolatorDistance;
+    m_interpolatorDistanceRemain += interpolatorDistance;
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
     magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
     m_movingAverage.feed(magsq);
@@ -158,22 +219,25 @@ void UDPSource::pull(Sample& sample)
 
 void UDPSource::modulateSample()
 {
-    if (m_settings.m_sampleFormat == UDPSourceSettings::FormatSnLE) // Linear I/Q transponding
+    const UDPSourceSettings& settings = m_settingsSnapshot.get();
+    InputStates& inputStates = m_inputStates.get();
+
+    if (settings.m_sampleFormat == UDPSourceSettings::FormatSnLE) // Linear I/Q transponding
     {
         Sample s;
 
         m_udpHandler.readSample(s);
 
         uint64_t magsq = s.m_real * s.m_real + s.m_imag * s.m_imag;
-        m_inMovingAverage.feed(magsq/(SDR_TX_SCALED*SDR_TX_SCALED));
-        m_inMagsq = m_inMovingAverage.average();
+        inputStates.m_inMovingAverage.feed(magsq/(SDR_TX_SCALED*SDR_TX_SCALED));
+        m_inMagsq = inputStates.m_inMovingAverage.average();
 
         calculateSquelch(m_inMagsq);
 
         if (m_squelchOpen)
         {
-            m_modSample.real(s.m_real * m_settings.m_gainOut);
-            m_modSample.imag(s.m_imag * m_settings.m_gainOut);
+            m_modSample.real(s.m_real * settings.m_gainOut);
+            m_modSample.imag(s.m_imag * settings.m_gainOut);
             calculateLevel(m_modSample);
         }
         else
@@ -182,21 +246,21 @@ void UDPSource::modulateSample()
             m_modSample.imag(0.0f);
         }
     }
-    else if (m_settings.m_sampleFormat == UDPSourceSettings::FormatNFM)
+    else if (settings.m_sampleFormat == UDPSourceSettings::FormatNFM)
     {
         qint16 t;
         readMonoSample(t);
 
-        m_inMovingAverage.feed((t*t)/1073741824.0);
-        m_inMagsq = m_inMovingAverage.average();
+        inputStates.m_inMovingAverage.feed((t*t)/1073741824.0);
+        m_inMagsq = inputStates.m_inMovingAverage.average();
 
         calculateSquelch(m_inMagsq);
 
         if (m_squelchOpen)
         {
-            m_modPhasor += (m_settings.m_fmDeviation / m_settings.m_inputSampleRate) * (t / SDR_TX_SCALEF) * M_PI * 2.0f;
-            m_modSample.real(cos(m_modPhasor) * 0.3162292f * SDR_TX_SCALEF * m_settings.m_gainOut);
-            m_modSample.imag(sin(m_modPhasor) * 0.3162292f * SDR_TX_SCALEF * m_settings.m_gainOut);
+            m_modPhasor += (settings.m_fmDeviation / settings.m_inputSampleRate) * (t / SDR_TX_SCALEF) * M_PI * 2.0f;
+            m_modSample.real(cos(m_modPhasor) * 0.3162292f * SDR_TX_SCALEF * settings.m_gainOut);
+            m_modSample.imag(sin(m_modPhasor) * 0.3162292f * SDR_TX_SCALEF * settings.m_gainOut);
             calculateLevel(m_modSample);
         }
         else
@@ -205,18 +269,18 @@ void UDPSource::modulateSample()
             m_modSample.imag(0.0f);
         }
     }
-    else if (m_settings.m_sampleFormat == UDPSourceSettings::FormatAM)
+    else if (settings.m_sampleFormat == UDPSourceSettings::FormatAM)
     {
         qint16 t;
         readMonoSample(t);
-        m_inMovingAverage.feed((t*t)/(SDR_TX_SCALED*SDR_TX_SCALED));
-        m_inMagsq = m_inMovingAverage.average();
+        inputStates.m_inMovingAverage.feed((t*t)/(SDR_TX_SCALED*SDR_TX_SCALED));
+        m_inMagsq = inputStates.m_inMovingAverage.average();
 
         calculateSquelch(m_inMagsq);
 
         if (m_squelchOpen)
         {
-            m_modSample.real(((t / SDR_TX_SCALEF)*m_settings.m_amModFactor*m_settings.m_gainOut + 1.0f) * (SDR_TX_SCALEF/2)); // modulate and scale zero frequency carrier
+            m_modSample.real(((t / SDR_TX_SCALEF)*settings.m_amModFactor*settings.m_gainOut + 1.0f) * (SDR_TX_SCALEF/2)); // modulate and scale zero frequency carrier
             m_modSample.imag(0.0f);
             calculateLevel(m_modSample);
         }
@@ -226,7 +290,7 @@ void UDPSource::modulateSample()
             m_modSample.imag(0.0f);
         }
     }
-    else if ((m_settings.m_sampleFormat == UDPSourceSettings::FormatLSB) || (m_settings.m_sampleFormat == UDPSourceSettings::FormatUSB))
+    else if ((settings.m_sampleFormat == UDPSourceSettings::FormatLSB) || (settings.m_sampleFormat == UDPSourceSettings::FormatUSB))
     {
         qint16 t;
         Complex c, ci;
@@ -234,17 +298,17 @@ void UDPSource::modulateSample()
         int n_out = 0;
 
         readMonoSample(t);
-        m_inMovingAverage.feed((t*t)/(SDR_TX_SCALED*SDR_TX_SCALED));
-        m_inMagsq = m_inMovingAverage.average();
+        inputStates.m_inMovingAverage.feed((t*t)/(SDR_TX_SCALED*SDR_TX_SCALED));
+        m_inMagsq = inputStates.m_inMovingAverage.average();
 
         calculateSquelch(m_inMagsq);
 
         if (m_squelchOpen)
         {
-            ci.real((t / SDR_TX_SCALEF) * m_settings.m_gainOut);
+            ci.real((t / SDR_TX_SCALEF) * settings.m_gainOut);
             ci.imag(0.0f);
 
-            n_out = m_SSBFilter->runSSB(ci, &filtered, (m_settings.m_sampleFormat == UDPSourceSettings::FormatUSB));
+            n_out = m_ssbFilter->m_filter.runSSB(ci, &filtered, (settings.m_sampleFormat == UDPSourceSettings::FormatUSB));
 
             if (n_out > 0)
             {
@@ -272,7 +336,7 @@ void UDPSource::modulateSample()
         initSquelch(false);
     }
 
-    if (m_spectrum && m_spectrumEnabled && (m_spectrumChunkCounter < m_spectrumChunkSize - 1))
+    if (m_spectrum && m_spectrumEnabled && (m_spectrumChunkCounter < inputStates.m_spectrumChunkSize - 1))
     {
         Sample s;
         s.m_real = (FixReal) m_modSample.real();
@@ -290,7 +354,7 @@ void UDPSource::modulateSample()
 
 void UDPSource::calculateLevel(Real sample)
 {
-    if (m_levelCalcCount < m_levelNbSamples)
+    if (m_levelCalcCount < m_inputStates->m_levelNbSamples)
     {
         m_peakLevel = std::max(std::fabs(m_peakLevel), sample);
         m_levelSum += sample * sample;
@@ -298,9 +362,9 @@ void UDPSource::calculateLevel(Real sample)
     }
     else
     {
-        qreal rmsLevel = m_levelSum > 0.0 ? sqrt(m_levelSum / m_levelNbSamples) : 0.0;
+        qreal rmsLevel = m_levelSum > 0.0 ? sqrt(m_levelSum / m_inputStates->m_levelNbSamples) : 0.0;
         //qDebug("NFMMod::calculateLevel: %f %f", rmsLevel, m_peakLevel);
-        emit levelChanged(rmsLevel, m_peakLevel, m_levelNbSamples);
+        emit levelChanged(rmsLevel, m_peakLevel, m_inputStates->m_levelNbSamples);
         m_peakLevel = 0.0f;
         m_levelSum = 0.0f;
         m_levelCalcCount = 0;
@@ -311,7 +375,7 @@ void UDPSource::calculateLevel(Complex sample)
 {
     Real t = std::abs(sample);
 
-    if (m_levelCalcCount < m_levelNbSamples)
+    if (m_levelCalcCount < m_inputStates->m_levelNbSamples)
     {
         m_peakLevel = std::max(std::fabs(m_peakLevel), t);
         m_levelSum += (t * t);
@@ -319,8 +383,8 @@ void UDPSource::calculateLevel(Complex sample)
     }
     else
     {
-        qreal rmsLevel = m_levelSum > 0.0 ? sqrt((m_levelSum/(SDR_TX_SCALED*SDR_TX_SCALED)) / m_levelNbSamples) : 0.0;
-        emit levelChanged(rmsLevel, m_peakLevel / SDR_TX_SCALEF, m_levelNbSamples);
+        qreal rmsLevel = m_levelSum > 0.0 ? sqrt((m_levelSum/(SDR_TX_SCALED*SDR_TX_SCALED)) / m_inputStates->m_levelNbSamples) : 0.0;
+        emit levelChanged(rmsLevel, m_peakLevel / SDR_TX_SCALEF, m_inputStates->m_levelNbSamples);
         m_peakLevel = 0.0f;
         m_levelSum = 0.0f;
         m_levelCalcCount = 0;
@@ -402,12 +466,8 @@ bool UDPSource::handleMessage(const Message& cmd)
 //                        m_actualInputSampleRate);
 //            }
 
-            m_settingsMutex.lock();
-            m_interpolatorDistanceRemain = 0;
-            m_interpolatorConsumed = false;
-            m_interpolatorDistance = (Real) m_actualInputSampleRate / (Real) m_outputSampleRate;
-            //m_interpolator.create(48, m_actualInputSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0); // causes clicking: leaving at standard frequency
-            m_settingsMutex.unlock();
+            // only the distance: recreating the interpolator causes clicking so it is left at standard frequency
+            m_interpolatorDistance.publish((Real) m_actualInputSampleRate / (Real) m_outputSampleRate);
         }
 
         return true;
@@ -422,9 +482,7 @@ bool UDPSource::handleMessage(const Message& cmd)
     }
     else if (MsgResetReadIndex::match(cmd))
     {
-        m_settingsMutex.lock();
-        m_udpHandler.resetReadIndex();
-        m_settingsMutex.unlock();
+        m_udpReadIndexReset.storeRelease(1);
 
         qDebug() << "UDPSource::handleMessage: MsgResetReadIndex";
 
@@ -469,19 +527,11 @@ void UDPSource::applyChannelSettings(int basebandSampleRate, int outputSampleRat
     if ((inputFrequencyOffset != m_inputFrequencyOffset) ||
         (outputSampleRate != m_outputSampleRate) || force)
     {
-        m_settingsMutex.lock();
         m_carrierNco.setFreq(inputFrequencyOffset, outputSampleRate);
-        m_settingsMutex.unlock();
     }
 
-    if (((outputSampleRate != m_outputSampleRate) && (!m_settings.m_autoRWBalance)) || force)
-    {
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) m_settings.m_inputSampleRate / (Real) outputSampleRate;
-        m_interpolator.create(48, m_settings.m_inputSampleRate, m_settings.m_rfBandwidth / 2.2, 3.0);
-        m_settingsMutex.unlock();
+    if (((outputSampleRate != m_outputSampleRate) && (!m_settings.m_autoRWBalance)) || force) {
+        publishInterpolation(m_settings.m_inputSampleRate, outputSampleRate, m_settings.m_rfBandwidth);
     }
 
     m_basebandSampleRate = basebandSampleRate;
@@ -489,6 +539,14 @@ void UDPSource::applyChannelSettings(int basebandSampleRate, int outputSampleRat
     m_inputFrequencyOffset = inputFrequencyOffset;
 }
 
+void UDPSource::publishInterpolation(Real inputSampleRate, Real outputSampleRate, Real rfBandwidth)
+{
+    Interpolator *interpolator = new Interpolator();
+    interpolator->create(48, inputSampleRate, rfBandwidth / 2.2, 3.0);
+    m_interpolator.publish(interpolator);
+    m_interpolatorDistance.publish(inputSampleRate / outputSampleRate);
+}
+
 void UDPSource::applySettings(const UDPSourceSettings& settings, bool force)
 {
     qDebug() << "UDPSource::applySettings:"
@@ -569,71 +627,42 @@ void UDPSource::applySettings(const UDPSourceSettings& settings, bool force)
        (settings.m_lowCutoff != m_settings.m_lowCutoff) ||
        (settings.m_inputSampleRate != m_settings.m_inputSampleRate) || force)
     {
-        m_settingsMutex.lock();
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorConsumed = false;
-        m_interpolatorDistance = (Real) settings.m_inputSampleRate / (Real) m_outputSampleRate;
-        m_interpolator.create(48, settings.m_inputSampleRate, settings.m_rfBandwidth / 2.2, 3.0);
+        publishInterpolation(settings.m_inputSampleRate, m_outputSampleRate, settings.m_rfBandwidth);
+        m_ssbFilter.publish(new SSBFilter(settings.m_inputSampleRate, settings.m_lowCutoff, settings.m_rfBandwidth));
         m_actualInputSampleRate = settings.m_inputSampleRate;
-        m_udpHandler.resetReadIndex();
         m_sampleRateSum = 0.0;
         m_sampleRateAvgCounter = 0;
-        m_spectrumChunkSize = settings.m_inputSampleRate * 0.05; // 50 ms chunk
-        m_spectrumChunkCounter = 0;
-        m_levelNbSamples = settings.m_inputSampleRate * 0.01; // every 10 ms
-        m_levelCalcCount = 0;
-        m_peakLevel = 0.0f;
-        m_levelSum = 0.0f;
-        m_udpHandler.resizeBuffer(settings.m_inputSampleRate);
-        m_inMovingAverage.resize(settings.m_inputSampleRate * 0.01, 1e-10); // 10 ms
-        m_squelchThreshold = settings.m_inputSampleRate * settings.m_squelchGate;
-        initSquelch(m_squelchOpen);
-        m_SSBFilter->create_filter(settings.m_lowCutoff / settings.m_inputSampleRate, settings.m_rfBandwidth / settings.m_inputSampleRate);
-        m_settingsMutex.unlock();
-    }
-
-    if ((settings.m_squelch != m_settings.m_squelch) || force)
-    {
-        m_squelch = CalcDb::powerFromdB(settings.m_squelch);
+        // the UDP buffer is read by the DSP thread which does the resize at the next block
+        m_udpBufferResize.fetchAndStoreOrdered((int) settings.m_inputSampleRate);
     }
 
-    if ((settings.m_squelchGate != m_settings.m_squelchGate) || force)
+    if ((settings.m_inputSampleRate != m_settings.m_inputSampleRate) ||
+        (settings.m_squelch != m_settings.m_squelch) ||
+        (settings.m_squelchGate != m_settings.m_squelchGate) || force)
     {
-        m_squelchThreshold = m_outputSampleRate * settings.m_squelchGate;
-        initSquelch(m_squelchOpen);
+        // squelch gate is counted in input samples
+        m_inputStates.publish(new InputStates(settings.m_inputSampleRate, settings.m_squelch, settings.m_squelchGate));
     }
 
     if ((settings.m_udpAddress != m_settings.m_udpAddress) ||
         (settings.m_udpPort != m_settings.m_udpPort) || force)
     {
-        m_settingsMutex.lock();
         m_udpHandler.configureUDPLink(settings.m_udpAddress, settings.m_udpPort);
-        m_settingsMutex.unlock();
     }
 
     if ((settings.m_channelMute != m_settings.m_channelMute) || force)
     {
         if (!settings.m_channelMute) {
-            m_udpHandler.resetReadIndex();
+            m_udpReadIndexReset.storeRelease(1);
         }
     }
 
-    if ((settings.m_autoRWBalance != m_settings.m_autoRWBalance) || force)
+    // auto R/W balance is applied to the UDP handler by the DSP thread when it picks up the settings
+    if (((settings.m_autoRWBalance != m_settings.m_autoRWBalance) || force) && !settings.m_autoRWBalance)
     {
-        m_settingsMutex.lock();
-        m_udpHandler.setAutoRWBalance(settings.m_autoRWBalance);
-
-        if (!settings.m_autoRWBalance)
-        {
-            m_interpolatorDistanceRemain = 0;
-            m_interpolatorConsumed = false;
-            m_interpolatorDistance = (Real) settings.m_inputSampleRate / (Real) m_outputSampleRate;
-            m_interpolator.create(48, settings.m_inputSampleRate, settings.m_rfBandwidth / 2.2, 3.0);
-            m_actualInputSampleRate = settings.m_inputSampleRate;
-            m_udpHandler.resetReadIndex();
-        }
-
-        m_settingsMutex.unlock();
+        publishInterpolation(settings.m_inputSampleRate, m_outputSampleRate, settings.m_rfBandwidth);
+        m_actualInputSampleRate = settings.m_inputSampleRate;
+        m_udpReadIndexReset.storeRelease(1);
     }
 
     if (settings.m_useReverseAPI)
@@ -647,6 +676,7 @@ void UDPSource::applySettings(const UDPSourceSettings& settings, bool force)
     }
 
     m_settings = settings;
+    m_settingsSnapshot.publish(settings);
 }
 
 QByteArray UDPSource::serialize() const
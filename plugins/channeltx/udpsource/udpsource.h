@@ -19,6 +19,7 @@
 #define PLUGINS_CHANNELTX_UDPSINK_UDPSOURCE_H_
 
 #include <QObject>
+#include <QAtomicInt>
 #include <QNetworkRequest>
 
 #include "dsp/basebandsamplesource.h"
@@ -29,6 +30,7 @@
 #include "dsp/nco.h"
 #include "dsp/fftfilt.h"
 #include "util/message.h"
+#include "util/settingssnapshot.h"
 
 #include "udpsourcesettings.h"
 #include "udpsourceudphandler.h"
@@ -99,6 +101,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual bool handleMessage(const Message& cmd);
 
     virtual void getIdentifier(QString& id) { id = objectName(); }
@@ -193,6 +196,22 @@ private:
         { }
     };
 
+    struct InputStates //!< at UDP input sample rate
+    {
+        InputStates(Real inputSampleRate = 48000.0f, Real squelchdB = -60.0f, Real squelchGate = 0.05f);
+        MovingAverage<double> m_inMovingAverage;
+        Real m_squelch; //!< squelch level as power
+        int m_squelchThreshold;
+        int m_levelNbSamples;
+        int m_spectrumChunkSize;
+    };
+
+    struct SSBFilter //!< at UDP input sample rate
+    {
+        SSBFilter(Real inputSampleRate = 48000.0f, Real lowCutoff = 0.0f, Real rfBandwidth = 12500.0f);
+        fftfilt m_filter;
+    };
+
     DeviceAPI* m_deviceAPI;
     ThreadedBasebandSampleSource* m_threadedChannelizer;
     UpChannelizer* m_channelizer;
@@ -202,7 +221,12 @@ private:
     int m_inputFrequencyOffset;
     UDPSourceSettings m_settings;
 
-    Real m_squelch;
+    // States published by the configuration and picked up by pull() at block boundaries
+    SettingsSnapshot<UDPSourceSettings> m_settingsSnapshot;
+    SettingsSnapshot<Interpolator> m_interpolator;
+    SettingsSnapshot<Real> m_interpolatorDistance; //!< also follows the UDP buffer skew compensation
+    SettingsSnapshot<InputStates> m_inputStates;
+    SettingsSnapshot<SSBFilter> m_ssbFilter;
 
     NCO m_carrierNco;
     Complex m_modSample;
@@ -210,20 +234,18 @@ private:
     BasebandSampleSink* m_spectrum;
     bool m_spectrumEnabled;
     SampleVector m_sampleBuffer;
-    int m_spectrumChunkSize;
     int m_spectrumChunkCounter;
 
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
     Real m_interpolatorDistanceRemain;
     bool m_interpolatorConsumed;
 
     double m_magsq;
     double m_inMagsq;
     MovingAverage<double> m_movingAverage;
-    MovingAverage<double> m_inMovingAverage;
 
     UDPSourceUDPHandler m_udpHandler;
+    QAtomicInt m_udpBufferResize;   //!< input sample rate the UDP buffer is to be resized for, 0 if none
+    QAtomicInt m_udpReadIndexReset; //!< non zero if a reset of the UDP buffer read index is requested
     Real m_actualInputSampleRate; //!< sample rate with UDP buffer skew compensation
     double m_sampleRateSum;
     int m_sampleRateAvgCounter;
@@ -231,31 +253,29 @@ private:
     int m_levelCalcCount;
     Real m_peakLevel;
     double m_levelSum;
-    int m_levelNbSamples;
 
     bool m_squelchOpen;
     int  m_squelchOpenCount;
     int  m_squelchCloseCount;
-    int m_squelchThreshold;
 
     float m_modPhasor;    //!< Phasor for FM modulation
-    fftfilt* m_SSBFilter; //!< Complex filter for SSB modulation
     Complex* m_SSBFilterBuffer;
     int m_SSBFilterBufferIndex;
 
     QNetworkAccessManager *m_networkManager;
     QNetworkRequest m_networkRequest;
 
-    QMutex m_settingsMutex;
-
     static const int m_sampleRateAverageItems = 17;
     static const int m_ssbFftLen = 1024;
 
     void applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const UDPSourceSettings& settings, bool force = false);
+    void updateStates();
+    void pullOne(Sample& sample);
     void modulateSample();
     void calculateLevel(Real sample);
     void calculateLevel(Complex sample);
+    void publishInterpolation(Real inputSampleRate, Real outputSampleRate, Real rfBandwidth);
 
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const UDPSourceSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
@@ -263,28 +283,30 @@ private:
 
     inline void calculateSquelch(double value)
     {
-        if ((!m_settings.m_squelchEnabled) || (value > m_squelch))
+        const InputStates& inputStates = m_inputStates.get();
+
+        if ((!m_settingsSnapshot->m_squelchEnabled) || (value > inputStates.m_squelch))
         {
-            if (m_squelchThreshold == 0)
+            if (inputStates.m_squelchThreshold == 0)
             {
                 m_squelchOpen = true;
             }
             else
             {
-                if (m_squelchOpenCount < m_squelchThreshold)
+                if (m_squelchOpenCount < inputStates.m_squelchThreshold)
                 {
                     m_squelchOpenCount++;
                 }
                 else
                 {
-                    m_squelchCloseCount = m_squelchThreshold;
+                    m_squelchCloseCount = inputStates.m_squelchThreshold;
                     m_squelchOpen = true;
                 }
             }
         }
         else
         {
-            if (m_squelchThreshold == 0)
+            if (inputStates.m_squelchThreshold == 0)
             {
                 m_squelchOpen = false;
             }
@@ -308,8 +330,8 @@ private:
         if (open)
         {
             m_squelchOpen = true;
-            m_squelchOpenCount = m_squelchThreshold;
-            m_squelchCloseCount = m_squelchThreshold;
+            m_squelchOpenCount = m_inputStates->m_squelchThreshold;
+            m_squelchCloseCount = m_inputStates->m_squelchThreshold;
         }
         else
         {
@@ -322,16 +344,18 @@ private:
     inline void readMonoSample(qint16& t)
     {
 
-        if (m_settings.m_stereoInput)
+        const UDPSourceSettings& settings = m_settingsSnapshot.get();
+
+        if (settings.m_stereoInput)
         {
             AudioSample a;
             m_udpHandler.readSample(a);
-            t = ((a.l + a.r) * m_settings.m_gainIn) / 2;
+            t = ((a.l + a.r) * settings.m_gainIn) / 2;
         }
         else
         {
             m_udpHandler.readSample(t);
-            t *= m_settings.m_gainIn;
+            t *= settings.m_gainIn;
         }
     }
 };
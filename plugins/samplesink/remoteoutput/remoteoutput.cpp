@@ -91,6 +91,8 @@ bool RemoteOutput::start()
 	m_remoteOutputThread->setDataAddress(m_settings.m_dataAddress, m_settings.m_dataPort);
 	m_remoteOutputThread->setSamplerate(m_settings.m_sampleRate);
 	m_remoteOutputThread->setNbBlocksFEC(m_settings.m_nbFECBlocks);
+	m_remoteOutputThread->setBlockSize(m_settings.m_blockSize);
+	m_remoteOutputThread->setSampleEncoding(m_settings.m_sampleEncoding);
 	m_remoteOutputThread->connectTimer(m_masterTimer);
 	m_remoteOutputThread->startWork();
 
@@ -296,6 +298,24 @@ void RemoteOutput::applySettings(const RemoteOutputSettings& settings, bool forc
         changeTxDelay = true;
     }
 
+    if (force || (m_settings.m_blockSize != settings.m_blockSize))
+    {
+        reverseAPIKeys.append("blockSize");
+
+        if (m_remoteOutputThread != 0) {
+            m_remoteOutputThread->setBlockSize(settings.m_blockSize);
+        }
+    }
+
+    if (force || (m_settings.m_sampleEncoding != settings.m_sampleEncoding))
+    {
+        reverseAPIKeys.append("sampleEncoding");
+
+        if (m_remoteOutputThread != 0) {
+            m_remoteOutputThread->setSampleEncoding(settings.m_sampleEncoding);
+        }
+    }
+
     if (force || (m_settings.m_txDelay != settings.m_txDelay))
     {
         reverseAPIKeys.append("txDelay");
@@ -315,6 +335,8 @@ void RemoteOutput::applySettings(const RemoteOutputSettings& settings, bool forc
             << " m_sampleRate: " << settings.m_sampleRate
             << " m_txDelay: " << settings.m_txDelay
             << " m_nbFECBlocks: " << settings.m_nbFECBlocks
+            << " m_blockSize: " << settings.m_blockSize
+            << " m_sampleEncoding: " << settings.m_sampleEncoding
             << " m_apiAddress: " << settings.m_apiAddress
             << " m_apiPort: " << settings.m_apiPort
             << " m_dataAddress: " << settings.m_dataAddress
@@ -395,6 +417,12 @@ int RemoteOutput::webapiSettingsPutPatch(
     if (deviceSettingsKeys.contains("nbFECBlocks")) {
         settings.m_nbFECBlocks = response.getRemoteOutputSettings()->getNbFecBlocks();
     }
+    if (deviceSettingsKeys.contains("blockSize")) {
+        settings.m_blockSize = response.getRemoteOutputSettings()->getBlockSize();
+    }
+    if (deviceSettingsKeys.contains("sampleEncoding")) {
+        settings.m_sampleEncoding = response.getRemoteOutputSettings()->getSampleEncoding();
+    }
     if (deviceSettingsKeys.contains("apiAddress")) {
         settings.m_apiAddress = *response.getRemoteOutputSettings()->getApiAddress();
     }
@@ -456,6 +484,8 @@ void RemoteOutput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& re
     response.getRemoteOutputSettings()->setSampleRate(settings.m_sampleRate);
     response.getRemoteOutputSettings()->setTxDelay(settings.m_txDelay);
     response.getRemoteOutputSettings()->setNbFecBlocks(settings.m_nbFECBlocks);
+    response.getRemoteOutputSettings()->setBlockSize(settings.m_blockSize);
+    response.getRemoteOutputSettings()->setSampleEncoding(settings.m_sampleEncoding);
     response.getRemoteOutputSettings()->setApiAddress(new QString(settings.m_apiAddress));
     response.getRemoteOutputSettings()->setApiPort(settings.m_apiPort);
     response.getRemoteOutputSettings()->setDataAddress(new QString(settings.m_dataAddress));
@@ -641,6 +671,12 @@ void RemoteOutput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys,
     if (deviceSettingsKeys.contains("nbFECBlocks") || force) {
         swgRemoteOutputSettings->setNbFecBlocks(settings.m_nbFECBlocks);
     }
+    if (deviceSettingsKeys.contains("blockSize") || force) {
+        swgRemoteOutputSettings->setBlockSize(settings.m_blockSize);
+    }
+    if (deviceSettingsKeys.contains("sampleEncoding") || force) {
+        swgRemoteOutputSettings->setSampleEncoding(settings.m_sampleEncoding);
+    }
     if (deviceSettingsKeys.contains("apiAddress") || force) {
         swgRemoteOutputSettings->setApiAddress(new QString(settings.m_apiAddress));
     }
@@ -241,6 +241,16 @@ void RemoteOutputSinkGui::displaySettings()
     QString s1 = QString::number(m_settings.m_nbFECBlocks, 'f', 0);
     ui->nominalNbBlocksText->setText(tr("%1/%2").arg(s0).arg(s1));
 
+    int blockSizeIndex = ui->blockSize->findText(QString::number(m_settings.m_blockSize));
+
+    if (blockSizeIndex < 0) { // size set through the API
+        ui->blockSize->addItem(QString::number(m_settings.m_blockSize));
+        blockSizeIndex = ui->blockSize->count() - 1;
+    }
+
+    ui->blockSize->setCurrentIndex(blockSizeIndex);
+    ui->sampleEncoding->setCurrentIndex(m_settings.m_sampleEncoding);
+
     ui->deviceIndex->setText(tr("%1").arg(m_settings.m_deviceIndex));
     ui->channelIndex->setText(tr("%1").arg(m_settings.m_channelIndex));
     ui->apiAddress->setText(m_settings.m_apiAddress);
@@ -322,6 +332,19 @@ void RemoteOutputSinkGui::on_nbFECBlocks_valueChanged(int value)
     sendSettings();
 }
 
+void RemoteOutputSinkGui::on_blockSize_currentIndexChanged(int index)
+{
+    (void) index;
+    m_settings.m_blockSize = ui->blockSize->currentText().toUInt();
+    sendSettings();
+}
+
+void RemoteOutputSinkGui::on_sampleEncoding_currentIndexChanged(int index)
+{
+    m_settings.m_sampleEncoding = index < 0 ? 0 : index;
+    sendSettings();
+}
+
 void RemoteOutputSinkGui::on_deviceIndex_returnPressed()
 {
     bool dataOk;
@@ -29,6 +29,8 @@ void RemoteOutputSettings::resetToDefaults()
     m_sampleRate = 48000;
     m_txDelay = 0.35;
     m_nbFECBlocks = 0;
+    m_blockSize = 512;
+    m_sampleEncoding = 0;
     m_apiAddress = "127.0.0.1";
     m_apiPort = 9091;
     m_dataAddress = "127.0.0.1";
@@ -59,6 +61,8 @@ QByteArray RemoteOutputSettings::serialize() const
     s.writeString(13, m_reverseAPIAddress);
     s.writeU32(14, m_reverseAPIPort);
     s.writeU32(15, m_reverseAPIDeviceIndex);
+    s.writeU32(16, m_blockSize);
+    s.writeU32(17, m_sampleEncoding);
 
     return s.final();
 }
@@ -101,6 +105,10 @@ bool RemoteOutputSettings::deserialize(const QByteArray& data)
 
         d.readU32(15, &uintval, 0);
         m_reverseAPIDeviceIndex = uintval > 99 ? 99 : uintval;
+        d.readU32(16, &uintval, 512);
+        m_blockSize = uintval < 512 ? 512 : uintval > 8972 ? 8972 : uintval;
+        d.readU32(17, &uintval, 0);
+        m_sampleEncoding = uintval > 3 ? 0 : uintval;
 
         return true;
     }
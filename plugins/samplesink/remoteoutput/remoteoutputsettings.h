@@ -26,6 +26,8 @@ struct RemoteOutputSettings {
     quint32 m_sampleRate;
     float   m_txDelay;
     quint32 m_nbFECBlocks;
+    quint32 m_blockSize;      //!< UDP datagram size. Protocol version 2 if not 512
+    quint32 m_sampleEncoding; //!< RemoteSampleEncoding. Protocol version 2 if not raw
     QString m_apiAddress;
     quint16 m_apiPort;
     QString m_dataAddress;
@@ -53,6 +53,8 @@ public:
     void setNbBlocksFEC(uint32_t nbBlocksFEC) { m_udpSinkFEC.setNbBlocksFEC(nbBlocksFEC); };
     void setTxDelay(float txDelay) { m_udpSinkFEC.setTxDelay(txDelay); };
     void setDataAddress(const QString& address, uint16_t port) { m_udpSinkFEC.setRemoteAddress(address, port); }
+    void setBlockSize(uint32_t blockSize) { m_udpSinkFEC.setBlockSize(blockSize); }
+    void setSampleEncoding(uint32_t sampleEncoding) { m_udpSinkFEC.setSampleEncoding((RemoteSampleEncoding) sampleEncoding); }
 
     bool isRunning() const { return m_running; }
 
@@ -33,6 +33,8 @@ UDPSinkFEC::UDPSinkFEC() :
     m_nbBlocksFEC(0),
     m_txDelayRatio(0.0),
     m_txDelay(0),
+    m_blockSize(RemoteUdpSize),
+    m_sampleEncoding(RemoteEncodingRaw),
     m_txBlockIndex(0),
     m_txBlocksIndex(0),
     m_frameCount(0),
@@ -109,6 +111,18 @@ void UDPSinkFEC::setRemoteAddress(const QString& address, uint16_t port)
     }
 }
 
+void UDPSinkFEC::setBlockSize(uint32_t blockSize)
+{
+    qDebug() << "UDPSinkFEC::setBlockSize: blockSize: " << blockSize;
+    m_blockSize = blockSize < (uint32_t) RemoteUdpSize ? RemoteUdpSize : blockSize > (uint32_t) RemoteMaxUdpSize ? RemoteMaxUdpSize : blockSize;
+}
+
+void UDPSinkFEC::setSampleEncoding(RemoteSampleEncoding sampleEncoding)
+{
+    qDebug() << "UDPSinkFEC::setSampleEncoding: sampleEncoding: " << (int) sampleEncoding;
+    m_sampleEncoding = sampleEncoding;
+}
+
 void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunkSize)
 {
     const SampleVector::iterator end = begin + sampleChunkSize;
@@ -121,6 +135,7 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
         if (m_txBlockIndex == 0) // Tx block index 0 is a block with only meta data
         {
             RemoteMetaDataFEC metaData;
+            metaData.init();
 
             uint64_t ts_usecs = TimeUtil::nowus();
 
@@ -133,8 +148,15 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
             metaData.m_tv_sec = ts_usecs / 1000000UL;
             metaData.m_tv_usec = ts_usecs % 1000000UL;
 
+            if ((m_blockSize != RemoteUdpSize) || (m_sampleEncoding != RemoteEncodingRaw))
+            {
+                metaData.m_version = RemoteProtocolV2;
+                metaData.m_encoding = m_sampleEncoding;
+                metaData.m_blockSize = m_blockSize;
+            }
+
             boost::crc_32_type crc32;
-            crc32.process_bytes(&metaData, sizeof(RemoteMetaDataFEC)-4);
+            crc32.process_bytes(&metaData, RemoteMetaDataFEC::crcSize());
 
             metaData.m_crc32 = crc32.checksum();
 
@@ -159,6 +181,9 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
                         << ":" << (int) metaData.m_nbFECBlocks
                         << "|" << metaData.m_tv_sec
                         << ":" << metaData.m_tv_usec
+                        << "|" << (int) metaData.m_version
+                        << ":" << (int) metaData.m_encoding
+                        << ":" << metaData.m_blockSize
                         << "|";
 
                 m_currentMetaFEC = metaData;
@@ -198,7 +223,7 @@ void UDPSinkFEC::write(const SampleVector::iterator& begin, uint32_t sampleChunk
                 int txDelay = m_txDelay;
 
                 if (m_udpWorker) {
-                    m_udpWorker->pushTxFrame(m_txBlocks[m_txBlocksIndex], nbBlocksFEC, txDelay, m_frameCount);
+                    m_udpWorker->pushTxFrame(m_txBlocks[m_txBlocksIndex], nbBlocksFEC, txDelay, m_frameCount, m_blockSize, m_sampleEncoding);
                 }
 
                 m_txBlocksIndex = (m_txBlocksIndex + 1) % 4;
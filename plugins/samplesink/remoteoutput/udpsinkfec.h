@@ -68,6 +68,8 @@ public:
     void setNbBlocksFEC(uint32_t nbBlocksFEC);
     void setTxDelay(float txDelayRatio);
     void setRemoteAddress(const QString& address, uint16_t port);
+    void setBlockSize(uint32_t blockSize); //!< UDP payload size. Protocol version 2 is used if not 512 bytes
+    void setSampleEncoding(RemoteSampleEncoding sampleEncoding); //!< Protocol version 2 is used if not raw
 
     /** Return true if the stream is OK, return false if there is an error. */
     operator bool() const
@@ -91,6 +93,8 @@ private:
     uint32_t m_nbBlocksFEC;                 //!< Variable number of FEC blocks
     float m_txDelayRatio;                   //!< Delay in ratio of nominal frame period
     uint32_t m_txDelay;                     //!< Delay in microseconds (usleep) between each sending of an UDP datagram
+    uint32_t m_blockSize;                   //!< Size of UDP datagrams on the wire
+    RemoteSampleEncoding m_sampleEncoding;  //!< Sample encoding on the wire
     RemoteSuperBlock m_txBlocks[4][256]; //!< UDP blocks to send with original data + FEC
     RemoteSuperBlock m_superBlock;       //!< current super block being built
     int m_txBlockIndex;                     //!< Current index in blocks to transmit in the Tx row
@@ -86,10 +86,12 @@ void UDPSinkFECWorker::run()
 void UDPSinkFECWorker::pushTxFrame(RemoteSuperBlock *txBlocks,
     uint32_t nbBlocksFEC,
     uint32_t txDelay,
-    uint16_t frameIndex)
+    uint16_t frameIndex,
+    uint32_t blockSize,
+    RemoteSampleEncoding sampleEncoding)
 {
     //qDebug("UDPSinkFECWorker::pushTxFrame. %d", m_inputMessageQueue.size());
-    m_inputMessageQueue.push(MsgUDPFECEncodeAndSend::create(txBlocks, nbBlocksFEC, txDelay, frameIndex));
+    m_inputMessageQueue.push(MsgUDPFECEncodeAndSend::create(txBlocks, nbBlocksFEC, txDelay, frameIndex, blockSize, sampleEncoding));
 }
 
 void UDPSinkFECWorker::setRemoteAddress(const QString& address, uint16_t port)
@@ -106,7 +108,13 @@ void UDPSinkFECWorker::handleInputMessages()
         if (MsgUDPFECEncodeAndSend::match(*message))
         {
             MsgUDPFECEncodeAndSend *sendMsg = (MsgUDPFECEncodeAndSend *) message;
-            encodeAndTransmit(sendMsg->getTxBlocks(), sendMsg->getFrameIndex(), sendMsg->getNbBlocsFEC(), sendMsg->getTxDelay());
+
+            if ((sendMsg->getBlockSize() == (uint32_t) RemoteUdpSize) && (sendMsg->getSampleEncoding() == RemoteEncodingRaw)) {
+                encodeAndTransmit(sendMsg->getTxBlocks(), sendMsg->getFrameIndex(), sendMsg->getNbBlocsFEC(), sendMsg->getTxDelay());
+            } else {
+                encodeAndTransmitV2(sendMsg->getTxBlocks(), sendMsg->getFrameIndex(), sendMsg->getNbBlocsFEC(), sendMsg->getTxDelay(),
+                    sendMsg->getBlockSize(), sendMsg->getSampleEncoding());
+            }
         }
         else if (MsgConfigureRemoteAddress::match(*message))
         {
@@ -202,6 +210,25 @@ void UDPSinkFECWorker::encodeAndTransmit(RemoteSuperBlock *txBlockx, uint16_t fr
     }
 }
 
+void UDPSinkFECWorker::encodeAndTransmitV2(RemoteSuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay,
+    uint32_t blockSize, RemoteSampleEncoding sampleEncoding)
+{
+    m_frameEncoder.setBlockSize(blockSize);
+    m_frameEncoder.setEncoding(sampleEncoding);
+    int nbBlocks = m_frameEncoder.encode(txBlockx, frameIndex, nbBlocksFEC);
 
+    if ((nbBlocks == 0) || !m_udpSocket) {
+        return;
+    }
 
+    // the delay is given for 128 + nbBlocksFEC blocks per frame
+    txDelay = (txDelay * (RemoteNbOrginalBlocks + nbBlocksFEC)) / nbBlocks;
+    const char *datagrams = m_frameEncoder.getDatagrams();
+    int datagramSize = m_frameEncoder.getBlockSize();
 
+    for (int i = 0; i < nbBlocks; i++)
+    {
+        m_udpSocket->writeDatagram(&datagrams[i*datagramSize], datagramSize, m_remoteHostAddress, m_remotePort);
+        usleep(txDelay);
+    }
+}
@@ -25,6 +25,7 @@
 #include <QHostAddress>
 
 #include "cm256cc/cm256.h"
+#include "channel/remoteframecodec.h"
 
 #include "util/messagequeue.h"
 #include "util/message.h"
@@ -43,14 +44,18 @@ public:
         uint32_t getNbBlocsFEC() const { return m_nbBlocksFEC; }
         uint32_t getTxDelay() const { return m_txDelay; }
         uint16_t getFrameIndex() const { return m_frameIndex; }
+        uint32_t getBlockSize() const { return m_blockSize; }
+        RemoteSampleEncoding getSampleEncoding() const { return m_sampleEncoding; }
 
         static MsgUDPFECEncodeAndSend* create(
                 RemoteSuperBlock *txBlocks,
                 uint32_t nbBlocksFEC,
                 uint32_t txDelay,
-                uint16_t frameIndex)
+                uint16_t frameIndex,
+                uint32_t blockSize,
+                RemoteSampleEncoding sampleEncoding)
         {
-            return new MsgUDPFECEncodeAndSend(txBlocks, nbBlocksFEC, txDelay, frameIndex);
+            return new MsgUDPFECEncodeAndSend(txBlocks, nbBlocksFEC, txDelay, frameIndex, blockSize, sampleEncoding);
         }
 
     private:
@@ -58,16 +63,22 @@ public:
         uint32_t m_nbBlocksFEC;
         uint32_t m_txDelay;
         uint16_t m_frameIndex;
+        uint32_t m_blockSize;
+        RemoteSampleEncoding m_sampleEncoding;
 
         MsgUDPFECEncodeAndSend(
                 RemoteSuperBlock *txBlocks,
                 uint32_t nbBlocksFEC,
                 uint32_t txDelay,
-                uint16_t frameIndex) :
+                uint16_t frameIndex,
+                uint32_t blockSize,
+                RemoteSampleEncoding sampleEncoding) :
             m_txBlockx(txBlocks),
             m_nbBlocksFEC(nbBlocksFEC),
             m_txDelay(txDelay),
-            m_frameIndex(frameIndex)
+            m_frameIndex(frameIndex),
+            m_blockSize(blockSize),
+            m_sampleEncoding(sampleEncoding)
         {}
     };
 
@@ -120,7 +131,9 @@ public:
     void pushTxFrame(RemoteSuperBlock *txBlocks,
         uint32_t nbBlocksFEC,
         uint32_t txDelay,
-        uint16_t frameIndex);
+        uint16_t frameIndex,
+        uint32_t blockSize = RemoteUdpSize,
+        RemoteSampleEncoding sampleEncoding = RemoteEncodingRaw);
     void setRemoteAddress(const QString& address, uint16_t port);
 
     MessageQueue m_inputMessageQueue;    //!< Queue for asynchronous inbound communication
@@ -133,12 +146,15 @@ private:
     void stopWork();
     void run();
     void encodeAndTransmit(RemoteSuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay);
+    void encodeAndTransmitV2(RemoteSuperBlock *txBlockx, uint16_t frameIndex, uint32_t nbBlocksFEC, uint32_t txDelay,
+        uint32_t blockSize, RemoteSampleEncoding sampleEncoding);
 
     QMutex m_startWaitMutex;
     QWaitCondition m_startWaiter;
     volatile bool m_running;
     CM256 m_cm256;                       //!< CM256 library object
     bool m_cm256Valid;                   //!< true if CM256 library is initialized correctly
+    RemoteFrameEncoder m_frameEncoder;   //!< version 2 protocol encoder
     QUdpSocket   *m_udpSocket;
     QString      m_remoteAddress;
     uint16_t     m_remotePort;
@@ -117,6 +117,8 @@ public:
 
 	virtual bool handleMessage(const Message& message);
 
+    virtual const FileRecord *getFileRecord() const { return m_fileSink; }
+
     virtual int webapiSettingsGet(
                 SWGSDRangel::SWGDeviceSettings& response,
                 QString& errorMessage);
@@ -29,7 +29,6 @@ AirspyThread::AirspyThread(struct airspy_device* dev, SampleSinkFifo* sampleFifo
 	QThread(parent),
 	m_running(false),
 	m_dev(dev),
-	m_convertBuffer(AIRSPY_BLOCKSIZE),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(10),
 	m_log2Decim(0),
@@ -114,7 +113,8 @@ void AirspyThread::run()
 //  Decimate according to specified log2 (ex: log2=4 => decim=16)
 void AirspyThread::callback(const qint16* buf, qint32 len)
 {
-	SampleVector::iterator it = m_convertBuffer.begin();
+	SampleVector::iterator begin = m_sampleFifo->writeReserve((len/2) >> m_log2Decim);
+	SampleVector::iterator it = begin;
 
 	if (m_log2Decim == 0)
 	{
@@ -202,7 +202,7 @@ void AirspyThread::callback(const qint16* buf, qint32 len)
 		}
 	}
 
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
+	m_sampleFifo->writeCommit(it - begin);
 }
 
 
@@ -48,7 +48,6 @@ private:
 
 	struct airspy_device* m_dev;
 	qint16 m_buf[2*AIRSPY_BLOCKSIZE];
-	SampleVector m_convertBuffer;
 	SampleSinkFifo* m_sampleFifo;
 
 	int m_samplerate;
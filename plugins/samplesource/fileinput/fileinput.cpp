@@ -17,6 +17,7 @@
 
 #include <string.h>
 #include <errno.h>
+#include <fstream>
 
 #include <QDebug>
 #include <QNetworkReply>
@@ -89,22 +90,23 @@ void FileInput::openFileStream()
 {
 	//stopInput();
 
-	if (m_ifstream.is_open()) {
-		m_ifstream.close();
+	if (m_file.isOpen()) {
+		m_file.close();
 	}
 
+	// header is parsed with a stream then samples are read through memory mapping of the file
 #ifdef Q_OS_WIN
-	m_ifstream.open(m_fileName.toStdWString().c_str(), std::ios::binary | std::ios::ate);
+	std::ifstream ifstream(m_fileName.toStdWString().c_str(), std::ios::binary | std::ios::ate);
 #else
-	m_ifstream.open(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
+	std::ifstream ifstream(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
 #endif
-	quint64 fileSize = m_ifstream.tellg();
+	quint64 fileSize = ifstream.is_open() ? (quint64) ifstream.tellg() : 0;
 
 	if (fileSize > sizeof(FileRecord::Header))
 	{
 	    FileRecord::Header header;
-	    m_ifstream.seekg(0,std::ios_base::beg);
-		bool crcOK = FileRecord::readHeader(m_ifstream, header);
+	    ifstream.seekg(0,std::ios_base::beg);
+		bool crcOK = FileRecord::readHeader(ifstream, header);
 		m_sampleRate = header.sampleRate;
 		m_centerFrequency = header.centerFrequency;
 		m_startingTimeStamp = header.startTimeStamp;
@@ -132,6 +134,8 @@ void FileInput::openFileStream()
 		m_recordLength = 0;
 	}
 
+	ifstream.close();
+
 	qDebug() << "FileInput::openFileStream: " << m_fileName.toStdString().c_str()
 			<< " fileSize: " << fileSize << " bytes"
 			<< " length: " << m_recordLength << " seconds"
@@ -148,8 +152,13 @@ void FileInput::openFileStream()
 	    getMessageQueueToGUI()->push(report);
 	}
 
-	if (m_recordLength == 0) {
-	    m_ifstream.close();
+	if (m_recordLength != 0)
+	{
+		m_file.setFileName(m_fileName);
+
+		if (!m_file.open(QIODevice::ReadOnly)) {
+			qCritical("FileInput::openFileStream: cannot open %s: %s", qPrintable(m_fileName), qPrintable(m_file.errorString()));
+		}
 	}
 }
 
@@ -157,13 +166,11 @@ void FileInput::seekFileStream(int seekMillis)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
-	if ((m_ifstream.is_open()) && m_fileInputThread && !m_fileInputThread->isRunning())
+	if (m_file.isOpen() && m_fileInputThread)
 	{
+        // the file is memory mapped so this is a mere pointer move. Can be done while playing.
         quint64 seekPoint = ((m_recordLength * seekMillis) / 1000) * m_sampleRate;
-		m_fileInputThread->setSamplesCount(seekPoint);
-        seekPoint *= (m_sampleSize == 24 ? 8 : 4); // + sizeof(FileSink::Header)
-		m_ifstream.clear();
-		m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
+		m_fileInputThread->seek(seekPoint);
 	}
 }
 
@@ -175,7 +182,7 @@ void FileInput::init()
 
 bool FileInput::start()
 {
-    if (!m_ifstream.is_open())
+    if (!m_file.isOpen())
     {
         qWarning("FileInput::start: file not open. not starting");
         return false;
@@ -184,18 +191,14 @@ bool FileInput::start()
 	QMutexLocker mutexLocker(&m_mutex);
 	qDebug() << "FileInput::start";
 
-	if (m_ifstream.tellg() != (std::streampos)0) {
-		m_ifstream.clear();
-		m_ifstream.seekg(sizeof(FileRecord::Header), std::ios::beg);
-	}
-
 	if(!m_sampleFifo.setSize(m_settings.m_accelerationFactor * m_sampleRate * sizeof(Sample))) {
 		qCritical("Could not allocate SampleFifo");
 		return false;
 	}
 
-	m_fileInputThread = new FileInputThread(&m_ifstream, &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
+	m_fileInputThread = new FileInputThread(&m_file, sizeof(FileRecord::Header), &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
 	m_fileInputThread->setSampleRateAndSize(m_settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+	m_fileInputThread->setAsFastAsPossible(m_settings.m_asFastAsPossible);
 	m_fileInputThread->startWork();
 	m_deviceDescription = "FileInput";
 
@@ -429,6 +432,28 @@ bool FileInput::applySettings(const FileInputSettings& settings, bool force)
     if ((m_settings.m_loop != settings.m_loop)) {
         reverseAPIKeys.append("loop");
     }
+
+    if ((m_settings.m_asFastAsPossible != settings.m_asFastAsPossible) || force)
+    {
+        reverseAPIKeys.append("asFastAsPossible");
+
+        if (m_fileInputThread)
+        {
+            // reading moves between the timer tick and the thread loop
+            QMutexLocker mutexLocker(&m_mutex);
+            bool running = m_fileInputThread->isRunning();
+
+            if (running) {
+                m_fileInputThread->stopWork();
+            }
+
+            m_fileInputThread->setAsFastAsPossible(settings.m_asFastAsPossible);
+
+            if (running) {
+                m_fileInputThread->startWork();
+            }
+        }
+    }
     if ((m_settings.m_fileName != settings.m_fileName)) {
         reverseAPIKeys.append("fileName");
     }
@@ -475,6 +500,9 @@ int FileInput::webapiSettingsPutPatch(
     if (deviceSettingsKeys.contains("loop")) {
         settings.m_loop = response.getFileInputSettings()->getLoop() != 0;
     }
+    if (deviceSettingsKeys.contains("asFastAsPossible")) {
+        settings.m_asFastAsPossible = response.getFileInputSettings()->getAsFastAsPossible() != 0;
+    }
     if (deviceSettingsKeys.contains("useReverseAPI")) {
         settings.m_useReverseAPI = response.getFileInputSettings()->getUseReverseApi() != 0;
     }
@@ -545,6 +573,7 @@ void FileInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& respo
     response.getFileInputSettings()->setFileName(new QString(settings.m_fileName));
     response.getFileInputSettings()->setAccelerationFactor(settings.m_accelerationFactor);
     response.getFileInputSettings()->setLoop(settings.m_loop ? 1 : 0);
+    response.getFileInputSettings()->setAsFastAsPossible(settings.m_asFastAsPossible ? 1 : 0);
 
     response.getFileInputSettings()->setUseReverseApi(settings.m_useReverseAPI ? 1 : 0);
 
@@ -611,6 +640,9 @@ void FileInput::webapiReverseSendSettings(QList<QString>& deviceSettingsKeys, co
     if (deviceSettingsKeys.contains("loop") || force) {
         swgFileInputSettings->setLoop(settings.m_loop);
     }
+    if (deviceSettingsKeys.contains("asFastAsPossible") || force) {
+        swgFileInputSettings->setAsFastAsPossible(settings.m_asFastAsPossible ? 1 : 0);
+    }
     if (deviceSettingsKeys.contains("fileName") || force) {
         swgFileInputSettings->setFileName(new QString(settings.m_fileName));
     }
@@ -19,11 +19,10 @@
 #define INCLUDE_FILEINPUT_H
 
 #include <ctime>
-#include <iostream>
-#include <fstream>
 
 #include <QString>
 #include <QByteArray>
+#include <QFile>
 #include <QTimer>
 #include <QNetworkRequest>
 
@@ -323,7 +322,7 @@ public:
 	DeviceAPI *m_deviceAPI;
 	QMutex m_mutex;
 	FileInputSettings m_settings;
-	std::ifstream m_ifstream;
+	QFile m_file;
 	FileInputThread* m_fileInputThread;
 	QString m_deviceDescription;
 	QString m_fileName;
@@ -242,7 +242,9 @@ void FileInputGUI::displaySettings()
 {
     blockApplySettings(true);
     ui->playLoop->setChecked(m_settings.m_loop);
-    ui->acceleration->setCurrentIndex(FileInputSettings::getAccelerationIndex(m_settings.m_accelerationFactor));
+    ui->acceleration->setCurrentIndex(m_settings.m_asFastAsPossible ?
+        ui->acceleration->count() - 1 :
+        FileInputSettings::getAccelerationIndex(m_settings.m_accelerationFactor));
     blockApplySettings(false);
 }
 
@@ -335,7 +337,15 @@ void FileInputGUI::on_acceleration_currentIndexChanged(int index)
 {
     if (m_doApplySettings)
     {
-        m_settings.m_accelerationFactor = FileInputSettings::getAccelerationValue(index);
+        if (index == ui->acceleration->count() - 1) { // as fast as possible
+            m_settings.m_asFastAsPossible = true;
+        }
+        else
+        {
+            m_settings.m_asFastAsPossible = false;
+            m_settings.m_accelerationFactor = FileInputSettings::getAccelerationValue(index);
+        }
+
         FileInput::MsgConfigureFileInput *message = FileInput::MsgConfigureFileInput::create(m_settings, false);
         m_sampleSource->getInputMessageQueue()->push(message);
     }
@@ -427,6 +437,7 @@ void FileInputGUI::setAccelerationCombo()
         ui->acceleration->addItem(s);
     }
 
+    ui->acceleration->addItem(QString("Max")); // as fast as the DSP chain takes samples
     ui->acceleration->blockSignals(false);
 }
 
@@ -27,6 +27,7 @@ struct FileInputSettings {
     QString m_fileName;
     quint32 m_accelerationFactor;
     bool m_loop;
+    bool m_asFastAsPossible; //!< push samples as fast as the DSP chain takes them instead of real time
     bool     m_useReverseAPI;
     QString  m_reverseAPIAddress;
     uint16_t m_reverseAPIPort;
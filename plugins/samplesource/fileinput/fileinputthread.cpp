@@ -19,6 +19,11 @@
 #include <errno.h>
 #include <assert.h>
 #include <QDebug>
+#include <QFile>
+
+#ifndef Q_OS_WIN
+#include <sys/mman.h>
+#endif
 
 #include "dsp/filerecord.h"
 #include "fileinputthread.h"
@@ -27,15 +32,23 @@
 
 MESSAGE_CLASS_DEFINITION(FileInputThread::MsgReportEOF, Message)
 
-FileInputThread::FileInputThread(std::ifstream *samplesStream,
+FileInputThread::FileInputThread(QFile *file,
+        qint64 dataStart,
         SampleSinkFifo* sampleFifo,
         const QTimer& timer,
         MessageQueue *fileInputMessageQueue,
         QObject* parent) :
 	QThread(parent),
 	m_running(false),
-	m_ifstream(samplesStream),
-	m_fileBuf(0),
+	m_asFastAsPossible(false),
+	m_eof(false),
+	m_file(file),
+	m_dataStart(dataStart),
+	m_fileSize(0),
+	m_position(dataStart),
+	m_map(nullptr),
+	m_mapOffset(0),
+	m_mapSize(0),
 	m_convertBuf(0),
 	m_bufsize(0),
 	m_chunksize(0),
@@ -49,7 +62,8 @@ FileInputThread::FileInputThread(std::ifstream *samplesStream,
     m_throttlems(FILESOURCE_THROTTLE_MS),
     m_throttleToggle(false)
 {
-    assert(m_ifstream != 0);
+    assert(m_file != 0);
+    m_fileSize = m_file->size();
 }
 
 FileInputThread::~FileInputThread()
@@ -58,9 +72,7 @@ FileInputThread::~FileInputThread()
 		stopWork();
 	}
 
-	if (m_fileBuf != 0) {
-		free(m_fileBuf);
-	}
+    unmap();
 
 	if (m_convertBuf != 0) {
 		free(m_convertBuf);
@@ -71,9 +83,10 @@ void FileInputThread::startWork()
 {
 	qDebug() << "FileInputThread::startWork: ";
 
-    if (m_ifstream->is_open())
+    if (m_file->isOpen())
     {
-        qDebug() << "FileInputThread::startWork: file stream open, starting...";
+        qDebug() << "FileInputThread::startWork: file open, starting...";
+        m_eof = false;
         m_startWaitMutex.lock();
         m_elapsedTimer.start();
         start();
@@ -84,7 +97,7 @@ void FileInputThread::startWork()
     }
     else
     {
-        qDebug() << "FileInputThread::startWork: file stream closed, not starting.";
+        qDebug() << "FileInputThread::startWork: file closed, not starting.";
     }
 }
 
@@ -123,24 +136,12 @@ void FileInputThread::setSampleRateAndSize(int samplerate, quint32 samplesize)
 
 void FileInputThread::setBuffers(std::size_t chunksize)
 {
+    // samples are read in place from the mapped file. Only the 16 <-> 24 bit conversion needs a buffer
     if (chunksize > m_bufsize)
     {
         m_bufsize = chunksize;
         int nbSamples = m_bufsize/(2 * m_samplebytes);
 
-        if (m_fileBuf == 0)
-        {
-            qDebug() << "FileInputThread::setBuffers: Allocate file buffer";
-            m_fileBuf = (quint8*) malloc(m_bufsize);
-        }
-        else
-        {
-            qDebug() << "FileInputThread::setBuffers: Re-allocate file buffer";
-            quint8 *buf = m_fileBuf;
-            m_fileBuf = (quint8*) realloc((void*) m_fileBuf, m_bufsize);
-            if (!m_fileBuf) free(buf);
-        }
-
         if (m_convertBuf == 0)
         {
             qDebug() << "FileInputThread::setBuffers: Allocate conversion buffer";
@@ -159,14 +160,47 @@ void FileInputThread::setBuffers(std::size_t chunksize)
     }
 }
 
+void FileInputThread::seek(quint64 samplesCount)
+{
+    QMutexLocker mutexLocker(&m_readMutex);
+    qint64 position = m_dataStart + (qint64) samplesCount * 2 * (m_samplebytes == 0 ? sizeof(int16_t) : m_samplebytes);
+    m_position = position > m_fileSize ? m_fileSize : position;
+    m_samplesCount = samplesCount;
+    m_eof = false;
+    adviseAhead(m_position);
+}
+
 void FileInputThread::run()
 {
 	m_running = true;
 	m_startWaiter.wakeAll();
 
-	while(m_running) // actual work is in the tick() function
+	while(m_running)
 	{
-		sleep(1);
+        if (m_asFastAsPossible && !m_eof)
+        {
+            // feed the FIFO as long as it has room. The DSP chain sets the pace.
+            qint64 freeBytes = (qint64) (m_sampleFifo->size() - m_sampleFifo->fill()) * 2 * m_samplebytes;
+            qint64 nbBytes = freeBytes < m_chunksize ? freeBytes : m_chunksize;
+
+            if (nbBytes < m_chunksize / 4)
+            {
+                usleep(1000);
+                continue;
+            }
+
+            if (readChunk(nbBytes) < nbBytes) {
+                reportEOF();
+            }
+        }
+        else if (m_asFastAsPossible) // EOF reached: wait to be stopped
+        {
+            msleep(FILESOURCE_THROTTLE_MS);
+        }
+        else // actual work is in the tick() function
+        {
+            sleep(1);
+        }
 	}
 
 	m_running = false;
@@ -174,7 +208,7 @@ void FileInputThread::run()
 
 void FileInputThread::tick()
 {
-	if (m_running)
+	if (m_running && !m_asFastAsPossible && !m_eof)
 	{
         qint64 throttlems = m_elapsedTimer.restart();
 
@@ -187,22 +221,101 @@ void FileInputThread::tick()
         }
 
 		// read samples directly feeding the SampleFifo (no callback)
-		m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
-
-        if (m_ifstream->eof())
-        {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
-        	MsgReportEOF *message = MsgReportEOF::create();
-        	m_fileInputMessageQueue->push(message);
-        }
-        else
-        {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
-    		m_samplesCount += m_chunksize / (2 * m_samplebytes);
+        if (readChunk(m_chunksize) < m_chunksize) {
+            reportEOF();
         }
 	}
 }
 
+void FileInputThread::reportEOF()
+{
+    m_eof = true;
+    MsgReportEOF *message = MsgReportEOF::create();
+    m_fileInputMessageQueue->push(message);
+}
+
+qint64 FileInputThread::readChunk(qint64 nbBytes)
+{
+    QMutexLocker mutexLocker(&m_readMutex);
+    qint64 remainder = m_fileSize - m_position;
+    qint64 sampleBytes = 2 * m_samplebytes;
+    nbBytes = nbBytes < remainder ? nbBytes : remainder;
+    nbBytes -= nbBytes % sampleBytes;
+
+    if (nbBytes <= 0) {
+        return 0;
+    }
+
+    const uchar *buf = mapAt(m_position, nbBytes);
+
+    if (!buf) {
+        return 0;
+    }
+
+    writeToSampleFifo(buf, (qint32) nbBytes);
+    m_position += nbBytes;
+    m_samplesCount += nbBytes / sampleBytes;
+    adviseAhead(m_position + nbBytes); // next chunk is being read now so prepare the one after
+
+    return nbBytes;
+}
+
+const uchar *FileInputThread::mapAt(qint64 offset, qint64 nbBytes)
+{
+    if (m_map && (offset >= m_mapOffset) && (offset + nbBytes <= m_mapOffset + m_mapSize)) {
+        return m_map + (offset - m_mapOffset);
+    }
+
+    unmap();
+    qint64 mapOffset = offset - (offset % FILESOURCE_MAP_ALIGN);
+    qint64 mapSize = offset - mapOffset + nbBytes;
+    mapSize = mapSize < FILESOURCE_MAP_WINDOW ? FILESOURCE_MAP_WINDOW : mapSize;
+    mapSize = mapOffset + mapSize > m_fileSize ? m_fileSize - mapOffset : mapSize;
+    m_map = m_file->map(mapOffset, mapSize);
+
+    if (!m_map)
+    {
+        qWarning("FileInputThread::mapAt: cannot map %lld bytes at %lld: %s",
+            mapSize, mapOffset, qPrintable(m_file->errorString()));
+        return nullptr;
+    }
+
+    m_mapOffset = mapOffset;
+    m_mapSize = mapSize;
+#ifndef Q_OS_WIN
+    madvise(m_map, m_mapSize, MADV_SEQUENTIAL); // aggressive read ahead and early page release
+#endif
+
+    return m_map + (offset - m_mapOffset);
+}
+
+void FileInputThread::unmap()
+{
+    if (m_map)
+    {
+        m_file->unmap(m_map);
+        m_map = nullptr;
+        m_mapSize = 0;
+    }
+}
+
+void FileInputThread::adviseAhead(qint64 offset)
+{
+#ifndef Q_OS_WIN
+    // only hints within the current window. The window is aligned so the page start is too.
+    if (!m_map || (offset < m_mapOffset) || (offset >= m_mapOffset + m_mapSize)) {
+        return;
+    }
+
+    qint64 start = offset - (offset % FILESOURCE_MAP_ALIGN);
+    qint64 length = 4 * m_chunksize + (offset - start);
+    length = start + length > m_mapOffset + m_mapSize ? m_mapOffset + m_mapSize - start : length;
+    madvise(m_map + (start - m_mapOffset), length, MADV_WILLNEED);
+#else
+    (void) offset;
+#endif
+}
+
 void FileInputThread::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
 {
 	if (m_samplesize == 16)
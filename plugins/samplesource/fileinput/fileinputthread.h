@@ -23,15 +23,16 @@
 #include <QWaitCondition>
 #include <QTimer>
 #include <QElapsedTimer>
-#include <iostream>
-#include <fstream>
 #include <cstdlib>
 
 #include "dsp/inthalfbandfilter.h"
 #include "util/message.h"
 
 #define FILESOURCE_THROTTLE_MS 50
+#define FILESOURCE_MAP_WINDOW (64*1024*1024) //!< size of the file portion mapped in memory at once
+#define FILESOURCE_MAP_ALIGN (64*1024)       //!< map offsets are aligned to this (multiple of page size and Windows allocation granularity)
 
+class QFile;
 class SampleSinkFifo;
 class MessageQueue;
 
@@ -53,7 +54,8 @@ public:
         { }
     };
 
-	FileInputThread(std::ifstream *samplesStream,
+	FileInputThread(QFile *file,
+	        qint64 dataStart,
 	        SampleSinkFifo* sampleFifo,
 	        const QTimer& timer,
 	        MessageQueue *fileInputMessageQueue,
@@ -64,17 +66,26 @@ public:
 	void stopWork();
 	void setSampleRateAndSize(int samplerate, quint32 samplesize);
     void setBuffers(std::size_t chunksize);
+    void setAsFastAsPossible(bool asFastAsPossible) { m_asFastAsPossible = asFastAsPossible; }
 	bool isRunning() const { return m_running; }
     quint64 getSamplesCount() const { return m_samplesCount; }
-    void setSamplesCount(quint64 samplesCount) { m_samplesCount = samplesCount; }
+    void seek(quint64 samplesCount); //!< position reading at this sample from the start of data
 
 private:
 	QMutex m_startWaitMutex;
 	QWaitCondition m_startWaiter;
 	volatile bool m_running;
-
-	std::ifstream* m_ifstream;
-	quint8  *m_fileBuf;
+    volatile bool m_asFastAsPossible;
+    bool m_eof;
+
+	QFile *m_file;
+    qint64 m_dataStart;    //!< offset of first sample in file (after header)
+    qint64 m_fileSize;
+    qint64 m_position;     //!< offset of next byte to read in file
+    uchar *m_map;          //!< currently mapped window or null
+    qint64 m_mapOffset;    //!< file offset of the mapped window
+    qint64 m_mapSize;
+    QMutex m_readMutex;    //!< serializes reads and seeks (reads happen in the thread when running as fast as possible)
 	quint8  *m_convertBuf;
 	std::size_t m_bufsize;
     qint64 m_chunksize;
@@ -92,7 +103,12 @@ private:
 
 	void run();
 	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
+    qint64 readChunk(qint64 nbBytes); //!< feeds the FIFO with up to nbBytes from the current position. Returns bytes read.
+    const uchar *mapAt(qint64 offset, qint64 nbBytes); //!< pointer to file bytes at offset making sure at least nbBytes are mapped
+    void unmap();
+    void adviseAhead(qint64 offset);
 	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
+    void reportEOF();
 
 private slots:
 	void tick();
@@ -27,7 +27,6 @@ HackRFInputThread::HackRFInputThread(hackrf_device* dev, SampleSinkFifo* sampleF
 	QThread(parent),
 	m_running(false),
 	m_dev(dev),
-	m_convertBuffer(HACKRF_BLOCKSIZE),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(10),
 	m_log2Decim(0),
@@ -124,7 +123,8 @@ void HackRFInputThread::run()
 //  Decimate according to specified log2 (ex: log2=4 => decim=16)
 void HackRFInputThread::callback(const qint8* buf, qint32 len)
 {
-	SampleVector::iterator it = m_convertBuffer.begin();
+	SampleVector::iterator begin = m_sampleFifo->writeReserve((len/2) >> m_log2Decim);
+	SampleVector::iterator it = begin;
 
 	if (m_log2Decim == 0)
 	{
@@ -212,7 +212,7 @@ void HackRFInputThread::callback(const qint8* buf, qint32 len)
 		}
 	}
 
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
+	m_sampleFifo->writeCommit(it - begin);
 }
 
 
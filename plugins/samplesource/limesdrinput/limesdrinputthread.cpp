@@ -25,7 +25,6 @@ LimeSDRInputThread::LimeSDRInputThread(lms_stream_t* stream, SampleSinkFifo* sam
     QThread(parent),
     m_running(false),
     m_stream(stream),
-    m_convertBuffer(LIMESDR_BLOCKSIZE),
     m_sampleFifo(sampleFifo),
     m_log2Decim(0)
 {
@@ -103,7 +102,8 @@ void LimeSDRInputThread::run()
 //  Decimate according to specified log2 (ex: log2=4 => decim=16)
 void LimeSDRInputThread::callback(const qint16* buf, qint32 len)
 {
-    SampleVector::iterator it = m_convertBuffer.begin();
+    SampleVector::iterator begin = m_sampleFifo->writeReserve((len/2) >> m_log2Decim);
+    SampleVector::iterator it = begin;
 
     switch (m_log2Decim)
     {
@@ -132,6 +132,6 @@ void LimeSDRInputThread::callback(const qint16* buf, qint32 len)
         break;
     }
 
-    m_sampleFifo->write(m_convertBuffer.begin(), it);
+    m_sampleFifo->writeCommit(it - begin);
 }
 
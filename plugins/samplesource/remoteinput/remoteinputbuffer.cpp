@@ -287,7 +287,7 @@ void RemoteInputBuffer::writeData(char *array)
                         RemoteMetaDataFEC *metaData = (RemoteMetaDataFEC *) recoveredBlock;
 
                         boost::crc_32_type crc32;
-                        crc32.process_bytes(metaData, sizeof(RemoteMetaDataFEC)-4);
+                        crc32.process_bytes(metaData, RemoteMetaDataFEC::crcSize());
 
                         if (crc32.checksum() == metaData->m_crc32)
                         {
@@ -383,5 +383,8 @@ void RemoteInputBuffer::printMeta(const QString& header, RemoteMetaDataFEC *meta
             << ":" << (int) metaData->m_nbFECBlocks
             << "|" << metaData->m_tv_sec
             << ":" << metaData->m_tv_usec
+            << "|" << (int) metaData->m_version
+            << ":" << (int) metaData->m_encoding
+            << ":" << metaData->m_blockSize
             << "|";
 }
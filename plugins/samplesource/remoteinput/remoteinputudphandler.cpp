@@ -15,15 +15,16 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include <QUdpSocket>
 #include <QDebug>
 #include <QTimer>
+#include <QMutexLocker>
 
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
 #include "device/deviceapi.h"
 
 #include "remoteinputudphandler.h"
+#include "remoteinputudpthread.h"
 #include "remoteinput.h"
 
 RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceAPI *deviceAPI) :
@@ -32,13 +33,11 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
     m_masterTimerConnected(false),
     m_running(false),
     m_rateDivider(1000/REMOTEINPUT_THROTTLE_MS),
-	m_dataSocket(0),
+	m_udpThread(nullptr),
 	m_dataAddress(QHostAddress::LocalHost),
 	m_remoteAddress(QHostAddress::LocalHost),
 	m_dataPort(9090),
 	m_dataConnected(false),
-	m_udpBuf(0),
-	m_udpReadBytes(0),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(0),
 	m_centerFrequency(0),
@@ -55,8 +54,6 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
     m_throttleToggle(false),
 	m_autoCorrBuffer(true)
 {
-    m_udpBuf = new char[RemoteUdpSize];
-
 #ifdef USE_INTERNAL_TIMER
 #warning "Uses internal timer"
     m_timer = new QTimer();
@@ -71,7 +68,6 @@ RemoteInputUDPHandler::RemoteInputUDPHandler(SampleSinkFifo *sampleFifo, DeviceA
 RemoteInputUDPHandler::~RemoteInputUDPHandler()
 {
 	stop();
-	delete[] m_udpBuf;
 	if (m_converterBuffer) { delete[] m_converterBuffer; }
 #ifdef USE_INTERNAL_TIMER
     if (m_timer) {
@@ -88,16 +84,14 @@ void RemoteInputUDPHandler::start()
 	    return;
 	}
 
-	if (!m_dataSocket)
+	if (!m_udpThread)
 	{
-		m_dataSocket = new QUdpSocket(this);
+		m_udpThread = new RemoteInputUDPThread(this);
 	}
 
     if (!m_dataConnected)
 	{
-        connect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead())); //, Qt::QueuedConnection);
-
-        if (m_dataSocket->bind(m_dataAddress, m_dataPort))
+        if (m_udpThread->startWork(m_dataAddress, m_dataPort))
 		{
 			qDebug("RemoteInputUDPHandler::start: bind data socket to %s:%d", m_dataAddress.toString().toStdString().c_str(),  m_dataPort);
 			m_dataConnected = true;
@@ -105,7 +99,6 @@ void RemoteInputUDPHandler::start()
 		else
 		{
 			qWarning("RemoteInputUDPHandler::start: cannot bind data port %d", m_dataPort);
-	        disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
 			m_dataConnected = false;
 		}
 	}
@@ -124,16 +117,13 @@ void RemoteInputUDPHandler::stop()
 
 	disconnectTimer();
 
-    if (m_dataConnected)
-    {
-		m_dataConnected = false;
-	    disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
-	}
+    m_dataConnected = false;
 
-	if (m_dataSocket)
+	if (m_udpThread)
 	{
-		delete m_dataSocket;
-		m_dataSocket = 0;
+		m_udpThread->stopWork();
+		delete m_udpThread;
+		m_udpThread = nullptr;
 	}
 
 	m_centerFrequency = 0;
@@ -157,25 +147,43 @@ void RemoteInputUDPHandler::configureUDPLink(const QString& address, quint16 por
 	start();
 }
 
-void RemoteInputUDPHandler::dataReadyRead()
+void RemoteInputUDPHandler::getRemoteAddress(QString& s) const
 {
-    m_udpReadBytes = 0;
+    QMutexLocker mutexLocker(&m_bufferMutex);
+    s = m_remoteAddress.toString();
+}
 
-	while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
-	{
-		qint64 pendingDataSize = m_dataSocket->pendingDatagramSize();
-		m_udpReadBytes += m_dataSocket->readDatagram(&m_udpBuf[m_udpReadBytes], pendingDataSize, &m_remoteAddress, 0);
+void RemoteInputUDPHandler::processData(char *datagrams, const int *datagramSizes, int nbDatagrams, const QHostAddress& remoteAddress)
+{
+    QMutexLocker mutexLocker(&m_bufferMutex);
+    m_remoteAddress = remoteAddress;
 
-		if (m_udpReadBytes == RemoteUdpSize) {
-		    processData();
-		    m_udpReadBytes = 0;
-		}
-	}
+    for (int i = 0; i < nbDatagrams; i++)
+    {
+        char *datagram = &datagrams[i * RemoteMaxUdpSize];
+
+        if (RemoteFrameDecoder::isVersion2(datagram, datagramSizes[i]))
+        {
+            // version 2 frames are restored as version 1 frames with all original blocks
+            if (m_frameDecoder.feed(datagram, datagramSizes[i]))
+            {
+                const RemoteSuperBlock *frame = m_frameDecoder.getFrame();
+
+                for (int ib = 0; ib < RemoteNbOrginalBlocks; ib++) {
+                    processDatagram((char *) &frame[ib]);
+                }
+            }
+        }
+        else if (datagramSizes[i] == RemoteUdpSize) // anything else is not ours
+        {
+            processDatagram(datagram);
+        }
+    }
 }
 
-void RemoteInputUDPHandler::processData()
+void RemoteInputUDPHandler::processDatagram(char *datagram)
 {
-    m_remoteInputBuffer.writeData(m_udpBuf);
+    m_remoteInputBuffer.writeData(datagram);
     const RemoteMetaDataFEC& metaData =  m_remoteInputBuffer.getCurrentMeta();
     bool change = false;
 
@@ -210,12 +218,16 @@ void RemoteInputUDPHandler::processData()
             m_outputMessageQueueToGUI->push(report);
         }
 
-        connectTimer();
+        QMetaObject::invokeMethod(this, "connectTimer", Qt::QueuedConnection); // timer lives in the handler thread
     }
 }
 
 void RemoteInputUDPHandler::connectTimer()
 {
+    if (!m_running) { // queued call arriving after stop()
+        return;
+    }
+
     if (!m_masterTimerConnected)
     {
         qDebug() << "RemoteInputUDPHandler::connectTimer";
@@ -246,6 +258,8 @@ void RemoteInputUDPHandler::disconnectTimer()
 
 void RemoteInputUDPHandler::tick()
 {
+    QMutexLocker mutexLocker(&m_bufferMutex);
+
     // auto throttling
     int throttlems = m_elapsedTimer.restart();
 
@@ -19,11 +19,11 @@
 #define PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTUDPHANDLER_H_
 
 #include <QObject>
-#include <QUdpSocket>
 #include <QHostAddress>
 #include <QMutex>
 #include <QElapsedTimer>
 
+#include "channel/remoteframecodec.h"
 #include "remoteinputbuffer.h"
 
 #define REMOTEINPUT_THROTTLE_MS 50
@@ -32,6 +32,7 @@ class SampleSinkFifo;
 class MessageQueue;
 class QTimer;
 class DeviceAPI;
+class RemoteInputUDPThread;
 
 class RemoteInputUDPHandler : public QObject
 {
@@ -43,7 +44,7 @@ public:
 	void start();
 	void stop();
 	void configureUDPLink(const QString& address, quint16 port);
-	void getRemoteAddress(QString& s) const { s = m_remoteAddress.toString(); }
+	void getRemoteAddress(QString& s) const;
     int getNbOriginalBlocks() const { return RemoteNbOrginalBlocks; }
     bool isStreaming() const { return m_masterTimerConnected; }
     int getSampleRate() const { return m_samplerate; }
@@ -52,8 +53,7 @@ public:
     uint64_t getTVmSec() const { return m_tv_msec; }
     int getMinNbBlocks() { return m_remoteInputBuffer.getMinNbBlocks(); }
     int getMaxNbRecovery() { return m_remoteInputBuffer.getMaxNbRecovery(); }
-public slots:
-	void dataReadyRead();
+    void processData(char *datagrams, const int *datagramSizes, int nbDatagrams, const QHostAddress& remoteAddress); //!< called from the UDP thread
 
 private:
 	DeviceAPI *m_deviceAPI;
@@ -62,13 +62,13 @@ private:
 	bool m_running;
     uint32_t m_rateDivider;
 	RemoteInputBuffer m_remoteInputBuffer;
-	QUdpSocket *m_dataSocket;
+	RemoteFrameDecoder m_frameDecoder; //!< restores version 2 protocol frames
+	mutable QMutex m_bufferMutex; //!< buffer is written by the UDP thread and read on timer ticks
+	RemoteInputUDPThread *m_udpThread;
 	QHostAddress m_dataAddress;
 	QHostAddress m_remoteAddress;
 	quint16 m_dataPort;
 	bool m_dataConnected;
-	char *m_udpBuf;
-	qint64 m_udpReadBytes;
 	SampleSinkFifo *m_sampleFifo;
 	uint32_t m_samplerate;
 	uint64_t m_centerFrequency;
@@ -87,11 +87,11 @@ private:
     bool m_throttleToggle;
     bool m_autoCorrBuffer;
 
-	void connectTimer();
     void disconnectTimer();
-	void processData();
+	void processDatagram(char *datagram);
 
 private slots:
+	void connectTimer();
 	void tick();
 };
 
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "remoteinputudphandler.h"
+#include "remoteinputudpthread.h"
+
+RemoteInputUDPThread::RemoteInputUDPThread(RemoteInputUDPHandler *handler, QObject* parent) :
+    QThread(parent),
+    m_running(false),
+    m_handler(handler)
+{
+    m_batchBuffer = new char[m_batchSize * RemoteMaxUdpSize];
+}
+
+RemoteInputUDPThread::~RemoteInputUDPThread()
+{
+    stopWork();
+    delete[] m_batchBuffer;
+}
+
+bool RemoteInputUDPThread::startWork(const QHostAddress& address, quint16 port)
+{
+    if (!m_socket.bind(address, port))
+    {
+        m_socket.close();
+        return false;
+    }
+
+    m_socket.setBufferSizes(0, 8<<20); // absorbs scheduling hiccups of this thread at high rates
+    qDebug("RemoteInputUDPThread::startWork: bound to %s:%u %s", qPrintable(address.toString()), port,
+        m_socket.isBatching() ? "batched receive" : "one datagram per call");
+
+    m_startWaitMutex.lock();
+    start();
+
+    while (!m_running) {
+        m_startWaiter.wait(&m_startWaitMutex, 100);
+    }
+
+    m_startWaitMutex.unlock();
+    return true;
+}
+
+void RemoteInputUDPThread::stopWork()
+{
+    if (m_running)
+    {
+        m_running = false;
+        wait();
+    }
+
+    m_socket.close();
+}
+
+void RemoteInputUDPThread::run()
+{
+    qDebug("RemoteInputUDPThread::run: begin");
+    m_running = true;
+    m_startWaiter.wakeAll();
+    QHostAddress senderAddress;
+
+    while (m_running)
+    {
+        // the timeout only bounds the time to notice a stop request
+        int nbDatagrams = m_socket.receive(m_batchBuffer, RemoteMaxUdpSize, m_batchSize, 100, m_batchSizes, &senderAddress);
+
+        if (nbDatagrams < 0)
+        {
+            qWarning("RemoteInputUDPThread::run: receive error");
+            msleep(100);
+        }
+        else if (nbDatagrams > 0)
+        {
+            m_handler->processData(m_batchBuffer, m_batchSizes, nbDatagrams, senderAddress);
+        }
+    }
+
+    qDebug("RemoteInputUDPThread::run: end");
+}
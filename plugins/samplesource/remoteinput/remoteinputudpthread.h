@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTUDPTHREAD_H_
+#define PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTUDPTHREAD_H_
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHostAddress>
+
+#include "channel/remotedatablock.h"
+#include "util/udpbatchsocket.h"
+
+class RemoteInputUDPHandler;
+
+/**
+ * Receives the remote stream datagrams in batches on its own thread without going through
+ * the Qt event loop and hands them over to the UDP handler.
+ */
+class RemoteInputUDPThread : public QThread
+{
+    Q_OBJECT
+public:
+    RemoteInputUDPThread(RemoteInputUDPHandler *handler, QObject* parent = nullptr);
+    ~RemoteInputUDPThread();
+
+    bool startWork(const QHostAddress& address, quint16 port); //!< false if the socket cannot be bound
+    void stopWork();
+
+private:
+    static const int m_batchSize = 256; //!< datagrams per receive call: up to a full frame with FEC
+
+    QMutex m_startWaitMutex;
+    QWaitCondition m_startWaiter;
+    volatile bool m_running;
+
+    RemoteInputUDPHandler *m_handler;
+    UDPBatchSocket m_socket;
+    char *m_batchBuffer;
+    int m_batchSizes[m_batchSize];
+
+    void run();
+};
+
+#endif // PLUGINS_SAMPLESOURCE_REMOTEINPUT_REMOTEINPUTUDPTHREAD_H_
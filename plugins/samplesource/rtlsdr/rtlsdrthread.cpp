@@ -28,7 +28,6 @@ RTLSDRThread::RTLSDRThread(rtlsdr_dev_t* dev, SampleSinkFifo* sampleFifo, QObjec
 	QThread(parent),
 	m_running(false),
 	m_dev(dev),
-	m_convertBuffer(FCD_BLOCKSIZE),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(288000),
 	m_log2Decim(4),
@@ -91,7 +90,8 @@ void RTLSDRThread::run()
 //  Decimate according to specified log2 (ex: log2=4 => decim=16)
 void RTLSDRThread::callback(const quint8* buf, qint32 len)
 {
-	SampleVector::iterator it = m_convertBuffer.begin();
+	SampleVector::iterator begin = m_sampleFifo->writeReserve((len/2) >> m_log2Decim);
+	SampleVector::iterator it = begin;
 
 	if (m_log2Decim == 0)
 	{
@@ -179,7 +179,7 @@ void RTLSDRThread::callback(const quint8* buf, qint32 len)
 		}
 	}
 
-	m_sampleFifo->write(m_convertBuffer.begin(), it);
+	m_sampleFifo->writeCommit(it - begin);
 
 	if(!m_running)
 		rtlsdr_cancel_async(m_dev);
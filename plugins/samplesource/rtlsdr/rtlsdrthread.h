@@ -46,7 +46,6 @@ private:
 	bool m_running;
 
 	rtlsdr_dev_t* m_dev;
-	SampleVector m_convertBuffer;
 	SampleSinkFifo* m_sampleFifo;
 
 	int m_samplerate;
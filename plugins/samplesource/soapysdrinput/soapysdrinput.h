@@ -180,6 +180,8 @@ public:
     bool hasIQAutoCorrection() { return false; } // not in SoapySDR interface
     bool hasIQCorrectionValue();
 
+    virtual const FileRecord *getFileRecord() const { return m_fileSink; }
+
     virtual int webapiSettingsGet(
                 SWGSDRangel::SWGDeviceSettings& response,
                 QString& errorMessage);
@@ -33,10 +33,6 @@ XTRXInputThread::XTRXInputThread(struct xtrx_dev *dev, unsigned int nbChannels,
 {
     qDebug("XTRXInputThread::XTRXInputThread: nbChannels: %u uniqueChannelIndex: %u", nbChannels, uniqueChannelIndex);
     m_channels = new Channel[2];
-
-    for (unsigned int i = 0; i < 2; i++) {
-        m_channels[i].m_convertBuffer.resize(DeviceXTRX::blockSize, Sample{0,0});
-    }
 }
 
 XTRXInputThread::~XTRXInputThread()
@@ -225,7 +221,9 @@ SampleSinkFifo *XTRXInputThread::getFifo(unsigned int channel)
 
 void XTRXInputThread::callbackSI(const qint16* buf, qint32 len)
 {
-    SampleVector::iterator it = m_channels[m_uniqueChannelIndex].m_convertBuffer.begin();
+    SampleSinkFifo *sampleFifo = m_channels[m_uniqueChannelIndex].m_sampleFifo;
+    SampleVector::iterator begin = sampleFifo->writeReserve((len/2) >> m_channels[m_uniqueChannelIndex].m_log2Decim);
+    SampleVector::iterator it = begin;
 
     if (m_channels[m_uniqueChannelIndex].m_log2Decim == 0)
     {
@@ -258,7 +256,7 @@ void XTRXInputThread::callbackSI(const qint16* buf, qint32 len)
         }
     }
 
-    m_channels[m_uniqueChannelIndex].m_sampleFifo->write(m_channels[m_uniqueChannelIndex].m_convertBuffer.begin(), it);
+    sampleFifo->writeCommit(it - begin);
 }
 
 void XTRXInputThread::callbackMI(const qint16* buf0, const qint16* buf1, qint32 len)
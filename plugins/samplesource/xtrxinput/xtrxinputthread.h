@@ -51,7 +51,6 @@ public:
 private:
     struct Channel
     {
-        SampleVector m_convertBuffer;
         SampleSinkFifo* m_sampleFifo;
         unsigned int m_log2Decim;
         Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12> m_decimators;
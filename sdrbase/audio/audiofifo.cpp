@@ -17,7 +17,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
-#include <QTime>
+#include <QThread>
 #include "dsp/dsptypes.h"
 #include "audio/audiofifo.h"
 #include "audio/audionetsink.h"
@@ -26,26 +26,35 @@
 
 AudioFifo::AudioFifo() :
 	m_fifo(0),
-	m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_fill(0),
+	m_exclusive(0),
+	m_writing(0),
+	m_tail(0),
+	m_reading(0),
+	m_head(0)
 {
-	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 AudioFifo::AudioFifo(uint32_t numSamples) :
 	m_fifo(0),
-    m_sampleSize(sizeof(AudioSample))
+	m_sampleSize(sizeof(AudioSample)),
+	m_size(0),
+	m_fill(0),
+	m_exclusive(0),
+	m_writing(0),
+	m_tail(0),
+	m_reading(0),
+	m_head(0)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	create(numSamples);
 }
 
 AudioFifo::~AudioFifo()
 {
 	QMutexLocker mutexLocker(&m_mutex);
+	beginExclusive();
 
 	if (m_fifo != 0)
 	{
@@ -59,8 +68,39 @@ AudioFifo::~AudioFifo()
 bool AudioFifo::setSize(uint32_t numSamples)
 {
 	QMutexLocker mutexLocker(&m_mutex);
+	beginExclusive();
+	bool ok = create(numSamples);
+	endExclusive();
 
-	return create(numSamples);
+	return ok;
+}
+
+bool AudioFifo::beginAccess(QAtomicInt& access)
+{
+	// ordered store then load pairs with the ones in beginExclusive so that either side sees the other
+	access.fetchAndStoreOrdered(1);
+
+	if (m_exclusive.loadAcquire() != 0)
+	{
+		access.storeRelease(0);
+		return false;
+	}
+
+	return true;
+}
+
+void AudioFifo::beginExclusive()
+{
+	m_exclusive.fetchAndStoreOrdered(1);
+
+	while ((m_writing.loadAcquire() != 0) || (m_reading.loadAcquire() != 0)) {
+		QThread::yieldCurrentThread();
+	}
+}
+
+void AudioFifo::endExclusive()
+{
+	m_exclusive.storeRelease(0);
 }
 
 uint AudioFifo::write(const quint8* data, uint32_t numSamples)
@@ -69,34 +109,31 @@ uint AudioFifo::write(const quint8* data, uint32_t numSamples)
 	uint32_t remaining;
 	uint32_t copyLen;
 
-	if (m_fifo == 0) {
+	if (!beginAccess(m_writing)) {
 		return 0;
 	}
 
-	m_mutex.lock();
+	if (m_fifo == 0)
+	{
+		m_writing.storeRelease(0);
+		return 0;
+	}
 
-	total = MIN(numSamples, m_size - m_fill);
+	total = MIN(numSamples, m_size - fill());
 	remaining = total;
 
 	while (remaining != 0)
 	{
-		if (isFull())
-		{
-			m_mutex.unlock();
-			return total - remaining; // written so far
-		}
-
-		copyLen = MIN(remaining, m_size - m_fill);
-		copyLen = MIN(copyLen, m_size - m_tail);
+		copyLen = MIN(remaining, m_size - m_tail);
 		memcpy(m_fifo + (m_tail * m_sampleSize), data, copyLen * m_sampleSize);
 		m_tail += copyLen;
 		m_tail %= m_size;
-		m_fill += copyLen;
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
 	}
 
-	m_mutex.unlock();
+	m_fill.fetchAndAddOrdered(total); // publishes the samples
+	m_writing.storeRelease(0);
 	return total;
 }
 
@@ -106,49 +143,50 @@ uint AudioFifo::read(quint8* data, uint32_t numSamples)
 	uint32_t remaining;
 	uint32_t copyLen;
 
-	if (m_fifo == 0) {
+	if (!beginAccess(m_reading)) {
 		return 0;
 	}
 
-	m_mutex.lock();
+	if (m_fifo == 0)
+	{
+		m_reading.storeRelease(0);
+		return 0;
+	}
 
-	total = MIN(numSamples, m_fill);
+	total = MIN(numSamples, fill());
 	remaining = total;
 
 	while (remaining != 0)
 	{
-		if (isEmpty())
-		{
-			m_mutex.unlock();
-			return total - remaining; // read so far
-		}
-
-		copyLen = MIN(remaining, m_fill);
-		copyLen = MIN(copyLen, m_size - m_head);
+		copyLen = MIN(remaining, m_size - m_head);
 		memcpy(data, m_fifo + (m_head * m_sampleSize), copyLen * m_sampleSize);
-
 		m_head += copyLen;
 		m_head %= m_size;
-		m_fill -= copyLen;
 		data += copyLen * m_sampleSize;
 		remaining -= copyLen;
 	}
 
-	m_mutex.unlock();
+	m_fill.fetchAndAddOrdered(-(int) total); // releases the space
+	m_reading.storeRelease(0);
 	return total;
 }
 
 uint AudioFifo::drain(uint32_t numSamples)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	if (!beginAccess(m_reading)) {
+		return 0;
+	}
 
-	if(numSamples > m_fill)
+	if (m_size == 0)
 	{
-		numSamples = m_fill;
+		m_reading.storeRelease(0);
+		return 0;
 	}
 
+	numSamples = MIN(numSamples, fill());
 	m_head = (m_head + numSamples) % m_size;
-	m_fill -= numSamples;
+	m_fill.fetchAndAddOrdered(-(int) numSamples);
+	m_reading.storeRelease(0);
 
 	return numSamples;
 }
@@ -156,10 +194,13 @@ uint AudioFifo::drain(uint32_t numSamples)
 void AudioFifo::clear()
 {
 	QMutexLocker mutexLocker(&m_mutex);
+	beginExclusive();
 
-	m_fill = 0;
+	m_fill.storeRelease(0);
 	m_head = 0;
 	m_tail = 0;
+
+	endExclusive();
 }
 
 bool AudioFifo::create(uint32_t numSamples)
@@ -170,7 +211,7 @@ bool AudioFifo::create(uint32_t numSamples)
 		m_fifo = 0;
 	}
 
-	m_fill = 0;
+	m_fill.storeRelease(0);
 	m_head = 0;
 	m_tail = 0;
 
@@ -22,10 +22,20 @@
 #include <QObject>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QAtomicInt>
 
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+/**
+ * Single producer single consumer FIFO of audio samples. The producer (channel thread) only moves
+ * the tail and the consumer (audio device thread) only moves the head. The shared fill count is
+ * updated atomically so read and write take no lock and never wait.
+ *
+ * Resizing and clearing change both sides. These are rare and may be called from any thread: they
+ * raise a flag and wait until no read or write is in progress. A read or write seeing the flag does
+ * nothing and returns 0.
+ */
 class SDRBASE_API AudioFifo : public QObject {
 	Q_OBJECT
 public:
@@ -35,31 +45,42 @@ public:
 
 	bool setSize(uint32_t numSamples);
 
-	uint32_t write(const quint8* data, uint32_t numSamples);
-	uint32_t read(quint8* data, uint32_t numSamples);
+	uint32_t write(const quint8* data, uint32_t numSamples); //!< producer side
+	uint32_t read(quint8* data, uint32_t numSamples);        //!< consumer side
 
-	uint32_t drain(uint32_t numSamples);
+	uint32_t drain(uint32_t numSamples); //!< consumer side
 	void clear();
 
-	inline uint32_t flush() { return drain(m_fill); }
-	inline uint32_t fill() const { return m_fill; }
-	inline bool isEmpty() const { return m_fill == 0; }
-	inline bool isFull() const { return m_fill == m_size; }
+	inline uint32_t flush() { return drain(fill()); }
+	inline uint32_t fill() const { return m_fill.loadAcquire(); }
+	inline bool isEmpty() const { return fill() == 0; }
+	inline bool isFull() const { return fill() == m_size; }
 	inline uint32_t size() const { return m_size; }
 
 private:
-	QMutex m_mutex;
+	static const int m_cacheLineSize = 64;
 
+	// shared
+	QMutex m_mutex; //!< serializes resize and clear
 	qint8* m_fifo;
-
 	const uint32_t m_sampleSize;
-
 	uint32_t m_size;
-	uint32_t m_fill;
-	uint32_t m_head;
+	char m_pad0[m_cacheLineSize];
+	QAtomicInt m_fill;
+	QAtomicInt m_exclusive;  //!< resize or clear in progress
+	char m_pad1[m_cacheLineSize];
+	// producer side
+	QAtomicInt m_writing;
 	uint32_t m_tail;
+	char m_pad2[m_cacheLineSize];
+	// consumer side
+	QAtomicInt m_reading;
+	uint32_t m_head;
 
 	bool create(uint32_t numSamples);
+	void beginExclusive();
+	void endExclusive();
+	bool beginAccess(QAtomicInt& access);
 };
 
 #endif // INCLUDE_AUDIOFIFO_H
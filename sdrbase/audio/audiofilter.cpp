@@ -207,3 +207,21 @@ float AudioFilter::runLP(const float& sample)
 {
     return m_filterLP.run(sample);
 }
+
+void AudioFilter::run(const float *in, float *out, int nbSamples)
+{
+    if (m_useHP)
+    {
+        m_filterHP.run(in, out, nbSamples);
+        m_filterLP.run(out, out, nbSamples);
+    }
+    else
+    {
+        m_filterLP.run(in, out, nbSamples);
+    }
+}
+
+void AudioFilter::runLP(const float *in, float *out, int nbSamples)
+{
+    m_filterLP.run(in, out, nbSamples);
+}
@@ -52,6 +52,8 @@ public:
     float run(const float& sample);
     float runHP(const float& sample);
     float runLP(const float& sample);
+    void run(const float *in, float *out, int nbSamples);   //!< block versions. in and out may be the same
+    void runLP(const float *in, float *out, int nbSamples);
 
 private:
     void calculate2(bool highPass, double fc, float *a, float *b, float fgain); // two pole Chebyshev calculation
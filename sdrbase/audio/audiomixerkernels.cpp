@@ -0,0 +1,127 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "util/cpufeatures.h"
+#include "audiomixerkernels.h"
+
+// constant initialized so that they are valid before the dynamic initialization of m_kernel
+AudioMixerKernels::Mix AudioMixerKernels::mix = AudioMixerKernels::mixScalar;
+AudioMixerKernels::Pack AudioMixerKernels::pack = AudioMixerKernels::packScalar;
+AudioMixerKernels::Kernel AudioMixerKernels::m_kernel = AudioMixerKernels::selectBest();
+
+bool AudioMixerKernels::isSupported(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelScalar:
+        return true;
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KernelSSE2:
+        return CPUFeatures::hasSSE2();
+    case KernelAVX2:
+        return CPUFeatures::hasAVX2();
+#elif defined(ARCHITECTURE_ARM) || defined(ARCHITECTURE_ARM64)
+    case KernelNEON:
+        return CPUFeatures::hasNEON();
+#endif
+    default:
+        return false;
+    }
+}
+
+bool AudioMixerKernels::setKernel(Kernel kernel)
+{
+    if (!isSupported(kernel)) {
+        return false;
+    }
+
+    switch (kernel)
+    {
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KernelSSE2:
+        mix = mixSSE2;
+        pack = packSSE2;
+        break;
+    case KernelAVX2:
+        mix = mixAVX2;
+        pack = packAVX2;
+        break;
+#elif defined(ARCHITECTURE_ARM) || defined(ARCHITECTURE_ARM64)
+    case KernelNEON:
+        mix = mixNEON;
+        pack = packNEON;
+        break;
+#endif
+    default:
+        mix = mixScalar;
+        pack = packScalar;
+        break;
+    }
+
+    m_kernel = kernel;
+    return true;
+}
+
+const char *AudioMixerKernels::getKernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelScalar:
+        return "scalar";
+    case KernelSSE2:
+        return "SSE2";
+    case KernelAVX2:
+        return "AVX2";
+    case KernelNEON:
+        return "NEON";
+    default:
+        return "unknown";
+    }
+}
+
+AudioMixerKernels::Kernel AudioMixerKernels::selectBest()
+{
+    static const Kernel preference[] = {KernelAVX2, KernelSSE2, KernelNEON};
+
+    for (unsigned int i = 0; i < sizeof(preference)/sizeof(preference[0]); i++)
+    {
+        if (setKernel(preference[i])) {
+            return preference[i];
+        }
+    }
+
+    return KernelScalar;
+}
+
+void AudioMixerKernels::mixScalar(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR)
+{
+    const qint32 round = 1 << (m_gainShift - 1);
+
+    for (int k = 0; k < nbSamples; k++)
+    {
+        acc[2*k]   += (in[k].l * gainL + round) >> m_gainShift;
+        acc[2*k+1] += (in[k].r * gainR + round) >> m_gainShift;
+    }
+}
+
+void AudioMixerKernels::packScalar(const qint32 *acc, qint16 *out, int nbValues)
+{
+    for (int k = 0; k < nbValues; k++) {
+        out[k] = acc[k] < -32768 ? -32768 : acc[k] > 32767 ? 32767 : acc[k];
+    }
+}
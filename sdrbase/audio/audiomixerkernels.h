@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIOMIXERKERNELS_H_
+#define SDRBASE_AUDIO_AUDIOMIXERKERNELS_H_
+
+#include <QtGlobal>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Audio mixer inner loops used by AudioOutput to sum its FIFOs. The implementation is selected at
+ * runtime from the instruction sets of the CPU like the half-band filter kernels (see hbfilterkernels.h).
+ * All implementations give bit identical results.
+ *
+ * Each SIMD implementation lives in its own translation unit compiled with the corresponding
+ * compiler flags. These units must not use anything else than intrinsics.
+ */
+class SDRBASE_API AudioMixerKernels
+{
+public:
+    enum Kernel
+    {
+        KernelScalar,
+        KernelSSE2,
+        KernelAVX2,
+        KernelNEON,
+        KernelEnd
+    };
+
+    static const int m_gainShift = 14;            //!< gains are fixed point with this many fractional bits
+    static const qint32 m_unityGain = 1<<14;
+    static const qint32 m_maxGain = 32767;        //!< gains must fit in 16 bits: just below 2.0
+
+    /**
+     * Add stereo samples with gains to the interleaved left/right accumulator:
+     * acc[2k] += round(in[k].l * gainL / 2^14), acc[2k+1] += round(in[k].r * gainR / 2^14)
+     * with 0 <= gain <= m_maxGain.
+     */
+    typedef void (*Mix)(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR);
+    /** Convert accumulated values to 16 bit with saturation */
+    typedef void (*Pack)(const qint32 *acc, qint16 *out, int nbValues);
+
+    static Mix mix;
+    static Pack pack;
+
+    static bool isSupported(Kernel kernel); //!< compiled in and supported by the CPU
+    static bool setKernel(Kernel kernel);   //!< use this implementation. Returns false and leaves the current one if not supported.
+    static Kernel getKernel() { return m_kernel; }
+    static const char *getKernelName(Kernel kernel);
+
+private:
+    static Kernel m_kernel;
+
+    static Kernel selectBest();
+
+    static void mixScalar(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR);
+    static void packScalar(const qint32 *acc, qint16 *out, int nbValues);
+    static void mixSSE2(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR);
+    static void packSSE2(const qint32 *acc, qint16 *out, int nbValues);
+    static void mixAVX2(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR);
+    static void packAVX2(const qint32 *acc, qint16 *out, int nbValues);
+    static void mixNEON(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR);
+    static void packNEON(const qint32 *acc, qint16 *out, int nbValues);
+};
+
+#endif // SDRBASE_AUDIO_AUDIOMIXERKERNELS_H_
@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with AVX2 enabled. Only intrinsics here (see audiomixerkernels.h).
+
+#include <immintrin.h>
+
+#include "audiomixerkernels.h"
+
+void AudioMixerKernels::mixAVX2(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR)
+{
+    const __m256i gains = _mm256_set_epi32(gainR, gainL, gainR, gainL, gainR, gainL, gainR, gainL);
+    const __m256i round = _mm256_set1_epi32(1 << (m_gainShift - 1));
+    int k = 0;
+
+    for (; k + 8 <= nbSamples; k += 8)
+    {
+        __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) &in[k]));
+        __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) &in[k+4]));
+        lo = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(lo, gains), round), m_gainShift);
+        hi = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(hi, gains), round), m_gainShift);
+        _mm256_storeu_si256((__m256i*) &acc[2*k],   _mm256_add_epi32(_mm256_loadu_si256((const __m256i*) &acc[2*k]), lo));
+        _mm256_storeu_si256((__m256i*) &acc[2*k+8], _mm256_add_epi32(_mm256_loadu_si256((const __m256i*) &acc[2*k+8]), hi));
+    }
+
+    mixScalar(&acc[2*k], &in[k], nbSamples - k, gainL, gainR);
+}
+
+void AudioMixerKernels::packAVX2(const qint32 *acc, qint16 *out, int nbValues)
+{
+    int k = 0;
+
+    for (; k + 16 <= nbValues; k += 16)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i*) &acc[k]);
+        __m256i b = _mm256_loadu_si256((const __m256i*) &acc[k+8]);
+        // packs works within 128 bit lanes: put the 64 bit quarters back in order
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xD8);
+        _mm256_storeu_si256((__m256i*) &out[k], p);
+    }
+
+    packScalar(&acc[k], &out[k], nbValues - k);
+}
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with NEON enabled. Only intrinsics here (see audiomixerkernels.h).
+
+#include <arm_neon.h>
+
+#include "audiomixerkernels.h"
+
+void AudioMixerKernels::mixNEON(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR)
+{
+    const int32_t g[4] = {gainL, gainR, gainL, gainR};
+    const int32x4_t gains = vld1q_s32(g);
+    int k = 0;
+
+    for (; k + 4 <= nbSamples; k += 4)
+    {
+        int16x8_t x = vld1q_s16((const int16_t*) &in[k]);
+        // rounding shift right: same as adding half and shifting
+        int32x4_t lo = vrshrq_n_s32(vmulq_s32(vmovl_s16(vget_low_s16(x)), gains), m_gainShift);
+        int32x4_t hi = vrshrq_n_s32(vmulq_s32(vmovl_s16(vget_high_s16(x)), gains), m_gainShift);
+        vst1q_s32(&acc[2*k],   vaddq_s32(vld1q_s32(&acc[2*k]), lo));
+        vst1q_s32(&acc[2*k+4], vaddq_s32(vld1q_s32(&acc[2*k+4]), hi));
+    }
+
+    mixScalar(&acc[2*k], &in[k], nbSamples - k, gainL, gainR);
+}
+
+void AudioMixerKernels::packNEON(const qint32 *acc, qint16 *out, int nbValues)
+{
+    int k = 0;
+
+    for (; k + 8 <= nbValues; k += 8)
+    {
+        int16x8_t p = vcombine_s16(vqmovn_s32(vld1q_s32(&acc[k])), vqmovn_s32(vld1q_s32(&acc[k+4])));
+        vst1q_s16(&out[k], p);
+    }
+
+    packScalar(&acc[k], &out[k], nbValues - k);
+}
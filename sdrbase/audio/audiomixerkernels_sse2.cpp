@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with SSE2 enabled. Only intrinsics here (see audiomixerkernels.h).
+
+#include <emmintrin.h>
+
+#include "audiomixerkernels.h"
+
+void AudioMixerKernels::mixSSE2(qint32 *acc, const AudioSample *in, int nbSamples, qint32 gainL, qint32 gainR)
+{
+    // samples interleaved with zeros so that each 32 bit product is l*gainL or r*gainR alone
+    const __m128i gains = _mm_set_epi16(0, gainR, 0, gainL, 0, gainR, 0, gainL);
+    const __m128i round = _mm_set1_epi32(1 << (m_gainShift - 1));
+    const __m128i zero = _mm_setzero_si128();
+    int k = 0;
+
+    for (; k + 4 <= nbSamples; k += 4)
+    {
+        __m128i x = _mm_loadu_si128((const __m128i*) &in[k]);
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(x, zero), gains);
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(x, zero), gains);
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, round), m_gainShift);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, round), m_gainShift);
+        _mm_storeu_si128((__m128i*) &acc[2*k],   _mm_add_epi32(_mm_loadu_si128((const __m128i*) &acc[2*k]), lo));
+        _mm_storeu_si128((__m128i*) &acc[2*k+4], _mm_add_epi32(_mm_loadu_si128((const __m128i*) &acc[2*k+4]), hi));
+    }
+
+    mixScalar(&acc[2*k], &in[k], nbSamples - k, gainL, gainR);
+}
+
+void AudioMixerKernels::packSSE2(const qint32 *acc, qint16 *out, int nbValues)
+{
+    int k = 0;
+
+    for (; k + 8 <= nbValues; k += 8)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*) &acc[k]);
+        __m128i b = _mm_loadu_si128((const __m128i*) &acc[k+4]);
+        _mm_storeu_si128((__m128i*) &out[k], _mm_packs_epi32(a, b));
+    }
+
+    packScalar(&acc[k], &out[k], nbValues - k);
+}
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "audionetsender.h"
+
+AudioNetSender *AudioNetSender::instance()
+{
+    static AudioNetSender inst;
+    return &inst;
+}
+
+AudioNetSender::AudioNetSender() :
+    m_running(false),
+    m_nbSinks(0),
+    m_nbDropped(0),
+    m_fillIndex(0),
+    m_nbQueued(0)
+{
+    m_queues[0].resize(m_queueSize);
+    m_queues[1].resize(m_queueSize);
+    m_batchBuffer = new char[UDPBatchSocket::m_maxBatchSize * m_maxDatagramSize];
+}
+
+AudioNetSender::~AudioNetSender()
+{
+    stopWork();
+    delete[] m_batchBuffer;
+}
+
+void AudioNetSender::addSink()
+{
+    QMutexLocker mutexLocker(&m_startWaitMutex);
+    m_nbSinks++;
+
+    if (!m_running) { // first sink or the socket could not be opened before
+        startWork();
+    }
+}
+
+void AudioNetSender::removeSink()
+{
+    QMutexLocker mutexLocker(&m_startWaitMutex);
+
+    if ((m_nbSinks > 0) && (--m_nbSinks == 0)) {
+        stopWork();
+    }
+}
+
+void AudioNetSender::startWork()
+{
+    if (!m_socket.open())
+    {
+        qWarning("AudioNetSender::startWork: cannot open socket");
+        return;
+    }
+
+    m_socket.setBufferSizes(1<<20, 0);
+    start();
+
+    while (!m_running) {
+        m_startWaiter.wait(&m_startWaitMutex, 100);
+    }
+
+    qDebug("AudioNetSender::startWork: %s", m_socket.isBatching() ? "batched send" : "one datagram per call");
+}
+
+void AudioNetSender::stopWork()
+{
+    if (m_running)
+    {
+        m_mutex.lock();
+        m_running = false;
+        m_dataWaiter.wakeAll();
+        m_mutex.unlock();
+        wait();
+    }
+
+    m_socket.close();
+    m_nbQueued = 0;
+}
+
+bool AudioNetSender::send(const char *data, int size, const QHostAddress& address, quint16 port)
+{
+    if ((size <= 0) || (size > m_maxDatagramSize)) {
+        return false;
+    }
+
+    if (!m_running) {
+        retryStart();
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_running || (m_nbQueued == m_queueSize))
+    {
+        m_nbDropped++;
+        return false;
+    }
+
+    Datagram& datagram = m_queues[m_fillIndex][m_nbQueued++];
+    datagram.m_address = address;
+    datagram.m_port = port;
+    datagram.m_size = size;
+    std::copy(data, data + size, datagram.m_data);
+
+    if (m_nbQueued == 1) {
+        m_dataWaiter.wakeOne();
+    }
+
+    return true;
+}
+
+void AudioNetSender::retryStart()
+{
+    // do not block the audio thread of the sink while another one adds or removes itself
+    if (!m_startWaitMutex.tryLock()) {
+        return;
+    }
+
+    if (!m_running && (m_nbSinks > 0) && (!m_retryTimer.isValid() || m_retryTimer.elapsed() > 1000))
+    {
+        m_retryTimer.start();
+        startWork();
+    }
+
+    m_startWaitMutex.unlock();
+}
+
+void AudioNetSender::run()
+{
+    qDebug("AudioNetSender::run: begin");
+    m_startWaitMutex.lock();
+    m_running = true;
+    m_startWaiter.wakeAll();
+    m_startWaitMutex.unlock();
+
+    m_mutex.lock();
+
+    while (m_running)
+    {
+        if (m_nbQueued == 0)
+        {
+            m_dataWaiter.wait(&m_mutex, 100);
+            continue;
+        }
+
+        // swap queues so that the sinks can go on while this one is sent
+        int sendIndex = m_fillIndex;
+        int nbDatagrams = m_nbQueued;
+        m_fillIndex ^= 1;
+        m_nbQueued = 0;
+        m_mutex.unlock();
+
+        sendQueue(m_queues[sendIndex], nbDatagrams);
+
+        m_mutex.lock();
+    }
+
+    m_mutex.unlock();
+    qDebug("AudioNetSender::run: end");
+}
+
+void AudioNetSender::sendQueue(const std::vector<Datagram>& queue, int nbDatagrams)
+{
+    int i = 0;
+
+    while (i < nbDatagrams)
+    {
+        // gather the run of datagrams with the same size and destination
+        const Datagram& first = queue[i];
+        int runLength = 0;
+
+        while ((i + runLength < nbDatagrams)
+            && (runLength < UDPBatchSocket::m_maxBatchSize)
+            && (queue[i + runLength].m_size == first.m_size)
+            && (queue[i + runLength].m_port == first.m_port)
+            && (queue[i + runLength].m_address == first.m_address))
+        {
+            const Datagram& datagram = queue[i + runLength];
+            std::copy(datagram.m_data, datagram.m_data + datagram.m_size, &m_batchBuffer[runLength * first.m_size]);
+            runLength++;
+        }
+
+        if (m_socket.send(m_batchBuffer, first.m_size, runLength, first.m_address, first.m_port) < 0) {
+            qWarning("AudioNetSender::sendQueue: cannot send to %s:%u", qPrintable(first.m_address.toString()), first.m_port);
+        }
+
+        i += runLength;
+    }
+}
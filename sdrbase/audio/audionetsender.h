@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_AUDIO_AUDIONETSENDER_H_
+#define SDRBASE_AUDIO_AUDIONETSENDER_H_
+
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QHostAddress>
+
+#include "util/udpbatchsocket.h"
+#include "export.h"
+
+/**
+ * Network thread shared by all the audio network sinks for their plain UDP output.
+ * Sinks queue complete datagrams from their audio thread and return at once. The thread sends
+ * them with one UDPBatchSocket so that runs of datagrams of the same size to the same destination
+ * go out in a single system call. The thread runs while at least one sink is registered.
+ * If the socket cannot be opened it is tried again on the next sink or, at most once a second, on the next datagram.
+ */
+class SDRBASE_API AudioNetSender : public QThread
+{
+    Q_OBJECT
+public:
+    static const int m_maxDatagramSize = 1024; //!< larger datagrams are refused
+    static const int m_queueSize = 512;        //!< datagrams pending across all sinks. Newer datagrams are dropped when full
+
+    static AudioNetSender *instance();
+
+    void addSink();    //!< starts the thread with the first sink or if it is not running yet
+    void removeSink(); //!< stops the thread with the last sink
+    bool send(const char *data, int size, const QHostAddress& address, quint16 port); //!< false if the datagram is dropped
+    quint64 getNbDropped() const { return m_nbDropped; }
+
+private:
+    struct Datagram
+    {
+        QHostAddress m_address;
+        quint16 m_port;
+        int m_size;
+        char m_data[m_maxDatagramSize];
+    };
+
+    QMutex m_mutex;
+    QWaitCondition m_dataWaiter;
+    QMutex m_startWaitMutex;
+    QWaitCondition m_startWaiter;
+    volatile bool m_running;
+    int m_nbSinks;
+    quint64 m_nbDropped;
+    QElapsedTimer m_retryTimer;        //!< last attempt to start the thread from send
+
+    std::vector<Datagram> m_queues[2]; //!< filled by the sinks and sent by the thread alternately
+    int m_fillIndex;                   //!< queue being filled
+    int m_nbQueued;                    //!< datagrams in the queue being filled
+    UDPBatchSocket m_socket;
+    char *m_batchBuffer;               //!< datagrams of a run laid out contiguously for the socket
+
+    AudioNetSender();
+    ~AudioNetSender();
+    void startWork();
+    void stopWork();
+    void retryStart();
+    void run();
+    void sendQueue(const std::vector<Datagram>& queue, int nbDatagrams);
+};
+
+#endif // SDRBASE_AUDIO_AUDIONETSENDER_H_
@@ -40,9 +40,9 @@ AudioNetSink::AudioNetSink(QObject *parent) :
     m_port(9998)
 {
     std::fill(m_data, m_data+m_dataBlockSize, 0);
-    std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
-    m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
+    std::fill(m_codecIn, m_codecIn+m_codecBlockSize, 0);
     m_udpSocket = new QUdpSocket(parent);
+    AudioNetSender::instance()->addSink();
 }
 
 AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
@@ -59,14 +59,16 @@ AudioNetSink::AudioNetSink(QObject *parent, int sampleRate, bool stereo) :
     m_port(9998)
 {
     std::fill(m_data, m_data+m_dataBlockSize, 0);
-    std::fill(m_opusIn, m_opusIn+m_opusBlockSize, 0);
-    m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
+    std::fill(m_codecIn, m_codecIn+m_codecBlockSize, 0);
     m_udpSocket = new QUdpSocket(parent);
     m_rtpBufferAudio = new RTPSink(m_udpSocket, sampleRate, stereo);
+    AudioNetSender::instance()->addSink();
 }
 
 AudioNetSink::~AudioNetSink()
 {
+    AudioNetSender::instance()->removeSink();
+
     if (m_rtpBufferAudio) {
         delete m_rtpBufferAudio;
     }
@@ -81,6 +83,8 @@ bool AudioNetSink::isRTPCapable() const
 
 bool AudioNetSink::selectType(SinkType type)
 {
+    SinkType oldType = m_type;
+
     if (type == SinkUDP)
     {
         m_type = SinkUDP;
@@ -90,6 +94,10 @@ bool AudioNetSink::selectType(SinkType type)
         m_type = SinkRTP;
     }
 
+    if (m_type != oldType) {
+        setNewCodecData(); // G722 frame size depends on the type
+    }
+
     return true;
 }
 
@@ -173,17 +181,20 @@ void AudioNetSink::setNewCodecData()
     {
         m_codecInputSize = m_sampleRate / (m_decimation * 50); // 20ms = 1/50s - size is per channel
         m_codecInputSize = m_codecInputSize > 960 ? 960 : m_codecInputSize; // hard limit of 48 kS/s
-        m_codecRatio = (m_sampleRate / m_decimation) / (AudioOpus::m_bitrate / 8); // compressor ratio
         qDebug() << "AudioNetSink::setNewCodecData: CodecOpus:"
             << " m_codecInputSize: " << m_codecInputSize
-            << " m_codecRatio: " << m_codecRatio
             << " Fs: " << m_sampleRate/m_decimation
             << " stereo: " << m_stereo;
         m_opus.setEncoder(m_sampleRate/m_decimation, m_stereo ? 2 : 1);
-        m_codecInputIndex = 0;
-        m_bufferIndex = 0;
+    }
+    else if (m_codec == CodecG722)
+    {
+        // a whole UDP datagram (2 samples per byte) or a 20ms RTP packet
+        m_codecInputSize = m_type == SinkUDP ? 2*m_udpBlockSize : m_g722FrameSize;
     }
 
+    m_codecInputIndex = 0;
+    m_bufferIndex = 0;
     setDecimationFilters();
 }
 
@@ -196,292 +207,240 @@ void AudioNetSink::setDecimationFilters()
     case CodecPCMA:
     case CodecPCMU:
         m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 3300.0, 300.0);
+        m_audioFilterR.setDecimFilters(m_sampleRate, decimatedSampleRate, 3300.0, 300.0);
         break;
     case CodecG722:
         m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 7000.0, 50.0);
+        m_audioFilterR.setDecimFilters(m_sampleRate, decimatedSampleRate, 7000.0, 50.0);
         break;
     case CodecOpus:
     case CodecL8:
     case CodecL16:
     default:
         m_audioFilter.setDecimFilters(m_sampleRate, decimatedSampleRate, 0.45*decimatedSampleRate, 50.0);
+        m_audioFilterR.setDecimFilters(m_sampleRate, decimatedSampleRate, 0.45*decimatedSampleRate, 50.0);
         break;
     }
 }
 
-void AudioNetSink::write(qint16 isample)
+void AudioNetSink::write(qint16 sample)
 {
-    qint16& sample = isample;
+    write(&sample, 1);
+}
+
+void AudioNetSink::write(qint16 lSample, qint16 rSample)
+{
+    AudioSample sample;
+    sample.l = lSample;
+    sample.r = rSample;
+    write(&sample, 1);
+}
 
-    if (m_decimation > 1)
+void AudioNetSink::write(const qint16 *samples, int nbSamples)
+{
+    while (nbSamples > 0)
     {
-        float lpSample = m_audioFilter.run(sample / 32768.0f);
+        int chunkSize = nbSamples < m_chunkSize ? nbSamples : m_chunkSize;
 
-        if (m_decimationCount >= m_decimation - 1)
-        {
-            sample = lpSample * 32768.0f;
-            m_decimationCount = 0;
-        }
-        else
-        {
-            m_decimationCount++;
-            return;
+        if (m_decimation > 1) {
+            writeChunk(m_decimatedMono, decimate(samples, chunkSize));
+        } else {
+            writeChunk(samples, chunkSize);
         }
+
+        samples += chunkSize;
+        nbSamples -= chunkSize;
     }
+}
 
-    if (m_type == SinkUDP)
+void AudioNetSink::write(const AudioSample *samples, int nbSamples)
+{
+    while (nbSamples > 0)
     {
-        if (m_codec == CodecG722)
-        {
-            if (m_bufferIndex >= 2*m_udpBlockSize)
-            {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-                m_bufferIndex = 0;
-            }
-        }
-        else
-        {
-            if (m_bufferIndex >= m_udpBlockSize)
-            {
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-                m_bufferIndex = 0;
-            }
-        }
+        int chunkSize = nbSamples < m_chunkSize ? nbSamples : m_chunkSize;
 
-        switch(m_codec)
-        {
-        case CodecPCMA:
-        case CodecPCMU:
-        {
-            qint8 *p = (qint8*) &m_data[m_bufferIndex];
-            *p = m_audioCompressor.compress8(sample);
-            m_bufferIndex += sizeof(qint8);
+        if (m_decimation > 1) {
+            writeChunk(m_decimatedStereo, decimate(samples, chunkSize));
+        } else {
+            writeChunk(samples, chunkSize);
         }
-            break;
-        case CodecL8:
-        {
-            qint8 *p = (qint8*) &m_data[m_bufferIndex];
-            *p = sample / 256;
-            m_bufferIndex += sizeof(qint8);
-        }
-            break;
-        case CodecG722:
-        {
-            qint16 *p = (qint16*) &m_data[m_udpBlockSize + 2*m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += 1;
 
-            if (m_bufferIndex == 2*m_udpBlockSize) {
-                m_g722.encode((uint8_t *) m_data, (const int16_t*) &m_data[m_udpBlockSize], 2*m_udpBlockSize);
-            }
-        }
-            break;
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
-                m_codecInputIndex = 0;
-            }
+        samples += chunkSize;
+        nbSamples -= chunkSize;
+    }
+}
 
-            m_opusIn[m_codecInputIndex++] = sample;
-        }
-            break;
-        case CodecL16:
-        default:
-        {
-            qint16 *p = (qint16*) &m_data[m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += sizeof(qint16);
-        }
-            break;
-        }
+int AudioNetSink::decimate(const qint16 *samples, int nbSamples)
+{
+    for (int i = 0; i < nbSamples; i++) {
+        m_filterIn[0][i] = samples[i] / 32768.0f;
+    }
+
+    m_audioFilter.run(m_filterIn[0], m_filterOut[0], nbSamples);
+    int nbOut = 0;
+
+    // the filter runs on all samples but only every m_decimation th output is kept
+    for (int i = m_decimation - 1 - m_decimationCount; i < nbSamples; i += m_decimation) {
+        m_decimatedMono[nbOut++] = m_filterOut[0][i] * 32768.0f;
     }
-    else if (m_type == SinkRTP)
+
+    m_decimationCount = (m_decimationCount + nbSamples) % m_decimation;
+    return nbOut;
+}
+
+int AudioNetSink::decimate(const AudioSample *samples, int nbSamples)
+{
+    for (int i = 0; i < nbSamples; i++)
     {
-        switch(m_codec)
-        {
-        case CodecPCMA:
-        case CodecPCMU:
-        {
-            qint8 p = m_audioCompressor.compress8(sample);
-            m_rtpBufferAudio->write((uint8_t *) &p);
-        }
-            break;
-        case CodecL8:
-        {
-            qint8 p = sample / 256;
-            m_rtpBufferAudio->write((uint8_t *) &p);
-        }
-            break;
-        case CodecG722:
-        {
+        m_filterIn[0][i] = samples[i].l / 32768.0f;
+        m_filterIn[1][i] = samples[i].r / 32768.0f;
+    }
 
-            if (m_bufferIndex >= 2*m_g722BlockSize)
-            {
-                m_g722.encode((uint8_t *) m_data, (const int16_t*) &m_data[m_g722BlockSize], 2*m_g722BlockSize);
-                m_bufferIndex = 0;
-            }
+    m_audioFilter.runLP(m_filterIn[0], m_filterOut[0], nbSamples);
+    m_audioFilterR.runLP(m_filterIn[1], m_filterOut[1], nbSamples);
+    int nbOut = 0;
 
-            if (m_bufferIndex % 2 == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex/2]);
-            }
+    for (int i = m_decimation - 1 - m_decimationCount; i < nbSamples; i += m_decimation, nbOut++)
+    {
+        m_decimatedStereo[nbOut].l = m_filterOut[0][i] * 32768.0f;
+        m_decimatedStereo[nbOut].r = m_filterOut[1][i] * 32768.0f;
+    }
 
-            qint16 *p = (qint16*) &m_data[m_g722BlockSize + 2*m_bufferIndex];
-            *p = sample;
-            m_bufferIndex += 1;
-        }
-            break;
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus mono: unexpected output frame size: %d bytes", nbBytes);
-                }
-                m_bufferIndex = 0;
-                m_codecInputIndex = 0;
-            }
+    m_decimationCount = (m_decimationCount + nbSamples) % m_decimation;
+    return nbOut;
+}
 
-            if (m_codecInputIndex % m_codecRatio == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex++]);
-            }
+void AudioNetSink::writeChunk(const qint16 *samples, int nbSamples)
+{
+    uint8_t *bytes = (uint8_t *) m_data;
 
-            m_opusIn[m_codecInputIndex++] = sample;
+    switch (m_codec)
+    {
+    case CodecPCMA:
+    case CodecPCMU:
+        for (int i = 0; i < nbSamples; i++) {
+            bytes[i] = m_audioCompressor.compress8(samples[i]);
         }
-            break;
-        case CodecL16:
-        default:
-            m_rtpBufferAudio->write((uint8_t *) &sample);
-            break;
+        writeBytes(bytes, nbSamples, nbSamples);
+        break;
+    case CodecL8:
+        for (int i = 0; i < nbSamples; i++) {
+            bytes[i] = samples[i] / 256;
         }
+        writeBytes(bytes, nbSamples, nbSamples);
+        break;
+    case CodecG722:
+    case CodecOpus:
+        writeCodec(samples, nbSamples, 1);
+        break;
+    case CodecL16: // actually no codec
+    default:
+        writeBytes((const uint8_t *) samples, nbSamples * sizeof(qint16), nbSamples);
+        break;
     }
 }
 
-void AudioNetSink::write(qint16 ilSample, qint16 irSample)
+void AudioNetSink::writeChunk(const AudioSample *samples, int nbSamples)
 {
-    qint16& lSample = ilSample;
-    qint16& rSample = irSample;
+    uint8_t *bytes = (uint8_t *) m_data;
 
-    if (m_decimation > 1)
+    switch (m_codec)
     {
-        float lpLSample = m_audioFilter.runLP(lSample / 32768.0f);
-        float lpRSample = m_audioFilter.runLP(rSample / 32768.0f);
-
-        if (m_decimationCount >= m_decimation - 1)
-        {
-            lSample = lpLSample * 32768.0f;
-            rSample = lpRSample * 32768.0f;
-            m_decimationCount = 0;
-        }
-        else
+    case CodecPCMA:
+    case CodecPCMU:
+    case CodecG722:
+        break; // mono modes - do nothing
+    case CodecOpus:
+        writeCodec((const qint16 *) samples, nbSamples, 2);
+        break;
+    case CodecL8:
+        for (int i = 0; i < nbSamples; i++)
         {
-            m_decimationCount++;
-            return;
+            bytes[2*i]   = samples[i].l / 256;
+            bytes[2*i+1] = samples[i].r / 256;
         }
+        writeBytes(bytes, 2*nbSamples, 2*nbSamples);
+        break;
+    case CodecL16: // actually no codec
+    default:
+        writeBytes((const uint8_t *) samples, nbSamples * sizeof(AudioSample), nbSamples);
+        break;
     }
+}
 
-    if (m_type == SinkUDP)
+void AudioNetSink::writeCodec(const qint16 *samples, int nbSamples, int nbChannels)
+{
+    while (nbSamples > 0)
     {
-        if (m_bufferIndex >= m_udpBlockSize)
-        {
-            m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) m_udpBlockSize, m_address, m_port);
-            m_bufferIndex = 0;
+        int nbCopied = std::min(nbSamples, m_codecInputSize - m_codecInputIndex);
+        std::copy(samples, samples + nbCopied*nbChannels, &m_codecIn[m_codecInputIndex*nbChannels]);
+        m_codecInputIndex += nbCopied;
+        samples += nbCopied*nbChannels;
+        nbSamples -= nbCopied;
+
+        if (m_codecInputIndex < m_codecInputSize) {
+            break;
         }
 
-        switch(m_codec)
-        {
-        case CodecPCMA:
-        case CodecPCMU:
-        case CodecG722:
-            break; // mono modes - do nothing
-        case CodecOpus:
+        int nbBytes;
+        m_codecInputIndex = 0;
+
+        if (m_codec == CodecOpus)
         {
-            if (m_codecInputIndex == m_codecInputSize)
-            {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                nbBytes = nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes;
-                m_udpSocket->writeDatagram((const char*) m_data, (qint64 ) nbBytes, m_address, m_port);
-                m_codecInputIndex = 0;
-            }
+            nbBytes = m_opus.encode(m_codecInputSize, m_codecIn, (uint8_t *) m_data);
 
-            m_opusIn[2*m_codecInputIndex]   = lSample;
-            m_opusIn[2*m_codecInputIndex+1] = rSample;
-            m_codecInputIndex++;
+            if ((m_type == SinkRTP) && (nbBytes != AudioOpus::m_bitrate/400)) { // 8 bits for 1/50s (20ms)
+                qWarning("AudioNetSink::writeCodec: CodecOpus: unexpected output frame size: %d bytes", nbBytes);
+            }
         }
-            break;
-        case CodecL8:
+        else // G722
         {
-            qint8 *p = (qint8*) &m_data[m_bufferIndex];
-            *p = lSample / 256;
-            m_bufferIndex += sizeof(qint8);
-            p = (qint8*) &m_data[m_bufferIndex];
-            *p = rSample / 256;
-            m_bufferIndex += sizeof(qint8);
+            nbBytes = m_g722.encode((uint8_t *) m_data, m_codecIn, m_codecInputSize);
         }
-            break;
-        case CodecL16:
-        default:
-        {
-            qint16 *p = (qint16*) &m_data[m_bufferIndex];
-            *p = lSample;
-            m_bufferIndex += sizeof(qint16);
-            p = (qint16*) &m_data[m_bufferIndex];
-            *p = rSample;
-            m_bufferIndex += sizeof(qint16);
+
+        if (nbBytes <= 0) {
+            continue;
         }
-            break;
+
+        if (m_type == SinkUDP) {
+            sendUDP(m_data, nbBytes > m_udpBlockSize ? m_udpBlockSize : nbBytes);
+        } else if (m_rtpBufferAudio) {
+            m_rtpBufferAudio->write((const uint8_t *) m_data, nbBytes);
         }
     }
-    else if (m_type == SinkRTP)
+}
+
+void AudioNetSink::writeBytes(const uint8_t *bytes, int nbBytes, int nbSamples)
+{
+    if (m_type == SinkUDP)
     {
-        switch(m_codec)
+        while (nbBytes > 0)
         {
-        case CodecPCMA:
-        case CodecPCMU:
-        case CodecG722:
-            break; // mono modes - do nothing
-        case CodecOpus:
-        {
-            if (m_codecInputIndex == m_codecInputSize)
+            int nbCopied = std::min(nbBytes, (int) (m_udpBlockSize - m_bufferIndex));
+            std::copy(bytes, bytes + nbCopied, &m_udpData[m_bufferIndex]);
+            m_bufferIndex += nbCopied;
+            bytes += nbCopied;
+            nbBytes -= nbCopied;
+
+            if (m_bufferIndex == (unsigned int) m_udpBlockSize)
             {
-                int nbBytes = m_opus.encode(m_codecInputSize, m_opusIn, (uint8_t *) m_data);
-                if (nbBytes != AudioOpus::m_bitrate/400) { // 8 bits for 1/50s (20ms)
-                    qWarning("AudioNetSink::write: CodecOpus stereo: unexpected output frame size: %d bytes", nbBytes);
-                }
+                sendUDP(m_udpData, m_udpBlockSize);
                 m_bufferIndex = 0;
-                m_codecInputIndex = 0;
-            }
-
-            if (m_codecInputIndex % m_codecRatio == 0) {
-                m_rtpBufferAudio->write((uint8_t *) &m_data[m_bufferIndex++]);
             }
-
-            m_opusIn[2*m_codecInputIndex]   = lSample;
-            m_opusIn[2*m_codecInputIndex+1] = rSample;
-            m_codecInputIndex++;
-        }
-            break;
-        case CodecL8:
-        {
-            qint8 pl = lSample / 256;
-            qint8 pr = rSample / 256;
-            m_rtpBufferAudio->write((uint8_t *) &pl, (uint8_t *) &pr);
-        }
-            break;
-        case CodecL16:
-        default:
-            m_rtpBufferAudio->write((uint8_t *) &lSample, (uint8_t *) &rSample);
-            break;
         }
     }
+    else if (m_rtpBufferAudio)
+    {
+        m_rtpBufferAudio->write(bytes, nbSamples);
+    }
+}
+
+void AudioNetSink::sendUDP(const char *data, int size)
+{
+    AudioNetSender::instance()->send(data, size, m_address, m_port);
 }
 
 void AudioNetSink::moveToThread(QThread *thread)
 {
     m_udpSocket->moveToThread(thread);
 }
-
@@ -24,6 +24,7 @@
 #include "audiocompressor.h"
 #include "audiog722.h"
 #include "audioopus.h"
+#include "audionetsender.h"
 #include "export.h"
 
 #include <QObject>
@@ -34,6 +35,12 @@ class QUdpSocket;
 class RTPSink;
 class QThread;
 
+/**
+ * Copies audio to the network as plain UDP datagrams or RTP packets with optional decimation and encoding.
+ * Samples are best given in blocks: decimation filters and codecs then run on whole blocks, Opus and G722
+ * encode complete frames and plain UDP datagrams are handed over to the network thread shared by all sinks
+ * (AudioNetSender). RTP packets are sent by the RTP session from the calling thread.
+ */
 class SDRBASE_API AudioNetSink {
 public:
     typedef enum
@@ -64,6 +71,8 @@ public:
 
     void write(qint16 sample);
     void write(qint16 lSample, qint16 rSample);
+    void write(const qint16 *samples, int nbSamples);     //!< mono block
+    void write(const AudioSample *samples, int nbSamples); //!< stereo block
 
     bool isRTPCapable() const;
     bool selectType(SinkType type);
@@ -71,14 +80,22 @@ public:
     void moveToThread(QThread *thread);
 
     static const int m_udpBlockSize;
-    static const int m_dataBlockSize = 65536; // room for G722 conversion (64000 = 12800*5 largest to date)
-    static const int m_g722BlockSize = 12800; // number of resulting G722 bytes (80*20ms frames)
-    static const int m_opusBlockSize = 960*2; // provision for 20ms of 2 int16 channels at 48 kS/s
-    static const int m_opusOutputSize = 160;  // output frame: 20ms of 8 bit data @ 64 kbits/s = 160 bytes
+    static const int m_dataBlockSize = 4096;   // encoded or converted bytes of one processing chunk (>= AudioOpus::m_maxPacketSize)
+    static const int m_chunkSize = 1024;       // samples processed at once
+    static const int m_g722FrameSize = 320;    // G722 input samples encoded at once for RTP (20ms at 16 kS/s)
+    static const int m_codecBlockSize = 960*2; // provision for 20ms of 2 int16 channels at 48 kS/s
+    static const int m_opusOutputSize = 160;   // output frame: 20ms of 8 bit data @ 64 kbits/s = 160 bytes
 
 protected:
     void setNewCodecData();       // actions to take when changes affecting codec dependent data occurs
     void setDecimationFilters();  // set decimation filters limits depending on effective sample rate and codec
+    int decimate(const qint16 *samples, int nbSamples);      // decimates a mono chunk in m_decimatedMono
+    int decimate(const AudioSample *samples, int nbSamples); // decimates a stereo chunk in m_decimatedStereo
+    void writeChunk(const qint16 *samples, int nbSamples);
+    void writeChunk(const AudioSample *samples, int nbSamples);
+    void writeCodec(const qint16 *samples, int nbSamples, int nbChannels); // Opus and G722
+    void writeBytes(const uint8_t *bytes, int nbBytes, int nbSamples);    // formatted samples to UDP or RTP
+    void sendUDP(const char *data, int size);
 
     SinkType m_type;
     Codec m_codec;
@@ -87,17 +104,22 @@ protected:
     AudioCompressor m_audioCompressor;
     AudioG722 m_g722;
     AudioOpus m_opus;
-    AudioFilter m_audioFilter;
+    AudioFilter m_audioFilter;  // mono or left channel
+    AudioFilter m_audioFilterR; // right channel
     int m_sampleRate;
     bool m_stereo;
     uint32_t m_decimation;
     uint32_t m_decimationCount;
     char m_data[m_dataBlockSize];
-    int16_t m_opusIn[m_opusBlockSize];
-    int m_codecInputSize;  // codec input block size - for codecs with actual encoding (Opus only for now)
+    char m_udpData[AudioNetSender::m_maxDatagramSize]; // UDP datagram being filled
+    int16_t m_codecIn[m_codecBlockSize];
+    float m_filterIn[2][m_chunkSize];
+    float m_filterOut[2][m_chunkSize];
+    qint16 m_decimatedMono[m_chunkSize];
+    AudioSample m_decimatedStereo[m_chunkSize];
+    int m_codecInputSize;  // codec input block size per channel (Opus and G722)
     int m_codecInputIndex; // codec input block fill index
-    int m_codecRatio;      // codec compression ratio
-    unsigned int m_bufferIndex;
+    unsigned int m_bufferIndex; // UDP datagram fill index
     QHostAddress m_address;
     unsigned int m_port;
 };
@@ -23,6 +23,7 @@
 #include "audiooutput.h"
 #include "audiofifo.h"
 #include "audionetsink.h"
+#include "audiomixerkernels.h"
 
 AudioOutput::AudioOutput() :
 	m_mutex(QMutex::Recursive),
@@ -253,82 +254,47 @@ qint64 AudioOutput::readData(char* data, qint64 maxLen)
 	{
 		// use outputBuffer as temp - yes, one memcpy could be saved
 		unsigned int samples = (*it)->read((quint8*) data, samplesPerBuffer);
-		const qint16* src = (const qint16*) data;
-		std::vector<qint32>::iterator dst = m_mixBuffer.begin();
+		AudioMixerKernels::mix(&m_mixBuffer[0], (const AudioSample*) data, samples, AudioMixerKernels::m_unityGain, AudioMixerKernels::m_unityGain);
+	}
 
-//		if (samples != framesPerBuffer)
-//		{
-//            qDebug("AudioOutput::readData: read %d samples vs %d requested", samples, framesPerBuffer);
-//		}
+	// convert to int16 with saturation
 
-		for (unsigned int i = 0; i < samples; i++)
-		{
-			*dst += *src;
-			++src;
-			++dst;
-			*dst += *src;
-			++src;
-			++dst;
-		}
-    }
-	// convert to int16
+	AudioMixerKernels::pack(&m_mixBuffer[0], (qint16*) data, 2 * samplesPerBuffer);
 
-	//std::vector<qint32>::const_iterator src = m_mixBuffer.begin(); // Valgrind optim
-	qint16* dst = (qint16*) data;
-	qint32 sl, sr;
+	// copy to UDP in one block
 
-	for (unsigned int i = 0; i < samplesPerBuffer; i++)
+	if ((m_copyAudioToUdp) && (m_audioNetSink))
 	{
-		// left channel
-
-		//s = *src++; // Valgrind optim
-		sl = m_mixBuffer[2*i];
+		const AudioSample* samples = (const AudioSample*) data;
 
-		if(sl < -32768)
+		if (m_udpChannelMode == UDPChannelStereo)
 		{
-			sl = -32768;
+			m_audioNetSink->write(samples, samplesPerBuffer);
 		}
-		else if (sl > 32767)
-		{
-			sl = 32767;
-		}
-
-		*dst++ = sl;
-
-		// right channel
-
-		//s = *src++; // Valgrind optim
-		sr = m_mixBuffer[2*i + 1];
-
-		if(sr < -32768)
-		{
-			sr = -32768;
-		}
-		else if (sr > 32767)
-		{
-			sr = 32767;
-		}
-
-		*dst++ = sr;
-
-		if ((m_copyAudioToUdp) && (m_audioNetSink))
+		else
 		{
-	        switch (m_udpChannelMode)
-	        {
-            case UDPChannelStereo:
-                m_audioNetSink->write(sl, sr);
-                break;
-            case UDPChannelMixed:
-                m_audioNetSink->write((sl+sr)/2);
-                break;
-            case UDPChannelRight:
-                m_audioNetSink->write(sr);
-                break;
-	        case UDPChannelLeft:
-	        default:
-	            m_audioNetSink->write(sl);
-	            break;
-	        }
+			if (m_udpMonoBuffer.size() < samplesPerBuffer) {
+				m_udpMonoBuffer.resize(samplesPerBuffer);
+			}
+
+			for (unsigned int i = 0; i < samplesPerBuffer; i++)
+			{
+				switch (m_udpChannelMode)
+				{
+				case UDPChannelMixed:
+					m_udpMonoBuffer[i] = (samples[i].l + samples[i].r) / 2;
+					break;
+				case UDPChannelRight:
+					m_udpMonoBuffer[i] = samples[i].r;
+					break;
+				case UDPChannelLeft:
+				default:
+					m_udpMonoBuffer[i] = samples[i].l;
+					break;
+				}
+			}
+
+			m_audioNetSink->write(m_udpMonoBuffer.data(), samplesPerBuffer);
 		}
 	}
 
@@ -84,6 +84,7 @@ private:
 
 	std::list<AudioFifo*> m_audioFifos;
 	std::vector<qint32> m_mixBuffer;
+	std::vector<qint16> m_udpMonoBuffer; //!< mono samples copied to UDP
 
 	QAudioFormat m_audioFormat;
 
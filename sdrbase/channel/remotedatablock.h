@@ -26,6 +26,7 @@
 #define CHANNEL_REMOTEDATABLOCK_H_
 
 #include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 #include <algorithm>
 #include <QString>
@@ -34,6 +35,28 @@
 #define UDPSINKFEC_UDPSIZE 512
 #define UDPSINKFEC_NBORIGINALBLOCKS 128
 //#define UDPSINKFEC_NBTXBLOCKS 8
+#define UDPSINKFEC_MAXUDPSIZE 8972 // 9000 bytes jumbo frame minus IPv4 and UDP headers
+
+/**
+ * Protocol version found in the header of every block and in the meta data.
+ * Version 1 is the original protocol with 128 blocks of 512 bytes carrying raw samples per frame.
+ * Its fillers are zero hence the zero value. Version 2 re-encodes the same frames in blocks of
+ * configurable size with a choice of sample encodings (see RemoteFrameEncoder).
+ */
+enum RemoteProtocolVersion
+{
+    RemoteProtocolV1 = 0,
+    RemoteProtocolV2 = 2
+};
+
+enum RemoteSampleEncoding
+{
+    RemoteEncodingRaw = 0,    //!< samples as produced: 16 or 32 bit I and Q
+    RemoteEncodingPacked12,   //!< 12 bit I and Q in 3 bytes scaled by a power of two per block
+    RemoteEncodingPacked8,    //!< 8 bit I and Q scaled by a power of two per block
+    RemoteEncodingLossless,   //!< I and Q or their differences bit packed at the minimum width per block
+    RemoteEncodingEnd
+};
 
 #pragma pack(push, 1)
 struct RemoteMetaDataFEC
@@ -49,17 +72,27 @@ struct RemoteMetaDataFEC
     uint32_t m_tv_usec;           //!< 24 microseconds of timestamp at start time of super-frame processing
     uint32_t m_crc32;             //!< 28 CRC32 of the above
 
+    // zero in version 1 and not covered by the CRC so that version 1 receivers are not affected
+    uint8_t  m_version;           //!< 29 protocol version (RemoteProtocolVersion)
+    uint8_t  m_encoding;          //!< 30 sample encoding on the wire (RemoteSampleEncoding)
+    uint16_t m_blockSize;         //!< 32 size of blocks on the wire (UDP payload)
+
     bool operator==(const RemoteMetaDataFEC& rhs)
     {
-        // Only the first 6 fields are relevant
+        // Only the first 6 fields and the protocol fields are relevant
         return (m_centerFrequency == rhs.m_centerFrequency)
             && (m_sampleRate == rhs.m_sampleRate)
             && (m_sampleBytes == rhs.m_sampleBytes)
             && (m_sampleBits == rhs.m_sampleBits)
             && (m_nbOriginalBlocks == rhs.m_nbOriginalBlocks)
-            && (m_nbFECBlocks == rhs.m_nbFECBlocks);
+            && (m_nbFECBlocks == rhs.m_nbFECBlocks)
+            && (m_version == rhs.m_version)
+            && (m_encoding == rhs.m_encoding)
+            && (m_blockSize == rhs.m_blockSize);
     }
 
+    static int crcSize() { return offsetof(RemoteMetaDataFEC, m_crc32); } //!< number of bytes covered by the CRC
+
     void init()
     {
         m_centerFrequency = 0;
@@ -71,6 +104,9 @@ struct RemoteMetaDataFEC
         m_tv_sec = 0;
         m_tv_usec = 0;
         m_crc32 = 0;
+        m_version = RemoteProtocolV1;
+        m_encoding = RemoteEncodingRaw;
+        m_blockSize = 0;
     }
 };
 
@@ -78,10 +114,11 @@ struct RemoteHeader
 {
     uint16_t m_frameIndex;
     uint8_t  m_blockIndex;
-    uint8_t  m_sampleBytes; //!<  number of bytes per sample (2 or 4) for this block
+    uint8_t  m_sampleBytes; //!<  4 LSB: number of bytes per sample (2 or 4) for this block. 4 MSB: sample encoding (version 2)
     uint8_t  m_sampleBits;  //!<  number of bits per sample
-    uint8_t  m_filler;
-    uint16_t m_filler2;
+    uint8_t  m_version;     //!<  protocol version (filler in version 1)
+    uint8_t  m_nbOriginalBlocks; //!< version 2: number of original blocks in this frame (filler in version 1)
+    uint8_t  m_nbFECBlocks;      //!< version 2: number of FEC blocks in this frame (filler in version 1)
 
     void init()
     {
@@ -89,14 +126,16 @@ struct RemoteHeader
         m_blockIndex = 0;
         m_sampleBytes = 2;
         m_sampleBits = 16;
-        m_filler = 0;
-        m_filler2 = 0;
+        m_version = RemoteProtocolV1;
+        m_nbOriginalBlocks = 0;
+        m_nbFECBlocks = 0;
     }
 };
 
 static const int RemoteUdpSize = UDPSINKFEC_UDPSIZE;
 static const int RemoteNbOrginalBlocks = UDPSINKFEC_NBORIGINALBLOCKS;
 static const int RemoteNbBytesPerBlock = UDPSINKFEC_UDPSIZE - sizeof(RemoteHeader);
+static const int RemoteMaxUdpSize = UDPSINKFEC_MAXUDPSIZE;
 
 struct RemoteProtectedBlock
 {
@@ -129,6 +168,8 @@ struct RemoteTxControlBlock
     int m_txDelay;
     QString m_dataAddress;
     uint16_t m_dataPort;
+    int m_blockSize;      //!< size of blocks on the wire. Version 2 protocol if not RemoteUdpSize
+    int m_sampleEncoding; //!< RemoteSampleEncoding. Version 2 protocol if not raw
 
     RemoteTxControlBlock() {
         m_complete = false;
@@ -138,6 +179,8 @@ struct RemoteTxControlBlock
         m_txDelay = 100;
         m_dataAddress = "127.0.0.1";
         m_dataPort = 9090;
+        m_blockSize = RemoteUdpSize;
+        m_sampleEncoding = RemoteEncodingRaw;
     }
 };
 
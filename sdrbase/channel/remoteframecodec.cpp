@@ -0,0 +1,705 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <algorithm>
+#include <QDebug>
+
+#include "remoteframecodec.h"
+
+namespace {
+
+const int nbFrameValuesMax = (RemoteNbOrginalBlocks - 1) * RemoteNbBytesPerBlock / 2; // I and Q values in a frame of 16 bit samples
+const int losslessHeaderSize = 11; // mode, number of samples, first I and Q
+
+inline uint32_t zigzag(int32_t v) {
+    return ((uint32_t) v << 1) ^ (uint32_t) (v >> 31);
+}
+
+inline int32_t unzigzag(uint32_t v) {
+    return (int32_t) (v >> 1) ^ -(int32_t) (v & 1);
+}
+
+inline int bitWidth(uint32_t v)
+{
+    int w = 0;
+
+    while (v) {
+        v >>= 1;
+        w++;
+    }
+
+    return w;
+}
+
+inline void putI32(uint8_t *p, int32_t v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+inline int32_t getI32(const uint8_t *p) {
+    return (int32_t) (p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24));
+}
+
+/** Number of bits to right shift the values so that they fit in bits signed bits */
+int packingShift(const int32_t *values, int nbValues, int bits)
+{
+    int32_t maxValue = 0;
+    int32_t minValue = 0;
+
+    for (int i = 0; i < nbValues; i++)
+    {
+        maxValue = std::max(maxValue, values[i]);
+        minValue = std::min(minValue, values[i]);
+    }
+
+    int32_t limit = (1 << (bits - 1)) - 1;
+    int shift = 0;
+
+    while (((maxValue >> shift) > limit) || ((minValue >> shift) < -limit - 1)) {
+        shift++;
+    }
+
+    return shift;
+}
+
+inline int32_t packValue(int32_t v, int shift, int bits)
+{
+    int32_t limit = (1 << (bits - 1)) - 1;
+
+    if (shift > 0) {
+        v = (int32_t) (((int64_t) v + (1 << (shift - 1))) >> shift); // round
+    }
+
+    return v > limit ? limit : v < -limit - 1 ? -limit - 1 : v;
+}
+
+} // namespace
+
+RemoteFrameEncoder::RemoteFrameEncoder() :
+    m_blockSize(RemoteUdpSize),
+    m_encoding(RemoteEncodingRaw),
+    m_nbValues(0)
+{
+    m_cm256Valid = m_cm256.isInitialized();
+
+    if (!m_cm256Valid) {
+        qWarning("RemoteFrameEncoder::RemoteFrameEncoder: cannot initialize CM256 library");
+    }
+
+    m_datagrams.resize(256 * m_blockSize);
+    m_values.resize(nbFrameValuesMax);
+}
+
+void RemoteFrameEncoder::setBlockSize(int blockSize)
+{
+    m_blockSize = blockSize < RemoteUdpSize ? RemoteUdpSize : blockSize > RemoteMaxUdpSize ? RemoteMaxUdpSize : blockSize;
+    m_datagrams.resize(256 * m_blockSize);
+}
+
+uint8_t *RemoteFrameEncoder::newPayload(int blockIndex)
+{
+    if (blockIndex > 255 - 1) { // keep room for at least one FEC block
+        return nullptr;
+    }
+
+    uint8_t *p = payload(blockIndex);
+    memset(p, 0, payloadSize());
+    return p;
+}
+
+int RemoteFrameEncoder::encode(const RemoteSuperBlock *frame, uint16_t frameIndex, int nbFECBlocks)
+{
+    const RemoteMetaDataFEC *metaData = (const RemoteMetaDataFEC *) &frame[0].m_protectedBlock;
+    int sampleBytes = metaData->m_sampleBytes & 0x0F;
+
+    if ((sampleBytes != 2) && (sampleBytes != 4)) {
+        return 0;
+    }
+
+    // meta data block
+    uint8_t *p = newPayload(0);
+    memcpy(p, &frame[0].m_protectedBlock, sizeof(RemoteProtectedBlock));
+    RemoteMetaDataFEC *txMetaData = (RemoteMetaDataFEC *) p;
+    txMetaData->m_version = RemoteProtocolV2;
+    txMetaData->m_encoding = m_encoding;
+    txMetaData->m_blockSize = m_blockSize;
+
+    // sample blocks
+    int nbDataBlocks;
+
+    if (m_encoding == RemoteEncodingRaw)
+    {
+        nbDataBlocks = encodeRaw(frame);
+    }
+    else
+    {
+        int nbValues = (RemoteNbOrginalBlocks - 1) * RemoteNbBytesPerBlock / sampleBytes;
+
+        for (int ib = 1, k = 0; ib < RemoteNbOrginalBlocks; ib++)
+        {
+            const uint8_t *buf = frame[ib].m_protectedBlock.buf;
+
+            if (sampleBytes == 2)
+            {
+                for (int i = 0; i < RemoteNbBytesPerBlock/2; i++, k++) {
+                    m_values[k] = ((const int16_t *) buf)[i];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < RemoteNbBytesPerBlock/4; i++, k++) {
+                    m_values[k] = ((const int32_t *) buf)[i];
+                }
+            }
+        }
+
+        m_nbValues = nbValues;
+
+        if (m_encoding == RemoteEncodingPacked12) {
+            nbDataBlocks = encodePacked(12);
+        } else if (m_encoding == RemoteEncodingPacked8) {
+            nbDataBlocks = encodePacked(8);
+        } else {
+            nbDataBlocks = encodeLossless();
+        }
+    }
+
+    if (nbDataBlocks < 0)
+    {
+        qWarning("RemoteFrameEncoder::encode: frame does not fit in 255 blocks of %d bytes", m_blockSize);
+        return 0;
+    }
+
+    // FEC blocks scaled to keep the same protection ratio as with version 1 frames
+    int nbOriginal = nbDataBlocks + 1;
+    int nbRecovery = 0;
+
+    if ((nbFECBlocks > 0) && m_cm256Valid)
+    {
+        nbRecovery = (nbFECBlocks * nbOriginal + RemoteNbOrginalBlocks - 1) / RemoteNbOrginalBlocks;
+        nbRecovery = std::min(nbRecovery, 256 - nbOriginal);
+        CM256::cm256_encoder_params params;
+        params.BlockBytes = payloadSize();
+        params.OriginalCount = nbOriginal;
+        params.RecoveryCount = nbRecovery;
+        CM256::cm256_block descriptors[256];
+
+        for (int i = 0; i < nbOriginal; i++)
+        {
+            descriptors[i].Block = (void *) payload(i);
+            descriptors[i].Index = i;
+        }
+
+        m_fecBlocks.resize(nbRecovery * payloadSize());
+
+        if (m_cm256.cm256_encode(params, descriptors, m_fecBlocks.data()) == 0)
+        {
+            for (int i = 0; i < nbRecovery; i++) {
+                memcpy(payload(nbOriginal + i), &m_fecBlocks[i * payloadSize()], payloadSize());
+            }
+        }
+        else
+        {
+            qWarning("RemoteFrameEncoder::encode: CM256 encode failed. No transmission of FEC blocks.");
+            nbRecovery = 0;
+        }
+    }
+
+    for (int i = 0; i < nbOriginal + nbRecovery; i++)
+    {
+        RemoteHeader *header = (RemoteHeader *) &m_datagrams[i * m_blockSize];
+        header->m_frameIndex = frameIndex;
+        header->m_blockIndex = i;
+        header->m_sampleBytes = (m_encoding << 4) | sampleBytes;
+        header->m_sampleBits = frame[0].m_header.m_sampleBits;
+        header->m_version = RemoteProtocolV2;
+        header->m_nbOriginalBlocks = nbOriginal;
+        header->m_nbFECBlocks = nbRecovery;
+    }
+
+    return nbOriginal + nbRecovery;
+}
+
+int RemoteFrameEncoder::encodeRaw(const RemoteSuperBlock *frame)
+{
+    int ib = 1;     // source block
+    int is = 0;     // index in source block
+    int nbBlocks = 0;
+
+    while (ib < RemoteNbOrginalBlocks)
+    {
+        uint8_t *p = newPayload(nbBlocks + 1);
+
+        if (!p) {
+            return -1;
+        }
+
+        nbBlocks++;
+        int ip = 0;
+
+        while ((ip < payloadSize()) && (ib < RemoteNbOrginalBlocks))
+        {
+            int n = std::min(payloadSize() - ip, RemoteNbBytesPerBlock - is);
+            memcpy(&p[ip], &frame[ib].m_protectedBlock.buf[is], n);
+            ip += n;
+            is += n;
+
+            if (is == RemoteNbBytesPerBlock)
+            {
+                ib++;
+                is = 0;
+            }
+        }
+    }
+
+    return nbBlocks;
+}
+
+int RemoteFrameEncoder::encodePacked(int bits)
+{
+    int bytesPerSample = bits == 12 ? 3 : 2;
+    int samplesPerBlock = (payloadSize() - 1) / bytesPerSample;
+    int nbSamples = m_nbValues / 2;
+    int nbBlocks = 0;
+
+    for (int is = 0; is < nbSamples; is += samplesPerBlock)
+    {
+        uint8_t *p = newPayload(nbBlocks + 1);
+
+        if (!p) {
+            return -1;
+        }
+
+        nbBlocks++;
+        int n = std::min(samplesPerBlock, nbSamples - is);
+        const int32_t *values = &m_values[2*is];
+        int shift = packingShift(values, 2*n, bits);
+        *p++ = shift;
+
+        for (int i = 0; i < n; i++)
+        {
+            int32_t re = packValue(values[2*i], shift, bits);
+            int32_t im = packValue(values[2*i+1], shift, bits);
+
+            if (bits == 12)
+            {
+                *p++ = re & 0xFF;
+                *p++ = ((re >> 8) & 0x0F) | ((im & 0x0F) << 4);
+                *p++ = (im >> 4) & 0xFF;
+            }
+            else
+            {
+                *p++ = re & 0xFF;
+                *p++ = im & 0xFF;
+            }
+        }
+    }
+
+    return nbBlocks;
+}
+
+int RemoteFrameEncoder::encodeLossless()
+{
+    int nbSamples = m_nbValues / 2;
+    int payloadBits = 8 * (payloadSize() - losslessHeaderSize);
+    int nbBlocks = 0;
+    int is = 0;
+
+    while (is < nbSamples)
+    {
+        // grow the block while the samples following the first fit at the largest width needed so far
+        uint32_t orDelta = 0;
+        uint32_t orRaw = 0;
+        int n = 1;
+
+        while ((is + n < nbSamples) && (n < 65535))
+        {
+            const int32_t *v = &m_values[2*(is + n)];
+            uint32_t nextOrDelta = orDelta | zigzag(v[0] - v[-2]) | zigzag(v[1] - v[-1]);
+            uint32_t nextOrRaw = orRaw | zigzag(v[0]) | zigzag(v[1]);
+            int width = std::min(bitWidth(nextOrDelta), bitWidth(nextOrRaw));
+
+            if (2 * n * width > payloadBits) {
+                break;
+            }
+
+            orDelta = nextOrDelta;
+            orRaw = nextOrRaw;
+            n++;
+        }
+
+        uint8_t *p = newPayload(nbBlocks + 1);
+
+        if (!p) {
+            return -1;
+        }
+
+        nbBlocks++;
+        bool delta = bitWidth(orDelta) <= bitWidth(orRaw);
+        int width = delta ? bitWidth(orDelta) : bitWidth(orRaw);
+        const int32_t *v = &m_values[2*is];
+        p[0] = (delta ? 0x80 : 0) | width;
+        p[1] = n & 0xFF;
+        p[2] = (n >> 8) & 0xFF;
+        putI32(&p[3], v[0]);
+        putI32(&p[7], v[1]);
+        p += losslessHeaderSize;
+
+        uint64_t acc = 0;
+        int accBits = 0;
+
+        for (int i = 2; i < 2*n; i++)
+        {
+            uint32_t z = delta ? zigzag(v[i] - v[i-2]) : zigzag(v[i]);
+            acc |= (uint64_t) z << accBits;
+            accBits += width;
+
+            while (accBits >= 8)
+            {
+                *p++ = acc & 0xFF;
+                acc >>= 8;
+                accBits -= 8;
+            }
+        }
+
+        if (accBits > 0) {
+            *p = acc & 0xFF;
+        }
+
+        is += n;
+    }
+
+    return nbBlocks;
+}
+
+RemoteFrameDecoder::RemoteFrameDecoder() :
+    m_frameIndex(-1),
+    m_frameDone(true),
+    m_blockSize(0),
+    m_nbOriginal(0),
+    m_nbFEC(0),
+    m_encoding(0),
+    m_sampleBytes(0),
+    m_sampleBits(0),
+    m_nbReceived(0),
+    m_nbRecoveryReceived(0),
+    m_nbFramesLost(0)
+{
+    m_cm256Valid = m_cm256.isInitialized();
+
+    if (!m_cm256Valid) {
+        qWarning("RemoteFrameDecoder::RemoteFrameDecoder: cannot initialize CM256 library");
+    }
+
+    m_payloads.resize(256 * (RemoteMaxUdpSize - sizeof(RemoteHeader)));
+    m_values.resize(nbFrameValuesMax);
+    memset(m_received, 0, sizeof(m_received));
+    memset(m_frame, 0, sizeof(m_frame));
+}
+
+bool RemoteFrameDecoder::feed(const char *datagram, int size)
+{
+    if (!isVersion2(datagram, size) || (size < RemoteUdpSize) || (size > RemoteMaxUdpSize)) {
+        return false;
+    }
+
+    const RemoteHeader *header = (const RemoteHeader *) datagram;
+
+    if ((m_frameIndex < 0) || (header->m_frameIndex != m_frameIndex)) // new frame
+    {
+        if (!m_frameDone) {
+            m_nbFramesLost++;
+        }
+
+        m_frameIndex = header->m_frameIndex;
+        m_blockSize = size;
+        m_nbOriginal = header->m_nbOriginalBlocks;
+        m_nbFEC = header->m_nbFECBlocks;
+        m_encoding = header->m_sampleBytes >> 4;
+        m_sampleBytes = header->m_sampleBytes & 0x0F;
+        m_sampleBits = header->m_sampleBits;
+        m_nbReceived = 0;
+        m_nbRecoveryReceived = 0;
+        memset(m_received, 0, sizeof(m_received));
+        m_frameDone = (m_nbOriginal < 2)
+            || (m_nbOriginal + m_nbFEC > 256)
+            || ((m_sampleBytes != 2) && (m_sampleBytes != 4))
+            || (m_encoding >= RemoteEncodingEnd); // cannot be decoded: ignore the rest of the frame
+
+        if (m_frameDone)
+        {
+            qWarning("RemoteFrameDecoder::feed: invalid header for frame %d", m_frameIndex);
+            m_nbFramesLost++;
+            return false;
+        }
+    }
+
+    int blockIndex = header->m_blockIndex;
+
+    if (m_frameDone || (size != m_blockSize) || (blockIndex >= m_nbOriginal + m_nbFEC) || m_received[blockIndex]) {
+        return false;
+    }
+
+    int payloadSize = m_blockSize - sizeof(RemoteHeader);
+    uint8_t *payload = &m_payloads[m_nbReceived * payloadSize];
+    memcpy(payload, datagram + sizeof(RemoteHeader), payloadSize);
+    m_received[blockIndex] = true;
+    m_descriptors[m_nbReceived].Block = (void *) payload;
+    m_descriptors[m_nbReceived].Index = blockIndex;
+
+    if (blockIndex >= m_nbOriginal) {
+        m_nbRecoveryReceived++;
+    }
+
+    if (++m_nbReceived < m_nbOriginal) {
+        return false;
+    }
+
+    m_frameDone = true;
+
+    if (decodeFrame()) {
+        return true;
+    }
+
+    m_nbFramesLost++;
+    return false;
+}
+
+bool RemoteFrameDecoder::decodeFrame()
+{
+    int payloadSize = m_blockSize - sizeof(RemoteHeader);
+
+    if (m_nbRecoveryReceived > 0) // recover the missing original blocks in place of the FEC blocks
+    {
+        if (!m_cm256Valid) {
+            return false;
+        }
+
+        CM256::cm256_encoder_params params;
+        params.BlockBytes = payloadSize;
+        params.OriginalCount = m_nbOriginal;
+        params.RecoveryCount = m_nbFEC;
+
+        if (m_cm256.cm256_decode(params, m_descriptors))
+        {
+            qWarning("RemoteFrameDecoder::decodeFrame: CM256 decode failed for frame %d", m_frameIndex);
+            return false;
+        }
+    }
+
+    const uint8_t *blocks[256];
+    memset(blocks, 0, sizeof(blocks));
+
+    for (int i = 0; i < m_nbOriginal; i++)
+    {
+        if (m_descriptors[i].Index < m_nbOriginal) {
+            blocks[m_descriptors[i].Index] = (const uint8_t *) m_descriptors[i].Block;
+        }
+    }
+
+    for (int i = 0; i < m_nbOriginal; i++)
+    {
+        if (!blocks[i]) {
+            return false;
+        }
+    }
+
+    bool decoded;
+
+    if (m_encoding == RemoteEncodingRaw) {
+        decoded = decodeRaw(&blocks[1], payloadSize);
+    } else if (m_encoding == RemoteEncodingPacked12) {
+        decoded = decodePacked(&blocks[1], payloadSize, 12);
+    } else if (m_encoding == RemoteEncodingPacked8) {
+        decoded = decodePacked(&blocks[1], payloadSize, 8);
+    } else {
+        decoded = decodeLossless(&blocks[1], payloadSize);
+    }
+
+    if (!decoded)
+    {
+        qWarning("RemoteFrameDecoder::decodeFrame: inconsistent samples in frame %d", m_frameIndex);
+        return false;
+    }
+
+    // version 1 frame: meta data as sent then native samples
+    memcpy(&m_frame[0].m_protectedBlock, blocks[0], sizeof(RemoteProtectedBlock));
+
+    if (m_encoding != RemoteEncodingRaw)
+    {
+        for (int ib = 1, k = 0; ib < RemoteNbOrginalBlocks; ib++)
+        {
+            uint8_t *buf = m_frame[ib].m_protectedBlock.buf;
+
+            if (m_sampleBytes == 2)
+            {
+                for (int i = 0; i < RemoteNbBytesPerBlock/2; i++, k++) {
+                    ((int16_t *) buf)[i] = m_values[k];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < RemoteNbBytesPerBlock/4; i++, k++) {
+                    ((int32_t *) buf)[i] = m_values[k];
+                }
+            }
+        }
+    }
+
+    for (int ib = 0; ib < RemoteNbOrginalBlocks; ib++)
+    {
+        RemoteHeader& header = m_frame[ib].m_header;
+        memset(&header, 0, sizeof(RemoteHeader));
+        header.m_frameIndex = m_frameIndex;
+        header.m_blockIndex = ib;
+        header.m_sampleBytes = m_sampleBytes;
+        header.m_sampleBits = m_sampleBits;
+    }
+
+    return true;
+}
+
+bool RemoteFrameDecoder::decodeRaw(const uint8_t **blocks, int payloadSize)
+{
+    int nbBytes = (m_nbOriginal - 1) * payloadSize;
+
+    if (nbBytes < (RemoteNbOrginalBlocks - 1) * RemoteNbBytesPerBlock) {
+        return false;
+    }
+
+    int ib = 0; // source block
+    int is = 0; // index in source block
+
+    for (int i = 1; i < RemoteNbOrginalBlocks; i++)
+    {
+        int id = 0;
+
+        while (id < RemoteNbBytesPerBlock)
+        {
+            int n = std::min(RemoteNbBytesPerBlock - id, payloadSize - is);
+            memcpy(&m_frame[i].m_protectedBlock.buf[id], &blocks[ib][is], n);
+            id += n;
+            is += n;
+
+            if (is == payloadSize)
+            {
+                ib++;
+                is = 0;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool RemoteFrameDecoder::decodePacked(const uint8_t **blocks, int payloadSize, int bits)
+{
+    int bytesPerSample = bits == 12 ? 3 : 2;
+    int samplesPerBlock = (payloadSize - 1) / bytesPerSample;
+    int nbSamples = (RemoteNbOrginalBlocks - 1) * RemoteNbBytesPerBlock / (2 * m_sampleBytes);
+
+    if ((m_nbOriginal - 1) * samplesPerBlock < nbSamples) {
+        return false;
+    }
+
+    for (int ib = 0, is = 0; is < nbSamples; ib++, is += samplesPerBlock)
+    {
+        const uint8_t *p = blocks[ib];
+        int shift = *p++;
+
+        if (shift > 31 - bits + 1) {
+            return false;
+        }
+
+        int n = std::min(samplesPerBlock, nbSamples - is);
+        int32_t *values = &m_values[2*is];
+
+        for (int i = 0; i < n; i++)
+        {
+            int32_t re, im;
+
+            if (bits == 12)
+            {
+                re = (int16_t) ((((p[1] & 0x0F) << 8) | p[0]) << 4) >> 4;
+                im = (int16_t) (((p[2] << 8) | (p[1] & 0xF0))) >> 4;
+                p += 3;
+            }
+            else
+            {
+                re = (int8_t) p[0];
+                im = (int8_t) p[1];
+                p += 2;
+            }
+
+            values[2*i] = (int32_t) ((uint32_t) re << shift);
+            values[2*i+1] = (int32_t) ((uint32_t) im << shift);
+        }
+    }
+
+    return true;
+}
+
+bool RemoteFrameDecoder::decodeLossless(const uint8_t **blocks, int payloadSize)
+{
+    int nbSamples = (RemoteNbOrginalBlocks - 1) * RemoteNbBytesPerBlock / (2 * m_sampleBytes);
+    int payloadBits = 8 * (payloadSize - losslessHeaderSize);
+    int is = 0;
+
+    for (int ib = 0; (ib < m_nbOriginal - 1) && (is < nbSamples); ib++)
+    {
+        const uint8_t *p = blocks[ib];
+        bool delta = (p[0] & 0x80) != 0;
+        int width = p[0] & 0x3F;
+        int n = p[1] | (p[2] << 8);
+
+        if ((n == 0) || (is + n > nbSamples) || (width > 32) || (2 * (n - 1) * width > payloadBits)) {
+            return false;
+        }
+
+        int32_t *v = &m_values[2*is];
+        v[0] = getI32(&p[3]);
+        v[1] = getI32(&p[7]);
+        p += losslessHeaderSize;
+
+        uint64_t acc = 0;
+        int accBits = 0;
+        uint32_t mask = width == 32 ? 0xFFFFFFFF : (1U << width) - 1;
+
+        for (int i = 2; i < 2*n; i++)
+        {
+            while (accBits < width)
+            {
+                acc |= (uint64_t) *p++ << accBits;
+                accBits += 8;
+            }
+
+            int32_t z = unzigzag((uint32_t) acc & mask);
+            acc >>= width;
+            accBits -= width;
+            v[i] = delta ? (int32_t) ((uint32_t) v[i-2] + (uint32_t) z) : z;
+        }
+
+        is += n;
+    }
+
+    return is == nbSamples;
+}
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_CHANNEL_REMOTEFRAMECODEC_H_
+#define SDRBASE_CHANNEL_REMOTEFRAMECODEC_H_
+
+#include <vector>
+
+#include "cm256cc/cm256.h"
+#include "channel/remotedatablock.h"
+#include "export.h"
+
+/**
+ * Version 2 of the remote protocol is a transport layer for the version 1 frames: the meta data
+ * block followed by RemoteNbOrginalBlocks-1 blocks of raw samples are re-encoded in blocks of
+ * configurable size (up to jumbo frames) with a choice of sample encodings and protected by FEC.
+ * The receiver restores version 1 frames so that the buffering downstream is the same for both versions.
+ *
+ * Layout of a version 2 block: a RemoteHeader with m_version = RemoteProtocolV2, the number of original
+ * and FEC blocks of the frame and the encoding in the 4 MSB of m_sampleBytes then the payload.
+ * Block zero payload is the meta data. The other payloads are in the order of the samples:
+ *   - raw: sample bytes as they are in the version 1 frame
+ *   - packed 12 and 8 bits: 1 byte shift then I and Q right shifted by it on 12 (3 bytes per sample) or 8 bits
+ *   - lossless: 1 byte mode (bit 7: differences, bits 0..5: width), 2 bytes number of samples N,
+ *     first I and Q on 4 bytes each then the 2(N-1) zigzag coded values (or differences) on width bits
+ */
+class SDRBASE_API RemoteFrameEncoder
+{
+public:
+    RemoteFrameEncoder();
+
+    void setBlockSize(int blockSize); //!< UDP payload size. Clamped to [RemoteUdpSize, RemoteMaxUdpSize]
+    int getBlockSize() const { return m_blockSize; }
+    void setEncoding(RemoteSampleEncoding encoding) { m_encoding = encoding; }
+    RemoteSampleEncoding getEncoding() const { return m_encoding; }
+
+    /**
+     * Encode a version 1 frame adding about nbFECBlocks FEC blocks per RemoteNbOrginalBlocks blocks.
+     * Returns the number of blocks of getBlockSize() bytes available contiguously at getDatagrams() or 0 on error.
+     */
+    int encode(const RemoteSuperBlock *frame, uint16_t frameIndex, int nbFECBlocks);
+    const char *getDatagrams() const { return (const char *) m_datagrams.data(); }
+
+private:
+    int m_blockSize;
+    RemoteSampleEncoding m_encoding;
+    CM256 m_cm256;
+    bool m_cm256Valid;
+    std::vector<uint8_t> m_datagrams;
+    std::vector<uint8_t> m_fecBlocks;
+    std::vector<int32_t> m_values;
+    int m_nbValues;
+
+    uint8_t *payload(int blockIndex) { return &m_datagrams[blockIndex * m_blockSize + sizeof(RemoteHeader)]; }
+    int payloadSize() const { return m_blockSize - sizeof(RemoteHeader); }
+    uint8_t *newPayload(int blockIndex); //!< zeroed payload or nullptr if there are too many blocks
+    int encodeRaw(const RemoteSuperBlock *frame);
+    int encodePacked(int bits);
+    int encodeLossless();
+};
+
+class SDRBASE_API RemoteFrameDecoder
+{
+public:
+    RemoteFrameDecoder();
+
+    static bool isVersion2(const char *datagram, int size) {
+        return (size > (int) sizeof(RemoteHeader)) && (((const RemoteHeader *) datagram)->m_version == RemoteProtocolV2);
+    }
+
+    /**
+     * Feed a version 2 block. Returns true when it completes a frame that is then available as a
+     * version 1 frame of RemoteNbOrginalBlocks blocks from getFrame().
+     */
+    bool feed(const char *datagram, int size);
+    const RemoteSuperBlock *getFrame() const { return m_frame; }
+    int getNbRecoveryUsed() const { return m_nbRecoveryReceived; } //!< FEC blocks used for the last frame
+    uint32_t getNbFramesLost() const { return m_nbFramesLost; } //!< frames that could not be restored so far
+
+private:
+    CM256 m_cm256;
+    bool m_cm256Valid;
+    int m_frameIndex;
+    bool m_frameDone;
+    int m_blockSize;
+    int m_nbOriginal;
+    int m_nbFEC;
+    int m_encoding;
+    int m_sampleBytes;
+    int m_sampleBits;
+    int m_nbReceived;
+    int m_nbRecoveryReceived;
+    uint32_t m_nbFramesLost;
+    bool m_received[256];
+    CM256::cm256_block m_descriptors[256];
+    std::vector<uint8_t> m_payloads;
+    std::vector<int32_t> m_values;
+    RemoteSuperBlock m_frame[RemoteNbOrginalBlocks];
+
+    bool decodeFrame();
+    bool decodeRaw(const uint8_t **blocks, int payloadSize);
+    bool decodePacked(const uint8_t **blocks, int payloadSize, int bits);
+    bool decodeLossless(const uint8_t **blocks, int payloadSize);
+};
+
+#endif // SDRBASE_CHANNEL_REMOTEFRAMECODEC_H_
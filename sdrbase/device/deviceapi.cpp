@@ -135,6 +135,24 @@ void DeviceAPI::removeChannelSink(ThreadedBasebandSampleSink* sink, int streamIn
     }
 }
 
+bool DeviceAPI::addPFBChannelSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset)
+{
+    if (m_deviceSourceEngine)
+    {
+        m_deviceSourceEngine->addPFBChannelSink(sink, frequencyOffset);
+        return true;
+    }
+
+    return false; // only source engines have a filter bank
+}
+
+void DeviceAPI::removePFBChannelSink(ThreadedBasebandSampleSink* sink)
+{
+    if (m_deviceSourceEngine) {
+        m_deviceSourceEngine->removePFBChannelSink(sink);
+    }
+}
+
 void DeviceAPI::addChannelSource(ThreadedBasebandSampleSource* source, int streamIndex)
 {
     (void) streamIndex;
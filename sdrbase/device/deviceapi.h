@@ -78,6 +78,8 @@ public:
 
     void addChannelSink(ThreadedBasebandSampleSink* sink, int streamIndex = 0);        //!< Add a channel sink (Rx)
     void removeChannelSink(ThreadedBasebandSampleSink* sink, int streamIndex = 0);     //!< Remove a channel sink (Rx)
+    bool addPFBChannelSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset);  //!< Add or move a channel sink (Rx) fed by the shared filter bank sub-band nearest to the offset. False if the device has no filter bank
+    void removePFBChannelSink(ThreadedBasebandSampleSink* sink);                       //!< Remove a channel sink (Rx) fed by the shared filter bank
     void addChannelSource(ThreadedBasebandSampleSource* sink, int streamIndex = 0);    //!< Add a channel source (Tx)
     void removeChannelSource(ThreadedBasebandSampleSource* sink, int streamIndex = 0); //!< Remove a channel source (Tx)
 
@@ -152,6 +154,7 @@ public:
 
     DSPDeviceSourceEngine *getDeviceSourceEngine() { return m_deviceSourceEngine; }
     DSPDeviceSinkEngine *getDeviceSinkEngine() { return m_deviceSinkEngine; }
+    DSPDeviceMIMOEngine *getDeviceMIMOEngine() { return m_deviceMIMOEngine; }
 
     void addSourceBuddy(DeviceAPI* buddy);
     void addSinkBuddy(DeviceAPI* buddy);
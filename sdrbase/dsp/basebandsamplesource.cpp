@@ -57,15 +57,12 @@ void BasebandSampleSource::handleWriteToDeviceFifo(int nbSamples)
 
 void BasebandSampleSource::handleWriteToFifo(SampleSourceFifo *sampleFifo, int nbSamples)
 {
+    ProfileTimer writeTimer(m_writeProfile, nbSamples);
     SampleVector::iterator writeAt;
     sampleFifo->getWriteIterator(writeAt);
     pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
-
-    for (int i = 0; i < nbSamples; i++)
-    {
-        pull((*writeAt));
-        sampleFifo->bumpIndex(writeAt);
-    }
+    pull(writeAt, nbSamples);
+    sampleFifo->commitWrite(nbSamples);
 }
 
 
@@ -24,6 +24,7 @@
 #include "dsp/samplesourcefifo.h"
 #include "export.h"
 #include "util/messagequeue.h"
+#include "util/profiler.h"
 
 class Message;
 
@@ -36,6 +37,14 @@ public:
 	virtual void start() = 0;
 	virtual void stop() = 0;
 	virtual void pull(Sample& sample) = 0;
+    /** Pull a block of samples. Default implementation loops over the per sample pull.
+     *  Override it to amortize virtual calls and locking over the whole block. */
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples)
+    {
+        for (unsigned int i = 0; i < nbSamples; i++, ++begin) {
+            pull(*begin);
+        }
+    }
     virtual void pullAudio(int nbSamples) { (void) nbSamples; }
 
     /** direct feeding of sample source FIFO */
@@ -44,12 +53,8 @@ public:
 	    SampleVector::iterator writeAt;
 	    sampleFifo->getWriteIterator(writeAt);
 	    pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
-
-	    for (int i = 0; i < nbSamples; i++)
-	    {
-	        pull((*writeAt));
-	        sampleFifo->bumpIndex(writeAt);
-	    }
+	    pull(writeAt, nbSamples);
+	    sampleFifo->commitWrite(nbSamples);
 	}
 
 	SampleSourceFifo& getSampleSourceFifo() { return m_sampleFifo; }
@@ -60,12 +65,14 @@ public:
     virtual void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
     MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
     void setDeviceSampleSourceFifo(SampleSourceFifo *deviceSampleFifo);
+    ProfileCounter& getWriteProfile() { return m_writeProfile; }
 
 protected:
 	MessageQueue m_inputMessageQueue;     //!< Queue for asynchronous inbound communication
     MessageQueue *m_guiMessageQueue;      //!< Input message queue to the GUI
 	SampleSourceFifo m_sampleFifo;        //!< Internal FIFO for multi-channel processing
 	SampleSourceFifo *m_deviceSampleFifo; //!< Reference to the device FIFO for single channel processing
+	ProfileCounter m_writeProfile;        //!< FIFO write handler runs
 
 	void handleWriteToFifo(SampleSourceFifo *sampleFifo, int nbSamples);
 
@@ -27,6 +27,8 @@
 #include "util/messagequeue.h"
 #include "export.h"
 
+class FileRecord;
+
 namespace SWGSDRangel
 {
     class SWGDeviceSettings;
@@ -117,6 +119,8 @@ public:
         return 501;
     }
 
+    virtual const FileRecord *getFileRecord() const { return nullptr; } //!< I/Q recorder if the device has one
+
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
 	virtual void setMessageQueueToGUI(MessageQueue *queue) = 0; // pure virtual so that child classes must have to deal with this
 	MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
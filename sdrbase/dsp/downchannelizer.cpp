@@ -19,6 +19,7 @@
 #include <dsp/downchannelizer.h>
 #include "dsp/inthalfbandfilter.h"
 #include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
 #include "dsp/hbfilterchainconverter.h"
 
 #include <QString>
@@ -29,6 +30,7 @@ MESSAGE_CLASS_DEFINITION(DownChannelizer::MsgSetChannelizer, Message)
 
 DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
     m_filterChainSetMode(false),
+    m_blockMode(DSPEngine::instance()->getBlockChannelizer()),
 	m_sampleSink(sampleSink),
 	m_inputSampleRate(0),
 	m_requestedOutputSampleRate(0),
@@ -38,6 +40,7 @@ DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
 {
 	QString name = "DownChannelizer(" + m_sampleSink->objectName() + ")";
 	setObjectName(name);
+	m_sinkProfile.setOwner(m_sampleSink, "demod");
 }
 
 DownChannelizer::~DownChannelizer()
@@ -66,44 +69,88 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 
 	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
 	{
+		ProfileTimer sinkTimer(m_sinkProfile, end - begin);
 		m_sampleSink->feed(begin, end, positiveOnly);
 	}
 	else
 	{
 		m_mutex.lock();
 
-		for(SampleVector::const_iterator sample = begin; sample != end; ++sample)
+		if (m_blockMode) {
+		    feedBlock(begin, end);
+		} else {
+		    feedSample(begin, end);
+		}
+
+		m_mutex.unlock();
+
 		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
+			ProfileTimer sinkTimer(m_sinkProfile, m_sampleBuffer.size());
+			m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
+		}
 
-			for (; stage != m_filterStages.end(); ++stage)
-			{
+		m_sampleBuffer.clear();
+	}
+}
+
+void DownChannelizer::feedSample(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+	for(SampleVector::const_iterator sample = begin; sample != end; ++sample)
+	{
+		Sample s(*sample);
+		FilterStages::iterator stage = m_filterStages.begin();
+
+		for (; stage != m_filterStages.end(); ++stage)
+		{
 #ifndef SDR_RX_SAMPLE_24BIT
                 s.m_real /= 2; // avoid saturation on 16 bit samples
                 s.m_imag /= 2;
 #endif
-				if(!(*stage)->work(&s))
-				{
-					break;
-				}
+			if(!(*stage)->work(&s))
+			{
+				break;
 			}
+		}
 
-			if(stage == m_filterStages.end())
-			{
+		if(stage == m_filterStages.end())
+		{
 #ifdef SDR_RX_SAMPLE_24BIT
-			    s.m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
-			    s.m_imag /= (1<<(m_filterStages.size()));
+		    s.m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
+		    s.m_imag /= (1<<(m_filterStages.size()));
 #endif
-				m_sampleBuffer.push_back(s);
-			}
+			m_sampleBuffer.push_back(s);
 		}
+	}
+}
 
-		m_mutex.unlock();
+void DownChannelizer::feedBlock(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    // each stage decimates the whole buffer in place before the next one is run
+    int nbSamples = end - begin;
+    m_sampleBuffer.assign(begin, end);
+    Sample *buf = m_sampleBuffer.data();
 
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
-		m_sampleBuffer.clear();
-	}
+    for (FilterStages::iterator stage = m_filterStages.begin(); stage != m_filterStages.end(); ++stage)
+    {
+#ifndef SDR_RX_SAMPLE_24BIT
+        for (int i = 0; i < nbSamples; i++)
+        {
+            buf[i].m_real /= 2; // avoid saturation on 16 bit samples
+            buf[i].m_imag /= 2;
+        }
+#endif
+        nbSamples = (*stage)->workBlock(buf, nbSamples);
+    }
+
+#ifdef SDR_RX_SAMPLE_24BIT
+    for (int i = 0; i < nbSamples; i++)
+    {
+        buf[i].m_real /= (1<<(m_filterStages.size())); // on 32 bit samples there is enough headroom to just divide the final result
+        buf[i].m_imag /= (1<<(m_filterStages.size()));
+    }
+#endif
+
+    m_sampleBuffer.resize(nbSamples);
 }
 
 void DownChannelizer::start()
@@ -249,20 +296,24 @@ void DownChannelizer::applySetting(unsigned int log2Decim, unsigned int filterCh
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>),
     m_workFunction(0),
+    m_workBlockFunction(0),
     m_mode(mode),
     m_sse(true)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
+            m_workBlockFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenterBlock;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
+            m_workBlockFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalfBlock;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
+            m_workBlockFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalfBlock;
             break;
     }
 }
@@ -270,20 +321,24 @@ DownChannelizer::FilterStage::FilterStage(Mode mode) :
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
     m_filter(new IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>),
     m_workFunction(0),
+    m_workBlockFunction(0),
     m_mode(mode),
     m_sse(true)
 {
     switch(mode) {
         case ModeCenter:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
+            m_workBlockFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenterBlock;
             break;
 
         case ModeLowerHalf:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
+            m_workBlockFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalfBlock;
             break;
 
         case ModeUpperHalf:
             m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
+            m_workBlockFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalfBlock;
             break;
     }
 }
@@ -20,11 +20,11 @@
 #define SDRBASE_DSP_DOWNCHANNELIZER_H
 
 #include <dsp/basebandsamplesink.h>
-#include <list>
 #include <vector>
 #include <QMutex>
 #include "export.h"
 #include "util/message.h"
+#include "util/profiler.h"
 #include "dsp/inthalfbandfiltereo.h"
 
 #define DOWNCHANNELIZER_HB_FILTER_ORDER 48
@@ -36,6 +36,7 @@ class SDRBASE_API DownChannelizer : public BasebandSampleSink {
 public:
     class SDRBASE_API MsgChannelizerNotification : public Message {
 		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED(MsgChannelizerNotification)
 
 	public:
 		MsgChannelizerNotification(int samplerate, qint64 frequencyOffset) :
@@ -82,6 +83,8 @@ public:
     void set(MessageQueue* messageQueue, unsigned int log2Decim, unsigned int filterChainHash);
 	int getInputSampleRate() const { return m_inputSampleRate; }
 	int getRequestedCenterFrequency() const { return m_requestedCenterFrequency; }
+    void setBlockMode(bool blockMode) { m_blockMode = blockMode; }
+    bool getBlockMode() const { return m_blockMode; }
 
 	virtual void start();
 	virtual void stop();
@@ -98,13 +101,16 @@ protected:
 
 #ifdef SDR_RX_SAMPLE_24BIT
         typedef bool (IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
+        typedef int (IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkBlockFunction)(Sample* buf, int nbSamples);
         IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #else
         typedef bool (IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
+        typedef int (IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkBlockFunction)(Sample* buf, int nbSamples);
         IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
 #endif
 
 		WorkFunction m_workFunction;
+		WorkBlockFunction m_workBlockFunction;
 		Mode m_mode;
 		bool m_sse;
 
@@ -115,10 +121,16 @@ protected:
 		{
 			return (m_filter->*m_workFunction)(sample);
 		}
+
+		int workBlock(Sample* buf, int nbSamples)
+		{
+			return (m_filter->*m_workBlockFunction)(buf, nbSamples);
+		}
 	};
-	typedef std::list<FilterStage*> FilterStages;
+	typedef std::vector<FilterStage*> FilterStages;
 	FilterStages m_filterStages;
     bool m_filterChainSetMode;
+    bool m_blockMode; //!< process whole buffers stage by stage with SIMD half-band filters
 	BasebandSampleSink* m_sampleSink; //!< Demodulator
 	int m_inputSampleRate;
 	int m_requestedOutputSampleRate;
@@ -127,7 +139,10 @@ protected:
 	int m_currentCenterFrequency;
 	SampleVector m_sampleBuffer;
 	QMutex m_mutex;
+	ProfileCounter m_sinkProfile; //!< time spent in the demodulator
 
+	void feedSample(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+	void feedBlock(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
 	void applyConfiguration();
     void applySetting(unsigned int log2Decim, unsigned int filterChainHash);
 	bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
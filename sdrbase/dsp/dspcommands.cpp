@@ -39,6 +39,9 @@ MESSAGE_CLASS_DEFINITION(DSPAddThreadedBasebandSampleSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPAddThreadedBasebandSampleSource, Message)
 MESSAGE_CLASS_DEFINITION(DSPRemoveThreadedBasebandSampleSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPRemoveThreadedBasebandSampleSource, Message)
+MESSAGE_CLASS_DEFINITION(DSPAddPFBChannelSink, Message)
+MESSAGE_CLASS_DEFINITION(DSPRemovePFBChannelSink, Message)
+MESSAGE_CLASS_DEFINITION(DSPConfigurePFBChannelizer, Message)
 MESSAGE_CLASS_DEFINITION(DSPAddAudioSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPRemoveAudioSink, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureCorrection, Message)
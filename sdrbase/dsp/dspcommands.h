@@ -233,6 +233,48 @@ private:
 	ThreadedBasebandSampleSource* m_threadedSampleSource;
 };
 
+class SDRBASE_API DSPAddPFBChannelSink : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPAddPFBChannelSink(ThreadedBasebandSampleSink* threadedSampleSink, qint64 frequencyOffset) :
+		Message(),
+		m_threadedSampleSink(threadedSampleSink),
+		m_frequencyOffset(frequencyOffset)
+	{ }
+
+	ThreadedBasebandSampleSink* getThreadedSampleSink() const { return m_threadedSampleSink; }
+	qint64 getFrequencyOffset() const { return m_frequencyOffset; }
+
+private:
+	ThreadedBasebandSampleSink* m_threadedSampleSink;
+	qint64 m_frequencyOffset;
+};
+
+class SDRBASE_API DSPRemovePFBChannelSink : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPRemovePFBChannelSink(ThreadedBasebandSampleSink* threadedSampleSink) : Message(), m_threadedSampleSink(threadedSampleSink) { }
+
+	ThreadedBasebandSampleSink* getThreadedSampleSink() const { return m_threadedSampleSink; }
+
+private:
+	ThreadedBasebandSampleSink* m_threadedSampleSink;
+};
+
+class SDRBASE_API DSPConfigurePFBChannelizer : public Message {
+	MESSAGE_CLASS_DECLARATION
+
+public:
+	DSPConfigurePFBChannelizer(unsigned int log2NbSubbands) : Message(), m_log2NbSubbands(log2NbSubbands) { }
+
+	unsigned int getLog2NbSubbands() const { return m_log2NbSubbands; }
+
+private:
+	unsigned int m_log2NbSubbands;
+};
+
 class SDRBASE_API DSPAddAudioSink : public Message {
 	MESSAGE_CLASS_DECLARATION
 
@@ -317,6 +359,7 @@ private:
 
 class SDRBASE_API DSPSignalNotification : public Message {
 	MESSAGE_CLASS_DECLARATION
+	MESSAGE_CLASS_POOLED(DSPSignalNotification)
 
 public:
 	DSPSignalNotification(int samplerate, qint64 centerFrequency) :
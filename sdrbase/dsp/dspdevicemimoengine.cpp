@@ -54,6 +54,8 @@ DSPDeviceMIMOEngine::DSPDeviceMIMOEngine(uint32_t uid, QObject* parent) :
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
 
+    m_workProfile.setOwner(this, "work");
+
 	moveToThread(this);
 }
 
@@ -255,6 +257,8 @@ QString DSPDeviceMIMOEngine::deviceDescription()
 void DSPDeviceMIMOEngine::work(int nbWriteSamples)
 {
     (void) nbWriteSamples;
+    ProfileTimer workTimer(m_workProfile);
+    unsigned int samplesTotal = 0;
     // Sources
     for (unsigned int isource = 0; isource < m_deviceSampleMIMO->getNbSourceStreams(); isource++)
     {
@@ -329,8 +333,12 @@ void DSPDeviceMIMOEngine::work(int nbWriteSamples)
             sampleFifo->readCommit((unsigned int) count);
             samplesDone += count;
         } // while stream FIFO
+
+        samplesTotal += samplesDone;
     } // for stream source
 
+    workTimer.setSamples(samplesTotal);
+
     // TODO: sinks
 }
 
@@ -343,6 +351,7 @@ void DSPDeviceMIMOEngine::workSampleSink(unsigned int sinkIndex)
 	SampleSinkFifo* sampleFifo = m_deviceSampleMIMO->getSampleSinkFifo(sinkIndex);
 	int samplesDone = 0;
 	bool positiveOnly = false;
+	ProfileTimer workTimer(m_workProfile);
 
 	while ((sampleFifo->fill() > 0) && (m_inputMessageQueue.size() == 0) && (samplesDone < m_deviceSampleMIMO->getSourceSampleRate(sinkIndex)))
 	{
@@ -413,6 +422,8 @@ void DSPDeviceMIMOEngine::workSampleSink(unsigned int sinkIndex)
 		sampleFifo->readCommit((unsigned int) count);
 		samplesDone += count;
 	}
+
+	workTimer.setSamples(samplesDone);
 }
 
 // notStarted -> idle -> init -> running -+
@@ -632,10 +643,16 @@ void DSPDeviceMIMOEngine::handleData()
 
 void DSPDeviceMIMOEngine::handleSetMIMO(DeviceSampleMIMO* mimo)
 {
+    if (m_deviceSampleMIMO) {
+        setFifoProfileOwner(nullptr);
+    }
+
     m_deviceSampleMIMO = mimo;
 
     if (mimo)
     {
+        setFifoProfileOwner(this);
+
         if ((m_sampleSinkConnectionIndexes.size() == 1) && (m_sampleSourceConnectionIndexes.size() == 0)) // true MIMO (synchronous FIFOs)
         {
             qDebug("DSPDeviceMIMOEngine::handleSetMIMO: synchronous set %s", qPrintable(mimo->getDeviceDescription()));
@@ -668,6 +685,17 @@ void DSPDeviceMIMOEngine::handleSetMIMO(DeviceSampleMIMO* mimo)
     // TODO: Tx
 }
 
+void DSPDeviceMIMOEngine::setFifoProfileOwner(const QObject *owner)
+{
+    for (unsigned int isource = 0; isource < m_deviceSampleMIMO->getNbSourceStreams(); isource++) {
+        m_deviceSampleMIMO->getSampleSinkFifo(isource)->getProfile().setOwner(owner, QString("rx%1").arg(isource));
+    }
+
+    for (unsigned int isink = 0; isink < m_deviceSampleMIMO->getNbSinkStreams(); isink++) {
+        m_deviceSampleMIMO->getSampleSourceFifo(isink)->getProfile().setOwner(owner, QString("tx%1").arg(isink));
+    }
+}
+
 void DSPDeviceMIMOEngine::handleSynchronousMessages()
 {
     Message *message = m_syncMessenger.getMessage();
@@ -26,6 +26,7 @@
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "util/movingaverage.h"
+#include "util/profiler.h"
 #include "export.h"
 
 class DeviceSampleMIMO;
@@ -360,6 +361,8 @@ private:
     bool m_spectrumInputSourceElseSink; //!< Source else sink stream to be used as spectrum sink input
     unsigned int m_spectrumInputIndex;  //!< Index of the stream to be used as spectrum sink input
 
+    ProfileCounter m_workProfile; //!< work() and workSampleSink() runs
+
   	void run();
 	void work(int nbWriteSamples); //!< transfer samples if in running state
 
@@ -369,6 +372,7 @@ private:
 	State gotoError(const QString& errorMsg); //!< Go to an error state
 
     void handleSetMIMO(DeviceSampleMIMO* mimo); //!< Manage MIMO device setting
+    void setFifoProfileOwner(const QObject *owner); //!< Tag the device stream FIFOs for the profiling reports
    	void iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, int isource, bool imbalanceCorrection);
 
 private slots:
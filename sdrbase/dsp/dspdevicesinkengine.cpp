@@ -44,6 +44,8 @@ DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
 
+	m_workProfile.setOwner(this, "work");
+
 	moveToThread(this);
 }
 
@@ -159,6 +161,8 @@ QString DSPDeviceSinkEngine::sinkDeviceDescription()
 
 void DSPDeviceSinkEngine::work(int nbWriteSamples)
 {
+	ProfileTimer workTimer(m_workProfile, nbWriteSamples);
+
 	// multiple channel sources handling
 	if ((m_threadedBasebandSampleSources.size() + m_basebandSampleSources.size()) > 1)
 	{
@@ -200,8 +204,10 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
 	            }
 	        }
 
-			sampleFifo->bumpIndex(writeAt);
+	        ++writeAt;
 		}
+
+	    sampleFifo->commitWrite(nbWriteSamples);
 	}
 }
 
@@ -389,9 +395,14 @@ void DSPDeviceSinkEngine::handleSetSink(DeviceSampleSink* sink)
 {
 	gotoIdle();
 
+	if (m_deviceSampleSink) {
+		m_deviceSampleSink->getSampleFifo()->getProfile().setOwner(nullptr, QString());
+	}
+
 	m_deviceSampleSink = sink;
 
 	if(m_deviceSampleSink != 0) {
+		m_deviceSampleSink->getSampleFifo()->getProfile().setOwner(this, "device");
 		qDebug("DSPDeviceSinkEngine::handleSetSink: set %s", qPrintable(sink->getDeviceDescription()));
 	} else {
 		qDebug("DSPDeviceSinkEngine::handleSetSource: set none");
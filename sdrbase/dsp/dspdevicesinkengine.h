@@ -30,6 +30,7 @@
 #include "dsp/fftwindow.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
+#include "util/profiler.h"
 #include "export.h"
 
 class DeviceSampleSink;
@@ -112,6 +113,8 @@ private:
 	quint64 m_centerFrequency;
 	uint32_t m_multipleSourcesDivisionFactor;
 
+	ProfileCounter m_workProfile; //!< whole work() run i.e. mixing of the channel sources
+
 	void run();
 	void work(int nbWriteSamples); //!< transfer samples from beseband sources to sink if in running state
 
@@ -24,7 +24,6 @@
 #include <stdio.h>
 #include <QDebug>
 #include "dsp/dspcommands.h"
-#include "util/fixed.h"
 #include "samplesinkfifo.h"
 #include "threadedbasebandsamplesink.h"
 
@@ -35,6 +34,7 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_deviceSampleSource(nullptr),
 	m_sampleSourceSequence(0),
 	m_basebandSampleSinks(),
+	m_pfbLog2NbSubbands(6),
 	m_sampleRate(0),
 	m_centerFrequency(0),
 	m_dcOffsetCorrection(false),
@@ -48,6 +48,9 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
 
+	m_workProfile.setOwner(this, "work");
+	m_pfbProfile.setOwner(this, "pfb");
+
 	moveToThread(this);
 }
 
@@ -150,6 +153,27 @@ void DSPDeviceSourceEngine::removeThreadedSink(ThreadedBasebandSampleSink* sink)
 	m_syncMessenger.sendWait(cmd);
 }
 
+void DSPDeviceSourceEngine::addPFBChannelSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset)
+{
+	qDebug() << "DSPDeviceSourceEngine::addPFBChannelSink: " << sink->objectName().toStdString().c_str() << " offset: " << frequencyOffset;
+	DSPAddPFBChannelSink cmd(sink, frequencyOffset);
+	m_syncMessenger.sendWait(cmd);
+}
+
+void DSPDeviceSourceEngine::removePFBChannelSink(ThreadedBasebandSampleSink* sink)
+{
+	qDebug() << "DSPDeviceSourceEngine::removePFBChannelSink: " << sink->objectName().toStdString().c_str();
+	DSPRemovePFBChannelSink cmd(sink);
+	m_syncMessenger.sendWait(cmd);
+}
+
+void DSPDeviceSourceEngine::configurePFBChannelizer(unsigned int log2NbSubbands)
+{
+	qDebug() << "DSPDeviceSourceEngine::configurePFBChannelizer: log2NbSubbands: " << log2NbSubbands;
+	DSPConfigurePFBChannelizer* cmd = new DSPConfigurePFBChannelizer(log2NbSubbands);
+	m_inputMessageQueue.push(cmd);
+}
+
 void DSPDeviceSourceEngine::configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection)
 {
 	qDebug() << "DSPDeviceSourceEngine::configureCorrections";
@@ -173,95 +197,6 @@ QString DSPDeviceSourceEngine::sourceDeviceDescription()
 	return cmd.getDeviceDescription();
 }
 
-void DSPDeviceSourceEngine::iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
-{
-    for(SampleVector::iterator it = begin; it < end; it++)
-    {
-        m_iBeta(it->real());
-        m_qBeta(it->imag());
-
-        if (imbalanceCorrection)
-        {
-#if IMBALANCE_INT
-            // acquisition
-            int64_t xi = (it->m_real - (int32_t) m_iBeta) << 5;
-            int64_t xq = (it->m_imag - (int32_t) m_qBeta) << 5;
-
-            // phase imbalance
-            m_avgII((xi*xi)>>28); // <I", I">
-            m_avgIQ((xi*xq)>>28); // <I", Q">
-
-            if ((int64_t) m_avgII != 0)
-            {
-                int64_t phi = (((int64_t) m_avgIQ)<<28) / (int64_t) m_avgII;
-                m_avgPhi(phi);
-            }
-
-            int64_t corrPhi = (((int64_t) m_avgPhi) * xq) >> 28;  //(m_avgPhi.asDouble()/16777216.0) * ((double) xq);
-
-            int64_t yi = xi - corrPhi;
-            int64_t yq = xq;
-
-            // amplitude I/Q imbalance
-            m_avgII2((yi*yi)>>28); // <I, I>
-            m_avgQQ2((yq*yq)>>28); // <Q, Q>
-
-            if ((int64_t) m_avgQQ2 != 0)
-            {
-                int64_t a = (((int64_t) m_avgII2)<<28) / (int64_t) m_avgQQ2;
-                Fixed<int64_t, 28> fA(Fixed<int64_t, 28>::internal(), a);
-                Fixed<int64_t, 28> sqrtA = sqrt((Fixed<int64_t, 28>) fA);
-                m_avgAmp(sqrtA.as_internal());
-            }
-
-            int64_t zq = (((int64_t) m_avgAmp) * yq) >> 28;
-
-            it->m_real = yi >> 5;
-            it->m_imag = zq >> 5;
-
-#else
-            // DC correction and conversion
-            float xi = (it->m_real - (int32_t) m_iBeta) / SDR_RX_SCALEF;
-            float xq = (it->m_imag - (int32_t) m_qBeta) / SDR_RX_SCALEF;
-
-            // phase imbalance
-            m_avgII(xi*xi); // <I", I">
-            m_avgIQ(xi*xq); // <I", Q">
-
-
-            if (m_avgII.asDouble() != 0) {
-                m_avgPhi(m_avgIQ.asDouble()/m_avgII.asDouble());
-            }
-
-            float& yi = xi; // the in phase remains the reference
-            float yq = xq - m_avgPhi.asDouble()*xi;
-
-            // amplitude I/Q imbalance
-            m_avgII2(yi*yi); // <I, I>
-            m_avgQQ2(yq*yq); // <Q, Q>
-
-            if (m_avgQQ2.asDouble() != 0) {
-                m_avgAmp(sqrt(m_avgII2.asDouble() / m_avgQQ2.asDouble()));
-            }
-
-            // final correction
-            float& zi = yi; // the in phase remains the reference
-            float zq = m_avgAmp.asDouble() * yq;
-
-            // convert and store
-            it->m_real = zi * SDR_RX_SCALEF;
-            it->m_imag = zq * SDR_RX_SCALEF;
-#endif
-        }
-        else
-        {
-            // DC correction only
-            it->m_real -= (int32_t) m_iBeta;
-            it->m_imag -= (int32_t) m_qBeta;
-        }
-    }
-}
-
 void DSPDeviceSourceEngine::dcOffset(SampleVector::iterator begin, SampleVector::iterator end)
 {
 	// sum and correct in one pass
@@ -328,6 +263,7 @@ void DSPDeviceSourceEngine::work()
 	SampleSinkFifo* sampleFifo = m_deviceSampleSource->getSampleFifo();
 	std::size_t samplesDone = 0;
 	bool positiveOnly = false;
+	ProfileTimer workTimer(m_workProfile);
 
 	while ((sampleFifo->fill() > 0) && (m_inputMessageQueue.size() == 0) && (samplesDone < m_sampleRate))
 	{
@@ -344,7 +280,7 @@ void DSPDeviceSourceEngine::work()
 			// correct stuff
             if (m_dcOffsetCorrection)
             {
-                iqCorrections(part1begin, part1end, m_iqImbalanceCorrection);
+                m_iqCorrector.process(part1begin, part1end, m_iqImbalanceCorrection);
             }
 
 //			if (m_dcOffsetCorrection)
@@ -368,6 +304,13 @@ void DSPDeviceSourceEngine::work()
 			{
 				(*it)->feed(part1begin, part1end, positiveOnly);
 			}
+
+			// feed data to the shared filter bank channels
+			if (m_pfbChannelizer.hasChannels())
+			{
+				ProfileTimer pfbTimer(m_pfbProfile, part1end - part1begin);
+				m_pfbChannelizer.feed(part1begin, part1end);
+			}
 		}
 
 		// second part of FIFO data (used when block wraps around)
@@ -376,7 +319,7 @@ void DSPDeviceSourceEngine::work()
 			// correct stuff
             if (m_dcOffsetCorrection)
             {
-                iqCorrections(part2begin, part2end, m_iqImbalanceCorrection);
+                m_iqCorrector.process(part2begin, part2end, m_iqImbalanceCorrection);
             }
 
 //            if (m_dcOffsetCorrection)
@@ -400,12 +343,21 @@ void DSPDeviceSourceEngine::work()
 			{
 				(*it)->feed(part2begin, part2end, positiveOnly);
 			}
+
+			// feed data to the shared filter bank channels
+			if (m_pfbChannelizer.hasChannels())
+			{
+				ProfileTimer pfbTimer(m_pfbProfile, part2end - part2begin);
+				m_pfbChannelizer.feed(part2begin, part2end);
+			}
 		}
 
 		// adjust FIFO pointers
 		sampleFifo->readCommit((unsigned int) count);
 		samplesDone += count;
 	}
+
+	workTimer.setSamples(samplesDone);
 }
 
 // notStarted -> idle -> init -> running -+
@@ -446,6 +398,8 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoIdle()
         (*it)->stop();
     }
 
+    m_pfbChannelizer.stopChannels();
+
 	m_deviceSampleSource->stop();
 	m_deviceDescription.clear();
 	m_sampleRate = 0;
@@ -505,6 +459,9 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoInit()
 		(*it)->handleSinkMessage(notif);
 	}
 
+	m_pfbChannelizer.configure(m_pfbLog2NbSubbands, m_sampleRate);
+	m_pfbChannelizer.notifyChannels(m_centerFrequency);
+
 	// pass data to listeners
 	if (m_deviceSampleSource->getMessageQueueToGUI())
 	{
@@ -560,6 +517,8 @@ DSPDeviceSourceEngine::State DSPDeviceSourceEngine::gotoRunning()
 		(*it)->start();
 	}
 
+	m_pfbChannelizer.startChannels();
+
 	qDebug() << "DSPDeviceSourceEngine::gotoRunning:input message queue pending: " << m_inputMessageQueue.size();
 
 	return StRunning;
@@ -584,10 +543,15 @@ void DSPDeviceSourceEngine::handleSetSource(DeviceSampleSource* source)
 //		disconnect(m_sampleSource->getSampleFifo(), SIGNAL(dataReady()), this, SLOT(handleData()));
 //	}
 
+	if (m_deviceSampleSource) {
+		m_deviceSampleSource->getSampleFifo()->getProfile().setOwner(nullptr, QString());
+	}
+
 	m_deviceSampleSource = source;
 
 	if(m_deviceSampleSource != 0)
 	{
+		m_deviceSampleSource->getSampleFifo()->getProfile().setOwner(this, "device");
 		qDebug("DSPDeviceSourceEngine::handleSetSource: set %s", qPrintable(source->getDeviceDescription()));
 		connect(m_deviceSampleSource->getSampleFifo(), SIGNAL(dataReady()), this, SLOT(handleData()), Qt::QueuedConnection);
 	}
@@ -679,6 +643,31 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 		threadedSink->stop();
 		m_threadedBasebandSampleSinks.remove(threadedSink);
 	}
+	else if (DSPAddPFBChannelSink::match(*message))
+	{
+		DSPAddPFBChannelSink *cmd = (DSPAddPFBChannelSink*) message;
+		ThreadedBasebandSampleSink *threadedSink = cmd->getThreadedSampleSink();
+		bool newChannel = !m_pfbChannelizer.hasChannel(threadedSink);
+
+		if (m_sampleRate != 0) {
+			m_pfbChannelizer.configure(m_pfbLog2NbSubbands, m_sampleRate);
+		}
+
+		m_pfbChannelizer.addChannel(threadedSink, cmd->getFrequencyOffset());
+		// initialize sample rate and center frequency in the sink:
+		DSPSignalNotification msg(m_pfbChannelizer.getSubbandSampleRate(), m_centerFrequency + cmd->getFrequencyOffset());
+		threadedSink->handleSinkMessage(msg);
+		// start the sink:
+		if ((m_state == StRunning) && newChannel) {
+			threadedSink->start();
+		}
+	}
+	else if (DSPRemovePFBChannelSink::match(*message))
+	{
+		ThreadedBasebandSampleSink* threadedSink = ((DSPRemovePFBChannelSink*) message)->getThreadedSampleSink();
+		threadedSink->stop();
+		m_pfbChannelizer.removeChannel(threadedSink);
+	}
 
 	m_syncMessenger.done(m_state);
 }
@@ -711,17 +700,25 @@ void DSPDeviceSourceEngine::handleInputMessages()
 				m_imbalance = 65536;
 			}
 
-			m_avgAmp.reset();
-			m_avgII.reset();
-			m_avgII2.reset();
-			m_avgIQ.reset();
-			m_avgPhi.reset();
-			m_avgQQ2.reset();
+			m_iqCorrector.reset();
 			m_iBeta.reset();
 			m_qBeta.reset();
 
 			delete message;
 		}
+		else if (DSPConfigurePFBChannelizer::match(*message))
+		{
+			DSPConfigurePFBChannelizer *conf = (DSPConfigurePFBChannelizer*) message;
+			m_pfbLog2NbSubbands = conf->getLog2NbSubbands();
+
+			if (m_sampleRate != 0)
+			{
+				m_pfbChannelizer.configure(m_pfbLog2NbSubbands, m_sampleRate);
+				m_pfbChannelizer.notifyChannels(m_centerFrequency);
+			}
+
+			delete message;
+		}
 		else if (DSPSignalNotification::match(*message))
 		{
 			DSPSignalNotification *notif = (DSPSignalNotification *) message;
@@ -749,6 +746,12 @@ void DSPDeviceSourceEngine::handleInputMessages()
 				(*it)->handleSinkMessage(*message);
 			}
 
+			if (m_sampleRate != 0) {
+				m_pfbChannelizer.configure(m_pfbLog2NbSubbands, m_sampleRate);
+			}
+
+			m_pfbChannelizer.notifyChannels(m_centerFrequency);
+
 			// forward changes to source GUI input queue
 
 			MessageQueue *guiMessageQueue = m_deviceSampleSource->getMessageQueueToGUI();
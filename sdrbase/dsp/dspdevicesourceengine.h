@@ -29,6 +29,9 @@
 #include "util/syncmessenger.h"
 #include "export.h"
 #include "util/movingaverage.h"
+#include "dsp/pfbchannelizer.h"
+#include "dsp/iqcorrector.h"
+#include "util/profiler.h"
 
 class DeviceSampleSource;
 class BasebandSampleSink;
@@ -70,6 +73,10 @@ public:
 	void addThreadedSink(ThreadedBasebandSampleSink* sink); //!< Add a sample sink that will run on its own thread
 	void removeThreadedSink(ThreadedBasebandSampleSink* sink); //!< Remove a sample sink that runs on its own thread
 
+	void addPFBChannelSink(ThreadedBasebandSampleSink* sink, qint64 frequencyOffset); //!< Subscribe a sink to the shared filter bank sub-band nearest to the frequency offset or change its offset
+	void removePFBChannelSink(ThreadedBasebandSampleSink* sink); //!< Unsubscribe a sink from the shared filter bank
+	void configurePFBChannelizer(unsigned int log2NbSubbands); //!< Set the number of sub-bands of the shared filter bank
+
 	void configureCorrections(bool dcOffsetCorrection, bool iqImbalanceCorrection); //!< Configure DSP corrections
 
 	State state() const { return m_state; } //!< Return DSP engine current state
@@ -97,6 +104,9 @@ private:
 	typedef std::list<ThreadedBasebandSampleSink*> ThreadedBasebandSampleSinks;
 	ThreadedBasebandSampleSinks m_threadedBasebandSampleSinks; //!< sample sinks on their own threads (usually channels)
 
+	PFBChannelizer m_pfbChannelizer; //!< filter bank shared by the channels subscribed to a sub-band
+	unsigned int m_pfbLog2NbSubbands;
+
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
 
@@ -107,32 +117,17 @@ private:
 	MovingAverageUtil<int32_t, int64_t, 1024> m_iBeta;
     MovingAverageUtil<int32_t, int64_t, 1024> m_qBeta;
 
-#if IMBALANCE_INT
-    // Fixed point DC + IQ corrections
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgII;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgIQ;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgPhi;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgII2;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgQQ2;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgAmp;
-
-#else
-    // Floating point DC + IQ corrections
-    MovingAverageUtil<float, double, 128> m_avgII;
-    MovingAverageUtil<float, double, 128> m_avgIQ;
-    MovingAverageUtil<float, double, 128> m_avgII2;
-    MovingAverageUtil<float, double, 128> m_avgQQ2;
-    MovingAverageUtil<double, double, 128> m_avgPhi;
-    MovingAverageUtil<double, double, 128> m_avgAmp;
-#endif
+    IQCorrector m_iqCorrector; //!< block DC and IQ imbalance correction
 
     qint32 m_iRange;
 	qint32 m_qRange;
 	qint32 m_imbalance;
 
+	ProfileCounter m_workProfile; //!< whole work() run
+	ProfileCounter m_pfbProfile;  //!< shared filter bank and its channels
+
 	void run();
 
-	void iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection);
 	void dcOffset(SampleVector::iterator begin, SampleVector::iterator end);
 	void imbalance(SampleVector::iterator begin, SampleVector::iterator end);
 	void work(); //!< transfer samples from source to sinks if in running state
@@ -33,6 +33,8 @@ DSPEngine::DSPEngine() :
 {
 	m_dvSerialSupport = false;
     m_mimoSupport = false;
+    m_blockChannelizer = false;
+    m_pfbLog2NbSubbands = 6;
     m_masterTimer.start(50);
 }
 
@@ -56,6 +58,7 @@ DSPEngine *DSPEngine::instance()
 DSPDeviceSourceEngine *DSPEngine::addDeviceSourceEngine()
 {
     m_deviceSourceEngines.push_back(new DSPDeviceSourceEngine(m_deviceSourceEnginesUIDSequence));
+    m_deviceSourceEngines.back()->configurePFBChannelizer(m_pfbLog2NbSubbands);
     m_deviceSourceEnginesUIDSequence++;
     return m_deviceSourceEngines.back();
 }
@@ -85,6 +85,10 @@ public:
     const QTimer& getMasterTimer() const { return m_masterTimer; }
     void setMIMOSupport(bool mimoSupport) { m_mimoSupport = mimoSupport; }
     bool getMIMOSupport() const { return m_mimoSupport; }
+    void setBlockChannelizer(bool blockChannelizer) { m_blockChannelizer = blockChannelizer; }
+    bool getBlockChannelizer() const { return m_blockChannelizer; }
+    void setPFBLog2NbSubbands(unsigned int log2NbSubbands) { m_pfbLog2NbSubbands = log2NbSubbands; }
+    unsigned int getPFBLog2NbSubbands() const { return m_pfbLog2NbSubbands; }
 
 private:
 	std::vector<DSPDeviceSourceEngine*> m_deviceSourceEngines;
@@ -99,6 +103,8 @@ private:
     QTimer m_masterTimer;
 	bool m_dvSerialSupport;
     bool m_mimoSupport;
+    bool m_blockChannelizer; //!< default processing mode of new down channelizers
+    unsigned int m_pfbLog2NbSubbands; //!< shared filter bank size of new source device engines
 #ifdef DSD_USE_SERIALDV
 	DVSerialEngine m_dvSerialEngine;
 #endif
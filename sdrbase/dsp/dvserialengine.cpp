@@ -229,7 +229,10 @@ void DVSerialEngine::release()
     {
         disconnect(&it->worker->m_inputMessageQueue, SIGNAL(messageEnqueued()), it->worker, SLOT(handleInputMessages()));
         it->worker->stop();
-        it->thread->wait(100);
+        // the input queue is consumed by the event loop of the worker thread: the queue can
+        // only be cleared from here once this loop has returned
+        it->thread->quit();
+        it->thread->wait();
         it->worker->m_inputMessageQueue.clear();
         it->worker->close();
         qDebug() << "DVSerialEngine::release: closed device at: " << it->device.c_str();
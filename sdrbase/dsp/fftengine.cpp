@@ -1,3 +1,6 @@
+#include <QStandardPaths>
+#include <QDir>
+
 #include "dsp/fftengine.h"
 #ifdef USE_KISSFFT
 #include "dsp/kissengine.h"
@@ -23,3 +26,47 @@ FFTEngine* FFTEngine::create()
 	return 0;
 #endif
 }
+
+QString FFTEngine::getWisdomFileName()
+{
+	QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+	QDir().mkpath(dataDir);
+	return dataDir + "/fftwf_wisdom";
+}
+
+bool FFTEngine::loadWisdom()
+{
+#ifdef USE_FFTW
+	return FFTWEngine::loadWisdom(getWisdomFileName());
+#else
+	return false;
+#endif
+}
+
+bool FFTEngine::saveWisdom()
+{
+#ifdef USE_FFTW
+	return FFTWEngine::saveWisdom(getWisdomFileName());
+#else
+	return false;
+#endif
+}
+
+void FFTEngine::prePlan(unsigned int log2MinSize, unsigned int log2MaxSize)
+{
+	FFTEngine *fft = create();
+
+	if (!fft) {
+		return;
+	}
+
+	qDebug("FFTEngine::prePlan: sizes %u to %u", 1U<<log2MinSize, 1U<<log2MaxSize);
+
+	for (unsigned int log2Size = log2MinSize; log2Size <= log2MaxSize; log2Size++)
+	{
+		fft->configure(1<<log2Size, false);
+		fft->configure(1<<log2Size, true);
+	}
+
+	delete fft;
+}
@@ -1,6 +1,8 @@
 #ifndef INCLUDE_FFTENGINE_H
 #define INCLUDE_FFTENGINE_H
 
+#include <QString>
+
 #include "dsp/dsptypes.h"
 #include "export.h"
 
@@ -15,6 +17,13 @@ public:
 	virtual Complex* out() = 0;
 
 	static FFTEngine* create();
+
+	/** Plan cache (FFTW wisdom) kept in the application data directory. No-op for engines that do not plan */
+	static QString getWisdomFileName();
+	static bool loadWisdom();
+	static bool saveWisdom();
+	/** Create plans in both directions for sizes 2^log2MinSize to 2^log2MaxSize */
+	static void prePlan(unsigned int log2MinSize, unsigned int log2MaxSize);
 };
 
 #endif // INCLUDE_FFTENGINE_H
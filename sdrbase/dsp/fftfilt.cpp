@@ -34,33 +34,150 @@
 #include <cstdlib>
 #include <cmath>
 #include <typeinfo>
+#include <map>
+#include <tuple>
 
 #include <stdio.h>
 #include <sys/types.h>
 #include <memory.h>
 
+#include <QMutex>
+#include <QMutexLocker>
+
 #include <dsp/misc.h>
+#include <dsp/fftengine.h>
 #include <dsp/fftfilt.h>
 
+//------------------------------------------------------------------------------
+// filter spectra cache
+// Filters with the same shape and length share the same spectrum. Demodulators
+// of the same type on a device typically have the same filters.
+//------------------------------------------------------------------------------
+
+namespace {
+	typedef std::tuple<int, float, float, int> KernelKey; // type, p1, p2, flen
+	QMutex kernelCacheMutex;
+	std::map<KernelKey, std::weak_ptr<const std::vector<fftfilt::cmplx>>> kernelCache;
+}
+
+fftfilt::Kernel fftfilt::getKernel(KernelType type, float p1, float p2)
+{
+	QMutexLocker mutexLocker(&kernelCacheMutex);
+	KernelKey key(type, p1, p2, flen);
+
+	for (auto it = kernelCache.begin(); it != kernelCache.end();) // clean up spectra no longer in use
+	{
+		if (it->second.expired()) {
+			it = kernelCache.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	auto it = kernelCache.find(key);
+
+	if (it != kernelCache.end()) {
+		return it->second.lock(); // not expired under the lock
+	}
+
+	std::vector<cmplx> *kernel = new std::vector<cmplx>(flen, cmplx(0, 0));
+	computeKernel(*kernel, type, p1, p2);
+	Kernel shared(kernel);
+	kernelCache[key] = shared;
+	return shared;
+}
+
+void fftfilt::computeKernel(std::vector<cmplx>& kernel, KernelType type, float p1, float p2)
+{
+	int scaleLen = flen2; // normalization range
+
+	if (type == KERNEL_RRC) // constructed directly from frequency domain response
+	{
+		for (int i = 0; i < flen; i++) {
+			kernel[i] = frrc(p1, p2, i, flen);
+		}
+
+		scaleLen = flen;
+	}
+	else
+	{
+		// create the filter shape coefficients by fft
+		FFTEngine *fft = FFTEngine::create();
+		fft->configure(flen, false);
+		cmplx *h = fft->in();
+		std::fill(h, h + flen, cmplx(0, 0));
+
+		if (type == KERNEL_BANDPASS)
+		{
+			bool b_lowpass = (p2 != 0);
+			bool b_highpass = (p1 != 0);
+
+			for (int i = 0; i < flen2; i++) {
+				// lowpass @ p2
+				if (b_lowpass)
+					h[i] += fsinc(p2, i, flen2);
+				// highpass @ p1
+				if (b_highpass)
+					h[i] -= fsinc(p1, i, flen2);
+			}
+			// highpass is delta[flen2/2] - h(t)
+			if (b_highpass && p2 < p1)
+				h[flen2 / 2] += 1;
+		}
+		else // KERNEL_DSB
+		{
+			for (int i = 0; i < flen2; i++) {
+				h[i] = fsinc(p1, i, flen2);
+			}
+		}
+
+		for (int i = 0; i < flen2; i++)
+			h[i] *= _blackman(i, flen2);
+
+		fft->transform(); // filter was expressed in the time domain (impulse response)
+		std::copy(fft->out(), fft->out() + flen, kernel.begin());
+		delete fft;
+	}
+
+	// normalize the output filter for unity gain
+	float scale = 0, mag;
+	for (int i = 0; i < scaleLen; i++) {
+		mag = abs(kernel[i]);
+		if (mag > scale) scale = mag;
+	}
+	if (scale == 0) {
+		scale = 1.0f;
+	}
+
+	// include the 1/N scaling of the inverse FFT
+	scale *= flen;
+
+	for (int i = 0; i < flen; i++)
+		kernel[i] /= scale;
+}
+
 //------------------------------------------------------------------------------
 // initialize the filter
 // create forward and reverse FFTs
 //------------------------------------------------------------------------------
 
-// Only need a single instance of g_fft, used for both forward and reverse
 void fftfilt::init_filter()
 {
 	flen2	= flen >> 1;
-	fft	= new g_fft<float>(flen);
-
-	filter		= new cmplx[flen];
-    filterOpp   = new cmplx[flen];
-	data		= new cmplx[flen];
+	fwdFFT	= FFTEngine::create();
+	invFFT	= FFTEngine::create();
+	fwdFFT->configure(flen, false);
+	invFFT->configure(flen, true);
+
+	filterKernel.reset(new std::vector<cmplx>(flen, cmplx(0, 0)));
+	filterOppKernel = filterKernel;
+	filter		= filterKernel->data();
+	filterOpp	= filterOppKernel->data();
+	data		= fwdFFT->in(); // samples are accumulated directly in the FFT input
 	output		= new cmplx[flen2];
 	ovlbuf		= new cmplx[flen2];
 
-	memset(filter, 0, flen * sizeof(cmplx));
-    memset(filterOpp, 0, flen * sizeof(cmplx));
+	// planning may have used the buffers
 	memset(data, 0, flen * sizeof(cmplx));
 	memset(output, 0, flen2 * sizeof(cmplx));
 	memset(ovlbuf, 0, flen2 * sizeof(cmplx));
@@ -95,78 +212,24 @@ fftfilt::fftfilt(float f2, int len)
 
 fftfilt::~fftfilt()
 {
-	if (fft) delete fft;
+	delete fwdFFT;
+	delete invFFT;
 
-	if (filter) delete [] filter;
-    if (filterOpp) delete [] filterOpp;
-	if (data) delete [] data;
 	if (output) delete [] output;
 	if (ovlbuf) delete [] ovlbuf;
 }
 
 void fftfilt::create_filter(float f1, float f2)
 {
-	// initialize the filter to zero
-	memset(filter, 0, flen * sizeof(cmplx));
-
-	// create the filter shape coefficients by fft
-	bool b_lowpass, b_highpass;
-	b_lowpass = (f2 != 0);
-	b_highpass = (f1 != 0);
-
-	for (int i = 0; i < flen2; i++) {
-		filter[i] = 0;
-	// lowpass @ f2
-		if (b_lowpass)
-			filter[i] += fsinc(f2, i, flen2);
-	// highighpass @ f1
-		if (b_highpass)
-			filter[i] -= fsinc(f1, i, flen2);
-	}
-	// highpass is delta[flen2/2] - h(t)
-	if (b_highpass && f2 < f1)
-		filter[flen2 / 2] += 1;
-
-	for (int i = 0; i < flen2; i++)
-		filter[i] *= _blackman(i, flen2);
-
-	fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
-
-	// normalize the output filter for unity gain
-	float scale = 0, mag;
-	for (int i = 0; i < flen2; i++) {
-		mag = abs(filter[i]);
-		if (mag > scale) scale = mag;
-	}
-	if (scale != 0) {
-		for (int i = 0; i < flen; i++)
-			filter[i] /= scale;
-	}
+	filterKernel = getKernel(KERNEL_BANDPASS, f1, f2);
+	filter = filterKernel->data();
 }
 
 // Double the size of FFT used for equivalent SSB filter or assume FFT is half the size of the one used for SSB
 void fftfilt::create_dsb_filter(float f2)
 {
-	// initialize the filter to zero
-	memset(filter, 0, flen * sizeof(cmplx));
-
-	for (int i = 0; i < flen2; i++) {
-		filter[i] = fsinc(f2, i, flen2);
-		filter[i] *= _blackman(i, flen2);
-	}
-
-	fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
-
-	// normalize the output filter for unity gain
-	float scale = 0, mag;
-	for (int i = 0; i < flen2; i++) {
-		mag = abs(filter[i]);
-		if (mag > scale) scale = mag;
-	}
-	if (scale != 0) {
-		for (int i = 0; i < flen; i++)
-			filter[i] /= scale;
-	}
+	filterKernel = getKernel(KERNEL_DSB, f2, 0);
+	filter = filterKernel->data();
 }
 
 // Double the size of FFT used for equivalent SSB filter or assume FFT is half the size of the one used for SSB
@@ -174,74 +237,117 @@ void fftfilt::create_dsb_filter(float f2)
 void fftfilt::create_asym_filter(float fopp, float fin)
 {
     // in band
-    // initialize the filter to zero
-    memset(filter, 0, flen * sizeof(cmplx));
-
-    for (int i = 0; i < flen2; i++) {
-        filter[i] = fsinc(fin, i, flen2);
-        filter[i] *= _blackman(i, flen2);
-    }
-
-    fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
-
-    // normalize the output filter for unity gain
-    float scale = 0, mag;
-    for (int i = 0; i < flen2; i++) {
-        mag = abs(filter[i]);
-        if (mag > scale) scale = mag;
-    }
-    if (scale != 0) {
-        for (int i = 0; i < flen; i++)
-            filter[i] /= scale;
-    }
-
+    filterKernel = getKernel(KERNEL_DSB, fin, 0);
+    filter = filterKernel->data();
     // opposite band
-    // initialize the filter to zero
-    memset(filterOpp, 0, flen * sizeof(cmplx));
-
-    for (int i = 0; i < flen2; i++) {
-        filterOpp[i] = fsinc(fopp, i, flen2);
-        filterOpp[i] *= _blackman(i, flen2);
-    }
-
-    fft->ComplexFFT(filterOpp); // filter was expressed in the time domain (impulse response)
-
-    // normalize the output filter for unity gain
-    scale = 0;
-    for (int i = 0; i < flen2; i++) {
-        mag = abs(filterOpp[i]);
-        if (mag > scale) scale = mag;
-    }
-    if (scale != 0) {
-        for (int i = 0; i < flen; i++)
-            filterOpp[i] /= scale;
-    }
+    filterOppKernel = getKernel(KERNEL_DSB, fopp, 0);
+    filterOpp = filterOppKernel->data();
 }
 
 // This filter is constructed directly from frequency domain response. Run with runFilt.
 void fftfilt::create_rrc_filter(float fb, float a)
 {
-    std::fill(filter, filter+flen, 0);
-
-    for (int i = 0; i < flen; i++) {
-        filter[i] = frrc(fb, a, i, flen);
-    }
-
-    // normalize the output filter for unity gain
-    float scale = 0, mag;
-    for (int i = 0; i < flen; i++)
-    {
-        mag = abs(filter[i]);
-        if (mag > scale) {
-            scale = mag;
-        }
-    }
-    if (scale != 0)
-    {
-        for (int i = 0; i < flen; i++) {
-            filter[i] /= scale;
-        }
-    }
+    filterKernel = getKernel(KERNEL_RRC, fb, a);
+    filter = filterKernel->data();
+}
+
+// Filter one frame of flen/2 samples accumulated in data and write flen/2 samples to out
+void fftfilt::filterFrame(cmplx *out, FilterMode mode, bool usb, bool getDC)
+{
+	fwdFFT->transform(); // the zero padding in the second half of data is preserved
+	const cmplx *X = fwdFFT->out();
+	cmplx *Y = invFFT->in();
+	const float scale = 1.0f / flen; // for bins not going through the filter
+
+	switch (mode)
+	{
+	case SSB:
+		// get or reject DC component
+		Y[0] = getDC ? X[0]*filter[0] : 0;
+		Y[flen2] = X[flen2] * scale;
+
+		// Discard frequencies for ssb
+		if (usb)
+		{
+			for (int i = 1; i < flen2; i++) {
+				Y[i] = X[i] * filter[i];
+				Y[flen2 + i] = 0;
+			}
+		}
+		else
+		{
+			for (int i = 1; i < flen2; i++) {
+				Y[i] = 0;
+				Y[flen2 + i] = X[flen2 + i] * filter[flen2 + i];
+			}
+		}
+		break;
+	case DSB:
+		for (int i = 0; i < flen; i++)
+			Y[i] = X[i] * filter[i];
+
+		// get or reject DC component
+		Y[0] = getDC ? Y[0] : 0;
+		break;
+	case ASYM:
+		Y[0] = X[0] * filter[0]; // always keep DC
+		Y[flen2] = X[flen2] * scale;
+
+		if (usb)
+		{
+			for (int i = 1; i < flen2; i++)
+			{
+				Y[i] = X[i] * filter[i]; // usb
+				Y[flen2 + i] = X[flen2 + i] * filterOpp[flen2 + i]; // lsb is the opposite
+			}
+		}
+		else
+		{
+			for (int i = 1; i < flen2; i++)
+			{
+				Y[i] = X[i] * filterOpp[i]; // usb is the opposite
+				Y[flen2 + i] = X[flen2 + i] * filter[flen2 + i]; // lsb
+			}
+		}
+		break;
+	case FILT:
+	default:
+		for (int i = 0; i < flen; i++)
+			Y[i] = X[i] * filter[i];
+		break;
+	}
+
+	invFFT->transform();
+	const cmplx *y = invFFT->out();
+
+	// overlap and add
+	for (int i = 0; i < flen2; i++) {
+		out[i] = ovlbuf[i] + y[i];
+		ovlbuf[i] = y[i+flen2];
+	}
+}
+
+int fftfilt::runBlock(const cmplx* in, int n, cmplx* out, FilterMode mode, bool usb, bool getDC)
+{
+	int nOut = 0;
+
+	while (n > 0)
+	{
+		int count = std::min(n, flen2 - inptr);
+		std::copy(in, in + count, data + inptr);
+		in += count;
+		n -= count;
+		inptr += count;
+
+		if (inptr == flen2)
+		{
+			inptr = 0;
+			filterFrame(out + nOut, mode, usb, getDC);
+			nOut += flen2;
+		}
+	}
+
+	return nOut;
 }
 
 // test bypass
@@ -264,17 +370,7 @@ int fftfilt::runFilt(const cmplx & in, cmplx **out)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
-	for (int i = 0; i < flen; i++)
-		data[i] *= filter[i];
-
-	fft->InverseComplexFFT(data);
-
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[flen2 + i];
-	}
-	memset (data, 0, flen * sizeof(cmplx));
+	filterFrame(output, FILT, false, true);
 
 	*out = output;
 	return flen2;
@@ -288,36 +384,7 @@ int fftfilt::runSSB(const cmplx & in, cmplx **out, bool usb, bool getDC)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
-
-	// get or reject DC component
-	data[0] = getDC ? data[0]*filter[0] : 0;
-
-	// Discard frequencies for ssb
-	if (usb)
-	{
-		for (int i = 1; i < flen2; i++) {
-			data[i] *= filter[i];
-			data[flen2 + i] = 0;
-		}
-	}
-	else
-	{
-		for (int i = 1; i < flen2; i++) {
-			data[i] = 0;
-			data[flen2 + i] *= filter[flen2 + i];
-		}
-	}
-
-	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
-
-	// overlap and add
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[i+flen2];
-	}
-	memset (data, 0, flen * sizeof(cmplx));
+	filterFrame(output, SSB, usb, getDC);
 
 	*out = output;
 	return flen2;
@@ -331,26 +398,7 @@ int fftfilt::runDSB(const cmplx & in, cmplx **out, bool getDC)
 		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
-
-	for (int i = 0; i < flen2; i++) {
-		data[i] *= filter[i];
-		data[flen2 + i] *= filter[flen2 + i];
-	}
-
-    // get or reject DC component
-    data[0] = getDC ? data[0] : 0;
-
-	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
-
-	// overlap and add
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[i+flen2];
-	}
-
-	memset (data, 0, flen * sizeof(cmplx));
+	filterFrame(output, DSB, false, getDC);
 
 	*out = output;
 	return flen2;
@@ -364,42 +412,32 @@ int fftfilt::runAsym(const cmplx & in, cmplx **out, bool usb)
         return 0;
     inptr = 0;
 
-    fft->ComplexFFT(data);
-
-    data[0] *= filter[0]; // always keep DC
-
-    if (usb)
-    {
-        for (int i = 1; i < flen2; i++)
-        {
-            data[i] *= filter[i]; // usb
-            data[flen2 + i] *= filterOpp[flen2 + i]; // lsb is the opposite
-        }
-    }
-    else
-    {
-        for (int i = 1; i < flen2; i++)
-        {
-            data[i] *= filterOpp[i]; // usb is the opposite
-            data[flen2 + i] *= filter[flen2 + i]; // lsb
-        }
-    }
-
-    // in-place FFT: freqdata overwritten with filtered timedata
-    fft->InverseComplexFFT(data);
-
-    // overlap and add
-    for (int i = 0; i < flen2; i++) {
-        output[i] = ovlbuf[i] + data[i];
-        ovlbuf[i] = data[i+flen2];
-    }
-
-    memset (data, 0, flen * sizeof(cmplx));
+    filterFrame(output, ASYM, usb, true);
 
     *out = output;
     return flen2;
 }
 
+int fftfilt::runFiltBlock(const cmplx* in, int n, cmplx* out)
+{
+	return runBlock(in, n, out, FILT, false, true);
+}
+
+int fftfilt::runSSBBlock(const cmplx* in, int n, cmplx* out, bool usb, bool getDC)
+{
+	return runBlock(in, n, out, SSB, usb, getDC);
+}
+
+int fftfilt::runDSBBlock(const cmplx* in, int n, cmplx* out, bool getDC)
+{
+	return runBlock(in, n, out, DSB, false, getDC);
+}
+
+int fftfilt::runAsymBlock(const cmplx* in, int n, cmplx* out, bool usb)
+{
+	return runBlock(in, n, out, ASYM, usb, true);
+}
+
 /* Sliding FFT from Fldigi */
 
 struct sfft::vrot_bins_pair {
@@ -6,9 +6,12 @@
 #define	_FFTFILT_H
 
 #include <complex>
-#include "gfft.h"
+#include <vector>
+#include <memory>
 #include "export.h"
 
+class FFTEngine;
+
 #undef M_PI
 #define M_PI 3.14159265358979323846
 
@@ -36,13 +39,27 @@ public:
 	int runDSB(const cmplx& in, cmplx **out, bool getDC = true);
 	int runAsym(const cmplx & in, cmplx **out, bool usb); //!< Asymmetrical fitering can be used for vestigial sideband
 
+	// Block versions: filter n input samples and write the output samples to out that must hold
+	// at least n + flen/2 samples. Return the number of output samples (a multiple of flen/2).
+	int runFiltBlock(const cmplx* in, int n, cmplx* out);
+	int runSSBBlock(const cmplx* in, int n, cmplx* out, bool usb, bool getDC = true);
+	int runDSBBlock(const cmplx* in, int n, cmplx* out, bool getDC = true);
+	int runAsymBlock(const cmplx* in, int n, cmplx* out, bool usb);
+
 protected:
+	enum FilterMode {FILT, SSB, DSB, ASYM};
+	enum KernelType {KERNEL_BANDPASS, KERNEL_DSB, KERNEL_RRC};
+	typedef std::shared_ptr<const std::vector<cmplx>> Kernel;
+
 	int flen;
 	int flen2;
-	g_fft<float> *fft;
-	cmplx *filter;
-    cmplx *filterOpp;
-	cmplx *data;
+	FFTEngine *fwdFFT;
+	FFTEngine *invFFT;
+	Kernel filterKernel;    //!< filter spectra are shared between the filters with same parameters
+	Kernel filterOppKernel;
+	const cmplx *filter;    //!< spectrum scaled by 1/flen so that the inverse FFT needs no scaling
+	const cmplx *filterOpp;
+	cmplx *data;            //!< input of the forward FFT. Second half is zero padding.
 	cmplx *ovlbuf;
 	cmplx *output;
 	int inptr;
@@ -88,6 +105,10 @@ protected:
 
 	void init_filter();
 	void init_dsb_filter();
+	Kernel getKernel(KernelType type, float p1, float p2);
+	void computeKernel(std::vector<cmplx>& kernel, KernelType type, float p1, float p2);
+	void filterFrame(cmplx *out, FilterMode mode, bool usb, bool getDC);
+	int runBlock(const cmplx* in, int n, cmplx* out, FilterMode mode, bool usb, bool getDC);
 };
 
 
@@ -1,4 +1,6 @@
 #include <QTime>
+#include <QFile>
+#include <QMutexLocker>
 #include "dsp/fftwengine.h"
 
 FFTWEngine::FFTWEngine() :
@@ -29,9 +31,26 @@ void FFTWEngine::configure(int n, bool inverse)
 	QTime t;
 	t.start();
 	m_globalPlanMutex.lock();
-	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
+	// try wisdom first so that a known plan does not get measured again
+	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+	bool hit = m_currentPlan->plan != NULL;
+
+	if (hit)
+	{
+		m_wisdomHits++;
+	}
+	else
+	{
+		m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
+		m_wisdomMisses++;
+		m_wisdomChanged = true;
+	}
+
+	unsigned int hits = m_wisdomHits;
+	unsigned int misses = m_wisdomMisses;
 	m_globalPlanMutex.unlock();
-	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms wisdom %s (hits: %u misses: %u)",
+		n, inverse ? "inverse" : "forward", t.elapsed(), hit ? "hit" : "miss", hits, misses);
 	m_plans.push_back(m_currentPlan);
 }
 
@@ -56,6 +75,49 @@ Complex* FFTWEngine::out()
 }
 
 QMutex FFTWEngine::m_globalPlanMutex;
+unsigned int FFTWEngine::m_wisdomHits = 0;
+unsigned int FFTWEngine::m_wisdomMisses = 0;
+bool FFTWEngine::m_wisdomChanged = false;
+
+bool FFTWEngine::loadWisdom(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if (!QFile::exists(fileName))
+	{
+		qDebug("FFTWEngine::loadWisdom: no wisdom file %s", qPrintable(fileName));
+		return false;
+	}
+
+	if (fftwf_import_wisdom_from_filename(QFile::encodeName(fileName).constData()) == 0)
+	{
+		qWarning("FFTWEngine::loadWisdom: cannot import wisdom from %s", qPrintable(fileName));
+		return false;
+	}
+
+	qDebug("FFTWEngine::loadWisdom: imported wisdom from %s", qPrintable(fileName));
+	return true;
+}
+
+bool FFTWEngine::saveWisdom(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if (!m_wisdomChanged) {
+		return true;
+	}
+
+	if (fftwf_export_wisdom_to_filename(QFile::encodeName(fileName).constData()) == 0)
+	{
+		qWarning("FFTWEngine::saveWisdom: cannot export wisdom to %s", qPrintable(fileName));
+		return false;
+	}
+
+	m_wisdomChanged = false;
+	qDebug("FFTWEngine::saveWisdom: exported wisdom to %s (hits: %u misses: %u)",
+		qPrintable(fileName), m_wisdomHits, m_wisdomMisses);
+	return true;
+}
 
 void FFTWEngine::freeAll()
 {
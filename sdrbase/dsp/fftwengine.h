@@ -2,6 +2,7 @@
 #define INCLUDE_FFTWENGINE_H
 
 #include <QMutex>
+#include <QString>
 #include <fftw3.h>
 #include <list>
 #include "dsp/fftengine.h"
@@ -18,8 +19,14 @@ public:
 	Complex* in();
 	Complex* out();
 
+	static bool loadWisdom(const QString& fileName); //!< import wisdom so that known plans are created without measurement
+	static bool saveWisdom(const QString& fileName); //!< export wisdom if new plans were measured since last load or save
+
 protected:
 	static QMutex m_globalPlanMutex;
+	static unsigned int m_wisdomHits;   //!< plans created from wisdom
+	static unsigned int m_wisdomMisses; //!< plans that had to be measured
+	static bool m_wisdomChanged;
 
 	struct Plan {
 		int n;
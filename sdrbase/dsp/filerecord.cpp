@@ -20,6 +20,10 @@
 
 #include <QDebug>
 #include <QDateTime>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+#include "SWGFileRecordReport.h"
 
 #include "dsp/dspcommands.h"
 #include "util/simpleserializer.h"
@@ -27,6 +31,8 @@
 
 #include "filerecord.h"
 
+FileRecord::Config FileRecord::m_defaultConfig;
+
 FileRecord::FileRecord() :
 	BasebandSampleSink(),
     m_fileName("test.sdriq"),
@@ -34,7 +40,11 @@ FileRecord::FileRecord() :
     m_centerFrequency(0),
 	m_recordOn(false),
     m_recordStart(false),
-    m_byteCount(0)
+    m_headerPending(false),
+    m_fileIndex(0),
+    m_fileByteCount(0),
+    m_totalSampleBytes(0),
+    m_startTimeStamp(0)
 {
 	setObjectName("FileSink");
 }
@@ -46,7 +56,11 @@ FileRecord::FileRecord(const QString& filename) :
     m_centerFrequency(0),
     m_recordOn(false),
     m_recordStart(false),
-    m_byteCount(0)
+    m_headerPending(false),
+    m_fileIndex(0),
+    m_fileByteCount(0),
+    m_totalSampleBytes(0),
+    m_startTimeStamp(0)
 {
     setObjectName("FileRecord");
 }
@@ -80,16 +94,48 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
     if(!m_recordOn)
         return;
 
-    if (begin < end) // if there is something to put out
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_recordOn || !(begin < end)) { // stopped meanwhile or nothing to put out
+        return;
+    }
+
+    if (m_recordStart)
     {
-        if (m_recordStart)
+        m_startTimeStamp = time(0);
+        startFile();
+        m_recordStart = false;
+    }
+
+    // only copies the samples to the writer buffers. The disk is written by the writer thread.
+    const char *data = reinterpret_cast<const char*>(&*(begin));
+    quint64 size = (end - begin)*sizeof(Sample);
+
+    while (size > 0)
+    {
+        quint64 chunk = getBytesBeforeRotation();
+
+        if (chunk == 0) // the next sample goes to a new file
         {
-            writeHeader();
-            m_recordStart = false;
+            m_fileIndex++;
+            startFile();
+            continue;
+        }
+
+        chunk = chunk < size ? chunk : size;
+
+        if (m_headerPending) {
+            m_headerPending = !writeHeader();
+        }
+
+        if (!m_headerPending) { // else drop samples until the file has its header
+            m_writer.write(data, chunk);
         }
 
-        m_sampleFile.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
-        m_byteCount += end - begin;
+        data += chunk;
+        size -= chunk;
+        m_fileByteCount += chunk;
+        m_totalSampleBytes += chunk;
     }
 }
 
@@ -104,25 +150,41 @@ void FileRecord::stop()
 
 void FileRecord::startRecording()
 {
-    if (!m_sampleFile.is_open())
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_recordOn)
     {
     	qDebug() << "FileRecord::startRecording";
-        m_sampleFile.open(m_fileName.toStdString().c_str(), std::ios::binary);
+        m_config = m_defaultConfig;
+
+        if (!m_writer.startWork(m_config.m_writer)) {
+            return;
+        }
+
         m_recordOn = true;
         m_recordStart = true;
-        m_byteCount = 0;
+        m_headerPending = false;
+        m_fileIndex = 0;
+        m_fileByteCount = 0;
+        m_totalSampleBytes = 0;
     }
 }
 
 void FileRecord::stopRecording()
 {
-    if (m_sampleFile.is_open())
     {
-    	qDebug() << "FileRecord::stopRecording";
-        m_sampleFile.close();
+        QMutexLocker mutexLocker(&m_mutex); // once released the feeding thread does not use the writer any more
+
+        if (!m_recordOn) {
+            return;
+        }
+
         m_recordOn = false;
         m_recordStart = false;
     }
+
+    qDebug() << "FileRecord::stopRecording";
+    m_writer.stopWork(); // waits until the queued buffers are written
 }
 
 bool FileRecord::handleMessage(const Message& message)
@@ -152,17 +214,94 @@ void FileRecord::handleConfigure(const QString& fileName)
 	m_fileName = fileName;
 }
 
-void FileRecord::writeHeader()
+void FileRecord::startFile()
+{
+    m_writer.openFile(getRotatedFileName(m_fileIndex));
+    m_fileByteCount = sizeof(Header);
+    m_headerPending = !writeHeader();
+}
+
+bool FileRecord::writeHeader()
 {
     Header header;
     header.sampleRate = m_sampleRate;
     header.centerFrequency = m_centerFrequency;
-    std::time_t ts = time(0);
-    header.startTimeStamp = ts;
+    // continuation files start where the previous one ended
+    quint64 elapsed = m_sampleRate == 0 ? 0 : (m_totalSampleBytes / sizeof(Sample)) / m_sampleRate;
+    header.startTimeStamp = m_startTimeStamp + elapsed;
     header.sampleSize = SDR_RX_SAMP_SZ;
     header.filler = 0;
+    setHeaderCRC(header);
+
+    return m_writer.write((const char *) &header, sizeof(Header)) == sizeof(Header);
+}
+
+quint64 FileRecord::getBytesBeforeRotation() const
+{
+    quint64 bytes = (quint64) -1;
 
-    writeHeader(m_sampleFile, header);
+    if (m_config.m_rotateSize != 0) {
+        bytes = m_config.m_rotateSize > m_fileByteCount ? m_config.m_rotateSize - m_fileByteCount : 0;
+    }
+
+    if ((m_config.m_rotateTime != 0) && (m_sampleRate != 0))
+    {
+        quint64 fileBytes = (quint64) m_config.m_rotateTime * m_sampleRate * sizeof(Sample) + sizeof(Header);
+        quint64 timeBytes = fileBytes > m_fileByteCount ? fileBytes - m_fileByteCount : 0;
+        bytes = timeBytes < bytes ? timeBytes : bytes;
+    }
+
+    if (m_fileByteCount == sizeof(Header)) { // at least one sample per file
+        bytes = bytes < sizeof(Sample) ? sizeof(Sample) : bytes;
+    }
+
+    return bytes - (bytes % sizeof(Sample)); // files end on a sample boundary
+}
+
+QString FileRecord::getRotatedFileName(int fileIndex) const
+{
+    if (fileIndex == 0) {
+        return m_fileName;
+    }
+
+    QFileInfo fileInfo(m_fileName);
+    QString baseName = fileInfo.path() + "/" + fileInfo.completeBaseName();
+
+    if (fileInfo.suffix().isEmpty()) {
+        return QString("%1_%2").arg(baseName).arg(fileIndex, 3, 10, QChar('0'));
+    } else {
+        return QString("%1_%2.%3").arg(baseName).arg(fileIndex, 3, 10, QChar('0')).arg(fileInfo.suffix());
+    }
+}
+
+void FileRecord::webapiFormatReport(SWGSDRangel::SWGFileRecordReport& response) const
+{
+    response.setRecording(m_recordOn ? 1 : 0);
+
+    if (response.getFileName()) {
+        *response.getFileName() = m_writer.getFileName();
+    } else {
+        response.setFileName(new QString(m_writer.getFileName()));
+    }
+
+    response.setFileIndex(m_writer.getFileIndex());
+    response.setFileByteCount(m_writer.getFileByteCount());
+    response.setTotalByteCount(m_writer.getTotalByteCount());
+    response.setOverrunCount(m_writer.getOverrunCount());
+    response.setDroppedByteCount(m_writer.getDroppedByteCount());
+    response.setWriteErrorCount(m_writer.getWriteErrorCount());
+    response.setQueuedBuffers(m_writer.getQueuedBuffers());
+    response.setTotalBuffers(m_writer.getTotalBuffers());
+}
+
+void FileRecord::setDefaultConfig(const Config& config)
+{
+    m_defaultConfig = config;
+}
+
+const FileRecord::Config& FileRecord::getDefaultConfig()
+{
+    return m_defaultConfig;
 }
 
 bool FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
@@ -174,9 +313,14 @@ bool FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
 }
 
 void FileRecord::writeHeader(std::ofstream& sampleFile, Header& header)
+{
+    setHeaderCRC(header);
+    sampleFile.write((const char *) &header, sizeof(Header));
+}
+
+void FileRecord::setHeaderCRC(Header& header)
 {
     boost::crc_32_type crc32;
     crc32.process_bytes(&header, 28);
     header.crc32 = crc32.checksum();
-    sampleFile.write((const char *) &header, sizeof(Header));
 }
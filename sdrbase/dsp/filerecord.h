@@ -24,10 +24,17 @@
 #include <fstream>
 
 #include <ctime>
+#include <QMutex>
+
+#include "dsp/filerecordwriter.h"
 #include "export.h"
 
 class Message;
 
+namespace SWGSDRangel {
+    class SWGFileRecordReport;
+}
+
 class SDRBASE_API FileRecord : public BasebandSampleSink {
 public:
 
@@ -43,11 +50,25 @@ public:
     };
 #pragma pack(pop)
 
+    struct Config
+    {
+        FileRecordWriter::Config m_writer;
+        quint64 m_rotateSize;      //!< start a new file when it reaches this number of bytes. 0 for no limit
+        unsigned int m_rotateTime; //!< start a new file after this number of seconds of samples. 0 for no limit
+
+        Config() :
+            m_rotateSize(0),
+            m_rotateTime(0)
+        {}
+    };
+
 	FileRecord();
     FileRecord(const QString& filename);
 	virtual ~FileRecord();
 
-    quint64 getByteCount() const { return m_byteCount; }
+    quint64 getByteCount() const { return m_writer.getTotalByteCount(); }
+    int getFileIndex() const { return m_writer.getFileIndex(); }
+    quint32 getOverrunCount() const { return m_writer.getOverrunCount(); }
 
     void setFileName(const QString& filename);
     void genUniqueFileName(uint deviceUID, int istream = -1);
@@ -59,8 +80,11 @@ public:
     void startRecording();
     void stopRecording();
     bool isRecording() const { return m_recordOn; }
+    void webapiFormatReport(SWGSDRangel::SWGFileRecordReport& response) const;
     static bool readHeader(std::ifstream& samplefile, Header& header); //!< returns true if CRC checksum is correct else false
     static void writeHeader(std::ofstream& samplefile, Header& header);
+    static void setDefaultConfig(const Config& config); //!< applies to recordings started afterwards
+    static const Config& getDefaultConfig();
 
 private:
 	QString m_fileName;
@@ -68,11 +92,22 @@ private:
 	quint64 m_centerFrequency;
 	bool m_recordOn;
     bool m_recordStart;
-    std::ofstream m_sampleFile;
-    quint64 m_byteCount;
+    bool m_headerPending;
+    Config m_config;
+    FileRecordWriter m_writer;
+    int m_fileIndex;
+    quint64 m_fileByteCount;   //!< bytes sent to the current file including header
+    quint64 m_totalSampleBytes; //!< sample bytes since the start of the recording
+    std::time_t m_startTimeStamp;
+    QMutex m_mutex;
+    static Config m_defaultConfig;
 
 	void handleConfigure(const QString& fileName);
-    void writeHeader();
+    void startFile();
+    bool writeHeader(); //!< false if the header could not be queued (writer overrun)
+    quint64 getBytesBeforeRotation() const;
+    QString getRotatedFileName(int fileIndex) const;
+    static void setHeaderCRC(Header& header);
 };
 
 #endif // INCLUDE_FILERECORD_H
@@ -0,0 +1,409 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <errno.h>
+#endif
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "filerecordwriter.h"
+
+FileRecordWriter::FileRecordWriter(QObject *parent) :
+    QThread(parent),
+    m_currentBuffer(nullptr),
+    m_running(false),
+    m_stop(false),
+    m_fileOffset(0),
+    m_preallocatedEnd(0),
+    m_directIO(false),
+    m_nbFilesOpened(0),
+    m_fileIndex(0),
+    m_fileByteCount(0),
+    m_totalByteCount(0),
+    m_overrunCount(0),
+    m_droppedByteCount(0),
+    m_writeErrorCount(0)
+{
+}
+
+FileRecordWriter::~FileRecordWriter()
+{
+    stopWork();
+}
+
+bool FileRecordWriter::startWork(const Config& config)
+{
+    if (m_running) {
+        return true;
+    }
+
+    m_config = config;
+    m_config.m_bufferSize = ((m_config.m_bufferSize + m_alignment - 1) / m_alignment) * m_alignment;
+    m_config.m_bufferSize = m_config.m_bufferSize < m_alignment ? m_alignment : m_config.m_bufferSize;
+    m_config.m_nbBuffers = m_config.m_nbBuffers < 2 ? 2 : m_config.m_nbBuffers;
+    allocateBuffers();
+
+    if (m_buffers.size() == 0)
+    {
+        qWarning("FileRecordWriter::startWork: cannot allocate %u buffers of %u bytes",
+            m_config.m_nbBuffers, m_config.m_bufferSize);
+        return false;
+    }
+
+    m_currentBuffer = nullptr;
+    m_nextFileName.clear();
+    m_stop = false;
+    m_nbFilesOpened = 0;
+    m_fileIndex = 0;
+    m_fileByteCount = 0;
+    m_totalByteCount = 0;
+    m_overrunCount = 0;
+    m_droppedByteCount = 0;
+    m_writeErrorCount = 0;
+
+    qDebug("FileRecordWriter::startWork: %u buffers of %u bytes direct I/O: %s preallocate: %llu",
+        m_config.m_nbBuffers, m_config.m_bufferSize, m_config.m_directIO ? "on" : "off", m_config.m_preallocateSize);
+
+    m_startWaitMutex.lock();
+    start();
+
+    while (!m_running) {
+        m_startWaiter.wait(&m_startWaitMutex, 100);
+    }
+
+    m_startWaitMutex.unlock();
+    return true;
+}
+
+void FileRecordWriter::stopWork()
+{
+    if (!m_running) {
+        return;
+    }
+
+    flush();
+    m_mutex.lock();
+    m_stop = true;
+    m_queueCondition.wakeAll();
+    m_mutex.unlock();
+    wait();
+    m_currentBuffer = nullptr;
+    freeBuffers();
+    qDebug("FileRecordWriter::stopWork: %llu bytes written in %d file(s) overruns: %u write errors: %u",
+        m_totalByteCount.load(), m_nbFilesOpened, m_overrunCount.load(), m_writeErrorCount.load());
+}
+
+void FileRecordWriter::openFile(const QString& fileName)
+{
+    if (m_currentBuffer && (m_currentBuffer->m_size != 0)) {
+        queueCurrentBuffer();
+    }
+
+    if (m_currentBuffer) { // empty: it becomes the first buffer of the new file
+        m_currentBuffer->m_fileName = fileName;
+    } else {
+        m_nextFileName = fileName;
+    }
+}
+
+quint64 FileRecordWriter::write(const char *data, quint64 size)
+{
+    quint64 written = 0;
+
+    while (written < size)
+    {
+        if (!m_currentBuffer && !acquireBuffer())
+        {
+            m_overrunCount++;
+            m_droppedByteCount += size - written;
+            break;
+        }
+
+        quint64 chunk = m_config.m_bufferSize - m_currentBuffer->m_size;
+        chunk = chunk < size - written ? chunk : size - written;
+        memcpy(&m_currentBuffer->m_data[m_currentBuffer->m_size], &data[written], chunk);
+        m_currentBuffer->m_size += chunk;
+        written += chunk;
+
+        if (m_currentBuffer->m_size == m_config.m_bufferSize) {
+            queueCurrentBuffer();
+        }
+    }
+
+    return written;
+}
+
+void FileRecordWriter::flush()
+{
+    if (m_currentBuffer && (m_currentBuffer->m_size != 0)) {
+        queueCurrentBuffer();
+    }
+}
+
+QString FileRecordWriter::getFileName() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_fileName;
+}
+
+int FileRecordWriter::getQueuedBuffers() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_fullBuffers.size();
+}
+
+bool FileRecordWriter::acquireBuffer()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_freeBuffers.empty()) {
+        return false;
+    }
+
+    m_currentBuffer = m_freeBuffers.front();
+    m_freeBuffers.pop_front();
+    m_currentBuffer->m_size = 0;
+    m_currentBuffer->m_fileName = m_nextFileName;
+    m_nextFileName.clear();
+
+    return true;
+}
+
+void FileRecordWriter::queueCurrentBuffer()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_fullBuffers.push_back(m_currentBuffer);
+    m_currentBuffer = nullptr;
+    m_queueCondition.wakeAll();
+}
+
+void FileRecordWriter::run()
+{
+    m_running = true;
+    m_startWaiter.wakeAll();
+
+    while (true)
+    {
+        m_mutex.lock();
+
+        while (m_fullBuffers.empty() && !m_stop) {
+            m_queueCondition.wait(&m_mutex);
+        }
+
+        if (m_fullBuffers.empty()) // stop requested and everything written
+        {
+            m_mutex.unlock();
+            break;
+        }
+
+        Buffer *buffer = m_fullBuffers.front();
+        m_fullBuffers.pop_front();
+        m_mutex.unlock();
+
+        writeBuffer(buffer);
+
+        m_mutex.lock();
+        m_freeBuffers.push_back(buffer);
+        m_mutex.unlock();
+    }
+
+    closeFileWriter();
+    m_running = false;
+}
+
+void FileRecordWriter::writeBuffer(Buffer *buffer)
+{
+    if (!buffer->m_fileName.isEmpty())
+    {
+        closeFileWriter();
+        openFileWriter(buffer->m_fileName);
+    }
+
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    if (m_directIO && (buffer->m_size % m_alignment != 0)) { // last block of the file
+        setDirectIO(false);
+    }
+
+    if (m_config.m_preallocateSize != 0) {
+        preallocate(buffer->m_size);
+    }
+
+    qint64 written = m_file.write(buffer->m_data, buffer->m_size);
+
+    if ((written < 0) && m_directIO) // some file systems accept the flag but not the writes
+    {
+        qWarning("FileRecordWriter::writeBuffer: direct write failed. Continue with buffered writes");
+        setDirectIO(false);
+        written = m_file.write(buffer->m_data, buffer->m_size);
+    }
+
+    if (written != (qint64) buffer->m_size)
+    {
+        qWarning("FileRecordWriter::writeBuffer: %s: wrote %lld of %u bytes: %s",
+            qPrintable(m_file.fileName()), written, buffer->m_size, qPrintable(m_file.errorString()));
+        m_writeErrorCount++;
+    }
+
+    if (written > 0)
+    {
+        m_fileOffset += written;
+        m_fileByteCount += written;
+        m_totalByteCount += written;
+    }
+}
+
+void FileRecordWriter::openFileWriter(const QString& fileName)
+{
+    m_file.setFileName(fileName);
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Unbuffered))
+    {
+        qWarning("FileRecordWriter::openFileWriter: cannot open %s: %s",
+            qPrintable(fileName), qPrintable(m_file.errorString()));
+        m_writeErrorCount++;
+        return;
+    }
+
+    m_mutex.lock();
+    m_fileName = fileName;
+    m_mutex.unlock();
+    m_fileIndex = m_nbFilesOpened++;
+    m_fileByteCount = 0;
+    m_fileOffset = 0;
+    m_preallocatedEnd = 0;
+    m_directIO = false;
+
+    if (m_config.m_directIO) {
+        setDirectIO(true);
+    }
+
+    qDebug("FileRecordWriter::openFileWriter: %s", qPrintable(fileName));
+}
+
+void FileRecordWriter::closeFileWriter()
+{
+    if (!m_file.isOpen()) {
+        return;
+    }
+
+    if ((m_preallocatedEnd > m_fileOffset) && (m_preallocatedEnd != (quint64) -1)) { // give back the space reserved past the end of file
+        m_file.resize(m_fileOffset);
+    }
+
+    m_file.close();
+}
+
+void FileRecordWriter::setDirectIO(bool directIO)
+{
+#if defined(__linux__) && defined(O_DIRECT)
+    int fd = m_file.handle();
+    int flags = fcntl(fd, F_GETFL);
+    flags = directIO ? flags | O_DIRECT : flags & ~O_DIRECT;
+
+    if (fcntl(fd, F_SETFL, flags) < 0)
+    {
+        qWarning("FileRecordWriter::setDirectIO: cannot %s direct I/O: %s",
+            directIO ? "set" : "clear", strerror(errno));
+        m_directIO = false;
+        return;
+    }
+
+    m_directIO = directIO;
+#else
+    if (directIO) {
+        qWarning("FileRecordWriter::setDirectIO: direct I/O is not supported on this system");
+    }
+
+    m_directIO = false;
+#endif
+}
+
+void FileRecordWriter::preallocate(quint64 size)
+{
+    if (m_fileOffset + size <= m_preallocatedEnd) {
+        return;
+    }
+
+#if defined(__linux__)
+    quint64 end = m_fileOffset + size + m_config.m_preallocateSize;
+
+    if (fallocate(m_file.handle(), FALLOC_FL_KEEP_SIZE, m_preallocatedEnd, end - m_preallocatedEnd) == 0)
+    {
+        m_preallocatedEnd = end;
+        return;
+    }
+
+    qDebug("FileRecordWriter::preallocate: not supported on this file system: %s", strerror(errno));
+#endif
+    m_preallocatedEnd = (quint64) -1; // do not try again for this file
+}
+
+void FileRecordWriter::allocateBuffers()
+{
+    freeBuffers();
+    m_buffers.reserve(m_config.m_nbBuffers);
+
+    for (unsigned int i = 0; i < m_config.m_nbBuffers; i++)
+    {
+        Buffer buffer;
+        buffer.m_size = 0;
+#if defined(_WIN32)
+        buffer.m_data = (char *) _aligned_malloc(m_config.m_bufferSize, m_alignment);
+#else
+        void *data;
+        buffer.m_data = posix_memalign(&data, m_alignment, m_config.m_bufferSize) == 0 ? (char *) data : nullptr;
+#endif
+        if (!buffer.m_data) {
+            break;
+        }
+
+        m_buffers.push_back(buffer);
+    }
+
+    for (std::vector<Buffer>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it) {
+        m_freeBuffers.push_back(&(*it));
+    }
+}
+
+void FileRecordWriter::freeBuffers()
+{
+    m_freeBuffers.clear();
+    m_fullBuffers.clear();
+
+    for (std::vector<Buffer>::iterator it = m_buffers.begin(); it != m_buffers.end(); ++it)
+    {
+#if defined(_WIN32)
+        _aligned_free(it->m_data);
+#else
+        free(it->m_data);
+#endif
+    }
+
+    m_buffers.clear();
+}
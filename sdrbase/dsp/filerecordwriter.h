@@ -0,0 +1,135 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDWRITER_H_
+#define SDRBASE_DSP_FILERECORDWRITER_H_
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QString>
+#include <QFile>
+
+#include "export.h"
+
+/**
+ * Writes a byte stream to disk on its own thread so that the thread producing the stream
+ * (usually the DSP device engine) never waits for the disk.
+ *
+ * The producer copies its data into one of a preallocated pool of large buffers aligned on
+ * a disk block boundary. Full buffers are queued to the writer thread and returned to the pool
+ * once written. When no buffer is available the data is dropped and an overrun is counted.
+ * A new file can be started at any point of the stream with openFile(). Files only end with a
+ * partial buffer so that every other write is a whole number of aligned blocks which makes it
+ * possible to use O_DIRECT where it is available.
+ */
+class SDRBASE_API FileRecordWriter : public QThread
+{
+    Q_OBJECT
+public:
+    static const unsigned int m_alignment = 4096; //!< buffer address and size alignment
+
+    struct Config
+    {
+        unsigned int m_bufferSize;   //!< bytes per buffer. Rounded up to a multiple of the alignment
+        unsigned int m_nbBuffers;    //!< number of buffers in the pool
+        bool m_directIO;             //!< bypass the page cache (Linux O_DIRECT)
+        quint64 m_preallocateSize;   //!< disk space reserved ahead of the write position (Linux fallocate). 0 for none
+
+        Config() :
+            m_bufferSize(4*1024*1024),
+            m_nbBuffers(16),
+            m_directIO(false),
+            m_preallocateSize(0)
+        {}
+    };
+
+    FileRecordWriter(QObject *parent = nullptr);
+    ~FileRecordWriter();
+
+    bool startWork(const Config& config); //!< allocates the buffers and starts the writer thread
+    void stopWork(); //!< flushes pending data, closes the file and stops the thread
+
+    // Producer side. Not thread safe with respect to each other: call from a single thread only.
+    void openFile(const QString& fileName); //!< the bytes written next go to a new file
+    quint64 write(const char *data, quint64 size); //!< returns the number of bytes queued. The rest is dropped
+    void flush(); //!< queues the buffer being filled even if it is not full
+
+    QString getFileName() const;
+    int getFileIndex() const { return m_fileIndex.load(); } //!< number of files opened minus one
+    quint64 getFileByteCount() const { return m_fileByteCount.load(); } //!< bytes written to disk in the current file
+    quint64 getTotalByteCount() const { return m_totalByteCount.load(); } //!< bytes written to disk since start
+    quint32 getOverrunCount() const { return m_overrunCount.load(); }
+    quint64 getDroppedByteCount() const { return m_droppedByteCount.load(); }
+    quint32 getWriteErrorCount() const { return m_writeErrorCount.load(); }
+    int getQueuedBuffers() const;
+    int getTotalBuffers() const { return m_buffers.size(); }
+
+private:
+    struct Buffer
+    {
+        char *m_data;
+        unsigned int m_size;  //!< bytes filled
+        QString m_fileName;   //!< when not empty the buffer starts this new file
+    };
+
+    Config m_config;
+    std::vector<Buffer> m_buffers;
+    std::deque<Buffer*> m_freeBuffers;
+    std::deque<Buffer*> m_fullBuffers;
+    Buffer *m_currentBuffer;  //!< being filled by the producer
+    QString m_nextFileName;   //!< file started by the next buffer
+    mutable QMutex m_mutex;
+    QWaitCondition m_queueCondition;
+    QMutex m_startWaitMutex;
+    QWaitCondition m_startWaiter;
+    volatile bool m_running;
+    bool m_stop;
+
+    // writer thread
+    QFile m_file;
+    QString m_fileName;       //!< guarded by m_mutex
+    quint64 m_fileOffset;
+    quint64 m_preallocatedEnd;
+    bool m_directIO;
+    int m_nbFilesOpened;
+
+    std::atomic<int> m_fileIndex;
+    std::atomic<quint64> m_fileByteCount;
+    std::atomic<quint64> m_totalByteCount;
+    std::atomic<quint32> m_overrunCount;
+    std::atomic<quint64> m_droppedByteCount;
+    std::atomic<quint32> m_writeErrorCount;
+
+    void run();
+    void allocateBuffers();
+    void freeBuffers();
+    bool acquireBuffer(); //!< producer: takes a free buffer as current buffer
+    void queueCurrentBuffer();
+    void writeBuffer(Buffer *buffer);
+    void openFileWriter(const QString& fileName);
+    void closeFileWriter();
+    void setDirectIO(bool directIO);
+    void preallocate(quint64 size);
+};
+
+#endif // SDRBASE_DSP_FILERECORDWRITER_H_
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "util/cpufeatures.h"
+#include "hbfilterkernels.h"
+
+// constant initialized so that they are valid before the dynamic initialization of m_kernel
+HBFilterKernels::Work32 HBFilterKernels::work32 = HBFilterKernels::work32Scalar;
+HBFilterKernels::Work64 HBFilterKernels::work64 = HBFilterKernels::work64Scalar;
+HBFilterKernels::Kernel HBFilterKernels::m_kernel = HBFilterKernels::selectBest();
+
+bool HBFilterKernels::isSupported(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelScalar:
+        return true;
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KernelSSE2:
+        return CPUFeatures::hasSSE2();
+    case KernelSSE41:
+        return CPUFeatures::hasSSE41();
+    case KernelAVX2:
+        return CPUFeatures::hasAVX2();
+#elif defined(ARCHITECTURE_ARM) || defined(ARCHITECTURE_ARM64)
+    case KernelNEON:
+        return CPUFeatures::hasNEON();
+#endif
+    default:
+        return false;
+    }
+}
+
+bool HBFilterKernels::setKernel(Kernel kernel)
+{
+    if (!isSupported(kernel)) {
+        return false;
+    }
+
+    switch (kernel)
+    {
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KernelSSE2:
+        work32 = work32SSE2;
+        work64 = work64SSE2;
+        break;
+    case KernelSSE41:
+        work32 = work32SSE41;
+        work64 = work64SSE41;
+        break;
+    case KernelAVX2:
+        work32 = work32AVX2;
+        work64 = work64AVX2;
+        break;
+#elif defined(ARCHITECTURE_ARM) || defined(ARCHITECTURE_ARM64)
+    case KernelNEON:
+        work32 = work32NEON;
+        work64 = work64NEON;
+        break;
+#endif
+    default:
+        work32 = work32Scalar;
+        work64 = work64Scalar;
+        break;
+    }
+
+    m_kernel = kernel;
+    return true;
+}
+
+const char *HBFilterKernels::getKernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelScalar:
+        return "scalar";
+    case KernelSSE2:
+        return "SSE2";
+    case KernelSSE41:
+        return "SSE4.1";
+    case KernelAVX2:
+        return "AVX2";
+    case KernelNEON:
+        return "NEON";
+    default:
+        return "unknown";
+    }
+}
+
+HBFilterKernels::Kernel HBFilterKernels::selectBest()
+{
+    static const Kernel preference[] = {KernelAVX2, KernelSSE41, KernelSSE2, KernelNEON};
+
+    for (unsigned int i = 0; i < sizeof(preference)/sizeof(preference[0]); i++)
+    {
+        if (setKernel(preference[i])) {
+            return preference[i];
+        }
+    }
+
+    return KernelScalar;
+}
+
+void HBFilterKernels::work32Scalar(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc)
+{
+    iAcc = 0;
+    qAcc = 0;
+
+    for (int k = 0; k < nbTaps; k++)
+    {
+        iAcc += ((qint32)(i[a] + i[b])) * h[k];
+        qAcc += ((qint32)(q[a] + q[b])) * h[k];
+        a -= 1;
+        b += 1;
+    }
+}
+
+void HBFilterKernels::work64Scalar(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc)
+{
+    iAcc = 0;
+    qAcc = 0;
+
+    for (int k = 0; k < nbTaps; k++)
+    {
+        iAcc += ((qint64)(i[a] + i[b])) * h[k];
+        qAcc += ((qint64)(q[a] + q[b])) * h[k];
+        a -= 1;
+        b += 1;
+    }
+}
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_HBFILTERKERNELS_H_
+#define SDRBASE_DSP_HBFILTERKERNELS_H_
+
+#include <QtGlobal>
+
+#include "export.h"
+
+/**
+ * Symmetrical taps of the integer even/odd half-band filters (IntHalfbandFilterEO) used in all
+ * the decimators and in the channelizers. The implementation is selected at runtime from the
+ * instruction sets of the CPU so that generic builds still run SIMD code. Computation is done
+ * in integers with the same wrap around as the scalar code so all implementations give bit
+ * identical results.
+ *
+ * Each SIMD implementation lives in its own translation unit compiled with the corresponding
+ * compiler flags. These units must not use anything else than intrinsics.
+ */
+class SDRBASE_API HBFilterKernels
+{
+public:
+    enum Kernel
+    {
+        KernelScalar,
+        KernelSSE2,
+        KernelSSE41,
+        KernelAVX2,
+        KernelNEON,
+        KernelEnd
+    };
+
+    /**
+     * I and Q accumulators of the symmetrical taps: acc = sum(k = 0 .. nbTaps-1) (x[a-k] + x[b+k]) * h[k]
+     * with x the I (i) and Q (q) storage rows. nbTaps is a multiple of 4.
+     */
+    typedef void (*Work32)(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc);
+    typedef void (*Work64)(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc);
+
+    static Work32 work32; //!< 32 bit storage and accumulator (16 bit Rx samples)
+    static Work64 work64; //!< 64 bit storage and accumulator (24 bit Rx samples). Stored values must fit in 32 bits.
+
+    static bool isSupported(Kernel kernel); //!< compiled in and supported by the CPU
+    static bool setKernel(Kernel kernel);   //!< use this implementation. Returns false and leaves the current one if not supported.
+    static Kernel getKernel() { return m_kernel; }
+    static const char *getKernelName(Kernel kernel);
+
+private:
+    static Kernel m_kernel;
+
+    static Kernel selectBest();
+
+    static void work32Scalar(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc);
+    static void work64Scalar(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc);
+    static void work32SSE2(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc);
+    static void work64SSE2(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc);
+    static void work32SSE41(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc);
+    static void work64SSE41(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc);
+    static void work32AVX2(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc);
+    static void work64AVX2(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc);
+    static void work32NEON(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc);
+    static void work64NEON(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc);
+};
+
+#endif // SDRBASE_DSP_HBFILTERKERNELS_H_
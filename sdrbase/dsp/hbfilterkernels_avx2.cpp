@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with AVX2 enabled. Only intrinsics here (see hbfilterkernels.h).
+
+#include <immintrin.h>
+
+#include "hbfilterkernels.h"
+
+void HBFilterKernels::work32AVX2(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc)
+{
+    const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    __m256i sumI = _mm256_setzero_si256();
+    __m256i sumQ = _mm256_setzero_si256();
+    __m256i sa, sb, c;
+    int k = 0;
+
+    for (; k + 8 <= nbTaps; k += 8)
+    {
+        c = _mm256_loadu_si256((const __m256i*) &h[k]);
+        sa = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &i[a-7]), reverse);
+        sb = _mm256_loadu_si256((const __m256i*) &i[b]);
+        sumI = _mm256_add_epi32(sumI, _mm256_mullo_epi32(_mm256_add_epi32(sa, sb), c));
+        sa = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*) &q[a-7]), reverse);
+        sb = _mm256_loadu_si256((const __m256i*) &q[b]);
+        sumQ = _mm256_add_epi32(sumQ, _mm256_mullo_epi32(_mm256_add_epi32(sa, sb), c));
+        a -= 8;
+        b += 8;
+    }
+
+    __m128i sI = _mm_add_epi32(_mm256_castsi256_si128(sumI), _mm256_extracti128_si256(sumI, 1));
+    __m128i sQ = _mm_add_epi32(_mm256_castsi256_si128(sumQ), _mm256_extracti128_si256(sumQ, 1));
+
+    if (k + 4 <= nbTaps) // order multiple of 16 but not 32
+    {
+        __m128i c4 = _mm_loadu_si128((const __m128i*) &h[k]);
+        __m128i sa4 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &i[a-3]), _MM_SHUFFLE(0,1,2,3));
+        __m128i sb4 = _mm_loadu_si128((const __m128i*) &i[b]);
+        sI = _mm_add_epi32(sI, _mm_mullo_epi32(_mm_add_epi32(sa4, sb4), c4));
+        sa4 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &q[a-3]), _MM_SHUFFLE(0,1,2,3));
+        sb4 = _mm_loadu_si128((const __m128i*) &q[b]);
+        sQ = _mm_add_epi32(sQ, _mm_mullo_epi32(_mm_add_epi32(sa4, sb4), c4));
+        a -= 4;
+        b += 4;
+        k += 4;
+    }
+
+    sI = _mm_add_epi32(sI, _mm_srli_si128(sI, 8));
+    sI = _mm_add_epi32(sI, _mm_srli_si128(sI, 4));
+    iAcc = _mm_cvtsi128_si32(sI);
+    sQ = _mm_add_epi32(sQ, _mm_srli_si128(sQ, 8));
+    sQ = _mm_add_epi32(sQ, _mm_srli_si128(sQ, 4));
+    qAcc = _mm_cvtsi128_si32(sQ);
+
+    for (; k < nbTaps; k++, a--, b++)
+    {
+        iAcc += ((qint32)(i[a] + i[b])) * h[k];
+        qAcc += ((qint32)(q[a] + q[b])) * h[k];
+    }
+}
+
+void HBFilterKernels::work64AVX2(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc)
+{
+    // stored values fit in 32 bits so each tap is a*h + b*h with 32x32->64 bit signed products
+    __m256i sumI = _mm256_setzero_si256();
+    __m256i sumQ = _mm256_setzero_si256();
+    __m256i sa, sb, c;
+    int k = 0;
+
+    for (; k + 4 <= nbTaps; k += 4)
+    {
+        c = _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*) &h[k]));
+        sa = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) &i[a-3]), _MM_SHUFFLE(0,1,2,3));
+        sb = _mm256_loadu_si256((const __m256i*) &i[b]);
+        sumI = _mm256_add_epi64(sumI, _mm256_add_epi64(_mm256_mul_epi32(sa, c), _mm256_mul_epi32(sb, c)));
+        sa = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i*) &q[a-3]), _MM_SHUFFLE(0,1,2,3));
+        sb = _mm256_loadu_si256((const __m256i*) &q[b]);
+        sumQ = _mm256_add_epi64(sumQ, _mm256_add_epi64(_mm256_mul_epi32(sa, c), _mm256_mul_epi32(sb, c)));
+        a -= 4;
+        b += 4;
+    }
+
+    __m128i sI = _mm_add_epi64(_mm256_castsi256_si128(sumI), _mm256_extracti128_si256(sumI, 1));
+    __m128i sQ = _mm_add_epi64(_mm256_castsi256_si128(sumQ), _mm256_extracti128_si256(sumQ, 1));
+    qint64 acc[4];
+    _mm_storeu_si128((__m128i*) &acc[0], sI);
+    _mm_storeu_si128((__m128i*) &acc[2], sQ);
+    iAcc = acc[0] + acc[1];
+    qAcc = acc[2] + acc[3];
+
+    for (; k < nbTaps; k++, a--, b++)
+    {
+        iAcc += ((qint64)(i[a] + i[b])) * h[k];
+        qAcc += ((qint64)(q[a] + q[b])) * h[k];
+    }
+}
@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with NEON enabled. Only intrinsics here (see hbfilterkernels.h).
+
+#include <arm_neon.h>
+
+#include "hbfilterkernels.h"
+
+void HBFilterKernels::work32NEON(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc)
+{
+    int32x4_t sumI = vdupq_n_s32(0);
+    int32x4_t sumQ = vdupq_n_s32(0);
+    int32x4_t sa, sb, c;
+    int k = 0;
+
+    for (; k + 4 <= nbTaps; k += 4)
+    {
+        c = vld1q_s32(&h[k]);
+        sa = vrev64q_s32(vld1q_s32(&i[a-3]));
+        sa = vcombine_s32(vget_high_s32(sa), vget_low_s32(sa));
+        sb = vld1q_s32(&i[b]);
+        sumI = vmlaq_s32(sumI, vaddq_s32(sa, sb), c);
+        sa = vrev64q_s32(vld1q_s32(&q[a-3]));
+        sa = vcombine_s32(vget_high_s32(sa), vget_low_s32(sa));
+        sb = vld1q_s32(&q[b]);
+        sumQ = vmlaq_s32(sumQ, vaddq_s32(sa, sb), c);
+        a -= 4;
+        b += 4;
+    }
+
+    iAcc = vgetq_lane_s32(sumI, 0) + vgetq_lane_s32(sumI, 1) + vgetq_lane_s32(sumI, 2) + vgetq_lane_s32(sumI, 3);
+    qAcc = vgetq_lane_s32(sumQ, 0) + vgetq_lane_s32(sumQ, 1) + vgetq_lane_s32(sumQ, 2) + vgetq_lane_s32(sumQ, 3);
+
+    for (; k < nbTaps; k++, a--, b++)
+    {
+        iAcc += ((qint32)(i[a] + i[b])) * h[k];
+        qAcc += ((qint32)(q[a] + q[b])) * h[k];
+    }
+}
+
+void HBFilterKernels::work64NEON(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc)
+{
+    // stored values fit in 32 bits so each tap is a*h + b*h with 32x32->64 bit signed products
+    int64x2_t sumI = vdupq_n_s64(0);
+    int64x2_t sumQ = vdupq_n_s64(0);
+    int32x2_t sa, sb, c;
+    int k = 0;
+
+    for (; k + 2 <= nbTaps; k += 2)
+    {
+        c = vld1_s32(&h[k]);
+        sa = vrev64_s32(vmovn_s64(vld1q_s64((const int64_t*) &i[a-1])));
+        sb = vmovn_s64(vld1q_s64((const int64_t*) &i[b]));
+        sumI = vmlal_s32(vmlal_s32(sumI, sa, c), sb, c);
+        sa = vrev64_s32(vmovn_s64(vld1q_s64((const int64_t*) &q[a-1])));
+        sb = vmovn_s64(vld1q_s64((const int64_t*) &q[b]));
+        sumQ = vmlal_s32(vmlal_s32(sumQ, sa, c), sb, c);
+        a -= 2;
+        b += 2;
+    }
+
+    iAcc = vgetq_lane_s64(sumI, 0) + vgetq_lane_s64(sumI, 1);
+    qAcc = vgetq_lane_s64(sumQ, 0) + vgetq_lane_s64(sumQ, 1);
+
+    for (; k < nbTaps; k++, a--, b++)
+    {
+        iAcc += ((qint64)(i[a] + i[b])) * h[k];
+        qAcc += ((qint64)(q[a] + q[b])) * h[k];
+    }
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with SSE2 enabled. Only intrinsics here (see hbfilterkernels.h).
+
+#include <emmintrin.h>
+
+#include "hbfilterkernels.h"
+
+namespace {
+
+/** Low 32 bits of the products of 4 x 32 bit integers (_mm_mullo_epi32 is SSE4.1) */
+inline __m128i mullo32(__m128i x, __m128i y)
+{
+    __m128i even = _mm_mul_epu32(x, y);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), _mm_srli_epi64(y, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+}
+
+/** Low 64 bits of the products of 2 x 64 bit integers i.e. the exact product when it fits */
+inline __m128i mullo64(__m128i x, __m128i y)
+{
+    __m128i lo = _mm_mul_epu32(x, y);
+    __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(x, 32), y), _mm_mul_epu32(x, _mm_srli_epi64(y, 32)));
+    return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+}
+
+} // namespace
+
+void HBFilterKernels::work32SSE2(const qint32 *i, const qint32 *q, int a, int b, const qint32 *h, int nbTaps, qint32& iAcc, qint32& qAcc)
+{
+    __m128i sumI = _mm_setzero_si128();
+    __m128i sumQ = _mm_setzero_si128();
+    __m128i sa, sb, c;
+    int k = 0;
+
+    for (; k + 4 <= nbTaps; k += 4)
+    {
+        c = _mm_loadu_si128((const __m128i*) &h[k]);
+        sa = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &i[a-3]), _MM_SHUFFLE(0,1,2,3));
+        sb = _mm_loadu_si128((const __m128i*) &i[b]);
+        sumI = _mm_add_epi32(sumI, mullo32(_mm_add_epi32(sa, sb), c));
+        sa = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &q[a-3]), _MM_SHUFFLE(0,1,2,3));
+        sb = _mm_loadu_si128((const __m128i*) &q[b]);
+        sumQ = _mm_add_epi32(sumQ, mullo32(_mm_add_epi32(sa, sb), c));
+        a -= 4;
+        b += 4;
+    }
+
+    sumI = _mm_add_epi32(sumI, _mm_srli_si128(sumI, 8));
+    sumI = _mm_add_epi32(sumI, _mm_srli_si128(sumI, 4));
+    iAcc = _mm_cvtsi128_si32(sumI);
+    sumQ = _mm_add_epi32(sumQ, _mm_srli_si128(sumQ, 8));
+    sumQ = _mm_add_epi32(sumQ, _mm_srli_si128(sumQ, 4));
+    qAcc = _mm_cvtsi128_si32(sumQ);
+
+    for (; k < nbTaps; k++, a--, b++)
+    {
+        iAcc += ((qint32)(i[a] + i[b])) * h[k];
+        qAcc += ((qint32)(q[a] + q[b])) * h[k];
+    }
+}
+
+void HBFilterKernels::work64SSE2(const qint64 *i, const qint64 *q, int a, int b, const qint32 *h, int nbTaps, qint64& iAcc, qint64& qAcc)
+{
+    __m128i sumI = _mm_setzero_si128();
+    __m128i sumQ = _mm_setzero_si128();
+    __m128i sa, sb, c;
+    int k = 0;
+
+    for (; k + 2 <= nbTaps; k += 2)
+    {
+        c = _mm_loadl_epi64((const __m128i*) &h[k]);
+        c = _mm_unpacklo_epi32(c, _mm_srai_epi32(c, 31)); // sign extend to 64 bits
+        sa = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &i[a-1]), _MM_SHUFFLE(1,0,3,2));
+        sb = _mm_loadu_si128((const __m128i*) &i[b]);
+        sumI = _mm_add_epi64(sumI, mullo64(_mm_add_epi64(sa, sb), c));
+        sa = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*) &q[a-1]), _MM_SHUFFLE(1,0,3,2));
+        sb = _mm_loadu_si128((const __m128i*) &q[b]);
+        sumQ = _mm_add_epi64(sumQ, mullo64(_mm_add_epi64(sa, sb), c));
+        a -= 2;
+        b += 2;
+    }
+
+    qint64 acc[4];
+    _mm_storeu_si128((__m128i*) &acc[0], sumI);
+    _mm_storeu_si128((__m128i*) &acc[2], sumQ);
+    iAcc = acc[0] + acc[1];
+    qAcc = acc[2] + acc[3];
+
+    for (; k < nbTaps; k++, a--, b++)
+    {
+        iAcc += ((qint64)(i[a] + i[b])) * h[k];
+        qAcc += ((qint64)(q[a] + q[b])) * h[k];
+    }
+}
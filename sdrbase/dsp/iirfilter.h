@@ -50,6 +50,7 @@ public:
     ~IIRFilter();
     void setCoeffs(const Type *a, const Type *b);
     Type run(const Type& sample);
+    void run(const Type *in, Type *out, int nbSamples); //!< same as run on each sample. in and out may be the same
 
 private:
     Type m_a[3];
@@ -158,4 +159,30 @@ Type IIRFilter<Type, 2>::run(const Type& sample)
     return y;
 }
 
+template <typename Type>
+void IIRFilter<Type, 2>::run(const Type *in, Type *out, int nbSamples)
+{
+    // keep coefficients and state in locals so that the loop does not go through memory
+    const Type a1 = m_a[1], a2 = m_a[2];
+    const Type b0 = m_b[0], b1 = m_b[1], b2 = m_b[2];
+    Type x0 = m_x[0], x1 = m_x[1];
+    Type y0 = m_y[0], y1 = m_y[1];
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        Type x = in[i];
+        Type y = b0*x + b1*x0 + b2*x1 + a1*y0 + a2*y1;
+        x1 = x0;
+        x0 = x;
+        y1 = y0;
+        y0 = y;
+        out[i] = y;
+    }
+
+    m_x[0] = x0;
+    m_x[1] = x1;
+    m_y[0] = y0;
+    m_y[1] = y1;
+}
+
 #endif /* SDRBASE_DSP_IIRFILTER_H_ */
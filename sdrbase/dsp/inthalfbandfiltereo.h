@@ -27,6 +27,7 @@
 #include <cstdlib>
 #include "dsp/dsptypes.h"
 #include "dsp/hbfiltertraits.h"
+#include "dsp/inthalfbandfiltereoi.h"
 
 template<typename EOStorageType, typename AccuType, uint32_t HBFilterOrder>
 class IntHalfbandFilterEO {
@@ -78,6 +79,114 @@ public:
         }
     }
 
+    /**
+     * Block version of workDecimateCenter. Works in place: the output samples are written at the
+     * start of the buffer. Returns the number of output samples.
+     */
+    int workDecimateCenterBlock(Sample* buf, int nbSamples)
+    {
+        int k = 0;
+
+        for (int i = 0; i < nbSamples; i++)
+        {
+            storeSample((FixReal) buf[i].real(), (FixReal) buf[i].imag());
+
+            if (m_state == 0)
+            {
+                advancePointer();
+                m_state = 1;
+            }
+            else
+            {
+                doFIR(&buf[k++]);
+                advancePointer();
+                m_state = 0;
+            }
+        }
+
+        return k;
+    }
+
+    /**
+     * Block version of workDecimateLowerHalf. Works in place: the output samples are written at the
+     * start of the buffer. Returns the number of output samples.
+     */
+    int workDecimateLowerHalfBlock(Sample* buf, int nbSamples)
+    {
+        int k = 0;
+
+        for (int i = 0; i < nbSamples; i++)
+        {
+            switch(m_state)
+            {
+                case 0:
+                    storeSample((FixReal) -buf[i].imag(), (FixReal) buf[i].real());
+                    advancePointer();
+                    m_state = 1;
+                    break;
+                case 1:
+                    storeSample((FixReal) -buf[i].real(), (FixReal) -buf[i].imag());
+                    doFIR(&buf[k++]);
+                    advancePointer();
+                    m_state = 2;
+                    break;
+                case 2:
+                    storeSample((FixReal) buf[i].imag(), (FixReal) -buf[i].real());
+                    advancePointer();
+                    m_state = 3;
+                    break;
+                default:
+                    storeSample((FixReal) buf[i].real(), (FixReal) buf[i].imag());
+                    doFIR(&buf[k++]);
+                    advancePointer();
+                    m_state = 0;
+                    break;
+            }
+        }
+
+        return k;
+    }
+
+    /**
+     * Block version of workDecimateUpperHalf. Works in place: the output samples are written at the
+     * start of the buffer. Returns the number of output samples.
+     */
+    int workDecimateUpperHalfBlock(Sample* buf, int nbSamples)
+    {
+        int k = 0;
+
+        for (int i = 0; i < nbSamples; i++)
+        {
+            switch(m_state)
+            {
+                case 0:
+                    storeSample((FixReal) buf[i].imag(), (FixReal) -buf[i].real());
+                    advancePointer();
+                    m_state = 1;
+                    break;
+                case 1:
+                    storeSample((FixReal) -buf[i].real(), (FixReal) -buf[i].imag());
+                    doFIR(&buf[k++]);
+                    advancePointer();
+                    m_state = 2;
+                    break;
+                case 2:
+                    storeSample((FixReal) -buf[i].imag(), (FixReal) buf[i].real());
+                    advancePointer();
+                    m_state = 3;
+                    break;
+                default:
+                    storeSample((FixReal) buf[i].real(), (FixReal) buf[i].imag());
+                    doFIR(&buf[k++]);
+                    advancePointer();
+                    m_state = 0;
+                    break;
+            }
+        }
+
+        return k;
+    }
+
     // upsample by 2, return center part of original spectrum - double buffer variant
     bool workInterpolateCenterZeroStuffing(Sample* sampleIn, Sample *SampleOut)
     {
@@ -839,28 +948,10 @@ protected:
 
     void doFIR(Sample* sample)
     {
-        AccuType iAcc = 0;
-        AccuType qAcc = 0;
-
-        int a = m_ptr/2 + m_size; // tip pointer
-        int b = m_ptr/2 + 1; // tail pointer
+        AccuType iAcc;
+        AccuType qAcc;
 
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
-        {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += ((EOStorageType)(m_even[0][a] + m_even[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_even[1][a] + m_even[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
-            {
-                iAcc += ((EOStorageType)(m_odd[0][a] + m_odd[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_odd[1][a] + m_odd[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-
-            a -= 1;
-            b += 1;
-        }
+        IntHalfbandFilterEOIntrinsics<EOStorageType, AccuType, HBFilterOrder>::work(m_ptr, m_even, m_odd, iAcc, qAcc);
 
         if ((m_ptr % 2) == 0)
         {
@@ -879,28 +970,10 @@ protected:
 
     void doFIR(int32_t *x, int32_t *y)
     {
-        AccuType iAcc = 0;
-        AccuType qAcc = 0;
-
-        int a = m_ptr/2 + m_size; // tip pointer
-        int b = m_ptr/2 + 1; // tail pointer
-
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
-        {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += ((EOStorageType)(m_even[0][a] + m_even[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_even[1][a] + m_even[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
-            {
-                iAcc += ((EOStorageType)(m_odd[0][a] + m_odd[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += ((EOStorageType)(m_odd[1][a] + m_odd[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
+        AccuType iAcc;
+        AccuType qAcc;
 
-            a -= 1;
-            b += 1;
-        }
+        IntHalfbandFilterEOIntrinsics<EOStorageType, AccuType, HBFilterOrder>::work(m_ptr, m_even, m_odd, iAcc, qAcc);
 
         if ((m_ptr % 2) == 0)
         {
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Integer half-band FIR based interpolator and decimator                        //
+// This is the SIMD part of the even/odd double buffer variant used for block    //
+// processing. Only the symmetrical taps are processed here. The result is the   //
+// same as the scalar implementation bit for bit.                                //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_INTHALFBANDFILTEREOI_H_
+#define SDRBASE_DSP_INTHALFBANDFILTEREOI_H_
+
+#include <stdint.h>
+#include <QtGlobal>
+
+#include "hbfilterkernels.h"
+#include "hbfiltertraits.h"
+
+/**
+ * Generic (scalar) version. Used for storage types without a SIMD implementation.
+ */
+template<typename EOStorageType, typename AccuType, uint32_t HBFilterOrder>
+class IntHalfbandFilterEOIntrinsics
+{
+public:
+    static void work(
+            int ptr,
+            const EOStorageType even[2][HBFilterOrder],
+            const EOStorageType odd[2][HBFilterOrder],
+            AccuType& iAcc, AccuType& qAcc)
+    {
+        const EOStorageType (*buf)[HBFilterOrder] = (ptr % 2) == 0 ? even : odd;
+        int a = ptr/2 + HBFIRFilterTraits<HBFilterOrder>::hbOrder/2; // tip pointer
+        int b = ptr/2 + 1; // tail pointer
+        iAcc = 0;
+        qAcc = 0;
+
+        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
+        {
+            iAcc += ((EOStorageType)(buf[0][a] + buf[0][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+            qAcc += ((EOStorageType)(buf[1][a] + buf[1][b])) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+            a -= 1;
+            b += 1;
+        }
+    }
+};
+
+/**
+ * 32 bit storage and accumulator (16 bit Rx samples). Products wrap modulo 2^32 like in the scalar version.
+ * The SSE2, SSE4.1, AVX2 or NEON implementation is chosen at runtime (see HBFilterKernels).
+ */
+template<uint32_t HBFilterOrder>
+class IntHalfbandFilterEOIntrinsics<qint32, qint32, HBFilterOrder>
+{
+public:
+    static void work(
+            int ptr,
+            const qint32 even[2][HBFilterOrder],
+            const qint32 odd[2][HBFilterOrder],
+            qint32& iAcc, qint32& qAcc)
+    {
+        const qint32 (*buf)[HBFilterOrder] = (ptr % 2) == 0 ? even : odd;
+        HBFilterKernels::work32(
+            buf[0],
+            buf[1],
+            ptr/2 + HBFIRFilterTraits<HBFilterOrder>::hbOrder/2, // tip pointer
+            ptr/2 + 1, // tail pointer
+            HBFIRFilterTraits<HBFilterOrder>::hbCoeffs,
+            HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4,
+            iAcc,
+            qAcc);
+    }
+};
+
+/**
+ * 64 bit storage and accumulator (24 bit Rx samples). Stored values always fit in 32 bits since
+ * they come from FixReal samples or from the 32 bit output of a previous stage.
+ * The SSE2, SSE4.1, AVX2 or NEON implementation is chosen at runtime (see HBFilterKernels).
+ */
+template<uint32_t HBFilterOrder>
+class IntHalfbandFilterEOIntrinsics<qint64, qint64, HBFilterOrder>
+{
+public:
+    static void work(
+            int ptr,
+            const qint64 even[2][HBFilterOrder],
+            const qint64 odd[2][HBFilterOrder],
+            qint64& iAcc, qint64& qAcc)
+    {
+        const qint64 (*buf)[HBFilterOrder] = (ptr % 2) == 0 ? even : odd;
+        HBFilterKernels::work64(
+            buf[0],
+            buf[1],
+            ptr/2 + HBFIRFilterTraits<HBFilterOrder>::hbOrder/2, // tip pointer
+            ptr/2 + 1, // tail pointer
+            HBFIRFilterTraits<HBFilterOrder>::hbCoeffs,
+            HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4,
+            iAcc,
+            qAcc);
+    }
+};
+
+#endif /* SDRBASE_DSP_INTHALFBANDFILTEREOI_H_ */
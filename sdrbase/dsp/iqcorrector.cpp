@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "util/cpufeatures.h"
+#include "iqcorrector.h"
+
+// constant initialized so that it is valid before the dynamic initialization of m_kernel
+IQCorrector::Apply IQCorrector::m_apply = IQCorrector::applyScalar;
+IQCorrector::Kernel IQCorrector::m_kernel = IQCorrector::selectBest();
+
+IQCorrector::IQCorrector() :
+    m_log2EstimationDecim(2)
+{
+    reset();
+}
+
+void IQCorrector::reset()
+{
+    m_initialized = false;
+    m_dcI = 0.0;
+    m_dcQ = 0.0;
+    m_covII = 0.0;
+    m_covIQ = 0.0;
+    m_covQQ = 0.0;
+    m_phi = 0.0f;
+    m_amp = 1.0f;
+
+    m_iBeta.reset();
+    m_qBeta.reset();
+    m_avgII.reset();
+    m_avgIQ.reset();
+    m_avgII2.reset();
+    m_avgQQ2.reset();
+    m_avgPhi.reset();
+    m_avgAmp.reset();
+}
+
+void IQCorrector::process(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
+{
+    int nbSamples = end - begin;
+
+    if (nbSamples <= 0) {
+        return;
+    }
+
+    Sample *samples = &(*begin);
+    estimate(samples, nbSamples, imbalanceCorrection);
+
+    if (imbalanceCorrection) {
+        m_apply(&samples[0].m_real, nbSamples, m_dcI, m_dcQ, m_phi, m_amp);
+    } else {
+        m_apply(&samples[0].m_real, nbSamples, m_dcI, m_dcQ, 0.0f, 1.0f);
+    }
+}
+
+void IQCorrector::estimate(const Sample *samples, int nbSamples, bool imbalanceCorrection)
+{
+    int step = 1 << m_log2EstimationDecim;
+    double sumI = 0.0, sumQ = 0.0, sumII = 0.0, sumIQ = 0.0, sumQQ = 0.0;
+    int count = 0;
+
+    if (imbalanceCorrection)
+    {
+        for (int i = 0; i < nbSamples; i += step, count++)
+        {
+            double xi = samples[i].m_real;
+            double xq = samples[i].m_imag;
+            sumI += xi;
+            sumQ += xq;
+            sumII += xi*xi;
+            sumIQ += xi*xq;
+            sumQQ += xq*xq;
+        }
+    }
+    else
+    {
+        for (int i = 0; i < nbSamples; i += step, count++)
+        {
+            sumI += samples[i].m_real;
+            sumQ += samples[i].m_imag;
+        }
+    }
+
+    double meanI = sumI / count;
+    double meanQ = sumQ / count;
+    // first order smoothing over the blocks with a time constant in samples independent of the block size
+    double alphaDC = m_initialized ? std::min(1.0, (double) nbSamples / m_dcTimeConstant) : 1.0;
+    m_dcI += alphaDC * (meanI - m_dcI);
+    m_dcQ += alphaDC * (meanQ - m_dcQ);
+
+    if (imbalanceCorrection)
+    {
+        // covariances of the block. Scale free so the float conversion of the old code is not needed.
+        double covII = sumII / count - meanI*meanI;
+        double covIQ = sumIQ / count - meanI*meanQ;
+        double covQQ = sumQQ / count - meanQ*meanQ;
+        double alphaIQ = m_initialized ? std::min(1.0, (double) nbSamples / m_imbalanceTimeConstant) : 1.0;
+        m_covII += alphaIQ * (covII - m_covII);
+        m_covIQ += alphaIQ * (covIQ - m_covIQ);
+        m_covQQ += alphaIQ * (covQQ - m_covQQ);
+
+        if (m_covII > 0.0)
+        {
+            // phase: Q" = Q - phi.I is orthogonal to I
+            double phi = m_covIQ / m_covII;
+            // amplitude: variance of Q" is <Q,Q> - phi.<I,Q>
+            double varQ2 = m_covQQ - phi * m_covIQ;
+            m_phi = phi;
+
+            if (varQ2 > 0.0) {
+                m_amp = sqrt(m_covII / varQ2);
+            }
+        }
+    }
+
+    m_initialized = true;
+}
+
+bool IQCorrector::isSupported(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelScalar:
+        return true;
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KernelSSE2:
+        return CPUFeatures::hasSSE2();
+    case KernelAVX2:
+        return CPUFeatures::hasAVX2();
+#elif defined(ARCHITECTURE_ARM) || defined(ARCHITECTURE_ARM64)
+    case KernelNEON:
+        return CPUFeatures::hasNEON();
+#endif
+    default:
+        return false;
+    }
+}
+
+bool IQCorrector::setKernel(Kernel kernel)
+{
+    if (!isSupported(kernel)) {
+        return false;
+    }
+
+    switch (kernel)
+    {
+#if defined(ARCHITECTURE_x86_64) || defined(ARCHITECTURE_x86)
+    case KernelSSE2:
+        m_apply = applySSE2;
+        break;
+    case KernelAVX2:
+        m_apply = applyAVX2;
+        break;
+#elif defined(ARCHITECTURE_ARM) || defined(ARCHITECTURE_ARM64)
+    case KernelNEON:
+        m_apply = applyNEON;
+        break;
+#endif
+    default:
+        m_apply = applyScalar;
+        break;
+    }
+
+    m_kernel = kernel;
+    return true;
+}
+
+const char *IQCorrector::getKernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelScalar:
+        return "scalar";
+    case KernelSSE2:
+        return "SSE2";
+    case KernelAVX2:
+        return "AVX2";
+    case KernelNEON:
+        return "NEON";
+    default:
+        return "unknown";
+    }
+}
+
+IQCorrector::Kernel IQCorrector::selectBest()
+{
+    static const Kernel preference[] = {KernelAVX2, KernelSSE2, KernelNEON};
+
+    for (unsigned int i = 0; i < sizeof(preference)/sizeof(preference[0]); i++)
+    {
+        if (setKernel(preference[i])) {
+            return preference[i];
+        }
+    }
+
+    return KernelScalar;
+}
+
+void IQCorrector::applyScalar(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp)
+{
+    for (int i = 0; i < nbSamples; i++, p += 2)
+    {
+        float zi = p[0] - dcI;
+        float zq = amp * ((p[1] - dcQ) - phi * zi);
+#if SDR_RX_SAMP_SZ == 16
+        long ri = lrintf(zi);
+        long rq = lrintf(zq);
+        p[0] = ri < -32768 ? -32768 : ri > 32767 ? 32767 : ri;
+        p[1] = rq < -32768 ? -32768 : rq > 32767 ? 32767 : rq;
+#else
+        p[0] = lrintf(zi);
+        p[1] = lrintf(zq);
+#endif
+    }
+}
+
+void IQCorrector::processPerSample(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
+{
+    for(SampleVector::iterator it = begin; it < end; it++)
+    {
+        m_iBeta(it->real());
+        m_qBeta(it->imag());
+
+        if (imbalanceCorrection)
+        {
+            // DC correction and conversion
+            float xi = (it->m_real - (int32_t) m_iBeta) / SDR_RX_SCALEF;
+            float xq = (it->m_imag - (int32_t) m_qBeta) / SDR_RX_SCALEF;
+
+            // phase imbalance
+            m_avgII(xi*xi); // <I", I">
+            m_avgIQ(xi*xq); // <I", Q">
+
+
+            if (m_avgII.asDouble() != 0) {
+                m_avgPhi(m_avgIQ.asDouble()/m_avgII.asDouble());
+            }
+
+            float& yi = xi; // the in phase remains the reference
+            float yq = xq - m_avgPhi.asDouble()*xi;
+
+            // amplitude I/Q imbalance
+            m_avgII2(yi*yi); // <I, I>
+            m_avgQQ2(yq*yq); // <Q, Q>
+
+            if (m_avgQQ2.asDouble() != 0) {
+                m_avgAmp(sqrt(m_avgII2.asDouble() / m_avgQQ2.asDouble()));
+            }
+
+            // final correction
+            float& zi = yi; // the in phase remains the reference
+            float zq = m_avgAmp.asDouble() * yq;
+
+            // convert and store
+            it->m_real = zi * SDR_RX_SCALEF;
+            it->m_imag = zq * SDR_RX_SCALEF;
+        }
+        else
+        {
+            // DC correction only
+            it->m_real -= (int32_t) m_iBeta;
+            it->m_imag -= (int32_t) m_qBeta;
+        }
+    }
+}
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_IQCORRECTOR_H_
+#define SDRBASE_DSP_IQCORRECTOR_H_
+
+#include "dsp/dsptypes.h"
+#include "util/movingaverage.h"
+#include "export.h"
+
+/**
+ * DC offset and IQ imbalance correction of the device samples.
+ *
+ * process() estimates the DC, phase and amplitude coefficients once per block from a decimated
+ * subset of the samples then applies them to the whole block with a SIMD kernel.
+ * processPerSample() is the former per sample moving average implementation kept as a reference.
+ *
+ * The kernel is selected at runtime from the instruction sets of the CPU like the half-band filter
+ * kernels (see hbfilterkernels.h). Each SIMD kernel lives in its own translation unit compiled with
+ * the corresponding compiler flags and only uses intrinsics.
+ */
+class SDRBASE_API IQCorrector
+{
+public:
+    enum Kernel
+    {
+        KernelScalar,
+        KernelSSE2,
+        KernelAVX2,
+        KernelNEON,
+        KernelEnd
+    };
+
+    IQCorrector();
+
+    void reset();
+    /** Use one sample out of 2^log2Decim for the estimation of the coefficients */
+    void setEstimationDecimation(unsigned int log2Decim) { m_log2EstimationDecim = log2Decim; }
+    void process(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection);
+    void processPerSample(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection);
+
+    float getDCI() const { return m_dcI; }
+    float getDCQ() const { return m_dcQ; }
+    float getPhi() const { return m_phi; }
+    float getAmp() const { return m_amp; }
+
+    static bool isSupported(Kernel kernel); //!< compiled in and supported by the CPU
+    static bool setKernel(Kernel kernel);   //!< use this implementation. Returns false and leaves the current one if not supported.
+    static Kernel getKernel() { return m_kernel; }
+    static const char *getKernelName(Kernel kernel);
+
+private:
+    static const int m_dcTimeConstant = 1024;        //!< samples
+    static const int m_imbalanceTimeConstant = 16384; //!< samples
+
+    unsigned int m_log2EstimationDecim;
+    bool m_initialized;
+    double m_dcI;
+    double m_dcQ;
+    double m_covII;
+    double m_covIQ;
+    double m_covQQ;
+    float m_phi;
+    float m_amp;
+
+    // per sample implementation
+    MovingAverageUtil<int32_t, int64_t, 1024> m_iBeta;
+    MovingAverageUtil<int32_t, int64_t, 1024> m_qBeta;
+    MovingAverageUtil<float, double, 128> m_avgII;
+    MovingAverageUtil<float, double, 128> m_avgIQ;
+    MovingAverageUtil<float, double, 128> m_avgII2;
+    MovingAverageUtil<float, double, 128> m_avgQQ2;
+    MovingAverageUtil<double, double, 128> m_avgPhi;
+    MovingAverageUtil<double, double, 128> m_avgAmp;
+
+    /**
+     * Correct nbSamples interleaved I/Q values in place: zi = xi - dcI, zq = amp * ((xq - dcQ) - phi * zi)
+     * rounded to nearest and saturated to the sample size.
+     */
+    typedef void (*Apply)(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp);
+
+    static Apply m_apply;
+    static Kernel m_kernel;
+
+    static Kernel selectBest();
+
+    void estimate(const Sample *samples, int nbSamples, bool imbalanceCorrection);
+
+    static void applyScalar(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp);
+    static void applySSE2(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp);
+    static void applyAVX2(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp);
+    static void applyNEON(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp);
+};
+
+#endif // SDRBASE_DSP_IQCORRECTOR_H_
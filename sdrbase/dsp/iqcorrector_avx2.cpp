@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with AVX2 enabled. Only intrinsics here (see iqcorrector.h).
+
+#include <immintrin.h>
+
+#include "iqcorrector.h"
+
+void IQCorrector::applyAVX2(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp)
+{
+    // z = (x - dc) then zq = amp * (zq - phi * zi). Lanes are interleaved I, Q.
+    const __m256 dc = _mm256_setr_ps(dcI, dcQ, dcI, dcQ, dcI, dcQ, dcI, dcQ);
+    const __m256 ph = _mm256_setr_ps(0.0f, phi, 0.0f, phi, 0.0f, phi, 0.0f, phi);
+    const __m256 am = _mm256_setr_ps(1.0f, amp, 1.0f, amp, 1.0f, amp, 1.0f, amp);
+    int i = 0;
+
+#if SDR_RX_SAMP_SZ == 16
+    for (; i + 8 <= nbSamples; i += 8, p += 16)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*) p);
+        // in lane sign extension to 32 bits: lo has samples 0,1 4,5 and hi 2,3 6,7. packs restores the order.
+        __m256 lo = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_unpacklo_epi16(v, v), 16));
+        __m256 hi = _mm256_cvtepi32_ps(_mm256_srai_epi32(_mm256_unpackhi_epi16(v, v), 16));
+        lo = _mm256_sub_ps(lo, dc);
+        hi = _mm256_sub_ps(hi, dc);
+        lo = _mm256_mul_ps(_mm256_sub_ps(lo, _mm256_mul_ps(ph, _mm256_shuffle_ps(lo, lo, _MM_SHUFFLE(2,2,0,0)))), am);
+        hi = _mm256_mul_ps(_mm256_sub_ps(hi, _mm256_mul_ps(ph, _mm256_shuffle_ps(hi, hi, _MM_SHUFFLE(2,2,0,0)))), am);
+        _mm256_storeu_si256((__m256i*) p, _mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi)));
+    }
+#else
+    for (; i + 4 <= nbSamples; i += 4, p += 8)
+    {
+        __m256 x = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*) p)), dc);
+        x = _mm256_mul_ps(_mm256_sub_ps(x, _mm256_mul_ps(ph, _mm256_shuffle_ps(x, x, _MM_SHUFFLE(2,2,0,0)))), am);
+        _mm256_storeu_si256((__m256i*) p, _mm256_cvtps_epi32(x));
+    }
+#endif
+
+    applyScalar(p, nbSamples - i, dcI, dcQ, phi, amp);
+}
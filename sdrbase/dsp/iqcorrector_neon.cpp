@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with NEON enabled. Only intrinsics here (see iqcorrector.h).
+
+#include <arm_neon.h>
+
+#include "iqcorrector.h"
+
+static inline int32x4_t roundToInt(float32x4_t v)
+{
+#if defined(__aarch64__)
+    return vcvtnq_s32_f32(v);
+#else
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(v), vdupq_n_u32(0x80000000));
+    float32x4_t half = vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(vdupq_n_f32(0.5f)), sign));
+    return vcvtq_s32_f32(vaddq_f32(v, half));
+#endif
+}
+
+void IQCorrector::applyNEON(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp)
+{
+    // z = (x - dc) then zq = amp * (zq - phi * zi). Lanes are interleaved I, Q.
+    const float dcArr[4] = {dcI, dcQ, dcI, dcQ};
+    const float phArr[4] = {0.0f, phi, 0.0f, phi};
+    const float amArr[4] = {1.0f, amp, 1.0f, amp};
+    const float32x4_t dc = vld1q_f32(dcArr);
+    const float32x4_t ph = vld1q_f32(phArr);
+    const float32x4_t am = vld1q_f32(amArr);
+    int i = 0;
+
+#if SDR_RX_SAMP_SZ == 16
+    for (; i + 4 <= nbSamples; i += 4, p += 8)
+    {
+        int16x8_t v = vld1q_s16(p);
+        float32x4_t lo = vsubq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), dc);
+        float32x4_t hi = vsubq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), dc);
+        lo = vmulq_f32(vmlsq_f32(lo, ph, vtrnq_f32(lo, lo).val[0]), am);
+        hi = vmulq_f32(vmlsq_f32(hi, ph, vtrnq_f32(hi, hi).val[0]), am);
+        vst1q_s16(p, vcombine_s16(vqmovn_s32(roundToInt(lo)), vqmovn_s32(roundToInt(hi))));
+    }
+#else
+    for (; i + 2 <= nbSamples; i += 2, p += 4)
+    {
+        float32x4_t x = vsubq_f32(vcvtq_f32_s32(vld1q_s32(p)), dc);
+        x = vmulq_f32(vmlsq_f32(x, ph, vtrnq_f32(x, x).val[0]), am);
+        vst1q_s32(p, roundToInt(x));
+    }
+#endif
+
+    applyScalar(p, nbSamples - i, dcI, dcQ, phi, amp);
+}
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+// Compiled with SSE2 enabled. Only intrinsics here (see iqcorrector.h).
+
+#include <emmintrin.h>
+
+#include "iqcorrector.h"
+
+void IQCorrector::applySSE2(FixReal *p, int nbSamples, float dcI, float dcQ, float phi, float amp)
+{
+    // z = (x - dc) then zq = amp * (zq - phi * zi). Lanes are interleaved I, Q.
+    const __m128 dc = _mm_setr_ps(dcI, dcQ, dcI, dcQ);
+    const __m128 ph = _mm_setr_ps(0.0f, phi, 0.0f, phi);
+    const __m128 am = _mm_setr_ps(1.0f, amp, 1.0f, amp);
+    int i = 0;
+
+#if SDR_RX_SAMP_SZ == 16
+    for (; i + 4 <= nbSamples; i += 4, p += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) p);
+        __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+        __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+        lo = _mm_sub_ps(lo, dc);
+        hi = _mm_sub_ps(hi, dc);
+        lo = _mm_mul_ps(_mm_sub_ps(lo, _mm_mul_ps(ph, _mm_shuffle_ps(lo, lo, _MM_SHUFFLE(2,2,0,0)))), am);
+        hi = _mm_mul_ps(_mm_sub_ps(hi, _mm_mul_ps(ph, _mm_shuffle_ps(hi, hi, _MM_SHUFFLE(2,2,0,0)))), am);
+        _mm_storeu_si128((__m128i*) p, _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi)));
+    }
+#else
+    for (; i + 2 <= nbSamples; i += 2, p += 4)
+    {
+        __m128 x = _mm_sub_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) p)), dc);
+        x = _mm_mul_ps(_mm_sub_ps(x, _mm_mul_ps(ph, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2,2,0,0)))), am);
+        _mm_storeu_si128((__m128i*) p, _mm_cvtps_epi32(x));
+    }
+#endif
+
+    applyScalar(p, nbSamples - i, dcI, dcQ, phi, amp);
+}
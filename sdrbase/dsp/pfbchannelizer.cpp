@@ -0,0 +1,268 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <QDebug>
+
+#include "dsp/fftengine.h"
+#include "dsp/dspcommands.h"
+#include "dsp/threadedbasebandsamplesink.h"
+#include "pfbchannelizer.h"
+
+PFBChannelizer::PFBChannelizer() :
+    m_log2NbSubbands(0),
+    m_nbSubbands(1),
+    m_sampleRate(0),
+    m_historyIndex(0),
+    m_sampleCount(0),
+    m_oddFrame(false),
+    m_fft(nullptr)
+{
+}
+
+PFBChannelizer::~PFBChannelizer()
+{
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it) {
+        delete *it;
+    }
+
+    delete m_fft;
+}
+
+void PFBChannelizer::configure(unsigned int log2NbSubbands, int sampleRate)
+{
+    log2NbSubbands = log2NbSubbands < 1 ? 1 : log2NbSubbands;
+
+    if ((log2NbSubbands == m_log2NbSubbands) && (sampleRate == m_sampleRate) && m_fft) {
+        return;
+    }
+
+    m_log2NbSubbands = log2NbSubbands;
+    m_nbSubbands = 1 << m_log2NbSubbands;
+    m_sampleRate = sampleRate;
+
+    createPrototype();
+    m_history.assign(2 * m_prototype.size(), Complex{0.0, 0.0});
+    m_historyIndex = 0;
+    m_sampleCount = 0;
+    m_oddFrame = false;
+
+    if (!m_fft) {
+        m_fft = FFTEngine::create();
+    }
+
+    m_fft->configure(m_nbSubbands, true);
+
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it) {
+        assignSubband(*it);
+    }
+
+    qDebug("PFBChannelizer::configure: %u sub-bands spacing: %d Hz sub-band rate: %d S/s",
+        m_nbSubbands, getSubbandSpacing(), getSubbandSampleRate());
+}
+
+int PFBChannelizer::addChannel(ThreadedBasebandSampleSink *sink, qint64 frequencyOffset)
+{
+    Channel *channel = nullptr;
+
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        if ((*it)->m_sink == sink)
+        {
+            channel = *it;
+            break;
+        }
+    }
+
+    if (!channel)
+    {
+        channel = new Channel(sink);
+        m_channels.push_back(channel);
+    }
+
+    channel->m_frequencyOffset = frequencyOffset;
+    assignSubband(channel);
+
+    return channel->m_subband;
+}
+
+void PFBChannelizer::removeChannel(ThreadedBasebandSampleSink *sink)
+{
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        if ((*it)->m_sink == sink)
+        {
+            delete *it;
+            m_channels.erase(it);
+            return;
+        }
+    }
+}
+
+bool PFBChannelizer::hasChannel(const ThreadedBasebandSampleSink *sink) const
+{
+    for (std::list<Channel*>::const_iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        if ((*it)->m_sink == sink) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PFBChannelizer::notifyChannels(quint64 centerFrequency)
+{
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        DSPSignalNotification notif(getSubbandSampleRate(), centerFrequency + (*it)->m_frequencyOffset);
+        (*it)->m_sink->handleSinkMessage(notif);
+    }
+}
+
+void PFBChannelizer::startChannels()
+{
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it) {
+        (*it)->m_sink->start();
+    }
+}
+
+void PFBChannelizer::stopChannels()
+{
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it) {
+        (*it)->m_sink->stop();
+    }
+}
+
+void PFBChannelizer::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+{
+    if (!m_fft || (m_channels.size() == 0)) {
+        return;
+    }
+
+    unsigned int historySize = m_prototype.size();
+    unsigned int decimation = m_nbSubbands / 2;
+
+    for (SampleVector::const_iterator it = begin; it != end; ++it)
+    {
+        Complex c(it->real(), it->imag());
+        m_history[m_historyIndex] = c;
+        m_history[m_historyIndex + historySize] = c;
+
+        if (++m_sampleCount == decimation)
+        {
+            runFilterBank();
+            m_sampleCount = 0;
+        }
+
+        m_historyIndex = m_historyIndex + 1 < historySize ? m_historyIndex + 1 : 0;
+    }
+
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        SampleVector::const_iterator cbegin = (*it)->m_samples.begin();
+        SampleVector::const_iterator cend = (*it)->m_samples.end();
+        (*it)->m_sink->feed(cbegin, cend, false);
+        (*it)->m_samples.clear();
+    }
+}
+
+void PFBChannelizer::runFilterBank()
+{
+    // fold the weighted history in N branches. The newest sample is at index m_historyIndex + historySize.
+    unsigned int historySize = m_prototype.size();
+    const Complex *newest = &m_history[m_historyIndex + historySize];
+    Complex *fftIn = m_fft->in();
+
+    for (unsigned int q = 0; q < m_nbSubbands; q++)
+    {
+        Complex acc(0.0, 0.0);
+
+        for (unsigned int l = 0; l < m_tapsPerBranch; l++)
+        {
+            unsigned int r = q + l * m_nbSubbands;
+            acc += *(newest - r) * m_prototype[r];
+        }
+
+        fftIn[q] = acc;
+    }
+
+    // inverse DFT gives the sub-bands mixed down to zero frequency
+    m_fft->transform();
+    const Complex *fftOut = m_fft->out();
+
+    for (std::list<Channel*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it)
+    {
+        Channel *channel = *it;
+        Complex c = fftOut[channel->m_subband];
+
+        if (m_oddFrame && (channel->m_subband & 1)) { // time shift of N/2 between frames
+            c = -c;
+        }
+
+        c *= channel->m_nco.nextIQ();
+        channel->m_samples.push_back(Sample(lrintf(c.real()), lrintf(c.imag())));
+    }
+
+    m_oddFrame = !m_oddFrame;
+}
+
+void PFBChannelizer::createPrototype()
+{
+    // windowed sinc. The -6 dB point is at 3/4 of the sub-band spacing so that the
+    // band covered by one sub-band overlaps its neighbours by half a spacing
+    unsigned int length = m_nbSubbands * m_tapsPerBranch;
+    m_prototype.resize(length);
+    double fc = 0.75 / m_nbSubbands;
+    double sum = 0.0;
+
+    for (unsigned int i = 0; i < length; i++)
+    {
+        double x = i - (length - 1) / 2.0;
+        double sinc = x == 0.0 ? 2.0 * fc : sin(2.0 * M_PI * fc * x) / (M_PI * x);
+        double w = 0.35875
+            - 0.48829 * cos((2.0 * M_PI * i) / (length - 1))
+            + 0.14128 * cos((4.0 * M_PI * i) / (length - 1))
+            - 0.01168 * cos((6.0 * M_PI * i) / (length - 1)); // Blackman-Harris
+        m_prototype[i] = sinc * w;
+        sum += m_prototype[i];
+    }
+
+    for (unsigned int i = 0; i < length; i++) {
+        m_prototype[i] /= sum; // unity gain
+    }
+}
+
+void PFBChannelizer::assignSubband(Channel *channel)
+{
+    if (m_sampleRate == 0) {
+        return;
+    }
+
+    int spacing = getSubbandSpacing();
+    int k = (int) roundf((float) channel->m_frequencyOffset / spacing);
+    qint64 fineOffset = channel->m_frequencyOffset - (qint64) k * spacing;
+    channel->m_subband = k < 0 ? m_nbSubbands + k : k;
+    channel->m_subband %= m_nbSubbands;
+    channel->m_nco.setFreq(-fineOffset, getSubbandSampleRate());
+
+    qDebug("PFBChannelizer::assignSubband: %s offset: %lld sub-band: %u fine offset: %lld",
+        qPrintable(channel->m_sink->getSampleSinkObjectName()),
+        channel->m_frequencyOffset, channel->m_subband, fineOffset);
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Polyphase filter bank channelizer shared by all channels of a source device.  //
+// The baseband is split once into N uniformly spaced sub-bands with a 2x        //
+// oversampled analysis filter bank (decimation by N/2) so that a channel close  //
+// to a sub-band edge is not aliased. Each subscribed channel takes the sub-band //
+// nearest to its frequency and a fine NCO shifts it to zero frequency.          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_PFBCHANNELIZER_H_
+#define SDRBASE_DSP_PFBCHANNELIZER_H_
+
+#include <vector>
+#include <list>
+
+#include "dsp/dsptypes.h"
+#include "dsp/ncof.h"
+#include "export.h"
+
+class FFTEngine;
+class ThreadedBasebandSampleSink;
+
+class SDRBASE_API PFBChannelizer
+{
+public:
+    PFBChannelizer();
+    ~PFBChannelizer();
+
+    /** Set the number of sub-bands as a power of two and the input sample rate */
+    void configure(unsigned int log2NbSubbands, int sampleRate);
+    /** Subscribe a channel sink or update its frequency offset relative to the device center frequency. Returns the sub-band index */
+    int addChannel(ThreadedBasebandSampleSink *sink, qint64 frequencyOffset);
+    void removeChannel(ThreadedBasebandSampleSink *sink);
+    /** Send the sub-band sample rate and the channel center frequency to all channels */
+    void notifyChannels(quint64 centerFrequency);
+    void startChannels();
+    void stopChannels();
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end);
+
+    bool hasChannels() const { return m_channels.size() != 0; }
+    bool hasChannel(const ThreadedBasebandSampleSink *sink) const;
+    unsigned int getNbSubbands() const { return m_nbSubbands; }
+    int getSubbandSpacing() const { return m_sampleRate / m_nbSubbands; }
+    int getSubbandSampleRate() const { return (2 * m_sampleRate) / m_nbSubbands; }
+
+private:
+    struct Channel
+    {
+        ThreadedBasebandSampleSink *m_sink;
+        qint64 m_frequencyOffset;
+        unsigned int m_subband;
+        NCOF m_nco;       //!< fine shift from the sub-band center to the channel center
+        SampleVector m_samples;
+
+        Channel(ThreadedBasebandSampleSink *sink) :
+            m_sink(sink),
+            m_frequencyOffset(0),
+            m_subband(0)
+        {}
+    };
+
+    static const unsigned int m_tapsPerBranch = 12;
+
+    unsigned int m_log2NbSubbands;
+    unsigned int m_nbSubbands;
+    int m_sampleRate;
+    std::vector<Real> m_prototype;  //!< prototype low pass filter of m_nbSubbands * m_tapsPerBranch taps
+    std::vector<Complex> m_history; //!< double buffered input history
+    unsigned int m_historyIndex;
+    unsigned int m_sampleCount;     //!< input samples since last filter bank output
+    bool m_oddFrame;                //!< sub-band k output is multiplied by (-1)^(k*m)
+    FFTEngine *m_fft;
+    std::list<Channel*> m_channels;
+
+    void createPrototype();
+    void assignSubband(Channel *channel);
+    void runFilterBank();
+};
+
+#endif /* SDRBASE_DSP_PFBCHANNELIZER_H_ */
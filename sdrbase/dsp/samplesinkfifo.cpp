@@ -23,52 +23,61 @@
 void SampleSinkFifo::create(uint s)
 {
 	m_size = 0;
-	m_fill = 0;
+	m_fill.storeRelease(0);
+	m_wakeupPending.storeRelease(0);
 	m_head = 0;
 	m_tail = 0;
 
-	m_data.resize(s);
-	m_size = m_data.size();
+	m_data.resize(m_mirrored ? 2*s : s);
+	m_size = m_mirrored ? m_data.size() / 2 : m_data.size();
 
 	if(m_size != s)
 		qCritical("SampleSinkFifo: out of memory");
+
+	m_profile.setSize(m_size);
 }
 
 SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_size(0),
+	m_mirrored(false),
+	m_fill(0),
+	m_wakeupPending(0),
+	m_tail(0),
+	m_suppressed(-1),
+	m_writeToBuffer(false),
+	m_head(0)
 {
-	m_suppressed = -1;
-	m_size = 0;
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
 }
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
 	QObject(parent),
-	m_data()
+	m_data(),
+	m_mirrored(false),
+	m_suppressed(-1),
+	m_writeToBuffer(false)
 {
-	m_suppressed = -1;
-
 	create(size);
 }
 
 SampleSinkFifo::SampleSinkFifo(const SampleSinkFifo& other) :
     QObject(other.parent()),
-    m_data(other.m_data)
+    m_data(other.m_data),
+    m_mirrored(other.m_mirrored),
+    m_fill(0),
+    m_wakeupPending(0),
+    m_tail(0),
+    m_suppressed(-1),
+    m_writeToBuffer(false),
+    m_head(0)
 {
-  	m_suppressed = -1;
-	m_size = m_data.size();
-	m_fill = 0;
-	m_head = 0;
-	m_tail = 0;
+	m_size = m_mirrored ? m_data.size() / 2 : m_data.size();
+	m_profile.setSize(m_size);
 }
 
 SampleSinkFifo::~SampleSinkFifo()
 {
-	QMutexLocker mutexLocker(&m_mutex);
-
 	m_size = 0;
 }
 
@@ -76,34 +85,54 @@ bool SampleSinkFifo::setSize(int size)
 {
 	create(size);
 
-	return m_data.size() == (uint)size;
+	return m_size == (uint)size;
 }
 
-uint SampleSinkFifo::write(const quint8* data, uint count)
+void SampleSinkFifo::setMirrored(bool mirrored)
 {
-	QMutexLocker mutexLocker(&m_mutex);
-	uint total;
-	uint remaining;
-	uint len;
-	const Sample* begin = (const Sample*)data;
-	count /= sizeof(Sample);
+	m_mirrored = mirrored;
+}
 
-	total = MIN(count, m_size - m_fill);
-	if(total < count) {
-		if(m_suppressed < 0) {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
+void SampleSinkFifo::overflow(uint count, uint total)
+{
+	m_profile.dropped(count - total);
+
+	if(m_suppressed < 0) {
+		m_suppressed = 0;
+		m_msgRateTimer.start();
+		qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
+	} else {
+		if(m_msgRateTimer.elapsed() > 2500) {
+			qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
 			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
+			m_suppressed = -1;
 		} else {
-			if(m_msgRateTimer.elapsed() > 2500) {
-				qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			} else {
-				m_suppressed++;
-			}
+			m_suppressed++;
 		}
 	}
+}
+
+void SampleSinkFifo::commitWrite(uint count)
+{
+	// publish the samples then wake up the consumer unless a wake up is already pending
+	uint fill = m_fill.fetchAndAddOrdered(count) + count;
+	m_profile.transferred(count, fill);
+
+	if ((fill > 0) && (m_wakeupPending.fetchAndStoreOrdered(1) == 0))
+		emit dataReady();
+}
+
+uint SampleSinkFifo::write(const quint8* data, uint count)
+{
+	const Sample* begin = (const Sample*)data;
+	count /= sizeof(Sample);
+	uint total;
+	uint remaining;
+	uint len;
+
+	total = MIN(count, m_size - m_fill.loadAcquire());
+	if(total < count)
+		overflow(count, total);
 
 	remaining = total;
 	while(remaining > 0) {
@@ -111,41 +140,25 @@ uint SampleSinkFifo::write(const quint8* data, uint count)
 		std::copy(begin, begin + len, m_data.begin() + m_tail);
 		m_tail += len;
 		m_tail %= m_size;
-		m_fill += len;
 		begin += len;
 		remaining -= len;
 	}
 
-	if(m_fill > 0)
-		emit dataReady();
+	commitWrite(total);
 
 	return total;
 }
 
 uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
 	uint count = end - begin;
 	uint total;
 	uint remaining;
 	uint len;
 
-	total = MIN(count, m_size - m_fill);
-	if(total < count) {
-		if(m_suppressed < 0) {
-			m_suppressed = 0;
-			m_msgRateTimer.start();
-			qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-		} else {
-			if(m_msgRateTimer.elapsed() > 2500) {
-				qCritical("SampleSinkFifo: %u messages dropped", m_suppressed);
-				qCritical("SampleSinkFifo: overflow - dropping %u samples", count - total);
-				m_suppressed = -1;
-			} else {
-				m_suppressed++;
-			}
-		}
-	}
+	total = MIN(count, m_size - m_fill.loadAcquire());
+	if(total < count)
+		overflow(count, total);
 
 	remaining = total;
 	while(remaining > 0) {
@@ -153,26 +166,67 @@ uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::con
 		std::copy(begin, begin + len, m_data.begin() + m_tail);
 		m_tail += len;
 		m_tail %= m_size;
-		m_fill += len;
 		begin += len;
 		remaining -= len;
 	}
 
-	if(m_fill > 0)
-		emit dataReady();
+	commitWrite(total);
 
 	return total;
 }
 
+SampleVector::iterator SampleSinkFifo::writeReserve(uint count)
+{
+	// the free space only grows while the consumer reads so the region stays free until committed
+	uint free = m_size - m_fill.loadAcquire();
+
+	if ((count <= free) && (m_mirrored || (m_tail + count <= m_size)))
+	{
+		// in mirrored mode the part past the end is moved to the start at commit
+		m_writeToBuffer = false;
+		return m_data.begin() + m_tail;
+	}
+	else
+	{
+		if (m_writeBuffer.size() < count) {
+			m_writeBuffer.resize(count);
+		}
+
+		m_writeToBuffer = true;
+		return m_writeBuffer.begin();
+	}
+}
+
+uint SampleSinkFifo::writeCommit(uint count)
+{
+	if (m_writeToBuffer)
+	{
+		m_writeToBuffer = false;
+		return write(m_writeBuffer.begin(), m_writeBuffer.begin() + count);
+	}
+
+	if (m_tail + count > m_size)
+	{
+		SampleVector::iterator wrapBegin = m_data.begin() + m_size;
+		std::copy(wrapBegin, wrapBegin + (m_tail + count - m_size), m_data.begin());
+	}
+
+	m_tail += count;
+	m_tail %= m_size;
+	commitWrite(count);
+
+	return count;
+}
+
 uint SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::iterator end)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	m_wakeupPending.fetchAndStoreOrdered(0); // writes from now on will signal again
 	uint count = end - begin;
 	uint total;
 	uint remaining;
 	uint len;
 
-	total = MIN(count, m_fill);
+	total = MIN(count, (uint) m_fill.loadAcquire());
 	if(total < count)
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
 
@@ -182,11 +236,12 @@ uint SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::iterator e
 		std::copy(m_data.begin() + m_head, m_data.begin() + m_head + len, begin);
 		m_head += len;
 		m_head %= m_size;
-		m_fill -= len;
 		begin += len;
 		remaining -= len;
 	}
 
+	m_fill.fetchAndAddOrdered(-(int) total);
+
 	return total;
 }
 
@@ -194,13 +249,13 @@ uint SampleSinkFifo::readBegin(uint count,
 	SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 	SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	m_wakeupPending.fetchAndStoreOrdered(0); // writes from now on will signal again
 	uint total;
 	uint remaining;
 	uint len;
 	uint head = m_head;
 
-	total = MIN(count, m_fill);
+	total = MIN(count, (uint) m_fill.loadAcquire());
 	if(total < count)
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
 
@@ -216,6 +271,12 @@ uint SampleSinkFifo::readBegin(uint count,
 		*part1Begin = m_data.end();
 		*part1End = m_data.end();
 	}
+	if((remaining > 0) && m_mirrored) {
+		// the wrapped samples are owned by the consumer until committed: copy them after the end
+		std::copy(m_data.begin(), m_data.begin() + remaining, m_data.begin() + m_size);
+		*part1End += remaining;
+		remaining = 0;
+	}
 	if(remaining > 0) {
 		len = MIN(remaining, m_size - head);
 		*part2Begin = m_data.begin() + head;
@@ -230,14 +291,14 @@ uint SampleSinkFifo::readBegin(uint count,
 
 uint SampleSinkFifo::readCommit(uint count)
 {
-	QMutexLocker mutexLocker(&m_mutex);
+	uint fill = m_fill.loadAcquire();
 
-	if(count > m_fill) {
+	if(count > fill) {
 		qCritical("SampleSinkFifo: cannot commit more than available samples");
-		count = m_fill;
+		count = fill;
 	}
 	m_head = (m_head + count) % m_size;
-	m_fill -= count;
+	m_fill.fetchAndAddOrdered(-(int) count);
 
 	return count;
 }
@@ -20,27 +20,57 @@
 #define INCLUDE_SAMPLEFIFO_H
 
 #include <QObject>
-#include <QMutex>
+#include <QAtomicInt>
 #include <QTime>
 #include "dsp/dsptypes.h"
+#include "util/profiler.h"
 #include "export.h"
 
+/**
+ * Single producer single consumer sample FIFO. The producer (device thread) only moves the tail
+ * and the consumer (DSP engine or channel thread) only moves the head. The shared fill count is
+ * the only variable both sides modify and it is updated atomically so no lock is taken.
+ * Producer, consumer and shared data are kept on separate cache lines.
+ *
+ * dataReady is not emitted on every write: once emitted it is not emitted again until the consumer
+ * starts a new read (readBegin or read) so that a busy consumer gets one wake up for many writes.
+ *
+ * In mirrored mode the buffer has a second half that receives a copy of the wrapped part of a read
+ * so readBegin always returns a single contiguous part (part2 is empty).
+ *
+ * writeReserve and writeCommit let the producer build its samples directly in the FIFO (e.g. the
+ * decimators of the device threads) instead of copying them from a conversion buffer. When the
+ * reserved region would wrap (not mirrored) or does not fit in the free space the producer gets
+ * a private buffer and the samples are copied at commit like with write.
+ */
 class SDRBASE_API SampleSinkFifo : public QObject {
 	Q_OBJECT
 
 private:
-	QMutex m_mutex;
-	QTime m_msgRateTimer;
-	int m_suppressed;
+	static const int m_cacheLineSize = 64;
 
+	// shared
 	SampleVector m_data;
-
 	uint m_size;
-	uint m_fill;
-	uint m_head;
+	bool m_mirrored;
+	char m_pad0[m_cacheLineSize];
+	QAtomicInt m_fill;
+	QAtomicInt m_wakeupPending;
+	char m_pad1[m_cacheLineSize];
+	// producer side
 	uint m_tail;
+	QTime m_msgRateTimer;
+	int m_suppressed;
+	SampleVector m_writeBuffer; //!< reserved region when it cannot be in the FIFO
+	bool m_writeToBuffer;
+	FifoCounter m_profile;
+	char m_pad2[m_cacheLineSize];
+	// consumer side
+	uint m_head;
 
 	void create(uint s);
+	void overflow(uint count, uint total);
+	void commitWrite(uint count);
 
 public:
 	SampleSinkFifo(QObject* parent = nullptr);
@@ -49,11 +79,15 @@ public:
 	~SampleSinkFifo();
 
 	bool setSize(int size);
+	void setMirrored(bool mirrored); //!< takes effect at next setSize
 	inline uint size() const { return m_size; }
-	inline uint fill() { QMutexLocker mutexLocker(&m_mutex); uint fill = m_fill; return fill; }
+	inline uint fill() { return m_fill.loadAcquire(); }
+	FifoCounter& getProfile() { return m_profile; } //!< producer side statistics (overflows are dropped samples)
 
 	uint write(const quint8* data, uint count);
 	uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+	SampleVector::iterator writeReserve(uint count); //!< contiguous region to write at most count samples (count <= size)
+	uint writeCommit(uint count); //!< publish the first count samples of the reserved region. Returns the number of samples actually written
 
 	uint read(SampleVector::iterator begin, SampleVector::iterator end);
 
@@ -55,6 +55,7 @@ void SampleSourceFifo::init()
     m_ir = 0;
     m_iw = m_size/2;
     m_init = true;
+    m_profile.setSize(m_size);
 }
 
 void SampleSourceFifo::readAdvance(SampleVector::iterator& readUntil, unsigned int nbSamples)
@@ -63,6 +64,14 @@ void SampleSourceFifo::readAdvance(SampleVector::iterator& readUntil, unsigned i
     assert(nbSamples <= m_size/2);
     emit dataWrite(nbSamples);
 
+    // samples written ahead of the read pointer: reading past them replays old samples
+    uint32_t fill = (m_iw + m_size - m_ir) % m_size;
+
+    if (nbSamples > fill) {
+        m_profile.dropped(nbSamples - fill);
+    }
+
+    m_profile.transferred(nbSamples, fill);
     m_ir = (m_ir + nbSamples) % m_size;
     readUntil =  m_data.begin() + m_size + m_ir;
     emit dataRead(nbSamples);
@@ -101,6 +110,23 @@ void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt)
     writeAt = m_data.begin() + m_iw;
 }
 
+void SampleSourceFifo::commitWrite(unsigned int nbSamples)
+{
+    assert(nbSamples <= m_size);
+    // the block was written from m_iw and may run past m_size into the second buffer
+    unsigned int firstPart = std::min(nbSamples, m_size - m_iw);
+    std::copy(m_data.begin() + m_iw, m_data.begin() + m_iw + firstPart, m_data.begin() + m_iw + m_size);
+
+    if (nbSamples > firstPart) {
+        std::copy(m_data.begin() + m_size, m_data.begin() + m_size + (nbSamples - firstPart), m_data.begin());
+    }
+
+    {
+//        QMutexLocker mutexLocker(&m_mutex);
+        m_iw = (m_iw + nbSamples) % m_size;
+    }
+}
+
 int SampleSourceFifo::getIteratorOffset(const SampleVector::iterator& iterator)
 {
     return iterator - m_data.begin();
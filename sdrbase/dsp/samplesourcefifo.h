@@ -24,6 +24,7 @@
 #include <assert.h>
 #include "export.h"
 #include "dsp/dsptypes.h"
+#include "util/profiler.h"
 
 class SDRBASE_API SampleSourceFifo : public QObject {
     Q_OBJECT
@@ -35,6 +36,7 @@ public:
 
     void resize(uint32_t size);
     uint32_t size() const { return m_size; }
+    FifoCounter& getProfile() { return m_profile; } //!< reader side statistics (underruns are dropped samples)
     void init();
     /** advance read pointer for the given length and activate R/W signals */
     void readAdvance(SampleVector::iterator& readUntil, unsigned int nbSamples);
@@ -42,6 +44,7 @@ public:
     void getReadIterator(SampleVector::iterator& readUntil); //!< get iterator past the last sample of a read advance operation (i.e. current read iterator)
     void getWriteIterator(SampleVector::iterator& writeAt);  //!< get iterator to current item for update - write phase 1
     void bumpIndex(SampleVector::iterator& writeAt);         //!< copy current item to second buffer and bump write index - write phase 2
+    void commitWrite(unsigned int nbSamples);                //!< block of items written contiguously from write iterator: mirror them and bump write index - block write phase 2
     int getIteratorOffset(const SampleVector::iterator& iterator);
     void setIteratorFromOffset(SampleVector::iterator& iterator, int offset);
 
@@ -66,6 +69,7 @@ private:
     uint32_t m_ir;
     bool m_init;
     QMutex m_mutex;
+    FifoCounter m_profile;
 
 signals:
     void dataWrite(int nbSamples); // signal data is read past a threshold and writing new samples to fill in is needed
@@ -0,0 +1,726 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QThread>
+#include <QDateTime>
+#include <QtEndian>
+#include <QMutexLocker>
+
+#include "SWGGLSpectrum.h"
+#include "SWGSpectrumServer.h"
+
+#include "dsp/spectrumengine.h"
+#include "dsp/dspcommands.h"
+#include "util/messagequeue.h"
+#include "websockets/wsspectrum.h"
+
+#define MAX_FFT_SIZE 4096
+
+#ifndef LINUX
+inline double log2f(double n)
+{
+	return log(n) / log(2.0);
+}
+#endif
+
+MESSAGE_CLASS_DEFINITION(SpectrumEngine::MsgConfigureSpectrum, Message)
+MESSAGE_CLASS_DEFINITION(SpectrumEngine::MsgConfigureSpectrumStream, Message)
+
+const Real SpectrumEngine::m_mult = (10.0f / log2f(10.0f));
+
+SpectrumEngine::SpectrumEngine(Real scalef) :
+	BasebandSampleSink(),
+	m_fft(FFTEngine::create()),
+	m_windowFunction(FFTWindow::BlackmanHarris),
+	m_fftBuffer(MAX_FFT_SIZE),
+	m_powerSpectrum(MAX_FFT_SIZE),
+	m_fftBufferFill(0),
+	m_needMoreSamples(false),
+	m_burstRemaining(0),
+	m_scalef(scalef),
+	m_averageNb(0),
+	m_avgMode(AvgModeNone),
+	m_linear(false),
+	m_ofs(0),
+    m_powFFTDiv(1.0),
+    m_centerFrequency(0),
+    m_sampleRate(0),
+    m_streamFrameRate(10),
+    m_streamRefLevel(0),
+    m_streamPowerRange(100),
+    m_streamSequence(0),
+    m_serverAddress("127.0.0.1"),
+    m_serverPort(8887),
+    m_wsSpectrum(nullptr),
+    m_wsThread(nullptr),
+	m_mutex(QMutex::Recursive)
+{
+	setObjectName("SpectrumEngine");
+	handleConfigure(1024, 0, 0, AvgModeNone, FFTWindow::BlackmanHarris, false);
+}
+
+SpectrumEngine::~SpectrumEngine()
+{
+    stopServer();
+	delete m_fft;
+}
+
+void SpectrumEngine::configure(MessageQueue* msgQueue,
+        int fftSize,
+        int overlapPercent,
+        unsigned int averagingNb,
+        int averagingMode,
+        FFTWindow::Function window,
+        bool linear)
+{
+	MsgConfigureSpectrum* cmd = new MsgConfigureSpectrum(fftSize, overlapPercent, averagingNb, averagingMode, window, linear);
+	msgQueue->push(cmd);
+}
+
+void SpectrumEngine::configureStream(MessageQueue* msgQueue, int frameRate, int refLevel, int powerRange)
+{
+    MsgConfigureSpectrumStream* cmd = new MsgConfigureSpectrumStream(frameRate, refLevel, powerRange);
+    msgQueue->push(cmd);
+}
+
+void SpectrumEngine::feedTriggered(const SampleVector::const_iterator& triggerPoint, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+	feed(triggerPoint, end, positiveOnly); // normal feed from trigger point
+	/*
+	if (triggerPoint == end)
+	{
+		// the following piece of code allows to terminate the FFT that ends past the end of scope captured data
+		// that is the spectrum will include the captured data
+		// just do nothing if you want the spectrum to be included inside the scope captured data
+		// that is to drop the FFT that dangles past the end of captured data
+		if (m_needMoreSamples) {
+			feed(begin, end, positiveOnly);
+			m_needMoreSamples = false;      // force finish
+		}
+	}
+	else
+	{
+		feed(triggerPoint, end, positiveOnly); // normal feed from trigger point
+	}*/
+}
+
+void SpectrumEngine::feed(const SampleVector::const_iterator& cbegin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+	// if no visualisation nor stream is set, send the samples to /dev/null
+
+	if (!isActive()) {
+		return;
+	}
+
+    if (!m_mutex.tryLock(0)) { // prevent conflicts with configuration process
+        return;
+    }
+
+	SampleVector::const_iterator begin(cbegin);
+	bool decimate = decimateToStreamRate();
+
+	while (begin < end)
+	{
+		if (decimate && (m_burstRemaining == 0))
+		{
+			// no spectrum is needed before the next stream frame is due: drop the input
+			if ((m_streamFrameRate <= 0) || (m_streamTimer.isValid() && (m_streamTimer.elapsed() < 1000 / m_streamFrameRate))) {
+				break;
+			}
+
+			// FFTs needed for one frame taken on contiguous samples
+			m_burstRemaining = ((m_avgMode == AvgModeFixedAvg) || (m_avgMode == AvgModeMax)) && (m_averageNb > 1) ? m_averageNb : 1;
+			m_fftBufferFill = 0;
+			// a burst is a complete average of its own: drop what was left from a previous one
+			m_fixedAverage.reset();
+			m_max.reset();
+
+			// the moving average only carries over between frames of the same stream
+			if (!m_streamTimer.isValid() || (m_streamTimer.elapsed() > 2 * (1000 / m_streamFrameRate))) {
+				m_movingAverage.reset();
+			}
+		}
+
+		std::size_t todo = end - begin;
+		std::size_t samplesNeeded = m_fftSize - m_fftBufferFill;
+
+		if (todo >= samplesNeeded)
+		{
+			// fill up the buffer
+			std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill;
+
+			for (std::size_t i = 0; i < samplesNeeded; ++i, ++begin)
+			{
+				*it++ = Complex(begin->real() / m_scalef, begin->imag() / m_scalef);
+			}
+
+			// apply fft window (and copy from m_fftBuffer to m_fftIn)
+			m_window.apply(&m_fftBuffer[0], m_fft->in());
+
+			// calculate FFT
+			m_fft->transform();
+
+			// extract power spectrum and reorder buckets
+			const Complex* fftOut = m_fft->out();
+			Complex c;
+			Real v;
+			std::size_t halfSize = m_fftSize / 2;
+
+			if (m_avgMode == AvgModeNone)
+			{
+                if ( positiveOnly )
+                {
+                    for (std::size_t i = 0; i < halfSize; i++)
+                    {
+                        c = fftOut[i];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+                        v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+                        m_powerSpectrum[i * 2] = v;
+                        m_powerSpectrum[i * 2 + 1] = v;
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < halfSize; i++)
+                    {
+                        c = fftOut[i + halfSize];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+                        v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+                        m_powerSpectrum[i] = v;
+
+                        c = fftOut[i];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+                        v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+                        m_powerSpectrum[i + halfSize] = v;
+                    }
+                }
+
+                // send new data to visualisation
+                newSpectrum(m_powerSpectrum, m_fftSize);
+			}
+			else if (m_avgMode == AvgModeMovingAvg)
+			{
+	            if ( positiveOnly )
+	            {
+	                for (std::size_t i = 0; i < halfSize; i++)
+	                {
+	                    c = fftOut[i];
+	                    v = c.real() * c.real() + c.imag() * c.imag();
+	                    v = m_movingAverage.storeAndGetAvg(v, i);
+	                    v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+	                    m_powerSpectrum[i * 2] = v;
+	                    m_powerSpectrum[i * 2 + 1] = v;
+	                }
+	            }
+	            else
+	            {
+	                for (std::size_t i = 0; i < halfSize; i++)
+	                {
+	                    c = fftOut[i + halfSize];
+	                    v = c.real() * c.real() + c.imag() * c.imag();
+	                    v = m_movingAverage.storeAndGetAvg(v, i+halfSize);
+	                    v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+	                    m_powerSpectrum[i] = v;
+
+	                    c = fftOut[i];
+	                    v = c.real() * c.real() + c.imag() * c.imag();
+	                    v = m_movingAverage.storeAndGetAvg(v, i);
+	                    v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+	                    m_powerSpectrum[i + halfSize] = v;
+	                }
+	            }
+
+	            // send new data to visualisation
+	            newSpectrum(m_powerSpectrum, m_fftSize);
+	            m_movingAverage.nextAverage();
+			}
+			else if (m_avgMode == AvgModeFixedAvg)
+			{
+			    double avg;
+
+                if ( positiveOnly )
+                {
+                    for (std::size_t i = 0; i < halfSize; i++)
+                    {
+                        c = fftOut[i];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+
+                        if (m_fixedAverage.storeAndGetAvg(avg, v, i))
+                        {
+                            avg = m_linear ? avg/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
+                            m_powerSpectrum[i * 2] = avg;
+                            m_powerSpectrum[i * 2 + 1] = avg;
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < halfSize; i++)
+                    {
+                        c = fftOut[i + halfSize];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+
+                        if (m_fixedAverage.storeAndGetAvg(avg, v, i+halfSize))
+                        { // result available
+                            avg = m_linear ? avg/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
+                            m_powerSpectrum[i] = avg;
+                        }
+
+                        c = fftOut[i];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+
+                        if (m_fixedAverage.storeAndGetAvg(avg, v, i))
+                        { // result available
+                            avg = m_linear ? avg/m_powFFTDiv : m_mult * log2f(avg) + m_ofs;
+                            m_powerSpectrum[i + halfSize] = avg;
+                        }
+                    }
+                }
+
+                if (m_fixedAverage.nextAverage()) { // result available
+                    newSpectrum(m_powerSpectrum, m_fftSize); // send new data to visualisation
+                }
+			}
+			else if (m_avgMode == AvgModeMax)
+			{
+			    double max;
+
+                if ( positiveOnly )
+                {
+                    for (std::size_t i = 0; i < halfSize; i++)
+                    {
+                        c = fftOut[i];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+
+                        if (m_max.storeAndGetMax(max, v, i))
+                        {
+                            max = m_linear ? max/m_powFFTDiv : m_mult * log2f(max) + m_ofs;
+                            m_powerSpectrum[i * 2] = max;
+                            m_powerSpectrum[i * 2 + 1] = max;
+                        }
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < halfSize; i++)
+                    {
+                        c = fftOut[i + halfSize];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+
+                        if (m_max.storeAndGetMax(max, v, i+halfSize))
+                        { // result available
+                            max = m_linear ? max/m_powFFTDiv : m_mult * log2f(max) + m_ofs;
+                            m_powerSpectrum[i] = max;
+                        }
+
+                        c = fftOut[i];
+                        v = c.real() * c.real() + c.imag() * c.imag();
+
+                        if (m_max.storeAndGetMax(max, v, i))
+                        { // result available
+                            max = m_linear ? max/m_powFFTDiv : m_mult * log2f(max) + m_ofs;
+                            m_powerSpectrum[i + halfSize] = max;
+                        }
+                    }
+                }
+
+                if (m_max.nextMax()) { // result available
+                    newSpectrum(m_powerSpectrum, m_fftSize); // send new data to visualisation
+                }
+			}
+
+			// advance buffer respecting the fft overlap factor
+			std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.begin() + m_fftSize, m_fftBuffer.begin());
+
+			// start over
+			m_fftBufferFill = m_overlapSize;
+			m_needMoreSamples = false;
+
+			if (m_burstRemaining > 0) {
+				m_burstRemaining--;
+			}
+		}
+		else
+		{
+			// not enough samples for FFT - just fill in new data and return
+			for(std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill; begin < end; ++begin)
+			{
+				*it++ = Complex(begin->real() / m_scalef, begin->imag() / m_scalef);
+			}
+
+			m_fftBufferFill += todo;
+			m_needMoreSamples = true;
+		}
+	}
+
+	 m_mutex.unlock();
+}
+
+void SpectrumEngine::start()
+{
+}
+
+void SpectrumEngine::stop()
+{
+}
+
+bool SpectrumEngine::isActive() const
+{
+    return m_wsSpectrum != nullptr;
+}
+
+bool SpectrumEngine::decimateToStreamRate() const
+{
+    return true;
+}
+
+void SpectrumEngine::newSpectrum(const std::vector<Real>& spectrum, int fftSize)
+{
+    streamSpectrum(spectrum, fftSize);
+}
+
+void SpectrumEngine::streamSpectrum(const std::vector<Real>& spectrum, int fftSize)
+{
+    if (!m_wsSpectrum || (m_streamFrameRate <= 0) || (m_streamPowerRange <= 0)) {
+        return;
+    }
+
+    if (m_streamTimer.isValid() && (m_streamTimer.elapsed() < 1000 / m_streamFrameRate)) {
+        return;
+    }
+
+    m_streamTimer.restart();
+    m_streamFrame.resize(WSSpectrum::m_headerSize + fftSize);
+    uchar *frame = reinterpret_cast<uchar*>(m_streamFrame.data());
+    qToLittleEndian<quint64>(m_centerFrequency, frame);
+    qToLittleEndian<quint64>(QDateTime::currentMSecsSinceEpoch(), frame + 8);
+    qToLittleEndian<quint32>(m_sampleRate, frame + 16);
+    qToLittleEndian<quint16>(fftSize, frame + 20);
+    qToLittleEndian<quint16>(m_linear ? 1 : 0, frame + 22);
+    qToLittleEndian<qint16>(m_streamRefLevel, frame + 24);
+    qToLittleEndian<quint16>(m_streamPowerRange, frame + 26);
+    qToLittleEndian<quint32>(m_streamSequence++, frame + 28);
+
+    // quantize the dB values on 8 bits over the power range below the reference level
+    Real floor = m_streamRefLevel - m_streamPowerRange;
+    Real scale = 255.0f / m_streamPowerRange;
+    uchar *bins = frame + WSSpectrum::m_headerSize;
+
+    for (int i = 0; i < fftSize; i++)
+    {
+        Real db = m_linear ? (spectrum[i] > 0.0f ? 10.0f * log10f(spectrum[i]) : floor) : spectrum[i];
+        int q = lrintf((db - floor) * scale);
+        bins[i] = q < 0 ? 0 : q > 255 ? 255 : q;
+    }
+
+    emit spectrumFrame(m_streamFrame);
+}
+
+bool SpectrumEngine::startServer(const QString& address, quint16 port)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_wsSpectrum)
+    {
+        if ((address == m_serverAddress) && (port == m_serverPort)) {
+            return true;
+        }
+
+        stopServer();
+    }
+
+    m_wsThread = new QThread();
+    m_wsSpectrum = new WSSpectrum(address, port);
+    m_wsSpectrum->moveToThread(m_wsThread);
+    m_wsThread->start();
+    QMetaObject::invokeMethod(m_wsSpectrum, "openSocket", Qt::BlockingQueuedConnection);
+
+    if (!m_wsSpectrum->isListening())
+    {
+        m_wsThread->quit();
+        m_wsThread->wait();
+        delete m_wsSpectrum;
+        delete m_wsThread;
+        m_wsSpectrum = nullptr;
+        m_wsThread = nullptr;
+        return false;
+    }
+
+    connect(this, &SpectrumEngine::spectrumFrame, m_wsSpectrum, &WSSpectrum::newSpectrumFrame, Qt::QueuedConnection);
+    m_serverAddress = address;
+    m_serverPort = port;
+    m_streamTimer.invalidate();
+
+    return true;
+}
+
+void SpectrumEngine::stopServer()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_wsSpectrum) {
+        return;
+    }
+
+    disconnect(this, &SpectrumEngine::spectrumFrame, m_wsSpectrum, &WSSpectrum::newSpectrumFrame);
+    QMetaObject::invokeMethod(m_wsSpectrum, "closeSocket", Qt::BlockingQueuedConnection);
+    m_wsThread->quit();
+    m_wsThread->wait();
+    delete m_wsSpectrum;
+    delete m_wsThread;
+    m_wsSpectrum = nullptr;
+    m_wsThread = nullptr;
+}
+
+void SpectrumEngine::setServerAddress(const QString& address, quint16 port)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_wsSpectrum)
+    {
+        m_serverAddress = address;
+        m_serverPort = port;
+    }
+}
+
+void SpectrumEngine::getServerPeers(QList<QHostAddress>& hosts, QList<quint16>& ports) const
+{
+    if (m_wsSpectrum)
+    {
+        m_wsSpectrum->getPeers(hosts, ports);
+    }
+    else
+    {
+        hosts.clear();
+        ports.clear();
+    }
+}
+
+int SpectrumEngine::webapiSpectrumSettingsGet(SWGSDRangel::SWGGLSpectrum& response, QString& errorMessage) const
+{
+    (void) errorMessage;
+    response.setFftSize(m_fftSize);
+    response.setFftOverlap(m_overlapPercent);
+    response.setFftWindow((int) m_windowFunction);
+    response.setAveragingMode((int) m_avgMode);
+    response.setAveragingValue(m_averageNb);
+    response.setLinear(m_linear ? 1 : 0);
+
+    if (response.getWsSpectrumAddress()) {
+        *response.getWsSpectrumAddress() = m_serverAddress;
+    } else {
+        response.setWsSpectrumAddress(new QString(m_serverAddress));
+    }
+
+    response.setWsSpectrumPort(m_serverPort);
+    response.setStreamFrameRate(m_streamFrameRate);
+    response.setStreamRefLevel(m_streamRefLevel);
+    response.setStreamPowerRange(m_streamPowerRange);
+    return 200;
+}
+
+int SpectrumEngine::webapiSpectrumSettingsPutPatch(
+        bool force,
+        const QStringList& spectrumSettingsKeys,
+        SWGSDRangel::SWGGLSpectrum& response,
+        QString& errorMessage)
+{
+    int fftSize = spectrumSettingsKeys.contains("fftSize") || force ? response.getFftSize() : m_fftSize;
+    int overlapPercent = spectrumSettingsKeys.contains("fftOverlap") || force ? response.getFftOverlap() : m_overlapPercent;
+    int window = spectrumSettingsKeys.contains("fftWindow") || force ? response.getFftWindow() : (int) m_windowFunction;
+    int averagingMode = spectrumSettingsKeys.contains("averagingMode") || force ? response.getAveragingMode() : (int) m_avgMode;
+    int averageNb = spectrumSettingsKeys.contains("averagingValue") || force ? response.getAveragingValue() : m_averageNb;
+    bool linear = spectrumSettingsKeys.contains("linear") || force ? response.getLinear() != 0 : m_linear;
+    int frameRate = spectrumSettingsKeys.contains("streamFrameRate") || force ? response.getStreamFrameRate() : m_streamFrameRate;
+    int refLevel = spectrumSettingsKeys.contains("streamRefLevel") || force ? response.getStreamRefLevel() : m_streamRefLevel;
+    int powerRange = spectrumSettingsKeys.contains("streamPowerRange") || force ? response.getStreamPowerRange() : m_streamPowerRange;
+    QString address = spectrumSettingsKeys.contains("wsSpectrumAddress") ? *response.getWsSpectrumAddress() : m_serverAddress;
+    quint16 port = spectrumSettingsKeys.contains("wsSpectrumPort") ? response.getWsSpectrumPort() : m_serverPort;
+
+    if ((window < 0) || (window > (int) FFTWindow::Rectangle))
+    {
+        errorMessage = QString("Invalid FFT window %1").arg(window);
+        return 400;
+    }
+
+    if ((overlapPercent < 0) || (overlapPercent >= 100))
+    {
+        errorMessage = QString("Invalid FFT overlap %1%. Must be from 0 to 99").arg(overlapPercent);
+        return 400;
+    }
+
+    if ((frameRate < 0) || (powerRange < 0))
+    {
+        errorMessage = QString("Stream frame rate and power range must be positive");
+        return 400;
+    }
+
+    configure(getInputMessageQueue(), fftSize, overlapPercent, averageNb, averagingMode, (FFTWindow::Function) window, linear);
+    configureStream(getInputMessageQueue(), frameRate, refLevel, powerRange);
+
+    if (isServerRunning())
+    {
+        if (!startServer(address, port)) // restarts if address or port changed
+        {
+            errorMessage = QString("Cannot start spectrum server at %1 on port %2").arg(address).arg(port);
+            return 500;
+        }
+    }
+    else
+    {
+        setServerAddress(address, port);
+    }
+
+    webapiSpectrumSettingsGet(response, errorMessage);
+    // configuration is applied asynchronously. Return what was requested.
+    response.setFftSize(fftSize);
+    response.setFftOverlap(overlapPercent);
+    response.setFftWindow(window);
+    response.setAveragingMode(averagingMode);
+    response.setAveragingValue(averageNb);
+    response.setLinear(linear ? 1 : 0);
+    response.setStreamFrameRate(frameRate);
+    response.setStreamRefLevel(refLevel);
+    response.setStreamPowerRange(powerRange);
+    return 200;
+}
+
+int SpectrumEngine::webapiSpectrumServerGet(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage) const
+{
+    (void) errorMessage;
+    response.init();
+    response.setRun(isServerRunning() ? 1 : 0);
+    *response.getListeningAddress() = m_serverAddress;
+    response.setListeningPort(m_serverPort);
+
+    QList<QHostAddress> hosts;
+    QList<quint16> ports;
+    getServerPeers(hosts, ports);
+
+    for (int i = 0; i < hosts.size(); i++)
+    {
+        response.getClients()->append(new SWGSDRangel::SWGSpectrumServer_clients);
+        response.getClients()->back()->setAddress(new QString(hosts.at(i).toString()));
+        response.getClients()->back()->setPort(ports.at(i));
+    }
+
+    return 200;
+}
+
+int SpectrumEngine::webapiSpectrumServerPost(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage)
+{
+    if (!startServer())
+    {
+        errorMessage = QString("Cannot start spectrum server at %1 on port %2").arg(m_serverAddress).arg(m_serverPort);
+        return 500;
+    }
+
+    return webapiSpectrumServerGet(response, errorMessage);
+}
+
+int SpectrumEngine::webapiSpectrumServerDelete(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage)
+{
+    stopServer();
+    return webapiSpectrumServerGet(response, errorMessage);
+}
+
+bool SpectrumEngine::handleMessage(const Message& message)
+{
+	if (MsgConfigureSpectrum::match(message))
+	{
+		MsgConfigureSpectrum& conf = (MsgConfigureSpectrum&) message;
+		handleConfigure(conf.getFFTSize(),
+		        conf.getOverlapPercent(),
+		        conf.getAverageNb(),
+		        conf.getAvgMode(),
+		        conf.getWindow(),
+		        conf.getLinear());
+		return true;
+	}
+	else if (MsgConfigureSpectrumStream::match(message))
+	{
+	    MsgConfigureSpectrumStream& conf = (MsgConfigureSpectrumStream&) message;
+	    QMutexLocker mutexLocker(&m_mutex);
+	    m_streamFrameRate = conf.getFrameRate();
+	    m_streamRefLevel = conf.getRefLevel();
+	    m_streamPowerRange = conf.getPowerRange();
+	    return true;
+	}
+	else if (DSPSignalNotification::match(message))
+	{
+	    DSPSignalNotification& notif = (DSPSignalNotification&) message;
+	    m_centerFrequency = notif.getCenterFrequency();
+	    m_sampleRate = notif.getSampleRate();
+	    return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+void SpectrumEngine::handleConfigure(int fftSize,
+        int overlapPercent,
+        unsigned int averageNb,
+        AvgMode averagingMode,
+        FFTWindow::Function window,
+        bool linear)
+{
+//    qDebug("SpectrumEngine::handleConfigure, fftSize: %d overlapPercent: %d averageNb: %u averagingMode: %d window: %d linear: %s",
+//            fftSize, overlapPercent, averageNb, (int) averagingMode, (int) window, linear ? "true" : "false");
+	QMutexLocker mutexLocker(&m_mutex);
+
+	if (fftSize > MAX_FFT_SIZE)
+	{
+		fftSize = MAX_FFT_SIZE;
+	}
+	else if (fftSize < 64)
+	{
+		fftSize = 64;
+	}
+
+	if (overlapPercent > 99) // at least one new sample per FFT
+	{
+		m_overlapPercent = 99;
+	}
+	else if (overlapPercent < 0)
+	{
+		m_overlapPercent = 0;
+	}
+	else
+	{
+        m_overlapPercent = overlapPercent;
+	}
+
+	m_fftSize = fftSize;
+	m_fft->configure(m_fftSize, false);
+	m_window.create(window, m_fftSize);
+	m_windowFunction = window;
+	m_overlapSize = (m_fftSize * m_overlapPercent) / 100;
+	m_refillSize = m_fftSize - m_overlapSize;
+	m_fftBufferFill = m_overlapSize;
+	m_burstRemaining = 0;
+	m_movingAverage.resize(fftSize, averageNb > 1000 ? 1000 : averageNb); // Capping to avoid out of memory condition
+	m_fixedAverage.resize(fftSize, averageNb);
+	m_max.resize(fftSize, averageNb);
+	m_averageNb = averageNb;
+	m_avgMode = averagingMode;
+	m_linear = linear;
+	m_ofs = 20.0f * log10f(1.0f / m_fftSize);
+	m_powFFTDiv = m_fftSize*m_fftSize;
+}
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// Spectrum computation independent of any display. It is used as is by the     //
+// server to stream quantized spectrum frames to remote displays and is the      //
+// base of the GUI spectrum visualizer.                                          //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMENGINE_H_
+#define SDRBASE_DSP_SPECTRUMENGINE_H_
+
+#include <QMutex>
+#include <QElapsedTimer>
+#include <QByteArray>
+#include <QHostAddress>
+#include <QList>
+#include <QStringList>
+
+#include "dsp/basebandsamplesink.h"
+#include "dsp/fftengine.h"
+#include "dsp/fftwindow.h"
+#include "export.h"
+#include "util/message.h"
+#include "util/movingaverage2d.h"
+#include "util/fixedaverage2d.h"
+#include "util/max2d.h"
+
+class MessageQueue;
+class QThread;
+class WSSpectrum;
+
+namespace SWGSDRangel {
+    class SWGGLSpectrum;
+    class SWGSpectrumServer;
+}
+
+class SDRBASE_API SpectrumEngine : public BasebandSampleSink {
+    Q_OBJECT
+public:
+    enum AvgMode
+    {
+        AvgModeNone,
+        AvgModeMovingAvg,
+        AvgModeFixedAvg,
+        AvgModeMax
+    };
+
+    class SDRBASE_API MsgConfigureSpectrum : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        MsgConfigureSpectrum(
+                int fftSize,
+                int overlapPercent,
+                unsigned int averageNb,
+                int preProcessMode,
+                FFTWindow::Function window,
+                bool linear) :
+            Message(),
+            m_fftSize(fftSize),
+            m_overlapPercent(overlapPercent),
+            m_averageNb(averageNb),
+            m_window(window),
+            m_linear(linear)
+        {
+            m_avgMode = preProcessMode < 0 ? AvgModeNone : preProcessMode > 3 ? AvgModeMax : (SpectrumEngine::AvgMode) preProcessMode;
+        }
+
+        int getFFTSize() const { return m_fftSize; }
+        int getOverlapPercent() const { return m_overlapPercent; }
+        unsigned int getAverageNb() const { return m_averageNb; }
+        SpectrumEngine::AvgMode getAvgMode() const { return m_avgMode; }
+        FFTWindow::Function getWindow() const { return m_window; }
+        bool getLinear() const { return m_linear; }
+
+    private:
+        int m_fftSize;
+        int m_overlapPercent;
+        unsigned int m_averageNb;
+        SpectrumEngine::AvgMode m_avgMode;
+        FFTWindow::Function m_window;
+        bool m_linear;
+    };
+
+    class SDRBASE_API MsgConfigureSpectrumStream : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        MsgConfigureSpectrumStream(int frameRate, int refLevel, int powerRange) :
+            Message(),
+            m_frameRate(frameRate),
+            m_refLevel(refLevel),
+            m_powerRange(powerRange)
+        { }
+
+        int getFrameRate() const { return m_frameRate; }
+        int getRefLevel() const { return m_refLevel; }
+        int getPowerRange() const { return m_powerRange; }
+
+    private:
+        int m_frameRate;  //!< maximum number of frames per second sent to stream clients
+        int m_refLevel;   //!< dB level mapped to the top of the 8 bit scale
+        int m_powerRange; //!< dB range mapped to the 8 bit scale
+    };
+
+    SpectrumEngine(Real scalef);
+    virtual ~SpectrumEngine();
+
+    void configure(MessageQueue* msgQueue,
+            int fftSize,
+            int overlapPercent,
+            unsigned int averagingNb,
+            int averagingMode,
+            FFTWindow::Function window,
+            bool linear);
+    void configureStream(MessageQueue* msgQueue, int frameRate, int refLevel, int powerRange);
+
+    int getFFTSize() const { return m_fftSize; }
+    int getOverlapPercent() const { return m_overlapPercent; }
+    unsigned int getAverageNb() const { return m_averageNb; }
+    AvgMode getAvgMode() const { return m_avgMode; }
+    FFTWindow::Function getWindow() const { return m_windowFunction; }
+    bool getLinear() const { return m_linear; }
+    int getStreamFrameRate() const { return m_streamFrameRate; }
+    int getStreamRefLevel() const { return m_streamRefLevel; }
+    int getStreamPowerRange() const { return m_streamPowerRange; }
+
+    /** Start the binary spectrum stream server (WebSocket). Returns false if it could not listen */
+    bool startServer(const QString& address, quint16 port);
+    bool startServer() { return startServer(m_serverAddress, m_serverPort); } //!< start with the last address and port
+    void stopServer();
+    void setServerAddress(const QString& address, quint16 port); //!< address and port used at next start
+    bool isServerRunning() const { return m_wsSpectrum != nullptr; }
+    const QString& getServerAddress() const { return m_serverAddress; }
+    quint16 getServerPort() const { return m_serverPort; }
+    void getServerPeers(QList<QHostAddress>& hosts, QList<quint16>& ports) const;
+
+    int webapiSpectrumSettingsGet(SWGSDRangel::SWGGLSpectrum& response, QString& errorMessage) const;
+    int webapiSpectrumSettingsPutPatch(
+            bool force,
+            const QStringList& spectrumSettingsKeys,
+            SWGSDRangel::SWGGLSpectrum& response, // query + response
+            QString& errorMessage);
+    int webapiSpectrumServerGet(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage) const;
+    int webapiSpectrumServerPost(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage);
+    int webapiSpectrumServerDelete(SWGSDRangel::SWGSpectrumServer& response, QString& errorMessage);
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    void feedTriggered(const SampleVector::const_iterator& triggerPoint, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual void start();
+    virtual void stop();
+    virtual bool handleMessage(const Message& message);
+
+signals:
+    void spectrumFrame(const QByteArray& frame); //!< quantized frame ready for stream clients
+
+protected:
+    virtual bool isActive() const; //!< samples are dropped when nobody uses the spectrum
+    virtual bool decimateToStreamRate() const; //!< only compute the spectra needed for the stream frames
+    virtual void newSpectrum(const std::vector<Real>& spectrum, int fftSize); //!< a new spectrum is available. Streams it when the server is running.
+
+private:
+    FFTEngine* m_fft;
+    FFTWindow m_window;
+    FFTWindow::Function m_windowFunction;
+
+    std::vector<Complex> m_fftBuffer;
+    std::vector<Real> m_powerSpectrum;
+
+    std::size_t m_fftSize;
+    std::size_t m_overlapPercent;
+    std::size_t m_overlapSize;
+    std::size_t m_refillSize;
+    std::size_t m_fftBufferFill;
+    bool m_needMoreSamples;
+    unsigned int m_burstRemaining; //!< FFTs still to compute for the current stream frame when decimating
+
+    Real m_scalef;
+    MovingAverage2D<double> m_movingAverage;
+    FixedAverage2D<double> m_fixedAverage;
+    Max2D<double> m_max;
+    unsigned int m_averageNb;
+    AvgMode m_avgMode;
+    bool m_linear;
+
+    Real m_ofs;
+    Real m_powFFTDiv;
+    static const Real m_mult;
+
+    qint64 m_centerFrequency;
+    int m_sampleRate;
+    int m_streamFrameRate;
+    int m_streamRefLevel;
+    int m_streamPowerRange;
+    quint32 m_streamSequence;
+    QElapsedTimer m_streamTimer;
+    QByteArray m_streamFrame;
+    QString m_serverAddress;
+    quint16 m_serverPort;
+    WSSpectrum *m_wsSpectrum;
+    QThread *m_wsThread;
+
+    QMutex m_mutex;
+
+    void handleConfigure(int fftSize,
+            int overlapPercent,
+            unsigned int averageNb,
+            AvgMode averagingMode,
+            FFTWindow::Function window,
+            bool linear);
+    void streamSpectrum(const std::vector<Real>& spectrum, int fftSize);
+};
+
+#endif // SDRBASE_DSP_SPECTRUMENGINE_H_
@@ -9,6 +9,7 @@ ThreadedBasebandSampleSinkFifo::ThreadedBasebandSampleSinkFifo(BasebandSampleSin
 	m_sampleSink(sampleSink)
 {
 	connect(&m_sampleFifo, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
+	m_sampleFifo.setMirrored(true); // channels are fed with one contiguous block
 	m_sampleFifo.setSize(size);
 }
 
@@ -25,6 +26,8 @@ void ThreadedBasebandSampleSinkFifo::writeToFifo(SampleVector::const_iterator& b
 void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it to the new threadable sink class
 {
 	bool positiveOnly = false;
+	ProfileTimer handlerTimer(m_handlerProfile);
+	std::size_t samplesDone = 0;
 
 	while ((m_sampleFifo.fill() > 0) && (m_sampleSink->getInputMessageQueue()->size() == 0))
 	{
@@ -60,7 +63,11 @@ void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it t
 
 			m_sampleFifo.readCommit(part2end - part2begin);
 		}
+
+		samplesDone += count;
 	}
+
+	handlerTimer.setSamples(samplesDone);
 }
 
 ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampleSink, QObject *parent) :
@@ -73,6 +80,9 @@ ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampl
 
 	m_thread = new QThread(parent);
 	m_threadedBasebandSampleSinkFifo = new ThreadedBasebandSampleSinkFifo(m_basebandSampleSink);
+	// the parent is the channel: used to attach the profiling counters to it
+	m_threadedBasebandSampleSinkFifo->m_handlerProfile.setOwner(parent, "handler");
+	m_threadedBasebandSampleSinkFifo->m_sampleFifo.getProfile().setOwner(parent, "channel");
 	//moveToThread(m_thread); // FIXME: Fixed? the intermediate FIFO should be handled within the sink. Define a new type of sink that is compatible with threading
 	m_basebandSampleSink->moveToThread(m_thread);
 	m_threadedBasebandSampleSinkFifo->moveToThread(m_thread);
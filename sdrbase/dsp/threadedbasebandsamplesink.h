@@ -24,6 +24,7 @@
 
 #include "samplesinkfifo.h"
 #include "util/messagequeue.h"
+#include "util/profiler.h"
 #include "export.h"
 
 class BasebandSampleSink;
@@ -43,6 +44,7 @@ public:
 
 	BasebandSampleSink* m_sampleSink;
 	SampleSinkFifo m_sampleFifo;
+	ProfileCounter m_handlerProfile; //!< whole FIFO handler run (channelizer and demodulator)
 
 public slots:
 	void handleFifoData();
@@ -31,6 +31,9 @@ ThreadedBasebandSampleSource::ThreadedBasebandSampleSource(BasebandSampleSource*
 
     m_thread = new QThread(parent);
     m_basebandSampleSource->moveToThread(m_thread);
+    // the parent is the channel: used to attach the profiling counters to it
+    m_basebandSampleSource->getWriteProfile().setOwner(parent, "handler");
+    m_basebandSampleSource->getSampleSourceFifo().getProfile().setOwner(parent, "channel");
 
     qDebug() << "ThreadedBasebandSampleSource::ThreadedBasebandSampleSource: thread: " << thread() << " m_thread: " << m_thread;
 }
@@ -64,6 +67,11 @@ void ThreadedBasebandSampleSource::pull(Sample& sample)
 	m_basebandSampleSource->pull(sample);
 }
 
+void ThreadedBasebandSampleSource::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+	m_basebandSampleSource->pull(begin, nbSamples);
+}
+
 void ThreadedBasebandSampleSource::feed(SampleSourceFifo* sampleFifo,
 	int nbSamples)
 {
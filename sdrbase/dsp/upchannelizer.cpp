@@ -35,10 +35,12 @@ UpChannelizer::UpChannelizer(BasebandSampleSource* sampleSource) :
     m_requestedInputSampleRate(0),
     m_requestedCenterFrequency(0),
     m_currentInputSampleRate(0),
-    m_currentCenterFrequency(0)
+    m_currentCenterFrequency(0),
+    m_inputIndex(0)
 {
     QString name = "UpChannelizer(" + m_sampleSource->objectName() + ")";
     setObjectName(name);
+    m_sourceProfile.setOwner(m_sampleSource, "mod");
 }
 
 UpChannelizer::~UpChannelizer()
@@ -72,43 +74,75 @@ void UpChannelizer::pull(Sample& sample)
     else
     {
         m_mutex.lock();
+        workStages();
+        sample = *m_stageSamples.begin();
+        m_mutex.unlock();
+    }
+}
 
-        FilterStages::iterator stage = m_filterStages.begin();
-        std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+void UpChannelizer::pull(SampleVector::iterator begin, unsigned int nbSamples)
+{
+    if(m_sampleSource == 0) {
+        m_sampleBuffer.clear();
+        return;
+    }
 
-        for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+    if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+    {
+        ProfileTimer sourceTimer(m_sourceProfile, nbSamples);
+        m_sampleSource->pull(begin, nbSamples);
+    }
+    else
+    {
+        m_mutex.lock();
+        unsigned int log2Interp = m_filterStages.size();
+
+        for (unsigned int i = 0; i < nbSamples; i++, ++begin)
         {
-            if(stage == m_filterStages.end() - 1)
+            // at most one input sample is consumed per output sample so the input block
+            // is refilled with just what is needed for the remaining output samples
+            if (m_inputIndex == m_inputBuffer.size())
             {
-                if ((*stage)->work(&m_sampleIn, &(*stageSample)))
-                {
-                    m_sampleSource->pull(m_sampleIn); // get new input sample
-                }
-            }
-            else
-            {
-                if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
-                {
-                    break;
-                }
+                m_inputBuffer.resize(((nbSamples - i) >> log2Interp) + 1);
+                ProfileTimer sourceTimer(m_sourceProfile, m_inputBuffer.size());
+                m_sampleSource->pull(m_inputBuffer.begin(), m_inputBuffer.size());
+                m_inputIndex = 0;
             }
+
+            workStages();
+            *begin = *m_stageSamples.begin();
         }
 
-        sample = *m_stageSamples.begin();
+        m_mutex.unlock();
+    }
+}
 
-//		for (; stage != m_filterStages.end(); ++stage)
-//		{
-//			// let's make it work for one stage only (96 kS/s < SR < 192 kS/s)
-//			if(stage == m_filterStages.end() - 1)
-//			{
-//				if ((*stage)->work(&m_sampleIn, &sample))
-//				{
-//					m_sampleSource->pull(m_sampleIn); // get new input sample
-//				}
-//			}
-//		}
+void UpChannelizer::workStages()
+{
+    FilterStages::iterator stage = m_filterStages.begin();
+    std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
 
-        m_mutex.unlock();
+    for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+    {
+        if(stage == m_filterStages.end() - 1)
+        {
+            if ((*stage)->work(&m_sampleIn, &(*stageSample)))
+            {
+                // get new input sample
+                if (m_inputIndex < m_inputBuffer.size()) {
+                    m_sampleIn = m_inputBuffer[m_inputIndex++];
+                } else {
+                    m_sampleSource->pull(m_sampleIn);
+                }
+            }
+        }
+        else
+        {
+            if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
+            {
+                break;
+            }
+        }
     }
 }
 
@@ -411,6 +445,8 @@ void UpChannelizer::freeFilterChain()
         delete *it;
     m_filterStages.clear();
     m_stageSamples.clear();
+    m_inputBuffer.clear();
+    m_inputIndex = 0;
 }
 
 
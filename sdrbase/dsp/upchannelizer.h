@@ -24,6 +24,7 @@
 #include <QMutex>
 #include "export.h"
 #include "util/message.h"
+#include "util/profiler.h"
 #ifdef USE_SSE4_1
 #include "dsp/inthalfbandfiltereo1.h"
 #else
@@ -39,6 +40,7 @@ class SDRBASE_API UpChannelizer : public BasebandSampleSource {
 public:
     class SDRBASE_API MsgChannelizerNotification : public Message {
         MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED(MsgChannelizerNotification)
 
     public:
         MsgChannelizerNotification(int basebandSampleRate, int samplerate, qint64 frequencyOffset) :
@@ -91,6 +93,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pull(SampleVector::iterator begin, unsigned int nbSamples);
     virtual void pullAudio(int nbSamples) { if (m_sampleSource) m_sampleSource->pullAudio(nbSamples); }
 
     virtual bool handleMessage(const Message& cmd);
@@ -132,8 +135,12 @@ protected:
     int m_currentCenterFrequency;
     SampleVector m_sampleBuffer;
     Sample m_sampleIn;
+    ProfileCounter m_sourceProfile; //!< time spent in the modulator block pulls (single sample pulls are not timed)
+    SampleVector m_inputBuffer;   //!< input samples pulled from the modulator in block
+    unsigned int m_inputIndex;    //!< next sample to consume in the input block
     QMutex m_mutex;
 
+    void workStages();            //!< run the filter chain for one output sample
     void applyConfiguration();
     void applySetting(unsigned int log2Decim, unsigned int filterChainHash);
     bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
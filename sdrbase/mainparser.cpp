@@ -20,6 +20,8 @@
 #include <QRegExpValidator>
 #include <QDebug>
 
+#include "dsp/filerecord.h"
+
 #include "mainparser.h"
 
 MainParser::MainParser() :
@@ -31,11 +33,47 @@ MainParser::MainParser() :
         "Web API server port.",
         "port",
         "8091"),
-    m_mimoOption("mimo", "Activate MIMO functionality")
+    m_reportsPortOption("reports-port",
+        "Web socket server port pushing device and channel reports to subscribed clients. 0 to disable.",
+        "port",
+        "0"),
+    m_mimoOption("mimo", "Activate MIMO functionality"),
+    m_blockChannelizerOption("block-channelizer", "Channelizers process whole sample blocks with SIMD half-band filters"),
+    m_pfbSubbandsOption("pfb-subbands",
+        "Log2 of the number of sub-bands of the filter bank shared by the channels of a source device (1 to 10).",
+        "log2",
+        "6"),
+    m_fftwPrePlanOption("fftw-preplan", "Create FFTW plans for the common FFT sizes at startup and save them in the wisdom file"),
+    m_recordBuffersOption("record-buffers",
+        "Memory used by each I/Q recorder to queue samples to disk in MiB.",
+        "size",
+        "64"),
+    m_recordDirectIOOption("record-direct-io", "I/Q recorders bypass the system page cache (Linux only)"),
+    m_recordPreallocateOption("record-preallocate",
+        "Disk space reserved ahead of the I/Q recorders write position in MiB (Linux only). 0 for none.",
+        "size",
+        "0"),
+    m_recordRotateSizeOption("record-rotate-size",
+        "I/Q recorders start a new file when the current one reaches this size in MiB. 0 for no limit.",
+        "size",
+        "0"),
+    m_recordRotateTimeOption("record-rotate-time",
+        "I/Q recorders start a new file after this number of seconds of samples. 0 for no limit.",
+        "seconds",
+        "0")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
+    m_reportsPort = 0;
     m_mimoSupport = false;
+    m_blockChannelizer = false;
+    m_pfbLog2NbSubbands = 6;
+    m_fftwPrePlan = false;
+    m_recordBuffers = 64;
+    m_recordDirectIO = false;
+    m_recordPreallocate = 0;
+    m_recordRotateSize = 0;
+    m_recordRotateTime = 0;
     m_mimoOption.setFlags(QCommandLineOption::HiddenFromHelp);
 
     m_parser.setApplicationDescription("Software Defined Radio application");
@@ -44,7 +82,16 @@ MainParser::MainParser() :
 
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
+    m_parser.addOption(m_reportsPortOption);
     m_parser.addOption(m_mimoOption);
+    m_parser.addOption(m_blockChannelizerOption);
+    m_parser.addOption(m_pfbSubbandsOption);
+    m_parser.addOption(m_fftwPrePlanOption);
+    m_parser.addOption(m_recordBuffersOption);
+    m_parser.addOption(m_recordDirectIOOption);
+    m_parser.addOption(m_recordPreallocateOption);
+    m_parser.addOption(m_recordRotateSizeOption);
+    m_parser.addOption(m_recordRotateTimeOption);
 }
 
 MainParser::~MainParser()
@@ -85,7 +132,83 @@ void MainParser::parse(const QCoreApplication& app)
         qWarning() << "MainParser::parse: server port invalid. Defaulting to " << m_serverPort;
     }
 
+    // reports server port
+
+    int reportsPort = m_parser.value(m_reportsPortOption).toInt(&ok);
+
+    if (ok && ((reportsPort == 0) || ((reportsPort > 1023) && (reportsPort < 65536) && (reportsPort != m_serverPort)))) {
+        m_reportsPort = reportsPort;
+    } else {
+        qWarning() << "MainParser::parse: reports server port invalid. Defaulting to " << m_reportsPort;
+    }
+
     // MIMO
 
     m_mimoSupport = m_parser.isSet(m_mimoOption);
+
+    // Block channelizer
+
+    m_blockChannelizer = m_parser.isSet(m_blockChannelizerOption);
+
+    // Shared filter bank
+
+    int pfbLog2NbSubbands = m_parser.value(m_pfbSubbandsOption).toInt(&ok);
+
+    if (ok && (pfbLog2NbSubbands >= 1) && (pfbLog2NbSubbands <= 10)) {
+        m_pfbLog2NbSubbands = pfbLog2NbSubbands;
+    } else {
+        qWarning() << "MainParser::parse: filter bank sub-bands invalid. Defaulting to " << m_pfbLog2NbSubbands;
+    }
+
+    // FFTW pre-planning
+
+    m_fftwPrePlan = m_parser.isSet(m_fftwPrePlanOption);
+
+    // I/Q recorders
+
+    int recordBuffers = m_parser.value(m_recordBuffersOption).toInt(&ok);
+
+    if (ok && (recordBuffers >= 8) && (recordBuffers <= 4096)) {
+        m_recordBuffers = recordBuffers;
+    } else {
+        qWarning() << "MainParser::parse: record buffers size invalid. Defaulting to " << m_recordBuffers;
+    }
+
+    m_recordDirectIO = m_parser.isSet(m_recordDirectIOOption);
+
+    int recordPreallocate = m_parser.value(m_recordPreallocateOption).toInt(&ok);
+
+    if (ok && (recordPreallocate >= 0)) {
+        m_recordPreallocate = recordPreallocate;
+    } else {
+        qWarning() << "MainParser::parse: record preallocation size invalid. Defaulting to " << m_recordPreallocate;
+    }
+
+    int recordRotateSize = m_parser.value(m_recordRotateSizeOption).toInt(&ok);
+
+    if (ok && (recordRotateSize >= 0)) {
+        m_recordRotateSize = recordRotateSize;
+    } else {
+        qWarning() << "MainParser::parse: record rotation size invalid. Defaulting to " << m_recordRotateSize;
+    }
+
+    int recordRotateTime = m_parser.value(m_recordRotateTimeOption).toInt(&ok);
+
+    if (ok && (recordRotateTime >= 0)) {
+        m_recordRotateTime = recordRotateTime;
+    } else {
+        qWarning() << "MainParser::parse: record rotation time invalid. Defaulting to " << m_recordRotateTime;
+    }
+}
+
+void MainParser::applyRecordConfig() const
+{
+    FileRecord::Config config;
+    // in 64 bits as the buffers size in MiB shifted to bytes does not fit an int above 2047
+    config.m_writer.m_nbBuffers = ((quint64) m_recordBuffers << 20) / config.m_writer.m_bufferSize;
+    config.m_writer.m_directIO = m_recordDirectIO;
+    config.m_writer.m_preallocateSize = (quint64) m_recordPreallocate << 20;
+    config.m_rotateSize = (quint64) m_recordRotateSize << 20;
+    config.m_rotateTime = m_recordRotateTime;
+    FileRecord::setDefaultConfig(config);
 }
@@ -34,17 +34,46 @@ public:
 
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
+    uint16_t getReportsPort() const { return m_reportsPort; }   //!< 0 if disabled
     bool getMIMOSupport() const { return m_mimoSupport; }
+    bool getBlockChannelizer() const { return m_blockChannelizer; }
+    unsigned int getPFBLog2NbSubbands() const { return m_pfbLog2NbSubbands; }
+    bool getFFTWPrePlan() const { return m_fftwPrePlan; }
+    int getRecordBuffers() const { return m_recordBuffers; }         //!< MiB
+    bool getRecordDirectIO() const { return m_recordDirectIO; }
+    int getRecordPreallocate() const { return m_recordPreallocate; } //!< MiB
+    int getRecordRotateSize() const { return m_recordRotateSize; }   //!< MiB
+    int getRecordRotateTime() const { return m_recordRotateTime; }   //!< seconds
+
+    void applyRecordConfig() const; //!< set the default configuration of the I/Q recorders from the record options
 
 private:
     QString  m_serverAddress;
     uint16_t m_serverPort;
+    uint16_t m_reportsPort;
     bool m_mimoSupport;
+    bool m_blockChannelizer;
+    unsigned int m_pfbLog2NbSubbands;
+    bool m_fftwPrePlan;
+    int m_recordBuffers;
+    bool m_recordDirectIO;
+    int m_recordPreallocate;
+    int m_recordRotateSize;
+    int m_recordRotateTime;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
+    QCommandLineOption m_reportsPortOption;
     QCommandLineOption m_mimoOption;
+    QCommandLineOption m_blockChannelizerOption;
+    QCommandLineOption m_pfbSubbandsOption;
+    QCommandLineOption m_fftwPrePlanOption;
+    QCommandLineOption m_recordBuffersOption;
+    QCommandLineOption m_recordDirectIOOption;
+    QCommandLineOption m_recordPreallocateOption;
+    QCommandLineOption m_recordRotateSizeOption;
+    QCommandLineOption m_recordRotateTimeOption;
 };
 
 
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QStringList>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#elif defined(__linux__) && defined(__arm__) && !defined(__aarch64__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+#include "cpufeatures.h"
+
+CPUFeatures::Features::Features() :
+    m_sse2(false),
+    m_sse41(false),
+    m_avx2(false),
+    m_neon(false)
+{
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    m_sse2 = __builtin_cpu_supports("sse2");
+    m_sse41 = __builtin_cpu_supports("sse4.1");
+    m_avx2 = __builtin_cpu_supports("avx2"); // also checks that the OS saves the YMM registers
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    int nIds = info[0];
+    __cpuid(info, 1);
+    m_sse2 = (info[3] & (1<<26)) != 0;
+    m_sse41 = (info[2] & (1<<19)) != 0;
+    bool osxsave = (info[2] & (1<<27)) != 0;
+    bool avx = (info[2] & (1<<28)) != 0;
+
+    if (osxsave && avx && (nIds >= 7))
+    {
+        bool ymmSaved = (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        m_avx2 = ymmSaved && ((info[1] & (1<<5)) != 0);
+    }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    m_neon = true; // mandatory in ARMv8
+#elif defined(__linux__) && defined(__arm__)
+    m_neon = (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    m_neon = true;
+#endif
+}
+
+const CPUFeatures::Features& CPUFeatures::features()
+{
+    static const Features features;
+    return features;
+}
+
+QString CPUFeatures::getDescription()
+{
+    QStringList list;
+
+    if (hasSSE2()) {
+        list.append("SSE2");
+    }
+    if (hasSSE41()) {
+        list.append("SSE4.1");
+    }
+    if (hasAVX2()) {
+        list.append("AVX2");
+    }
+    if (hasNEON()) {
+        list.append("NEON");
+    }
+
+    return list.size() == 0 ? QString("none") : list.join(" ");
+}
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_CPUFEATURES_H_
+#define SDRBASE_UTIL_CPUFEATURES_H_
+
+#include <QString>
+
+#include "export.h"
+
+/**
+ * SIMD instruction sets available on the running CPU. This is what the runtime dispatched kernels
+ * rely on as opposed to the USE_xxx macros that reflect the compilation flags.
+ */
+class SDRBASE_API CPUFeatures
+{
+public:
+    static bool hasSSE2() { return features().m_sse2; }
+    static bool hasSSE41() { return features().m_sse41; }
+    static bool hasAVX2() { return features().m_avx2; }
+    static bool hasNEON() { return features().m_neon; }
+    static QString getDescription(); //!< space separated list of the instruction sets found
+
+private:
+    struct Features
+    {
+        bool m_sse2;
+        bool m_sse41;
+        bool m_avx2;
+        bool m_neon;
+
+        Features();
+    };
+
+    static const Features& features();
+};
+
+#endif // SDRBASE_UTIL_CPUFEATURES_H_
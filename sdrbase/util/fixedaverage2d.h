@@ -52,6 +52,12 @@ public:
         m_maxIndex = 0;
     }
 
+    void reset()
+    {
+        std::fill(m_sum, m_sum+m_width, 0);
+        m_maxIndex = 0;
+    }
+
     bool storeAndGetAvg(T& avg, T v, unsigned int index)
     {
         if (m_size <= 1)
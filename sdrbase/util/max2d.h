@@ -52,6 +52,12 @@ public:
         m_maxIndex = 0;
     }
 
+    void reset()
+    {
+        std::fill(m_max, m_max+m_width, 0);
+        m_maxIndex = 0;
+    }
+
     bool storeAndGetMax(T& max, T v, unsigned int index)
     {
         if (m_size <= 1)
@@ -20,6 +20,8 @@
 #define INCLUDE_MESSAGE_H
 
 #include <stdlib.h>
+#include <QAtomicPointer>
+#include "util/messagepool.h"
 #include "export.h"
 
 class SDRBASE_API Message {
@@ -38,6 +40,11 @@ protected:
 	// addressing
 	static const char* m_identifier;
 	void* m_destination;
+
+private:
+	QAtomicPointer<Message> m_queueNext; //!< link in the MessageQueue the message is pushed to
+
+	friend class MessageQueue;
 };
 
 #define MESSAGE_CLASS_DECLARATION \
@@ -49,6 +56,16 @@ protected:
 		static const char* m_identifier; \
 	private:
 
+/**
+ * Add to the declaration of message classes created at a high rate to recycle their memory
+ * (see MessagePool). Creation and deletion are unchanged (new and delete).
+ */
+#define MESSAGE_CLASS_POOLED(Name) \
+	public: \
+		static void* operator new(std::size_t size) { return MessagePool<Name>::allocate(size); } \
+		static void operator delete(void* p, std::size_t size) { MessagePool<Name>::deallocate(p, size); } \
+	private:
+
 #define MESSAGE_CLASS_DEFINITION(Name, BaseClass) \
 	const char* Name::m_identifier = #Name; \
 	const char* Name::getIdentifier() const { return m_identifier; } \
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_MESSAGEPOOL_H_
+#define SDRBASE_UTIL_MESSAGEPOOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+/**
+ * Free list of memory blocks for one message class. Messages of high frequency classes are
+ * created by the DSP or device threads and deleted by the consumer of the queue so blocks are
+ * recycled instead of going back and forth to the heap. The list is guarded by a spin lock
+ * that is only held to link or unlink one block.
+ *
+ * Blocks are plain ::operator new blocks of sizeof(T) so a block can be freed by any instance
+ * of the pool (e.g. one instance per shared library on Windows). Classes derived from T have
+ * a different size and fall back to the heap.
+ */
+template<typename T>
+class MessagePool
+{
+public:
+    static void *allocate(std::size_t size)
+    {
+        if (size == sizeof(T))
+        {
+            lock();
+            Block *block = m_free;
+
+            if (block)
+            {
+                m_free = block->m_next;
+                m_nbFree--;
+            }
+
+            unlock();
+
+            if (block) {
+                return block;
+            }
+        }
+
+        return ::operator new(size);
+    }
+
+    static void deallocate(void *p, std::size_t size)
+    {
+        if (!p) {
+            return;
+        }
+
+        if (size == sizeof(T))
+        {
+            lock();
+
+            if (m_nbFree < m_maxFree)
+            {
+                Block *block = static_cast<Block*>(p);
+                block->m_next = m_free;
+                m_free = block;
+                m_nbFree++;
+                p = nullptr;
+            }
+
+            unlock();
+        }
+
+        if (p) {
+            ::operator delete(p);
+        }
+    }
+
+private:
+    struct Block {
+        Block *m_next;
+    };
+
+    static const int m_maxFree = 256; //!< blocks kept beyond this go back to the heap
+    static std::atomic_flag m_lock;
+    static Block *m_free;
+    static int m_nbFree;
+
+    static void lock()
+    {
+        while (m_lock.test_and_set(std::memory_order_acquire)) {}
+    }
+
+    static void unlock() {
+        m_lock.clear(std::memory_order_release);
+    }
+};
+
+template<typename T> std::atomic_flag MessagePool<T>::m_lock = ATOMIC_FLAG_INIT;
+template<typename T> typename MessagePool<T>::Block *MessagePool<T>::m_free = nullptr;
+template<typename T> int MessagePool<T>::m_nbFree = 0;
+
+#endif // SDRBASE_UTIL_MESSAGEPOOL_H_
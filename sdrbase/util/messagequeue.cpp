@@ -21,10 +21,13 @@
 #include "util/messagequeue.h"
 #include "util/message.h"
 
+MESSAGE_CLASS_DEFINITION(MessageQueue::CoalesceSlot, Message)
+
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0)
 {
 }
 
@@ -37,15 +40,65 @@ MessageQueue::~MessageQueue()
 		qDebug() << "MessageQueue::~MessageQueue: message: " << message->getIdentifier() << " was still in queue";
 		delete message;
 	}
+
+	for (std::vector<CoalesceSlot*>::iterator it = m_coalesceSlots.begin(); it != m_coalesceSlots.end(); ++it) {
+		delete *it;
+	}
+}
+
+void MessageQueue::enqueue(Message* message)
+{
+	message->m_queueNext.storeRelease(nullptr);
+	Message* prev = m_head.fetchAndStoreOrdered(message);
+	// the consumer sees the message when it is linked to the previous one
+	prev->m_queueNext.storeRelease(message);
+}
+
+Message* MessageQueue::dequeue()
+{
+	Message* tail = m_tail;
+	Message* next = tail->m_queueNext.loadAcquire();
+
+	if (tail == &m_stub)
+	{
+		if (!next) {
+			return nullptr;
+		}
+
+		m_tail = next;
+		tail = next;
+		next = next->m_queueNext.loadAcquire();
+	}
+
+	if (next)
+	{
+		m_tail = next;
+		return tail;
+	}
+
+	if (tail != m_head.loadAcquire()) {
+		return nullptr; // a producer has not linked its message yet: it will signal when done
+	}
+
+	// tail is the last message: put the stub behind it so that it can be unlinked
+	enqueue(&m_stub);
+	next = tail->m_queueNext.loadAcquire();
+
+	if (next)
+	{
+		m_tail = next;
+		return tail;
+	}
+
+	return nullptr;
 }
 
 void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		enqueue(message);
+		m_size.ref();
 	}
 
 	if (emitSignal)
@@ -54,29 +107,88 @@ void MessageQueue::push(Message* message, bool emitSignal)
 	}
 }
 
-Message* MessageQueue::pop()
+void MessageQueue::pushCoalesced(Message* message, bool emitSignal)
 {
-	QMutexLocker locker(&m_lock);
+	if (!message) {
+		return;
+	}
 
-	if (m_queue.isEmpty())
+	const char *identifier = message->getIdentifier();
+	CoalesceSlot *slot = nullptr;
+	Message *replaced;
+
+	{
+		QMutexLocker locker(&m_coalesceMutex);
+
+		for (std::vector<CoalesceSlot*>::iterator it = m_coalesceSlots.begin(); it != m_coalesceSlots.end(); ++it)
+		{
+			if ((*it)->m_messageIdentifier == identifier)
+			{
+				slot = *it;
+				break;
+			}
+		}
+
+		if (!slot)
+		{
+			slot = new CoalesceSlot(identifier);
+			m_coalesceSlots.push_back(slot);
+		}
+
+		replaced = slot->m_pending;
+		slot->m_pending = message;
+	}
+
+	if (replaced)
 	{
-		return 0;
+		delete replaced; // the slot is already queued
 	}
 	else
 	{
-		return m_queue.takeFirst();
+		// the slot was empty so it is not in the queue
+		enqueue(slot);
+		m_size.ref();
+
+		if (emitSignal) {
+			emit messageEnqueued();
+		}
 	}
 }
 
-int MessageQueue::size()
+Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	Message* message;
+
+	while ((message = dequeue()) != 0)
+	{
+		m_size.deref();
+
+		if (CoalesceSlot::match(*message))
+		{
+			CoalesceSlot *slot = (CoalesceSlot*) message;
+			QMutexLocker locker(&m_coalesceMutex);
+			message = slot->m_pending;
+			slot->m_pending = nullptr;
+		}
+
+		if (message) {
+			return message;
+		}
+	}
+
+	return 0;
+}
 
-	return m_queue.size();
+int MessageQueue::size()
+{
+	return m_size.loadAcquire();
 }
 
 void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
-	m_queue.clear();
+	Message* message;
+
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
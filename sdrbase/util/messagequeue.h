@@ -19,13 +19,25 @@
 #ifndef INCLUDE_MESSAGEQUEUE_H
 #define INCLUDE_MESSAGEQUEUE_H
 
+#include <vector>
 #include <QObject>
-#include <QQueue>
+#include <QAtomicInt>
+#include <QAtomicPointer>
 #include <QMutex>
+#include "util/message.h"
 #include "export.h"
 
-class Message;
-
+/**
+ * Multiple producers single consumer message queue. Messages are linked through their own
+ * queue link so push and pop take no lock and allocate nothing (intrusive MPSC queue from
+ * D. Vyukov). push() may be called from any thread, pop() and clear() only from the thread
+ * that consumes the queue. size() is an atomic counter cheap enough to be polled in the
+ * DSP loops.
+ *
+ * pushCoalesced() keeps only the latest not yet popped message of a given class: use it
+ * for reports where the consumer only needs the most recent value. The coalesced message
+ * takes the place in the queue of the first one that was pushed since the last pop.
+ */
 class SDRBASE_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -34,6 +46,7 @@ public:
 	~MessageQueue();
 
 	void push(Message* message, bool emitSignal = true);  //!< Push message onto queue
+	void pushCoalesced(Message* message, bool emitSignal = true); //!< Push message replacing a pending message of the same class
 	Message* pop(); //!< Pop message from queue
 
 	int size(); //!< Returns queue size
@@ -43,8 +56,33 @@ signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	class CoalesceSlot : public Message {
+		MESSAGE_CLASS_DECLARATION
+
+	public:
+		CoalesceSlot(const char *identifier) :
+			Message(),
+			m_messageIdentifier(identifier),
+			m_pending(nullptr)
+		{ }
+
+		const char *m_messageIdentifier;
+		Message *m_pending;
+	};
+
+	static const int m_cacheLineSize = 64;
+
+	QAtomicPointer<Message> m_head; //!< last pushed, moved by producers
+	char m_pad0[m_cacheLineSize];
+	Message *m_tail;                //!< next to pop, moved by the consumer
+	char m_pad1[m_cacheLineSize];
+	QAtomicInt m_size;
+	Message m_stub;
+	QMutex m_coalesceMutex;
+	std::vector<CoalesceSlot*> m_coalesceSlots;
+
+	void enqueue(Message* message);
+	Message* dequeue();
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
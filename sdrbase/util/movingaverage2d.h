@@ -67,6 +67,13 @@ public:
         m_avgIndex = 0;
     }
 
+    void reset()
+    {
+        std::fill(m_data, m_data+(m_width*m_depth), 0.0);
+        std::fill(m_sum, m_sum+m_width, 0.0);
+        m_avgIndex = 0;
+    }
+
     T storeAndGetAvg(T v, unsigned int index)
     {
         if (m_depth <= 1)
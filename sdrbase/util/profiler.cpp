@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <QMutexLocker>
+
+#include "profiler.h"
+
+ProfileCounter::ProfileCounter() :
+    m_calls(0),
+    m_samples(0),
+    m_totalNs(0),
+    m_maxNs(0)
+{
+    Profiler::instance().addCounter(this);
+}
+
+ProfileCounter::~ProfileCounter()
+{
+    Profiler::instance().removeCounter(this);
+}
+
+void ProfileCounter::setOwner(const QObject *owner, const QString& name)
+{
+    Profiler::instance().setCounterOwner(this, owner, name);
+}
+
+void ProfileCounter::reset()
+{
+    m_calls.store(0, std::memory_order_relaxed);
+    m_samples.store(0, std::memory_order_relaxed);
+    m_totalNs.store(0, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+FifoCounter::FifoCounter() :
+    m_size(0),
+    m_fill(0),
+    m_maxFill(0),
+    m_transferred(0),
+    m_dropped(0)
+{
+    Profiler::instance().addCounter(this);
+}
+
+FifoCounter::~FifoCounter()
+{
+    Profiler::instance().removeCounter(this);
+}
+
+void FifoCounter::setOwner(const QObject *owner, const QString& name)
+{
+    Profiler::instance().setCounterOwner(this, owner, name);
+}
+
+void FifoCounter::reset()
+{
+    m_maxFill.store(m_fill.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_transferred.store(0, std::memory_order_relaxed);
+    m_dropped.store(0, std::memory_order_relaxed);
+}
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+{
+    m_elapsed.start();
+}
+
+void Profiler::addCounter(ProfileCounter *counter)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    StageEntry entry = {counter, nullptr, QString()};
+    m_stages.push_back(entry);
+}
+
+void Profiler::removeCounter(ProfileCounter *counter)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_stages.erase(
+        std::remove_if(m_stages.begin(), m_stages.end(), [=](const StageEntry& entry) { return entry.m_counter == counter; }),
+        m_stages.end()
+    );
+}
+
+void Profiler::setCounterOwner(ProfileCounter *counter, const QObject *owner, const QString& name)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::vector<StageEntry>::iterator it = m_stages.begin(); it != m_stages.end(); ++it)
+    {
+        if (it->m_counter == counter)
+        {
+            it->m_owner = owner;
+            it->m_name = name;
+            break;
+        }
+    }
+}
+
+void Profiler::addCounter(FifoCounter *counter)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    FifoEntry entry = {counter, nullptr, QString()};
+    m_fifos.push_back(entry);
+}
+
+void Profiler::removeCounter(FifoCounter *counter)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_fifos.erase(
+        std::remove_if(m_fifos.begin(), m_fifos.end(), [=](const FifoEntry& entry) { return entry.m_counter == counter; }),
+        m_fifos.end()
+    );
+}
+
+void Profiler::setCounterOwner(FifoCounter *counter, const QObject *owner, const QString& name)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::vector<FifoEntry>::iterator it = m_fifos.begin(); it != m_fifos.end(); ++it)
+    {
+        if (it->m_counter == counter)
+        {
+            it->m_owner = owner;
+            it->m_name = name;
+            break;
+        }
+    }
+}
+
+void Profiler::snapshot(std::vector<StageSnapshot>& stages, std::vector<FifoSnapshot>& fifos) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    stages.clear();
+    fifos.clear();
+
+    // counters without owner are not attached to a device or channel and are not reported
+    for (std::vector<StageEntry>::const_iterator it = m_stages.begin(); it != m_stages.end(); ++it)
+    {
+        if (!it->m_owner) {
+            continue;
+        }
+
+        StageSnapshot stage;
+        stage.m_owner = it->m_owner;
+        stage.m_name = it->m_name;
+        stage.m_calls = it->m_counter->getCalls();
+        stage.m_samples = it->m_counter->getSamples();
+        stage.m_totalNs = it->m_counter->getTotalNs();
+        stage.m_maxNs = it->m_counter->getMaxNs();
+        stages.push_back(stage);
+    }
+
+    for (std::vector<FifoEntry>::const_iterator it = m_fifos.begin(); it != m_fifos.end(); ++it)
+    {
+        if (!it->m_owner) {
+            continue;
+        }
+
+        FifoSnapshot fifo;
+        fifo.m_owner = it->m_owner;
+        fifo.m_name = it->m_name;
+        fifo.m_size = it->m_counter->getSize();
+        fifo.m_fill = it->m_counter->getFill();
+        fifo.m_maxFill = it->m_counter->getMaxFill();
+        fifo.m_transferred = it->m_counter->getTransferred();
+        fifo.m_dropped = it->m_counter->getDropped();
+        fifos.push_back(fifo);
+    }
+}
+
+void Profiler::reset()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::vector<StageEntry>::iterator it = m_stages.begin(); it != m_stages.end(); ++it) {
+        it->m_counter->reset();
+    }
+
+    for (std::vector<FifoEntry>::iterator it = m_fifos.begin(); it != m_fifos.end(); ++it) {
+        it->m_counter->reset();
+    }
+
+    m_elapsed.restart();
+}
+
+qint64 Profiler::getElapsedNs() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_elapsed.nsecsElapsed();
+}
@@ -0,0 +1,209 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_PROFILER_H_
+#define SDRBASE_UTIL_PROFILER_H_
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <QString>
+#include <QMutex>
+#include <QElapsedTimer>
+
+#include "export.h"
+
+class QObject;
+
+/**
+ * Time spent in a processing stage. Only the thread running the stage calls add() so the
+ * values are plain relaxed atomics that can be read at any time from another thread.
+ * Counters register themselves in the Profiler on construction. The owner (DSP engine or channel)
+ * is only used as a tag to group the counters in reports and is never dereferenced.
+ */
+class SDRBASE_API ProfileCounter
+{
+public:
+    ProfileCounter();
+    ~ProfileCounter();
+
+    void setOwner(const QObject *owner, const QString& name);
+    void reset();
+
+    void add(quint64 nanoseconds, quint64 samples)
+    {
+        m_calls.store(m_calls.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        m_samples.store(m_samples.load(std::memory_order_relaxed) + samples, std::memory_order_relaxed);
+        m_totalNs.store(m_totalNs.load(std::memory_order_relaxed) + nanoseconds, std::memory_order_relaxed);
+
+        if (nanoseconds > m_maxNs.load(std::memory_order_relaxed)) {
+            m_maxNs.store(nanoseconds, std::memory_order_relaxed);
+        }
+    }
+
+    quint64 getCalls() const { return m_calls.load(std::memory_order_relaxed); }
+    quint64 getSamples() const { return m_samples.load(std::memory_order_relaxed); }
+    quint64 getTotalNs() const { return m_totalNs.load(std::memory_order_relaxed); }
+    quint64 getMaxNs() const { return m_maxNs.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint64> m_calls;
+    std::atomic<quint64> m_samples;
+    std::atomic<quint64> m_totalNs;
+    std::atomic<quint64> m_maxNs;
+};
+
+/**
+ * Scoped timer adding the time spent in the scope to a ProfileCounter
+ */
+class ProfileTimer
+{
+public:
+    ProfileTimer(ProfileCounter& counter, quint64 samples = 0) :
+        m_counter(counter),
+        m_samples(samples),
+        m_start(std::chrono::steady_clock::now())
+    {}
+
+    ~ProfileTimer()
+    {
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - m_start;
+        m_counter.add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), m_samples);
+    }
+
+    void setSamples(quint64 samples) { m_samples = samples; } //!< when the count is only known at the end of the scope
+
+private:
+    ProfileCounter& m_counter;
+    quint64 m_samples;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+/**
+ * Sample FIFO statistics. All updates are done by one side of the FIFO (the producer for a
+ * sample sink FIFO, the reader for a sample source FIFO).
+ * Dropped samples are overflows of a sink FIFO and underruns of a source FIFO.
+ */
+class SDRBASE_API FifoCounter
+{
+public:
+    FifoCounter();
+    ~FifoCounter();
+
+    void setOwner(const QObject *owner, const QString& name);
+    void reset();
+
+    void setSize(quint32 size) { m_size.store(size, std::memory_order_relaxed); }
+
+    void transferred(quint32 count, quint32 fill)
+    {
+        m_transferred.store(m_transferred.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        m_fill.store(fill, std::memory_order_relaxed);
+
+        if (fill > m_maxFill.load(std::memory_order_relaxed)) {
+            m_maxFill.store(fill, std::memory_order_relaxed);
+        }
+    }
+
+    void dropped(quint32 count) {
+        m_dropped.store(m_dropped.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+    }
+
+    quint32 getSize() const { return m_size.load(std::memory_order_relaxed); }
+    quint32 getFill() const { return m_fill.load(std::memory_order_relaxed); }
+    quint32 getMaxFill() const { return m_maxFill.load(std::memory_order_relaxed); }
+    quint64 getTransferred() const { return m_transferred.load(std::memory_order_relaxed); }
+    quint64 getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<quint32> m_size;
+    std::atomic<quint32> m_fill;
+    std::atomic<quint32> m_maxFill;
+    std::atomic<quint64> m_transferred;
+    std::atomic<quint64> m_dropped;
+};
+
+/**
+ * Registry of all the profile and FIFO counters. Reports are built from a snapshot of the values
+ * taken under the registry lock so counters can come and go with the devices and channels.
+ */
+class SDRBASE_API Profiler
+{
+public:
+    struct StageSnapshot
+    {
+        const QObject *m_owner;
+        QString m_name;
+        quint64 m_calls;
+        quint64 m_samples;
+        quint64 m_totalNs;
+        quint64 m_maxNs;
+    };
+
+    struct FifoSnapshot
+    {
+        const QObject *m_owner;
+        QString m_name;
+        quint32 m_size;
+        quint32 m_fill;
+        quint32 m_maxFill;
+        quint64 m_transferred;
+        quint64 m_dropped;
+    };
+
+    static Profiler& instance();
+
+    void snapshot(std::vector<StageSnapshot>& stages, std::vector<FifoSnapshot>& fifos) const;
+    void reset(); //!< reset all counters and the elapsed time (updates racing with the reset may be lost)
+    qint64 getElapsedNs() const; //!< time since the last reset
+
+private:
+    struct StageEntry
+    {
+        ProfileCounter *m_counter;
+        const QObject *m_owner;
+        QString m_name;
+    };
+
+    struct FifoEntry
+    {
+        FifoCounter *m_counter;
+        const QObject *m_owner;
+        QString m_name;
+    };
+
+    Profiler();
+
+    void addCounter(ProfileCounter *counter);
+    void removeCounter(ProfileCounter *counter);
+    void setCounterOwner(ProfileCounter *counter, const QObject *owner, const QString& name);
+    void addCounter(FifoCounter *counter);
+    void removeCounter(FifoCounter *counter);
+    void setCounterOwner(FifoCounter *counter, const QObject *owner, const QString& name);
+
+    mutable QMutex m_mutex;
+    std::vector<StageEntry> m_stages;
+    std::vector<FifoEntry> m_fifos;
+    QElapsedTimer m_elapsed;
+
+    friend class ProfileCounter;
+    friend class FifoCounter;
+};
+
+#endif // SDRBASE_UTIL_PROFILER_H_
@@ -283,40 +283,32 @@ void RTPSink::write(const uint8_t *sampleByteL, const uint8_t *sampleByteR)
 
 void RTPSink::write(const uint8_t *samples, int nbSamples)
 {
-    int samplesIndex = 0;
     QMutexLocker locker(&m_mutex);
 
-    // fill remainder of buffer and send it
-    if (m_sampleBufferIndex + nbSamples > m_packetSamples)
+    while (nbSamples > 0)
     {
-        writeNetBuf(&m_byteBuffer[m_sampleBufferIndex*m_sampleBytes],
-                &samples[samplesIndex*m_sampleBytes],
-                elemLength(m_payloadType),
-                (m_packetSamples - m_sampleBufferIndex)*m_sampleBytes,
-                m_endianReverse);
-        m_rtpSession.SendPacket((const void *) m_byteBuffer, (std::size_t) m_bufferSize);
-        nbSamples -= (m_packetSamples - m_sampleBufferIndex);
-        m_sampleBufferIndex = 0;
-    }
+        // like the single sample write a full packet is sent when the next sample comes in
+        if (m_sampleBufferIndex == m_packetSamples)
+        {
+            int status = m_rtpSession.SendPacket((const void *) m_byteBuffer, (std::size_t) m_bufferSize);
 
-    // send complete packets
-    while (nbSamples > m_packetSamples)
-    {
-        writeNetBuf(m_byteBuffer,
+            if (status < 0) {
+                qCritical("RTPSink::write: cannot write packet: %s", qrtplib::RTPGetErrorString(status).c_str());
+            }
+
+            m_sampleBufferIndex = 0;
+        }
+
+        int nbCopied = std::min(nbSamples, m_packetSamples - m_sampleBufferIndex);
+        writeNetBuf(&m_byteBuffer[m_sampleBufferIndex*m_sampleBytes],
                 samples,
                 elemLength(m_payloadType),
-                m_bufferSize,
+                nbCopied*m_sampleBytes,
                 m_endianReverse);
-        m_rtpSession.SendPacket((const void *) m_byteBuffer, (std::size_t) m_bufferSize);
-        samplesIndex += m_packetSamples;
-        nbSamples -= m_packetSamples;
+        m_sampleBufferIndex += nbCopied;
+        samples += nbCopied*m_sampleBytes;
+        nbSamples -= nbCopied;
     }
-
-    // copy remainder of input to buffer
-    writeNetBuf(&m_byteBuffer[m_sampleBufferIndex*m_sampleBytes],
-            &samples[samplesIndex*m_sampleBytes],
-            elemLength(m_payloadType),
-            nbSamples*m_sampleBytes,m_endianReverse);
 }
 
 void RTPSink::writeNetBuf(uint8_t *dest, const uint8_t *src, unsigned int elemLen, unsigned int bytesLen, bool endianReverse)
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_SETTINGSSNAPSHOT_H_
+#define SDRBASE_UTIL_SETTINGSSNAPSHOT_H_
+
+#include <QAtomicPointer>
+
+/**
+ * Read copy update holder of a settings or DSP state object shared between the thread that
+ * configures a channel (GUI or Web API through the input message queue) and the DSP thread
+ * that feeds it.
+ *
+ * The configuring thread builds a complete new object (settings copy, filters created with
+ * the new parameters...) and hands it over with publish(). The DSP thread calls update() once
+ * per block, typically at the start of feed(), and then uses get() without any lock for the
+ * rest of the block. Objects are only replaced at block boundaries so a block is always
+ * processed with a consistent state.
+ *
+ * There must be a single reader. Replaced objects are normally deleted by the next publish()
+ * so the DSP thread does not free memory. An object published twice before the reader picks
+ * it up is dropped without having been seen.
+ */
+template<typename T>
+class SettingsSnapshot
+{
+public:
+    explicit SettingsSnapshot(T *initial = new T()) :
+        m_current(initial),
+        m_pending(nullptr),
+        m_retired(nullptr)
+    {}
+
+    ~SettingsSnapshot()
+    {
+        delete m_current;
+        delete m_pending.fetchAndStoreOrdered(nullptr);
+        delete m_retired.fetchAndStoreOrdered(nullptr);
+    }
+
+    /** Configuring thread: take ownership of t and make it the next state of the reader */
+    void publish(T *t)
+    {
+        delete m_retired.fetchAndStoreOrdered(nullptr);
+        delete m_pending.fetchAndStoreOrdered(t);
+    }
+
+    void publish(const T& t) { publish(new T(t)); }
+
+    /** Reader: switch to the last published state if any. Returns true if the state changed */
+    bool update()
+    {
+        T *t = m_pending.fetchAndStoreOrdered(nullptr);
+
+        if (!t) {
+            return false;
+        }
+
+        T *previous = m_current;
+        m_current = t;
+        // Only non null when two states were picked up with no publish in between to collect the first
+        delete m_retired.fetchAndStoreOrdered(previous);
+        return true;
+    }
+
+    /** Reader: current state */
+    T& get() { return *m_current; }
+    const T& get() const { return *m_current; }
+    T* operator->() { return m_current; }
+    const T* operator->() const { return m_current; }
+
+private:
+    T *m_current;                //!< owned by the reader
+    QAtomicPointer<T> m_pending; //!< published and not yet picked up
+    QAtomicPointer<T> m_retired; //!< replaced by the reader and waiting to be deleted
+
+    SettingsSnapshot(const SettingsSnapshot&);
+    SettingsSnapshot& operator=(const SettingsSnapshot&);
+};
+
+#endif // SDRBASE_UTIL_SETTINGSSNAPSHOT_H_
@@ -0,0 +1,332 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+typedef int socklen_t;
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#include <string.h>
+#include <QDebug>
+
+#include "udpbatchsocket.h"
+
+#if defined(__linux__)
+#define UDPBATCHSOCKET_MMSG
+#endif
+
+#if defined(_WIN32)
+#define closesocket_ closesocket
+#else
+#define closesocket_ ::close
+#endif
+
+static bool toSockAddr(const QHostAddress& address, quint16 port, sockaddr_in& sockAddr)
+{
+    bool ok;
+    quint32 ipv4 = address.toIPv4Address(&ok);
+
+    if (!ok) {
+        return false;
+    }
+
+    memset(&sockAddr, 0, sizeof(sockAddr));
+    sockAddr.sin_family = AF_INET;
+    sockAddr.sin_addr.s_addr = htonl(ipv4);
+    sockAddr.sin_port = htons(port);
+    return true;
+}
+
+UDPBatchSocket::UDPBatchSocket() :
+    m_socket(-1),
+    m_batching(hasBatching()),
+    m_nbSystemCalls(0)
+{
+#if defined(_WIN32)
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+}
+
+UDPBatchSocket::~UDPBatchSocket()
+{
+    close();
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+bool UDPBatchSocket::hasBatching()
+{
+#ifdef UDPBATCHSOCKET_MMSG
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool UDPBatchSocket::open()
+{
+    if (isOpen()) {
+        return true;
+    }
+
+    m_socket = (qintptr) ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (m_socket == -1)
+    {
+        qWarning("UDPBatchSocket::open: cannot create socket");
+        return false;
+    }
+
+    return true;
+}
+
+bool UDPBatchSocket::bind(const QHostAddress& address, quint16 port)
+{
+    sockaddr_in sockAddr;
+
+    if (!toSockAddr(address, port, sockAddr))
+    {
+        qWarning("UDPBatchSocket::bind: %s is not an IPv4 address", qPrintable(address.toString()));
+        return false;
+    }
+
+    if (!open()) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, (const char *) &reuse, sizeof(reuse));
+
+    if (::bind(m_socket, (const sockaddr *) &sockAddr, sizeof(sockAddr)) != 0)
+    {
+        qWarning("UDPBatchSocket::bind: cannot bind to %s:%u", qPrintable(address.toString()), port);
+        return false;
+    }
+
+    return true;
+}
+
+void UDPBatchSocket::close()
+{
+    if (isOpen())
+    {
+        closesocket_(m_socket);
+        m_socket = -1;
+    }
+}
+
+void UDPBatchSocket::setBufferSizes(int sendBytes, int receiveBytes)
+{
+    if (!open()) {
+        return;
+    }
+
+    if (sendBytes > 0) {
+        setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, (const char *) &sendBytes, sizeof(sendBytes));
+    }
+
+    if (receiveBytes > 0) {
+        setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, (const char *) &receiveBytes, sizeof(receiveBytes));
+    }
+}
+
+int UDPBatchSocket::send(const char *datagrams, int datagramSize, int nbDatagrams, const QHostAddress& address, quint16 port)
+{
+    sockaddr_in destination;
+
+    if (!toSockAddr(address, port, destination) || !open()) {
+        return -1;
+    }
+
+#ifdef UDPBATCHSOCKET_MMSG
+    if (m_batching)
+    {
+        mmsghdr msgs[m_maxBatchSize];
+        iovec iovecs[m_maxBatchSize];
+        int sent = 0;
+
+        while (sent < nbDatagrams)
+        {
+            int batchSize = std::min(nbDatagrams - sent, m_maxBatchSize);
+
+            for (int i = 0; i < batchSize; i++)
+            {
+                iovecs[i].iov_base = (void *) &datagrams[(sent + i) * datagramSize];
+                iovecs[i].iov_len = datagramSize;
+                memset(&msgs[i].msg_hdr, 0, sizeof(msghdr));
+                msgs[i].msg_hdr.msg_name = &destination;
+                msgs[i].msg_hdr.msg_namelen = sizeof(destination);
+                msgs[i].msg_hdr.msg_iov = &iovecs[i];
+                msgs[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            int res = sendmmsg(m_socket, msgs, batchSize, 0); // may send less than asked
+            m_nbSystemCalls++;
+
+            if (res < 0)
+            {
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                return sent == 0 ? -1 : sent;
+            }
+
+            sent += res;
+        }
+
+        return sent;
+    }
+#endif
+
+    return sendOneByOne(datagrams, datagramSize, nbDatagrams, &destination, sizeof(destination));
+}
+
+int UDPBatchSocket::sendOneByOne(const char *datagrams, int datagramSize, int nbDatagrams, const void *destination, int destinationLength)
+{
+    for (int i = 0; i < nbDatagrams; i++)
+    {
+        int res = ::sendto(m_socket, &datagrams[i * datagramSize], datagramSize, 0,
+            (const sockaddr *) destination, (socklen_t) destinationLength);
+        m_nbSystemCalls++;
+
+        if (res < 0) {
+            return i == 0 ? -1 : i;
+        }
+    }
+
+    return nbDatagrams;
+}
+
+bool UDPBatchSocket::waitReadable(int timeoutMs)
+{
+#if defined(_WIN32)
+    fd_set readSet;
+    FD_ZERO(&readSet);
+    FD_SET((SOCKET) m_socket, &readSet);
+    timeval timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_usec = (timeoutMs % 1000) * 1000;
+    return select(0, &readSet, nullptr, nullptr, &timeout) > 0;
+#else
+    pollfd pfd;
+    pfd.fd = m_socket;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return (poll(&pfd, 1, timeoutMs) > 0) && (pfd.revents & POLLIN);
+#endif
+}
+
+int UDPBatchSocket::receive(char *datagrams, int datagramSize, int maxDatagrams, int timeoutMs,
+    int *datagramSizes, QHostAddress *senderAddress)
+{
+    if (!isOpen()) {
+        return -1;
+    }
+
+    if (!waitReadable(timeoutMs)) {
+        return 0;
+    }
+
+    sockaddr_in sources[m_maxBatchSize];
+    int nbRead;
+
+    if (maxDatagrams > m_maxBatchSize) {
+        maxDatagrams = m_maxBatchSize;
+    }
+
+#ifdef UDPBATCHSOCKET_MMSG
+    if (m_batching)
+    {
+        mmsghdr msgs[m_maxBatchSize];
+        iovec iovecs[m_maxBatchSize];
+
+        for (int i = 0; i < maxDatagrams; i++)
+        {
+            iovecs[i].iov_base = (void *) &datagrams[i * datagramSize];
+            iovecs[i].iov_len = datagramSize;
+            memset(&msgs[i].msg_hdr, 0, sizeof(msghdr));
+            msgs[i].msg_hdr.msg_name = &sources[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        nbRead = recvmmsg(m_socket, msgs, maxDatagrams, MSG_DONTWAIT, nullptr); // what is pending now
+        m_nbSystemCalls++;
+
+        if (nbRead < 0) {
+            return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? 0 : -1;
+        }
+
+        if (datagramSizes)
+        {
+            for (int i = 0; i < nbRead; i++) {
+                datagramSizes[i] = msgs[i].msg_len;
+            }
+        }
+    }
+    else
+#endif
+    {
+        nbRead = receiveOneByOne(datagrams, datagramSize, maxDatagrams, datagramSizes, sources);
+    }
+
+    if (senderAddress && (nbRead > 0)) {
+        senderAddress->setAddress(ntohl(sources[nbRead - 1].sin_addr.s_addr));
+    }
+
+    return nbRead;
+}
+
+int UDPBatchSocket::receiveOneByOne(char *datagrams, int datagramSize, int maxDatagrams, int *datagramSizes, void *source)
+{
+    sockaddr_in *sources = (sockaddr_in *) source;
+    int nbRead = 0;
+
+    // the socket is readable so the first read does not block. Next ones only while data is pending
+    while ((nbRead < maxDatagrams) && ((nbRead == 0) || waitReadable(0)))
+    {
+        socklen_t sourceLength = sizeof(sockaddr_in);
+        int res = ::recvfrom(m_socket, &datagrams[nbRead * datagramSize], datagramSize, 0,
+            (sockaddr *) &sources[nbRead], &sourceLength);
+        m_nbSystemCalls++;
+
+        if (res < 0) {
+            return nbRead == 0 ? -1 : nbRead;
+        }
+
+        if (datagramSizes) {
+            datagramSizes[nbRead] = res;
+        }
+
+        nbRead++;
+    }
+
+    return nbRead;
+}
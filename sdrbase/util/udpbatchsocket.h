@@ -0,0 +1,74 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_UDPBATCHSOCKET_H_
+#define SDRBASE_UTIL_UDPBATCHSOCKET_H_
+
+#include <QtGlobal>
+#include <QHostAddress>
+
+#include "export.h"
+
+/**
+ * Blocking IPv4 UDP socket that sends and receives many datagrams of the same size per system call.
+ * It uses sendmmsg/recvmmsg where available (Linux) and falls back to one sendto/recvfrom per datagram
+ * elsewhere. Unlike QUdpSocket it does not need an event loop and is meant to be used from a
+ * dedicated I/O thread. Datagrams are laid out contiguously in the caller's buffer one every datagramSize bytes.
+ */
+class SDRBASE_API UDPBatchSocket
+{
+public:
+    static const int m_maxBatchSize = 256; //!< maximum number of datagrams handled in one system call
+
+    UDPBatchSocket();
+    ~UDPBatchSocket();
+
+    bool open();
+    bool bind(const QHostAddress& address, quint16 port); //!< opens the socket if necessary
+    void close();
+    bool isOpen() const { return m_socket != -1; }
+    void setBufferSizes(int sendBytes, int receiveBytes); //!< kernel buffer sizes. 0 leaves the size unchanged
+    void setBatching(bool batching) { m_batching = batching && hasBatching(); } //!< false forces one system call per datagram
+    bool isBatching() const { return m_batching; }
+    quint64 getNbSystemCalls() const { return m_nbSystemCalls; }
+    static bool hasBatching(); //!< true if the system has sendmmsg/recvmmsg
+
+    /**
+     * Send nbDatagrams datagrams of datagramSize bytes to address:port. Opens the socket if necessary.
+     * Returns the number of datagrams sent or -1 on error
+     */
+    int send(const char *datagrams, int datagramSize, int nbDatagrams, const QHostAddress& address, quint16 port);
+    /**
+     * Wait at most timeoutMs for datagrams and read as many as are pending up to maxDatagrams.
+     * The size of each datagram is stored in datagramSizes when not null and the sender of the last one
+     * in senderAddress when not null. Returns the number of datagrams read (0 on timeout) or -1 on error
+     */
+    int receive(char *datagrams, int datagramSize, int maxDatagrams, int timeoutMs,
+        int *datagramSizes = nullptr, QHostAddress *senderAddress = nullptr);
+
+private:
+    qintptr m_socket;
+    bool m_batching;
+    quint64 m_nbSystemCalls;
+
+    int sendOneByOne(const char *datagrams, int datagramSize, int nbDatagrams, const void *destination, int destinationLength);
+    int receiveOneByOne(char *datagrams, int datagramSize, int maxDatagrams, int *datagramSizes, void *source);
+    bool waitReadable(int timeoutMs);
+};
+
+#endif // SDRBASE_UTIL_UDPBATCHSOCKET_H_
@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QObject>
+#include <QTextStream>
+
+#include "SWGProfilingReport.h"
+#include "SWGDeviceSetProfiling.h"
+#include "SWGChannelProfiling.h"
+#include "SWGProfilingStage.h"
+#include "SWGProfilingFifo.h"
+
+#include "device/deviceapi.h"
+#include "channel/channelapi.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "dsp/dspdevicesinkengine.h"
+#include "dsp/dspdevicemimoengine.h"
+#include "util/profiler.h"
+
+#include "webapiprofiling.h"
+
+namespace {
+
+void addStages(
+        const std::vector<Profiler::StageSnapshot>& snapshots,
+        const QObject *owner,
+        float elapsed,
+        QList<SWGSDRangel::SWGProfilingStage*> *stages)
+{
+    for (std::vector<Profiler::StageSnapshot>::const_iterator it = snapshots.begin(); it != snapshots.end(); ++it)
+    {
+        if (it->m_owner != owner) {
+            continue;
+        }
+
+        SWGSDRangel::SWGProfilingStage *stage = new SWGSDRangel::SWGProfilingStage();
+        stage->setName(new QString(it->m_name));
+        stage->setCalls(it->m_calls);
+        stage->setSamples(it->m_samples);
+        stage->setTotalTime(it->m_totalNs * 1e-9f);
+        stage->setMaxTime(it->m_maxNs * 1e-9f);
+        stage->setLoad(elapsed > 0.0f ? (it->m_totalNs * 1e-9f) / elapsed : 0.0f);
+        stages->append(stage);
+    }
+}
+
+void addFifos(
+        const std::vector<Profiler::FifoSnapshot>& snapshots,
+        const QObject *owner,
+        QList<SWGSDRangel::SWGProfilingFifo*> *fifos)
+{
+    for (std::vector<Profiler::FifoSnapshot>::const_iterator it = snapshots.begin(); it != snapshots.end(); ++it)
+    {
+        if (it->m_owner != owner) {
+            continue;
+        }
+
+        SWGSDRangel::SWGProfilingFifo *fifo = new SWGSDRangel::SWGProfilingFifo();
+        fifo->setName(new QString(it->m_name));
+        fifo->setSize(it->m_size);
+        fifo->setFill(it->m_fill);
+        fifo->setMaxFill(it->m_maxFill);
+        fifo->setTransferred(it->m_transferred);
+        fifo->setDropped(it->m_dropped);
+        fifos->append(fifo);
+    }
+}
+
+void addChannel(
+        ChannelAPI *channelAPI,
+        const std::vector<Profiler::StageSnapshot>& stages,
+        const std::vector<Profiler::FifoSnapshot>& fifos,
+        float elapsed,
+        QList<SWGSDRangel::SWGChannelProfiling*> *channels)
+{
+    // channel counters are owned by the QObject part of the channel
+    const QObject *owner = dynamic_cast<const QObject*>(channelAPI);
+
+    if (!owner) {
+        return;
+    }
+
+    SWGSDRangel::SWGChannelProfiling *channel = new SWGSDRangel::SWGChannelProfiling();
+    channel->init();
+    channel->setIndex(channelAPI->getIndexInDeviceSet());
+    channelAPI->getIdentifier(*channel->getId());
+    addStages(stages, owner, elapsed, channel->getStages());
+    addFifos(fifos, owner, channel->getFifos());
+    channels->append(channel);
+}
+
+// Prometheus label values must escape backslash, double quote and line feed
+QString escapeLabel(const QString& value)
+{
+    QString escaped(value);
+    escaped.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", "\\n");
+    return escaped;
+}
+
+enum StageMetric
+{
+    StageCalls,
+    StageSamples,
+    StageSeconds,
+    StageMaxSeconds
+};
+
+enum FifoMetric
+{
+    FifoSize,
+    FifoFill,
+    FifoMaxFill,
+    FifoTransferred,
+    FifoDropped
+};
+
+void writeStages(QTextStream& out, const QString& name, const QString& labels, QList<SWGSDRangel::SWGProfilingStage*> *stages, StageMetric metric)
+{
+    for (int i = 0; i < stages->size(); i++)
+    {
+        SWGSDRangel::SWGProfilingStage *stage = stages->at(i);
+        out << name << "{" << labels << ",stage=\"" << escapeLabel(*stage->getName()) << "\"} ";
+
+        switch (metric)
+        {
+        case StageCalls:
+            out << stage->getCalls();
+            break;
+        case StageSamples:
+            out << stage->getSamples();
+            break;
+        case StageSeconds:
+            out << stage->getTotalTime();
+            break;
+        case StageMaxSeconds:
+            out << stage->getMaxTime();
+            break;
+        }
+
+        out << "\n";
+    }
+}
+
+void writeFifos(QTextStream& out, const QString& name, const QString& labels, QList<SWGSDRangel::SWGProfilingFifo*> *fifos, FifoMetric metric)
+{
+    for (int i = 0; i < fifos->size(); i++)
+    {
+        SWGSDRangel::SWGProfilingFifo *fifo = fifos->at(i);
+        out << name << "{" << labels << ",fifo=\"" << escapeLabel(*fifo->getName()) << "\"} ";
+
+        switch (metric)
+        {
+        case FifoSize:
+            out << fifo->getSize();
+            break;
+        case FifoFill:
+            out << fifo->getFill();
+            break;
+        case FifoMaxFill:
+            out << fifo->getMaxFill();
+            break;
+        case FifoTransferred:
+            out << fifo->getTransferred();
+            break;
+        case FifoDropped:
+            out << fifo->getDropped();
+            break;
+        }
+
+        out << "\n";
+    }
+}
+
+QString deviceSetLabels(SWGSDRangel::SWGDeviceSetProfiling *deviceSet)
+{
+    return QString("deviceset=\"%1\"").arg(deviceSet->getIndex());
+}
+
+QString channelLabels(SWGSDRangel::SWGDeviceSetProfiling *deviceSet, SWGSDRangel::SWGChannelProfiling *channel)
+{
+    return QString("deviceset=\"%1\",channel=\"%2\",id=\"%3\"")
+        .arg(deviceSet->getIndex())
+        .arg(channel->getIndex())
+        .arg(escapeLabel(*channel->getId()));
+}
+
+} // namespace
+
+void WebAPIProfiling::getReport(const std::vector<DeviceAPI*>& deviceAPIs, SWGSDRangel::SWGProfilingReport& report)
+{
+    std::vector<Profiler::StageSnapshot> stages;
+    std::vector<Profiler::FifoSnapshot> fifos;
+    Profiler::instance().snapshot(stages, fifos);
+    float elapsed = Profiler::instance().getElapsedNs() * 1e-9f;
+
+    report.init();
+    report.setElapsed(elapsed);
+
+    for (unsigned int i = 0; i < deviceAPIs.size(); i++)
+    {
+        DeviceAPI *deviceAPI = deviceAPIs[i];
+        SWGSDRangel::SWGDeviceSetProfiling *deviceSet = new SWGSDRangel::SWGDeviceSetProfiling();
+        deviceSet->init();
+        deviceSet->setIndex(i);
+
+        const QObject *engines[3] = {
+            deviceAPI->getDeviceSourceEngine(),
+            deviceAPI->getDeviceSinkEngine(),
+            deviceAPI->getDeviceMIMOEngine()
+        };
+
+        for (int ie = 0; ie < 3; ie++)
+        {
+            if (engines[ie])
+            {
+                addStages(stages, engines[ie], elapsed, deviceSet->getStages());
+                addFifos(fifos, engines[ie], deviceSet->getFifos());
+            }
+        }
+
+        for (int ic = 0; ic < deviceAPI->getNbSinkChannels(); ic++) {
+            addChannel(deviceAPI->getChanelSinkAPIAt(ic), stages, fifos, elapsed, deviceSet->getChannels());
+        }
+
+        for (int ic = 0; ic < deviceAPI->getNbSourceChannels(); ic++) {
+            addChannel(deviceAPI->getChanelSourceAPIAt(ic), stages, fifos, elapsed, deviceSet->getChannels());
+        }
+
+        report.getDeviceSets()->append(deviceSet);
+    }
+}
+
+void WebAPIProfiling::formatPrometheus(SWGSDRangel::SWGProfilingReport& report, QString& text)
+{
+    static const struct {
+        const char *m_name;
+        const char *m_type;
+        const char *m_help;
+        StageMetric m_metric;
+    } stageMetrics[] = {
+        {"sdrangel_stage_calls_total", "counter", "Number of runs of the DSP stage", StageCalls},
+        {"sdrangel_stage_samples_total", "counter", "Number of samples processed by the DSP stage", StageSamples},
+        {"sdrangel_stage_seconds_total", "counter", "Time spent in the DSP stage", StageSeconds},
+        {"sdrangel_stage_max_seconds", "gauge", "Longest run of the DSP stage", StageMaxSeconds}
+    };
+
+    static const struct {
+        const char *m_name;
+        const char *m_type;
+        const char *m_help;
+        FifoMetric m_metric;
+    } fifoMetrics[] = {
+        {"sdrangel_fifo_size_samples", "gauge", "Size of the sample FIFO", FifoSize},
+        {"sdrangel_fifo_fill_samples", "gauge", "Fill of the sample FIFO at the last transfer", FifoFill},
+        {"sdrangel_fifo_max_fill_samples", "gauge", "Maximum fill of the sample FIFO", FifoMaxFill},
+        {"sdrangel_fifo_transferred_samples_total", "counter", "Samples written (Rx) or read (Tx) through the FIFO", FifoTransferred},
+        {"sdrangel_fifo_dropped_samples_total", "counter", "Samples lost on FIFO overflow (Rx) or underrun (Tx)", FifoDropped}
+    };
+
+    QList<SWGSDRangel::SWGDeviceSetProfiling*> *deviceSets = report.getDeviceSets();
+    text.clear();
+    QTextStream out(&text);
+
+    out << "# HELP sdrangel_profiling_elapsed_seconds Time since the last reset of the profiling counters\n";
+    out << "# TYPE sdrangel_profiling_elapsed_seconds gauge\n";
+    out << "sdrangel_profiling_elapsed_seconds " << report.getElapsed() << "\n";
+
+    for (unsigned int im = 0; im < sizeof(stageMetrics) / sizeof(stageMetrics[0]); im++)
+    {
+        QString name(stageMetrics[im].m_name);
+        out << "# HELP " << name << " " << stageMetrics[im].m_help << "\n";
+        out << "# TYPE " << name << " " << stageMetrics[im].m_type << "\n";
+
+        for (int id = 0; id < deviceSets->size(); id++)
+        {
+            SWGSDRangel::SWGDeviceSetProfiling *deviceSet = deviceSets->at(id);
+            writeStages(out, name, deviceSetLabels(deviceSet), deviceSet->getStages(), stageMetrics[im].m_metric);
+
+            for (int ic = 0; ic < deviceSet->getChannels()->size(); ic++)
+            {
+                SWGSDRangel::SWGChannelProfiling *channel = deviceSet->getChannels()->at(ic);
+                writeStages(out, name, channelLabels(deviceSet, channel), channel->getStages(), stageMetrics[im].m_metric);
+            }
+        }
+    }
+
+    for (unsigned int im = 0; im < sizeof(fifoMetrics) / sizeof(fifoMetrics[0]); im++)
+    {
+        QString name(fifoMetrics[im].m_name);
+        out << "# HELP " << name << " " << fifoMetrics[im].m_help << "\n";
+        out << "# TYPE " << name << " " << fifoMetrics[im].m_type << "\n";
+
+        for (int id = 0; id < deviceSets->size(); id++)
+        {
+            SWGSDRangel::SWGDeviceSetProfiling *deviceSet = deviceSets->at(id);
+            writeFifos(out, name, deviceSetLabels(deviceSet), deviceSet->getFifos(), fifoMetrics[im].m_metric);
+
+            for (int ic = 0; ic < deviceSet->getChannels()->size(); ic++)
+            {
+                SWGSDRangel::SWGChannelProfiling *channel = deviceSet->getChannels()->at(ic);
+                writeFifos(out, name, channelLabels(deviceSet, channel), channel->getFifos(), fifoMetrics[im].m_metric);
+            }
+        }
+    }
+
+    out.flush();
+}
@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIPROFILING_H_
+#define SDRBASE_WEBAPI_WEBAPIPROFILING_H_
+
+#include <vector>
+#include <QString>
+
+#include "export.h"
+
+class DeviceAPI;
+
+namespace SWGSDRangel
+{
+    class SWGProfilingReport;
+}
+
+/**
+ * Builds the profiling report of the Web API from the Profiler counters. Counters are attached to
+ * device sets and channels by matching their owner with the device engines and channel objects.
+ * Shared by the GUI and server adapters.
+ */
+class SDRBASE_API WebAPIProfiling
+{
+public:
+    /** deviceAPIs are the device sets in index order */
+    static void getReport(const std::vector<DeviceAPI*>& deviceAPIs, SWGSDRangel::SWGProfilingReport& report);
+    /** Prometheus text exposition format (version 0.0.4) of a report */
+    static void formatPrometheus(SWGSDRangel::SWGProfilingReport& report, QString& text);
+};
+
+#endif // SDRBASE_WEBAPI_WEBAPIPROFILING_H_
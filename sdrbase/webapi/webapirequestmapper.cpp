@@ -21,10 +21,9 @@
 #include <QJsonDocument>
 #include <QJsonArray>
 
-#include <boost/lexical_cast.hpp>
-
 #include "httpdocrootsettings.h"
 #include "webapirequestmapper.h"
+#include "webapiprofiling.h"
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGInstanceDevicesResponse.h"
 #include "SWGInstanceChannelsResponse.h"
@@ -42,8 +41,12 @@
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
+#include "SWGGLSpectrum.h"
+#include "SWGSpectrumServer.h"
+#include "SWGProfilingReport.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
+#include "SWGObject.h"
 
 WebAPIRequestMapper::WebAPIRequestMapper(QObject* parent) :
     HttpRequestHandler(parent),
@@ -55,6 +58,39 @@ WebAPIRequestMapper::WebAPIRequestMapper(QObject* parent) :
     qtwebapp::HttpDocrootSettings docrootSettings;
     docrootSettings.path = ":/webapi";
     m_staticFileController = new qtwebapp::StaticFileController(docrootSettings, parent);
+
+    m_router.addRoute(WebAPIAdapterInterface::instanceSummaryURL.toLatin1(), RouteInstanceSummary);
+    m_router.addRoute(WebAPIAdapterInterface::instanceDevicesURL.toLatin1(), RouteInstanceDevices);
+    m_router.addRoute(WebAPIAdapterInterface::instanceChannelsURL.toLatin1(), RouteInstanceChannels);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLoggingURL.toLatin1(), RouteInstanceLogging);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioURL.toLatin1(), RouteInstanceAudio);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioInputParametersURL.toLatin1(), RouteInstanceAudioInputParameters);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioOutputParametersURL.toLatin1(), RouteInstanceAudioOutputParameters);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioInputCleanupURL.toLatin1(), RouteInstanceAudioInputCleanup);
+    m_router.addRoute(WebAPIAdapterInterface::instanceAudioOutputCleanupURL.toLatin1(), RouteInstanceAudioOutputCleanup);
+    m_router.addRoute(WebAPIAdapterInterface::instanceLocationURL.toLatin1(), RouteInstanceLocation);
+    m_router.addRoute(WebAPIAdapterInterface::instanceDVSerialURL.toLatin1(), RouteInstanceDVSerial);
+    m_router.addRoute(WebAPIAdapterInterface::instancePresetsURL.toLatin1(), RouteInstancePresets);
+    m_router.addRoute(WebAPIAdapterInterface::instancePresetURL.toLatin1(), RouteInstancePreset);
+    m_router.addRoute(WebAPIAdapterInterface::instancePresetFileURL.toLatin1(), RouteInstancePresetFile);
+    m_router.addRoute(WebAPIAdapterInterface::instanceDeviceSetsURL.toLatin1(), RouteInstanceDeviceSets);
+    m_router.addRoute(WebAPIAdapterInterface::instanceDeviceSetURL.toLatin1(), RouteInstanceDeviceSet);
+    m_router.addRoute(WebAPIAdapterInterface::instanceProfilingURL.toLatin1(), RouteInstanceProfiling);
+    m_router.addRoute(WebAPIAdapterInterface::instanceProfilingMetricsURL.toLatin1(), RouteInstanceProfilingMetrics);
+    // device set paths with their indexes
+    m_router.addRoute("/sdrangel/deviceset/{int}", RouteDeviceset);
+    m_router.addRoute("/sdrangel/deviceset/{int}/focus", RouteDevicesetFocus);
+    m_router.addRoute("/sdrangel/deviceset/{int}/device", RouteDevicesetDevice);
+    m_router.addRoute("/sdrangel/deviceset/{int}/device/settings", RouteDevicesetDeviceSettings);
+    m_router.addRoute("/sdrangel/deviceset/{int}/device/run", RouteDevicesetDeviceRun);
+    m_router.addRoute("/sdrangel/deviceset/{int}/device/report", RouteDevicesetDeviceReport);
+    m_router.addRoute("/sdrangel/deviceset/{int}/channels/report", RouteDevicesetChannelsReport);
+    m_router.addRoute("/sdrangel/deviceset/{int}/spectrum/settings", RouteDevicesetSpectrumSettings);
+    m_router.addRoute("/sdrangel/deviceset/{int}/spectrum/server", RouteDevicesetSpectrumServer);
+    m_router.addRoute("/sdrangel/deviceset/{int}/channel", RouteDevicesetChannel);
+    m_router.addRoute("/sdrangel/deviceset/{int}/channel/{int}", RouteDevicesetChannelIndex);
+    m_router.addRoute("/sdrangel/deviceset/{int}/channel/{int}/settings", RouteDevicesetChannelSettings);
+    m_router.addRoute("/sdrangel/deviceset/{int}/channel/{int}/report", RouteDevicesetChannelReport);
 }
 
 WebAPIRequestMapper::~WebAPIRequestMapper()
@@ -76,7 +112,7 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
 
         errorResponse.init();
         *errorResponse.getMessage() = "Service not available";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
     else // normal processing
     {
@@ -93,77 +129,106 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
             return;
         }
 
-        if (path == WebAPIAdapterInterface::instanceSummaryURL) {
+        int captures[WebAPIRouter::m_maxCaptures];
+
+        switch (m_router.match(path, captures))
+        {
+        case RouteInstanceSummary:
             instanceSummaryService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDevicesURL) {
+            break;
+        case RouteInstanceDevices:
             instanceDevicesService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceChannelsURL) {
+            break;
+        case RouteInstanceChannels:
             instanceChannelsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLoggingURL) {
+            break;
+        case RouteInstanceLogging:
             instanceLoggingService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioURL) {
+            break;
+        case RouteInstanceAudio:
             instanceAudioService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputParametersURL) {
+            break;
+        case RouteInstanceAudioInputParameters:
             instanceAudioInputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputParametersURL) {
+            break;
+        case RouteInstanceAudioOutputParameters:
             instanceAudioOutputParametersService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioInputCleanupURL) {
+            break;
+        case RouteInstanceAudioInputCleanup:
             instanceAudioInputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceAudioOutputCleanupURL) {
+            break;
+        case RouteInstanceAudioOutputCleanup:
             instanceAudioOutputCleanupService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceLocationURL) {
+            break;
+        case RouteInstanceLocation:
             instanceLocationService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDVSerialURL) {
+            break;
+        case RouteInstanceDVSerial:
             instanceDVSerialService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetsURL) {
+            break;
+        case RouteInstancePresets:
             instancePresetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetURL) {
+            break;
+        case RouteInstancePreset:
             instancePresetService(request, response);
-        } else if (path == WebAPIAdapterInterface::instancePresetFileURL) {
+            break;
+        case RouteInstancePresetFile:
             instancePresetFileService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetsURL) {
+            break;
+        case RouteInstanceDeviceSets:
             instanceDeviceSetsService(request, response);
-        } else if (path == WebAPIAdapterInterface::instanceDeviceSetURL) {
+            break;
+        case RouteInstanceDeviceSet:
             instanceDeviceSetService(request, response);
-        }
-        else
-        {
-            std::smatch desc_match;
-            std::string pathStr(path.constData(), path.length());
-
-            if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetURLRe)) {
-                devicesetService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceURLRe)) {
-                devicesetDeviceService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetFocusURLRe)) {
-                devicesetFocusService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceSettingsURLRe)) {
-                devicesetDeviceSettingsService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceRunURLRe)) {
-                devicesetDeviceRunService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe)) {
-                devicesetDeviceReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
-                devicesetChannelsReportService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
-                devicesetChannelService(std::string(desc_match[1]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelIndexURLRe)) {
-                devicesetChannelIndexService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelSettingsURLRe)) {
-                devicesetChannelSettingsService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelReportURLRe)) {
-                devicesetChannelReportService(std::string(desc_match[1]), std::string(desc_match[2]), request, response);
-            }
-            else // serve static documentation pages
-            {
-                m_staticFileController->service(request, response);
-            }
-
-//            QDirIterator it(":", QDirIterator::Subdirectories);
-//            while (it.hasNext()) {
-//                qDebug() << "WebAPIRequestMapper::service: " << it.next();
-//            }
-
+            break;
+        case RouteInstanceProfiling:
+            instanceProfilingService(request, response);
+            break;
+        case RouteInstanceProfilingMetrics:
+            instanceProfilingMetricsService(request, response);
+            break;
+        case RouteDeviceset:
+            devicesetService(captures[0], request, response);
+            break;
+        case RouteDevicesetFocus:
+            devicesetFocusService(captures[0], request, response);
+            break;
+        case RouteDevicesetDevice:
+            devicesetDeviceService(captures[0], request, response);
+            break;
+        case RouteDevicesetDeviceSettings:
+            devicesetDeviceSettingsService(captures[0], request, response);
+            break;
+        case RouteDevicesetDeviceRun:
+            devicesetDeviceRunService(captures[0], request, response);
+            break;
+        case RouteDevicesetDeviceReport:
+            devicesetDeviceReportService(captures[0], request, response);
+            break;
+        case RouteDevicesetChannelsReport:
+            devicesetChannelsReportService(captures[0], request, response);
+            break;
+        case RouteDevicesetSpectrumSettings:
+            devicesetSpectrumSettingsService(captures[0], request, response);
+            break;
+        case RouteDevicesetSpectrumServer:
+            devicesetSpectrumServerService(captures[0], request, response);
+            break;
+        case RouteDevicesetChannel:
+            devicesetChannelService(captures[0], request, response);
+            break;
+        case RouteDevicesetChannelIndex:
+            devicesetChannelIndexService(captures[0], captures[1], request, response);
+            break;
+        case RouteDevicesetChannelSettings:
+            devicesetChannelSettingsService(captures[0], captures[1], request, response);
+            break;
+        case RouteDevicesetChannelReport:
+            devicesetChannelReportService(captures[0], captures[1], request, response);
+            break;
+        default: // serve static documentation pages
+            m_staticFileController->service(request, response);
+            break;
         }
     }
 }
@@ -182,9 +247,9 @@ void WebAPIRequestMapper::instanceSummaryService(qtwebapp::HttpRequest& request,
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "DELETE")
@@ -195,9 +260,9 @@ void WebAPIRequestMapper::instanceSummaryService(qtwebapp::HttpRequest& request,
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -205,7 +270,7 @@ void WebAPIRequestMapper::instanceSummaryService(qtwebapp::HttpRequest& request,
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -234,9 +299,9 @@ void WebAPIRequestMapper::instanceDevicesService(qtwebapp::HttpRequest& request,
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -244,7 +309,7 @@ void WebAPIRequestMapper::instanceDevicesService(qtwebapp::HttpRequest& request,
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -273,9 +338,9 @@ void WebAPIRequestMapper::instanceChannelsService(qtwebapp::HttpRequest& request
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -283,7 +348,7 @@ void WebAPIRequestMapper::instanceChannelsService(qtwebapp::HttpRequest& request
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -301,9 +366,9 @@ void WebAPIRequestMapper::instanceLoggingService(qtwebapp::HttpRequest& request,
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "PUT")
@@ -318,9 +383,9 @@ void WebAPIRequestMapper::instanceLoggingService(qtwebapp::HttpRequest& request,
             response.setStatus(status);
 
             if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
+                writeJson(response, normalResponse);
             } else {
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -328,7 +393,7 @@ void WebAPIRequestMapper::instanceLoggingService(qtwebapp::HttpRequest& request,
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -336,7 +401,7 @@ void WebAPIRequestMapper::instanceLoggingService(qtwebapp::HttpRequest& request,
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -354,9 +419,9 @@ void WebAPIRequestMapper::instanceAudioService(qtwebapp::HttpRequest& request, q
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -364,7 +429,7 @@ void WebAPIRequestMapper::instanceAudioService(qtwebapp::HttpRequest& request, q
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -394,9 +459,9 @@ void WebAPIRequestMapper::instanceAudioInputParametersService(qtwebapp::HttpRequ
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else if (request.getMethod() == "DELETE")
@@ -407,9 +472,9 @@ void WebAPIRequestMapper::instanceAudioInputParametersService(qtwebapp::HttpRequ
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -417,7 +482,7 @@ void WebAPIRequestMapper::instanceAudioInputParametersService(qtwebapp::HttpRequ
                 response.setStatus(405,"Invalid HTTP method");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid HTTP method";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -425,7 +490,7 @@ void WebAPIRequestMapper::instanceAudioInputParametersService(qtwebapp::HttpRequ
             response.setStatus(400,"Invalid JSON request");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON request";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -433,7 +498,7 @@ void WebAPIRequestMapper::instanceAudioInputParametersService(qtwebapp::HttpRequ
         response.setStatus(400,"Invalid JSON format");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid JSON format";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -463,9 +528,9 @@ void WebAPIRequestMapper::instanceAudioOutputParametersService(qtwebapp::HttpReq
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else if (request.getMethod() == "DELETE")
@@ -476,9 +541,9 @@ void WebAPIRequestMapper::instanceAudioOutputParametersService(qtwebapp::HttpReq
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -486,7 +551,7 @@ void WebAPIRequestMapper::instanceAudioOutputParametersService(qtwebapp::HttpReq
                 response.setStatus(405,"Invalid HTTP method");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid HTTP method";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -494,7 +559,7 @@ void WebAPIRequestMapper::instanceAudioOutputParametersService(qtwebapp::HttpReq
             response.setStatus(400,"Invalid JSON request");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON request";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -502,7 +567,7 @@ void WebAPIRequestMapper::instanceAudioOutputParametersService(qtwebapp::HttpReq
         response.setStatus(400,"Invalid JSON format");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid JSON format";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -520,9 +585,9 @@ void WebAPIRequestMapper::instanceAudioInputCleanupService(qtwebapp::HttpRequest
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -530,7 +595,7 @@ void WebAPIRequestMapper::instanceAudioInputCleanupService(qtwebapp::HttpRequest
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -548,9 +613,9 @@ void WebAPIRequestMapper::instanceAudioOutputCleanupService(qtwebapp::HttpReques
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -558,7 +623,7 @@ void WebAPIRequestMapper::instanceAudioOutputCleanupService(qtwebapp::HttpReques
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -576,9 +641,9 @@ void WebAPIRequestMapper::instanceLocationService(qtwebapp::HttpRequest& request
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "PUT")
@@ -594,9 +659,9 @@ void WebAPIRequestMapper::instanceLocationService(qtwebapp::HttpRequest& request
             response.setStatus(status);
 
             if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
+                writeJson(response, normalResponse);
             } else {
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -604,7 +669,7 @@ void WebAPIRequestMapper::instanceLocationService(qtwebapp::HttpRequest& request
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -612,7 +677,7 @@ void WebAPIRequestMapper::instanceLocationService(qtwebapp::HttpRequest& request
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -630,9 +695,9 @@ void WebAPIRequestMapper::instanceDVSerialService(qtwebapp::HttpRequest& request
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "PATCH")
@@ -650,9 +715,9 @@ void WebAPIRequestMapper::instanceDVSerialService(qtwebapp::HttpRequest& request
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -660,7 +725,7 @@ void WebAPIRequestMapper::instanceDVSerialService(qtwebapp::HttpRequest& request
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -677,9 +742,9 @@ void WebAPIRequestMapper::instancePresetsService(qtwebapp::HttpRequest& request,
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
 }
@@ -707,9 +772,9 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -717,7 +782,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid JSON request";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -725,7 +790,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "PUT")
@@ -745,9 +810,9 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -755,7 +820,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid JSON request";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -763,7 +828,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "POST")
@@ -783,9 +848,9 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -793,7 +858,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid JSON request";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -801,7 +866,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "DELETE")
@@ -820,9 +885,9 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -830,7 +895,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
                 response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid JSON request";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -838,7 +903,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -846,7 +911,7 @@ void WebAPIRequestMapper::instancePresetService(qtwebapp::HttpRequest& request,
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -873,9 +938,9 @@ void WebAPIRequestMapper::instancePresetFileService(qtwebapp::HttpRequest& reque
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -883,7 +948,7 @@ void WebAPIRequestMapper::instancePresetFileService(qtwebapp::HttpRequest& reque
                 response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid JSON request";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -891,7 +956,7 @@ void WebAPIRequestMapper::instancePresetFileService(qtwebapp::HttpRequest& reque
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "POST")
@@ -911,9 +976,9 @@ void WebAPIRequestMapper::instancePresetFileService(qtwebapp::HttpRequest& reque
                 response.setStatus(status);
 
                 if (status/100 == 2) {
-                    response.write(normalResponse.asJson().toUtf8());
+                    writeJson(response, normalResponse);
                 } else {
-                    response.write(errorResponse.asJson().toUtf8());
+                    writeJson(response, errorResponse);
                 }
             }
             else
@@ -921,7 +986,7 @@ void WebAPIRequestMapper::instancePresetFileService(qtwebapp::HttpRequest& reque
                 response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
                 *errorResponse.getMessage() = "Invalid JSON request";
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
         else
@@ -929,7 +994,7 @@ void WebAPIRequestMapper::instancePresetFileService(qtwebapp::HttpRequest& reque
             response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
             *errorResponse.getMessage() = "Invalid JSON format";
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -937,7 +1002,7 @@ void WebAPIRequestMapper::instancePresetFileService(qtwebapp::HttpRequest& reque
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
@@ -954,9 +1019,9 @@ void WebAPIRequestMapper::instanceDeviceSetsService(qtwebapp::HttpRequest& reque
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -964,7 +1029,80 @@ void WebAPIRequestMapper::instanceDeviceSetsService(qtwebapp::HttpRequest& reque
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
+    }
+}
+
+void WebAPIRequestMapper::instanceProfilingService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGProfilingReport normalResponse;
+        int status = m_adapter->instanceProfilingGet(normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
+        }
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->instanceProfilingDelete(normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
+    }
+}
+
+void WebAPIRequestMapper::instanceProfilingMetricsService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGProfilingReport report;
+        int status = m_adapter->instanceProfilingGet(report, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2)
+        {
+            QString text;
+            WebAPIProfiling::formatPrometheus(report, text);
+            response.setHeader("Content-Type", "text/plain; version=0.0.4");
+            response.write(text.toUtf8());
+        }
+        else
+        {
+            response.setHeader("Content-Type", "application/json");
+            writeJson(response, errorResponse);
+        }
+    }
+    else
+    {
+        response.setHeader("Content-Type", "application/json");
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
@@ -993,9 +1131,9 @@ void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& reques
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else if (request.getMethod() == "DELETE")
@@ -1005,9 +1143,9 @@ void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& reques
         response.setStatus(status);
 
         if (status/100 == 2) {
-            response.write(normalResponse.asJson().toUtf8());
+            writeJson(response, normalResponse);
         } else {
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -1015,11 +1153,11 @@ void WebAPIRequestMapper::instanceDeviceSetService(qtwebapp::HttpRequest& reques
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
-void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1027,25 +1165,14 @@ void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGDeviceSet normalResponse;
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGDeviceSet normalResponse;
+        int status = m_adapter->devicesetGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        catch (const boost::bad_lexical_cast &e)
-        {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
-            response.write(errorResponse.asJson().toUtf8());
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -1053,264 +1180,216 @@ void WebAPIRequestMapper::devicesetService(const std::string& indexStr, qtwebapp
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
-void WebAPIRequestMapper::devicesetFocusService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetFocusService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "PATCH")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-
-        if (request.getMethod() == "PATCH")
-        {
-            SWGSDRangel::SWGSuccessResponse normalResponse;
-            int status = m_adapter->devicesetFocusPatch(deviceSetIndex, normalResponse, errorResponse);
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->devicesetFocusPatch(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
-            response.write(errorResponse.asJson().toUtf8());
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "PUT")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "PUT")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGDeviceListItem query;
+            SWGSDRangel::SWGDeviceListItem normalResponse;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateDeviceListItem(query, jsonObject))
             {
-                SWGSDRangel::SWGDeviceListItem query;
-                SWGSDRangel::SWGDeviceListItem normalResponse;
-
-                if (validateDeviceListItem(query, jsonObject))
-                {
-                    int status = m_adapter->devicesetDevicePut(deviceSetIndex, query, normalResponse, errorResponse);
-                    response.setStatus(status);
-
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Missing device identification");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Missing device identification";
-                    response.write(errorResponse.asJson().toUtf8());
+                int status = m_adapter->devicesetDevicePut(deviceSetIndex, query, normalResponse, errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    writeJson(response, normalResponse);
+                } else {
+                    writeJson(response, errorResponse);
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Missing device identification");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
-                response.write(errorResponse.asJson().toUtf8());
+                *errorResponse.getMessage() = "Missing device identification";
+                writeJson(response, errorResponse);
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
-            response.write(errorResponse.asJson().toUtf8());
+            *errorResponse.getMessage() = "Invalid JSON format";
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceSettingsService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceSettingsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            SWGSDRangel::SWGDeviceSettings normalResponse;
+            resetDeviceSettings(normalResponse);
+            QStringList deviceSettingsKeys;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateDeviceSettings(normalResponse, jsonObject, deviceSettingsKeys))
             {
-                SWGSDRangel::SWGDeviceSettings normalResponse;
-                resetDeviceSettings(normalResponse);
-                QStringList deviceSettingsKeys;
-
-                if (validateDeviceSettings(normalResponse, jsonObject, deviceSettingsKeys))
-                {
-                    int status = m_adapter->devicesetDeviceSettingsPutPatch(
-                            deviceSetIndex,
-                            (request.getMethod() == "PUT"), // force settings on PUT
-                            deviceSettingsKeys,
-                            normalResponse,
-                            errorResponse);
-                    response.setStatus(status);
-
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
-                    response.write(errorResponse.asJson().toUtf8());
+                int status = m_adapter->devicesetDeviceSettingsPutPatch(
+                        deviceSetIndex,
+                        (request.getMethod() == "PUT"), // force settings on PUT
+                        deviceSettingsKeys,
+                        normalResponse,
+                        errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    writeJson(response, normalResponse);
+                } else {
+                    writeJson(response, errorResponse);
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGDeviceSettings normalResponse;
-            resetDeviceSettings(normalResponse);
-            int status = m_adapter->devicesetDeviceSettingsGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
-
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
+                *errorResponse.getMessage() = "Invalid JSON request";
+                writeJson(response, errorResponse);
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
-            response.write(errorResponse.asJson().toUtf8());
+            *errorResponse.getMessage() = "Invalid JSON format";
+            writeJson(response, errorResponse);
+        }
+    }
+    else if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGDeviceSettings normalResponse;
+        resetDeviceSettings(normalResponse);
+        int status = m_adapter->devicesetDeviceSettingsGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceRunService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceRunService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunGet(deviceSetIndex, normalResponse, errorResponse);
 
-        if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunGet(deviceSetIndex, normalResponse, errorResponse);
-
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
-        else if (request.getMethod() == "POST")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunPost(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "POST")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunPost(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
-        else if (request.getMethod() == "DELETE")
-        {
-            SWGSDRangel::SWGDeviceState normalResponse;
-            int status = m_adapter->devicesetDeviceRunDelete(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        SWGSDRangel::SWGDeviceState normalResponse;
+        int status = m_adapter->devicesetDeviceRunDelete(deviceSetIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
-            response.write(errorResponse.asJson().toUtf8());
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
-void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetDeviceReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1318,26 +1397,15 @@ void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexS
 
     if (request.getMethod() == "GET")
     {
-        try
-        {
-            SWGSDRangel::SWGDeviceReport normalResponse;
-            resetDeviceReport(normalResponse);
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetDeviceReportGet(deviceSetIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGDeviceReport normalResponse;
+        resetDeviceReport(normalResponse);
+        int status = m_adapter->devicesetDeviceReportGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        catch (const boost::bad_lexical_cast &e)
-        {
-            errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
-            response.write(errorResponse.asJson().toUtf8());
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -1345,11 +1413,11 @@ void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexS
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
     }
 }
 
-void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+void WebAPIRequestMapper::devicesetChannelsReportService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
     response.setHeader("Content-Type", "application/json");
@@ -1357,25 +1425,75 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
 
     if (request.getMethod() == "GET")
     {
-        try
+        SWGSDRangel::SWGChannelsDetail normalResponse;
+        int status = m_adapter->devicesetChannelsReportGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumSettingsService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
+    {
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
+
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            SWGSDRangel::SWGChannelsDetail normalResponse;
-            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
-            int status = m_adapter->devicesetChannelsReportGet(deviceSetIndex, normalResponse, errorResponse);
+            SWGSDRangel::SWGGLSpectrum normalResponse;
+            normalResponse.init();
+            normalResponse.fromJsonObject(jsonObject);
+            QStringList spectrumSettingsKeys = jsonObject.keys();
+            int status = m_adapter->devicesetSpectrumSettingsPutPatch(
+                    deviceSetIndex,
+                    (request.getMethod() == "PUT"), // force settings on PUT
+                    spectrumSettingsKeys,
+                    normalResponse,
+                    errorResponse);
             response.setStatus(status);
 
             if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
+                writeJson(response, normalResponse);
             } else {
-                response.write(errorResponse.asJson().toUtf8());
+                writeJson(response, errorResponse);
             }
         }
-        catch (const boost::bad_lexical_cast &e)
+        else
         {
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
-            response.setStatus(400,"Invalid data");
-            response.write(errorResponse.asJson().toUtf8());
+            *errorResponse.getMessage() = "Invalid JSON format";
+            writeJson(response, errorResponse);
+        }
+    }
+    else if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGGLSpectrum normalResponse;
+        normalResponse.init();
+        int status = m_adapter->devicesetSpectrumSettingsGet(deviceSetIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
     else
@@ -1383,12 +1501,50 @@ void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& inde
         response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
         *errorResponse.getMessage() = "Invalid HTTP method";
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
+    }
+}
+
+void WebAPIRequestMapper::devicesetSpectrumServerService(int deviceSetIndex, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+    SWGSDRangel::SWGSpectrumServer normalResponse;
+    int status;
+
+    if (request.getMethod() == "GET")
+    {
+        status = m_adapter->devicesetSpectrumServerGet(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "POST")
+    {
+        status = m_adapter->devicesetSpectrumServerPost(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else if (request.getMethod() == "DELETE")
+    {
+        status = m_adapter->devicesetSpectrumServerDelete(deviceSetIndex, normalResponse, errorResponse);
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
+        return;
+    }
+
+    response.setStatus(status);
+
+    if (status/100 == 2) {
+        writeJson(response, normalResponse);
+    } else {
+        writeJson(response, errorResponse);
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelService(
-        const std::string& deviceSetIndexStr,
+        int deviceSetIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1396,77 +1552,65 @@ void WebAPIRequestMapper::devicesetChannelService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "POST")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "POST")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
-
-            if (parseJsonBody(jsonStr, jsonObject, response))
-            {
-                SWGSDRangel::SWGChannelSettings query;
-                SWGSDRangel::SWGSuccessResponse normalResponse;
-                resetChannelSettings(query);
+            SWGSDRangel::SWGChannelSettings query;
+            SWGSDRangel::SWGSuccessResponse normalResponse;
+            resetChannelSettings(query);
 
-                if (jsonObject.contains("direction")) {
-                    query.setDirection(jsonObject["direction"].toInt());
-                } else {
-                    query.setDirection(0); // assume Rx
-                }
+            if (jsonObject.contains("direction")) {
+                query.setDirection(jsonObject["direction"].toInt());
+            } else {
+                query.setDirection(0); // assume Rx
+            }
 
-                if (jsonObject.contains("channelType") && jsonObject["channelType"].isString())
-                {
-                    query.setChannelType(new QString(jsonObject["channelType"].toString()));
+            if (jsonObject.contains("channelType") && jsonObject["channelType"].isString())
+            {
+                query.setChannelType(new QString(jsonObject["channelType"].toString()));
 
-                    int status = m_adapter->devicesetChannelPost(deviceSetIndex, query, normalResponse, errorResponse);
+                int status = m_adapter->devicesetChannelPost(deviceSetIndex, query, normalResponse, errorResponse);
 
-                    response.setStatus(status);
+                response.setStatus(status);
 
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
-                    response.write(errorResponse.asJson().toUtf8());
+                if (status/100 == 2) {
+                    writeJson(response, normalResponse);
+                } else {
+                    writeJson(response, errorResponse);
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
-                response.write(errorResponse.asJson().toUtf8());
+                *errorResponse.getMessage() = "Invalid JSON request";
+                writeJson(response, errorResponse);
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
-            response.write(errorResponse.asJson().toUtf8());
+            *errorResponse.getMessage() = "Invalid JSON format";
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelIndexService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1474,44 +1618,31 @@ void WebAPIRequestMapper::devicesetChannelIndexService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "DELETE")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
-
-        if (request.getMethod() == "DELETE")
-        {
-            SWGSDRangel::SWGSuccessResponse normalResponse;
-            int status = m_adapter->devicesetChannelDelete(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        SWGSDRangel::SWGSuccessResponse normalResponse;
+        int status = m_adapter->devicesetChannelDelete(deviceSetIndex, channelIndex, normalResponse, errorResponse);
 
-            response.setStatus(status);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else
-        {
-            response.setStatus(405,"Invalid HTTP method");
-            errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
-            response.write(errorResponse.asJson().toUtf8());
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelSettingsService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1519,88 +1650,75 @@ void WebAPIRequestMapper::devicesetChannelSettingsService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGChannelSettings normalResponse;
+        resetChannelSettings(normalResponse);
+        int status = m_adapter->devicesetChannelSettingsGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
+        }
+    }
+    else if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
 
-        if (request.getMethod() == "GET")
+        if (parseJsonBody(jsonStr, jsonObject, response))
         {
             SWGSDRangel::SWGChannelSettings normalResponse;
             resetChannelSettings(normalResponse);
-            int status = m_adapter->devicesetChannelSettingsGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
-            response.setStatus(status);
-
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
-        }
-        else if ((request.getMethod() == "PUT") || (request.getMethod() == "PATCH"))
-        {
-            QString jsonStr = request.getBody();
-            QJsonObject jsonObject;
+            QStringList channelSettingsKeys;
 
-            if (parseJsonBody(jsonStr, jsonObject, response))
+            if (validateChannelSettings(normalResponse, jsonObject, channelSettingsKeys))
             {
-                SWGSDRangel::SWGChannelSettings normalResponse;
-                resetChannelSettings(normalResponse);
-                QStringList channelSettingsKeys;
-
-                if (validateChannelSettings(normalResponse, jsonObject, channelSettingsKeys))
-                {
-                    int status = m_adapter->devicesetChannelSettingsPutPatch(
-                            deviceSetIndex,
-                            channelIndex,
-                            (request.getMethod() == "PUT"), // force settings on PUT
-                            channelSettingsKeys,
-                            normalResponse,
-                            errorResponse);
-                    response.setStatus(status);
-
-                    if (status/100 == 2) {
-                        response.write(normalResponse.asJson().toUtf8());
-                    } else {
-                        response.write(errorResponse.asJson().toUtf8());
-                    }
-                }
-                else
-                {
-                    response.setStatus(400,"Invalid JSON request");
-                    errorResponse.init();
-                    *errorResponse.getMessage() = "Invalid JSON request";
-                    response.write(errorResponse.asJson().toUtf8());
+                int status = m_adapter->devicesetChannelSettingsPutPatch(
+                        deviceSetIndex,
+                        channelIndex,
+                        (request.getMethod() == "PUT"), // force settings on PUT
+                        channelSettingsKeys,
+                        normalResponse,
+                        errorResponse);
+                response.setStatus(status);
+
+                if (status/100 == 2) {
+                    writeJson(response, normalResponse);
+                } else {
+                    writeJson(response, errorResponse);
                 }
             }
             else
             {
-                response.setStatus(400,"Invalid JSON format");
+                response.setStatus(400,"Invalid JSON request");
                 errorResponse.init();
-                *errorResponse.getMessage() = "Invalid JSON format";
-                response.write(errorResponse.asJson().toUtf8());
+                *errorResponse.getMessage() = "Invalid JSON request";
+                writeJson(response, errorResponse);
             }
         }
         else
         {
-            response.setStatus(405,"Invalid HTTP method");
+            response.setStatus(400,"Invalid JSON format");
             errorResponse.init();
-            *errorResponse.getMessage() = "Invalid HTTP method";
-            response.write(errorResponse.asJson().toUtf8());
+            *errorResponse.getMessage() = "Invalid JSON format";
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
+    else
     {
+        response.setStatus(405,"Invalid HTTP method");
         errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        writeJson(response, errorResponse);
     }
 }
 
 void WebAPIRequestMapper::devicesetChannelReportService(
-        const std::string& deviceSetIndexStr,
-        const std::string& channelIndexStr,
+        int deviceSetIndex,
+        int channelIndex,
         qtwebapp::HttpRequest& request,
         qtwebapp::HttpResponse& response)
 {
@@ -1608,32 +1726,19 @@ void WebAPIRequestMapper::devicesetChannelReportService(
     response.setHeader("Content-Type", "application/json");
     response.setHeader("Access-Control-Allow-Origin", "*");
 
-    try
+    if (request.getMethod() == "GET")
     {
-        int deviceSetIndex = boost::lexical_cast<int>(deviceSetIndexStr);
-        int channelIndex = boost::lexical_cast<int>(channelIndexStr);
-
-        if (request.getMethod() == "GET")
-        {
-            SWGSDRangel::SWGChannelReport normalResponse;
-            resetChannelReport(normalResponse);
-            int status = m_adapter->devicesetChannelReportGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
-            response.setStatus(status);
+        SWGSDRangel::SWGChannelReport normalResponse;
+        resetChannelReport(normalResponse);
+        int status = m_adapter->devicesetChannelReportGet(deviceSetIndex, channelIndex, normalResponse, errorResponse);
+        response.setStatus(status);
 
-            if (status/100 == 2) {
-                response.write(normalResponse.asJson().toUtf8());
-            } else {
-                response.write(errorResponse.asJson().toUtf8());
-            }
+        if (status/100 == 2) {
+            writeJson(response, normalResponse);
+        } else {
+            writeJson(response, errorResponse);
         }
     }
-    catch (const boost::bad_lexical_cast &e)
-    {
-        errorResponse.init();
-        *errorResponse.getMessage() = "Wrong integer conversion on index";
-        response.setStatus(400,"Invalid data");
-        response.write(errorResponse.asJson().toUtf8());
-    }
 }
 
 bool WebAPIRequestMapper::parseJsonBody(QString& jsonStr, QJsonObject& jsonObject, qtwebapp::HttpResponse& response)
@@ -1656,7 +1761,7 @@ bool WebAPIRequestMapper::parseJsonBody(QString& jsonStr, QJsonObject& jsonObjec
             errorResponse.init();
             *errorResponse.getMessage() = errorMsg;
             response.setStatus(400, errorMsg.toUtf8());
-            response.write(errorResponse.asJson().toUtf8());
+            writeJson(response, errorResponse);
         }
 
         return (error.error == QJsonParseError::NoError);
@@ -1667,12 +1772,23 @@ bool WebAPIRequestMapper::parseJsonBody(QString& jsonStr, QJsonObject& jsonObjec
         errorResponse.init();
         *errorResponse.getMessage() = errorMsg;
         response.setStatus(500, errorMsg.toUtf8());
-        response.write(errorResponse.asJson().toUtf8());
+        writeJson(response, errorResponse);
 
         return false;
     }
 }
 
+void WebAPIRequestMapper::writeJson(qtwebapp::HttpResponse& response, SWGSDRangel::SWGObject& object)
+{
+    if (response.hasSentLastPart()) { // an error body was already sent e.g. by parseJsonBody
+        return;
+    }
+
+    QJsonObject *jsonObject = object.asJsonObject();
+    response.write(QJsonDocument(*jsonObject).toJson(QJsonDocument::Compact), true);
+    delete jsonObject;
+}
+
 bool WebAPIRequestMapper::validatePresetTransfer(SWGSDRangel::SWGPresetTransfer& presetTransfer)
 {
     SWGSDRangel::SWGPresetIdentifier *presetIdentifier = presetTransfer.getPreset();
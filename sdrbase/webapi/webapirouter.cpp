@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QList>
+
+#include "webapirouter.h"
+
+WebAPIRouter::Node::~Node()
+{
+    qDeleteAll(m_literals);
+    delete m_intCapture;
+}
+
+WebAPIRouter::WebAPIRouter() :
+    m_root(new Node())
+{}
+
+WebAPIRouter::~WebAPIRouter()
+{
+    delete m_root;
+}
+
+void WebAPIRouter::addRoute(const QByteArray& pattern, int routeId)
+{
+    Node *node = m_root;
+    QList<QByteArray> segments = pattern.split('/');
+    int nbCaptures = 0;
+
+    // the leading slash gives an empty first segment
+    for (int i = 1; i < segments.size(); i++)
+    {
+        if (segments[i] == "{int}")
+        {
+            if (!node->m_intCapture) {
+                node->m_intCapture = new Node();
+            }
+
+            node = node->m_intCapture;
+            nbCaptures++;
+        }
+        else
+        {
+            Node *& child = node->m_literals[segments[i]];
+
+            if (!child) {
+                child = new Node();
+            }
+
+            node = child;
+        }
+    }
+
+    Q_ASSERT(pattern.startsWith('/'));
+    Q_ASSERT(nbCaptures <= m_maxCaptures);
+    node->m_routeId = routeId;
+}
+
+int WebAPIRouter::match(const QByteArray& path, int captures[m_maxCaptures]) const
+{
+    const char *data = path.constData();
+    int size = path.size();
+
+    if ((size == 0) || (data[0] != '/')) {
+        return -1;
+    }
+
+    const Node *node = m_root;
+    int nbCaptures = 0;
+    int begin = 1;
+
+    while (node)
+    {
+        int end = begin;
+
+        while ((end < size) && (data[end] != '/')) {
+            end++;
+        }
+
+        // wraps the path bytes without copy for the hash lookup
+        QHash<QByteArray, Node*>::const_iterator it = node->m_literals.constFind(QByteArray::fromRawData(data + begin, end - begin));
+
+        if (it != node->m_literals.constEnd())
+        {
+            node = it.value();
+        }
+        else if (node->m_intCapture && (nbCaptures < m_maxCaptures) && parseInt(data + begin, end - begin, captures[nbCaptures]))
+        {
+            node = node->m_intCapture;
+            nbCaptures++;
+        }
+        else
+        {
+            return -1;
+        }
+
+        if (end == size) {
+            return node->m_routeId;
+        }
+
+        begin = end + 1;
+    }
+
+    return -1;
+}
+
+bool WebAPIRouter::parseInt(const char *begin, int size, int& value)
+{
+    if ((size == 0) || (size > 9)) { // 9 digits always fit in an int
+        return false;
+    }
+
+    value = 0;
+
+    for (int i = 0; i < size; i++)
+    {
+        if ((begin[i] < '0') || (begin[i] > '9')) {
+            return false;
+        }
+
+        value = value*10 + (begin[i] - '0');
+    }
+
+    return true;
+}
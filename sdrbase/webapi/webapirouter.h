@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBAPI_WEBAPIROUTER_H_
+#define SDRBASE_WEBAPI_WEBAPIROUTER_H_
+
+#include <QByteArray>
+#include <QHash>
+
+#include "export.h"
+
+/**
+ * Maps request paths to route identifiers. Routes are compiled once into a trie of path
+ * segments. A segment is either a literal or "{int}" which captures a decimal integer.
+ * Literals take precedence over captures at the same level. Matching does not allocate.
+ */
+class SDRBASE_API WebAPIRouter
+{
+public:
+    static const int m_maxCaptures = 4;
+
+    WebAPIRouter();
+    ~WebAPIRouter();
+
+    /** Add a route e.g. "/sdrangel/deviceset/{int}/channel/{int}/report". routeId must be positive or zero */
+    void addRoute(const QByteArray& pattern, int routeId);
+    /** Return the route identifier or -1 if there is no match. captures receives the integer captures in path order */
+    int match(const QByteArray& path, int captures[m_maxCaptures]) const;
+
+private:
+    struct Node
+    {
+        QHash<QByteArray, Node*> m_literals;
+        Node *m_intCapture;
+        int m_routeId;
+
+        Node() : m_intCapture(nullptr), m_routeId(-1) {}
+        ~Node();
+    };
+
+    Node *m_root;
+
+    static bool parseInt(const char *begin, int size, int& value);
+};
+
+#endif /* SDRBASE_WEBAPI_WEBAPIROUTER_H_ */
@@ -18,14 +18,19 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QCoreApplication>
+#include <QThread>
 
 #include "httplistener.h"
 #include "webapirequestmapper.h"
 #include "webapiserver.h"
+#include "websockets/wsreports.h"
 
 WebAPIServer::WebAPIServer(const QString& host, uint16_t port, WebAPIRequestMapper *requestMapper) :
     m_requestMapper(requestMapper),
-    m_listener(0)
+    m_listener(0),
+    m_reportsPort(0),
+    m_reportsThread(nullptr),
+    m_wsReports(nullptr)
 {
     m_settings.host = host;
     m_settings.port = port;
@@ -33,6 +38,7 @@ WebAPIServer::WebAPIServer(const QString& host, uint16_t port, WebAPIRequestMapp
 
 WebAPIServer::~WebAPIServer()
 {
+    stopReports();
     if (m_listener) { delete m_listener; }
 }
 
@@ -43,10 +49,14 @@ void WebAPIServer::start()
         m_listener = new qtwebapp::HttpListener(m_settings, m_requestMapper, qApp);
         qInfo("WebAPIServer::start: starting web API server at http://%s:%d", qPrintable(m_settings.host), m_settings.port);
     }
+
+    startReports();
 }
 
 void WebAPIServer::stop()
 {
+    stopReports();
+
     if (m_listener)
     {
         delete m_listener;
@@ -61,4 +71,48 @@ void WebAPIServer::setHostAndPort(const QString& host, uint16_t port)
     m_settings.host = host;
     m_settings.port = port;
     m_listener = new qtwebapp::HttpListener(m_settings, m_requestMapper, qApp);
+    startReports();
+}
+
+void WebAPIServer::startReports()
+{
+    if (m_wsReports || (m_reportsPort == 0) || !m_requestMapper->getAdapter()) {
+        return;
+    }
+
+    m_reportsThread = new QThread();
+    m_wsReports = new WSReports(m_settings.host, m_reportsPort, m_requestMapper->getAdapter());
+    m_wsReports->moveToThread(m_reportsThread);
+    m_reportsThread->start();
+    QMetaObject::invokeMethod(m_wsReports, "openSocket", Qt::BlockingQueuedConnection);
+
+    if (m_wsReports->isListening())
+    {
+        qInfo("WebAPIServer::startReports: starting reports server at ws://%s:%d", qPrintable(m_settings.host), m_reportsPort);
+    }
+    else
+    {
+        m_reportsThread->quit();
+        m_reportsThread->wait();
+        delete m_wsReports;
+        delete m_reportsThread;
+        m_wsReports = nullptr;
+        m_reportsThread = nullptr;
+    }
+}
+
+void WebAPIServer::stopReports()
+{
+    if (!m_wsReports) {
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_wsReports, "closeSocket", Qt::BlockingQueuedConnection);
+    m_reportsThread->quit();
+    m_reportsThread->wait();
+    delete m_wsReports;
+    delete m_reportsThread;
+    m_wsReports = nullptr;
+    m_reportsThread = nullptr;
+    qInfo("WebAPIServer::stopReports: stopped reports server at ws://%s:%d", qPrintable(m_settings.host), m_reportsPort);
 }
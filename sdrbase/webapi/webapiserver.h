@@ -29,6 +29,8 @@ namespace qtwebapp
 }
 
 class WebAPIRequestMapper;
+class WSReports;
+class QThread;
 
 class SDRBASE_API WebAPIServer
 {
@@ -40,6 +42,8 @@ public:
     void stop();
 
     void setHostAndPort(const QString& host, uint16_t port);
+    /** Port of the web socket server pushing device and channel reports on the same host. 0 to disable */
+    void setReportsPort(uint16_t port) { m_reportsPort = port; }
     const QString& getHost() const { return m_settings.host; }
     int getPort() const { return m_settings.port; }
 
@@ -47,6 +51,12 @@ private:
     WebAPIRequestMapper *m_requestMapper;
     qtwebapp::HttpListener *m_listener;
     qtwebapp::HttpListenerSettings m_settings;
+    uint16_t m_reportsPort;
+    QThread *m_reportsThread;
+    WSReports *m_wsReports;
+
+    void startReports();
+    void stopReports();
 };
 
 
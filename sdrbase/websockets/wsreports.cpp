@@ -0,0 +1,398 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QWebSocketServer>
+#include <QWebSocket>
+#include <QTimer>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QDebug>
+
+#include "webapi/webapiadapterinterface.h"
+#include "webapi/webapirequestmapper.h"
+#include "SWGDeviceReport.h"
+#include "SWGChannelReport.h"
+#include "SWGErrorResponse.h"
+
+#include "wsreports.h"
+
+WSReports::WSReports(const QString& address, quint16 port, WebAPIAdapterInterface *adapter, QObject *parent) :
+    QObject(parent),
+    m_listeningAddress(address),
+    m_port(port),
+    m_listening(false),
+    m_adapter(adapter),
+    m_webSocketServer(nullptr),
+    m_timer(nullptr)
+{
+    m_clock.start();
+}
+
+WSReports::~WSReports()
+{
+    closeSocket();
+}
+
+void WSReports::openSocket()
+{
+    if (m_webSocketServer) {
+        return;
+    }
+
+    // created here so that they live in the thread running the event loop of this object
+    m_webSocketServer = new QWebSocketServer(QStringLiteral("Reports Server"), QWebSocketServer::NonSecureMode, this);
+
+    if (m_webSocketServer->listen(m_listeningAddress, m_port))
+    {
+        qDebug() << "WSReports::openSocket: reports server listening at " << m_listeningAddress.toString() << " on port " << m_port;
+        connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &WSReports::onNewConnection);
+        m_timer = new QTimer(this);
+        connect(m_timer, &QTimer::timeout, this, &WSReports::tick);
+        m_listening = true;
+    }
+    else
+    {
+        qInfo("WSReports::openSocket: cannot start reports server at %s on port %u", qPrintable(m_listeningAddress.toString()), m_port);
+        delete m_webSocketServer;
+        m_webSocketServer = nullptr;
+        m_listening = false;
+    }
+}
+
+void WSReports::closeSocket()
+{
+    if (!m_webSocketServer) {
+        return;
+    }
+
+    delete m_timer;
+    m_timer = nullptr;
+    m_webSocketServer->close();
+
+    // close() may emit disconnected synchronously: detach the sockets first so that
+    // socketDisconnected does not touch m_clients or schedule a second delete
+    QList<QWebSocket*> clients = m_clients.keys();
+    m_clients.clear();
+
+    for (QWebSocket *client : clients)
+    {
+        disconnect(client, nullptr, this, nullptr);
+        client->close();
+        delete client;
+    }
+
+    delete m_webSocketServer;
+    m_webSocketServer = nullptr;
+    m_listening = false;
+}
+
+void WSReports::onNewConnection()
+{
+    QWebSocket *pSocket = m_webSocketServer->nextPendingConnection();
+
+    connect(pSocket, &QWebSocket::textMessageReceived, this, &WSReports::processClientMessage);
+    connect(pSocket, &QWebSocket::disconnected, this, &WSReports::socketDisconnected);
+
+    m_clients.insert(pSocket, QList<Subscription>());
+    qDebug() << "WSReports::onNewConnection: client connected: " << pSocket->peerAddress().toString() << ":" << pSocket->peerPort();
+}
+
+void WSReports::processClientMessage(const QString &message)
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (!pClient || !m_clients.contains(pClient)) {
+        return;
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(message.toUtf8(), &error);
+
+    if ((error.error != QJsonParseError::NoError) || !doc.isObject())
+    {
+        qDebug() << "WSReports::processClientMessage: invalid message: " << message;
+        return;
+    }
+
+    QList<Subscription>& subscriptions = m_clients[pClient];
+    QJsonArray subscribeArray = doc.object().value("subscribe").toArray();
+    QJsonArray unsubscribeArray = doc.object().value("unsubscribe").toArray();
+
+    for (QJsonArray::const_iterator it = unsubscribeArray.constBegin(); it != unsubscribeArray.constEnd(); ++it) {
+        unsubscribe(subscriptions, (*it).toObject());
+    }
+
+    for (QJsonArray::const_iterator it = subscribeArray.constBegin(); it != subscribeArray.constEnd(); ++it) {
+        subscribe(subscriptions, (*it).toObject());
+    }
+
+    updateTimer();
+}
+
+void WSReports::socketDisconnected()
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (pClient)
+    {
+        qDebug() << "WSReports::socketDisconnected: client disconnected: " << pClient->peerAddress().toString() << ":" << pClient->peerPort();
+        m_clients.remove(pClient);
+        pClient->deleteLater();
+        updateTimer();
+    }
+}
+
+WSReports::ReportKey WSReports::parseKey(const QJsonObject& item)
+{
+    int deviceSetIndex = item.value("deviceSet").toInt(-1);
+    int channelIndex = item.contains("channel") ? item.value("channel").toInt(-1) : -1;
+
+    if ((deviceSetIndex < 0) || (item.contains("channel") && (channelIndex < 0))) {
+        return ReportKey(-1, -1);
+    }
+
+    return ReportKey(deviceSetIndex, channelIndex);
+}
+
+void WSReports::subscribe(QList<Subscription>& subscriptions, const QJsonObject& item)
+{
+    ReportKey key = parseKey(item);
+
+    if (key.first < 0) {
+        return;
+    }
+
+    int periodMs = item.value("periodMs").toInt(1000);
+    periodMs = periodMs < m_tickMs ? m_tickMs : periodMs > m_maxPeriodMs ? m_maxPeriodMs : periodMs;
+    QList<Subscription>::iterator it = subscriptions.begin();
+
+    for (; it != subscriptions.end(); ++it)
+    {
+        if (it->m_key == key) {
+            break;
+        }
+    }
+
+    if (it == subscriptions.end())
+    {
+        if (subscriptions.size() >= m_maxSubscriptions) {
+            return;
+        }
+
+        it = subscriptions.insert(it, Subscription());
+        it->m_key = key;
+    }
+
+    // (re)subscription starts over with a full report
+    it->m_periodMs = periodMs;
+    it->m_nextMs = m_clock.elapsed();
+    it->m_full = true;
+    it->m_lastSent = QJsonObject();
+    it->m_lastError.clear();
+}
+
+void WSReports::unsubscribe(QList<Subscription>& subscriptions, const QJsonObject& item)
+{
+    ReportKey key = parseKey(item);
+
+    for (QList<Subscription>::iterator it = subscriptions.begin(); it != subscriptions.end(); ++it)
+    {
+        if (it->m_key == key)
+        {
+            subscriptions.erase(it);
+            return;
+        }
+    }
+}
+
+void WSReports::updateTimer()
+{
+    if (!m_timer) {
+        return;
+    }
+
+    bool active = false;
+
+    for (QHash<QWebSocket*, QList<Subscription>>::const_iterator it = m_clients.constBegin(); it != m_clients.constEnd(); ++it)
+    {
+        if (!it.value().isEmpty())
+        {
+            active = true;
+            break;
+        }
+    }
+
+    if (active && !m_timer->isActive()) {
+        m_timer->start(m_tickMs);
+    } else if (!active && m_timer->isActive()) {
+        m_timer->stop();
+    }
+}
+
+const WSReports::Report& WSReports::getReport(const ReportKey& key, QHash<ReportKey, Report>& reports)
+{
+    QHash<ReportKey, Report>::iterator it = reports.find(key);
+
+    if (it != reports.end()) {
+        return it.value();
+    }
+
+    SWGSDRangel::SWGErrorResponse error;
+    QJsonObject *jsonObject = nullptr;
+    int status;
+
+    // same calls as the GET requests on the report URLs that end in the webapiReportGet of the plugins
+    if (key.second < 0)
+    {
+        SWGSDRangel::SWGDeviceReport deviceReport;
+        WebAPIRequestMapper::resetDeviceReport(deviceReport);
+        status = m_adapter->devicesetDeviceReportGet(key.first, deviceReport, error);
+
+        if (status/100 == 2) {
+            jsonObject = deviceReport.asJsonObject();
+        }
+    }
+    else
+    {
+        SWGSDRangel::SWGChannelReport channelReport;
+        WebAPIRequestMapper::resetChannelReport(channelReport);
+        status = m_adapter->devicesetChannelReportGet(key.first, key.second, channelReport, error);
+
+        if (status/100 == 2) {
+            jsonObject = channelReport.asJsonObject();
+        }
+    }
+
+    Report& report = reports[key];
+    report.m_ok = jsonObject != nullptr;
+
+    if (jsonObject)
+    {
+        report.m_report = *jsonObject;
+        delete jsonObject;
+    }
+    else
+    {
+        report.m_error = error.getMessage() ? *error.getMessage() : QString("Error %1").arg(status);
+    }
+
+    return report;
+}
+
+void WSReports::tick()
+{
+    qint64 nowMs = m_clock.elapsed();
+    QHash<ReportKey, Report> reports; // each report is fetched once per tick whatever the number of subscribers
+
+    for (QHash<QWebSocket*, QList<Subscription>>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        QJsonArray items;
+
+        for (QList<Subscription>::iterator sit = it.value().begin(); sit != it.value().end(); ++sit)
+        {
+            if (sit->m_nextMs > nowMs) {
+                continue;
+            }
+
+            // keep the phase and skip the periods that were missed
+            sit->m_nextMs += sit->m_periodMs * ((nowMs - sit->m_nextMs) / sit->m_periodMs + 1);
+            const Report& report = getReport(sit->m_key, reports);
+            QJsonObject item;
+            item.insert("deviceSet", sit->m_key.first);
+
+            if (sit->m_key.second >= 0) {
+                item.insert("channel", sit->m_key.second);
+            }
+
+            if (!report.m_ok)
+            {
+                if (report.m_error == sit->m_lastError) { // already notified
+                    continue;
+                }
+
+                item.insert("error", report.m_error);
+                sit->m_lastError = report.m_error;
+                sit->m_full = true;
+            }
+            else if (sit->m_full)
+            {
+                item.insert("full", true);
+                item.insert("report", report.m_report);
+                sit->m_lastSent = report.m_report;
+                sit->m_lastError.clear();
+                sit->m_full = false;
+            }
+            else
+            {
+                QJsonObject delta;
+
+                if (!jsonDelta(sit->m_lastSent, report.m_report, delta)) {
+                    continue;
+                }
+
+                item.insert("report", delta);
+                sit->m_lastSent = report.m_report;
+            }
+
+            items.append(item);
+        }
+
+        if (!items.isEmpty())
+        {
+            QJsonObject frame;
+            frame.insert("timestamp", (double) QDateTime::currentMSecsSinceEpoch());
+            frame.insert("reports", items);
+            it.key()->sendTextMessage(QString::fromUtf8(QJsonDocument(frame).toJson(QJsonDocument::Compact)));
+        }
+    }
+}
+
+bool WSReports::jsonDelta(const QJsonObject& previous, const QJsonObject& current, QJsonObject& delta)
+{
+    for (QJsonObject::const_iterator it = current.constBegin(); it != current.constEnd(); ++it)
+    {
+        QJsonObject::const_iterator previousIt = previous.constFind(it.key());
+
+        if (previousIt == previous.constEnd())
+        {
+            delta.insert(it.key(), it.value());
+        }
+        else if (it.value().isObject() && previousIt.value().isObject())
+        {
+            QJsonObject subDelta;
+
+            if (jsonDelta(previousIt.value().toObject(), it.value().toObject(), subDelta)) {
+                delta.insert(it.key(), subDelta);
+            }
+        }
+        else if (it.value() != previousIt.value())
+        {
+            delta.insert(it.key(), it.value());
+        }
+    }
+
+    for (QJsonObject::const_iterator it = previous.constBegin(); it != previous.constEnd(); ++it)
+    {
+        if (!current.contains(it.key())) {
+            delta.insert(it.key(), QJsonValue());
+        }
+    }
+
+    return !delta.isEmpty();
+}
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// WebSocket server pushing device and channel reports to subscribed clients.    //
+//                                                                               //
+// Clients send text messages to (un)subscribe. No channel means device report:  //
+//   {"subscribe": [{"deviceSet": 0, "channel": 1, "periodMs": 200},             //
+//                  {"deviceSet": 0, "periodMs": 1000}]}                         //
+//   {"unsubscribe": [{"deviceSet": 0, "channel": 1}]}                           //
+//                                                                               //
+// At each period the report is fetched through the web API adapter and only     //
+// the fields that changed since the last push are sent. Reports due at the      //
+// same time are batched in one text frame:                                      //
+//   {"timestamp": ms since epoch, "reports": [                                  //
+//     {"deviceSet": 0, "channel": 1, "full": true, "report": {...}},            //
+//     {"deviceSet": 0, "report": {changed fields}},                             //
+//     {"deviceSet": 1, "channel": 0, "error": "message"}]}                      //
+// Objects are compared member by member, removed members are sent as null and   //
+// arrays are sent whole. The first push after (re)subscription or an error is   //
+// full.                                                                         //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBSOCKETS_WSREPORTS_H_
+#define SDRBASE_WEBSOCKETS_WSREPORTS_H_
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+class QTimer;
+class WebAPIAdapterInterface;
+
+class SDRBASE_API WSReports : public QObject
+{
+    Q_OBJECT
+public:
+    static const int m_tickMs = 50;            //!< scheduling resolution and minimum period
+    static const int m_maxPeriodMs = 60000;
+    static const int m_maxSubscriptions = 256; //!< per client
+
+    WSReports(const QString& address, quint16 port, WebAPIAdapterInterface *adapter, QObject *parent = nullptr);
+    virtual ~WSReports();
+
+    bool isListening() const { return m_listening; }
+
+    /** Members of current that differ from previous. Removed members are null. Returns false if there is no change */
+    static bool jsonDelta(const QJsonObject& previous, const QJsonObject& current, QJsonObject& delta);
+
+public slots:
+    void openSocket();
+    void closeSocket();
+
+private slots:
+    void onNewConnection();
+    void processClientMessage(const QString &message);
+    void socketDisconnected();
+    void tick();
+
+private:
+    typedef QPair<int, int> ReportKey; //!< device set index, channel index or -1 for the device report
+
+    struct Subscription
+    {
+        ReportKey m_key;
+        int m_periodMs;
+        qint64 m_nextMs;
+        bool m_full;              //!< next push sends the whole report
+        QJsonObject m_lastSent;
+        QString m_lastError;
+    };
+
+    struct Report
+    {
+        bool m_ok;
+        QJsonObject m_report;
+        QString m_error;
+    };
+
+    QHostAddress m_listeningAddress;
+    quint16 m_port;
+    bool m_listening;
+    WebAPIAdapterInterface *m_adapter;
+    QWebSocketServer* m_webSocketServer;
+    QHash<QWebSocket*, QList<Subscription>> m_clients;
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+
+    void subscribe(QList<Subscription>& subscriptions, const QJsonObject& item);
+    void unsubscribe(QList<Subscription>& subscriptions, const QJsonObject& item);
+    void updateTimer();
+    const Report& getReport(const ReportKey& key, QHash<ReportKey, Report>& reports);
+    static ReportKey parseKey(const QJsonObject& item);
+};
+
+#endif // SDRBASE_WEBSOCKETS_WSREPORTS_H_
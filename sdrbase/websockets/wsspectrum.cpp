@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QWebSocketServer>
+#include <QWebSocket>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include "wsspectrum.h"
+
+WSSpectrum::WSSpectrum(const QString& address, quint16 port, QObject *parent) :
+    QObject(parent),
+    m_listeningAddress(address),
+    m_port(port),
+    m_listening(false),
+    m_webSocketServer(nullptr)
+{
+}
+
+WSSpectrum::~WSSpectrum()
+{
+    closeSocket();
+}
+
+void WSSpectrum::openSocket()
+{
+    if (m_webSocketServer) {
+        return;
+    }
+
+    // created here so that it lives in the thread running the event loop of this object
+    m_webSocketServer = new QWebSocketServer(QStringLiteral("Spectrum Server"), QWebSocketServer::NonSecureMode, this);
+
+    if (m_webSocketServer->listen(m_listeningAddress, m_port))
+    {
+        qDebug() << "WSSpectrum::openSocket: spectrum server listening at " << m_listeningAddress.toString() << " on port " << m_port;
+        connect(m_webSocketServer, &QWebSocketServer::newConnection, this, &WSSpectrum::onNewConnection);
+        m_listening = true;
+    }
+    else
+    {
+        qInfo("WSSpectrum::openSocket: cannot start spectrum server at %s on port %u", qPrintable(m_listeningAddress.toString()), m_port);
+        delete m_webSocketServer;
+        m_webSocketServer = nullptr;
+        m_listening = false;
+    }
+}
+
+void WSSpectrum::closeSocket()
+{
+    if (!m_webSocketServer) {
+        return;
+    }
+
+    m_webSocketServer->close();
+
+    // close() may emit disconnected synchronously: detach the sockets first so that
+    // socketDisconnected does not take the mutex again or schedule a second delete
+    QList<QWebSocket*> clients;
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        clients = m_clients;
+        m_clients.clear();
+    }
+
+    for (QWebSocket *client : clients)
+    {
+        disconnect(client, nullptr, this, nullptr);
+        client->close();
+        delete client;
+    }
+
+    delete m_webSocketServer;
+    m_webSocketServer = nullptr;
+    m_listening = false;
+}
+
+void WSSpectrum::onNewConnection()
+{
+    QWebSocket *pSocket = m_webSocketServer->nextPendingConnection();
+
+    connect(pSocket, &QWebSocket::textMessageReceived, this, &WSSpectrum::processClientMessage);
+    connect(pSocket, &QWebSocket::disconnected, this, &WSSpectrum::socketDisconnected);
+
+    QMutexLocker mutexLocker(&m_mutex);
+    m_clients << pSocket;
+    qDebug() << "WSSpectrum::onNewConnection: client connected: " << pSocket->peerAddress().toString() << ":" << pSocket->peerPort();
+}
+
+void WSSpectrum::processClientMessage(const QString &message)
+{
+    qDebug() << "WSSpectrum::processClientMessage: " << message; // control from clients is not supported
+}
+
+void WSSpectrum::socketDisconnected()
+{
+    QWebSocket *pClient = qobject_cast<QWebSocket *>(sender());
+
+    if (pClient)
+    {
+        qDebug() << "WSSpectrum::socketDisconnected: client disconnected: " << pClient->peerAddress().toString() << ":" << pClient->peerPort();
+        QMutexLocker mutexLocker(&m_mutex);
+        m_clients.removeAll(pClient);
+        pClient->deleteLater();
+    }
+}
+
+void WSSpectrum::newSpectrumFrame(const QByteArray& frame)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (QList<QWebSocket*>::iterator it = m_clients.begin(); it != m_clients.end(); ++it) {
+        (*it)->sendBinaryMessage(frame);
+    }
+}
+
+void WSSpectrum::getPeers(QList<QHostAddress>& hosts, QList<quint16>& ports) const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    hosts.clear();
+    ports.clear();
+
+    for (QList<QWebSocket*>::const_iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        hosts.push_back((*it)->peerAddress());
+        ports.push_back((*it)->peerPort());
+    }
+}
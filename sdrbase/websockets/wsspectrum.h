@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// WebSocket server broadcasting binary spectrum frames to remote displays.      //
+//                                                                               //
+// Frame layout (little endian):                                                 //
+//   0  u64 center frequency (Hz)                                                //
+//   8  u64 time stamp (ms since epoch)                                          //
+//  16  u32 sample rate (S/s)                                                    //
+//  20  u16 number of bins N                                                     //
+//  22  u16 flags (bit 0: linear scale before conversion to dB)                  //
+//  24  i16 reference level (dB) mapped to 255                                   //
+//  26  u16 power range (dB). 0 is reference level minus power range             //
+//  28  u32 frame sequence number                                                //
+//  32  N x u8 bins from lowest to highest frequency                             //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_WEBSOCKETS_WSSPECTRUM_H_
+#define SDRBASE_WEBSOCKETS_WSSPECTRUM_H_
+
+#include <QObject>
+#include <QList>
+#include <QHostAddress>
+#include <QMutex>
+#include <QByteArray>
+
+#include "export.h"
+
+class QWebSocketServer;
+class QWebSocket;
+
+class SDRBASE_API WSSpectrum : public QObject
+{
+    Q_OBJECT
+public:
+    static const int m_headerSize = 32;
+
+    WSSpectrum(const QString& address, quint16 port, QObject *parent = nullptr);
+    virtual ~WSSpectrum();
+
+    bool isListening() const { return m_listening; }
+    void getPeers(QList<QHostAddress>& hosts, QList<quint16>& ports) const;
+
+public slots:
+    void openSocket();
+    void closeSocket();
+    void newSpectrumFrame(const QByteArray& frame);
+
+private slots:
+    void onNewConnection();
+    void processClientMessage(const QString &message);
+    void socketDisconnected();
+
+private:
+    QHostAddress m_listeningAddress;
+    quint16 m_port;
+    bool m_listening;
+    QWebSocketServer* m_webSocketServer;
+    QList<QWebSocket*> m_clients;
+    mutable QMutex m_mutex;
+};
+
+#endif // SDRBASE_WEBSOCKETS_WSSPECTRUM_H_
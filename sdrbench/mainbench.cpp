@@ -19,7 +19,21 @@
 
 #include <QDebug>
 #include <QElapsedTimer>
-
+#include <QFile>
+#include <QTextStream>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
+#include <QDateTime>
+#include <QSysInfo>
+#include <QCoreApplication>
+#include <math.h>
+#include <algorithm>
+
+#include "dsp/fftengine.h"
+#include "dsp/hbfilterkernels.h"
+#include "dsp/ncof.h"
+#include "util/cpufeatures.h"
 #include "mainbench.h"
 
 MainBench *MainBench::m_instance = 0;
@@ -46,7 +60,16 @@ void MainBench::run()
         << " testType: " << (int) m_parser.getTestType()
         << " nsamples: " << m_parser.getNbSamples()
         << " repet: " << m_parser.getRepetition()
-        << " log2f: " << m_parser.getLog2Factor();
+        << " log2f: " << m_parser.getLog2Factor()
+        << " fftwPrePlan: " << m_parser.getFFTWPrePlan();
+
+    FFTEngine::loadWisdom();
+
+    if (m_parser.getFFTWPrePlan())
+    {
+        FFTEngine::prePlan(6, 14);
+        FFTEngine::saveWisdom();
+    }
 
     if (m_parser.getTestType() == ParserBench::TestDecimatorsII) {
         testDecimateII();
@@ -60,17 +83,60 @@ void MainBench::run()
         testDecimateFI();
     } else if (m_parser.getTestType() == ParserBench::TestDecimatorsFF) {
         testDecimateFF();
+    } else if (m_parser.getTestType() == ParserBench::TestIQCorrection) {
+        testIQCorrection();
+    } else if (m_parser.getTestType() == ParserBench::TestDownChannelizer) {
+        testDownChannelizer();
+    } else if (m_parser.getTestType() == ParserBench::TestUpChannelizer) {
+        testUpChannelizer();
+    } else if (m_parser.getTestType() == ParserBench::TestInterpolator) {
+        testInterpolator();
+    } else if (m_parser.getTestType() == ParserBench::TestFFTFilt) {
+        testFFTFilt();
+    } else if (m_parser.getTestType() == ParserBench::TestFFTEngine) {
+        testFFTEngine();
+    } else if (m_parser.getTestType() == ParserBench::TestNCO) {
+        testNCO();
+    } else if (m_parser.getTestType() == ParserBench::TestSampleSinkFifo) {
+        testSampleSinkFifo();
+    } else if (m_parser.getTestType() == ParserBench::TestUDPBatch) {
+        testUDPBatch();
+    } else if (m_parser.getTestType() == ParserBench::TestLDPC) {
+        testLDPC();
+    } else if (m_parser.getTestType() == ParserBench::TestLoRa) {
+        testLoRa();
+    } else if (m_parser.getTestType() == ParserBench::TestWebAPI) {
+        testWebAPI();
+    } else if ((m_parser.getTestType() == ParserBench::TestDemodNFM)
+            || (m_parser.getTestType() == ParserBench::TestDemodSSB)
+            || (m_parser.getTestType() == ParserBench::TestDemodWFM)
+            || (m_parser.getTestType() == ParserBench::TestDemodBFM)) {
+        testDemod(m_parser.getTestType());
+    } else if (m_parser.getTestType() == ParserBench::TestAll) {
+        testDownChannelizer();
+        testUpChannelizer();
+        testInterpolator();
+        testFFTFilt();
+        testFFTEngine();
+        testNCO();
+        testSampleSinkFifo();
+        testLoRa();
+        testDemod(ParserBench::TestDemodNFM);
+        testDemod(ParserBench::TestDemodSSB);
+        testDemod(ParserBench::TestDemodWFM);
+        testDemod(ParserBench::TestDemodBFM);
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
 
+    writeResults();
+    FFTEngine::saveWisdom();
     emit finished();
 }
 
 void MainBench::testDecimateII(ParserBench::TestType testType)
 {
     QElapsedTimer timer;
-    qint64 nsecs = 0;
 
     qDebug() << "MainBench::testDecimateII: create test data";
 
@@ -79,32 +145,72 @@ void MainBench::testDecimateII(ParserBench::TestType testType)
     auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
     std::generate(buf, buf + m_parser.getNbSamples()*2 - 1, my_rand);
 
-    qDebug() << "MainBench::testDecimateII: run test";
+    qDebug() << "MainBench::testDecimateII: run test with CPU features:" << CPUFeatures::getDescription();
 
-    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    // run the same data through every half-band kernel the CPU supports and check against the scalar one
+    HBFilterKernels::Kernel bestKernel = HBFilterKernels::getKernel();
+    SampleVector reference;
+
+    for (int k = 0; k < (int) HBFilterKernels::KernelEnd; k++)
     {
-        switch (testType)
+        HBFilterKernels::Kernel kernel = (HBFilterKernels::Kernel) k;
+
+        if (!HBFilterKernels::setKernel(kernel)) {
+            continue;
+        }
+
+        m_decimatorsII = Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12>(); // same filter history for each kernel
+        qint64 nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
         {
-        case ParserBench::TestDecimatorsInfII:
-            timer.start();
-            decimateInfII(buf, m_parser.getNbSamples()*2);
-            nsecs += timer.nsecsElapsed();
-            break;
-        case ParserBench::TestDecimatorsSupII:
-            timer.start();
-            decimateSupII(buf, m_parser.getNbSamples()*2);
-            nsecs += timer.nsecsElapsed();
-            break;
-        case ParserBench::TestDecimatorsII:
-        default:
-            timer.start();
-            decimateII(buf, m_parser.getNbSamples()*2);
-            nsecs += timer.nsecsElapsed();
-            break;
+            switch (testType)
+            {
+            case ParserBench::TestDecimatorsInfII:
+                timer.start();
+                decimateInfII(buf, m_parser.getNbSamples()*2);
+                nsecs += timer.nsecsElapsed();
+                break;
+            case ParserBench::TestDecimatorsSupII:
+                timer.start();
+                decimateSupII(buf, m_parser.getNbSamples()*2);
+                nsecs += timer.nsecsElapsed();
+                break;
+            case ParserBench::TestDecimatorsII:
+            default:
+                timer.start();
+                decimateII(buf, m_parser.getNbSamples()*2);
+                nsecs += timer.nsecsElapsed();
+                break;
+            }
+        }
+
+        printResults(QString("MainBench::testDecimateII(%1)").arg(HBFilterKernels::getKernelName(kernel)), nsecs);
+
+        if (kernel == HBFilterKernels::KernelScalar)
+        {
+            reference = m_convertBuffer;
+        }
+        else
+        {
+            int mismatches = 0;
+
+            for (unsigned int i = 0; i < m_convertBuffer.size(); i++)
+            {
+                if ((m_convertBuffer[i].real() != reference[i].real()) || (m_convertBuffer[i].imag() != reference[i].imag())) {
+                    mismatches++;
+                }
+            }
+
+            if (mismatches == 0) {
+                qInfo("MainBench::testDecimateII: %s: bit exact with scalar", HBFilterKernels::getKernelName(kernel));
+            } else {
+                qWarning("MainBench::testDecimateII: %s: %d samples differ from scalar", HBFilterKernels::getKernelName(kernel), mismatches);
+            }
         }
     }
 
-    printResults("MainBench::testDecimateII", nsecs);
+    HBFilterKernels::setKernel(bestKernel);
 
     qDebug() << "MainBench::testDecimateII: cleanup test data";
     delete[] buf;
@@ -191,6 +297,80 @@ void MainBench::testDecimateFF()
     delete[] buf;
 }
 
+void MainBench::testIQCorrection()
+{
+    QElapsedTimer timer;
+    qint64 nsecsPerSample = 0;
+    qint64 nsecsBlock = 0;
+    const std::size_t blockSize = 16384; // typical FIFO read size
+
+    qDebug() << "MainBench::testIQCorrection: create test data";
+
+    // DC offset and IQ imbalance: Q leaks 10% of I and has 80% of its amplitude
+    SampleVector samples(m_parser.getNbSamples());
+    SampleVector work(m_parser.getNbSamples());
+    float scale = SDR_RX_SCALEF / 4.0f;
+
+    for (SampleVector::iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        float i = m_uniform_distribution_f(m_generator);
+        float q = m_uniform_distribution_f(m_generator);
+        it->setReal((i + 0.02f) * scale);
+        it->setImag((0.8f * (q + 0.1f * i) - 0.01f) * scale);
+    }
+
+    IQCorrector perSampleCorrector;
+
+    qDebug() << "MainBench::testIQCorrection: run test";
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        std::copy(samples.begin(), samples.end(), work.begin());
+        timer.start();
+
+        for (std::size_t n = 0; n < work.size(); n += blockSize) {
+            perSampleCorrector.processPerSample(work.begin() + n, work.begin() + std::min(n + blockSize, work.size()), true);
+        }
+
+        nsecsPerSample += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testIQCorrection: per sample", nsecsPerSample);
+
+    // block correction with every kernel the CPU supports
+    IQCorrector::Kernel bestKernel = IQCorrector::getKernel();
+
+    for (int k = 0; k < (int) IQCorrector::KernelEnd; k++)
+    {
+        IQCorrector::Kernel kernel = (IQCorrector::Kernel) k;
+
+        if (!IQCorrector::setKernel(kernel)) {
+            continue;
+        }
+
+        IQCorrector blockCorrector;
+        nsecsBlock = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            std::copy(samples.begin(), samples.end(), work.begin());
+            timer.start();
+
+            for (std::size_t n = 0; n < work.size(); n += blockSize) {
+                blockCorrector.process(work.begin() + n, work.begin() + std::min(n + blockSize, work.size()), true);
+            }
+
+            nsecsBlock += timer.nsecsElapsed();
+        }
+
+        printResults(QString("MainBench::testIQCorrection: block (%1)").arg(IQCorrector::getKernelName(kernel)), nsecsBlock);
+        qInfo("MainBench::testIQCorrection: block estimates: DC: %f %f phi: %f amp: %f",
+            blockCorrector.getDCI() / scale, blockCorrector.getDCQ() / scale, blockCorrector.getPhi(), blockCorrector.getAmp());
+    }
+
+    IQCorrector::setKernel(bestKernel);
+}
+
 void MainBench::decimateII(const qint16* buf, int len)
 {
     SampleVector::iterator it = m_convertBuffer.begin();
@@ -389,4 +569,165 @@ void MainBench::printResults(const QString& prefix, qint64 nsecs)
     QDebug info = qInfo();
     info.noquote();
     info << tr("%1: ran test in %L2 ns - sample rate: %3 kS/s").arg(prefix).arg(nsecs).arg(ratekSs);
+
+    Result result;
+    result.m_test = prefix;
+    result.m_nbSamples = (qint64) m_parser.getNbSamples() * m_parser.getRepetition();
+    result.m_nsecs = nsecs;
+    result.m_blockSize = 0;
+    result.m_p50 = result.m_p90 = result.m_p99 = result.m_max = 0;
+    m_results.push_back(result);
+}
+
+void MainBench::generateIQ(SampleVector& samples, float frequency, float deviation)
+{
+    // FM modulated tone plus noise at -20 dB from full scale. frequency and deviation relative to the sample rate
+    NCOF modulation;
+    modulation.setFreq(frequency, 1.0f);
+    float phase = 0.0f;
+    float scale = SDR_RX_SCALEF / 10.0f;
+
+    for (SampleVector::iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        phase += 2.0f * M_PI * deviation * modulation.next();
+        phase = phase > M_PI ? phase - 2.0f * M_PI : phase < -M_PI ? phase + 2.0f * M_PI : phase;
+        it->setReal((cos(phase) + 0.1f * m_uniform_distribution_f(m_generator)) * scale);
+        it->setImag((sin(phase) + 0.1f * m_uniform_distribution_f(m_generator)) * scale);
+    }
+}
+
+void MainBench::runTimed(const QString& prefix, unsigned int nbSamples, unsigned int blockSize, const std::function<void(unsigned int, unsigned int)>& process)
+{
+    QElapsedTimer timer;
+    std::vector<qint64> blockNsecs;
+    blockNsecs.reserve(((nbSamples + blockSize - 1) / blockSize) * m_parser.getRepetition());
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        for (unsigned int offset = 0; offset < nbSamples; offset += blockSize)
+        {
+            unsigned int count = std::min(blockSize, nbSamples - offset);
+            timer.start();
+            process(offset, count);
+            blockNsecs.push_back(timer.nsecsElapsed());
+        }
+    }
+
+    addResult(prefix, (qint64) nbSamples * m_parser.getRepetition(), blockSize, blockNsecs);
+}
+
+void MainBench::addResult(const QString& prefix, qint64 nbSamples, unsigned int blockSize, std::vector<qint64>& blockNsecs)
+{
+    Result result;
+    result.m_test = prefix;
+    result.m_nbSamples = nbSamples;
+    result.m_nsecs = 0;
+    result.m_blockSize = blockSize;
+
+    for (std::vector<qint64>::const_iterator it = blockNsecs.begin(); it != blockNsecs.end(); ++it) {
+        result.m_nsecs += *it;
+    }
+
+    if (blockNsecs.size() == 0) {
+        blockNsecs.push_back(0);
+    }
+
+    std::sort(blockNsecs.begin(), blockNsecs.end());
+    result.m_p50 = blockNsecs[(blockNsecs.size() * 50) / 100];
+    result.m_p90 = blockNsecs[(blockNsecs.size() * 90) / 100];
+    result.m_p99 = blockNsecs[std::min(blockNsecs.size() - 1, (blockNsecs.size() * 99) / 100)];
+    result.m_max = blockNsecs.back();
+    m_results.push_back(result);
+
+    double ratekSs = result.m_nsecs == 0 ? 0.0 : (nbSamples / (double) result.m_nsecs) * 1e6;
+    double nsPerSample = nbSamples == 0 ? 0.0 : result.m_nsecs / (double) nbSamples;
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("%1: ran test in %L2 ns - sample rate: %3 kS/s - %4 ns/S - latency per %5 samples: p50: %L6 p90: %L7 p99: %L8 max: %L9 ns")
+        .arg(prefix).arg(result.m_nsecs).arg(ratekSs).arg(nsPerSample).arg(blockSize)
+        .arg(result.m_p50).arg(result.m_p90).arg(result.m_p99).arg(result.m_max);
+}
+
+void MainBench::writeResults()
+{
+    if (m_parser.getOutputFormat() == ParserBench::OutputText) {
+        return; // already printed
+    }
+
+    QFile file;
+    bool opened;
+
+    if (m_parser.getOutputFileName().isEmpty()) {
+        opened = file.open(stdout, QIODevice::WriteOnly);
+    } else {
+        file.setFileName(m_parser.getOutputFileName());
+        opened = file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+
+    if (!opened)
+    {
+        qWarning() << "MainBench::writeResults: cannot open output: " << m_parser.getOutputFileName();
+        return;
+    }
+
+    QTextStream out(&file);
+
+    if (m_parser.getOutputFormat() == ParserBench::OutputJSON)
+    {
+        QJsonArray results;
+
+        for (std::vector<Result>::const_iterator it = m_results.begin(); it != m_results.end(); ++it)
+        {
+            QJsonObject result;
+            result.insert("test", it->m_test);
+            result.insert("samples", it->m_nbSamples);
+            result.insert("nsecs", it->m_nsecs);
+            result.insert("samplesPerSecond", it->m_nsecs == 0 ? 0.0 : (it->m_nbSamples / (double) it->m_nsecs) * 1e9);
+            result.insert("nsPerSample", it->m_nbSamples == 0 ? 0.0 : it->m_nsecs / (double) it->m_nbSamples);
+
+            if (it->m_blockSize != 0)
+            {
+                result.insert("blockSize", (int) it->m_blockSize);
+                result.insert("p50Ns", it->m_p50);
+                result.insert("p90Ns", it->m_p90);
+                result.insert("p99Ns", it->m_p99);
+                result.insert("maxNs", it->m_max);
+            }
+
+            results.append(result);
+        }
+
+        QJsonObject root;
+        root.insert("version", QCoreApplication::applicationVersion());
+        root.insert("date", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+        root.insert("cpuArchitecture", QSysInfo::currentCpuArchitecture());
+        root.insert("os", QSysInfo::prettyProductName());
+        root.insert("rxSampleBits", SDR_RX_SAMP_SZ);
+        root.insert("repetition", (int) m_parser.getRepetition());
+        root.insert("results", results);
+        out << QJsonDocument(root).toJson();
+    }
+    else
+    {
+        out << "test,samples,nsecs,samplesPerSecond,nsPerSample,blockSize,p50Ns,p90Ns,p99Ns,maxNs\n";
+
+        for (std::vector<Result>::const_iterator it = m_results.begin(); it != m_results.end(); ++it)
+        {
+            QString test = it->m_test;
+            test.replace('"', "\"\"");
+            out << "\"" << test << "\","
+                << it->m_nbSamples << ","
+                << it->m_nsecs << ","
+                << QString::number(it->m_nsecs == 0 ? 0.0 : (it->m_nbSamples / (double) it->m_nsecs) * 1e9, 'f', 0) << ","
+                << QString::number(it->m_nbSamples == 0 ? 0.0 : it->m_nsecs / (double) it->m_nbSamples, 'f', 3) << ",";
+
+            if (it->m_blockSize != 0) {
+                out << it->m_blockSize << "," << it->m_p50 << "," << it->m_p90 << "," << it->m_p99 << "," << it->m_max << "\n";
+            } else {
+                out << ",,,,\n";
+            }
+        }
+    }
+
+    out.flush();
 }
@@ -23,11 +23,13 @@
 #include <QObject>
 #include <random>
 #include <functional>
+#include <vector>
 
 #include "dsp/decimators.h"
 #include "dsp/decimatorsif.h"
 #include "dsp/decimatorsfi.h"
 #include "dsp/decimatorsff.h"
+#include "dsp/iqcorrector.h"
 #include "parserbench.h"
 
 namespace qtwebapp {
@@ -52,6 +54,19 @@ private:
     void testDecimateIF();
     void testDecimateFI();
     void testDecimateFF();
+    void testIQCorrection();
+    void testDownChannelizer();
+    void testUpChannelizer();
+    void testInterpolator();
+    void testFFTFilt();
+    void testFFTEngine();
+    void testNCO();
+    void testSampleSinkFifo();
+    void testUDPBatch();
+    void testLDPC();
+    void testLoRa();
+    void testWebAPI();
+    void testDemod(ParserBench::TestType testType);
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
@@ -59,6 +74,23 @@ private:
     void decimateFI(const float *buf, int len);
     void decimateFF(const float *buf, int len);
     void printResults(const QString& prefix, qint64 nsecs);
+    void generateIQ(SampleVector& samples, float frequency, float deviation);
+    /** Call process(offset, count) over nbSamples samples in blocks of blockSize for the number of repetitions and record the results */
+    void runTimed(const QString& prefix, unsigned int nbSamples, unsigned int blockSize, const std::function<void(unsigned int, unsigned int)>& process);
+    void addResult(const QString& prefix, qint64 nbSamples, unsigned int blockSize, std::vector<qint64>& blockNsecs);
+    void writeResults();
+
+    struct Result
+    {
+        QString m_test;
+        qint64 m_nbSamples;
+        qint64 m_nsecs;
+        unsigned int m_blockSize; //!< 0 if latencies were not measured
+        qint64 m_p50;
+        qint64 m_p90;
+        qint64 m_p99;
+        qint64 m_max;
+    };
 
     static MainBench *m_instance;
     qtwebapp::LoggerWithFile *m_logger;
@@ -74,6 +106,7 @@ private:
 
     SampleVector m_convertBuffer;
     FSampleVector m_convertBufferF;
+    std::vector<Result> m_results;
 };
 
 #endif // SDRBENCH_MAINBENCH_H_
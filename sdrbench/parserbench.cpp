@@ -38,12 +38,38 @@ ParserBench::ParserBench() :
     m_log2FactorOption(QStringList() << "l" << "log2-factor",
         "Log2 factor for rate conversion.",
         "log2",
-        "2")
+        "2"),
+    m_fftwPrePlanOption("fftw-preplan", "Create FFTW plans for the common FFT sizes before running the test and save them in the wisdom file"),
+    m_blockSizeOption(QStringList() << "b" << "block-size",
+        "Number of samples processed in one call. Latency percentiles are computed over these calls.",
+        "samples",
+        "4096"),
+    m_formatOption(QStringList() << "f" << "format",
+        "Results format: text, json or csv.",
+        "format",
+        "text"),
+    m_outputOption(QStringList() << "o" << "output",
+        "Write results to this file instead of the standard output (json and csv formats).",
+        "file",
+        ""),
+    m_esN0Option("esn0",
+        "Es/N0 of the QPSK symbols (dB) in the LDPC test.",
+        "dB",
+        "2.0"),
+    m_ldpcIterationsOption("ldpc-iterations",
+        "Maximum number of iterations of the LDPC decoder.",
+        "iterations",
+        "25")
 {
     m_testStr = "decimateii";
     m_nbSamples = 1048576;
     m_repetition = 1;
     m_log2Factor = 4;
+    m_fftwPrePlan = false;
+    m_blockSize = 4096;
+    m_outputFormat = OutputText;
+    m_esN0 = 2.0f;
+    m_ldpcIterations = 25;
 
     m_parser.setApplicationDescription("Software Defined Radio application benchmarks");
     m_parser.addHelpOption();
@@ -53,6 +79,12 @@ ParserBench::ParserBench() :
     m_parser.addOption(m_nbSamplesOption);
     m_parser.addOption(m_repetitionOption);
     m_parser.addOption(m_log2FactorOption);
+    m_parser.addOption(m_fftwPrePlanOption);
+    m_parser.addOption(m_blockSizeOption);
+    m_parser.addOption(m_formatOption);
+    m_parser.addOption(m_outputOption);
+    m_parser.addOption(m_esN0Option);
+    m_parser.addOption(m_ldpcIterationsOption);
 }
 
 ParserBench::~ParserBench()
@@ -111,6 +143,59 @@ void ParserBench::parse(const QCoreApplication& app)
     } else {
         qWarning() << "ParserBench::parse: repetilog2 factortion invalid. Defaulting to " << m_log2Factor;
     }
+
+    // FFTW pre-planning
+
+    m_fftwPrePlan = m_parser.isSet(m_fftwPrePlanOption);
+
+    // block size
+
+    QString blockSizeStr = m_parser.value(m_blockSizeOption);
+    int blockSize = blockSizeStr.toInt(&ok);
+
+    if (ok && (blockSize > 0) && (blockSize <= (int) m_nbSamples)) {
+        m_blockSize = blockSize;
+    } else {
+        qWarning() << "ParserBench::parse: block size invalid. Defaulting to " << m_blockSize;
+    }
+
+    // results format
+
+    QString format = m_parser.value(m_formatOption);
+
+    if (format == "json") {
+        m_outputFormat = OutputJSON;
+    } else if (format == "csv") {
+        m_outputFormat = OutputCSV;
+    } else if (format == "text") {
+        m_outputFormat = OutputText;
+    } else {
+        qWarning() << "ParserBench::parse: format invalid. Defaulting to text";
+    }
+
+    // results file
+
+    m_outputFileName = m_parser.value(m_outputOption);
+
+    // LDPC test
+
+    QString esN0Str = m_parser.value(m_esN0Option);
+    float esN0 = esN0Str.toFloat(&ok);
+
+    if (ok && (esN0 > -10.0f) && (esN0 < 30.0f)) {
+        m_esN0 = esN0;
+    } else {
+        qWarning() << "ParserBench::parse: Es/N0 invalid. Defaulting to " << m_esN0;
+    }
+
+    QString ldpcIterationsStr = m_parser.value(m_ldpcIterationsOption);
+    int ldpcIterations = ldpcIterationsStr.toInt(&ok);
+
+    if (ok && (ldpcIterations > 0) && (ldpcIterations <= 1000)) {
+        m_ldpcIterations = ldpcIterations;
+    } else {
+        qWarning() << "ParserBench::parse: LDPC iterations invalid. Defaulting to " << m_ldpcIterations;
+    }
 }
 
 ParserBench::TestType ParserBench::getTestType() const
@@ -125,6 +210,40 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsInfII;
     } else if (m_testStr == "decimatesupii") {
         return TestDecimatorsSupII;
+    } else if (m_testStr == "iqcorrection") {
+        return TestIQCorrection;
+    } else if (m_testStr == "downchannelizer") {
+        return TestDownChannelizer;
+    } else if (m_testStr == "upchannelizer") {
+        return TestUpChannelizer;
+    } else if (m_testStr == "interpolator") {
+        return TestInterpolator;
+    } else if (m_testStr == "fftfilt") {
+        return TestFFTFilt;
+    } else if (m_testStr == "fftengine") {
+        return TestFFTEngine;
+    } else if (m_testStr == "nco") {
+        return TestNCO;
+    } else if (m_testStr == "samplesinkfifo") {
+        return TestSampleSinkFifo;
+    } else if (m_testStr == "udpbatch") {
+        return TestUDPBatch;
+    } else if (m_testStr == "ldpc") {
+        return TestLDPC;
+    } else if (m_testStr == "lora") {
+        return TestLoRa;
+    } else if (m_testStr == "webapi") {
+        return TestWebAPI;
+    } else if (m_testStr == "demodnfm") {
+        return TestDemodNFM;
+    } else if (m_testStr == "demodssb") {
+        return TestDemodSSB;
+    } else if (m_testStr == "demodwfm") {
+        return TestDemodWFM;
+    } else if (m_testStr == "demodbfm") {
+        return TestDemodBFM;
+    } else if (m_testStr == "all") {
+        return TestAll;
     } else {
         return TestDecimatorsII;
     }
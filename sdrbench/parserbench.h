@@ -32,9 +32,33 @@ public:
         TestDecimatorsFI,
         TestDecimatorsFF,
         TestDecimatorsInfII,
-        TestDecimatorsSupII
+        TestDecimatorsSupII,
+        TestIQCorrection,
+        TestDownChannelizer,
+        TestUpChannelizer,
+        TestInterpolator,
+        TestFFTFilt,
+        TestFFTEngine,
+        TestNCO,
+        TestSampleSinkFifo,
+        TestUDPBatch,
+        TestLDPC,
+        TestLoRa,
+        TestWebAPI,
+        TestDemodNFM,
+        TestDemodSSB,
+        TestDemodWFM,
+        TestDemodBFM,
+        TestAll //!< all of the above except the decimators and IQ correction
     } TestType;
 
+    typedef enum
+    {
+        OutputText,
+        OutputJSON,
+        OutputCSV
+    } OutputFormat;
+
     ParserBench();
     ~ParserBench();
 
@@ -45,18 +69,36 @@ public:
     uint32_t getNbSamples() const { return m_nbSamples; }
     uint32_t getRepetition() const { return m_repetition; }
     uint32_t getLog2Factor() const { return m_log2Factor; }
+    bool getFFTWPrePlan() const { return m_fftwPrePlan; }
+    uint32_t getBlockSize() const { return m_blockSize; }
+    OutputFormat getOutputFormat() const { return m_outputFormat; }
+    const QString& getOutputFileName() const { return m_outputFileName; }
+    float getEsN0() const { return m_esN0; }
+    uint32_t getLDPCIterations() const { return m_ldpcIterations; }
 
 private:
     QString  m_testStr;
     uint32_t m_nbSamples;
     uint32_t m_repetition;
     uint32_t m_log2Factor;
+    bool m_fftwPrePlan;
+    uint32_t m_blockSize;
+    OutputFormat m_outputFormat;
+    QString m_outputFileName;
+    float m_esN0;
+    uint32_t m_ldpcIterations;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_testOption;
     QCommandLineOption m_nbSamplesOption;
     QCommandLineOption m_repetitionOption;
     QCommandLineOption m_log2FactorOption;
+    QCommandLineOption m_fftwPrePlanOption;
+    QCommandLineOption m_blockSizeOption;
+    QCommandLineOption m_formatOption;
+    QCommandLineOption m_outputOption;
+    QCommandLineOption m_esN0Option;
+    QCommandLineOption m_ldpcIterationsOption;
 };
 
 
@@ -0,0 +1,128 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/downchannelizer.h"
+#include "dsp/upchannelizer.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/basebandsamplesource.h"
+#include "dsp/dspcommands.h"
+#include "dsp/nco.h"
+#include "mainbench.h"
+
+namespace {
+
+// Channel end of the channelizers. Samples are just counted.
+class BenchSampleSink : public BasebandSampleSink
+{
+public:
+    BenchSampleSink() : m_count(0) {}
+    virtual void start() {}
+    virtual void stop() {}
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+    {
+        (void) positiveOnly;
+        m_count += end - begin;
+    }
+    virtual bool handleMessage(const Message& cmd) { (void) cmd; return false; }
+    qint64 m_count;
+};
+
+class BenchSampleSource : public BasebandSampleSource
+{
+public:
+    BenchSampleSource() { m_nco.setFreq(1000.0, 48000.0); }
+    virtual void start() {}
+    virtual void stop() {}
+    virtual void pull(Sample& sample)
+    {
+        Complex c = m_nco.nextIQ() * (SDR_TX_SCALEF / 2.0f);
+        sample.setReal(c.real());
+        sample.setImag(c.imag());
+    }
+    virtual bool handleMessage(const Message& cmd) { (void) cmd; return false; }
+    NCO m_nco;
+};
+
+}
+
+void MainBench::testDownChannelizer()
+{
+    qDebug() << "MainBench::testDownChannelizer: create test data";
+
+    SampleVector samples(m_parser.getNbSamples());
+    generateIQ(samples, 0.01f, 0.05f);
+    unsigned int log2Decim = m_parser.getLog2Factor();
+
+    qDebug() << "MainBench::testDownChannelizer: run test";
+
+    for (int blockMode = 0; blockMode < 2; blockMode++)
+    {
+        BenchSampleSink sink;
+        DownChannelizer channelizer(&sink);
+        channelizer.setBlockMode(blockMode != 0);
+        DSPSignalNotification notif(3072000, 0);
+        channelizer.handleMessage(notif);
+        DownChannelizer::MsgSetChannelizer setChannelizer(log2Decim, 0); // centered
+        channelizer.handleMessage(setChannelizer);
+
+        runTimed(tr("MainBench::testDownChannelizer: %1 log2 decim %2").arg(blockMode ? "block" : "sample").arg(log2Decim),
+            samples.size(), m_parser.getBlockSize(),
+            [&](unsigned int offset, unsigned int count) {
+                channelizer.feed(samples.begin() + offset, samples.begin() + offset + count, false);
+            }
+        );
+    }
+}
+
+void MainBench::testUpChannelizer()
+{
+    qDebug() << "MainBench::testUpChannelizer: run test";
+
+    SampleVector samples(m_parser.getBlockSize());
+    unsigned int log2Interp = m_parser.getLog2Factor();
+
+    for (int blockMode = 0; blockMode < 2; blockMode++)
+    {
+        BenchSampleSource source;
+        UpChannelizer channelizer(&source);
+        DSPSignalNotification notif(3072000, 0);
+        channelizer.handleMessage(notif);
+        UpChannelizer::MsgSetChannelizer setChannelizer(log2Interp, 0); // centered
+        channelizer.handleMessage(setChannelizer);
+
+        runTimed(tr("MainBench::testUpChannelizer: %1 log2 interp %2").arg(blockMode ? "block" : "sample").arg(log2Interp),
+            m_parser.getNbSamples(), m_parser.getBlockSize(),
+            [&](unsigned int offset, unsigned int count) {
+                (void) offset;
+
+                if (blockMode)
+                {
+                    channelizer.pull(samples.begin(), count);
+                }
+                else
+                {
+                    for (unsigned int i = 0; i < count; i++) {
+                        channelizer.pull(samples[i]);
+                    }
+                }
+            }
+        );
+    }
+}
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "device/deviceapi.h"
+#include "dsp/downchannelizer.h"
+#include "nfmdemod.h"
+#include "ssbdemod.h"
+#include "wfmdemod.h"
+#include "bfmdemod.h"
+#include "mainbench.h"
+
+namespace {
+
+template<class Demod>
+void runDemod(
+    DeviceAPI *deviceAPI,
+    int channelSampleRate,
+    const std::function<void(BasebandSampleSink*)>& run)
+{
+    Demod *demod = new Demod(deviceAPI);
+    DownChannelizer::MsgChannelizerNotification notif(channelSampleRate, 0);
+    demod->handleMessage(notif); // what the channelizer would send
+    demod->start();
+    run(demod);
+    demod->stop();
+    delete demod;
+}
+
+}
+
+void MainBench::testDemod(ParserBench::TestType testType)
+{
+    // channel sample rates as given by the channelizer for the default settings
+    int channelSampleRate;
+    float deviation;
+    QString demodName;
+
+    switch (testType)
+    {
+    case ParserBench::TestDemodSSB:
+        channelSampleRate = 48000;
+        deviation = 0.0f;
+        demodName = "SSB";
+        break;
+    case ParserBench::TestDemodWFM:
+        channelSampleRate = WFMDemod::requiredBW(80000);
+        deviation = 75000.0f / channelSampleRate;
+        demodName = "WFM";
+        break;
+    case ParserBench::TestDemodBFM:
+        channelSampleRate = BFMDemod::requiredBW(180000);
+        deviation = 75000.0f / channelSampleRate;
+        demodName = "BFM";
+        break;
+    case ParserBench::TestDemodNFM:
+    default:
+        channelSampleRate = 48000;
+        deviation = 5000.0f / channelSampleRate;
+        demodName = "NFM";
+        break;
+    }
+
+    qDebug() << "MainBench::testDemod: " << demodName << ": create test data";
+
+    SampleVector samples(m_parser.getNbSamples());
+    generateIQ(samples, 1000.0f / channelSampleRate, deviation);
+
+    qDebug() << "MainBench::testDemod: " << demodName << ": run test";
+
+    // not attached to a device engine so that only the feed method of the demodulator is run
+    DeviceAPI deviceAPI(DeviceAPI::StreamSingleRx, 0, nullptr, nullptr, nullptr);
+    QString prefix = tr("MainBench::testDemod: %1 at %2 S/s").arg(demodName).arg(channelSampleRate);
+    std::function<void(BasebandSampleSink*)> run = [&](BasebandSampleSink *demod) {
+        runTimed(prefix, samples.size(), m_parser.getBlockSize(),
+            [&](unsigned int offset, unsigned int count) {
+                demod->feed(samples.begin() + offset, samples.begin() + offset + count, false);
+            }
+        );
+    };
+
+    switch (testType)
+    {
+    case ParserBench::TestDemodSSB:
+        runDemod<SSBDemod>(&deviceAPI, channelSampleRate, run);
+        break;
+    case ParserBench::TestDemodWFM:
+        runDemod<WFMDemod>(&deviceAPI, channelSampleRate, run);
+        break;
+    case ParserBench::TestDemodBFM:
+        runDemod<BFMDemod>(&deviceAPI, channelSampleRate, run);
+        break;
+    case ParserBench::TestDemodNFM:
+    default:
+        runDemod<NFMDemod>(&deviceAPI, channelSampleRate, run);
+        break;
+    }
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QStringList>
+
+#include "dsp/kissengine.h"
+#ifdef USE_FFTW
+#include "dsp/fftwengine.h"
+#endif
+#include "mainbench.h"
+
+void MainBench::testFFTEngine()
+{
+    qDebug() << "MainBench::testFFTEngine: create test data";
+
+    SampleVector samples(m_parser.getNbSamples());
+    generateIQ(samples, 0.01f, 0.05f);
+    std::vector<Complex> input(samples.size());
+
+    for (unsigned int i = 0; i < samples.size(); i++) {
+        input[i] = Complex(samples[i].real(), samples[i].imag());
+    }
+
+    qDebug() << "MainBench::testFFTEngine: run test";
+
+    // one block is one transform
+    for (int log2Size = 8; log2Size <= 14; log2Size += 2)
+    {
+        unsigned int fftSize = 1 << log2Size;
+        unsigned int nbSamples = (input.size() / fftSize) * fftSize;
+        std::vector<FFTEngine*> engines;
+        QStringList engineNames;
+        engines.push_back(new KissEngine);
+        engineNames.append("kiss");
+#ifdef USE_FFTW
+        engines.push_back(new FFTWEngine);
+        engineNames.append("fftw");
+#endif
+
+        for (unsigned int e = 0; e < engines.size(); e++)
+        {
+            FFTEngine *engine = engines[e];
+            engine->configure(fftSize, false);
+
+            runTimed(tr("MainBench::testFFTEngine: %1 size %2").arg(engineNames[e]).arg(fftSize),
+                nbSamples, fftSize,
+                [&](unsigned int offset, unsigned int count) {
+                    std::copy(input.begin() + offset, input.begin() + offset + count, engine->in());
+                    engine->transform();
+                }
+            );
+
+            delete engine;
+        }
+    }
+}
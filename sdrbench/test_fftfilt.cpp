@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/fftfilt.h"
+#include "mainbench.h"
+
+void MainBench::testFFTFilt()
+{
+    qDebug() << "MainBench::testFFTFilt: create test data";
+
+    const int fftLength = 1024;
+    SampleVector samples(m_parser.getNbSamples());
+    generateIQ(samples, 0.01f, 0.05f);
+    std::vector<fftfilt::cmplx> input(samples.size());
+    std::vector<fftfilt::cmplx> output(m_parser.getBlockSize() + fftLength);
+
+    for (unsigned int i = 0; i < samples.size(); i++) {
+        input[i] = fftfilt::cmplx(samples[i].real(), samples[i].imag());
+    }
+
+    qDebug() << "MainBench::testFFTFilt: run test";
+
+    // band pass as used in the demodulators with per sample and block calls
+    for (int ssb = 0; ssb < 2; ssb++)
+    {
+        for (int block = 0; block < 2; block++)
+        {
+            fftfilt filter(0.3f / 48.0f, 3.0f / 48.0f, fftLength);
+
+            runTimed(tr("MainBench::testFFTFilt: %1 %2 size %3").arg(ssb ? "SSB" : "filter").arg(block ? "block" : "sample").arg(fftLength),
+                input.size(), m_parser.getBlockSize(),
+                [&](unsigned int offset, unsigned int count) {
+                    if (block)
+                    {
+                        if (ssb) {
+                            filter.runSSBBlock(&input[offset], count, output.data(), true);
+                        } else {
+                            filter.runFiltBlock(&input[offset], count, output.data());
+                        }
+                    }
+                    else
+                    {
+                        fftfilt::cmplx *sideband;
+
+                        for (unsigned int i = offset; i < offset + count; i++)
+                        {
+                            int n = ssb ? filter.runSSB(input[i], &sideband, true) : filter.runFilt(input[i], &sideband);
+
+                            if (n > 0) {
+                                std::copy(sideband, sideband + n, output.begin());
+                            }
+                        }
+                    }
+                }
+            );
+        }
+    }
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/interpolator.h"
+#include "mainbench.h"
+
+void MainBench::testInterpolator()
+{
+    qDebug() << "MainBench::testInterpolator: create test data";
+
+    SampleVector samples(m_parser.getNbSamples());
+    generateIQ(samples, 0.01f, 0.05f);
+    std::vector<Complex> input(samples.size());
+    std::vector<Complex> output(2 * m_parser.getBlockSize() + 1);
+
+    for (unsigned int i = 0; i < samples.size(); i++) {
+        input[i] = Complex(samples[i].real(), samples[i].imag());
+    }
+
+    qDebug() << "MainBench::testInterpolator: run test";
+
+    // fractional rate changes as done in the demodulators: 64 to 48 kS/s and 48 to 64 kS/s
+    for (int interpolate = 0; interpolate < 2; interpolate++)
+    {
+        Interpolator interpolator;
+        Real inputRate = interpolate ? 48000.0 : 64000.0;
+        Real outputRate = interpolate ? 64000.0 : 48000.0;
+        Real distance = inputRate / outputRate;
+        Real distanceRemain = 0.0;
+        interpolator.create(16, inputRate, 0.45 * std::min(inputRate, outputRate));
+
+        runTimed(tr("MainBench::testInterpolator: %1 %2 to %3 S/s").arg(interpolate ? "interpolate" : "decimate").arg(inputRate).arg(outputRate),
+            input.size(), m_parser.getBlockSize(),
+            [&](unsigned int offset, unsigned int count) {
+                unsigned int nbOut = 0;
+
+                for (unsigned int i = offset; i < offset + count; i++)
+                {
+                    if (interpolate)
+                    {
+                        while (!interpolator.interpolate(&distanceRemain, input[i], &output[nbOut])) {
+                            nbOut++;
+                            distanceRemain += distance;
+                        }
+                    }
+                    else if (interpolator.decimate(&distanceRemain, input[i], &output[nbOut]))
+                    {
+                        nbOut++;
+                        distanceRemain += distance;
+                    }
+                }
+            }
+        );
+    }
+}
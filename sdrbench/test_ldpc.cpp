@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "leansdr/framework.h"
+#include "leansdr/generic.h"
+#include "leansdr/dvbs2.h"
+#include "util/cpufeatures.h"
+#include "mainbench.h"
+
+void MainBench::testLDPC()
+{
+    // QPSK DVB-S2 FEC frames (normal and short, rate 1/2) with AWGN at the given Es/N0 decoded
+    // by each LDPC min-sum kernel the CPU supports. Results are checked against the scalar kernel.
+    static const struct { bool sf; leansdr::code_rate rate; const char *name; } codes[] = {
+        {false, leansdr::FEC12, "normal 1/2"},
+        {true,  leansdr::FEC12, "short 1/2"}
+    };
+    const int lanes = leansdr::ldpc_minsum_decoder::LANES;
+    float esN0 = std::pow(10.0f, m_parser.getEsN0() / 10.0f);
+    float sigma = std::sqrt(1.0f / (2.0f * esN0)); // per I or Q component with unit energy symbols
+    float amplitude = std::sqrt(0.5f);
+    std::normal_distribution<float> noise(0.0f, sigma);
+
+    qDebug() << "MainBench::testLDPC: run test with CPU features:" << CPUFeatures::getDescription()
+        << "Es/N0:" << m_parser.getEsN0() << "dB";
+
+    for (unsigned int ic = 0; ic < sizeof(codes)/sizeof(codes[0]); ic++)
+    {
+        const leansdr::fec_info *fi = &leansdr::fec_infos[codes[ic].sf][codes[ic].rate];
+        int n = codes[ic].sf ? 64800 / 4 : 64800;
+        int k = fi->kldpc;
+        int nbFrames = std::max((int) (m_parser.getNbSamples() / n), lanes); // samples are coded bits here
+        nbFrames = ((nbFrames + lanes - 1) / lanes) * lanes;
+        leansdr::s2_ldpc_engine encoder(fi->ldpc, k, n);
+        leansdr::ldpc_minsum_code code;
+
+        if (!code.init(fi->ldpc, k, n))
+        {
+            qWarning("MainBench::testLDPC: %s: invalid LDPC table", codes[ic].name);
+            continue;
+        }
+
+        // transmitted codewords and received LLRs scaled like the S2 deinterleaver output
+        std::vector<uint8_t> codewords(nbFrames * (n / 8));
+        std::vector<int8_t> llrs(nbFrames * n);
+        long rawErrors = 0;
+
+        for (int f = 0; f < nbFrames; f++)
+        {
+            uint8_t *cw = &codewords[f * (n / 8)];
+
+            for (int i = 0; i < k / 8; i++) {
+                cw[i] = m_generator() & 0xff;
+            }
+
+            encoder.encode(fi->ldpc, cw, k, n, cw + k / 8);
+
+            for (int i = 0; i < n; i++)
+            {
+                int bit = (cw[i / 8] >> (7 - (i % 8))) & 1;
+                float y = (bit ? -amplitude : amplitude) + noise(m_generator);
+                float llr = (2.0f * amplitude * y / (sigma * sigma)) * 5.0f;
+                llrs[f * n + i] = llr > 127.0f ? 127 : llr < -127.0f ? -127 : (int8_t) llr;
+                rawErrors += (llrs[f * n + i] < 0) != bit;
+            }
+        }
+
+        std::vector<uint8_t> reference(nbFrames * (k / 8));
+        std::vector<uint8_t> decoded(nbFrames * (k / 8));
+        leansdr::ldpc_minsum_decoder::kernel bestKernel = leansdr::ldpc_minsum_decoder::get_kernel();
+
+        for (int kk = 0; kk < (int) leansdr::ldpc_minsum_decoder::KERNEL_COUNT; kk++)
+        {
+            leansdr::ldpc_minsum_decoder::kernel kernel = (leansdr::ldpc_minsum_decoder::kernel) kk;
+
+            if (!leansdr::ldpc_minsum_decoder::set_kernel(kernel)) {
+                continue;
+            }
+
+            leansdr::ldpc_minsum_decoder decoder;
+            decoder.max_iterations = m_parser.getLDPCIterations();
+            std::vector<qint64> batchNsecs;
+            long bitErrors = 0;
+            int frameErrors = 0;
+            int failedChecks = 0;
+            long iterations = 0;
+            QElapsedTimer timer;
+
+            for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+            {
+                for (int f0 = 0; f0 < nbFrames; f0 += lanes)
+                {
+                    const int8_t *frames[leansdr::ldpc_minsum_decoder::LANES];
+
+                    for (int f = 0; f < lanes; f++) {
+                        frames[f] = &llrs[(f0 + f) * n];
+                    }
+
+                    timer.start();
+                    uint32_t failed = decoder.decode(code, frames, lanes);
+
+                    for (int f = 0; f < lanes; f++) {
+                        decoder.harden(f, k, &decoded[(f0 + f) * (k / 8)]);
+                    }
+
+                    batchNsecs.push_back(timer.nsecsElapsed());
+                    iterations += decoder.get_iterations();
+
+                    if (r != 0) {
+                        continue;
+                    }
+
+                    for (int f = 0; f < lanes; f++)
+                    {
+                        const uint8_t *cw = &codewords[(f0 + f) * (n / 8)];
+                        const uint8_t *out = &decoded[(f0 + f) * (k / 8)];
+                        int errors = 0;
+
+                        for (int i = 0; i < k / 8; i++) {
+                            errors += leansdr::hamming_weight((uint8_t) (cw[i] ^ out[i]));
+                        }
+
+                        bitErrors += errors;
+                        frameErrors += errors ? 1 : 0;
+                        failedChecks += (failed >> f) & 1;
+                    }
+                }
+            }
+
+            QString prefix = QString("MainBench::testLDPC(%1, %2)").arg(codes[ic].name).arg(leansdr::ldpc_minsum_decoder::kernel_name(kernel));
+            addResult(prefix, (qint64) nbFrames * m_parser.getRepetition(), lanes, batchNsecs);
+            qint64 nsecs = 0;
+
+            for (std::vector<qint64>::const_iterator it = batchNsecs.begin(); it != batchNsecs.end(); ++it) {
+                nsecs += *it;
+            }
+
+            qInfo("%s: %.1f frames/s raw BER %.2e BER %.2e FER %.3f (%d failed parity) %.1f iterations per batch",
+                qPrintable(prefix),
+                nsecs == 0 ? 0.0 : (nbFrames * (double) m_parser.getRepetition() * 1e9) / nsecs,
+                rawErrors / ((double) nbFrames * n),
+                bitErrors / ((double) nbFrames * k),
+                frameErrors / (double) nbFrames,
+                failedChecks,
+                batchNsecs.size() == 0 ? 0.0 : iterations / (double) batchNsecs.size());
+
+            if (kernel == leansdr::ldpc_minsum_decoder::KERNEL_SCALAR)
+            {
+                reference = decoded;
+            }
+            else if (decoded == reference)
+            {
+                qInfo("MainBench::testLDPC: %s: bit exact with scalar", leansdr::ldpc_minsum_decoder::kernel_name(kernel));
+            }
+            else
+            {
+                qWarning("MainBench::testLDPC: %s: decoded frames differ from scalar", leansdr::ldpc_minsum_decoder::kernel_name(kernel));
+            }
+        }
+
+        leansdr::ldpc_minsum_decoder::set_kernel(bestKernel);
+    }
+}
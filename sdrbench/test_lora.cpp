@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "lorasymboldemod.h"
+#include "mainbench.h"
+
+namespace {
+
+/** Append len samples of a LoRa chirp for the given symbol at one sample per chip */
+void appendChirp(std::vector<Complex>& signal, unsigned int spreadFactor, unsigned int symbol, bool up, unsigned int len, float amplitude)
+{
+    unsigned int nbSymbols = 1 << spreadFactor;
+
+    for (unsigned int n = 0; n < len; n++)
+    {
+        unsigned int m = (n + symbol) & (nbSymbols - 1);
+        double phase = std::fmod(M_PI * (((double) m * m) / nbSymbols - m), 2.0 * M_PI);
+        signal.push_back(Complex(amplitude * std::cos(phase), amplitude * (up ? 1.0 : -1.0) * std::sin(phase)));
+    }
+}
+
+}
+
+void MainBench::testLoRa()
+{
+    // One stream carrying back to back frames of every spreading factor at the same time (8 symbols preamble,
+    // 2 symbols sync word, 2.25 symbols delimiter, 16 random payload symbols, 4 symbols gap) plus noise.
+    // Each spreading factor demodulator runs alone then all of them together like in the plugin.
+    const unsigned int nbPayloadSymbols = 16;
+    const unsigned int nbSpreadFactors = LoRaSymbolDemod::m_maxSpreadFactor - LoRaSymbolDemod::m_minSpreadFactor + 1;
+    unsigned int nbSamples = m_parser.getNbSamples();
+    std::vector<std::vector<std::vector<unsigned short>>> payloads(nbSpreadFactors);
+    std::vector<Complex> channel(nbSamples);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+
+    qDebug() << "MainBench::testLoRa: create test data";
+
+    for (unsigned int i = 0; i < nbSpreadFactors; i++)
+    {
+        unsigned int spreadFactor = LoRaSymbolDemod::m_minSpreadFactor + i;
+        unsigned int nbSymbols = 1 << spreadFactor;
+        std::vector<Complex> signal(i * 137, Complex{0.0f, 0.0f}); // frames of different spreading factors do not start together
+
+        while (signal.size() < nbSamples)
+        {
+            for (int k = 0; k < 8; k++) {
+                appendChirp(signal, spreadFactor, 0, true, nbSymbols, 0.5f);
+            }
+
+            appendChirp(signal, spreadFactor, nbSymbols / 4, true, nbSymbols, 0.5f);
+            appendChirp(signal, spreadFactor, nbSymbols / 2, true, nbSymbols, 0.5f);
+            appendChirp(signal, spreadFactor, 0, false, nbSymbols, 0.5f);
+            appendChirp(signal, spreadFactor, 0, false, nbSymbols, 0.5f);
+            appendChirp(signal, spreadFactor, 0, false, nbSymbols / 4, 0.5f);
+            std::vector<unsigned short> payload;
+
+            for (unsigned int k = 0; k < nbPayloadSymbols; k++)
+            {
+                payload.push_back(m_generator() & (nbSymbols - 1));
+                appendChirp(signal, spreadFactor, payload.back(), true, nbSymbols, 0.5f);
+            }
+
+            if (signal.size() <= nbSamples) { // complete frames only
+                payloads[i].push_back(payload);
+            }
+
+            signal.resize(signal.size() + 4 * nbSymbols, Complex{0.0f, 0.0f});
+        }
+
+        for (unsigned int n = 0; n < nbSamples; n++) {
+            channel[n] += signal[n];
+        }
+    }
+
+    for (unsigned int n = 0; n < nbSamples; n++) {
+        channel[n] += Complex(noise(m_generator), noise(m_generator));
+    }
+
+    qDebug() << "MainBench::testLoRa: run test";
+
+    for (unsigned int i = 0; i <= nbSpreadFactors; i++)
+    {
+        std::vector<LoRaSymbolDemod*> demods;
+
+        if (i == nbSpreadFactors)
+        {
+            for (unsigned int sf = LoRaSymbolDemod::m_minSpreadFactor; sf <= LoRaSymbolDemod::m_maxSpreadFactor; sf++) {
+                demods.push_back(new LoRaSymbolDemod(sf));
+            }
+        }
+        else
+        {
+            demods.push_back(new LoRaSymbolDemod(LoRaSymbolDemod::m_minSpreadFactor + i));
+        }
+
+        QString prefix = i == nbSpreadFactors ?
+            tr("MainBench::testLoRa: SF%1 to SF%2").arg(LoRaSymbolDemod::m_minSpreadFactor).arg(LoRaSymbolDemod::m_maxSpreadFactor) :
+            tr("MainBench::testLoRa: SF%1").arg(LoRaSymbolDemod::m_minSpreadFactor + i);
+        runTimed(prefix, nbSamples, m_parser.getBlockSize(),
+            [&](unsigned int offset, unsigned int count) {
+                for (unsigned int d = 0; d < demods.size(); d++) {
+                    demods[d]->process(&channel[offset], count);
+                }
+            }
+        );
+
+        // frames decoded with all their payload symbols right
+        for (unsigned int d = 0; d < demods.size(); d++)
+        {
+            unsigned int index = demods[d]->getSpreadFactor() - LoRaSymbolDemod::m_minSpreadFactor;
+            const std::vector<std::vector<unsigned short>>& frames = demods[d]->getFrames();
+            const std::vector<std::vector<unsigned short>>& sent = payloads[index];
+            unsigned int nbGood = 0;
+            unsigned int next = 0;
+
+            for (unsigned int f = 0; f < frames.size(); f++)
+            {
+                for (unsigned int k = 0; k < sent.size(); k++)
+                {
+                    unsigned int p = (next + k) % sent.size(); // frames come back in order at each repetition
+
+                    if ((frames[f].size() >= nbPayloadSymbols) && std::equal(sent[p].begin(), sent[p].end(), frames[f].begin()))
+                    {
+                        nbGood++;
+                        next = p + 1;
+                        break;
+                    }
+                }
+            }
+
+            qInfo("%s: SF%u: %u frames sent %u decoded %u good over %u repetitions",
+                qPrintable(prefix), demods[d]->getSpreadFactor(), (unsigned int) sent.size() * m_parser.getRepetition(),
+                (unsigned int) frames.size(), nbGood, m_parser.getRepetition());
+            delete demods[d];
+        }
+    }
+}
@@ -0,0 +1,56 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/nco.h"
+#include "dsp/ncof.h"
+#include "mainbench.h"
+
+void MainBench::testNCO()
+{
+    qDebug() << "MainBench::testNCO: run test";
+
+    std::vector<Complex> output(m_parser.getBlockSize());
+    NCO nco;
+    NCOF ncof;
+    nco.setFreq(12345.0, 48000.0);
+    ncof.setFreq(12345.0, 48000.0);
+
+    runTimed(tr("MainBench::testNCO: NCO nextIQ"), m_parser.getNbSamples(), m_parser.getBlockSize(),
+        [&](unsigned int offset, unsigned int count) {
+            (void) offset;
+
+            for (unsigned int i = 0; i < count; i++) {
+                output[i] = nco.nextIQ();
+            }
+        }
+    );
+
+    runTimed(tr("MainBench::testNCO: NCOF nextIQ"), m_parser.getNbSamples(), m_parser.getBlockSize(),
+        [&](unsigned int offset, unsigned int count) {
+            (void) offset;
+
+            for (unsigned int i = 0; i < count; i++) {
+                output[i] = ncof.nextIQ();
+            }
+        }
+    );
+
+    qDebug() << "MainBench::testNCO: last samples: " << output.back().real() << output.back().imag();
+}
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+
+#include "dsp/samplesinkfifo.h"
+#include "mainbench.h"
+
+void MainBench::testSampleSinkFifo()
+{
+    qDebug() << "MainBench::testSampleSinkFifo: create test data";
+
+    SampleVector samples(m_parser.getNbSamples());
+    generateIQ(samples, 0.01f, 0.05f);
+
+    qDebug() << "MainBench::testSampleSinkFifo: run test";
+
+    // write then read back each block in the same thread. This measures the copies and
+    // the cost of the synchronization without the scheduling effects of two threads.
+    for (int mirrored = 0; mirrored < 2; mirrored++)
+    {
+        SampleSinkFifo fifo;
+        fifo.setMirrored(mirrored != 0);
+        fifo.setSize(4 * m_parser.getBlockSize() + 1); // not a multiple of the block size so that reads wrap
+        qint64 nbRead = 0;
+
+        runTimed(tr("MainBench::testSampleSinkFifo: write and read %1").arg(mirrored ? "mirrored" : "two parts"),
+            samples.size(), m_parser.getBlockSize(),
+            [&](unsigned int offset, unsigned int count) {
+                SampleVector::iterator part1begin;
+                SampleVector::iterator part1end;
+                SampleVector::iterator part2begin;
+                SampleVector::iterator part2end;
+
+                fifo.write(samples.begin() + offset, samples.begin() + offset + count);
+                unsigned int nbSamples = fifo.readBegin(fifo.fill(), &part1begin, &part1end, &part2begin, &part2end);
+                nbRead += (part1end - part1begin) + (part2end - part2begin);
+                fifo.readCommit(nbSamples);
+            }
+        );
+
+        qDebug() << "MainBench::testSampleSinkFifo: read " << nbRead << " samples";
+    }
+}
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <thread>
+#include <vector>
+
+#include "channel/remotedatablock.h"
+#include "util/udpbatchsocket.h"
+#include "mainbench.h"
+
+void MainBench::testUDPBatch()
+{
+    // Remote sink to remote input link over loopback: frames of 128 datagrams plus 8 FEC blocks.
+    const int nbBlocksPerFrame = RemoteNbOrginalBlocks + 8;
+    const int samplesPerFrame = RemoteNbOrginalBlocks * (RemoteNbBytesPerBlock / sizeof(Sample));
+    const int nbFrames = (m_parser.getNbSamples() + samplesPerFrame - 1) / samplesPerFrame;
+    const quint16 port = 9099;
+    std::vector<RemoteSuperBlock> frame(nbBlocksPerFrame);
+
+    qDebug() << "MainBench::testUDPBatch: run test:" << nbFrames << "frames of" << nbBlocksPerFrame << "datagrams";
+
+    for (int batching = 1; batching >= 0; batching--)
+    {
+        if (batching && !UDPBatchSocket::hasBatching())
+        {
+            qInfo("MainBench::testUDPBatch: no batched system calls on this system");
+            continue;
+        }
+
+        UDPBatchSocket receiver;
+        UDPBatchSocket sender;
+        receiver.setBatching(batching != 0);
+        sender.setBatching(batching != 0);
+
+        if (!receiver.bind(QHostAddress(QHostAddress::LocalHost), port))
+        {
+            qWarning("MainBench::testUDPBatch: cannot bind port %u", port);
+            return;
+        }
+
+        receiver.setBufferSizes(0, 8<<20);
+        qint64 nsecs = 0;
+        qint64 nbSent = 0;
+        qint64 nbReceived = 0;
+
+        for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+        {
+            qint64 nbExpected = (qint64) nbFrames * nbBlocksPerFrame;
+            qint64 nbThisRun = 0;
+            QElapsedTimer timer;
+            timer.start();
+
+            std::thread receiverThread([&]() {
+                std::vector<char> buffer(UDPBatchSocket::m_maxBatchSize * RemoteUdpSize);
+
+                while (nbThisRun < nbExpected)
+                {
+                    int nb = receiver.receive(buffer.data(), RemoteUdpSize, UDPBatchSocket::m_maxBatchSize, 100);
+
+                    if (nb <= 0) { // lost the end of the stream
+                        break;
+                    }
+
+                    nbThisRun += nb;
+                }
+            });
+
+            for (int f = 0; f < nbFrames; f++)
+            {
+                for (int i = 0; i < nbBlocksPerFrame; i++)
+                {
+                    frame[i].m_header.m_frameIndex = f;
+                    frame[i].m_header.m_blockIndex = i;
+                }
+
+                int nb = sender.send((const char*) frame.data(), RemoteUdpSize, nbBlocksPerFrame, QHostAddress(QHostAddress::LocalHost), port);
+                nbSent += nb < 0 ? 0 : nb;
+            }
+
+            receiverThread.join();
+            nsecs += timer.nsecsElapsed();
+            nbReceived += nbThisRun;
+        }
+
+        printResults(tr("MainBench::testUDPBatch: %1").arg(batching ? "sendmmsg/recvmmsg" : "sendto/recvfrom"), nsecs);
+        qInfo("MainBench::testUDPBatch: sent %lld received %lld datagrams (%.2f%% lost) system calls: send %llu receive %llu",
+            nbSent, nbReceived, nbSent == 0 ? 0.0 : ((nbSent - nbReceived) * 100.0) / nbSent,
+            sender.getNbSystemCalls(), receiver.getNbSystemCalls());
+    }
+}
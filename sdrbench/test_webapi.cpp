@@ -0,0 +1,321 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2019 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+// (at your option) any later version.                                           //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <algorithm>
+#include <numeric>
+#include <regex>
+#include <thread>
+#include <vector>
+
+#include "httplistener.h"
+#include "httplistenersettings.h"
+#include "webapi/webapiadapterinterface.h"
+#include "webapi/webapirequestmapper.h"
+#include "webapi/webapirouter.h"
+#include "SWGChannelReport.h"
+#include "SWGNFMDemodReport.h"
+#include "SWGErrorResponse.h"
+#include "mainbench.h"
+
+namespace {
+
+// device set paths as they were matched by WebAPIRequestMapper before the router
+const std::regex devicesetURLRe("^/sdrangel/deviceset/([0-9]{1,2})$");
+const std::regex devicesetFocusURLRe("^/sdrangel/deviceset/([0-9]{1,2})/focus$");
+const std::regex devicesetDeviceURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device$");
+const std::regex devicesetDeviceSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/settings$");
+const std::regex devicesetDeviceRunURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/run");
+const std::regex devicesetDeviceReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/report$");
+const std::regex devicesetChannelsReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channels/report$");
+const std::regex devicesetSpectrumSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/settings$");
+const std::regex devicesetSpectrumServerURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum/server$");
+const std::regex devicesetChannelURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel$");
+const std::regex devicesetChannelIndexURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})$");
+const std::regex devicesetChannelSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/settings$");
+const std::regex devicesetChannelReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})/report");
+
+/** Answers channel report polls with a NFM demodulator report as the plugin does */
+class WebAPIAdapterBench : public WebAPIAdapterInterface
+{
+public:
+    virtual int devicesetChannelReportGet(
+            int deviceSetIndex,
+            int channelIndex,
+            SWGSDRangel::SWGChannelReport& response,
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        (void) error;
+        response.setChannelType(new QString("NFMDemod"));
+        response.setDirection(0);
+        response.setNfmDemodReport(new SWGSDRangel::SWGNFMDemodReport());
+        response.getNfmDemodReport()->init();
+        response.getNfmDemodReport()->setChannelPowerDb(-40.0f - deviceSetIndex - channelIndex);
+        response.getNfmDemodReport()->setCtcssTone(0.0f);
+        response.getNfmDemodReport()->setSquelch(1);
+        response.getNfmDemodReport()->setAudioSampleRate(48000);
+        response.getNfmDemodReport()->setChannelSampleRate(48000);
+        return 200;
+    }
+};
+
+/** Read one response with a Content-Length header. Returns the HTTP status or 0 on error */
+int readHttpResponse(QTcpSocket& socket, QByteArray& buffer)
+{
+    int headerEnd;
+
+    while ((headerEnd = buffer.indexOf("\r\n\r\n")) < 0)
+    {
+        if (!socket.waitForReadyRead(1000)) {
+            return 0;
+        }
+
+        buffer.append(socket.readAll());
+    }
+
+    int lengthPos = buffer.indexOf("Content-Length:");
+
+    if ((lengthPos < 0) || (lengthPos > headerEnd)) {
+        return 0;
+    }
+
+    int lengthEnd = buffer.indexOf("\r\n", lengthPos);
+    int contentLength = buffer.mid(lengthPos + 15, lengthEnd - lengthPos - 15).trimmed().toInt();
+    int responseSize = headerEnd + 4 + contentLength;
+
+    while (buffer.size() < responseSize)
+    {
+        if (!socket.waitForReadyRead(1000)) {
+            return 0;
+        }
+
+        buffer.append(socket.readAll());
+    }
+
+    int status = buffer.mid(9, 3).toInt(); // HTTP/1.1 nnn
+    buffer.remove(0, responseSize);
+    return status;
+}
+
+}
+
+void MainBench::testWebAPI()
+{
+    // Mix of paths of a monitoring client: mostly channel report polls across device sets
+    const QByteArray paths[] = {
+        "/sdrangel/deviceset/0/channel/0/report",
+        "/sdrangel/deviceset/0/channel/1/report",
+        "/sdrangel/deviceset/1/channel/0/report",
+        "/sdrangel/deviceset/1/channel/2/report",
+        "/sdrangel/deviceset/0/device/report",
+        "/sdrangel/deviceset/1/channels/report",
+        "/sdrangel/deviceset/0/channel/1/settings",
+        "/sdrangel"
+    };
+    const unsigned int nbPaths = sizeof(paths) / sizeof(paths[0]);
+    const unsigned int nbLookups = m_parser.getNbSamples();
+    unsigned int checksum = 0;
+
+    qDebug() << "MainBench::testWebAPI: route matching";
+
+    // the previous WebAPIRequestMapper::service: string comparisons then regular expressions in sequence
+    const QString *urls[] = {
+        &WebAPIAdapterInterface::instanceSummaryURL,
+        &WebAPIAdapterInterface::instanceDevicesURL,
+        &WebAPIAdapterInterface::instanceChannelsURL,
+        &WebAPIAdapterInterface::instanceLoggingURL,
+        &WebAPIAdapterInterface::instanceAudioURL,
+        &WebAPIAdapterInterface::instanceAudioInputParametersURL,
+        &WebAPIAdapterInterface::instanceAudioOutputParametersURL,
+        &WebAPIAdapterInterface::instanceAudioInputCleanupURL,
+        &WebAPIAdapterInterface::instanceAudioOutputCleanupURL,
+        &WebAPIAdapterInterface::instanceLocationURL,
+        &WebAPIAdapterInterface::instanceDVSerialURL,
+        &WebAPIAdapterInterface::instancePresetsURL,
+        &WebAPIAdapterInterface::instancePresetURL,
+        &WebAPIAdapterInterface::instancePresetFileURL,
+        &WebAPIAdapterInterface::instanceDeviceSetsURL,
+        &WebAPIAdapterInterface::instanceDeviceSetURL,
+        &WebAPIAdapterInterface::instanceProfilingURL,
+        &WebAPIAdapterInterface::instanceProfilingMetricsURL
+    };
+    const std::regex *regexes[] = {
+        &devicesetURLRe,
+        &devicesetDeviceURLRe,
+        &devicesetFocusURLRe,
+        &devicesetDeviceSettingsURLRe,
+        &devicesetDeviceRunURLRe,
+        &devicesetDeviceReportURLRe,
+        &devicesetChannelsReportURLRe,
+        &devicesetSpectrumSettingsURLRe,
+        &devicesetSpectrumServerURLRe,
+        &devicesetChannelURLRe,
+        &devicesetChannelIndexURLRe,
+        &devicesetChannelSettingsURLRe,
+        &devicesetChannelReportURLRe
+    };
+    const unsigned int nbURLs = sizeof(urls) / sizeof(urls[0]);
+    const unsigned int nbRegexes = sizeof(regexes) / sizeof(regexes[0]);
+
+    runTimed("MainBench::testWebAPI: route regex", nbLookups, m_parser.getBlockSize(),
+        [&](unsigned int offset, unsigned int count) {
+            for (unsigned int i = offset; i < offset + count; i++)
+            {
+                const QByteArray& path = paths[i % nbPaths];
+                unsigned int route = 0;
+
+                for (; route < nbURLs; route++)
+                {
+                    if (path == *urls[route]) {
+                        break;
+                    }
+                }
+
+                if (route == nbURLs)
+                {
+                    std::smatch match;
+                    std::string pathStr(path.constData(), path.length());
+
+                    for (unsigned int r = 0; r < nbRegexes; r++, route++)
+                    {
+                        if (std::regex_match(pathStr, match, *regexes[r]))
+                        {
+                            route += std::stoi(std::string(match[1]));
+                            break;
+                        }
+                    }
+                }
+
+                checksum += route;
+            }
+        }
+    );
+
+    WebAPIRouter router;
+    const char *patterns[] = {
+        "/sdrangel/deviceset/{int}",
+        "/sdrangel/deviceset/{int}/device",
+        "/sdrangel/deviceset/{int}/focus",
+        "/sdrangel/deviceset/{int}/device/settings",
+        "/sdrangel/deviceset/{int}/device/run",
+        "/sdrangel/deviceset/{int}/device/report",
+        "/sdrangel/deviceset/{int}/channels/report",
+        "/sdrangel/deviceset/{int}/spectrum/settings",
+        "/sdrangel/deviceset/{int}/spectrum/server",
+        "/sdrangel/deviceset/{int}/channel",
+        "/sdrangel/deviceset/{int}/channel/{int}",
+        "/sdrangel/deviceset/{int}/channel/{int}/settings",
+        "/sdrangel/deviceset/{int}/channel/{int}/report"
+    };
+
+    for (unsigned int i = 0; i < nbURLs; i++) {
+        router.addRoute(urls[i]->toLatin1(), i);
+    }
+
+    for (unsigned int i = 0; i < nbRegexes; i++) {
+        router.addRoute(patterns[i], nbURLs + i);
+    }
+
+    runTimed("MainBench::testWebAPI: route trie", nbLookups, m_parser.getBlockSize(),
+        [&](unsigned int offset, unsigned int count) {
+            int captures[WebAPIRouter::m_maxCaptures];
+
+            for (unsigned int i = offset; i < offset + count; i++)
+            {
+                int route = router.match(paths[i % nbPaths], captures);
+                checksum += route < (int) nbURLs ? route : route + captures[0];
+            }
+        }
+    );
+
+    qDebug() << "MainBench::testWebAPI: checksum:" << checksum;
+
+    // Keep-alive GET polls of channel reports on the loopback interface
+    const unsigned int nbRequests = std::max(1U, m_parser.getNbSamples() / 100);
+    qtwebapp::HttpListenerSettings listenerSettings;
+    listenerSettings.host = "127.0.0.1";
+    listenerSettings.port = 9098;
+    WebAPIAdapterBench adapter;
+    WebAPIRequestMapper requestMapper;
+    requestMapper.setAdapter(&adapter);
+    qtwebapp::HttpListener listener(listenerSettings, &requestMapper);
+
+    if (!listener.isListening())
+    {
+        qWarning("MainBench::testWebAPI: cannot listen on port %d", listenerSettings.port);
+        return;
+    }
+
+    qDebug() << "MainBench::testWebAPI: run test:" << nbRequests << "requests";
+    std::vector<qint64> requestNsecs;
+    requestNsecs.reserve(nbRequests * m_parser.getRepetition());
+    unsigned int nbFailed = 0;
+
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        QEventLoop loop; // the listener accepts connections from the event loop
+
+        std::thread clientThread([&]() {
+            QTcpSocket socket;
+            QByteArray buffer;
+            QElapsedTimer timer;
+            socket.connectToHost(QHostAddress(QHostAddress::LocalHost), listenerSettings.port);
+
+            if (socket.waitForConnected(1000))
+            {
+                for (unsigned int i = 0; i < nbRequests; i++)
+                {
+                    QByteArray request = "GET " + paths[i % 4] + " HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n";
+                    timer.start();
+                    socket.write(request);
+
+                    if (readHttpResponse(socket, buffer) != 200)
+                    {
+                        nbFailed++;
+                        break;
+                    }
+
+                    requestNsecs.push_back(timer.nsecsElapsed());
+                }
+
+                socket.disconnectFromHost();
+            }
+            else
+            {
+                nbFailed++;
+            }
+
+            QMetaObject::invokeMethod(&loop, "quit", Qt::QueuedConnection);
+        });
+
+        loop.exec();
+        clientThread.join();
+    }
+
+    if (nbFailed != 0) {
+        qWarning("MainBench::testWebAPI: %u connections failed", nbFailed);
+    }
+
+    addResult("MainBench::testWebAPI: channel report GET", requestNsecs.size(), 1, requestNsecs);
+    qInfo("MainBench::testWebAPI: %.0f requests/s", requestNsecs.size() == 0 ? 0.0 :
+        (requestNsecs.size() * 1e9) / std::accumulate(requestNsecs.begin(), requestNsecs.end(), (qint64) 0));
+}
@@ -60,9 +60,12 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspdevicemimoengine.h"
+#include "dsp/fftengine.h"
+#include "dsp/hbfilterkernels.h"
 #include "plugin/pluginapi.h"
 #include "gui/glspectrum.h"
 #include "gui/glspectrumgui.h"
+#include "util/cpufeatures.h"
 #include "loggerwithfile.h"
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
@@ -122,6 +125,18 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
     splash->showStatusMessage("starting...", Qt::white);
 
 	m_settings.setAudioDeviceManager(m_dspEngine->getAudioDeviceManager());
+    m_dspEngine->setBlockChannelizer(parser.getBlockChannelizer());
+    m_dspEngine->setPFBLog2NbSubbands(parser.getPFBLog2NbSubbands());
+
+    parser.applyRecordConfig();
+
+    FFTEngine::loadWisdom();
+
+    if (parser.getFFTWPrePlan())
+    {
+        FFTEngine::prePlan(6, 14);
+        FFTEngine::saveWisdom();
+    }
 
 	ui->setupUi(this);
 	createStatusBar();
@@ -231,6 +246,7 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 	m_apiHost = parser.getServerAddress();
 	m_apiPort = parser.getServerPort();
 	m_apiServer = new WebAPIServer(m_apiHost, m_apiPort, m_requestMapper);
+	m_apiServer->setReportsPort(parser.getReportsPort());
 	m_apiServer->start();
 
 	m_commandKeyReceiver = new CommandKeyReceiver();
@@ -252,6 +268,7 @@ MainWindow::~MainWindow()
     delete m_apiAdapter;
 
     delete m_pluginManager;
+    FFTEngine::saveWisdom();
 	delete m_dateTimeWidget;
 	delete m_showSystemWidget;
 
@@ -2056,6 +2073,9 @@ void MainWindow::setLoggingOptions()
                 .arg(qApp->applicationPid()));
  #endif
         m_logger->logToFile(QtInfoMsg, appInfoStr);
+        m_logger->logToFile(QtInfoMsg, tr("CPU features: %1 half-band filter kernel: %2")
+                .arg(CPUFeatures::getDescription())
+                .arg(HBFilterKernels::getKernelName(HBFilterKernels::getKernel())));
     }
 }
 
@@ -32,9 +32,13 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/filerecord.h"
+#include "dsp/spectrumvis.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "channel/channelapi.h"
+#include "util/profiler.h"
+#include "webapi/webapiprofiling.h"
 
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGInstanceDevicesResponse.h"
@@ -52,9 +56,13 @@
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
+#include "SWGFileRecordReport.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
+#include "SWGGLSpectrum.h"
+#include "SWGSpectrumServer.h"
+#include "SWGProfilingReport.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
@@ -885,6 +893,34 @@ int WebAPIAdapterGUI::instancePresetDelete(
     return 202;
 }
 
+int WebAPIAdapterGUI::instanceProfilingGet(
+        SWGSDRangel::SWGProfilingReport& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    std::vector<DeviceAPI*> deviceAPIs;
+
+    for (unsigned int i = 0; i < m_mainWindow.m_deviceUIs.size(); i++) {
+        deviceAPIs.push_back(m_mainWindow.m_deviceUIs[i]->m_deviceAPI);
+    }
+
+    WebAPIProfiling::getReport(deviceAPIs, response);
+    return 200;
+}
+
+int WebAPIAdapterGUI::instanceProfilingDelete(
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    Profiler::instance().reset();
+
+    response.init();
+    *response.getMessage() = QString("Profiling counters reset");
+
+    return 200;
+}
+
 int WebAPIAdapterGUI::instanceDeviceSetsGet(
         SWGSDRangel::SWGDeviceSetList& response,
         SWGSDRangel::SWGErrorResponse& error)
@@ -1306,7 +1342,18 @@ int WebAPIAdapterGUI::devicesetDeviceReportGet(
             response.setDeviceHwType(new QString(deviceSet->m_deviceAPI->getHardwareId()));
             response.setDirection(0);
             DeviceSampleSource *source = deviceSet->m_deviceAPI->getSampleSource();
-            return source->webapiReportGet(response, *error.getMessage());
+            int httpRC = source->webapiReportGet(response, *error.getMessage());
+            const FileRecord *fileRecord = source->getFileRecord();
+
+            if (fileRecord && ((httpRC/100 == 2) || (httpRC == 501))) // the recorder status is available even if the device has no report
+            {
+                response.setFileRecordReport(new SWGSDRangel::SWGFileRecordReport());
+                fileRecord->webapiFormatReport(*response.getFileRecordReport());
+                error.getMessage()->clear();
+                httpRC = 200;
+            }
+
+            return httpRC;
         }
         else if (deviceSet->m_deviceSinkEngine) // Single Tx
         {
@@ -1349,6 +1396,82 @@ int WebAPIAdapterGUI::devicesetChannelsReportGet(
     }
 }
 
+int WebAPIAdapterGUI::devicesetSpectrumSettingsGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGGLSpectrum& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        return deviceSet->m_spectrumVis->webapiSpectrumSettingsGet(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumServerGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumServer& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        return deviceSet->m_spectrumVis->webapiSpectrumServerGet(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumServerPost(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumServer& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        return deviceSet->m_spectrumVis->webapiSpectrumServerPost(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterGUI::devicesetSpectrumServerDelete(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumServer& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainWindow.m_deviceUIs.size()))
+    {
+        DeviceUISet *deviceSet = m_mainWindow.m_deviceUIs[deviceSetIndex];
+        return deviceSet->m_spectrumVis->webapiSpectrumServerDelete(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
 int WebAPIAdapterGUI::devicesetChannelPost(
             int deviceSetIndex,
             SWGSDRangel::SWGChannelSettings& query,
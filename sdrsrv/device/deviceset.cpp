@@ -17,6 +17,7 @@
 
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/spectrumengine.h"
 #include "plugin/pluginapi.h"
 #include "plugin/plugininterface.h"
 #include "settings/preset.h"
@@ -54,11 +55,13 @@ DeviceSet::DeviceSet(int tabIndex)
     m_deviceSourceEngine = nullptr;
     m_deviceSinkEngine = nullptr;
     m_deviceMIMOEngine = nullptr;
+    m_spectrumEngine = nullptr;
     m_deviceTabIndex = tabIndex;
 }
 
 DeviceSet::~DeviceSet()
 {
+    delete m_spectrumEngine;
 }
 
 void DeviceSet::registerRxChannelInstance(const QString& channelName, ChannelAPI* channelAPI)
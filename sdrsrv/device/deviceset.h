@@ -24,6 +24,7 @@ class DeviceAPI;
 class DSPDeviceSourceEngine;
 class DSPDeviceSinkEngine;
 class DSPDeviceMIMOEngine;
+class SpectrumEngine;
 class PluginAPI;
 class ChannelAPI;
 class Preset;
@@ -35,6 +36,7 @@ public:
     DSPDeviceSourceEngine *m_deviceSourceEngine;
     DSPDeviceSinkEngine *m_deviceSinkEngine;
     DSPDeviceMIMOEngine *m_deviceMIMOEngine;
+    SpectrumEngine *m_spectrumEngine;
 
     DeviceSet(int tabIndex);
     ~DeviceSet();
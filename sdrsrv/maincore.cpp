@@ -24,10 +24,14 @@
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/fftengine.h"
+#include "dsp/hbfilterkernels.h"
+#include "dsp/spectrumengine.h"
 #include "device/deviceapi.h"
 #include "device/deviceset.h"
 #include "device/deviceenumerator.h"
 #include "plugin/pluginmanager.h"
+#include "util/cpufeatures.h"
 #include "loggerwithfile.h"
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
@@ -59,6 +63,18 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
 
     m_instance = this;
     m_settings.setAudioDeviceManager(m_dspEngine->getAudioDeviceManager());
+    m_dspEngine->setBlockChannelizer(parser.getBlockChannelizer());
+    m_dspEngine->setPFBLog2NbSubbands(parser.getPFBLog2NbSubbands());
+
+    parser.applyRecordConfig();
+
+    FFTEngine::loadWisdom();
+
+    if (parser.getFFTWPrePlan())
+    {
+        FFTEngine::prePlan(6, 14);
+        FFTEngine::saveWisdom();
+    }
 
     m_pluginManager = new PluginManager(this);
     m_pluginManager->loadPlugins(QString("pluginssrv"));
@@ -74,6 +90,7 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_requestMapper = new WebAPIRequestMapper(this);
     m_requestMapper->setAdapter(m_apiAdapter);
     m_apiServer = new WebAPIServer(parser.getServerAddress(), parser.getServerPort(), m_requestMapper);
+    m_apiServer->setReportsPort(parser.getReportsPort());
     m_apiServer->start();
 
     m_dspEngine->setMIMOSupport(parser.getMIMOSupport());
@@ -89,6 +106,7 @@ MainCore::~MainCore()
 
 	m_apiServer->stop();
 	m_settings.save();
+    FFTEngine::saveWisdom();
     delete m_apiServer;
     delete m_requestMapper;
     delete m_apiAdapter;
@@ -251,6 +269,9 @@ void MainCore::setLoggingOptions()
                 .arg(QCoreApplication::applicationPid());
  #endif
         m_logger->logToFile(QtInfoMsg, appInfoStr);
+        m_logger->logToFile(QtInfoMsg, tr("CPU features: %1 half-band filter kernel: %2")
+                .arg(CPUFeatures::getDescription())
+                .arg(HBFilterKernels::getKernelName(HBFilterKernels::getKernel())));
     }
 }
 
@@ -266,7 +287,10 @@ void MainCore::addSinkDevice()
     int deviceTabIndex = m_deviceSets.size();
     m_deviceSets.push_back(new DeviceSet(deviceTabIndex));
     m_deviceSets.back()->m_deviceSourceEngine = 0;
+    m_deviceSets.back()->m_deviceSinkEngine = dspDeviceSinkEngine;
     m_deviceSets.back()->m_deviceMIMOEngine = 0;
+    m_deviceSets.back()->m_spectrumEngine = new SpectrumEngine(SDR_TX_SCALEF);
+    dspDeviceSinkEngine->addSpectrumSink(m_deviceSets.back()->m_spectrumEngine);
 
     char tabNameCStr[16];
     sprintf(tabNameCStr, "T%d", deviceTabIndex);
@@ -313,6 +337,8 @@ void MainCore::addSourceDevice()
     m_deviceSets.back()->m_deviceSourceEngine = dspDeviceSourceEngine;
     m_deviceSets.back()->m_deviceSinkEngine = 0;
     m_deviceSets.back()->m_deviceMIMOEngine = 0;
+    m_deviceSets.back()->m_spectrumEngine = new SpectrumEngine(SDR_RX_SCALEF);
+    dspDeviceSourceEngine->addSink(m_deviceSets.back()->m_spectrumEngine);
 
     char tabNameCStr[16];
     sprintf(tabNameCStr, "R%d", deviceTabIndex);
@@ -350,6 +376,7 @@ void MainCore::removeLastDevice()
     {
         DSPDeviceSourceEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSourceEngine;
         lastDeviceEngine->stopAcquistion();
+        lastDeviceEngine->removeSink(m_deviceSets.back()->m_spectrumEngine);
 
         // deletes old UI and input object
         m_deviceSets.back()->freeRxChannels();      // destroys the channel instances
@@ -370,6 +397,7 @@ void MainCore::removeLastDevice()
     {
         DSPDeviceSinkEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSinkEngine;
         lastDeviceEngine->stopGeneration();
+        lastDeviceEngine->removeSpectrumSink(m_deviceSets.back()->m_spectrumEngine);
 
         // deletes old UI and output object
         m_deviceSets.back()->freeTxChannels();
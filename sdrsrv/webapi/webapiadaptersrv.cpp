@@ -41,6 +41,10 @@
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
+#include "SWGFileRecordReport.h"
+#include "SWGGLSpectrum.h"
+#include "SWGSpectrumServer.h"
+#include "SWGProfilingReport.h"
 
 #include "maincore.h"
 #include "loggerwithfile.h"
@@ -52,7 +56,11 @@
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/filerecord.h"
+#include "dsp/spectrumengine.h"
 #include "channel/channelapi.h"
+#include "util/profiler.h"
+#include "webapi/webapiprofiling.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "webapiadaptersrv.h"
@@ -988,6 +996,34 @@ int WebAPIAdapterSrv::instancePresetDelete(
     return 202;
 }
 
+int WebAPIAdapterSrv::instanceProfilingGet(
+        SWGSDRangel::SWGProfilingReport& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    std::vector<DeviceAPI*> deviceAPIs;
+
+    for (unsigned int i = 0; i < m_mainCore.m_deviceSets.size(); i++) {
+        deviceAPIs.push_back(m_mainCore.m_deviceSets[i]->m_deviceAPI);
+    }
+
+    WebAPIProfiling::getReport(deviceAPIs, response);
+    return 200;
+}
+
+int WebAPIAdapterSrv::instanceProfilingDelete(
+        SWGSDRangel::SWGSuccessResponse& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    (void) error;
+    Profiler::instance().reset();
+
+    response.init();
+    *response.getMessage() = QString("Profiling counters reset");
+
+    return 200;
+}
+
 int WebAPIAdapterSrv::instanceDeviceSetsGet(
         SWGSDRangel::SWGDeviceSetList& response,
         SWGSDRangel::SWGErrorResponse& error)
@@ -1391,7 +1427,18 @@ int WebAPIAdapterSrv::devicesetDeviceReportGet(
             response.setDeviceHwType(new QString(deviceSet->m_deviceAPI->getHardwareId()));
             response.setDirection(0);
             DeviceSampleSource *source = deviceSet->m_deviceAPI->getSampleSource();
-            return source->webapiReportGet(response, *error.getMessage());
+            int httpRC = source->webapiReportGet(response, *error.getMessage());
+            const FileRecord *fileRecord = source->getFileRecord();
+
+            if (fileRecord && ((httpRC/100 == 2) || (httpRC == 501))) // the recorder status is available even if the device has no report
+            {
+                response.setFileRecordReport(new SWGSDRangel::SWGFileRecordReport());
+                fileRecord->webapiFormatReport(*response.getFileRecordReport());
+                error.getMessage()->clear();
+                httpRC = 200;
+            }
+
+            return httpRC;
         }
         else if (deviceSet->m_deviceSinkEngine) // Single Tx
         {
@@ -1434,6 +1481,138 @@ int WebAPIAdapterSrv::devicesetChannelsReportGet(
     }
 }
 
+int WebAPIAdapterSrv::devicesetSpectrumSettingsGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGGLSpectrum& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (!deviceSet->m_spectrumEngine)
+        {
+            *error.getMessage() = QString("Device set %1 has no spectrum").arg(deviceSetIndex);
+            return 404;
+        }
+
+        return deviceSet->m_spectrumEngine->webapiSpectrumSettingsGet(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumSettingsPutPatch(
+        int deviceSetIndex,
+        bool force,
+        const QStringList& spectrumSettingsKeys,
+        SWGSDRangel::SWGGLSpectrum& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (!deviceSet->m_spectrumEngine)
+        {
+            *error.getMessage() = QString("Device set %1 has no spectrum").arg(deviceSetIndex);
+            return 404;
+        }
+
+        return deviceSet->m_spectrumEngine->webapiSpectrumSettingsPutPatch(force, spectrumSettingsKeys, response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumServerGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumServer& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (!deviceSet->m_spectrumEngine)
+        {
+            *error.getMessage() = QString("Device set %1 has no spectrum").arg(deviceSetIndex);
+            return 404;
+        }
+
+        return deviceSet->m_spectrumEngine->webapiSpectrumServerGet(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumServerPost(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumServer& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (!deviceSet->m_spectrumEngine)
+        {
+            *error.getMessage() = QString("Device set %1 has no spectrum").arg(deviceSetIndex);
+            return 404;
+        }
+
+        return deviceSet->m_spectrumEngine->webapiSpectrumServerPost(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
+int WebAPIAdapterSrv::devicesetSpectrumServerDelete(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumServer& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (!deviceSet->m_spectrumEngine)
+        {
+            *error.getMessage() = QString("Device set %1 has no spectrum").arg(deviceSetIndex);
+            return 404;
+        }
+
+        return deviceSet->m_spectrumEngine->webapiSpectrumServerDelete(response, *error.getMessage());
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
 int WebAPIAdapterSrv::devicesetChannelPost(
             int deviceSetIndex,
             SWGSDRangel::SWGChannelSettings& query,
@@ -0,0 +1,183 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGChannelProfiling.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGChannelProfiling::SWGChannelProfiling(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGChannelProfiling::SWGChannelProfiling() {
+    index = 0;
+    m_index_isSet = false;
+    id = nullptr;
+    m_id_isSet = false;
+    stages = nullptr;
+    m_stages_isSet = false;
+    fifos = nullptr;
+    m_fifos_isSet = false;
+}
+
+SWGChannelProfiling::~SWGChannelProfiling() {
+    this->cleanup();
+}
+
+void
+SWGChannelProfiling::init() {
+    index = 0;
+    m_index_isSet = false;
+    id = new QString("");
+    m_id_isSet = false;
+    stages = new QList<SWGProfilingStage*>();
+    m_stages_isSet = false;
+    fifos = new QList<SWGProfilingFifo*>();
+    m_fifos_isSet = false;
+}
+
+void
+SWGChannelProfiling::cleanup() {
+
+    if(id != nullptr) { 
+        delete id;
+    }
+    if(stages != nullptr) { 
+        auto arr = stages;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete stages;
+    }
+    if(fifos != nullptr) { 
+        auto arr = fifos;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete fifos;
+    }
+}
+
+SWGChannelProfiling*
+SWGChannelProfiling::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGChannelProfiling::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&index, pJson["index"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&id, pJson["id"], "QString", "QString");
+    
+    
+    ::SWGSDRangel::setValue(&stages, pJson["stages"], "QList", "SWGProfilingStage");
+    
+    ::SWGSDRangel::setValue(&fifos, pJson["fifos"], "QList", "SWGProfilingFifo");
+}
+
+QString
+SWGChannelProfiling::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGChannelProfiling::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_index_isSet){
+        obj->insert("index", QJsonValue(index));
+    }
+    if(id != nullptr && *id != QString("")){
+        toJsonValue(QString("id"), id, obj, QString("QString"));
+    }
+    if(stages->size() > 0){
+        toJsonArray((QList<void*>*)stages, obj, "stages", "SWGProfilingStage");
+    }
+    if(fifos->size() > 0){
+        toJsonArray((QList<void*>*)fifos, obj, "fifos", "SWGProfilingFifo");
+    }
+
+    return obj;
+}
+
+qint32
+SWGChannelProfiling::getIndex() {
+    return index;
+}
+void
+SWGChannelProfiling::setIndex(qint32 index) {
+    this->index = index;
+    this->m_index_isSet = true;
+}
+
+QString*
+SWGChannelProfiling::getId() {
+    return id;
+}
+void
+SWGChannelProfiling::setId(QString* id) {
+    this->id = id;
+    this->m_id_isSet = true;
+}
+
+QList<SWGProfilingStage*>*
+SWGChannelProfiling::getStages() {
+    return stages;
+}
+void
+SWGChannelProfiling::setStages(QList<SWGProfilingStage*>* stages) {
+    this->stages = stages;
+    this->m_stages_isSet = true;
+}
+
+QList<SWGProfilingFifo*>*
+SWGChannelProfiling::getFifos() {
+    return fifos;
+}
+void
+SWGChannelProfiling::setFifos(QList<SWGProfilingFifo*>* fifos) {
+    this->fifos = fifos;
+    this->m_fifos_isSet = true;
+}
+
+
+bool
+SWGChannelProfiling::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_index_isSet){ isObjectUpdated = true; break;}
+        if(id != nullptr && *id != QString("")){ isObjectUpdated = true; break;}
+        if(stages->size() > 0){ isObjectUpdated = true; break;}
+        if(fifos->size() > 0){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
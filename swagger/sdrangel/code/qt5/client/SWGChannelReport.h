@@ -26,6 +26,7 @@
 #include "SWGAMModReport.h"
 #include "SWGATVModReport.h"
 #include "SWGBFMDemodReport.h"
+#include "SWGDATVDemodReport.h"
 #include "SWGDSDDemodReport.h"
 #include "SWGFileSourceReport.h"
 #include "SWGFreeDVDemodReport.h"
@@ -78,6 +79,9 @@ public:
     SWGBFMDemodReport* getBfmDemodReport();
     void setBfmDemodReport(SWGBFMDemodReport* bfm_demod_report);
 
+    SWGDATVDemodReport* getDatvDemodReport();
+    void setDatvDemodReport(SWGDATVDemodReport* datv_demod_report);
+
     SWGDSDDemodReport* getDsdDemodReport();
     void setDsdDemodReport(SWGDSDDemodReport* dsd_demod_report);
 
@@ -142,6 +146,9 @@ private:
     SWGBFMDemodReport* bfm_demod_report;
     bool m_bfm_demod_report_isSet;
 
+    SWGDATVDemodReport* datv_demod_report;
+    bool m_datv_demod_report_isSet;
+
     SWGDSDDemodReport* dsd_demod_report;
     bool m_dsd_demod_report_isSet;
 
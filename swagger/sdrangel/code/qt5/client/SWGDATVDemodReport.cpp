@@ -0,0 +1,175 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDATVDemodReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDATVDemodReport::SWGDATVDemodReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDATVDemodReport::SWGDATVDemodReport() {
+    channel_power_db = 0.0f;
+    m_channel_power_db_isSet = false;
+    channel_sample_rate = 0;
+    m_channel_sample_rate_isSet = false;
+    multi_thread = 0;
+    m_multi_thread_isSet = false;
+    runnables = nullptr;
+    m_runnables_isSet = false;
+}
+
+SWGDATVDemodReport::~SWGDATVDemodReport() {
+    this->cleanup();
+}
+
+void
+SWGDATVDemodReport::init() {
+    channel_power_db = 0.0f;
+    m_channel_power_db_isSet = false;
+    channel_sample_rate = 0;
+    m_channel_sample_rate_isSet = false;
+    multi_thread = 0;
+    m_multi_thread_isSet = false;
+    runnables = new QList<SWGDATVDemodRunnableReport*>();
+    m_runnables_isSet = false;
+}
+
+void
+SWGDATVDemodReport::cleanup() {
+
+
+
+    if(runnables != nullptr) { 
+        auto arr = runnables;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete runnables;
+    }
+}
+
+SWGDATVDemodReport*
+SWGDATVDemodReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDATVDemodReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&channel_power_db, pJson["channelPowerDB"], "float", "");
+    
+    ::SWGSDRangel::setValue(&channel_sample_rate, pJson["channelSampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&multi_thread, pJson["multiThread"], "qint32", "");
+    
+    
+    ::SWGSDRangel::setValue(&runnables, pJson["runnables"], "QList", "SWGDATVDemodRunnableReport");
+}
+
+QString
+SWGDATVDemodReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDATVDemodReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_channel_power_db_isSet){
+        obj->insert("channelPowerDB", QJsonValue(channel_power_db));
+    }
+    if(m_channel_sample_rate_isSet){
+        obj->insert("channelSampleRate", QJsonValue(channel_sample_rate));
+    }
+    if(m_multi_thread_isSet){
+        obj->insert("multiThread", QJsonValue(multi_thread));
+    }
+    if(runnables->size() > 0){
+        toJsonArray((QList<void*>*)runnables, obj, "runnables", "SWGDATVDemodRunnableReport");
+    }
+
+    return obj;
+}
+
+float
+SWGDATVDemodReport::getChannelPowerDb() {
+    return channel_power_db;
+}
+void
+SWGDATVDemodReport::setChannelPowerDb(float channel_power_db) {
+    this->channel_power_db = channel_power_db;
+    this->m_channel_power_db_isSet = true;
+}
+
+qint32
+SWGDATVDemodReport::getChannelSampleRate() {
+    return channel_sample_rate;
+}
+void
+SWGDATVDemodReport::setChannelSampleRate(qint32 channel_sample_rate) {
+    this->channel_sample_rate = channel_sample_rate;
+    this->m_channel_sample_rate_isSet = true;
+}
+
+qint32
+SWGDATVDemodReport::getMultiThread() {
+    return multi_thread;
+}
+void
+SWGDATVDemodReport::setMultiThread(qint32 multi_thread) {
+    this->multi_thread = multi_thread;
+    this->m_multi_thread_isSet = true;
+}
+
+QList<SWGDATVDemodRunnableReport*>*
+SWGDATVDemodReport::getRunnables() {
+    return runnables;
+}
+void
+SWGDATVDemodReport::setRunnables(QList<SWGDATVDemodRunnableReport*>* runnables) {
+    this->runnables = runnables;
+    this->m_runnables_isSet = true;
+}
+
+
+bool
+SWGDATVDemodReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_channel_power_db_isSet){ isObjectUpdated = true; break;}
+        if(m_channel_sample_rate_isSet){ isObjectUpdated = true; break;}
+        if(m_multi_thread_isSet){ isObjectUpdated = true; break;}
+        if(runnables->size() > 0){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,171 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDATVDemodRunnableReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDATVDemodRunnableReport::SWGDATVDemodRunnableReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDATVDemodRunnableReport::SWGDATVDemodRunnableReport() {
+    name = nullptr;
+    m_name_isSet = false;
+    group = 0;
+    m_group_isSet = false;
+    load = 0.0f;
+    m_load_isSet = false;
+    calls = 0L;
+    m_calls_isSet = false;
+}
+
+SWGDATVDemodRunnableReport::~SWGDATVDemodRunnableReport() {
+    this->cleanup();
+}
+
+void
+SWGDATVDemodRunnableReport::init() {
+    name = new QString("");
+    m_name_isSet = false;
+    group = 0;
+    m_group_isSet = false;
+    load = 0.0f;
+    m_load_isSet = false;
+    calls = 0L;
+    m_calls_isSet = false;
+}
+
+void
+SWGDATVDemodRunnableReport::cleanup() {
+    if(name != nullptr) { 
+        delete name;
+    }
+
+
+
+}
+
+SWGDATVDemodRunnableReport*
+SWGDATVDemodRunnableReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDATVDemodRunnableReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&name, pJson["name"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&group, pJson["group"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&load, pJson["load"], "float", "");
+    
+    ::SWGSDRangel::setValue(&calls, pJson["calls"], "qint64", "");
+    
+}
+
+QString
+SWGDATVDemodRunnableReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDATVDemodRunnableReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(name != nullptr && *name != QString("")){
+        toJsonValue(QString("name"), name, obj, QString("QString"));
+    }
+    if(m_group_isSet){
+        obj->insert("group", QJsonValue(group));
+    }
+    if(m_load_isSet){
+        obj->insert("load", QJsonValue(load));
+    }
+    if(m_calls_isSet){
+        obj->insert("calls", QJsonValue(calls));
+    }
+
+    return obj;
+}
+
+QString*
+SWGDATVDemodRunnableReport::getName() {
+    return name;
+}
+void
+SWGDATVDemodRunnableReport::setName(QString* name) {
+    this->name = name;
+    this->m_name_isSet = true;
+}
+
+qint32
+SWGDATVDemodRunnableReport::getGroup() {
+    return group;
+}
+void
+SWGDATVDemodRunnableReport::setGroup(qint32 group) {
+    this->group = group;
+    this->m_group_isSet = true;
+}
+
+float
+SWGDATVDemodRunnableReport::getLoad() {
+    return load;
+}
+void
+SWGDATVDemodRunnableReport::setLoad(float load) {
+    this->load = load;
+    this->m_load_isSet = true;
+}
+
+qint64
+SWGDATVDemodRunnableReport::getCalls() {
+    return calls;
+}
+void
+SWGDATVDemodRunnableReport::setCalls(qint64 calls) {
+    this->calls = calls;
+    this->m_calls_isSet = true;
+}
+
+
+bool
+SWGDATVDemodRunnableReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(name != nullptr && *name != QString("")){ isObjectUpdated = true; break;}
+        if(m_group_isSet){ isObjectUpdated = true; break;}
+        if(m_load_isSet){ isObjectUpdated = true; break;}
+        if(m_calls_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,187 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDeviceSetProfiling.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDeviceSetProfiling::SWGDeviceSetProfiling(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDeviceSetProfiling::SWGDeviceSetProfiling() {
+    index = 0;
+    m_index_isSet = false;
+    stages = nullptr;
+    m_stages_isSet = false;
+    fifos = nullptr;
+    m_fifos_isSet = false;
+    channels = nullptr;
+    m_channels_isSet = false;
+}
+
+SWGDeviceSetProfiling::~SWGDeviceSetProfiling() {
+    this->cleanup();
+}
+
+void
+SWGDeviceSetProfiling::init() {
+    index = 0;
+    m_index_isSet = false;
+    stages = new QList<SWGProfilingStage*>();
+    m_stages_isSet = false;
+    fifos = new QList<SWGProfilingFifo*>();
+    m_fifos_isSet = false;
+    channels = new QList<SWGChannelProfiling*>();
+    m_channels_isSet = false;
+}
+
+void
+SWGDeviceSetProfiling::cleanup() {
+
+    if(stages != nullptr) { 
+        auto arr = stages;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete stages;
+    }
+    if(fifos != nullptr) { 
+        auto arr = fifos;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete fifos;
+    }
+    if(channels != nullptr) { 
+        auto arr = channels;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete channels;
+    }
+}
+
+SWGDeviceSetProfiling*
+SWGDeviceSetProfiling::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDeviceSetProfiling::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&index, pJson["index"], "qint32", "");
+    
+    
+    ::SWGSDRangel::setValue(&stages, pJson["stages"], "QList", "SWGProfilingStage");
+    
+    ::SWGSDRangel::setValue(&fifos, pJson["fifos"], "QList", "SWGProfilingFifo");
+    
+    ::SWGSDRangel::setValue(&channels, pJson["channels"], "QList", "SWGChannelProfiling");
+}
+
+QString
+SWGDeviceSetProfiling::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDeviceSetProfiling::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_index_isSet){
+        obj->insert("index", QJsonValue(index));
+    }
+    if(stages->size() > 0){
+        toJsonArray((QList<void*>*)stages, obj, "stages", "SWGProfilingStage");
+    }
+    if(fifos->size() > 0){
+        toJsonArray((QList<void*>*)fifos, obj, "fifos", "SWGProfilingFifo");
+    }
+    if(channels->size() > 0){
+        toJsonArray((QList<void*>*)channels, obj, "channels", "SWGChannelProfiling");
+    }
+
+    return obj;
+}
+
+qint32
+SWGDeviceSetProfiling::getIndex() {
+    return index;
+}
+void
+SWGDeviceSetProfiling::setIndex(qint32 index) {
+    this->index = index;
+    this->m_index_isSet = true;
+}
+
+QList<SWGProfilingStage*>*
+SWGDeviceSetProfiling::getStages() {
+    return stages;
+}
+void
+SWGDeviceSetProfiling::setStages(QList<SWGProfilingStage*>* stages) {
+    this->stages = stages;
+    this->m_stages_isSet = true;
+}
+
+QList<SWGProfilingFifo*>*
+SWGDeviceSetProfiling::getFifos() {
+    return fifos;
+}
+void
+SWGDeviceSetProfiling::setFifos(QList<SWGProfilingFifo*>* fifos) {
+    this->fifos = fifos;
+    this->m_fifos_isSet = true;
+}
+
+QList<SWGChannelProfiling*>*
+SWGDeviceSetProfiling::getChannels() {
+    return channels;
+}
+void
+SWGDeviceSetProfiling::setChannels(QList<SWGChannelProfiling*>* channels) {
+    this->channels = channels;
+    this->m_channels_isSet = true;
+}
+
+
+bool
+SWGDeviceSetProfiling::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_index_isSet){ isObjectUpdated = true; break;}
+        if(stages->size() > 0){ isObjectUpdated = true; break;}
+        if(fifos->size() > 0){ isObjectUpdated = true; break;}
+        if(channels->size() > 0){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
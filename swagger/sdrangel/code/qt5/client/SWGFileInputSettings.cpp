@@ -34,6 +34,8 @@ SWGFileInputSettings::SWGFileInputSettings() {
     m_acceleration_factor_isSet = false;
     loop = 0;
     m_loop_isSet = false;
+    as_fast_as_possible = 0;
+    m_as_fast_as_possible_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = nullptr;
@@ -56,6 +58,8 @@ SWGFileInputSettings::init() {
     m_acceleration_factor_isSet = false;
     loop = 0;
     m_loop_isSet = false;
+    as_fast_as_possible = 0;
+    m_as_fast_as_possible_isSet = false;
     use_reverse_api = 0;
     m_use_reverse_api_isSet = false;
     reverse_api_address = new QString("");
@@ -74,6 +78,7 @@ SWGFileInputSettings::cleanup() {
 
 
 
+
     if(reverse_api_address != nullptr) { 
         delete reverse_api_address;
     }
@@ -98,6 +103,8 @@ SWGFileInputSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&loop, pJson["loop"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&as_fast_as_possible, pJson["asFastAsPossible"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&use_reverse_api, pJson["useReverseAPI"], "qint32", "");
     
     ::SWGSDRangel::setValue(&reverse_api_address, pJson["reverseAPIAddress"], "QString", "QString");
@@ -131,6 +138,9 @@ SWGFileInputSettings::asJsonObject() {
     if(m_loop_isSet){
         obj->insert("loop", QJsonValue(loop));
     }
+    if(m_as_fast_as_possible_isSet){
+        obj->insert("asFastAsPossible", QJsonValue(as_fast_as_possible));
+    }
     if(m_use_reverse_api_isSet){
         obj->insert("useReverseAPI", QJsonValue(use_reverse_api));
     }
@@ -177,6 +187,16 @@ SWGFileInputSettings::setLoop(qint32 loop) {
     this->m_loop_isSet = true;
 }
 
+qint32
+SWGFileInputSettings::getAsFastAsPossible() {
+    return as_fast_as_possible;
+}
+void
+SWGFileInputSettings::setAsFastAsPossible(qint32 as_fast_as_possible) {
+    this->as_fast_as_possible = as_fast_as_possible;
+    this->m_as_fast_as_possible_isSet = true;
+}
+
 qint32
 SWGFileInputSettings::getUseReverseApi() {
     return use_reverse_api;
@@ -225,6 +245,7 @@ SWGFileInputSettings::isSet(){
         if(file_name != nullptr && *file_name != QString("")){ isObjectUpdated = true; break;}
         if(m_acceleration_factor_isSet){ isObjectUpdated = true; break;}
         if(m_loop_isSet){ isObjectUpdated = true; break;}
+        if(m_as_fast_as_possible_isSet){ isObjectUpdated = true; break;}
         if(m_use_reverse_api_isSet){ isObjectUpdated = true; break;}
         if(reverse_api_address != nullptr && *reverse_api_address != QString("")){ isObjectUpdated = true; break;}
         if(m_reverse_api_port_isSet){ isObjectUpdated = true; break;}
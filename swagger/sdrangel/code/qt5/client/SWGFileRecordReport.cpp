@@ -0,0 +1,297 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGFileRecordReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFileRecordReport::SWGFileRecordReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFileRecordReport::SWGFileRecordReport() {
+    recording = 0;
+    m_recording_isSet = false;
+    file_name = nullptr;
+    m_file_name_isSet = false;
+    file_index = 0;
+    m_file_index_isSet = false;
+    file_byte_count = 0L;
+    m_file_byte_count_isSet = false;
+    total_byte_count = 0L;
+    m_total_byte_count_isSet = false;
+    overrun_count = 0;
+    m_overrun_count_isSet = false;
+    dropped_byte_count = 0L;
+    m_dropped_byte_count_isSet = false;
+    write_error_count = 0;
+    m_write_error_count_isSet = false;
+    queued_buffers = 0;
+    m_queued_buffers_isSet = false;
+    total_buffers = 0;
+    m_total_buffers_isSet = false;
+}
+
+SWGFileRecordReport::~SWGFileRecordReport() {
+    this->cleanup();
+}
+
+void
+SWGFileRecordReport::init() {
+    recording = 0;
+    m_recording_isSet = false;
+    file_name = new QString("");
+    m_file_name_isSet = false;
+    file_index = 0;
+    m_file_index_isSet = false;
+    file_byte_count = 0L;
+    m_file_byte_count_isSet = false;
+    total_byte_count = 0L;
+    m_total_byte_count_isSet = false;
+    overrun_count = 0;
+    m_overrun_count_isSet = false;
+    dropped_byte_count = 0L;
+    m_dropped_byte_count_isSet = false;
+    write_error_count = 0;
+    m_write_error_count_isSet = false;
+    queued_buffers = 0;
+    m_queued_buffers_isSet = false;
+    total_buffers = 0;
+    m_total_buffers_isSet = false;
+}
+
+void
+SWGFileRecordReport::cleanup() {
+
+    if(file_name != nullptr) { 
+        delete file_name;
+    }
+
+
+
+
+
+
+
+
+}
+
+SWGFileRecordReport*
+SWGFileRecordReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFileRecordReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&recording, pJson["recording"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&file_name, pJson["fileName"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&file_index, pJson["fileIndex"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&file_byte_count, pJson["fileByteCount"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&total_byte_count, pJson["totalByteCount"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&overrun_count, pJson["overrunCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&dropped_byte_count, pJson["droppedByteCount"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&write_error_count, pJson["writeErrorCount"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&queued_buffers, pJson["queuedBuffers"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&total_buffers, pJson["totalBuffers"], "qint32", "");
+    
+}
+
+QString
+SWGFileRecordReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFileRecordReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_recording_isSet){
+        obj->insert("recording", QJsonValue(recording));
+    }
+    if(file_name != nullptr && *file_name != QString("")){
+        toJsonValue(QString("fileName"), file_name, obj, QString("QString"));
+    }
+    if(m_file_index_isSet){
+        obj->insert("fileIndex", QJsonValue(file_index));
+    }
+    if(m_file_byte_count_isSet){
+        obj->insert("fileByteCount", QJsonValue(file_byte_count));
+    }
+    if(m_total_byte_count_isSet){
+        obj->insert("totalByteCount", QJsonValue(total_byte_count));
+    }
+    if(m_overrun_count_isSet){
+        obj->insert("overrunCount", QJsonValue(overrun_count));
+    }
+    if(m_dropped_byte_count_isSet){
+        obj->insert("droppedByteCount", QJsonValue(dropped_byte_count));
+    }
+    if(m_write_error_count_isSet){
+        obj->insert("writeErrorCount", QJsonValue(write_error_count));
+    }
+    if(m_queued_buffers_isSet){
+        obj->insert("queuedBuffers", QJsonValue(queued_buffers));
+    }
+    if(m_total_buffers_isSet){
+        obj->insert("totalBuffers", QJsonValue(total_buffers));
+    }
+
+    return obj;
+}
+
+qint32
+SWGFileRecordReport::getRecording() {
+    return recording;
+}
+void
+SWGFileRecordReport::setRecording(qint32 recording) {
+    this->recording = recording;
+    this->m_recording_isSet = true;
+}
+
+QString*
+SWGFileRecordReport::getFileName() {
+    return file_name;
+}
+void
+SWGFileRecordReport::setFileName(QString* file_name) {
+    this->file_name = file_name;
+    this->m_file_name_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getFileIndex() {
+    return file_index;
+}
+void
+SWGFileRecordReport::setFileIndex(qint32 file_index) {
+    this->file_index = file_index;
+    this->m_file_index_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getFileByteCount() {
+    return file_byte_count;
+}
+void
+SWGFileRecordReport::setFileByteCount(qint64 file_byte_count) {
+    this->file_byte_count = file_byte_count;
+    this->m_file_byte_count_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getTotalByteCount() {
+    return total_byte_count;
+}
+void
+SWGFileRecordReport::setTotalByteCount(qint64 total_byte_count) {
+    this->total_byte_count = total_byte_count;
+    this->m_total_byte_count_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getOverrunCount() {
+    return overrun_count;
+}
+void
+SWGFileRecordReport::setOverrunCount(qint32 overrun_count) {
+    this->overrun_count = overrun_count;
+    this->m_overrun_count_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getDroppedByteCount() {
+    return dropped_byte_count;
+}
+void
+SWGFileRecordReport::setDroppedByteCount(qint64 dropped_byte_count) {
+    this->dropped_byte_count = dropped_byte_count;
+    this->m_dropped_byte_count_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getWriteErrorCount() {
+    return write_error_count;
+}
+void
+SWGFileRecordReport::setWriteErrorCount(qint32 write_error_count) {
+    this->write_error_count = write_error_count;
+    this->m_write_error_count_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getQueuedBuffers() {
+    return queued_buffers;
+}
+void
+SWGFileRecordReport::setQueuedBuffers(qint32 queued_buffers) {
+    this->queued_buffers = queued_buffers;
+    this->m_queued_buffers_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getTotalBuffers() {
+    return total_buffers;
+}
+void
+SWGFileRecordReport::setTotalBuffers(qint32 total_buffers) {
+    this->total_buffers = total_buffers;
+    this->m_total_buffers_isSet = true;
+}
+
+
+bool
+SWGFileRecordReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_recording_isSet){ isObjectUpdated = true; break;}
+        if(file_name != nullptr && *file_name != QString("")){ isObjectUpdated = true; break;}
+        if(m_file_index_isSet){ isObjectUpdated = true; break;}
+        if(m_file_byte_count_isSet){ isObjectUpdated = true; break;}
+        if(m_total_byte_count_isSet){ isObjectUpdated = true; break;}
+        if(m_overrun_count_isSet){ isObjectUpdated = true; break;}
+        if(m_dropped_byte_count_isSet){ isObjectUpdated = true; break;}
+        if(m_write_error_count_isSet){ isObjectUpdated = true; break;}
+        if(m_queued_buffers_isSet){ isObjectUpdated = true; break;}
+        if(m_total_buffers_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
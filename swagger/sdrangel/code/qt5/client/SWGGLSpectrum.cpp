@@ -0,0 +1,318 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGGLSpectrum.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGGLSpectrum::SWGGLSpectrum(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGGLSpectrum::SWGGLSpectrum() {
+    fft_size = 0;
+    m_fft_size_isSet = false;
+    fft_overlap = 0;
+    m_fft_overlap_isSet = false;
+    fft_window = 0;
+    m_fft_window_isSet = false;
+    averaging_mode = 0;
+    m_averaging_mode_isSet = false;
+    averaging_value = 0;
+    m_averaging_value_isSet = false;
+    linear = 0;
+    m_linear_isSet = false;
+    ws_spectrum_address = nullptr;
+    m_ws_spectrum_address_isSet = false;
+    ws_spectrum_port = 0;
+    m_ws_spectrum_port_isSet = false;
+    stream_frame_rate = 0;
+    m_stream_frame_rate_isSet = false;
+    stream_ref_level = 0;
+    m_stream_ref_level_isSet = false;
+    stream_power_range = 0;
+    m_stream_power_range_isSet = false;
+}
+
+SWGGLSpectrum::~SWGGLSpectrum() {
+    this->cleanup();
+}
+
+void
+SWGGLSpectrum::init() {
+    fft_size = 0;
+    m_fft_size_isSet = false;
+    fft_overlap = 0;
+    m_fft_overlap_isSet = false;
+    fft_window = 0;
+    m_fft_window_isSet = false;
+    averaging_mode = 0;
+    m_averaging_mode_isSet = false;
+    averaging_value = 0;
+    m_averaging_value_isSet = false;
+    linear = 0;
+    m_linear_isSet = false;
+    ws_spectrum_address = new QString("");
+    m_ws_spectrum_address_isSet = false;
+    ws_spectrum_port = 0;
+    m_ws_spectrum_port_isSet = false;
+    stream_frame_rate = 0;
+    m_stream_frame_rate_isSet = false;
+    stream_ref_level = 0;
+    m_stream_ref_level_isSet = false;
+    stream_power_range = 0;
+    m_stream_power_range_isSet = false;
+}
+
+void
+SWGGLSpectrum::cleanup() {
+
+
+
+
+
+
+    if(ws_spectrum_address != nullptr) { 
+        delete ws_spectrum_address;
+    }
+
+
+
+
+}
+
+SWGGLSpectrum*
+SWGGLSpectrum::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGGLSpectrum::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&fft_size, pJson["fftSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&fft_overlap, pJson["fftOverlap"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&fft_window, pJson["fftWindow"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&averaging_mode, pJson["averagingMode"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&averaging_value, pJson["averagingValue"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&linear, pJson["linear"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&ws_spectrum_address, pJson["wsSpectrumAddress"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&ws_spectrum_port, pJson["wsSpectrumPort"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&stream_frame_rate, pJson["streamFrameRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&stream_ref_level, pJson["streamRefLevel"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&stream_power_range, pJson["streamPowerRange"], "qint32", "");
+    
+}
+
+QString
+SWGGLSpectrum::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGGLSpectrum::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_fft_size_isSet){
+        obj->insert("fftSize", QJsonValue(fft_size));
+    }
+    if(m_fft_overlap_isSet){
+        obj->insert("fftOverlap", QJsonValue(fft_overlap));
+    }
+    if(m_fft_window_isSet){
+        obj->insert("fftWindow", QJsonValue(fft_window));
+    }
+    if(m_averaging_mode_isSet){
+        obj->insert("averagingMode", QJsonValue(averaging_mode));
+    }
+    if(m_averaging_value_isSet){
+        obj->insert("averagingValue", QJsonValue(averaging_value));
+    }
+    if(m_linear_isSet){
+        obj->insert("linear", QJsonValue(linear));
+    }
+    if(ws_spectrum_address != nullptr && *ws_spectrum_address != QString("")){
+        toJsonValue(QString("wsSpectrumAddress"), ws_spectrum_address, obj, QString("QString"));
+    }
+    if(m_ws_spectrum_port_isSet){
+        obj->insert("wsSpectrumPort", QJsonValue(ws_spectrum_port));
+    }
+    if(m_stream_frame_rate_isSet){
+        obj->insert("streamFrameRate", QJsonValue(stream_frame_rate));
+    }
+    if(m_stream_ref_level_isSet){
+        obj->insert("streamRefLevel", QJsonValue(stream_ref_level));
+    }
+    if(m_stream_power_range_isSet){
+        obj->insert("streamPowerRange", QJsonValue(stream_power_range));
+    }
+
+    return obj;
+}
+
+qint32
+SWGGLSpectrum::getFftSize() {
+    return fft_size;
+}
+void
+SWGGLSpectrum::setFftSize(qint32 fft_size) {
+    this->fft_size = fft_size;
+    this->m_fft_size_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getFftOverlap() {
+    return fft_overlap;
+}
+void
+SWGGLSpectrum::setFftOverlap(qint32 fft_overlap) {
+    this->fft_overlap = fft_overlap;
+    this->m_fft_overlap_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getFftWindow() {
+    return fft_window;
+}
+void
+SWGGLSpectrum::setFftWindow(qint32 fft_window) {
+    this->fft_window = fft_window;
+    this->m_fft_window_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getAveragingMode() {
+    return averaging_mode;
+}
+void
+SWGGLSpectrum::setAveragingMode(qint32 averaging_mode) {
+    this->averaging_mode = averaging_mode;
+    this->m_averaging_mode_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getAveragingValue() {
+    return averaging_value;
+}
+void
+SWGGLSpectrum::setAveragingValue(qint32 averaging_value) {
+    this->averaging_value = averaging_value;
+    this->m_averaging_value_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getLinear() {
+    return linear;
+}
+void
+SWGGLSpectrum::setLinear(qint32 linear) {
+    this->linear = linear;
+    this->m_linear_isSet = true;
+}
+
+QString*
+SWGGLSpectrum::getWsSpectrumAddress() {
+    return ws_spectrum_address;
+}
+void
+SWGGLSpectrum::setWsSpectrumAddress(QString* ws_spectrum_address) {
+    this->ws_spectrum_address = ws_spectrum_address;
+    this->m_ws_spectrum_address_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getWsSpectrumPort() {
+    return ws_spectrum_port;
+}
+void
+SWGGLSpectrum::setWsSpectrumPort(qint32 ws_spectrum_port) {
+    this->ws_spectrum_port = ws_spectrum_port;
+    this->m_ws_spectrum_port_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getStreamFrameRate() {
+    return stream_frame_rate;
+}
+void
+SWGGLSpectrum::setStreamFrameRate(qint32 stream_frame_rate) {
+    this->stream_frame_rate = stream_frame_rate;
+    this->m_stream_frame_rate_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getStreamRefLevel() {
+    return stream_ref_level;
+}
+void
+SWGGLSpectrum::setStreamRefLevel(qint32 stream_ref_level) {
+    this->stream_ref_level = stream_ref_level;
+    this->m_stream_ref_level_isSet = true;
+}
+
+qint32
+SWGGLSpectrum::getStreamPowerRange() {
+    return stream_power_range;
+}
+void
+SWGGLSpectrum::setStreamPowerRange(qint32 stream_power_range) {
+    this->stream_power_range = stream_power_range;
+    this->m_stream_power_range_isSet = true;
+}
+
+
+bool
+SWGGLSpectrum::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_fft_size_isSet){ isObjectUpdated = true; break;}
+        if(m_fft_overlap_isSet){ isObjectUpdated = true; break;}
+        if(m_fft_window_isSet){ isObjectUpdated = true; break;}
+        if(m_averaging_mode_isSet){ isObjectUpdated = true; break;}
+        if(m_averaging_value_isSet){ isObjectUpdated = true; break;}
+        if(m_linear_isSet){ isObjectUpdated = true; break;}
+        if(ws_spectrum_address != nullptr && *ws_spectrum_address != QString("")){ isObjectUpdated = true; break;}
+        if(m_ws_spectrum_port_isSet){ isObjectUpdated = true; break;}
+        if(m_stream_frame_rate_isSet){ isObjectUpdated = true; break;}
+        if(m_stream_ref_level_isSet){ isObjectUpdated = true; break;}
+        if(m_stream_power_range_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,119 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGGLSpectrum.h
+ *
+ * Spectrum computation and stream settings
+ */
+
+#ifndef SWGGLSpectrum_H_
+#define SWGGLSpectrum_H_
+
+#include <QJsonObject>
+
+
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGGLSpectrum: public SWGObject {
+public:
+    SWGGLSpectrum();
+    SWGGLSpectrum(QString* json);
+    virtual ~SWGGLSpectrum();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGGLSpectrum* fromJson(QString &jsonString) override;
+
+    qint32 getFftSize();
+    void setFftSize(qint32 fft_size);
+
+    qint32 getFftOverlap();
+    void setFftOverlap(qint32 fft_overlap);
+
+    qint32 getFftWindow();
+    void setFftWindow(qint32 fft_window);
+
+    qint32 getAveragingMode();
+    void setAveragingMode(qint32 averaging_mode);
+
+    qint32 getAveragingValue();
+    void setAveragingValue(qint32 averaging_value);
+
+    qint32 getLinear();
+    void setLinear(qint32 linear);
+
+    QString* getWsSpectrumAddress();
+    void setWsSpectrumAddress(QString* ws_spectrum_address);
+
+    qint32 getWsSpectrumPort();
+    void setWsSpectrumPort(qint32 ws_spectrum_port);
+
+    qint32 getStreamFrameRate();
+    void setStreamFrameRate(qint32 stream_frame_rate);
+
+    qint32 getStreamRefLevel();
+    void setStreamRefLevel(qint32 stream_ref_level);
+
+    qint32 getStreamPowerRange();
+    void setStreamPowerRange(qint32 stream_power_range);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 fft_size;
+    bool m_fft_size_isSet;
+
+    qint32 fft_overlap;
+    bool m_fft_overlap_isSet;
+
+    qint32 fft_window;
+    bool m_fft_window_isSet;
+
+    qint32 averaging_mode;
+    bool m_averaging_mode_isSet;
+
+    qint32 averaging_value;
+    bool m_averaging_value_isSet;
+
+    qint32 linear;
+    bool m_linear_isSet;
+
+    QString* ws_spectrum_address;
+    bool m_ws_spectrum_address_isSet;
+
+    qint32 ws_spectrum_port;
+    bool m_ws_spectrum_port_isSet;
+
+    qint32 stream_frame_rate;
+    bool m_stream_frame_rate_isSet;
+
+    qint32 stream_ref_level;
+    bool m_stream_ref_level_isSet;
+
+    qint32 stream_power_range;
+    bool m_stream_power_range_isSet;
+
+};
+
+}
+
+#endif /* SWGGLSpectrum_H_ */
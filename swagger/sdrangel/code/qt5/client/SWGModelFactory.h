@@ -41,10 +41,13 @@
 #include "SWGCWKeyerSettings.h"
 #include "SWGChannel.h"
 #include "SWGChannelListItem.h"
+#include "SWGChannelProfiling.h"
 #include "SWGChannelReport.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelsDetail.h"
 #include "SWGComplex.h"
+#include "SWGDATVDemodReport.h"
+#include "SWGDATVDemodRunnableReport.h"
 #include "SWGDSDDemodReport.h"
 #include "SWGDSDDemodSettings.h"
 #include "SWGDVSeralDevices.h"
@@ -53,6 +56,7 @@
 #include "SWGDeviceReport.h"
 #include "SWGDeviceSet.h"
 #include "SWGDeviceSetList.h"
+#include "SWGDeviceSetProfiling.h"
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGErrorResponse.h"
@@ -60,6 +64,7 @@
 #include "SWGFCDProSettings.h"
 #include "SWGFileInputReport.h"
 #include "SWGFileInputSettings.h"
+#include "SWGFileRecordReport.h"
 #include "SWGFileSourceReport.h"
 #include "SWGFileSourceSettings.h"
 #include "SWGFreeDVDemodReport.h"
@@ -72,6 +77,7 @@
 #include "SWGFrequencyBand.h"
 #include "SWGFrequencyRange.h"
 #include "SWGGain.h"
+#include "SWGGLSpectrum.h"
 #include "SWGHackRFInputSettings.h"
 #include "SWGHackRFOutputSettings.h"
 #include "SWGInstanceChannelsResponse.h"
@@ -109,6 +115,9 @@
 #include "SWGPresetItem.h"
 #include "SWGPresetTransfer.h"
 #include "SWGPresets.h"
+#include "SWGProfilingFifo.h"
+#include "SWGProfilingReport.h"
+#include "SWGProfilingStage.h"
 #include "SWGRDSReport.h"
 #include "SWGRDSReport_altFrequencies.h"
 #include "SWGRange.h"
@@ -135,6 +144,8 @@
 #include "SWGSoapySDRInputSettings.h"
 #include "SWGSoapySDROutputSettings.h"
 #include "SWGSoapySDRReport.h"
+#include "SWGSpectrumServer.h"
+#include "SWGSpectrumServer_clients.h"
 #include "SWGSuccessResponse.h"
 #include "SWGTestMISettings.h"
 #include "SWGTestMiStreamSettings.h"
@@ -236,6 +247,9 @@ namespace SWGSDRangel {
     if(QString("SWGChannelListItem").compare(type) == 0) {
       return new SWGChannelListItem();
     }
+    if(QString("SWGChannelProfiling").compare(type) == 0) {
+      return new SWGChannelProfiling();
+    }
     if(QString("SWGChannelReport").compare(type) == 0) {
       return new SWGChannelReport();
     }
@@ -248,6 +262,12 @@ namespace SWGSDRangel {
     if(QString("SWGComplex").compare(type) == 0) {
       return new SWGComplex();
     }
+    if(QString("SWGDATVDemodReport").compare(type) == 0) {
+      return new SWGDATVDemodReport();
+    }
+    if(QString("SWGDATVDemodRunnableReport").compare(type) == 0) {
+      return new SWGDATVDemodRunnableReport();
+    }
     if(QString("SWGDSDDemodReport").compare(type) == 0) {
       return new SWGDSDDemodReport();
     }
@@ -272,6 +292,9 @@ namespace SWGSDRangel {
     if(QString("SWGDeviceSetList").compare(type) == 0) {
       return new SWGDeviceSetList();
     }
+    if(QString("SWGDeviceSetProfiling").compare(type) == 0) {
+      return new SWGDeviceSetProfiling();
+    }
     if(QString("SWGDeviceSettings").compare(type) == 0) {
       return new SWGDeviceSettings();
     }
@@ -293,6 +316,9 @@ namespace SWGSDRangel {
     if(QString("SWGFileInputSettings").compare(type) == 0) {
       return new SWGFileInputSettings();
     }
+    if(QString("SWGFileRecordReport").compare(type) == 0) {
+      return new SWGFileRecordReport();
+    }
     if(QString("SWGFileSourceReport").compare(type) == 0) {
       return new SWGFileSourceReport();
     }
@@ -329,6 +355,9 @@ namespace SWGSDRangel {
     if(QString("SWGGain").compare(type) == 0) {
       return new SWGGain();
     }
+    if(QString("SWGGLSpectrum").compare(type) == 0) {
+      return new SWGGLSpectrum();
+    }
     if(QString("SWGHackRFInputSettings").compare(type) == 0) {
       return new SWGHackRFInputSettings();
     }
@@ -440,6 +469,15 @@ namespace SWGSDRangel {
     if(QString("SWGPresets").compare(type) == 0) {
       return new SWGPresets();
     }
+    if(QString("SWGProfilingFifo").compare(type) == 0) {
+      return new SWGProfilingFifo();
+    }
+    if(QString("SWGProfilingReport").compare(type) == 0) {
+      return new SWGProfilingReport();
+    }
+    if(QString("SWGProfilingStage").compare(type) == 0) {
+      return new SWGProfilingStage();
+    }
     if(QString("SWGRDSReport").compare(type) == 0) {
       return new SWGRDSReport();
     }
@@ -518,6 +556,12 @@ namespace SWGSDRangel {
     if(QString("SWGSoapySDRReport").compare(type) == 0) {
       return new SWGSoapySDRReport();
     }
+    if(QString("SWGSpectrumServer").compare(type) == 0) {
+      return new SWGSpectrumServer();
+    }
+    if(QString("SWGSpectrumServer_clients").compare(type) == 0) {
+      return new SWGSpectrumServer_clients();
+    }
     if(QString("SWGSuccessResponse").compare(type) == 0) {
       return new SWGSuccessResponse();
     }
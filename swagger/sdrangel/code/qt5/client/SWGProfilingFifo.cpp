@@ -0,0 +1,213 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGProfilingFifo.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGProfilingFifo::SWGProfilingFifo(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGProfilingFifo::SWGProfilingFifo() {
+    name = nullptr;
+    m_name_isSet = false;
+    size = 0;
+    m_size_isSet = false;
+    fill = 0;
+    m_fill_isSet = false;
+    max_fill = 0;
+    m_max_fill_isSet = false;
+    transferred = 0L;
+    m_transferred_isSet = false;
+    dropped = 0L;
+    m_dropped_isSet = false;
+}
+
+SWGProfilingFifo::~SWGProfilingFifo() {
+    this->cleanup();
+}
+
+void
+SWGProfilingFifo::init() {
+    name = new QString("");
+    m_name_isSet = false;
+    size = 0;
+    m_size_isSet = false;
+    fill = 0;
+    m_fill_isSet = false;
+    max_fill = 0;
+    m_max_fill_isSet = false;
+    transferred = 0L;
+    m_transferred_isSet = false;
+    dropped = 0L;
+    m_dropped_isSet = false;
+}
+
+void
+SWGProfilingFifo::cleanup() {
+    if(name != nullptr) { 
+        delete name;
+    }
+
+
+
+
+
+}
+
+SWGProfilingFifo*
+SWGProfilingFifo::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGProfilingFifo::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&name, pJson["name"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&size, pJson["size"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&fill, pJson["fill"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&max_fill, pJson["maxFill"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&transferred, pJson["transferred"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&dropped, pJson["dropped"], "qint64", "");
+    
+}
+
+QString
+SWGProfilingFifo::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGProfilingFifo::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(name != nullptr && *name != QString("")){
+        toJsonValue(QString("name"), name, obj, QString("QString"));
+    }
+    if(m_size_isSet){
+        obj->insert("size", QJsonValue(size));
+    }
+    if(m_fill_isSet){
+        obj->insert("fill", QJsonValue(fill));
+    }
+    if(m_max_fill_isSet){
+        obj->insert("maxFill", QJsonValue(max_fill));
+    }
+    if(m_transferred_isSet){
+        obj->insert("transferred", QJsonValue(transferred));
+    }
+    if(m_dropped_isSet){
+        obj->insert("dropped", QJsonValue(dropped));
+    }
+
+    return obj;
+}
+
+QString*
+SWGProfilingFifo::getName() {
+    return name;
+}
+void
+SWGProfilingFifo::setName(QString* name) {
+    this->name = name;
+    this->m_name_isSet = true;
+}
+
+qint32
+SWGProfilingFifo::getSize() {
+    return size;
+}
+void
+SWGProfilingFifo::setSize(qint32 size) {
+    this->size = size;
+    this->m_size_isSet = true;
+}
+
+qint32
+SWGProfilingFifo::getFill() {
+    return fill;
+}
+void
+SWGProfilingFifo::setFill(qint32 fill) {
+    this->fill = fill;
+    this->m_fill_isSet = true;
+}
+
+qint32
+SWGProfilingFifo::getMaxFill() {
+    return max_fill;
+}
+void
+SWGProfilingFifo::setMaxFill(qint32 max_fill) {
+    this->max_fill = max_fill;
+    this->m_max_fill_isSet = true;
+}
+
+qint64
+SWGProfilingFifo::getTransferred() {
+    return transferred;
+}
+void
+SWGProfilingFifo::setTransferred(qint64 transferred) {
+    this->transferred = transferred;
+    this->m_transferred_isSet = true;
+}
+
+qint64
+SWGProfilingFifo::getDropped() {
+    return dropped;
+}
+void
+SWGProfilingFifo::setDropped(qint64 dropped) {
+    this->dropped = dropped;
+    this->m_dropped_isSet = true;
+}
+
+
+bool
+SWGProfilingFifo::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(name != nullptr && *name != QString("")){ isObjectUpdated = true; break;}
+        if(m_size_isSet){ isObjectUpdated = true; break;}
+        if(m_fill_isSet){ isObjectUpdated = true; break;}
+        if(m_max_fill_isSet){ isObjectUpdated = true; break;}
+        if(m_transferred_isSet){ isObjectUpdated = true; break;}
+        if(m_dropped_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,133 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGProfilingReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGProfilingReport::SWGProfilingReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGProfilingReport::SWGProfilingReport() {
+    elapsed = 0.0f;
+    m_elapsed_isSet = false;
+    device_sets = nullptr;
+    m_device_sets_isSet = false;
+}
+
+SWGProfilingReport::~SWGProfilingReport() {
+    this->cleanup();
+}
+
+void
+SWGProfilingReport::init() {
+    elapsed = 0.0f;
+    m_elapsed_isSet = false;
+    device_sets = new QList<SWGDeviceSetProfiling*>();
+    m_device_sets_isSet = false;
+}
+
+void
+SWGProfilingReport::cleanup() {
+
+    if(device_sets != nullptr) { 
+        auto arr = device_sets;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete device_sets;
+    }
+}
+
+SWGProfilingReport*
+SWGProfilingReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGProfilingReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&elapsed, pJson["elapsed"], "float", "");
+    
+    
+    ::SWGSDRangel::setValue(&device_sets, pJson["deviceSets"], "QList", "SWGDeviceSetProfiling");
+}
+
+QString
+SWGProfilingReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGProfilingReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_elapsed_isSet){
+        obj->insert("elapsed", QJsonValue(elapsed));
+    }
+    if(device_sets->size() > 0){
+        toJsonArray((QList<void*>*)device_sets, obj, "deviceSets", "SWGDeviceSetProfiling");
+    }
+
+    return obj;
+}
+
+float
+SWGProfilingReport::getElapsed() {
+    return elapsed;
+}
+void
+SWGProfilingReport::setElapsed(float elapsed) {
+    this->elapsed = elapsed;
+    this->m_elapsed_isSet = true;
+}
+
+QList<SWGDeviceSetProfiling*>*
+SWGProfilingReport::getDeviceSets() {
+    return device_sets;
+}
+void
+SWGProfilingReport::setDeviceSets(QList<SWGDeviceSetProfiling*>* device_sets) {
+    this->device_sets = device_sets;
+    this->m_device_sets_isSet = true;
+}
+
+
+bool
+SWGProfilingReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_elapsed_isSet){ isObjectUpdated = true; break;}
+        if(device_sets->size() > 0){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
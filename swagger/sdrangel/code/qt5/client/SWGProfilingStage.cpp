@@ -0,0 +1,213 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.11.1
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGProfilingStage.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGProfilingStage::SWGProfilingStage(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGProfilingStage::SWGProfilingStage() {
+    name = nullptr;
+    m_name_isSet = false;
+    calls = 0L;
+    m_calls_isSet = false;
+    samples = 0L;
+    m_samples_isSet = false;
+    total_time = 0.0f;
+    m_total_time_isSet = false;
+    max_time = 0.0f;
+    m_max_time_isSet = false;
+    load = 0.0f;
+    m_load_isSet = false;
+}
+
+SWGProfilingStage::~SWGProfilingStage() {
+    this->cleanup();
+}
+
+void
+SWGProfilingStage::init() {
+    name = new QString("");
+    m_name_isSet = false;
+    calls = 0L;
+    m_calls_isSet = false;
+    samples = 0L;
+    m_samples_isSet = false;
+    total_time = 0.0f;
+    m_total_time_isSet = false;
+    max_time = 0.0f;
+    m_max_time_isSet = false;
+    load = 0.0f;
+    m_load_isSet = false;
+}
+
+void
+SWGProfilingStage::cleanup() {
+    if(name != nullptr) { 
+        delete name;
+    }
+
+
+
+
+
+}
+
+SWGProfilingStage*
+SWGProfilingStage::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGProfilingStage::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&name, pJson["name"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&calls, pJson["calls"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&samples, pJson["samples"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&total_time, pJson["totalTime"], "float", "");
+    
+    ::SWGSDRangel::setValue(&max_time, pJson["maxTime"], "float", "");
+    
+    ::SWGSDRangel::setValue(&load, pJson["load"], "float", "");
+    
+}
+
+QString
+SWGProfilingStage::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGProfilingStage::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(name != nullptr && *name != QString("")){
+        toJsonValue(QString("name"), name, obj, QString("QString"));
+    }
+    if(m_calls_isSet){
+        obj->insert("calls", QJsonValue(calls));
+    }
+    if(m_samples_isSet){
+        obj->insert("samples", QJsonValue(samples));
+    }
+    if(m_total_time_isSet){
+        obj->insert("totalTime", QJsonValue(total_time));
+    }
+    if(m_max_time_isSet){
+        obj->insert("maxTime", QJsonValue(max_time));
+    }
+    if(m_load_isSet){
+        obj->insert("load", QJsonValue(load));
+    }
+
+    return obj;
+}
+
+QString*
+SWGProfilingStage::getName() {
+    return name;
+}
+void
+SWGProfilingStage::setName(QString* name) {
+    this->name = name;
+    this->m_name_isSet = true;
+}
+
+qint64
+SWGProfilingStage::getCalls() {
+    return calls;
+}
+void
+SWGProfilingStage::setCalls(qint64 calls) {
+    this->calls = calls;
+    this->m_calls_isSet = true;
+}
+
+qint64
+SWGProfilingStage::getSamples() {
+    return samples;
+}
+void
+SWGProfilingStage::setSamples(qint64 samples) {
+    this->samples = samples;
+    this->m_samples_isSet = true;
+}
+
+float
+SWGProfilingStage::getTotalTime() {
+    return total_time;
+}
+void
+SWGProfilingStage::setTotalTime(float total_time) {
+    this->total_time = total_time;
+    this->m_total_time_isSet = true;
+}
+
+float
+SWGProfilingStage::getMaxTime() {
+    return max_time;
+}
+void
+SWGProfilingStage::setMaxTime(float max_time) {
+    this->max_time = max_time;
+    this->m_max_time_isSet = true;
+}
+
+float
+SWGProfilingStage::getLoad() {
+    return load;
+}
+void
+SWGProfilingStage::setLoad(float load) {
+    this->load = load;
+    this->m_load_isSet = true;
+}
+
+
+bool
+SWGProfilingStage::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(name != nullptr && *name != QString("")){ isObjectUpdated = true; break;}
+        if(m_calls_isSet){ isObjectUpdated = true; break;}
+        if(m_samples_isSet){ isObjectUpdated = true; break;}
+        if(m_total_time_isSet){ isObjectUpdated = true; break;}
+        if(m_max_time_isSet){ isObjectUpdated = true; break;}
+        if(m_load_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
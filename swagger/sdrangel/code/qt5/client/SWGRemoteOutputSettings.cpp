@@ -36,6 +36,10 @@ SWGRemoteOutputSettings::SWGRemoteOutputSettings() {
     m_tx_delay_isSet = false;
     nb_fec_blocks = 0;
     m_nb_fec_blocks_isSet = false;
+    block_size = 0;
+    m_block_size_isSet = false;
+    sample_encoding = 0;
+    m_sample_encoding_isSet = false;
     api_address = nullptr;
     m_api_address_isSet = false;
     api_port = 0;
@@ -72,6 +76,10 @@ SWGRemoteOutputSettings::init() {
     m_tx_delay_isSet = false;
     nb_fec_blocks = 0;
     m_nb_fec_blocks_isSet = false;
+    block_size = 0;
+    m_block_size_isSet = false;
+    sample_encoding = 0;
+    m_sample_encoding_isSet = false;
     api_address = new QString("");
     m_api_address_isSet = false;
     api_port = 0;
@@ -137,6 +145,10 @@ SWGRemoteOutputSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&nb_fec_blocks, pJson["nbFECBlocks"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&block_size, pJson["blockSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&sample_encoding, pJson["sampleEncoding"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&api_address, pJson["apiAddress"], "QString", "QString");
     
     ::SWGSDRangel::setValue(&api_port, pJson["apiPort"], "qint32", "");
@@ -185,6 +197,12 @@ SWGRemoteOutputSettings::asJsonObject() {
     if(m_nb_fec_blocks_isSet){
         obj->insert("nbFECBlocks", QJsonValue(nb_fec_blocks));
     }
+    if(m_block_size_isSet){
+        obj->insert("blockSize", QJsonValue(block_size));
+    }
+    if(m_sample_encoding_isSet){
+        obj->insert("sampleEncoding", QJsonValue(sample_encoding));
+    }
     if(api_address != nullptr && *api_address != QString("")){
         toJsonValue(QString("apiAddress"), api_address, obj, QString("QString"));
     }
@@ -259,6 +277,26 @@ SWGRemoteOutputSettings::setNbFecBlocks(qint32 nb_fec_blocks) {
     this->m_nb_fec_blocks_isSet = true;
 }
 
+qint32
+SWGRemoteOutputSettings::getBlockSize() {
+    return block_size;
+}
+void
+SWGRemoteOutputSettings::setBlockSize(qint32 block_size) {
+    this->block_size = block_size;
+    this->m_block_size_isSet = true;
+}
+
+qint32
+SWGRemoteOutputSettings::getSampleEncoding() {
+    return sample_encoding;
+}
+void
+SWGRemoteOutputSettings::setSampleEncoding(qint32 sample_encoding) {
+    this->sample_encoding = sample_encoding;
+    this->m_sample_encoding_isSet = true;
+}
+
 QString*
 SWGRemoteOutputSettings::getApiAddress() {
     return api_address;
@@ -368,6 +406,8 @@ SWGRemoteOutputSettings::isSet(){
         if(m_sample_rate_isSet){ isObjectUpdated = true; break;}
         if(m_tx_delay_isSet){ isObjectUpdated = true; break;}
         if(m_nb_fec_blocks_isSet){ isObjectUpdated = true; break;}
+        if(m_block_size_isSet){ isObjectUpdated = true; break;}
+        if(m_sample_encoding_isSet){ isObjectUpdated = true; break;}
         if(api_address != nullptr && *api_address != QString("")){ isObjectUpdated = true; break;}
         if(m_api_port_isSet){ isObjectUpdated = true; break;}
         if(data_address != nullptr && *data_address != QString("")){ isObjectUpdated = true; break;}
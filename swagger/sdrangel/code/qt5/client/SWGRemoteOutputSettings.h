@@ -54,6 +54,12 @@ public:
     qint32 getNbFecBlocks();
     void setNbFecBlocks(qint32 nb_fec_blocks);
 
+    qint32 getBlockSize();
+    void setBlockSize(qint32 block_size);
+
+    qint32 getSampleEncoding();
+    void setSampleEncoding(qint32 sample_encoding);
+
     QString* getApiAddress();
     void setApiAddress(QString* api_address);
 
@@ -100,6 +106,12 @@ private:
     qint32 nb_fec_blocks;
     bool m_nb_fec_blocks_isSet;
 
+    qint32 block_size;
+    bool m_block_size_isSet;
+
+    qint32 sample_encoding;
+    bool m_sample_encoding_isSet;
+
     QString* api_address;
     bool m_api_address_isSet;
 
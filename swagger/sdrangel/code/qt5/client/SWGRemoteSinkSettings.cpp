@@ -30,6 +30,10 @@ SWGRemoteSinkSettings::SWGRemoteSinkSettings(QString* json) {
 SWGRemoteSinkSettings::SWGRemoteSinkSettings() {
     nb_fec_blocks = 0;
     m_nb_fec_blocks_isSet = false;
+    block_size = 0;
+    m_block_size_isSet = false;
+    sample_encoding = 0;
+    m_sample_encoding_isSet = false;
     data_address = nullptr;
     m_data_address_isSet = false;
     data_port = 0;
@@ -64,6 +68,10 @@ void
 SWGRemoteSinkSettings::init() {
     nb_fec_blocks = 0;
     m_nb_fec_blocks_isSet = false;
+    block_size = 0;
+    m_block_size_isSet = false;
+    sample_encoding = 0;
+    m_sample_encoding_isSet = false;
     data_address = new QString("");
     m_data_address_isSet = false;
     data_port = 0;
@@ -126,6 +134,10 @@ void
 SWGRemoteSinkSettings::fromJsonObject(QJsonObject &pJson) {
     ::SWGSDRangel::setValue(&nb_fec_blocks, pJson["nbFECBlocks"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&block_size, pJson["blockSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&sample_encoding, pJson["sampleEncoding"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&data_address, pJson["dataAddress"], "QString", "QString");
     
     ::SWGSDRangel::setValue(&data_port, pJson["dataPort"], "qint32", "");
@@ -169,6 +181,12 @@ SWGRemoteSinkSettings::asJsonObject() {
     if(m_nb_fec_blocks_isSet){
         obj->insert("nbFECBlocks", QJsonValue(nb_fec_blocks));
     }
+    if(m_block_size_isSet){
+        obj->insert("blockSize", QJsonValue(block_size));
+    }
+    if(m_sample_encoding_isSet){
+        obj->insert("sampleEncoding", QJsonValue(sample_encoding));
+    }
     if(data_address != nullptr && *data_address != QString("")){
         toJsonValue(QString("dataAddress"), data_address, obj, QString("QString"));
     }
@@ -219,6 +237,26 @@ SWGRemoteSinkSettings::setNbFecBlocks(qint32 nb_fec_blocks) {
     this->m_nb_fec_blocks_isSet = true;
 }
 
+qint32
+SWGRemoteSinkSettings::getBlockSize() {
+    return block_size;
+}
+void
+SWGRemoteSinkSettings::setBlockSize(qint32 block_size) {
+    this->block_size = block_size;
+    this->m_block_size_isSet = true;
+}
+
+qint32
+SWGRemoteSinkSettings::getSampleEncoding() {
+    return sample_encoding;
+}
+void
+SWGRemoteSinkSettings::setSampleEncoding(qint32 sample_encoding) {
+    this->sample_encoding = sample_encoding;
+    this->m_sample_encoding_isSet = true;
+}
+
 QString*
 SWGRemoteSinkSettings::getDataAddress() {
     return data_address;
@@ -345,6 +383,8 @@ SWGRemoteSinkSettings::isSet(){
     bool isObjectUpdated = false;
     do{
         if(m_nb_fec_blocks_isSet){ isObjectUpdated = true; break;}
+        if(m_block_size_isSet){ isObjectUpdated = true; break;}
+        if(m_sample_encoding_isSet){ isObjectUpdated = true; break;}
         if(data_address != nullptr && *data_address != QString("")){ isObjectUpdated = true; break;}
         if(m_data_port_isSet){ isObjectUpdated = true; break;}
         if(m_tx_delay_isSet){ isObjectUpdated = true; break;}
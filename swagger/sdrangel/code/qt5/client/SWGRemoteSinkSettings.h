@@ -45,6 +45,12 @@ public:
     qint32 getNbFecBlocks();
     void setNbFecBlocks(qint32 nb_fec_blocks);
 
+    qint32 getBlockSize();
+    void setBlockSize(qint32 block_size);
+
+    qint32 getSampleEncoding();
+    void setSampleEncoding(qint32 sample_encoding);
+
     QString* getDataAddress();
     void setDataAddress(QString* data_address);
 
@@ -88,6 +94,12 @@ private:
     qint32 nb_fec_blocks;
     bool m_nb_fec_blocks_isSet;
 
+    qint32 block_size;
+    bool m_block_size_isSet;
+
+    qint32 sample_encoding;
+    bool m_sample_encoding_isSet;
+
     QString* data_address;
     bool m_data_address_isSet;
 